@@ -29,4 +29,8 @@ float3 view_pos_from_depth(constant matrix_float4x4 &invProjection, float2 uv, f
 
 float3 get_reflected_vector(float3 n, float3 t, float3 v, float roughness, float anisotropy);
 
+// quantized vertex attributes (see MGPVertexQuantizer)
+float3 oct_decode(float2 e);
+float3 tangent_decode(float3 n, float angle);
+
 #endif /* CommonMath_h */
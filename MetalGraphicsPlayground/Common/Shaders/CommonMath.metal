@@ -60,3 +60,23 @@ float3 get_reflected_vector(float3 n, float3 t, float3 v, float roughness, float
     r = mix(r, n, sqr(roughness));
     return r;
 }
+
+float3 oct_decode(float2 e) {
+    float3 n = float3(e, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-n.z, 0.0);
+    n.x += n.x >= 0.0 ? -t : t;
+    n.y += n.y >= 0.0 ? -t : t;
+    return normalize(n);
+}
+
+// angle : around n / pi, from the basis of Duff et al. (Building an Orthonormal Basis, Revisited)
+float3 tangent_decode(float3 n, float angle) {
+    float s = n.z >= 0.0 ? 1.0 : -1.0;
+    float a = -1.0 / (s + n.z);
+    float c = n.x * n.y * a;
+    float3 t = float3(1.0 + s * n.x * n.x * a, s * c, -s * n.x);
+    float3 b = float3(c, s + n.y * n.y * a, -n.y);
+    float cos_angle;
+    float sin_angle = sincos(angle * PI, cos_angle);
+    return cos_angle * t + sin_angle * b;
+}
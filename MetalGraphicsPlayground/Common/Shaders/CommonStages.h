@@ -10,6 +10,7 @@
 #define ShaderCommon_h
 
 #include <metal_stdlib>
+#include "SharedStructures.h"
 using namespace metal;
 
 typedef struct {
@@ -17,4 +18,9 @@ typedef struct {
     float2 uv;
 } ScreenFragment;
 
+// expands the affine rows of an instance to a model matrix
+inline float4x4 instance_model_matrix(constant instance_props_t &instance) {
+    return transpose(float4x4(instance.model[0], instance.model[1], instance.model[2], float4(0, 0, 0, 1)));
+}
+
 #endif /* ShaderCommon_h */
@@ -16,6 +16,9 @@ using namespace metal;
 
 // Function constants
 constant bool uses_anisotropy [[function_constant(fcv_uses_anisotropy)]];
+// false unless a pipeline sets it
+constant bool quantized_vertex_value [[function_constant(fcv_quantized_vertex)]];
+constant bool quantized_vertex = is_function_constant_defined(quantized_vertex_value) && quantized_vertex_value;
 
 // Math
 constant constexpr float PI = 3.14159265;
@@ -37,6 +37,7 @@ constant bool uses_ssao_map [[function_constant(fcv_uses_ssao_map)]];
 constant bool uses_anisotropic_map = uses_anisotropy && has_anisotropic_map;
 
 // g-buffer vertex input data
+// quantized : pos is unorm in the bounds, normal.xy octahedral, tangent.xy angle and sign
 typedef struct {
     float3 pos     [[attribute(attrib_pos)]];
     float2 uv      [[attribute(attrib_uv)]];
@@ -66,14 +67,25 @@ typedef struct {
 vertex GBufferFragment gbuffer_prepass_vert(GBufferVertex in [[stage_in]],
                                     constant camera_props_t &cameraProps [[buffer(1)]],
                                     constant instance_props_t *instanceProps [[buffer(2)]],
+                                    constant vertex_quantization_t &quantization [[buffer(4), function_constant(quantized_vertex)]],
                                     uint iid [[instance_id]]) {
     GBufferFragment out;
-    float4 v = float4(in.pos, 1.0);
-    float4x4 modelview = cameraProps.view * instanceProps[iid].model;
+    float3 pos = in.pos;
+    float3 normal = in.normal;
+    float3 tangent = in.tangent;
+    float handedness = 1.0;
+    if(quantized_vertex) {
+        pos = quantization.offset.xyz + in.pos * quantization.scale.xyz;
+        normal = oct_decode(in.normal.xy);
+        tangent = tangent_decode(normal, in.tangent.x);
+        handedness = in.tangent.y < 0.0 ? -1.0 : 1.0;
+    }
+    float4 v = float4(pos, 1.0);
+    float4x4 modelview = cameraProps.view * instance_model_matrix(instanceProps[iid]);
     out.clip_pos = cameraProps.projection * modelview * v;
-    out.normal = (modelview * float4(in.normal, 0.0)).xyz;
-    out.tangent = (modelview * float4(in.tangent, 0.0)).xyz;
-    out.bitangent = cross(out.tangent, out.normal);
+    out.normal = (modelview * float4(normal, 0.0)).xyz;
+    out.tangent = (modelview * float4(tangent, 0.0)).xyz;
+    out.bitangent = cross(out.tangent, out.normal) * handedness;
     out.uv = in.uv;
     out.iid = iid;
     return out;
@@ -82,6 +94,7 @@ vertex GBufferFragment gbuffer_prepass_vert(GBufferVertex in [[stage_in]],
 fragment GBufferOutput gbuffer_prepass_frag(GBufferFragment in [[stage_in]],
                                   constant camera_props_t &cameraProps [[buffer(1)]],
                                   constant instance_props_t *instanceProps [[buffer(2)]],
+                                  constant material_t *materials [[buffer(3)]],
                                   texture2d<half> albedoMap [[texture(tex_albedo), function_constant(has_albedo_map)]],
                                   texture2d<half> normalMap [[texture(tex_normal), function_constant(has_normal_map)]],
                                   texture2d<float> roughnessMap [[texture(tex_roughness), function_constant(has_roughness_map)]],
@@ -90,7 +103,7 @@ fragment GBufferOutput gbuffer_prepass_frag(GBufferFragment in [[stage_in]],
                                   texture2d<half> anisotropicMap [[texture(tex_anisotropic), function_constant(uses_anisotropic_map)]]
                                   ) {
     GBufferOutput out;
-    material_t material = instanceProps[in.iid].material;
+    material_t material = materials[instanceProps[in.iid].material_index];
     
     if(flip_vertically) {
         in.uv.y = 1.0 - in.uv.y;
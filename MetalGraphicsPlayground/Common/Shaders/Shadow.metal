@@ -9,6 +9,7 @@
 #include <metal_stdlib>
 #include "SharedStructures.h"
 #include "CommonVariables.h"
+#include "CommonStages.h"
 #include "Shadow.h"
 
 #define SHADOW_ANTIALIASING 1
@@ -37,10 +38,14 @@ vertex ShadowFragment shadow_vert(ShadowVertex in [[stage_in]],
                                   constant light_t &light [[buffer(1)]],
                                   constant light_global_t &light_global [[buffer(2)]],
                                   constant instance_props_t *instanceProps [[buffer(3)]],
+                                  constant vertex_quantization_t &quantization [[buffer(4), function_constant(quantized_vertex)]],
                                   uint iid [[instance_id]]) {
     ShadowFragment out;
-    float4 v = float4(in.pos, 1.0);
-    out.clip_pos = light.light_view_projection * instanceProps[iid].model * v;
+    float3 pos = in.pos;
+    if(quantized_vertex)
+        pos = quantization.offset.xyz + in.pos * quantization.scale.xyz;
+    float4 v = float4(pos, 1.0);
+    out.clip_pos = light.light_view_projection * instance_model_matrix(instanceProps[iid]) * v;
     return out;
 }
 
@@ -30,11 +30,46 @@ typedef struct {
     float anisotropy;
 } material_t;
 
-typedef struct __attribute__((__aligned__(256))) {
-    matrix_float4x4 model;
-    material_t material;
+// per-instance data, tightly packed (64 bytes).
+// materials are stored once per frame in a separate table.
+typedef struct {
+    vector_float4 model[3];     // rows of the affine model matrix (last row is 0, 0, 0, 1)
+    uint32_t material_index;    // index in the material table
+    uint32_t padding[3];
 } instance_props_t;
 
+// layouts must be same in the shaders and the host code
+#if defined(__METAL_VERSION__) || defined(__cplusplus)
+#define SHARED_STATIC_ASSERT(cond, msg) static_assert(cond, msg)
+#else
+#define SHARED_STATIC_ASSERT(cond, msg) _Static_assert(cond, msg)
+#endif
+
+// dequantizes positions of a quantized vertex buffer (vertex buffer 4)
+// position = offset + unorm16 * scale
+typedef struct {
+    vector_float4 offset;
+    vector_float4 scale;
+} vertex_quantization_t;
+
+SHARED_STATIC_ASSERT(sizeof(material_t) == 32, "material_t must be 32 bytes");
+SHARED_STATIC_ASSERT(__builtin_offsetof(material_t, roughness) == 16, "material_t.roughness must follow albedo");
+SHARED_STATIC_ASSERT(sizeof(instance_props_t) == 64, "instance_props_t must be 64 bytes");
+SHARED_STATIC_ASSERT(sizeof(vertex_quantization_t) == 32, "vertex_quantization_t must be 32 bytes");
+SHARED_STATIC_ASSERT(__builtin_offsetof(instance_props_t, material_index) == 48, "instance_props_t.material_index must follow the model rows");
+
+#ifndef __METAL_VERSION__
+static inline instance_props_t instance_props_make(matrix_float4x4 model, uint32_t material_index) {
+    matrix_float4x4 rows = simd_transpose(model);
+    instance_props_t props = {};
+    props.model[0] = rows.columns[0];
+    props.model[1] = rows.columns[1];
+    props.model[2] = rows.columns[2];
+    props.material_index = material_index;
+    return props;
+}
+#endif
+
 typedef struct __attribute__((__aligned__(256))) {
     matrix_float4x4 light_view;
     matrix_float4x4 light_view_projection;
@@ -117,7 +152,8 @@ typedef enum {
     fcv_uses_ibl_specular_map,
     fcv_uses_ssao_map,
     fcv_light_cull_tile_size,
-    fcv_uses_anisotropy
+    fcv_uses_anisotropy,
+    fcv_quantized_vertex
 } function_constant_values;
 
 // vertex attribute
@@ -0,0 +1,97 @@
+//
+//  MGPAliasingPlanner.cpp
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/17.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#include "MGPAliasingPlanner.h"
+
+#include <algorithm>
+#include <vector>
+
+static uint64_t align_up(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+static bool overlaps(const mgp_alias_request_t &a, const mgp_alias_request_t &b) {
+    return a.firstUse <= b.lastUse && b.firstUse <= a.lastUse;
+}
+
+uint64_t mgp_alias_plan(const mgp_alias_request_t *requests, size_t count,
+                        uint64_t *offsets, mgp_alias_stats_t *stats) {
+    // largest first, then earliest
+    std::vector<uint32_t> order(count);
+    for(size_t i = 0; i < count; i++)
+        order[i] = (uint32_t)i;
+    std::sort(order.begin(), order.end(), [requests](uint32_t a, uint32_t b) {
+        if(requests[a].size != requests[b].size)
+            return requests[a].size > requests[b].size;
+        if(requests[a].firstUse != requests[b].firstUse)
+            return requests[a].firstUse < requests[b].firstUse;
+        return a < b;
+    });
+
+    struct Range {
+        uint64_t begin, end;
+    };
+    std::vector<uint32_t> placed;
+    std::vector<Range> busy;
+    uint64_t heapSize = 0;
+
+    for(uint32_t index : order) {
+        const mgp_alias_request_t &request = requests[index];
+        const uint64_t alignment = request.alignment > 0 ? request.alignment : 1;
+
+        // memory taken by placed resources alive at the same time
+        busy.clear();
+        for(uint32_t other : placed) {
+            if(overlaps(request, requests[other]))
+                busy.push_back({ offsets[other], offsets[other] + requests[other].size });
+        }
+        std::sort(busy.begin(), busy.end(), [](const Range &a, const Range &b) {
+            return a.begin < b.begin;
+        });
+
+        // smallest gap that fits, or the end of the busy ranges
+        uint64_t bestOffset = UINT64_MAX, bestWaste = UINT64_MAX;
+        uint64_t cursor = 0;
+        for(const Range &range : busy) {
+            uint64_t offset = align_up(cursor, alignment);
+            if(range.begin >= offset && range.begin - offset >= request.size) {
+                uint64_t waste = range.begin - cursor - request.size;
+                if(waste < bestWaste) {
+                    bestWaste = waste;
+                    bestOffset = offset;
+                }
+            }
+            cursor = std::max(cursor, range.end);
+        }
+        if(bestOffset == UINT64_MAX)
+            bestOffset = align_up(cursor, alignment);
+
+        offsets[index] = bestOffset;
+        heapSize = std::max(heapSize, bestOffset + request.size);
+        placed.push_back(index);
+    }
+
+    if(stats) {
+        stats->heapSize = heapSize;
+        stats->unaliasedSize = 0;
+        stats->peakLiveSize = 0;
+        for(size_t i = 0; i < count; i++)
+            stats->unaliasedSize += requests[i].size;
+
+        // live sizes only change at first uses
+        for(size_t i = 0; i < count; i++) {
+            uint64_t liveSize = 0;
+            for(size_t j = 0; j < count; j++) {
+                if(requests[j].firstUse <= requests[i].firstUse && requests[i].firstUse <= requests[j].lastUse)
+                    liveSize += requests[j].size;
+            }
+            stats->peakLiveSize = std::max(stats->peakLiveSize, liveSize);
+        }
+    }
+    return heapSize;
+}
@@ -0,0 +1,47 @@
+//
+//  MGPAliasingPlanner.h
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/17.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#ifndef MGPAliasingPlanner_h
+#define MGPAliasingPlanner_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Places transient resources in one heap so that resources which are never
+// used at the same time share memory.
+// Each resource is used from its first to its last pass (inclusive).
+// Resources are placed largest first, each at the best fitting free range
+// among the resources whose lifetimes overlap it.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    uint64_t size;
+    uint64_t alignment;     // power of two, 0 is same as 1
+    uint32_t firstUse;
+    uint32_t lastUse;
+} mgp_alias_request_t;
+
+typedef struct {
+    uint64_t heapSize;          // memory needed for the placements
+    uint64_t unaliasedSize;     // sum of the sizes, without aliasing
+    uint64_t peakLiveSize;      // largest sum of sizes in use at once, the lower bound of heapSize
+} mgp_alias_stats_t;
+
+// Writes the offset of each request, returns the heap size.
+// stats can be NULL.
+uint64_t mgp_alias_plan(const mgp_alias_request_t *requests, size_t count,
+                        uint64_t *offsets, mgp_alias_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MGPAliasingPlanner_h */
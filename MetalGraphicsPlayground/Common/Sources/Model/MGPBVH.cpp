@@ -0,0 +1,643 @@
+//
+//  MGPBVH.cpp
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/17.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#include "MGPBVH.h"
+
+#include <math.h>
+#include <float.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+const uint32_t kInvalidIndex = 0xFFFFFFFF;
+const uint32_t kMaxLeafSize = 4;
+const uint32_t kNumBins = 16;
+
+enum PrimitiveClass : uint8_t {
+    PrimitiveClassBounded = 0,
+    PrimitiveClassNeverVisible,
+    PrimitiveClassAlwaysVisible
+};
+
+struct Bounds {
+    float min[3];
+    float max[3];
+
+    void reset() {
+        min[0] = min[1] = min[2] = FLT_MAX;
+        max[0] = max[1] = max[2] = -FLT_MAX;
+    }
+    void grow(const Bounds &b) {
+        for(int i = 0; i < 3; i++) {
+            min[i] = std::min(min[i], b.min[i]);
+            max[i] = std::max(max[i], b.max[i]);
+        }
+    }
+    void grow(const float p[3]) {
+        for(int i = 0; i < 3; i++) {
+            min[i] = std::min(min[i], p[i]);
+            max[i] = std::max(max[i], p[i]);
+        }
+    }
+    // half surface area
+    float area() const {
+        float dx = max[0] - min[0], dy = max[1] - min[1], dz = max[2] - min[2];
+        if(dx < 0.0f || dy < 0.0f || dz < 0.0f)
+            return 0.0f;
+        return dx * dy + dy * dz + dz * dx;
+    }
+};
+
+inline Bounds merged(const Bounds &a, const Bounds &b) {
+    Bounds result = a;
+    result.grow(b);
+    return result;
+}
+
+struct Primitive {
+    float center[3];
+    float extent[3];
+
+    Bounds bounds() const {
+        Bounds b;
+        for(int i = 0; i < 3; i++) {
+            b.min[i] = center[i] - extent[i];
+            b.max[i] = center[i] + extent[i];
+        }
+        return b;
+    }
+};
+
+struct Node {
+    Bounds bounds;
+    uint32_t parent;
+    uint32_t left, right;   // internal node
+    uint32_t first, count;  // leaf (count > 0)
+
+    bool isLeaf() const { return count > 0; }
+};
+
+// traversal state of up to 64 views
+struct ViewStackEntry {
+    uint32_t node;
+    uint64_t intersecting;  // views that still test planes
+    uint64_t inside;        // views that see the whole subtree
+    uint8_t planeMasks[64]; // planes left to test, per intersecting view
+};
+
+struct BuildPrimitive {
+    Bounds bounds;
+    float centroid[3];
+    uint32_t index;
+};
+
+struct Bin {
+    Bounds bounds;
+    uint32_t count;
+};
+
+inline void getBox(const mgp_aabb_array_t *aabbs, size_t i, Primitive *p) {
+    p->center[0] = aabbs->center_x[i];
+    p->center[1] = aabbs->center_y[i];
+    p->center[2] = aabbs->center_z[i];
+    p->extent[0] = aabbs->extent_x[i];
+    p->extent[1] = aabbs->extent_y[i];
+    p->extent[2] = aabbs->extent_z[i];
+}
+
+PrimitiveClass classify(const Primitive &p) {
+    for(int k = 0; k < 3; k++) {
+        if(p.extent[k] < 0.0f)
+            return PrimitiveClassNeverVisible;
+    }
+    for(int k = 0; k < 3; k++) {
+        if(!isfinite(p.extent[k]) || !isfinite(p.center[k]))
+            return PrimitiveClassAlwaysVisible;
+    }
+    return PrimitiveClassBounded;
+}
+
+inline uint32_t allPlanesMask(const mgp_cull_planes_t *planes) {
+    return (1u << planes->count) - 1;
+}
+
+// 0 : outside, 1 : intersecting (mask updated)
+inline bool testPlanes(const mgp_cull_planes_t *planes, const float c[3], const float e[3], uint32_t *mask) {
+    uint32_t bits = *mask;
+    while(bits) {
+        uint32_t p = __builtin_ctz(bits);
+        bits &= bits - 1;
+        float distance = planes->nx[p] * c[0] + planes->ny[p] * c[1] + planes->nz[p] * c[2] + planes->d[p];
+        float radius = fabsf(planes->nx[p]) * e[0] + fabsf(planes->ny[p]) * e[1] + fabsf(planes->nz[p]) * e[2];
+        if(distance < -radius)
+            return false;
+        // fully inside this plane, children don't need to test it again
+        if(distance >= radius)
+            *mask &= ~(1u << p);
+    }
+    return true;
+}
+
+} // namespace
+
+struct mgp_bvh {
+    std::vector<Node> nodes;
+    std::vector<uint8_t> dirty;
+    uint32_t root = kInvalidIndex;
+
+    // primitive slots : bounded (tree) primitives, then always visible ones
+    std::vector<Primitive> primitives;
+    std::vector<uint32_t> indices;      // slot -> box index
+    std::vector<uint32_t> leafOfSlot;   // slot -> leaf node
+    size_t numTreePrimitives = 0;
+
+    std::vector<Primitive> boxes;       // box index -> last box given
+    std::vector<uint32_t> slotOf;       // box index -> slot
+    std::vector<uint8_t> classes;       // box index -> PrimitiveClass
+    size_t count = 0;
+
+    // scratch
+    std::vector<std::pair<uint32_t, uint32_t>> stack;
+    std::vector<ViewStackEntry> viewStack;
+    std::vector<mgp_bvh_range_t> ranges;
+    std::vector<BuildPrimitive> buildPrimitives;
+
+    uint32_t buildNode(uint32_t begin, uint32_t end, uint32_t parent);
+    void makeLeaf(uint32_t node, uint32_t begin, uint32_t end);
+    void markDirty(uint32_t node);
+    void refitNode(uint32_t node);
+    void rotate(uint32_t node);
+
+    template<typename RangeVisitor, typename SlotVisitor>
+    void cull(const mgp_cull_planes_t *planes, RangeVisitor onRange, SlotVisitor onSlot);
+};
+
+uint32_t mgp_bvh::buildNode(uint32_t begin, uint32_t end, uint32_t parent) {
+    uint32_t nodeIndex = (uint32_t)nodes.size();
+    nodes.emplace_back();
+    nodes[nodeIndex].parent = parent;
+
+    Bounds bounds, centroidBounds;
+    bounds.reset();
+    centroidBounds.reset();
+    for(uint32_t i = begin; i < end; i++) {
+        bounds.grow(buildPrimitives[i].bounds);
+        centroidBounds.grow(buildPrimitives[i].centroid);
+    }
+    nodes[nodeIndex].bounds = bounds;
+
+    uint32_t numPrimitives = end - begin;
+    if(numPrimitives <= 1) {
+        makeLeaf(nodeIndex, begin, end);
+        return nodeIndex;
+    }
+
+    // binned SAH along the longest centroid axis
+    float bestCost = FLT_MAX;
+    uint32_t bestBin = kNumBins;
+    int axis = 0;
+    for(int i = 1; i < 3; i++) {
+        if(centroidBounds.max[i] - centroidBounds.min[i] > centroidBounds.max[axis] - centroidBounds.min[axis])
+            axis = i;
+    }
+    float lo = centroidBounds.min[axis], hi = centroidBounds.max[axis];
+    float scale = hi - lo > 0.0f ? kNumBins / (hi - lo) : 0.0f;
+    if(scale > 0.0f) {
+        Bin bins[kNumBins];
+        for(uint32_t b = 0; b < kNumBins; b++) {
+            bins[b].bounds.reset();
+            bins[b].count = 0;
+        }
+        for(uint32_t i = begin; i < end; i++) {
+            const BuildPrimitive &p = buildPrimitives[i];
+            uint32_t b = std::min(kNumBins - 1, (uint32_t)((p.centroid[axis] - lo) * scale));
+            bins[b].bounds.grow(p.bounds);
+            bins[b].count++;
+        }
+
+        // sweep from right, then from left
+        float rightArea[kNumBins];
+        uint32_t rightCount[kNumBins];
+        Bounds accum;
+        accum.reset();
+        uint32_t accumCount = 0;
+        for(uint32_t b = kNumBins - 1; b > 0; b--) {
+            accum.grow(bins[b].bounds);
+            accumCount += bins[b].count;
+            rightArea[b] = accum.area();
+            rightCount[b] = accumCount;
+        }
+        accum.reset();
+        accumCount = 0;
+        for(uint32_t b = 0; b < kNumBins - 1; b++) {
+            accum.grow(bins[b].bounds);
+            accumCount += bins[b].count;
+            if(accumCount == 0 || rightCount[b + 1] == 0)
+                continue;
+            float cost = accum.area() * accumCount + rightArea[b + 1] * rightCount[b + 1];
+            if(cost < bestCost) {
+                bestCost = cost;
+                bestBin = b;
+            }
+        }
+    }
+
+    float leafCost = bounds.area() * numPrimitives;
+    if(numPrimitives <= kMaxLeafSize && (bestBin == kNumBins || leafCost <= bestCost)) {
+        makeLeaf(nodeIndex, begin, end);
+        return nodeIndex;
+    }
+
+    uint32_t mid;
+    if(bestBin < kNumBins) {
+        BuildPrimitive *first = buildPrimitives.data();
+        BuildPrimitive *split = std::partition(first + begin, first + end, [&](const BuildPrimitive &p) {
+            uint32_t b = std::min(kNumBins - 1, (uint32_t)((p.centroid[axis] - lo) * scale));
+            return b <= bestBin;
+        });
+        mid = (uint32_t)(split - first);
+    }
+    else {
+        // all centroids are the same, split in half
+        mid = begin + numPrimitives / 2;
+    }
+
+    uint32_t left = buildNode(begin, mid, nodeIndex);
+    uint32_t right = buildNode(mid, end, nodeIndex);
+    nodes[nodeIndex].left = left;
+    nodes[nodeIndex].right = right;
+    nodes[nodeIndex].count = 0;
+    return nodeIndex;
+}
+
+void mgp_bvh::makeLeaf(uint32_t node, uint32_t begin, uint32_t end) {
+    nodes[node].first = begin;
+    nodes[node].count = end - begin;
+    nodes[node].left = nodes[node].right = kInvalidIndex;
+    for(uint32_t i = begin; i < end; i++)
+        leafOfSlot[i] = node;
+}
+
+void mgp_bvh::markDirty(uint32_t node) {
+    while(node != kInvalidIndex && !dirty[node]) {
+        dirty[node] = 1;
+        node = nodes[node].parent;
+    }
+}
+
+void mgp_bvh::refitNode(uint32_t nodeIndex) {
+    if(!dirty[nodeIndex])
+        return;
+    dirty[nodeIndex] = 0;
+
+    Node &node = nodes[nodeIndex];
+    if(node.isLeaf()) {
+        node.bounds.reset();
+        for(uint32_t i = node.first; i < node.first + node.count; i++)
+            node.bounds.grow(primitives[i].bounds());
+        return;
+    }
+    refitNode(node.left);
+    refitNode(node.right);
+    nodes[nodeIndex].bounds = merged(nodes[node.left].bounds, nodes[node.right].bounds);
+    rotate(nodeIndex);
+}
+
+// Tree rotation (Kopta et al. 2012) : swaps a child with a grandchild on the
+// other side if it shrinks the surface area of the grandchild's parent.
+void mgp_bvh::rotate(uint32_t nodeIndex) {
+    uint32_t children[2] = { nodes[nodeIndex].left, nodes[nodeIndex].right };
+
+    float bestGain = 0.0f;
+    uint32_t bestChild = kInvalidIndex;     // child moved down
+    uint32_t bestGrandchild = kInvalidIndex; // grandchild moved up
+    for(int side = 0; side < 2; side++) {
+        const Node &child = nodes[children[side]];
+        const Node &sibling = nodes[children[1 - side]];
+        if(sibling.isLeaf())
+            continue;
+        float siblingArea = sibling.bounds.area();
+        uint32_t grandchildren[2] = { sibling.left, sibling.right };
+        for(int g = 0; g < 2; g++) {
+            // sibling would contain the child and the other grandchild
+            float newArea = merged(child.bounds, nodes[grandchildren[1 - g]].bounds).area();
+            float gain = siblingArea - newArea;
+            if(gain > bestGain) {
+                bestGain = gain;
+                bestChild = children[side];
+                bestGrandchild = grandchildren[g];
+            }
+        }
+    }
+    if(bestChild == kInvalidIndex)
+        return;
+
+    uint32_t siblingIndex = nodes[bestGrandchild].parent;
+    Node &node = nodes[nodeIndex];
+    Node &sibling = nodes[siblingIndex];
+    if(node.left == bestChild)
+        node.left = bestGrandchild;
+    else
+        node.right = bestGrandchild;
+    if(sibling.left == bestGrandchild)
+        sibling.left = bestChild;
+    else
+        sibling.right = bestChild;
+    nodes[bestGrandchild].parent = nodeIndex;
+    nodes[bestChild].parent = siblingIndex;
+    sibling.bounds = merged(nodes[sibling.left].bounds, nodes[sibling.right].bounds);
+}
+
+template<typename RangeVisitor, typename SlotVisitor>
+void mgp_bvh::cull(const mgp_cull_planes_t *planes, RangeVisitor onRange, SlotVisitor onSlot) {
+    if(numTreePrimitives < primitives.size())
+        onRange((uint32_t)numTreePrimitives, (uint32_t)(primitives.size() - numTreePrimitives));
+    if(root == kInvalidIndex)
+        return;
+
+    stack.clear();
+    stack.emplace_back(root, allPlanesMask(planes));
+    while(!stack.empty()) {
+        uint32_t nodeIndex = stack.back().first;
+        uint32_t mask = stack.back().second;
+        stack.pop_back();
+
+        const Node &node = nodes[nodeIndex];
+        if(mask) {
+            float c[3], e[3];
+            for(int i = 0; i < 3; i++) {
+                c[i] = (node.bounds.min[i] + node.bounds.max[i]) * 0.5f;
+                e[i] = (node.bounds.max[i] - node.bounds.min[i]) * 0.5f;
+            }
+            if(!testPlanes(planes, c, e, &mask))
+                continue;
+        }
+
+        if(!node.isLeaf()) {
+            stack.emplace_back(node.right, mask);
+            stack.emplace_back(node.left, mask);
+        }
+        else if(mask == 0) {
+            onRange(node.first, node.count);
+        }
+        else {
+            for(uint32_t i = node.first; i < node.first + node.count; i++) {
+                uint32_t primitiveMask = mask;
+                if(testPlanes(planes, primitives[i].center, primitives[i].extent, &primitiveMask))
+                    onSlot(i);
+            }
+        }
+    }
+}
+
+mgp_bvh_t *mgp_bvh_create(void) {
+    return new mgp_bvh();
+}
+
+void mgp_bvh_destroy(mgp_bvh_t *bvh) {
+    delete bvh;
+}
+
+void mgp_bvh_build(mgp_bvh_t *bvh, const mgp_aabb_array_t *aabbs) {
+    size_t count = aabbs->count;
+    bvh->count = count;
+    bvh->classes.resize(count);
+    bvh->slotOf.assign(count, kInvalidIndex);
+    bvh->boxes.resize(count);
+    bvh->buildPrimitives.clear();
+
+    std::vector<uint32_t> alwaysVisible;
+    for(size_t i = 0; i < count; i++) {
+        Primitive &p = bvh->boxes[i];
+        getBox(aabbs, i, &p);
+        PrimitiveClass primitiveClass = classify(p);
+        bvh->classes[i] = primitiveClass;
+        if(primitiveClass == PrimitiveClassAlwaysVisible) {
+            alwaysVisible.push_back((uint32_t)i);
+        }
+        else if(primitiveClass == PrimitiveClassBounded) {
+            BuildPrimitive buildPrimitive;
+            buildPrimitive.bounds = p.bounds();
+            memcpy(buildPrimitive.centroid, p.center, sizeof(float) * 3);
+            buildPrimitive.index = (uint32_t)i;
+            bvh->buildPrimitives.push_back(buildPrimitive);
+        }
+    }
+
+    uint32_t numTreePrimitives = (uint32_t)bvh->buildPrimitives.size();
+    bvh->numTreePrimitives = numTreePrimitives;
+    bvh->leafOfSlot.assign(numTreePrimitives + alwaysVisible.size(), kInvalidIndex);
+
+    bvh->nodes.clear();
+    bvh->nodes.reserve(numTreePrimitives > 0 ? numTreePrimitives * 2 : 0);
+    bvh->root = numTreePrimitives > 0 ? bvh->buildNode(0, numTreePrimitives, kInvalidIndex) : kInvalidIndex;
+    bvh->dirty.assign(bvh->nodes.size(), 0);
+
+    bvh->indices.resize(numTreePrimitives);
+    for(uint32_t slot = 0; slot < numTreePrimitives; slot++)
+        bvh->indices[slot] = bvh->buildPrimitives[slot].index;
+    bvh->indices.insert(bvh->indices.end(), alwaysVisible.begin(), alwaysVisible.end());
+
+    // store primitives in slot order, so leaves are contiguous
+    bvh->primitives.resize(bvh->indices.size());
+    for(size_t slot = 0; slot < bvh->indices.size(); slot++) {
+        uint32_t i = bvh->indices[slot];
+        bvh->primitives[slot] = bvh->boxes[i];
+        bvh->slotOf[i] = (uint32_t)slot;
+    }
+}
+
+void mgp_bvh_refit(mgp_bvh_t *bvh, const mgp_aabb_array_t *aabbs) {
+    if(aabbs->count != bvh->count) {
+        mgp_bvh_build(bvh, aabbs);
+        return;
+    }
+
+    // compare against the last boxes in input order, touching slots only for moved ones
+    for(size_t i = 0; i < aabbs->count; i++) {
+        Primitive &p = bvh->boxes[i];
+        if(p.center[0] == aabbs->center_x[i] && p.center[1] == aabbs->center_y[i] &&
+           p.center[2] == aabbs->center_z[i] && p.extent[0] == aabbs->extent_x[i] &&
+           p.extent[1] == aabbs->extent_y[i] && p.extent[2] == aabbs->extent_z[i])
+            continue;
+
+        getBox(aabbs, i, &p);
+        PrimitiveClass primitiveClass = classify(p);
+        if(primitiveClass != bvh->classes[i]) {
+            mgp_bvh_build(bvh, aabbs);
+            return;
+        }
+        if(primitiveClass == PrimitiveClassBounded) {
+            uint32_t slot = bvh->slotOf[i];
+            bvh->primitives[slot] = p;
+            bvh->markDirty(bvh->leafOfSlot[slot]);
+        }
+    }
+
+    if(bvh->root != kInvalidIndex)
+        bvh->refitNode(bvh->root);
+}
+
+size_t mgp_bvh_cull(mgp_bvh_t *bvh,
+                    const mgp_cull_planes_t *planes,
+                    uint64_t *visibility) {
+    memset(visibility, 0, sizeof(uint64_t) * MGP_CULL_BITSET_WORDS(bvh->count));
+
+    size_t numVisible = 0;
+    const uint32_t *indices = bvh->indices.data();
+    bvh->cull(planes, [&](uint32_t first, uint32_t count) {
+        for(uint32_t slot = first; slot < first + count; slot++) {
+            uint32_t i = indices[slot];
+            visibility[i >> 6] |= 1ull << (i & 63);
+        }
+        numVisible += count;
+    }, [&](uint32_t slot) {
+        uint32_t i = indices[slot];
+        visibility[i >> 6] |= 1ull << (i & 63);
+        numVisible++;
+    });
+    return numVisible;
+}
+
+void mgp_bvh_cull_views(mgp_bvh_t *bvh,
+                        const mgp_cull_planes_t *planes,
+                        size_t numViews,
+                        uint64_t *visibility) {
+    size_t numWords = MGP_CULL_BITSET_WORDS(bvh->count);
+    memset(visibility, 0, sizeof(uint64_t) * numWords * numViews);
+
+    const uint32_t *indices = bvh->indices.data();
+    for(size_t slot = bvh->numTreePrimitives; slot < bvh->indices.size(); slot++) {
+        uint32_t i = indices[slot];
+        for(size_t view = 0; view < numViews; view++)
+            visibility[view * numWords + (i >> 6)] |= 1ull << (i & 63);
+    }
+    if(bvh->root == kInvalidIndex)
+        return;
+
+    std::vector<ViewStackEntry> &stack = bvh->viewStack;
+    for(size_t firstView = 0; firstView < numViews; firstView += 64) {
+        const mgp_cull_planes_t *groupPlanes = planes + firstView;
+        uint64_t *groupVisibility = visibility + firstView * numWords;
+        size_t numGroupViews = std::min<size_t>(64, numViews - firstView);
+        uint64_t allViews = numGroupViews == 64 ? ~0ull : (1ull << numGroupViews) - 1;
+
+        ViewStackEntry rootEntry;
+        rootEntry.node = bvh->root;
+        rootEntry.intersecting = allViews;
+        rootEntry.inside = 0;
+        for(size_t view = 0; view < numGroupViews; view++)
+            rootEntry.planeMasks[view] = (uint8_t)allPlanesMask(groupPlanes + view);
+
+        stack.clear();
+        stack.push_back(rootEntry);
+        while(!stack.empty()) {
+            ViewStackEntry entry = stack.back();
+            stack.pop_back();
+
+            const Node &node = bvh->nodes[entry.node];
+            if(entry.intersecting) {
+                float c[3], e[3];
+                for(int i = 0; i < 3; i++) {
+                    c[i] = (node.bounds.min[i] + node.bounds.max[i]) * 0.5f;
+                    e[i] = (node.bounds.max[i] - node.bounds.min[i]) * 0.5f;
+                }
+                uint64_t views = entry.intersecting;
+                while(views) {
+                    uint32_t view = __builtin_ctzll(views);
+                    views &= views - 1;
+                    uint32_t mask = entry.planeMasks[view];
+                    if(!testPlanes(groupPlanes + view, c, e, &mask)) {
+                        entry.intersecting &= ~(1ull << view);
+                    }
+                    else if(mask == 0) {
+                        entry.intersecting &= ~(1ull << view);
+                        entry.inside |= 1ull << view;
+                    }
+                    entry.planeMasks[view] = (uint8_t)mask;
+                }
+            }
+            if((entry.intersecting | entry.inside) == 0)
+                continue;
+
+            if(!node.isLeaf()) {
+                entry.node = node.right;
+                stack.push_back(entry);
+                entry.node = node.left;
+                stack.push_back(entry);
+                continue;
+            }
+            for(uint32_t slot = node.first; slot < node.first + node.count; slot++) {
+                uint32_t i = indices[slot];
+                size_t word = i >> 6;
+                uint64_t bit = 1ull << (i & 63);
+                const Primitive &p = bvh->primitives[slot];
+                uint64_t views = entry.intersecting;
+                while(views) {
+                    uint32_t view = __builtin_ctzll(views);
+                    views &= views - 1;
+                    uint32_t mask = entry.planeMasks[view];
+                    if(testPlanes(groupPlanes + view, p.center, p.extent, &mask))
+                        groupVisibility[view * numWords + word] |= bit;
+                }
+                views = entry.inside;
+                while(views) {
+                    uint32_t view = __builtin_ctzll(views);
+                    views &= views - 1;
+                    groupVisibility[view * numWords + word] |= bit;
+                }
+            }
+        }
+    }
+}
+
+const mgp_bvh_range_t *mgp_bvh_cull_ranges(mgp_bvh_t *bvh,
+                                           const mgp_cull_planes_t *planes,
+                                           size_t *numRanges) {
+    std::vector<mgp_bvh_range_t> &ranges = bvh->ranges;
+    ranges.clear();
+    auto append = [&](uint32_t first, uint32_t count) {
+        // merge adjacent ranges
+        if(!ranges.empty() && ranges.back().first + ranges.back().count == first)
+            ranges.back().count += count;
+        else
+            ranges.push_back({ first, count });
+    };
+    bvh->cull(planes, append, [&](uint32_t slot) {
+        append(slot, 1);
+    });
+    *numRanges = ranges.size();
+    return ranges.data();
+}
+
+const uint32_t *mgp_bvh_primitive_indices(const mgp_bvh_t *bvh) {
+    return bvh->indices.data();
+}
+
+size_t mgp_bvh_primitive_count(const mgp_bvh_t *bvh) {
+    return bvh->count;
+}
+
+size_t mgp_bvh_node_count(const mgp_bvh_t *bvh) {
+    return bvh->nodes.size();
+}
+
+float mgp_bvh_sah_cost(const mgp_bvh_t *bvh) {
+    if(bvh->root == kInvalidIndex)
+        return 0.0f;
+    float rootArea = bvh->nodes[bvh->root].bounds.area();
+    if(rootArea <= 0.0f)
+        return 0.0f;
+
+    double cost = 0.0;
+    for(const Node &node : bvh->nodes)
+        cost += node.bounds.area() * (node.isLeaf() ? node.count : 1);
+    return (float)(cost / rootArea);
+}
@@ -0,0 +1,72 @@
+//
+//  MGPBVH.h
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/17.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#ifndef MGPBVH_h
+#define MGPBVH_h
+
+#include "MGPCulling.h"
+
+// Dynamic bounding volume hierarchy over world-space boxes.
+// Built with binned SAH, then kept up to date by refitting only the paths
+// of moved boxes and applying tree rotations on them.
+// Culling rejects (or accepts) whole subtrees at once.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct mgp_bvh mgp_bvh_t;
+
+// range of primitive slots, see mgp_bvh_primitive_indices
+typedef struct {
+    uint32_t first;
+    uint32_t count;
+} mgp_bvh_range_t;
+
+mgp_bvh_t *mgp_bvh_create(void);
+void mgp_bvh_destroy(mgp_bvh_t *bvh);
+
+// Rebuilds the whole tree. Boxes with negative extent are never visible,
+// boxes with non-finite extent are always visible.
+void mgp_bvh_build(mgp_bvh_t *bvh, const mgp_aabb_array_t *aabbs);
+
+// Updates the tree with new boxes (same count and order as the last build).
+// Only the ancestors of changed boxes are refitted and rotated.
+// Falls back to a full build if the count or a box's visibility class changes.
+void mgp_bvh_refit(mgp_bvh_t *bvh, const mgp_aabb_array_t *aabbs);
+
+// Writes one bit per box (in build order) into visibility,
+// which must hold MGP_CULL_BITSET_WORDS(count) words. Returns the number of visible boxes.
+size_t mgp_bvh_cull(mgp_bvh_t *bvh,
+                    const mgp_cull_planes_t *planes,
+                    uint64_t *visibility);
+
+// Culls numViews plane sets, traversing the tree once per 64 views.
+// visibility holds one bitset (MGP_CULL_BITSET_WORDS(count) words) per view, one after another.
+void mgp_bvh_cull_views(mgp_bvh_t *bvh,
+                        const mgp_cull_planes_t *planes,
+                        size_t numViews,
+                        uint64_t *visibility);
+
+// Returns visible leaf ranges, valid until the next call on this tree.
+// Ranges index into mgp_bvh_primitive_indices.
+const mgp_bvh_range_t *mgp_bvh_cull_ranges(mgp_bvh_t *bvh,
+                                           const mgp_cull_planes_t *planes,
+                                           size_t *numRanges);
+const uint32_t *mgp_bvh_primitive_indices(const mgp_bvh_t *bvh);
+
+size_t mgp_bvh_primitive_count(const mgp_bvh_t *bvh);
+size_t mgp_bvh_node_count(const mgp_bvh_t *bvh);
+// SAH cost of the tree relative to its root surface area (lower is better)
+float mgp_bvh_sah_cost(const mgp_bvh_t *bvh);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MGPBVH_h */
@@ -7,26 +7,20 @@
 //
 
 #import "MGPBoundingVolume.h"
-#import "MGPPlane.h"
 #import "MGPFrustum.h"
+#import "MGPCulling.h"
 
 @implementation MGPBoundingBox
 
 @synthesize position = _position;
 
 - (BOOL)isCulledInFrustum:(MGPFrustum *)frustum {
-    BOOL isCulled = NO;
-    simd_float3 abs_extent = simd_abs(_extent);
-    NSArray<MGPPlane*> *planes = frustum.planes;
-    for(MGPPlane *plane in planes) {
-        float distance = [plane distanceToPosition: _position];
-        float radius = simd_dot(simd_abs(plane.normal), abs_extent);
-        if(distance < -radius) {
-            isCulled = YES;
-            break;
-        }
-    }
-    return isCulled;
+    mgp_cull_planes_t planes;
+    [frustum getCullingPlanes:&planes];
+    simd_float3 absExtent = simd_abs(_extent);
+    float center[3] = { _position.x, _position.y, _position.z };
+    float extent[3] = { absExtent.x, absExtent.y, absExtent.z };
+    return !mgp_cull_aabb_is_visible(&planes, center, extent);
 }
 
 @end
@@ -36,16 +30,10 @@
 @synthesize position = _position;
 
 - (BOOL)isCulledInFrustum:(MGPFrustum *)frustum {
-    BOOL isCulled = NO;
-    NSArray<MGPPlane*> *planes = frustum.planes;
-    for(MGPPlane *plane in planes) {
-        float distance = [plane distanceToPosition: _position];
-        if(distance < -_radius) {
-            isCulled = YES;
-            break;
-        }
-    }
-    return isCulled;
+    mgp_cull_planes_t planes;
+    [frustum getCullingPlanes:&planes];
+    float center[3] = { _position.x, _position.y, _position.z };
+    return !mgp_cull_sphere_is_visible(&planes, center, _radius);
 }
 
 @end
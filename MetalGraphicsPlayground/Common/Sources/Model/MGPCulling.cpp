@@ -0,0 +1,394 @@
+//
+//  MGPCulling.cpp
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/17.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#include "MGPCulling.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include <stdint.h>
+
+// MGP_CULL_SCALAR forces the scalar loop, which gives the same visibility.
+#if defined(MGP_CULL_SCALAR)
+#elif defined(__AVX__)
+#include <immintrin.h>
+#define MGP_CULL_AVX 1
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define MGP_CULL_SSE 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define MGP_CULL_NEON 1
+#endif
+
+namespace {
+
+// volumes per iteration
+const size_t kBatchSize = 8;
+
+// Allocates numArrays float arrays of the given capacity in a single 32-byte aligned block,
+// keeping the first 'count' elements of the previous arrays.
+// Returns false and keeps the previous arrays if the block can't be allocated.
+bool resizeArrays(float **arrays, size_t numArrays, size_t count, size_t *capacity) {
+    if(count <= *capacity)
+        return true;
+    if(count > SIZE_MAX / (sizeof(float) * numArrays) / 2)
+        return false;
+
+    size_t newCapacity = *capacity ? *capacity : kBatchSize;
+    while(newCapacity < count)
+        newCapacity *= 2;
+
+    void *block = nullptr;
+    if(posix_memalign(&block, 32, sizeof(float) * numArrays * newCapacity) != 0)
+        return false;
+
+    float *newBlock = (float *)block;
+    for(size_t i = 0; i < numArrays; i++) {
+        if(arrays[i])
+            memcpy(newBlock + i * newCapacity, arrays[i], sizeof(float) * (*capacity));
+    }
+    free(arrays[0]);
+    for(size_t i = 0; i < numArrays; i++)
+        arrays[i] = newBlock + i * newCapacity;
+    *capacity = newCapacity;
+    return true;
+}
+
+inline bool isAABBVisible(const mgp_cull_planes_t *planes,
+                          float cx, float cy, float cz,
+                          float ex, float ey, float ez) {
+    for(uint32_t p = 0; p < planes->count; p++) {
+        float distance = planes->nx[p] * cx + planes->ny[p] * cy + planes->nz[p] * cz + planes->d[p];
+        float radius = fabsf(planes->nx[p]) * ex + fabsf(planes->ny[p]) * ey + fabsf(planes->nz[p]) * ez;
+        if(distance < -radius)
+            return false;
+    }
+    return true;
+}
+
+inline bool isSphereVisible(const mgp_cull_planes_t *planes,
+                            float cx, float cy, float cz, float r) {
+    for(uint32_t p = 0; p < planes->count; p++) {
+        float distance = planes->nx[p] * cx + planes->ny[p] * cy + planes->nz[p] * cz + planes->d[p];
+        if(distance < -r)
+            return false;
+    }
+    return true;
+}
+
+// Returns 8-bit visibility mask of volumes [i, i+8)
+#if MGP_CULL_AVX
+inline uint32_t cullAABBBatch(const mgp_cull_planes_t *planes, const mgp_aabb_array_t *a, size_t i) {
+    const __m256 signMask = _mm256_set1_ps(-0.0f);
+    __m256 cx = _mm256_loadu_ps(a->center_x + i);
+    __m256 cy = _mm256_loadu_ps(a->center_y + i);
+    __m256 cz = _mm256_loadu_ps(a->center_z + i);
+    __m256 ex = _mm256_loadu_ps(a->extent_x + i);
+    __m256 ey = _mm256_loadu_ps(a->extent_y + i);
+    __m256 ez = _mm256_loadu_ps(a->extent_z + i);
+    __m256 visible = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+    for(uint32_t p = 0; p < planes->count; p++) {
+        __m256 nx = _mm256_broadcast_ss(planes->nx + p);
+        __m256 ny = _mm256_broadcast_ss(planes->ny + p);
+        __m256 nz = _mm256_broadcast_ss(planes->nz + p);
+        __m256 d = _mm256_broadcast_ss(planes->d + p);
+        __m256 distance = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(nx, cx), _mm256_mul_ps(ny, cy)),
+                                        _mm256_add_ps(_mm256_mul_ps(nz, cz), d));
+        __m256 radius = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_andnot_ps(signMask, nx), ex),
+                                                    _mm256_mul_ps(_mm256_andnot_ps(signMask, ny), ey)),
+                                      _mm256_mul_ps(_mm256_andnot_ps(signMask, nz), ez));
+        visible = _mm256_and_ps(visible, _mm256_cmp_ps(_mm256_add_ps(distance, radius),
+                                                       _mm256_setzero_ps(), _CMP_GE_OQ));
+    }
+    return (uint32_t)_mm256_movemask_ps(visible);
+}
+
+inline uint32_t cullSphereBatch(const mgp_cull_planes_t *planes, const mgp_sphere_array_t *s, size_t i) {
+    __m256 cx = _mm256_loadu_ps(s->center_x + i);
+    __m256 cy = _mm256_loadu_ps(s->center_y + i);
+    __m256 cz = _mm256_loadu_ps(s->center_z + i);
+    __m256 r = _mm256_loadu_ps(s->radius + i);
+    __m256 visible = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+    for(uint32_t p = 0; p < planes->count; p++) {
+        __m256 distance = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_broadcast_ss(planes->nx + p), cx),
+                                                      _mm256_mul_ps(_mm256_broadcast_ss(planes->ny + p), cy)),
+                                        _mm256_add_ps(_mm256_mul_ps(_mm256_broadcast_ss(planes->nz + p), cz),
+                                                      _mm256_broadcast_ss(planes->d + p)));
+        visible = _mm256_and_ps(visible, _mm256_cmp_ps(_mm256_add_ps(distance, r),
+                                                       _mm256_setzero_ps(), _CMP_GE_OQ));
+    }
+    return (uint32_t)_mm256_movemask_ps(visible);
+}
+#elif MGP_CULL_SSE
+// two float4 blocks share the broadcast plane per iteration
+inline uint32_t cullAABBBatch(const mgp_cull_planes_t *planes, const mgp_aabb_array_t *a, size_t i) {
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    __m128 cx0 = _mm_loadu_ps(a->center_x + i), cx1 = _mm_loadu_ps(a->center_x + i + 4);
+    __m128 cy0 = _mm_loadu_ps(a->center_y + i), cy1 = _mm_loadu_ps(a->center_y + i + 4);
+    __m128 cz0 = _mm_loadu_ps(a->center_z + i), cz1 = _mm_loadu_ps(a->center_z + i + 4);
+    __m128 ex0 = _mm_loadu_ps(a->extent_x + i), ex1 = _mm_loadu_ps(a->extent_x + i + 4);
+    __m128 ey0 = _mm_loadu_ps(a->extent_y + i), ey1 = _mm_loadu_ps(a->extent_y + i + 4);
+    __m128 ez0 = _mm_loadu_ps(a->extent_z + i), ez1 = _mm_loadu_ps(a->extent_z + i + 4);
+    __m128 visible0 = _mm_castsi128_ps(_mm_set1_epi32(-1));
+    __m128 visible1 = visible0;
+    for(uint32_t p = 0; p < planes->count; p++) {
+        __m128 nx = _mm_set1_ps(planes->nx[p]);
+        __m128 ny = _mm_set1_ps(planes->ny[p]);
+        __m128 nz = _mm_set1_ps(planes->nz[p]);
+        __m128 d = _mm_set1_ps(planes->d[p]);
+        __m128 ax = _mm_andnot_ps(signMask, nx);
+        __m128 ay = _mm_andnot_ps(signMask, ny);
+        __m128 az = _mm_andnot_ps(signMask, nz);
+        __m128 s0 = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, cx0), _mm_mul_ps(ny, cy0)),
+                                          _mm_add_ps(_mm_mul_ps(nz, cz0), d)),
+                               _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, ex0), _mm_mul_ps(ay, ey0)),
+                                          _mm_mul_ps(az, ez0)));
+        __m128 s1 = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, cx1), _mm_mul_ps(ny, cy1)),
+                                          _mm_add_ps(_mm_mul_ps(nz, cz1), d)),
+                               _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, ex1), _mm_mul_ps(ay, ey1)),
+                                          _mm_mul_ps(az, ez1)));
+        visible0 = _mm_and_ps(visible0, _mm_cmpge_ps(s0, _mm_setzero_ps()));
+        visible1 = _mm_and_ps(visible1, _mm_cmpge_ps(s1, _mm_setzero_ps()));
+    }
+    return (uint32_t)_mm_movemask_ps(visible0) | ((uint32_t)_mm_movemask_ps(visible1) << 4);
+}
+
+inline uint32_t cullSphereBatch(const mgp_cull_planes_t *planes, const mgp_sphere_array_t *s, size_t i) {
+    __m128 cx0 = _mm_loadu_ps(s->center_x + i), cx1 = _mm_loadu_ps(s->center_x + i + 4);
+    __m128 cy0 = _mm_loadu_ps(s->center_y + i), cy1 = _mm_loadu_ps(s->center_y + i + 4);
+    __m128 cz0 = _mm_loadu_ps(s->center_z + i), cz1 = _mm_loadu_ps(s->center_z + i + 4);
+    __m128 r0 = _mm_loadu_ps(s->radius + i), r1 = _mm_loadu_ps(s->radius + i + 4);
+    __m128 visible0 = _mm_castsi128_ps(_mm_set1_epi32(-1));
+    __m128 visible1 = visible0;
+    for(uint32_t p = 0; p < planes->count; p++) {
+        __m128 nx = _mm_set1_ps(planes->nx[p]);
+        __m128 ny = _mm_set1_ps(planes->ny[p]);
+        __m128 nz = _mm_set1_ps(planes->nz[p]);
+        __m128 d = _mm_set1_ps(planes->d[p]);
+        __m128 s0 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, cx0), _mm_mul_ps(ny, cy0)),
+                               _mm_add_ps(_mm_mul_ps(nz, cz0), _mm_add_ps(d, r0)));
+        __m128 s1 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, cx1), _mm_mul_ps(ny, cy1)),
+                               _mm_add_ps(_mm_mul_ps(nz, cz1), _mm_add_ps(d, r1)));
+        visible0 = _mm_and_ps(visible0, _mm_cmpge_ps(s0, _mm_setzero_ps()));
+        visible1 = _mm_and_ps(visible1, _mm_cmpge_ps(s1, _mm_setzero_ps()));
+    }
+    return (uint32_t)_mm_movemask_ps(visible0) | ((uint32_t)_mm_movemask_ps(visible1) << 4);
+}
+#elif MGP_CULL_NEON
+inline uint32_t movemask(uint32x4_t mask) {
+    static const uint32_t bits[4] = { 1, 2, 4, 8 };
+    return vaddvq_u32(vandq_u32(mask, vld1q_u32(bits)));
+}
+
+inline uint32x4_t cullAABB4(const mgp_cull_planes_t *planes,
+                            float32x4_t cx, float32x4_t cy, float32x4_t cz,
+                            float32x4_t ex, float32x4_t ey, float32x4_t ez) {
+    uint32x4_t visible = vdupq_n_u32(0xFFFFFFFF);
+    for(uint32_t p = 0; p < planes->count; p++) {
+        float32x4_t nx = vdupq_n_f32(planes->nx[p]);
+        float32x4_t ny = vdupq_n_f32(planes->ny[p]);
+        float32x4_t nz = vdupq_n_f32(planes->nz[p]);
+        float32x4_t distance = vmlaq_f32(vmlaq_f32(vmlaq_f32(vdupq_n_f32(planes->d[p]), nx, cx), ny, cy), nz, cz);
+        float32x4_t radius = vmlaq_f32(vmlaq_f32(vmulq_f32(vabsq_f32(nx), ex), vabsq_f32(ny), ey), vabsq_f32(nz), ez);
+        visible = vandq_u32(visible, vcgeq_f32(vaddq_f32(distance, radius), vdupq_n_f32(0.0f)));
+    }
+    return visible;
+}
+
+inline uint32_t cullAABBBatch(const mgp_cull_planes_t *planes, const mgp_aabb_array_t *a, size_t i) {
+    uint32x4_t lo = cullAABB4(planes,
+                              vld1q_f32(a->center_x + i), vld1q_f32(a->center_y + i), vld1q_f32(a->center_z + i),
+                              vld1q_f32(a->extent_x + i), vld1q_f32(a->extent_y + i), vld1q_f32(a->extent_z + i));
+    uint32x4_t hi = cullAABB4(planes,
+                              vld1q_f32(a->center_x + i + 4), vld1q_f32(a->center_y + i + 4), vld1q_f32(a->center_z + i + 4),
+                              vld1q_f32(a->extent_x + i + 4), vld1q_f32(a->extent_y + i + 4), vld1q_f32(a->extent_z + i + 4));
+    return movemask(lo) | (movemask(hi) << 4);
+}
+
+inline uint32x4_t cullSphere4(const mgp_cull_planes_t *planes,
+                              float32x4_t cx, float32x4_t cy, float32x4_t cz, float32x4_t r) {
+    uint32x4_t visible = vdupq_n_u32(0xFFFFFFFF);
+    for(uint32_t p = 0; p < planes->count; p++) {
+        float32x4_t distance = vmlaq_f32(vmlaq_f32(vmlaq_f32(vdupq_n_f32(planes->d[p]),
+                                                             vdupq_n_f32(planes->nx[p]), cx),
+                                                   vdupq_n_f32(planes->ny[p]), cy),
+                                         vdupq_n_f32(planes->nz[p]), cz);
+        visible = vandq_u32(visible, vcgeq_f32(vaddq_f32(distance, r), vdupq_n_f32(0.0f)));
+    }
+    return visible;
+}
+
+inline uint32_t cullSphereBatch(const mgp_cull_planes_t *planes, const mgp_sphere_array_t *s, size_t i) {
+    uint32x4_t lo = cullSphere4(planes, vld1q_f32(s->center_x + i), vld1q_f32(s->center_y + i),
+                                vld1q_f32(s->center_z + i), vld1q_f32(s->radius + i));
+    uint32x4_t hi = cullSphere4(planes, vld1q_f32(s->center_x + i + 4), vld1q_f32(s->center_y + i + 4),
+                                vld1q_f32(s->center_z + i + 4), vld1q_f32(s->radius + i + 4));
+    return movemask(lo) | (movemask(hi) << 4);
+}
+#else
+inline uint32_t cullAABBBatch(const mgp_cull_planes_t *planes, const mgp_aabb_array_t *a, size_t i) {
+    uint32_t mask = 0;
+    for(size_t j = 0; j < kBatchSize; j++) {
+        if(isAABBVisible(planes,
+                         a->center_x[i+j], a->center_y[i+j], a->center_z[i+j],
+                         a->extent_x[i+j], a->extent_y[i+j], a->extent_z[i+j]))
+            mask |= 1u << j;
+    }
+    return mask;
+}
+
+inline uint32_t cullSphereBatch(const mgp_cull_planes_t *planes, const mgp_sphere_array_t *s, size_t i) {
+    uint32_t mask = 0;
+    for(size_t j = 0; j < kBatchSize; j++) {
+        if(isSphereVisible(planes, s->center_x[i+j], s->center_y[i+j], s->center_z[i+j], s->radius[i+j]))
+            mask |= 1u << j;
+    }
+    return mask;
+}
+#endif
+
+} // namespace
+
+void mgp_cull_planes_make(mgp_cull_planes_t *planes,
+                          const float (*equations)[4],
+                          uint32_t count) {
+    if(count > MGP_CULL_MAX_PLANES)
+        count = MGP_CULL_MAX_PLANES;
+
+    // unused planes never reject anything
+    for(uint32_t i = 0; i < MGP_CULL_MAX_PLANES; i++) {
+        planes->nx[i] = 0.0f;
+        planes->ny[i] = 0.0f;
+        planes->nz[i] = 0.0f;
+        planes->d[i] = FLT_MAX;
+    }
+    for(uint32_t i = 0; i < count; i++) {
+        planes->nx[i] = equations[i][0];
+        planes->ny[i] = equations[i][1];
+        planes->nz[i] = equations[i][2];
+        planes->d[i] = equations[i][3];
+    }
+    planes->count = count;
+}
+
+int mgp_aabb_array_resize(mgp_aabb_array_t *array, size_t count) {
+    float *arrays[6] = {
+        array->center_x, array->center_y, array->center_z,
+        array->extent_x, array->extent_y, array->extent_z
+    };
+    if(!resizeArrays(arrays, 6, count, &array->capacity))
+        return 0;
+    array->center_x = arrays[0];
+    array->center_y = arrays[1];
+    array->center_z = arrays[2];
+    array->extent_x = arrays[3];
+    array->extent_y = arrays[4];
+    array->extent_z = arrays[5];
+    array->count = count;
+    return 1;
+}
+
+void mgp_aabb_array_free(mgp_aabb_array_t *array) {
+    free(array->center_x);
+    memset(array, 0, sizeof(mgp_aabb_array_t));
+}
+
+int mgp_sphere_array_resize(mgp_sphere_array_t *array, size_t count) {
+    float *arrays[4] = { array->center_x, array->center_y, array->center_z, array->radius };
+    if(!resizeArrays(arrays, 4, count, &array->capacity))
+        return 0;
+    array->center_x = arrays[0];
+    array->center_y = arrays[1];
+    array->center_z = arrays[2];
+    array->radius = arrays[3];
+    array->count = count;
+    return 1;
+}
+
+void mgp_sphere_array_free(mgp_sphere_array_t *array) {
+    free(array->center_x);
+    memset(array, 0, sizeof(mgp_sphere_array_t));
+}
+
+size_t mgp_cull_aabbs(const mgp_cull_planes_t *planes,
+                      const mgp_aabb_array_t *aabbs,
+                      uint64_t *visibility) {
+    size_t count = aabbs->count;
+    size_t numVisible = 0;
+    memset(visibility, 0, sizeof(uint64_t) * MGP_CULL_BITSET_WORDS(count));
+
+    size_t i = 0;
+    for(; i + kBatchSize <= count; i += kBatchSize) {
+        uint64_t mask = cullAABBBatch(planes, aabbs, i);
+        visibility[i >> 6] |= mask << (i & 63);
+        numVisible += __builtin_popcountll(mask);
+    }
+    for(; i < count; i++) {
+        if(isAABBVisible(planes,
+                         aabbs->center_x[i], aabbs->center_y[i], aabbs->center_z[i],
+                         aabbs->extent_x[i], aabbs->extent_y[i], aabbs->extent_z[i])) {
+            visibility[i >> 6] |= 1ull << (i & 63);
+            numVisible++;
+        }
+    }
+    return numVisible;
+}
+
+size_t mgp_cull_spheres(const mgp_cull_planes_t *planes,
+                        const mgp_sphere_array_t *spheres,
+                        uint64_t *visibility) {
+    size_t count = spheres->count;
+    size_t numVisible = 0;
+    memset(visibility, 0, sizeof(uint64_t) * MGP_CULL_BITSET_WORDS(count));
+
+    size_t i = 0;
+    for(; i + kBatchSize <= count; i += kBatchSize) {
+        uint64_t mask = cullSphereBatch(planes, spheres, i);
+        visibility[i >> 6] |= mask << (i & 63);
+        numVisible += __builtin_popcountll(mask);
+    }
+    for(; i < count; i++) {
+        if(isSphereVisible(planes, spheres->center_x[i], spheres->center_y[i],
+                           spheres->center_z[i], spheres->radius[i])) {
+            visibility[i >> 6] |= 1ull << (i & 63);
+            numVisible++;
+        }
+    }
+    return numVisible;
+}
+
+void mgp_aabb_transform(const float matrix[16],
+                        const float center[3], const float extent[3],
+                        float outCenter[3], float outExtent[3]) {
+    float c[3], e[3];
+    for(int row = 0; row < 3; row++) {
+        c[row] = matrix[12 + row];
+        e[row] = 0.0f;
+        for(int col = 0; col < 3; col++) {
+            float m = matrix[col * 4 + row];
+            c[row] += m * center[col];
+            e[row] += fabsf(m) * extent[col];
+        }
+    }
+    for(int i = 0; i < 3; i++) {
+        outCenter[i] = c[i];
+        outExtent[i] = e[i];
+    }
+}
+
+int mgp_cull_aabb_is_visible(const mgp_cull_planes_t *planes,
+                             const float center[3], const float extent[3]) {
+    return isAABBVisible(planes, center[0], center[1], center[2], extent[0], extent[1], extent[2]);
+}
+
+int mgp_cull_sphere_is_visible(const mgp_cull_planes_t *planes,
+                               const float center[3], float radius) {
+    return isSphereVisible(planes, center[0], center[1], center[2], radius);
+}
@@ -0,0 +1,97 @@
+//
+//  MGPCulling.h
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/17.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#ifndef MGPCulling_h
+#define MGPCulling_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Portable batched frustum culling.
+// Planes and volumes are stored as SoA so boxes can be tested 8 at a time
+// with AVX, SSE or NEON. Results are written into a visibility bitset.
+
+#define MGP_CULL_MAX_PLANES 8
+#define MGP_CULL_BITSET_WORDS(count) (((count) + 63) / 64)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// world-space planes (normal inside), each component packed as two float4 blocks
+typedef struct __attribute__((__aligned__(32))) {
+    float nx[MGP_CULL_MAX_PLANES];
+    float ny[MGP_CULL_MAX_PLANES];
+    float nz[MGP_CULL_MAX_PLANES];
+    float d[MGP_CULL_MAX_PLANES];
+    uint32_t count;
+} mgp_cull_planes_t;
+
+// axis-aligned bounding boxes (center, non-negative half extent)
+typedef struct {
+    float *center_x, *center_y, *center_z;
+    float *extent_x, *extent_y, *extent_z;
+    size_t count;
+    size_t capacity;
+} mgp_aabb_array_t;
+
+// bounding spheres
+typedef struct {
+    float *center_x, *center_y, *center_z;
+    float *radius;
+    size_t count;
+    size_t capacity;
+} mgp_sphere_array_t;
+
+// equations : <A,B,C,D> a.k.a. Ax+By+Cz+D=0
+void mgp_cull_planes_make(mgp_cull_planes_t *planes,
+                          const float (*equations)[4],
+                          uint32_t count);
+
+// Returns 0 if the arrays couldn't grow, leaving them (and count) as they were.
+int mgp_aabb_array_resize(mgp_aabb_array_t *array, size_t count);
+void mgp_aabb_array_free(mgp_aabb_array_t *array);
+int mgp_sphere_array_resize(mgp_sphere_array_t *array, size_t count);
+void mgp_sphere_array_free(mgp_sphere_array_t *array);
+
+static inline void mgp_aabb_array_set(mgp_aabb_array_t *array, size_t index,
+                                      const float center[3], const float extent[3]) {
+    array->center_x[index] = center[0];
+    array->center_y[index] = center[1];
+    array->center_z[index] = center[2];
+    array->extent_x[index] = extent[0];
+    array->extent_y[index] = extent[1];
+    array->extent_z[index] = extent[2];
+}
+
+// Writes one bit per volume (1 : visible) into visibility, which must hold
+// MGP_CULL_BITSET_WORDS(count) words. Returns the number of visible volumes.
+size_t mgp_cull_aabbs(const mgp_cull_planes_t *planes,
+                      const mgp_aabb_array_t *aabbs,
+                      uint64_t *visibility);
+size_t mgp_cull_spheres(const mgp_cull_planes_t *planes,
+                        const mgp_sphere_array_t *spheres,
+                        uint64_t *visibility);
+
+// Transforms a box by a column-major 4x4 affine matrix, yielding the
+// world-space box that encloses it. (center' = M*center, extent' = |M|*extent)
+void mgp_aabb_transform(const float matrix[16],
+                        const float center[3], const float extent[3],
+                        float outCenter[3], float outExtent[3]);
+
+// Single volume tests (scalar)
+int mgp_cull_aabb_is_visible(const mgp_cull_planes_t *planes,
+                             const float center[3], const float extent[3]);
+int mgp_cull_sphere_is_visible(const mgp_cull_planes_t *planes,
+                               const float center[3], float radius);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MGPCulling_h */
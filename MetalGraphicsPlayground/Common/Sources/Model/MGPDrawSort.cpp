@@ -0,0 +1,83 @@
+//
+//  MGPDrawSort.cpp
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/17.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#include "MGPDrawSort.h"
+
+#include <string.h>
+#include <algorithm>
+
+uint32_t mgp_draw_key_depth(float depth, float maxDepth) {
+    const uint32_t maxValue = (1u << MGP_DRAW_KEY_DEPTH_BITS) - 1;
+    if(!(maxDepth > 0.0f))
+        return 0;
+    float t = depth / maxDepth;
+    if(!(t > 0.0f))
+        return 0;
+    if(t >= 1.0f)
+        return maxValue;
+    return (uint32_t)(t * (float)maxValue);
+}
+
+uint32_t mgp_draw_key_hash(const void *const *objects, size_t count, uint32_t bits) {
+    // FNV-1a over the pointers, then folded
+    uint64_t hash = 14695981039346656037ull;
+    for(size_t i = 0; i < count; i++) {
+        uint64_t value = (uint64_t)(uintptr_t)objects[i];
+        for(int byte = 0; byte < 8; byte++) {
+            hash ^= (value >> (byte * 8)) & 0xff;
+            hash *= 1099511628211ull;
+        }
+    }
+    hash ^= hash >> 32;
+    hash ^= hash >> 16;
+    return (uint32_t)hash & ((1u << bits) - 1);
+}
+
+void mgp_draw_keys_sort(uint64_t *keys, uint32_t *values,
+                        uint64_t *tempKeys, uint32_t *tempValues,
+                        size_t count) {
+    if(count < 2)
+        return;
+
+    // histograms of all 8 bytes in one read
+    size_t counts[8][256];
+    memset(counts, 0, sizeof(counts));
+    for(size_t i = 0; i < count; i++) {
+        uint64_t key = keys[i];
+        for(int pass = 0; pass < 8; pass++)
+            counts[pass][(key >> (pass * 8)) & 0xff]++;
+    }
+
+    uint64_t *srcKeys = keys, *dstKeys = tempKeys;
+    uint32_t *srcValues = values, *dstValues = tempValues;
+    for(int pass = 0; pass < 8; pass++) {
+        size_t *histogram = counts[pass];
+        const int shift = pass * 8;
+        if(histogram[(srcKeys[0] >> shift) & 0xff] == count)
+            continue;
+
+        size_t offset = 0;
+        for(int digit = 0; digit < 256; digit++) {
+            size_t digitCount = histogram[digit];
+            histogram[digit] = offset;
+            offset += digitCount;
+        }
+        for(size_t i = 0; i < count; i++) {
+            size_t index = histogram[(srcKeys[i] >> shift) & 0xff]++;
+            dstKeys[index] = srcKeys[i];
+            dstValues[index] = srcValues[i];
+        }
+        std::swap(srcKeys, dstKeys);
+        std::swap(srcValues, dstValues);
+    }
+
+    if(srcKeys != keys) {
+        memcpy(keys, srcKeys, sizeof(uint64_t) * count);
+        memcpy(values, srcValues, sizeof(uint32_t) * count);
+    }
+}
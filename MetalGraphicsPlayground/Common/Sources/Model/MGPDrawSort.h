@@ -0,0 +1,63 @@
+//
+//  MGPDrawSort.h
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/17.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#ifndef MGPDrawSort_h
+#define MGPDrawSort_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+// 64-bit draw sort keys, from the most significant bits :
+// pass (4) | pipeline (8) | texture set (16) | mesh (16) | depth (20)
+// Sorting them in ascending order groups draws by encoder state first,
+// then draws the same mesh front-to-back.
+
+#define MGP_DRAW_KEY_PASS_BITS 4
+#define MGP_DRAW_KEY_PIPELINE_BITS 8
+#define MGP_DRAW_KEY_TEXTURE_SET_BITS 16
+#define MGP_DRAW_KEY_MESH_BITS 16
+#define MGP_DRAW_KEY_DEPTH_BITS 20
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+static inline uint64_t mgp_draw_key_make(uint32_t pass, uint32_t pipeline, uint32_t textureSet,
+                                         uint32_t mesh, uint32_t depth) {
+    uint64_t key = pass & ((1u << MGP_DRAW_KEY_PASS_BITS) - 1);
+    key = (key << MGP_DRAW_KEY_PIPELINE_BITS) | (pipeline & ((1u << MGP_DRAW_KEY_PIPELINE_BITS) - 1));
+    key = (key << MGP_DRAW_KEY_TEXTURE_SET_BITS) | (textureSet & ((1u << MGP_DRAW_KEY_TEXTURE_SET_BITS) - 1));
+    key = (key << MGP_DRAW_KEY_MESH_BITS) | (mesh & ((1u << MGP_DRAW_KEY_MESH_BITS) - 1));
+    key = (key << MGP_DRAW_KEY_DEPTH_BITS) | (depth & ((1u << MGP_DRAW_KEY_DEPTH_BITS) - 1));
+    return key;
+}
+
+static inline uint32_t mgp_draw_key_pipeline(uint64_t key) {
+    return (uint32_t)(key >> (MGP_DRAW_KEY_DEPTH_BITS + MGP_DRAW_KEY_MESH_BITS + MGP_DRAW_KEY_TEXTURE_SET_BITS))
+        & ((1u << MGP_DRAW_KEY_PIPELINE_BITS) - 1);
+}
+
+// Quantizes depth in [0, maxDepth] (smaller is nearer), clamped.
+uint32_t mgp_draw_key_depth(float depth, float maxDepth);
+
+// Identifier of a set of objects for a key field, equal for equal sets.
+// Different sets can collide, which only makes sorting less effective.
+uint32_t mgp_draw_key_hash(const void *const *objects, size_t count, uint32_t bits);
+
+// Sorts keys in ascending order with LSD radix sort (8 bits per pass, stable),
+// moving values along. Passes where every key has the same byte are skipped.
+// tempKeys and tempValues must hold count elements.
+void mgp_draw_keys_sort(uint64_t *keys, uint32_t *values,
+                        uint64_t *tempKeys, uint32_t *tempValues,
+                        size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MGPDrawSort_h */
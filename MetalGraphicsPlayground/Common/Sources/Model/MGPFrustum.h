@@ -10,6 +10,7 @@
 #import <simd/simd.h>
 #import "SharedStructures.h"
 #import "MGPProjectionState.h"
+#import "MGPCulling.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -20,6 +21,11 @@ NS_ASSUME_NONNULL_BEGIN
 
 // world-space 6 planes (near, far, left, right, bottom, top), normal inside
 @property (nonatomic, readonly) NSArray<MGPPlane*> *planes;
+// projection the planes were made with, for sizes on the screen
+@property (nonatomic, readonly) MGPProjectionState projectionState;
+// for back-face tests : world position with w 1, or the direction eyes look from with w 0
+// if orthographic, zero if the projection is in between
+@property (nonatomic, readonly) simd_float4 eye;
 
 - (instancetype)initWithCamera: (MGPCamera *)camera;
 - (void)setPlanesForCamera: (MGPCamera *)camera;
@@ -30,6 +36,9 @@ NS_ASSUME_NONNULL_BEGIN
 - (void)multiplyMatrix: (simd_float4x4)matrix;
 - (MGPFrustum *)frustumByMultipliedWithMatrix: (simd_float4x4)matrix;
 
+// packs plane equations for batched culling
+- (void)getCullingPlanes: (mgp_cull_planes_t *)cullingPlanes;
+
 @end
 
 NS_ASSUME_NONNULL_END
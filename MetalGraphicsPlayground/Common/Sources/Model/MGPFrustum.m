@@ -48,6 +48,7 @@
 
 - (void)setPlanesWithProjectionState:(MGPProjectionState)proj
                               matrix:(simd_float4x4)matrix {
+    _projectionState = proj;
     simd_float3 position = matrix.columns[3].xyz;
     
     // basis vectors and related constants
@@ -57,6 +58,12 @@
     float centerZ = (proj.nearPlane + proj.farPlane) * 0.5f;
     float tanHalfFov = proj.orthographicSize * 0.5f * proj.orthographicRate + tanf(proj.fieldOfView * 0.5f) * (1.0f - proj.orthographicRate);
     float tanHalfFovAspectRatio = tanHalfFov * proj.aspectRatio;
+    if(proj.orthographicRate <= 0.0f)
+        _eye = simd_make_float4(position, 1.0f);
+    else if(proj.orthographicRate >= 1.0f)
+        _eye = simd_make_float4(-forward, 0.0f);
+    else
+        _eye = simd_make_float4(0.0f);
     
     // apply center, normal of planes
     MGPPlane *nearPlane = _planes[0];
@@ -90,11 +97,14 @@
     for(MGPPlane *plane in _planes) {
         [plane multiplyMatrix:matrix];
     }
+    _eye = simd_mul(matrix, _eye);
 }
 
 - (MGPFrustum *)frustumByMultipliedWithMatrix:(simd_float4x4)matrix {
     MGPFrustum *newFrustum = [[MGPFrustum alloc] init];
     [newFrustum _makePlanes];
+    newFrustum->_projectionState = _projectionState;
+    newFrustum->_eye = _eye;
     for(NSUInteger i = 0; i < _planes.count; i++) {
         newFrustum->_planes[i].normal = _planes[i].normal;
         newFrustum->_planes[i].center = _planes[i].center;
@@ -103,4 +113,16 @@
     return newFrustum;
 }
 
+- (void)getCullingPlanes:(mgp_cull_planes_t *)cullingPlanes {
+    float equations[6][4];
+    for(NSUInteger i = 0; i < 6; i++) {
+        simd_float4 equation = _planes[i].equation;
+        equations[i][0] = equation.x;
+        equations[i][1] = equation.y;
+        equations[i][2] = equation.z;
+        equations[i][3] = equation.w;
+    }
+    mgp_cull_planes_make(cullingPlanes, equations, 6);
+}
+
 @end
@@ -11,6 +11,14 @@
 #import "MGPSceneNode.h"
 #import "../Utility/MetalMath.h"
 
+@interface MGPSceneNode (Private)
+- (MGPScene * _Nullable)activeScene;
+@end
+
+@interface MGPScene (Private)
+- (void)lightComponentDidChangeType:(MGPLightComponent *)component;
+@end
+
 @implementation MGPLightComponent
 - (instancetype)init {
     self = [super init];
@@ -44,6 +52,12 @@
     return self;
 }
 
+- (void)setType:(MGPLightType)type {
+    _type = type;
+    if(self.enabled)
+        [self.node.activeScene lightComponentDidChangeType:self];
+}
+
 - (light_t)shaderProperties {
     light_t light;
     
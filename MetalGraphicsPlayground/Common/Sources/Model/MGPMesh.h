@@ -8,12 +8,16 @@
 
 #import <Foundation/Foundation.h>
 #import "../Utility/MGPTextureLoader.h"
+#import "../../Shaders/SharedStructures.h"
 @import ModelIO;
 @import Metal;
 @import MetalKit;
 
 NS_ASSUME_NONNULL_BEGIN
 
+// levels of detail of a mesh, LOD 0 is the mesh itself
+#define MGP_MESH_MAX_LODS 4
+
 @protocol MGPBoundingVolume;
 @interface MGPSubmesh : NSObject
 
@@ -21,6 +25,14 @@ NS_ASSUME_NONNULL_BEGIN
 @property (readonly, nonnull) NSMutableArray *textures;
 @property (nonatomic, readonly) id<MGPBoundingVolume> volume;
 
+// LOD 0 is drawn from metalKitSubmesh, others from lodIndexBuffer of the mesh. (uint32)
+- (NSUInteger)indexCountAtLOD: (NSUInteger)lod;
+- (NSUInteger)indexBufferOffsetAtLOD: (NSUInteger)lod;
+
+// Clusters of LOD 0 for CPU culling, each one a range of the index buffer.
+// nil for submeshes too small to be worth it.
+@property (readonly, nonatomic, nullable) NSData *meshlets;     // mgp_meshlet_t
+
 @end
 
 @interface MGPMesh : NSObject
@@ -53,6 +65,37 @@ NS_ASSUME_NONNULL_BEGIN
 @property (readonly, nonnull) NSArray<MGPSubmesh *> *submeshes;
 @property (readonly, nonatomic) id<MGPBoundingVolume> volume;
 
+// Vertices are quantized when the mesh is loaded with the quantized vertex descriptor
+// of MGPGBuffer, vertexQuantization goes to vertex buffer 4.
+@property (readonly, nonatomic) BOOL usesQuantizedVertices;
+@property (readonly, nonatomic) vertex_quantization_t vertexQuantization;
+
+// LODs are simplified at loading and share the vertices of LOD 0.
+@property (readonly, nonatomic) NSUInteger lodCount;
+@property (readonly, nonatomic, nullable) id<MTLBuffer> lodIndexBuffer;
+@property (readonly, nonatomic) float lodBuildTime;     // seconds
+// Simplification error of a LOD relative to the bounding sphere radius, grows with the LOD.
+- (float)lodErrorAtIndex: (NSUInteger)lod;
+- (NSUInteger)triangleCountAtLOD: (NSUInteger)lod;
+
+// Vertex cache efficiency of all submeshes on a 32-entry FIFO cache, before and after
+// the triangles were reordered at loading. Submeshes that wouldn't improve keep their
+// order. 0 for meshes that aren't triangle lists.
+@property (readonly, nonatomic) float vertexCacheACMRBefore;
+@property (readonly, nonatomic) float vertexCacheACMRAfter;
+@property (readonly, nonatomic) float vertexCacheATVRBefore;
+@property (readonly, nonatomic) float vertexCacheATVRAfter;
+
+// Seconds spent on normals and tangents at loading.
+@property (readonly, nonatomic) float tangentSpaceBuildTime;
+
+// Meshlets of all submeshes.
+@property (readonly, nonatomic) NSUInteger meshletCount;
+
+// CPU-side triangles for software occlusion culling, nil if the mesh is too detailed.
+@property (readonly, nonatomic, nullable) NSData *occluderVertices;   // packed float3
+@property (readonly, nonatomic, nullable) NSData *occluderIndices;    // uint32_t triangle list
+
 @end
 
 NS_ASSUME_NONNULL_END
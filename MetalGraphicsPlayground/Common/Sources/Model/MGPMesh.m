@@ -10,10 +10,55 @@
 #import "../Utility/MGPCommonVertices.h"
 #import "../../Shaders/SharedStructures.h"
 #import "MGPBoundingVolume.h"
+#import "MGPObjImporter.h"
+#import "MGPMeshOptimizer.h"
+#import "MGPVertexQuantizer.h"
+#import "MGPMeshSimplifier.h"
+#import "MGPMeshlets.h"
+#import "MGPTangentSpace.h"
+
+// faces bending less than this (cosine) share normals
+#define NORMAL_CREASE_THRESHOLD 0.2f
+
+// submeshes keep their triangle order unless reordering lowers ACMR on a FIFO cache this large
+#define VERTEX_CACHE_SIZE 32
+// how much worse than the cache order an overdraw cluster may get
+#define OVERDRAW_THRESHOLD 1.05f
+
+// meshes with more triangles than this are not used as occluders
+#define MAX_NUM_OCCLUDER_TRIANGLES 4096
+
+// each LOD aims at this much of the previous one's triangles...
+#define LOD_TRIANGLE_RATIO 0.5f
+// without moving the surface farther than this, relative to the largest extent of the mesh
+#define LOD_TARGET_ERROR 0.05f
+// and is dropped if it keeps more than this of them
+#define LOD_MAX_TRIANGLE_RATIO 0.8f
+// meshes with less triangles than this keep LOD 0 only
+#define MIN_NUM_LOD_TRIANGLES 256
+
+// submeshes with less triangles than this are drawn whole
+#define MIN_NUM_MESHLET_TRIANGLES 1024
+// how much meshlets trade vertices for tighter normal cones
+#define MESHLET_CONE_WEIGHT 0.5f
+
+@interface MGPSubmesh ()
+- (void)setIndexCount: (NSUInteger)indexCount
+    indexBufferOffset: (NSUInteger)indexBufferOffset
+                atLOD: (NSUInteger)lod;
+@property (readwrite, nonatomic, nullable) NSData *meshlets;
+@end
 
 @implementation MGPSubmesh {
     MTKSubmesh *_metalKitSubmesh;
     NSMutableArray *_textures;
+    
+    // textures still streaming, their placeholders are in _textures
+    NSMutableArray *_textureRequests;
+    
+    // LODs above 0, in lodIndexBuffer of the mesh
+    NSUInteger _lodIndexCounts[MGP_MESH_MAX_LODS];
+    NSUInteger _lodIndexBufferOffsets[MGP_MESH_MAX_LODS];
 }
 
 @synthesize metalKitSubmesh = _metalKitSubmesh;
@@ -29,6 +74,7 @@
     if(self) {
         _metalKitSubmesh = mtkSubmesh;
         _textures = [[NSMutableArray alloc] initWithCapacity: tex_total];
+        _textureRequests = [[NSMutableArray alloc] initWithCapacity: tex_total];
         
         MDLMaterialSemantic meterialSemantics[] = {
             MDLMaterialSemanticBaseColor,
@@ -40,15 +86,22 @@
         };
         
         for(NSInteger i = 0; i < tex_total; i++) {
-            id<MTLTexture> texture = [MGPSubmesh createMetalTextureFromMaterial: mdlSubmesh.material
-                                                        modelIOMaterialSemantic: meterialSemantics[i]
-                                                                  textureLoader: textureLoader
-                                                                    textureDict: textureDict];
-            if(texture != nil) {
+            id texture = [MGPSubmesh createMetalTextureFromMaterial: mdlSubmesh.material
+                                            modelIOMaterialSemantic: meterialSemantics[i]
+                                                      textureLoader: textureLoader
+                                                        textureDict: textureDict];
+            if([texture isKindOfClass: MGPTextureRequest.class]) {
+                MGPTextureRequest *request = texture;
+                [_textures addObject: request.texture ?: NSNull.null];
+                [_textureRequests addObject: request];
+            }
+            else if(texture != nil) {
                 [_textures addObject: texture];
+                [_textureRequests addObject: NSNull.null];
             }
             else {
                 [_textures addObject: NSNull.null];
+                [_textureRequests addObject: NSNull.null];
             }
         }
         
@@ -58,6 +111,48 @@
     return self;
 }
 
+- (NSMutableArray *)textures {
+    [self resolveTextureRequests];
+    return _textures;
+}
+
+- (NSUInteger)indexCountAtLOD: (NSUInteger)lod {
+    if(lod == 0)
+        return _metalKitSubmesh.indexCount;
+    return lod < MGP_MESH_MAX_LODS ? _lodIndexCounts[lod] : 0;
+}
+
+- (NSUInteger)indexBufferOffsetAtLOD: (NSUInteger)lod {
+    if(lod == 0)
+        return _metalKitSubmesh.indexBuffer.offset;
+    return lod < MGP_MESH_MAX_LODS ? _lodIndexBufferOffsets[lod] : 0;
+}
+
+- (void)setIndexCount: (NSUInteger)indexCount
+    indexBufferOffset: (NSUInteger)indexBufferOffset
+                atLOD: (NSUInteger)lod {
+    _lodIndexCounts[lod] = indexCount;
+    _lodIndexBufferOffsets[lod] = indexBufferOffset;
+}
+
+// Swaps placeholders for streamed textures, and textures reloaded at another quality.
+// (the placeholder stays if loading failed)
+- (void)resolveTextureRequests {
+    for(NSInteger i = 0; i < _textureRequests.count; i++) {
+        MGPTextureRequest *request = _textureRequests[i];
+        if((id)request == NSNull.null || !request.completed)
+            continue;
+        if(!request.resident) {
+            NSLog(@"%@", request.error);
+            _textureRequests[i] = NSNull.null;
+            continue;
+        }
+        id<MTLTexture> texture = request.texture;
+        if(_textures[i] != texture)
+            _textures[i] = texture;
+    }
+}
+
 - (void)makeBoundingVolumeWithModelIOMesh: (MDLMesh *)mdlMesh
                            modelIOSubmesh: (MDLSubmesh *)mdlSubmesh {
     MDLVertexAttributeData *attributeData = [mdlMesh vertexAttributeDataForAttributeNamed: MDLVertexAttributePosition];
@@ -117,12 +212,28 @@
     _volume = box;
 }
 
-+ (nonnull id<MTLTexture>) createMetalTextureFromMaterial:(nonnull MDLMaterial *)material
-                                  modelIOMaterialSemantic:(MDLMaterialSemantic)materialSemantic
-                                            textureLoader:(nonnull MGPTextureLoader *)textureLoader
-                                              textureDict:(NSMutableDictionary *)textureDict;
+// Placeholder while streaming, neutral for the semantic.
++ (id<MTLTexture>)placeholderTextureForSemantic:(MDLMaterialSemantic)materialSemantic
+                                  textureLoader:(MGPTextureLoader *)textureLoader {
+    switch(materialSemantic) {
+        case MDLMaterialSemanticTangentSpaceNormal:
+            return [textureLoader placeholderTextureWithRed:128 green:128 blue:255 alpha:255];
+        case MDLMaterialSemanticMetallic:
+            return [textureLoader placeholderTextureWithRed:0 green:0 blue:0 alpha:255];
+        case MDLMaterialSemanticAmbientOcclusion:
+            return [textureLoader placeholderTextureWithRed:255 green:255 blue:255 alpha:255];
+        default:
+            return [textureLoader placeholderTextureWithRed:128 green:128 blue:128 alpha:255];
+    }
+}
+
+// Returns a texture, or a MGPTextureRequest if the texture is streamed from a file.
++ (nullable id) createMetalTextureFromMaterial:(nonnull MDLMaterial *)material
+                       modelIOMaterialSemantic:(MDLMaterialSemantic)materialSemantic
+                                 textureLoader:(nonnull MGPTextureLoader *)textureLoader
+                                   textureDict:(NSMutableDictionary *)textureDict;
 {
-    id<MTLTexture> texture;
+    id texture;
     
     NSArray<MDLMaterialProperty *> *propertiesWithSemantic =
     [material propertiesWithSemantic:materialSemantic];
@@ -143,7 +254,7 @@
             }
             
             NSURL *textureURL = [NSURL fileURLWithPath:URLString];
-            NSString *textureName = [URLString lastPathComponent];
+            NSString *textureName = textureURL.path;
             NSError *error = nil;
             
             // Find a texture in the pool
@@ -155,17 +266,17 @@
                 return texture;
             }
             
-            // Attempt to load the texture from the file system
-            texture = [textureLoader newTextureFromURL: textureURL
-                                                 usage: MTLTextureUsageShaderRead
-                                           storageMode: MTLStorageModePrivate
-                                                 error: &error];
-            
-            // If we found a texture using the string as a file path name...
-            if(texture)
+            // Attempt to stream the texture from the file system
+            if([textureURL checkResourceIsReachableAndReturnError: nil])
             {
-                // save a texture in the pool
-                textureDict[texture.label] = texture;
+                // shared with other meshes, released with the mesh
+                texture = [textureLoader retainCachedTextureFromURL: textureURL
+                                                              usage: MTLTextureUsageShaderRead
+                                                        storageMode: MTLStorageModePrivate
+                                                        placeholder: [MGPSubmesh placeholderTextureForSemantic: materialSemantic
+                                                                                                 textureLoader: textureLoader]];
+                // save a request in the pool
+                textureDict[textureName] = texture;
                 // ...return it
                 return texture;
             }
@@ -181,7 +292,7 @@
             // If we found a texture with the string in our asset catalog...
             if(texture) {
                 // save a texture in the pool
-                textureDict[texture.label] = texture;
+                textureDict[textureName] = texture;
                 // ...return it
                 return texture;
             }
@@ -218,11 +329,34 @@
 @implementation MGPMesh {
     MTKMesh *_metalKitMesh;
     NSMutableArray *_submeshes;
-    NSMutableDictionary<NSString*, id<MTLTexture>> *_textureDict;
+    MGPTextureLoader *_textureLoader;
+    NSMutableDictionary<NSString*, id> *_textureDict;      // textures or cached MGPTextureRequests
+    id<MGPBoundingVolume> _volume;
+    NSUInteger _meshletCount;
+    float _tangentSpaceBuildTime;
+    mgp_mesh_cache_stats_t _vertexCacheStatsBefore;
+    mgp_mesh_cache_stats_t _vertexCacheStatsAfter;
+    BOOL _usesQuantizedVertices;
+    vertex_quantization_t _vertexQuantization;
+    
+    // LODs
+    NSUInteger _lodCount;
+    id<MTLBuffer> _lodIndexBuffer;
+    float _lodBuildTime;
+    float _lodErrors[MGP_MESH_MAX_LODS];
+    NSUInteger _lodTriangleCounts[MGP_MESH_MAX_LODS];
 }
 
 @synthesize metalKitMesh = _metalKitMesh;
 @synthesize submeshes = _submeshes;
+@synthesize volume = _volume;
+@synthesize meshletCount = _meshletCount;
+@synthesize tangentSpaceBuildTime = _tangentSpaceBuildTime;
+@synthesize usesQuantizedVertices = _usesQuantizedVertices;
+@synthesize vertexQuantization = _vertexQuantization;
+@synthesize lodCount = _lodCount;
+@synthesize lodIndexBuffer = _lodIndexBuffer;
+@synthesize lodBuildTime = _lodBuildTime;
 
 - (instancetype)initWithModelIOMesh: (MDLMesh *)mdlMesh
             modelIOVertexDescriptor: (nonnull MDLVertexDescriptor *)descriptor
@@ -232,16 +366,26 @@
                               error: (NSError **)error {
     self = [super init];
     if(self) {
-        if(calculateNormals || ![mdlMesh vertexAttributeDataForAttributeNamed: MDLVertexAttributeNormal]) {
-            [mdlMesh addNormalsWithAttributeNamed:MDLVertexAttributeNormal
-                                  creaseThreshold:0.2];
-        }
-        [mdlMesh addTangentBasisForTextureCoordinateAttributeNamed: MDLVertexAttributeTextureCoordinate
-                                              normalAttributeNamed: MDLVertexAttributeNormal
-                                             tangentAttributeNamed: MDLVertexAttributeTangent];
-        mdlMesh.vertexDescriptor = descriptor;
+        NSTimeInterval startTime = [NSDate timeIntervalSinceReferenceDate];
+        BOOL generatesNormals = calculateNormals || ![mdlMesh vertexAttributeDataForAttributeNamed: MDLVertexAttributeNormal];
+        mdlMesh = [MGPMesh _modelIOMeshWithTangentSpace: mdlMesh
+                                       generatesNormals: generatesNormals];
+        _tangentSpaceBuildTime = [NSDate timeIntervalSinceReferenceDate] - startTime;
         
-        MTKMesh *mtkMesh = [[MTKMesh alloc] initWithMesh: mdlMesh
+        // quantized vertices are encoded from the float layout
+        _usesQuantizedVertices = [MGPMesh _isQuantizedVertexDescriptor: descriptor];
+        MDLVertexDescriptor *layoutDescriptor = _usesQuantizedVertices ? [MGPMesh _baseModelIOVertexDescriptor] : descriptor;
+        mdlMesh.vertexDescriptor = layoutDescriptor;
+        [self _optimizeModelIOMesh: mdlMesh
+                  vertexDescriptor: layoutDescriptor];
+        NSArray<NSData*> *meshlets = [MGPMesh _makeMeshletsWithModelIOMesh: mdlMesh];
+        
+        MDLMesh *uploadMesh = mdlMesh;
+        if(_usesQuantizedVertices) {
+            uploadMesh = [self _quantizedModelIOMesh: mdlMesh
+                                    vertexDescriptor: descriptor];
+        }
+        MTKMesh *mtkMesh = [[MTKMesh alloc] initWithMesh: uploadMesh
                                                   device: device
                                                    error: error];
         
@@ -250,7 +394,8 @@
         // init submeshes
         _submeshes = [[NSMutableArray alloc] initWithCapacity: _metalKitMesh.submeshes.count];
         
-        // local texture pool
+        // textures of this mesh, streamed ones are shared through the loader's cache
+        _textureLoader = textureLoader;
         _textureDict = [NSMutableDictionary new];
         
         for(NSInteger i = 0; i < _metalKitMesh.submeshes.count; i++) {
@@ -260,21 +405,527 @@
                                                             textureLoader: textureLoader
                                                               textureDict: _textureDict
                                                                     error: error];
+            if((NSUInteger)i < meshlets.count && meshlets[i].length > 0) {
+                submesh.meshlets = meshlets[i];
+                _meshletCount += meshlets[i].length / sizeof(mgp_meshlet_t);
+            }
             [_submeshes addObject: submesh];
         }
+        
+        [self makeBoundingVolume];
+        [self makeOccluderWithModelIOMesh: mdlMesh];
+        [self makeLODsWithModelIOMesh: mdlMesh
+                               device: device];
     }
     return self;
 }
 
+// Normals (if asked) and tangents by MGPTangentSpace, in the base layout.
+// Split vertices make a new mesh. Meshes of other primitives are left to ModelIO.
++ (MDLMesh *)_modelIOMeshWithTangentSpace: (MDLMesh *)mdlMesh
+                         generatesNormals: (BOOL)generatesNormals {
+    NSUInteger indexCount = 0;
+    BOOL triangles = YES;
+    for(MDLSubmesh *submesh in mdlMesh.submeshes) {
+        triangles &= submesh.geometryType == MDLGeometryTypeTriangles;
+        indexCount += submesh.indexCount;
+    }
+    if(!triangles || indexCount == 0 || mdlMesh.vertexCount == 0) {
+        if(generatesNormals) {
+            [mdlMesh addNormalsWithAttributeNamed: MDLVertexAttributeNormal
+                                  creaseThreshold: NORMAL_CREASE_THRESHOLD];
+        }
+        [mdlMesh addTangentBasisForTextureCoordinateAttributeNamed: MDLVertexAttributeTextureCoordinate
+                                              normalAttributeNamed: MDLVertexAttributeNormal
+                                             tangentAttributeNamed: MDLVertexAttributeTangent];
+        return mdlMesh;
+    }
+    
+    MDLVertexDescriptor *descriptor = [MGPMesh _baseModelIOVertexDescriptor];
+    mdlMesh.vertexDescriptor = descriptor;
+    NSUInteger vertexCount = mdlMesh.vertexCount;
+    
+    // room for every split, pages that stay untouched cost nothing
+    NSMutableData *vertexData = [NSMutableData dataWithLength: (vertexCount + indexCount) * 2 * sizeof(mgp_obj_vertex_t)];
+    NSMutableData *indexData = [NSMutableData dataWithLength: indexCount * sizeof(uint32_t)];
+    memcpy(vertexData.mutableBytes, mdlMesh.vertexBuffers[0].map.bytes, vertexCount * sizeof(mgp_obj_vertex_t));
+    uint32_t *indices = indexData.mutableBytes;
+    NSUInteger indexStart = 0;
+    for(MDLSubmesh *submesh in mdlMesh.submeshes) {
+        id<MDLMeshBuffer> indexBuffer = [submesh indexBufferAsIndexType: MDLIndexBitDepthUInt32];
+        memcpy(indices + indexStart, indexBuffer.map.bytes, submesh.indexCount * sizeof(uint32_t));
+        indexStart += submesh.indexCount;
+    }
+    for(NSUInteger i = 0; i < indexCount; i++) {
+        if(indices[i] >= vertexCount)
+            return mdlMesh;
+    }
+    
+    mgp_tangent_space_layout_t layout = {
+        sizeof(mgp_obj_vertex_t),
+        offsetof(mgp_obj_vertex_t, position),
+        offsetof(mgp_obj_vertex_t, uv),
+        offsetof(mgp_obj_vertex_t, normal),
+        offsetof(mgp_obj_vertex_t, tangent),
+        0
+    };
+    if(generatesNormals) {
+        vertexCount = mgp_tangent_space_generate_normals(vertexData.mutableBytes, indices,
+                                                         vertexData.mutableBytes, vertexCount,
+                                                         indices, indexCount, &layout,
+                                                         NORMAL_CREASE_THRESHOLD, 0);
+    }
+    vertexCount = mgp_tangent_space_generate_tangents(vertexData.mutableBytes, indices,
+                                                      vertexData.mutableBytes, vertexCount,
+                                                      indices, indexCount, &layout, 0);
+    
+    id<MDLMeshBuffer> vertexBuffer = [mdlMesh.allocator newBufferWithData: [NSData dataWithBytesNoCopy: vertexData.mutableBytes
+                                                                                               length: vertexCount * sizeof(mgp_obj_vertex_t)
+                                                                                         freeWhenDone: NO]
+                                                                     type: MDLMeshBufferTypeVertex];
+    NSMutableArray<MDLSubmesh *> *submeshes = [[NSMutableArray alloc] initWithCapacity: mdlMesh.submeshes.count];
+    indexStart = 0;
+    for(MDLSubmesh *submesh in mdlMesh.submeshes) {
+        NSData *submeshIndices = [NSData dataWithBytesNoCopy: indices + indexStart
+                                                      length: submesh.indexCount * sizeof(uint32_t)
+                                                freeWhenDone: NO];
+        id<MDLMeshBuffer> indexBuffer = [mdlMesh.allocator newBufferWithData: submeshIndices
+                                                                        type: MDLMeshBufferTypeIndex];
+        [submeshes addObject: [[MDLSubmesh alloc] initWithName: submesh.name
+                                                   indexBuffer: indexBuffer
+                                                    indexCount: submesh.indexCount
+                                                     indexType: MDLIndexBitDepthUInt32
+                                                  geometryType: submesh.geometryType
+                                                      material: submesh.material]];
+        indexStart += submesh.indexCount;
+    }
+    return [[MDLMesh alloc] initWithVertexBuffer: vertexBuffer
+                                     vertexCount: vertexCount
+                                      descriptor: descriptor
+                                       submeshes: submeshes];
+}
+
++ (BOOL)_isQuantizedVertexDescriptor: (MDLVertexDescriptor *)descriptor {
+    return descriptor.attributes.count > attrib_tangent &&
+        descriptor.attributes[attrib_pos].format == MDLVertexFormatUShort4Normalized &&
+        descriptor.attributes[attrib_normal].format == MDLVertexFormatShort2Normalized;
+}
+
+// Same submeshes over vertices encoded by MGPVertexQuantizer, mdlMesh must be in the base layout.
+- (MDLMesh *)_quantizedModelIOMesh: (MDLMesh *)mdlMesh
+                  vertexDescriptor: (MDLVertexDescriptor *)descriptor {
+    NSUInteger vertexCount = mdlMesh.vertexCount;
+    const uint8_t *vertices = mdlMesh.vertexBuffers[0].map.bytes;
+    mgp_vertex_stream_t stream = {
+        (const float *)(vertices + offsetof(mgp_obj_vertex_t, position)),
+        (const float *)(vertices + offsetof(mgp_obj_vertex_t, uv)),
+        (const float *)(vertices + offsetof(mgp_obj_vertex_t, normal)),
+        (const float *)(vertices + offsetof(mgp_obj_vertex_t, tangent)),
+        sizeof(mgp_obj_vertex_t),
+        vertexCount,
+        0
+    };
+    mgp_vertex_quantization_t quantization;
+    mgp_vertex_quantization_make(&stream, &quantization);
+    _vertexQuantization.offset = simd_make_float4(quantization.offset[0], quantization.offset[1], quantization.offset[2], 0.0f);
+    _vertexQuantization.scale = simd_make_float4(quantization.scale[0], quantization.scale[1], quantization.scale[2], 0.0f);
+    
+    NSMutableData *vertexData = [NSMutableData dataWithLength: vertexCount * sizeof(mgp_quantized_vertex_t)];
+    mgp_vertex_quantize(vertexData.mutableBytes, &stream, &quantization);
+    id<MDLMeshBuffer> vertexBuffer = [mdlMesh.allocator newBufferWithData: vertexData
+                                                                     type: MDLMeshBufferTypeVertex];
+    
+    NSMutableArray<MDLSubmesh *> *submeshes = [[NSMutableArray alloc] initWithCapacity: mdlMesh.submeshes.count];
+    for(MDLSubmesh *submesh in mdlMesh.submeshes) {
+        [submeshes addObject: [[MDLSubmesh alloc] initWithName: submesh.name
+                                                   indexBuffer: submesh.indexBuffer
+                                                    indexCount: submesh.indexCount
+                                                     indexType: submesh.indexType
+                                                  geometryType: submesh.geometryType
+                                                      material: submesh.material]];
+    }
+    return [[MDLMesh alloc] initWithVertexBuffer: vertexBuffer
+                                     vertexCount: vertexCount
+                                      descriptor: descriptor
+                                       submeshes: submeshes];
+}
+
+// Reorders triangles for the vertex cache and overdraw where it helps, then vertices in the order of use.
+- (void)_optimizeModelIOMesh: (MDLMesh *)mdlMesh
+            vertexDescriptor: (MDLVertexDescriptor *)descriptor {
+    NSUInteger vertexCount = mdlMesh.vertexCount;
+    NSUInteger indexCount = 0;
+    for(MDLSubmesh *submesh in mdlMesh.submeshes) {
+        if(submesh.geometryType != MDLGeometryTypeTriangles)
+            return;
+        indexCount += submesh.indexCount;
+    }
+    MDLVertexAttributeData *positions = [mdlMesh vertexAttributeDataForAttributeNamed: MDLVertexAttributePosition
+                                                                             asFormat: MDLVertexFormatFloat3];
+    if(vertexCount == 0 || indexCount == 0 || positions == nil)
+        return;
+    
+    NSMutableData *indexData = [NSMutableData dataWithLength: indexCount * sizeof(uint32_t)];
+    uint32_t *indices = indexData.mutableBytes;
+    NSUInteger indexStart = 0;
+    for(MDLSubmesh *submesh in mdlMesh.submeshes) {
+        id<MDLMeshBuffer> indexBuffer = [submesh indexBufferAsIndexType: MDLIndexBitDepthUInt32];
+        memcpy(indices + indexStart, indexBuffer.map.bytes, submesh.indexCount * sizeof(uint32_t));
+        for(NSUInteger i = indexStart; i < indexStart + submesh.indexCount; i++) {
+            if(indices[i] >= vertexCount)
+                return;
+        }
+        indexStart += submesh.indexCount;
+    }
+    mgp_mesh_analyze_vertex_cache(indices, indexCount, vertexCount, VERTEX_CACHE_SIZE, &_vertexCacheStatsBefore);
+    
+    indexStart = 0;
+    for(MDLSubmesh *submesh in mdlMesh.submeshes) {
+        mgp_mesh_optimize_triangle_order(indices + indexStart, indices + indexStart, submesh.indexCount,
+                                         positions.dataStart, vertexCount, positions.stride,
+                                         OVERDRAW_THRESHOLD, VERTEX_CACHE_SIZE, NULL, NULL);
+        indexStart += submesh.indexCount;
+    }
+    mgp_mesh_analyze_vertex_cache(indices, indexCount, vertexCount, VERTEX_CACHE_SIZE, &_vertexCacheStatsAfter);
+    
+    // every vertex buffer follows the same order
+    NSMutableData *remapData = [NSMutableData dataWithLength: vertexCount * sizeof(uint32_t)];
+    uint32_t *remap = remapData.mutableBytes;
+    mgp_mesh_optimize_vertex_fetch_remap(remap, indices, indexCount, vertexCount);
+    for(NSUInteger i = 0; i < mdlMesh.vertexBuffers.count; i++) {
+        id<MDLMeshBuffer> vertexBuffer = mdlMesh.vertexBuffers[i];
+        NSUInteger stride = i < descriptor.layouts.count ? descriptor.layouts[i].stride : 0;
+        if(stride == 0 || vertexBuffer.length < vertexCount * stride)
+            continue;
+        NSMutableData *vertexData = [NSMutableData dataWithLength: vertexCount * stride];
+        mgp_mesh_remap_vertices(vertexData.mutableBytes, vertexBuffer.map.bytes, vertexCount, stride, remap);
+        [vertexBuffer fillData: vertexData offset: 0];
+    }
+    mgp_mesh_remap_indices(indices, indices, indexCount, remap);
+    [MGPMesh _setIndices: indices
+           ofModelIOMesh: mdlMesh];
+}
+
+// Groups the triangles of large submeshes into meshlets, in place.
+// Returns the meshlets of every submesh, empty for the ones left as they are.
++ (NSArray<NSData*> *)_makeMeshletsWithModelIOMesh: (MDLMesh *)mdlMesh {
+    NSUInteger vertexCount = mdlMesh.vertexCount;
+    NSUInteger indexCount = 0;
+    for(MDLSubmesh *submesh in mdlMesh.submeshes) {
+        if(submesh.geometryType != MDLGeometryTypeTriangles)
+            return @[];
+        indexCount += submesh.indexCount;
+    }
+    MDLVertexAttributeData *positions = [mdlMesh vertexAttributeDataForAttributeNamed: MDLVertexAttributePosition
+                                                                             asFormat: MDLVertexFormatFloat3];
+    if(vertexCount == 0 || indexCount == 0 || positions == nil)
+        return @[];
+    
+    NSMutableData *indexData = [NSMutableData dataWithLength: indexCount * sizeof(uint32_t)];
+    NSMutableData *scratchData = [NSMutableData dataWithLength: indexCount * sizeof(uint32_t)];
+    uint32_t *indices = indexData.mutableBytes;
+    uint32_t *scratch = scratchData.mutableBytes;
+    NSMutableArray<NSData*> *meshlets = [[NSMutableArray alloc] initWithCapacity: mdlMesh.submeshes.count];
+    NSUInteger indexStart = 0;
+    for(MDLSubmesh *submesh in mdlMesh.submeshes) {
+        NSUInteger count = submesh.indexCount;
+        id<MDLMeshBuffer> indexBuffer = [submesh indexBufferAsIndexType: MDLIndexBitDepthUInt32];
+        memcpy(indices + indexStart, indexBuffer.map.bytes, count * sizeof(uint32_t));
+        for(NSUInteger i = indexStart; i < indexStart + count; i++) {
+            if(indices[i] >= vertexCount)
+                return @[];
+        }
+        
+        NSMutableData *submeshMeshlets = [NSMutableData new];
+        if(count / 3 >= MIN_NUM_MESHLET_TRIANGLES) {
+            [submeshMeshlets setLength: mgp_meshlets_bound(count, MGP_MESHLET_MAX_VERTICES, MGP_MESHLET_MAX_TRIANGLES) * sizeof(mgp_meshlet_t)];
+            size_t meshletCount = mgp_meshlets_build(submeshMeshlets.mutableBytes, scratch + indexStart,
+                                                     indices + indexStart, count,
+                                                     positions.dataStart, vertexCount, positions.stride,
+                                                     MGP_MESHLET_MAX_VERTICES, MGP_MESHLET_MAX_TRIANGLES,
+                                                     MESHLET_CONE_WEIGHT);
+            [submeshMeshlets setLength: meshletCount * sizeof(mgp_meshlet_t)];
+            memcpy(indices + indexStart, scratch + indexStart, count * sizeof(uint32_t));
+        }
+        [meshlets addObject: submeshMeshlets];
+        indexStart += count;
+    }
+    [MGPMesh _setIndices: indices
+           ofModelIOMesh: mdlMesh];
+    return meshlets;
+}
+
+// Writes indices of all submeshes back, in their own index types.
++ (void)_setIndices: (const uint32_t *)indices
+      ofModelIOMesh: (MDLMesh *)mdlMesh {
+    NSUInteger indexStart = 0;
+    for(MDLSubmesh *submesh in mdlMesh.submeshes) {
+        NSUInteger count = submesh.indexCount;
+        NSMutableData *data = nil;
+        if(submesh.indexType == MDLIndexBitDepthUInt32) {
+            data = [NSMutableData dataWithBytes: indices + indexStart length: count * sizeof(uint32_t)];
+        }
+        else if(submesh.indexType == MDLIndexBitDepthUInt16) {
+            data = [NSMutableData dataWithLength: count * sizeof(uint16_t)];
+            uint16_t *values = data.mutableBytes;
+            for(NSUInteger j = 0; j < count; j++)
+                values[j] = (uint16_t)indices[indexStart + j];
+        }
+        else {
+            data = [NSMutableData dataWithLength: count * sizeof(uint8_t)];
+            uint8_t *values = data.mutableBytes;
+            for(NSUInteger j = 0; j < count; j++)
+                values[j] = (uint8_t)indices[indexStart + j];
+        }
+        [submesh.indexBuffer fillData: data offset: 0];
+        indexStart += count;
+    }
+}
+
+- (void)dealloc {
+    for(id texture in _textureDict.allValues) {
+        if([texture isKindOfClass: MGPTextureRequest.class])
+            [_textureLoader releaseCachedTexture: texture];
+    }
+}
+
+- (void)makeBoundingVolume {
+    // merge submesh bounding boxes
+    simd_float3 min = simd_make_float3(1e10f, 1e10f, 1e10f);
+    simd_float3 max = simd_make_float3(-1e10f, -1e10f, -1e10f);
+    for(MGPSubmesh *submesh in _submeshes) {
+        if(![submesh.volume isKindOfClass: MGPBoundingBox.class])
+            continue;
+        MGPBoundingBox *submeshBox = (MGPBoundingBox *)submesh.volume;
+        simd_float3 extent = simd_abs(submeshBox.extent);
+        min = simd_min(min, submeshBox.position - extent);
+        max = simd_max(max, submeshBox.position + extent);
+    }
+    if(min.x > max.x)
+        return;
+    
+    MGPBoundingBox *box = [MGPBoundingBox new];
+    box.position = (min+max)*0.5;
+    box.extent = max-box.position;
+    _volume = box;
+}
+
+- (void)makeOccluderWithModelIOMesh: (MDLMesh *)mdlMesh {
+    NSUInteger numIndices = 0;
+    for(MDLSubmesh *mdlSubmesh in mdlMesh.submeshes) {
+        if(mdlSubmesh.geometryType != MDLGeometryTypeTriangles)
+            return;
+        numIndices += mdlSubmesh.indexCount;
+    }
+    if(numIndices == 0 || numIndices / 3 > MAX_NUM_OCCLUDER_TRIANGLES)
+        return;
+    
+    MDLVertexAttributeData *attributeData = [mdlMesh vertexAttributeDataForAttributeNamed: MDLVertexAttributePosition];
+    if(!(attributeData.format & MDLVertexFormatFloatBits) || (attributeData.format & 0xF) < 3)
+        return;
+    
+    // positions
+    NSMutableData *vertices = [NSMutableData dataWithLength: sizeof(float) * 3 * mdlMesh.vertexCount];
+    float *vertexBytes = (float *)vertices.mutableBytes;
+    for(NSUInteger i = 0; i < mdlMesh.vertexCount; i++) {
+        memcpy(vertexBytes + i * 3, attributeData.dataStart + attributeData.stride * i, sizeof(float) * 3);
+    }
+    
+    // indices of all submeshes
+    NSMutableData *indices = [NSMutableData dataWithLength: sizeof(uint32_t) * numIndices];
+    uint32_t *indexBytes = (uint32_t *)indices.mutableBytes;
+    for(MDLSubmesh *mdlSubmesh in mdlMesh.submeshes) {
+        size_t indexSize = mdlSubmesh.indexType / 8;
+        void *indexBufferBytes = mdlSubmesh.indexBuffer.map.bytes;
+        for(NSUInteger i = 0, cnt = mdlSubmesh.indexCount; i < cnt; i++) {
+            if(indexSize == 1)
+                *indexBytes++ = *((uint8_t *)indexBufferBytes + i);
+            else if(indexSize == 2)
+                *indexBytes++ = *((uint16_t *)indexBufferBytes + i);
+            else
+                *indexBytes++ = *((uint32_t *)indexBufferBytes + i);
+        }
+    }
+    
+    _occluderVertices = vertices;
+    _occluderIndices = indices;
+}
+
+// Simplifies LOD n from LOD n-1, submeshes in parallel. Vertices shared by submeshes
+// are locked, so submeshes keep meeting each other at every LOD.
+- (void)makeLODsWithModelIOMesh: (MDLMesh *)mdlMesh
+                         device: (id<MTLDevice>)device {
+    NSTimeInterval startTime = [NSDate timeIntervalSinceReferenceDate];
+    _lodCount = 1;
+    _lodErrors[0] = 0.0f;
+    
+    NSUInteger vertexCount = mdlMesh.vertexCount;
+    NSUInteger submeshCount = mdlMesh.submeshes.count;
+    NSUInteger indexCount = 0;
+    for(MDLSubmesh *submesh in mdlMesh.submeshes) {
+        if(submesh.geometryType != MDLGeometryTypeTriangles)
+            return;
+        indexCount += submesh.indexCount;
+    }
+    _lodTriangleCounts[0] = indexCount / 3;
+    MDLVertexAttributeData *positions = [mdlMesh vertexAttributeDataForAttributeNamed: MDLVertexAttributePosition
+                                                                             asFormat: MDLVertexFormatFloat3];
+    if(indexCount / 3 < MIN_NUM_LOD_TRIANGLES || submeshCount != _submeshes.count || positions == nil)
+        return;
+    
+    // indices of all submeshes, each one keeps its range through the LODs
+    uint32_t *indices = malloc(sizeof(uint32_t) * indexCount);
+    uint32_t *scratch = malloc(sizeof(uint32_t) * indexCount);
+    size_t *starts = malloc(sizeof(size_t) * submeshCount);
+    size_t *counts = malloc(sizeof(size_t) * submeshCount);
+    size_t *lodCounts = malloc(sizeof(size_t) * submeshCount);
+    float *lodErrors = malloc(sizeof(float) * submeshCount);
+    size_t indexStart = 0;
+    BOOL validIndices = YES;
+    for(NSUInteger s = 0; s < submeshCount; s++) {
+        MDLSubmesh *submesh = mdlMesh.submeshes[s];
+        id<MDLMeshBuffer> indexBuffer = [submesh indexBufferAsIndexType: MDLIndexBitDepthUInt32];
+        memcpy(indices + indexStart, indexBuffer.map.bytes, submesh.indexCount * sizeof(uint32_t));
+        starts[s] = indexStart;
+        counts[s] = submesh.indexCount;
+        indexStart += submesh.indexCount;
+    }
+    for(NSUInteger i = 0; i < indexCount; i++)
+        validIndices &= indices[i] < vertexCount;
+    
+    // uv and normal take part in the error
+    static const float attributeWeights[5] = { 1.0f, 1.0f, 0.5f, 0.5f, 0.5f };
+    float *attributes = calloc(vertexCount * 5, sizeof(float));
+    MDLVertexAttributeData *uvs = [mdlMesh vertexAttributeDataForAttributeNamed: MDLVertexAttributeTextureCoordinate
+                                                                       asFormat: MDLVertexFormatFloat2];
+    MDLVertexAttributeData *normals = [mdlMesh vertexAttributeDataForAttributeNamed: MDLVertexAttributeNormal
+                                                                           asFormat: MDLVertexFormatFloat3];
+    simd_float3 minimum = simd_make_float3(FLT_MAX, FLT_MAX, FLT_MAX);
+    simd_float3 maximum = -minimum;
+    for(NSUInteger i = 0; i < vertexCount; i++) {
+        const float *position = (const float *)(positions.dataStart + positions.stride * i);
+        minimum = simd_min(minimum, simd_make_float3(position[0], position[1], position[2]));
+        maximum = simd_max(maximum, simd_make_float3(position[0], position[1], position[2]));
+        if(uvs)
+            memcpy(attributes + i * 5, uvs.dataStart + uvs.stride * i, sizeof(float) * 2);
+        if(normals)
+            memcpy(attributes + i * 5 + 2, normals.dataStart + normals.stride * i, sizeof(float) * 3);
+    }
+    // errors of the simplifier are relative to the largest extent
+    float radius = simd_length(maximum - minimum) * 0.5f;
+    float errorScale = radius > 0.0f ? simd_reduce_max(maximum - minimum) / radius : 0.0f;
+    
+    unsigned char *vertexLock = calloc(vertexCount, 1);
+    mgp_mesh_simplify_lock_submesh_borders(vertexLock, indices, counts, submeshCount,
+                                           positions.dataStart, positions.stride, vertexCount);
+    mgp_mesh_simplify_vertices_t vertices = {
+        .positions = positions.dataStart,
+        .positionStride = positions.stride,
+        .attributes = attributes,
+        .attributeStride = sizeof(float) * 5,
+        .attributeWeights = attributeWeights,
+        .attributeCount = 5,
+        .vertexCount = vertexCount,
+        .vertexLock = vertexLock
+    };
+    const mgp_mesh_simplify_vertices_t *simplifyVertices = &vertices;
+    
+    NSMutableData *lodIndexData = [NSMutableData new];
+    for(NSUInteger lod = 1; lod < MGP_MESH_MAX_LODS && validIndices; lod++) {
+        dispatch_apply(submeshCount, DISPATCH_APPLY_AUTO, ^(size_t s) {
+            size_t targetIndexCount = (size_t)(counts[s] / 3 * LOD_TRIANGLE_RATIO) * 3;
+            lodCounts[s] = mgp_mesh_simplify(scratch + starts[s], indices + starts[s], counts[s], simplifyVertices,
+                                             targetIndexCount, LOD_TARGET_ERROR, &lodErrors[s]);
+        });
+        
+        size_t numIndices = 0;
+        float error = 0.0f;
+        for(NSUInteger s = 0; s < submeshCount; s++) {
+            numIndices += lodCounts[s];
+            error = MAX(error, lodErrors[s]);
+        }
+        if(numIndices / 3 > _lodTriangleCounts[lod - 1] * LOD_MAX_TRIANGLE_RATIO)
+            break;
+        
+        for(NSUInteger s = 0; s < submeshCount; s++) {
+            mgp_mesh_optimize_vertex_cache(indices + starts[s], scratch + starts[s], lodCounts[s], vertexCount);
+            counts[s] = lodCounts[s];
+            [_submeshes[s] setIndexCount: counts[s]
+                       indexBufferOffset: lodIndexData.length
+                                   atLOD: lod];
+            [lodIndexData appendBytes: indices + starts[s]
+                               length: counts[s] * sizeof(uint32_t)];
+        }
+        // errors add up along the chain
+        _lodErrors[lod] = _lodErrors[lod - 1] + error * errorScale;
+        _lodTriangleCounts[lod] = numIndices / 3;
+        _lodCount = lod + 1;
+    }
+    
+    if(_lodCount > 1) {
+        _lodIndexBuffer = [device newBufferWithBytes: lodIndexData.bytes
+                                              length: lodIndexData.length
+                                             options: MTLResourceStorageModeManaged];
+        _lodIndexBuffer.label = @"LOD Indices";
+    }
+    
+    free(indices);
+    free(scratch);
+    free(starts);
+    free(counts);
+    free(lodCounts);
+    free(lodErrors);
+    free(attributes);
+    free(vertexLock);
+    _lodBuildTime = [NSDate timeIntervalSinceReferenceDate] - startTime;
+}
+
+- (float)vertexCacheACMRBefore {
+    return _vertexCacheStatsBefore.acmr;
+}
+
+- (float)vertexCacheACMRAfter {
+    return _vertexCacheStatsAfter.acmr;
+}
+
+- (float)vertexCacheATVRBefore {
+    return _vertexCacheStatsBefore.atvr;
+}
+
+- (float)vertexCacheATVRAfter {
+    return _vertexCacheStatsAfter.atvr;
+}
+
+- (float)lodErrorAtIndex: (NSUInteger)lod {
+    return _lodErrors[MIN(lod, _lodCount - 1)];
+}
+
+- (NSUInteger)triangleCountAtLOD: (NSUInteger)lod {
+    return _lodTriangleCounts[MIN(lod, _lodCount - 1)];
+}
+
 + (NSArray<MGPMesh*>*)loadMeshesFromURL: (NSURL *)url
                 modelIOVertexDescriptor: (nonnull MDLVertexDescriptor *)descriptor
                                  device: (id<MTLDevice>)device
                        calculateNormals: (BOOL)calculateNormals
                                   error: (NSError **)error {
+    // OBJ files are read natively, ModelIO is the fallback for other formats
+    if([url.pathExtension.lowercaseString isEqualToString: @"obj"]) {
+        NSArray<MGPMesh *> *meshes = [MGPMesh _loadMeshesFromObjURL: url
+                                             modelIOVertexDescriptor: descriptor
+                                                              device: device
+                                                    calculateNormals: calculateNormals
+                                                               error: error];
+        if(meshes != nil)
+            return meshes;
+    }
+    
     MTKMeshBufferAllocator *allocator = [[MTKMeshBufferAllocator alloc] initWithDevice: device];
     
+    // quantized vertices are encoded later from the float layout
+    MDLVertexDescriptor *assetDescriptor = [MGPMesh _isQuantizedVertexDescriptor: descriptor] ? [MGPMesh _baseModelIOVertexDescriptor] : descriptor;
     MDLAsset *asset = [[MDLAsset alloc] initWithURL: url
-                                   vertexDescriptor: descriptor
+                                   vertexDescriptor: assetDescriptor
                                     bufferAllocator: allocator];
     
     NSMutableArray<MGPMesh *> *list = [NSMutableArray new];
@@ -294,6 +945,119 @@
     return list;
 }
 
++ (MDLVertexDescriptor *)_baseModelIOVertexDescriptor {
+    // same layout as mgp_obj_vertex_t and the base vertex descriptor of MGPGBuffer
+    MDLVertexDescriptor *descriptor = [[MDLVertexDescriptor alloc] init];
+    descriptor.attributes[attrib_pos] = [[MDLVertexAttribute alloc] initWithName: MDLVertexAttributePosition
+                                                                          format: MDLVertexFormatFloat3
+                                                                          offset: offsetof(mgp_obj_vertex_t, position)
+                                                                     bufferIndex: 0];
+    descriptor.attributes[attrib_uv] = [[MDLVertexAttribute alloc] initWithName: MDLVertexAttributeTextureCoordinate
+                                                                         format: MDLVertexFormatFloat2
+                                                                         offset: offsetof(mgp_obj_vertex_t, uv)
+                                                                    bufferIndex: 0];
+    descriptor.attributes[attrib_normal] = [[MDLVertexAttribute alloc] initWithName: MDLVertexAttributeNormal
+                                                                             format: MDLVertexFormatFloat3
+                                                                             offset: offsetof(mgp_obj_vertex_t, normal)
+                                                                        bufferIndex: 0];
+    descriptor.attributes[attrib_tangent] = [[MDLVertexAttribute alloc] initWithName: MDLVertexAttributeTangent
+                                                                              format: MDLVertexFormatFloat3
+                                                                              offset: offsetof(mgp_obj_vertex_t, tangent)
+                                                                         bufferIndex: 0];
+    descriptor.layouts[0] = [[MDLVertexBufferLayout alloc] initWithStride: sizeof(mgp_obj_vertex_t)];
+    return descriptor;
+}
+
++ (MDLMaterial *)_materialWithObjMaterial: (const mgp_obj_material_t *)objMaterial {
+    MDLMaterial *material = [[MDLMaterial alloc] initWithName: @(objMaterial->name)
+                                         scatteringFunction: [MDLScatteringFunction new]];
+    struct {
+        const char *path;
+        MDLMaterialSemantic semantic;
+    } maps[] = {
+        { objMaterial->diffuseMap, MDLMaterialSemanticBaseColor },
+        { objMaterial->normalMap, MDLMaterialSemanticTangentSpaceNormal },
+        { objMaterial->roughnessMap, MDLMaterialSemanticRoughness },
+        { objMaterial->metallicMap, MDLMaterialSemanticMetallic }
+    };
+    for(size_t i = 0; i < sizeof(maps) / sizeof(maps[0]); i++) {
+        if(maps[i].path == NULL)
+            continue;
+        NSURL *url = [NSURL fileURLWithPath: @(maps[i].path)];
+        [material setProperty: [[MDLMaterialProperty alloc] initWithName: url.lastPathComponent
+                                                                semantic: maps[i].semantic
+                                                                     URL: url]];
+    }
+    return material;
+}
+
+// Returns nil if the file couldn't be imported.
++ (NSArray<MGPMesh*>*)_loadMeshesFromObjURL: (NSURL *)url
+                    modelIOVertexDescriptor: (nonnull MDLVertexDescriptor *)descriptor
+                                     device: (id<MTLDevice>)device
+                           calculateNormals: (BOOL)calculateNormals
+                                      error: (NSError **)error {
+    char errorMessage[256] = {};
+    mgp_obj_model_t *model = mgp_obj_load(url.fileSystemRepresentation, 0, errorMessage, sizeof(errorMessage));
+    if(model == NULL) {
+        NSLog(@"Failed to import %@ : %s", url.lastPathComponent, errorMessage);
+        return nil;
+    }
+    
+    MTKMeshBufferAllocator *allocator = [[MTKMeshBufferAllocator alloc] initWithDevice: device];
+    MGPTextureLoader *textureLoader = [MGPTextureLoader sharedTextureLoaderWithDevice: device];
+    MDLVertexDescriptor *objVertexDescriptor = [MGPMesh _baseModelIOVertexDescriptor];
+    
+    NSMutableArray<MDLMaterial *> *materials = [[NSMutableArray alloc] initWithCapacity: model->numMaterials];
+    for(uint32_t i = 0; i < model->numMaterials; i++)
+        [materials addObject: [MGPMesh _materialWithObjMaterial: &model->materials[i]]];
+    
+    NSMutableArray<MGPMesh *> *list = [[NSMutableArray alloc] initWithCapacity: model->numObjects];
+    for(uint32_t i = 0; i < model->numObjects; i++) {
+        const mgp_obj_object_t *object = &model->objects[i];
+        NSData *vertexData = [NSData dataWithBytesNoCopy: (void *)(model->vertices + object->vertexStart)
+                                                  length: object->vertexCount * sizeof(mgp_obj_vertex_t)
+                                            freeWhenDone: NO];
+        id<MDLMeshBuffer> vertexBuffer = [allocator newBufferWithData: vertexData
+                                                                 type: MDLMeshBufferTypeVertex];
+        
+        NSMutableArray<MDLSubmesh *> *submeshes = [[NSMutableArray alloc] initWithCapacity: object->submeshCount];
+        for(uint32_t j = 0; j < object->submeshCount; j++) {
+            const mgp_obj_submesh_t *submesh = &model->submeshes[object->submeshStart + j];
+            NSData *indexData = [NSData dataWithBytesNoCopy: (void *)(model->indices + submesh->indexStart)
+                                                     length: submesh->indexCount * sizeof(uint32_t)
+                                               freeWhenDone: NO];
+            id<MDLMeshBuffer> indexBuffer = [allocator newBufferWithData: indexData
+                                                                    type: MDLMeshBufferTypeIndex];
+            MDLMaterial *material = submesh->material != MGP_OBJ_NO_MATERIAL ? materials[submesh->material] : nil;
+            [submeshes addObject: [[MDLSubmesh alloc] initWithName: @(object->name)
+                                                       indexBuffer: indexBuffer
+                                                        indexCount: submesh->indexCount
+                                                         indexType: MDLIndexBitDepthUInt32
+                                                      geometryType: MDLGeometryTypeTriangles
+                                                          material: material]];
+        }
+        
+        MDLMesh *mdlMesh = [[MDLMesh alloc] initWithVertexBuffer: vertexBuffer
+                                                     vertexCount: object->vertexCount
+                                                      descriptor: objVertexDescriptor
+                                                       submeshes: submeshes];
+        mdlMesh.name = @(object->name);
+        
+        MGPMesh *mesh = [[MGPMesh alloc] initWithModelIOMesh: mdlMesh
+                                     modelIOVertexDescriptor: descriptor
+                                               textureLoader: textureLoader
+                                                      device: device
+                                            calculateNormals: calculateNormals || !model->hasNormals
+                                                       error: error];
+        if(mesh != nil)
+            [list addObject: mesh];
+    }
+    
+    mgp_obj_destroy(model);
+    return list;
+}
+
 + (NSArray<MGPMesh*>*)loadMeshesFromModelIOObject: (MDLObject *)object
                           modelIOVertexDescriptor: (nonnull MDLVertexDescriptor *)descriptor
                                            device: (id<MTLDevice>)device
@@ -303,7 +1067,7 @@
     
     if([object isKindOfClass: MDLMesh.class]) {
         MDLMesh *mdlMesh = (MDLMesh *)object;
-        MGPTextureLoader *textureLoader = [[MGPTextureLoader alloc] initWithDevice: device];
+        MGPTextureLoader *textureLoader = [MGPTextureLoader sharedTextureLoaderWithDevice: device];
         
         MGPMesh *mesh = [[MGPMesh alloc] initWithModelIOMesh: mdlMesh
                                      modelIOVertexDescriptor: descriptor
@@ -16,7 +16,11 @@ NS_ASSUME_NONNULL_BEGIN
 
 @property (nonatomic, readwrite) MGPMesh *mesh;
 @property (nonatomic, readwrite) material_t material;
-@property (nonatomic, readonly) instance_props_t instanceProps;
+
+// World-space bounding box of the mesh (cached until the node moves)
+// Extent is negative if there's no mesh to draw.
+@property (nonatomic, readonly) simd_float3 worldBoundsCenter;
+@property (nonatomic, readonly) simd_float3 worldBoundsExtent;
 
 - (instancetype)initWithMesh:(MGPMesh*)mesh;
 - (instancetype)initWithMesh:(MGPMesh*)mesh
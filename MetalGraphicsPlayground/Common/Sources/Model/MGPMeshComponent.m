@@ -8,8 +8,16 @@
 
 #import "MGPMeshComponent.h"
 #import "MGPMesh.h"
+#import "MGPSceneNode.h"
+#import "MGPBoundingVolume.h"
+#import "MGPCulling.h"
 
-@implementation MGPMeshComponent
+@implementation MGPMeshComponent {
+    simd_float3 _worldBoundsCenter;
+    simd_float3 _worldBoundsExtent;
+    NSUInteger _worldBoundsVersion;
+    BOOL _worldBoundsValid;
+}
 
 - (instancetype)init {
     self = [super init];
@@ -40,11 +48,65 @@
     return self;
 }
 
-- (instance_props_t)instanceProps {
-    instance_props_t props;
-    props.model = self.localToWorldMatrix;
-    props.material = _material;
-    return props;
+- (void)setMesh:(MGPMesh *)mesh {
+    _mesh = mesh;
+    _worldBoundsValid = NO;
+}
+
+- (void)setNode:(MGPSceneNode *)node {
+    [super setNode:node];
+    _worldBoundsValid = NO;
+}
+
+- (simd_float3)worldBoundsCenter {
+    [self _updateWorldBoundsIfNeeded];
+    return _worldBoundsCenter;
+}
+
+- (simd_float3)worldBoundsExtent {
+    [self _updateWorldBoundsIfNeeded];
+    return _worldBoundsExtent;
+}
+
+- (void)_updateWorldBoundsIfNeeded {
+    MGPSceneNode *node = self.node;
+    NSUInteger version = node.transformVersion;
+    if(_worldBoundsValid && _worldBoundsVersion == version)
+        return;
+    
+    id<MGPBoundingVolume> volume = _mesh.volume;
+    simd_float3 center = volume.position;
+    simd_float3 extent;
+    if(_mesh == nil) {
+        // nothing to draw, always culled
+        _worldBoundsCenter = simd_make_float3(0, 0, 0);
+        _worldBoundsExtent = simd_make_float3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+    }
+    else if(volume == nil) {
+        // unbounded, never culled
+        _worldBoundsCenter = simd_make_float3(0, 0, 0);
+        _worldBoundsExtent = simd_make_float3(FLT_MAX, FLT_MAX, FLT_MAX);
+    }
+    else {
+        if([volume isKindOfClass: MGPBoundingSphere.class]) {
+            float radius = ((MGPBoundingSphere *)volume).radius;
+            extent = simd_make_float3(radius, radius, radius);
+        }
+        else {
+            extent = simd_abs(((MGPBoundingBox *)volume).extent);
+        }
+        
+        simd_float4x4 localToWorld = self.localToWorldMatrix;
+        float worldCenter[3], worldExtent[3];
+        mgp_aabb_transform((const float *)&localToWorld,
+                           (const float *)&center, (const float *)&extent,
+                           worldCenter, worldExtent);
+        _worldBoundsCenter = simd_make_float3(worldCenter[0], worldCenter[1], worldCenter[2]);
+        _worldBoundsExtent = simd_make_float3(worldExtent[0], worldExtent[1], worldExtent[2]);
+    }
+    
+    _worldBoundsVersion = version;
+    _worldBoundsValid = YES;
 }
 
 @end
@@ -0,0 +1,354 @@
+//
+//  MGPMeshOptimizer.cpp
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/17.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#include "MGPMeshOptimizer.h"
+
+#include <string.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace {
+    // simulated by the optimizer, larger than the real caches on purpose
+    const uint32_t kCacheSize = 32;
+    // clusters are measured on a cache closer to the hardware
+    const uint32_t kClusterCacheSize = 16;
+    const uint32_t kMaxValence = 32;
+
+    struct ScoreTables {
+        float cache[kCacheSize];
+        float valence[kMaxValence + 1];
+
+        ScoreTables() {
+            for(uint32_t i = 0; i < kCacheSize; i++) {
+                // the last triangle's vertices get a fixed score so it isn't reused right away
+                cache[i] = i < 3 ? 0.75f : powf(1.0f - (float)(i - 3) / (kCacheSize - 3), 1.5f);
+            }
+            valence[0] = 0.0f;
+            for(uint32_t i = 1; i <= kMaxValence; i++)
+                valence[i] = 2.0f / sqrtf((float)i);
+        }
+    };
+
+    const ScoreTables &scoreTables() {
+        static ScoreTables tables;
+        return tables;
+    }
+
+    inline float vertexScore(int32_t cachePosition, uint32_t liveTriangles) {
+        if(liveTriangles == 0)
+            return -1.0f;
+        const ScoreTables &tables = scoreTables();
+        float score = cachePosition >= 0 ? tables.cache[cachePosition] : 0.0f;
+        return score + tables.valence[std::min(liveTriangles, kMaxValence)];
+    }
+
+    // FIFO cache, returns the number of misses of a triangle.
+    class FifoCache {
+    public:
+        FifoCache(size_t vertexCount, uint32_t cacheSize)
+        : _timestamps(vertexCount, 0), _cacheSize(cacheSize), _time(cacheSize + 1) {}
+
+        uint32_t add(const uint32_t *triangle) {
+            uint32_t misses = 0;
+            for(int i = 0; i < 3; i++) {
+                if(_time - _timestamps[triangle[i]] > _cacheSize) {
+                    _timestamps[triangle[i]] = _time++;
+                    misses++;
+                }
+            }
+            return misses;
+        }
+
+        void flush() {
+            _time += _cacheSize + 1;
+        }
+
+    private:
+        std::vector<uint32_t> _timestamps;
+        uint32_t _cacheSize;
+        uint32_t _time;
+    };
+}
+
+void mgp_mesh_analyze_vertex_cache(const uint32_t *indices, size_t indexCount, size_t vertexCount,
+                                   uint32_t cacheSize, mgp_mesh_cache_stats_t *stats) {
+    *stats = {};
+    size_t triangleCount = indexCount / 3;
+    if(triangleCount == 0)
+        return;
+    FifoCache cache(vertexCount, std::max(1u, cacheSize));
+    std::vector<bool> used(vertexCount, false);
+    size_t numUsed = 0;
+    uint32_t numTransformed = 0;
+    for(size_t i = 0; i < triangleCount * 3; i += 3) {
+        numTransformed += cache.add(&indices[i]);
+        for(int j = 0; j < 3; j++) {
+            if(!used[indices[i + j]]) {
+                used[indices[i + j]] = true;
+                numUsed++;
+            }
+        }
+    }
+    stats->numTransformed = numTransformed;
+    stats->acmr = (float)numTransformed / triangleCount;
+    stats->atvr = (float)numTransformed / numUsed;
+}
+
+void mgp_mesh_optimize_vertex_cache(uint32_t *destination, const uint32_t *indices, size_t indexCount,
+                                    size_t vertexCount) {
+    size_t triangleCount = indexCount / 3;
+    std::vector<uint32_t> source(indices, indices + triangleCount * 3);
+
+    // live triangles of each vertex, packed
+    std::vector<uint32_t> liveCounts(vertexCount, 0);
+    for(uint32_t index : source)
+        liveCounts[index]++;
+    std::vector<uint32_t> offsets(vertexCount + 1, 0);
+    for(size_t v = 0; v < vertexCount; v++)
+        offsets[v + 1] = offsets[v] + liveCounts[v];
+    std::vector<uint32_t> adjacency(source.size());
+    {
+        std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+        for(size_t i = 0; i < source.size(); i++)
+            adjacency[fill[source[i]]++] = (uint32_t)(i / 3);
+    }
+
+    std::vector<float> vertexScores(vertexCount);
+    for(size_t v = 0; v < vertexCount; v++)
+        vertexScores[v] = vertexScore(-1, liveCounts[v]);
+    std::vector<float> triangleScores(triangleCount);
+    std::vector<bool> emitted(triangleCount, false);
+    size_t best = triangleCount;
+    for(size_t t = 0; t < triangleCount; t++) {
+        const uint32_t *triangle = &source[t * 3];
+        triangleScores[t] = vertexScores[triangle[0]] + vertexScores[triangle[1]] + vertexScores[triangle[2]];
+        if(best == triangleCount || triangleScores[t] > triangleScores[best])
+            best = t;
+    }
+
+    uint32_t cache[kCacheSize + 3];
+    uint32_t newCache[kCacheSize + 3];
+    uint32_t cacheCount = 0;
+    size_t nextCandidate = 0;
+    for(size_t output = 0; output < triangleCount; output++) {
+        if(best == triangleCount) {
+            // dead end, nothing in the cache has live triangles
+            while(emitted[nextCandidate])
+                nextCandidate++;
+            best = nextCandidate;
+        }
+        const uint32_t *triangle = &source[best * 3];
+        memcpy(&destination[output * 3], triangle, sizeof(uint32_t) * 3);
+        emitted[best] = true;
+
+        // the triangle's vertices move to the front
+        uint32_t newCacheCount = 0;
+        for(int i = 0; i < 3; i++)
+            newCache[newCacheCount++] = triangle[i];
+        for(uint32_t i = 0; i < cacheCount; i++) {
+            uint32_t v = cache[i];
+            if(v != triangle[0] && v != triangle[1] && v != triangle[2])
+                newCache[newCacheCount++] = v;
+        }
+        for(int i = 0; i < 3; i++) {
+            uint32_t v = triangle[i];
+            uint32_t *begin = &adjacency[offsets[v]];
+            uint32_t *end = begin + liveCounts[v];
+            uint32_t *found = std::find(begin, end, (uint32_t)best);
+            if(found != end) {
+                *found = end[-1];
+                liveCounts[v]--;
+            }
+        }
+
+        // vertices pushed out of the cache lose their position score
+        best = triangleCount;
+        float bestScore = -1.0f;
+        for(uint32_t i = 0; i < newCacheCount; i++) {
+            uint32_t v = newCache[i];
+            int32_t position = i < kCacheSize ? (int32_t)i : -1;
+            float score = vertexScore(position, liveCounts[v]);
+            float delta = score - vertexScores[v];
+            vertexScores[v] = score;
+            for(uint32_t j = 0; j < liveCounts[v]; j++) {
+                uint32_t t = adjacency[offsets[v] + j];
+                triangleScores[t] += delta;
+                if(triangleScores[t] > bestScore) {
+                    bestScore = triangleScores[t];
+                    best = t;
+                }
+            }
+        }
+        cacheCount = std::min(newCacheCount, kCacheSize);
+        memcpy(cache, newCache, sizeof(uint32_t) * cacheCount);
+    }
+}
+
+void mgp_mesh_optimize_overdraw(uint32_t *destination, const uint32_t *indices, size_t indexCount,
+                                const float *positions, size_t vertexCount, size_t positionStride,
+                                float threshold) {
+    size_t triangleCount = indexCount / 3;
+    if(triangleCount == 0)
+        return;
+    std::vector<uint32_t> source(indices, indices + triangleCount * 3);
+    auto position = [&](uint32_t v) {
+        return (const float *)((const uint8_t *)positions + v * positionStride);
+    };
+
+    // hard boundaries, a triangle missing all of its vertices starts a new patch
+    std::vector<uint32_t> misses(triangleCount);
+    std::vector<size_t> hardStarts;
+    {
+        FifoCache cache(vertexCount, kClusterCacheSize);
+        for(size_t t = 0; t < triangleCount; t++) {
+            misses[t] = cache.add(&source[t * 3]);
+            if(t == 0 || misses[t] == 3)
+                hardStarts.push_back(t);
+        }
+    }
+    hardStarts.push_back(triangleCount);
+
+    // soft boundaries, a patch is split when the part so far is as good as
+    // the whole patch (within the threshold) from a cold cache
+    std::vector<size_t> clusterStarts;
+    {
+        FifoCache cache(vertexCount, kClusterCacheSize);
+        for(size_t h = 0; h + 1 < hardStarts.size(); h++) {
+            size_t start = hardStarts[h], end = hardStarts[h + 1];
+            uint32_t patchMisses = 0;
+            cache.flush();
+            for(size_t t = start; t < end; t++)
+                patchMisses += cache.add(&source[t * 3]);
+            float limit = threshold * patchMisses / (end - start);
+
+            cache.flush();
+            size_t clusterStart = start;
+            uint32_t clusterMisses = 0;
+            clusterStarts.push_back(start);
+            for(size_t t = start; t < end; t++) {
+                clusterMisses += cache.add(&source[t * 3]);
+                if(t + 1 < end && clusterMisses <= limit * (t + 1 - clusterStart)) {
+                    clusterStarts.push_back(t + 1);
+                    clusterStart = t + 1;
+                    clusterMisses = 0;
+                    cache.flush();
+                }
+            }
+        }
+    }
+    clusterStarts.push_back(triangleCount);
+
+    // mesh centroid over the referenced vertices
+    double meshCentroid[3] = { 0, 0, 0 };
+    for(uint32_t v : source) {
+        const float *p = position(v);
+        for(int i = 0; i < 3; i++)
+            meshCentroid[i] += p[i];
+    }
+    for(int i = 0; i < 3; i++)
+        meshCentroid[i] /= source.size();
+
+    // clusters facing away from the center are drawn first
+    size_t clusterCount = clusterStarts.size() - 1;
+    std::vector<float> sortKeys(clusterCount);
+    for(size_t c = 0; c < clusterCount; c++) {
+        double centroid[3] = { 0, 0, 0 }, normal[3] = { 0, 0, 0 };
+        double area = 0.0;
+        for(size_t t = clusterStarts[c]; t < clusterStarts[c + 1]; t++) {
+            const float *p0 = position(source[t * 3]);
+            const float *p1 = position(source[t * 3 + 1]);
+            const float *p2 = position(source[t * 3 + 2]);
+            double e1[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+            double e2[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+            double n[3] = { e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0] };
+            double a = sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+            for(int i = 0; i < 3; i++) {
+                centroid[i] += (p0[i] + p1[i] + p2[i]) * (a / 3.0);
+                normal[i] += n[i];
+            }
+            area += a;
+        }
+        double length = sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+        if(area <= 0.0 || length <= 0.0) {
+            sortKeys[c] = 0.0f;
+            continue;
+        }
+        double key = 0.0;
+        for(int i = 0; i < 3; i++)
+            key += (centroid[i] / area - meshCentroid[i]) * (normal[i] / length);
+        sortKeys[c] = (float)key;
+    }
+
+    std::vector<uint32_t> order(clusterCount);
+    for(size_t c = 0; c < clusterCount; c++)
+        order[c] = (uint32_t)c;
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        return sortKeys[a] > sortKeys[b];
+    });
+
+    uint32_t *output = destination;
+    for(uint32_t c : order) {
+        size_t count = (clusterStarts[c + 1] - clusterStarts[c]) * 3;
+        memcpy(output, &source[clusterStarts[c] * 3], sizeof(uint32_t) * count);
+        output += count;
+    }
+}
+
+int mgp_mesh_optimize_triangle_order(uint32_t *destination, const uint32_t *indices, size_t indexCount,
+                                     const float *positions, size_t vertexCount, size_t positionStride,
+                                     float threshold, uint32_t cacheSize,
+                                     mgp_mesh_cache_stats_t *before, mgp_mesh_cache_stats_t *after) {
+    std::vector<uint32_t> optimized(indexCount);
+    mgp_mesh_optimize_vertex_cache(optimized.data(), indices, indexCount, vertexCount);
+    mgp_mesh_optimize_overdraw(optimized.data(), optimized.data(), indexCount,
+                               positions, vertexCount, positionStride, threshold);
+
+    mgp_mesh_cache_stats_t original, reordered;
+    mgp_mesh_analyze_vertex_cache(indices, indexCount, vertexCount, cacheSize, &original);
+    mgp_mesh_analyze_vertex_cache(optimized.data(), indexCount, vertexCount, cacheSize, &reordered);
+    bool improves = reordered.numTransformed < original.numTransformed;
+    if(improves)
+        memcpy(destination, optimized.data(), sizeof(uint32_t) * indexCount);
+    else if(destination != indices)
+        memcpy(destination, indices, sizeof(uint32_t) * indexCount);
+
+    if(before)
+        *before = original;
+    if(after)
+        *after = improves ? reordered : original;
+    return improves;
+}
+
+size_t mgp_mesh_optimize_vertex_fetch_remap(uint32_t *remap, const uint32_t *indices, size_t indexCount,
+                                            size_t vertexCount) {
+    std::fill(remap, remap + vertexCount, UINT32_MAX);
+    uint32_t next = 0;
+    for(size_t i = 0; i < indexCount; i++) {
+        if(remap[indices[i]] == UINT32_MAX)
+            remap[indices[i]] = next++;
+    }
+    size_t numUsed = next;
+    for(size_t v = 0; v < vertexCount; v++) {
+        if(remap[v] == UINT32_MAX)
+            remap[v] = next++;
+    }
+    return numUsed;
+}
+
+void mgp_mesh_remap_indices(uint32_t *destination, const uint32_t *indices, size_t indexCount,
+                            const uint32_t *remap) {
+    for(size_t i = 0; i < indexCount; i++)
+        destination[i] = remap[indices[i]];
+}
+
+void mgp_mesh_remap_vertices(void *destination, const void *vertices, size_t vertexCount, size_t vertexSize,
+                             const uint32_t *remap) {
+    for(size_t v = 0; v < vertexCount; v++)
+        memcpy((uint8_t *)destination + remap[v] * vertexSize, (const uint8_t *)vertices + v * vertexSize, vertexSize);
+}
@@ -0,0 +1,70 @@
+//
+//  MGPMeshOptimizer.h
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/17.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#ifndef MGPMeshOptimizer_h
+#define MGPMeshOptimizer_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Reorders triangle lists for the GPU, in the order they are meant to run:
+//  1. vertex cache : greedy triangle order after Forsyth's scoring,
+//  2. overdraw : clusters of the cache order sorted outside-in (Sander et al.),
+//     keeping the cache order inside a cluster,
+//  3. vertex fetch : vertices renumbered in the order of first use.
+// Passes 1 and 2 can lose to an order that is already good for large caches,
+// so they are only kept where they help.
+// Indices are 32-bit, destination may be the same as indices.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    float acmr;                 // transformed vertices per triangle, 0.5 at best, 3 at worst
+    float atvr;                 // transformed vertices per used vertex, 1 at best
+    uint32_t numTransformed;
+} mgp_mesh_cache_stats_t;
+
+// FIFO post-transform cache of cacheSize entries.
+void mgp_mesh_analyze_vertex_cache(const uint32_t *indices, size_t indexCount, size_t vertexCount,
+                                   uint32_t cacheSize, mgp_mesh_cache_stats_t *stats);
+
+void mgp_mesh_optimize_vertex_cache(uint32_t *destination, const uint32_t *indices, size_t indexCount,
+                                    size_t vertexCount);
+
+// indices should be in the cache order already.
+// positions : float3 at every positionStride bytes.
+// threshold : how much worse than the cache order a cluster may get, 1.05 is a good start.
+void mgp_mesh_optimize_overdraw(uint32_t *destination, const uint32_t *indices, size_t indexCount,
+                                const float *positions, size_t vertexCount, size_t positionStride,
+                                float threshold);
+
+// Both passes above, kept only if they lower ACMR on a FIFO cache of cacheSize entries,
+// otherwise the original order is written. Returns 1 if the triangles were reordered.
+// before and after can be NULL, after is the order written.
+int mgp_mesh_optimize_triangle_order(uint32_t *destination, const uint32_t *indices, size_t indexCount,
+                                     const float *positions, size_t vertexCount, size_t positionStride,
+                                     float threshold, uint32_t cacheSize,
+                                     mgp_mesh_cache_stats_t *before, mgp_mesh_cache_stats_t *after);
+
+// Fills remap with the new index of every vertex, unused vertices go after the used ones.
+// Returns the number of used vertices.
+size_t mgp_mesh_optimize_vertex_fetch_remap(uint32_t *remap, const uint32_t *indices, size_t indexCount,
+                                            size_t vertexCount);
+void mgp_mesh_remap_indices(uint32_t *destination, const uint32_t *indices, size_t indexCount,
+                            const uint32_t *remap);
+// destination can't be the same as vertices.
+void mgp_mesh_remap_vertices(void *destination, const void *vertices, size_t vertexCount, size_t vertexSize,
+                             const uint32_t *remap);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MGPMeshOptimizer_h */
@@ -0,0 +1,692 @@
+//
+//  MGPMeshSimplifier.cpp
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/17.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#include "MGPMeshSimplifier.h"
+
+#include <float.h>
+#include <string.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace {
+    const size_t kMaxAttributes = 8;
+    // borders are held by planes through them, heavier than the triangles
+    const float kBorderWeight = 10.0f;
+    // collapses of a pass may be this much worse than the one that reaches the goal of the pass,
+    // the rest waits for the quadrics to be merged
+    const float kPassErrorBound = 1.5f;
+
+    enum VertexKind : uint8_t {
+        kManifold,
+        kBorder,
+        kSeam,
+        kLocked
+    };
+
+    struct Vector3 {
+        float x, y, z;
+    };
+
+    inline Vector3 operator-(const Vector3 &a, const Vector3 &b) {
+        return { a.x - b.x, a.y - b.y, a.z - b.z };
+    }
+
+    inline Vector3 operator*(const Vector3 &a, float s) {
+        return { a.x * s, a.y * s, a.z * s };
+    }
+
+    inline Vector3 cross(const Vector3 &a, const Vector3 &b) {
+        return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+    }
+
+    inline float dot(const Vector3 &a, const Vector3 &b) {
+        return a.x * b.x + a.y * b.y + a.z * b.z;
+    }
+
+    inline float normalize(Vector3 &v) {
+        float length = sqrtf(dot(v, v));
+        if(length > 0.0f)
+            v = v * (1.0f / length);
+        return length;
+    }
+
+    // symmetric A, b, c of p'Ap + 2b'p + c, summed with the weight w
+    struct Quadric {
+        float a00, a11, a22;
+        float a10, a20, a21;
+        float b0, b1, b2;
+        float c;
+        float w;
+    };
+
+    // sum of weighted attribute gradients and offsets of the triangles
+    struct QuadricGradient {
+        float gx, gy, gz, gw;
+    };
+
+    void quadricAdd(Quadric &q, const Quadric &r) {
+        q.a00 += r.a00; q.a11 += r.a11; q.a22 += r.a22;
+        q.a10 += r.a10; q.a20 += r.a20; q.a21 += r.a21;
+        q.b0 += r.b0; q.b1 += r.b1; q.b2 += r.b2;
+        q.c += r.c;
+        q.w += r.w;
+    }
+
+    void quadricAdd(QuadricGradient *g, const QuadricGradient *r, size_t count) {
+        for(size_t k = 0; k < count; k++) {
+            g[k].gx += r[k].gx;
+            g[k].gy += r[k].gy;
+            g[k].gz += r[k].gz;
+            g[k].gw += r[k].gw;
+        }
+    }
+
+    void quadricFromPlane(Quadric &q, const Vector3 &n, float d, float w) {
+        float xw = n.x * w, yw = n.y * w, zw = n.z * w, dw = d * w;
+        q.a00 = n.x * xw; q.a11 = n.y * yw; q.a22 = n.z * zw;
+        q.a10 = n.x * yw; q.a20 = n.x * zw; q.a21 = n.y * zw;
+        q.b0 = n.x * dw; q.b1 = n.y * dw; q.b2 = n.z * dw;
+        q.c = d * dw;
+        q.w = w;
+    }
+
+    float quadricResidual(const Quadric &q, const Vector3 &p) {
+        float rx = q.a00 * p.x + q.a10 * p.y + q.a20 * p.z;
+        float ry = q.a10 * p.x + q.a11 * p.y + q.a21 * p.z;
+        float rz = q.a20 * p.x + q.a21 * p.y + q.a22 * p.z;
+        return p.x * rx + p.y * ry + p.z * rz + 2.0f * (q.b0 * p.x + q.b1 * p.y + q.b2 * p.z) + q.c;
+    }
+
+    // squared distance to the planes, averaged by weight
+    float quadricError(const Quadric &q, const Vector3 &p) {
+        return q.w > 0.0f ? fabsf(quadricResidual(q, p)) / q.w : 0.0f;
+    }
+
+    // squared attribute error of (p, s), averaged by weight
+    float quadricError(const Quadric &q, const QuadricGradient *g, size_t count,
+                       const Vector3 &p, const float *s) {
+        float r = quadricResidual(q, p);
+        for(size_t k = 0; k < count; k++) {
+            float predicted = g[k].gx * p.x + g[k].gy * p.y + g[k].gz * p.z + g[k].gw;
+            r += s[k] * s[k] * q.w - 2.0f * s[k] * predicted;
+        }
+        return q.w > 0.0f ? fabsf(r) / q.w : 0.0f;
+    }
+
+    void quadricFromTriangle(Quadric &q, const Vector3 &p0, const Vector3 &p1, const Vector3 &p2) {
+        Vector3 n = cross(p1 - p0, p2 - p0);
+        float area = normalize(n);
+        quadricFromPlane(q, n, -dot(n, p0), area);
+    }
+
+    // plane through the edge p0-p1, perpendicular to the triangle
+    void quadricFromBorder(Quadric &q, const Vector3 &p0, const Vector3 &p1, const Vector3 &p2, float weight) {
+        Vector3 p10 = p1 - p0;
+        float length = normalize(p10);
+        Vector3 p20 = p2 - p0;
+        Vector3 n = p20 - p10 * dot(p20, p10);
+        normalize(n);
+        quadricFromPlane(q, n, -dot(n, p0), length * length * weight);
+    }
+
+    // Each attribute is linear over the triangle : s(p) = g.p + d.
+    void quadricFromAttributes(Quadric &q, QuadricGradient *g,
+                               const Vector3 &p0, const Vector3 &p1, const Vector3 &p2,
+                               const float *a0, const float *a1, const float *a2, size_t count) {
+        Vector3 p10 = p1 - p0, p20 = p2 - p0;
+        Vector3 n = cross(p10, p20);
+        float w = sqrtf(dot(n, n)) * 0.5f;
+        float d00 = dot(p10, p10), d01 = dot(p10, p20), d11 = dot(p20, p20);
+        float denom = d00 * d11 - d01 * d01;
+        float inverse = denom != 0.0f ? 1.0f / denom : 0.0f;
+
+        memset(&q, 0, sizeof(Quadric));
+        q.w = w;
+        for(size_t k = 0; k < count; k++) {
+            float da1 = a1[k] - a0[k], da2 = a2[k] - a0[k];
+            float s1 = (d11 * da1 - d01 * da2) * inverse;
+            float s2 = (d00 * da2 - d01 * da1) * inverse;
+            Vector3 gradient = { p10.x * s1 + p20.x * s2, p10.y * s1 + p20.y * s2, p10.z * s1 + p20.z * s2 };
+            float offset = a0[k] - dot(gradient, p0);
+
+            q.a00 += w * gradient.x * gradient.x;
+            q.a11 += w * gradient.y * gradient.y;
+            q.a22 += w * gradient.z * gradient.z;
+            q.a10 += w * gradient.x * gradient.y;
+            q.a20 += w * gradient.x * gradient.z;
+            q.a21 += w * gradient.y * gradient.z;
+            q.b0 += w * gradient.x * offset;
+            q.b1 += w * gradient.y * offset;
+            q.b2 += w * gradient.z * offset;
+            q.c += w * offset * offset;
+            g[k] = { w * gradient.x, w * gradient.y, w * gradient.z, w * offset };
+        }
+    }
+
+    // Vertices with bitwise equal positions, open addressing.
+    class PositionTable {
+    public:
+        PositionTable(const float *positions, size_t stride, size_t count)
+        : _positions((const char *)positions), _stride(stride) {
+            size_t capacity = 16;
+            while(capacity < count * 2)
+                capacity <<= 1;
+            _slots.assign(capacity, UINT32_MAX);
+        }
+
+        // returns the first vertex inserted with the same position
+        uint32_t insert(uint32_t vertex) {
+            const float *p = position(vertex);
+            size_t mask = _slots.size() - 1;
+            for(size_t slot = hash(p) & mask;; slot = (slot + 1) & mask) {
+                uint32_t other = _slots[slot];
+                if(other == UINT32_MAX) {
+                    _slots[slot] = vertex;
+                    return vertex;
+                }
+                if(memcmp(position(other), p, sizeof(float) * 3) == 0)
+                    return other;
+            }
+        }
+
+    private:
+        const float *position(uint32_t vertex) const {
+            return (const float *)(_positions + vertex * _stride);
+        }
+
+        static uint32_t hash(const float *p) {
+            uint32_t bits[3];
+            memcpy(bits, p, sizeof(bits));
+            return (bits[0] * 73856093u) ^ (bits[1] * 19349663u) ^ (bits[2] * 83492791u);
+        }
+
+        const char *_positions;
+        size_t _stride;
+        std::vector<uint32_t> _slots;
+    };
+
+    // Half-edges leaving each vertex, with the other two corners of their triangle.
+    struct Adjacency {
+        struct Edge {
+            uint32_t next, prev;
+        };
+        std::vector<uint32_t> offsets;
+        std::vector<Edge> edges;
+
+        void build(const uint32_t *indices, size_t indexCount, size_t vertexCount) {
+            offsets.assign(vertexCount + 1, 0);
+            for(size_t i = 0; i < indexCount; i++)
+                offsets[indices[i] + 1]++;
+            for(size_t v = 0; v < vertexCount; v++)
+                offsets[v + 1] += offsets[v];
+            edges.resize(indexCount);
+            std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+            for(size_t i = 0; i < indexCount; i += 3) {
+                for(int k = 0; k < 3; k++) {
+                    uint32_t v = indices[i + k];
+                    edges[cursor[v]++] = { indices[i + (k + 1) % 3], indices[i + (k + 2) % 3] };
+                }
+            }
+        }
+
+        bool hasEdge(uint32_t a, uint32_t b) const {
+            for(uint32_t e = offsets[a]; e < offsets[a + 1]; e++) {
+                if(edges[e].next == b)
+                    return true;
+            }
+            return false;
+        }
+    };
+
+    struct Collapse {
+        uint32_t v, t;
+        float error;
+    };
+
+    class Simplifier {
+    public:
+        Simplifier(const mgp_mesh_simplify_vertices_t *vertices, const uint32_t *indices, size_t indexCount)
+        : _vertices(vertices), _vertexCount(vertices->vertexCount),
+        _attributeCount(vertices->attributes ? std::min(vertices->attributeCount, kMaxAttributes) : 0) {
+            loadVertices();
+            weldPositions(indices, indexCount);
+        }
+
+        size_t simplify(uint32_t *result, size_t indexCount, size_t targetIndexCount, float targetError, float *resultError);
+
+    private:
+        void loadVertices();
+        void weldPositions(const uint32_t *indices, size_t indexCount);
+        void findOpenEdges(const uint32_t *indices, size_t indexCount);
+        void classifyVertices();
+        void fillQuadrics(const uint32_t *indices, size_t indexCount);
+        bool canCollapse(uint32_t v, uint32_t t) const;
+        float collapseError(uint32_t v, uint32_t t) const;
+        bool hasTriangleFlips(uint32_t v, uint32_t t) const;
+        void pickCollapses(const uint32_t *indices, size_t indexCount);
+        size_t sortCollapses(float errorLimit);
+        size_t performCollapses(size_t numCandidates, size_t triangleGoal, float &maxError);
+        void mergeQuadrics(uint32_t v, uint32_t t);
+        void mergeAttributeQuadrics(uint32_t v, uint32_t t);
+
+        const float *attributes(uint32_t v) const {
+            return &_attributes[v * _attributeCount];
+        }
+
+        const mgp_mesh_simplify_vertices_t *_vertices;
+        size_t _vertexCount;
+        size_t _attributeCount;
+
+        std::vector<Vector3> _positions;            // inside the unit cube
+        std::vector<float> _attributes;             // weighted
+        std::vector<uint32_t> _remap;               // first vertex at the same position
+        std::vector<uint32_t> _wedge;               // next vertex at the same position, circular
+        std::vector<uint8_t> _kinds;
+        std::vector<uint32_t> _loop, _loopback;     // open half-edges leaving and entering
+        std::vector<uint32_t> _openOut, _openIn;
+
+        std::vector<Quadric> _vertexQuadrics;       // by position (_remap)
+        std::vector<Quadric> _attributeQuadrics;    // by vertex
+        std::vector<QuadricGradient> _attributeGradients;
+
+        Adjacency _adjacency;
+        std::vector<Collapse> _collapses;
+        std::vector<uint32_t> _collapseRemap;
+        std::vector<uint8_t> _collapseLocked;
+    };
+
+    void Simplifier::loadVertices() {
+        const char *positions = (const char *)_vertices->positions;
+        size_t stride = _vertices->positionStride;
+
+        // the whole vertex buffer sets the scale, so submeshes share it
+        float minimum[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+        float maximum[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+        for(size_t i = 0; i < _vertexCount; i++) {
+            const float *p = (const float *)(positions + i * stride);
+            for(int k = 0; k < 3; k++) {
+                minimum[k] = std::min(minimum[k], p[k]);
+                maximum[k] = std::max(maximum[k], p[k]);
+            }
+        }
+        float extent = std::max(maximum[0] - minimum[0], std::max(maximum[1] - minimum[1], maximum[2] - minimum[2]));
+        float scale = extent > 0.0f ? 1.0f / extent : 0.0f;
+
+        _positions.resize(_vertexCount);
+        for(size_t i = 0; i < _vertexCount; i++) {
+            const float *p = (const float *)(positions + i * stride);
+            _positions[i] = { (p[0] - minimum[0]) * scale, (p[1] - minimum[1]) * scale, (p[2] - minimum[2]) * scale };
+        }
+
+        if(_attributeCount > 0) {
+            const char *attributes = (const char *)_vertices->attributes;
+            _attributes.resize(_vertexCount * _attributeCount);
+            for(size_t i = 0; i < _vertexCount; i++) {
+                const float *a = (const float *)(attributes + i * _vertices->attributeStride);
+                for(size_t k = 0; k < _attributeCount; k++)
+                    _attributes[i * _attributeCount + k] = a[k] * _vertices->attributeWeights[k];
+            }
+        }
+    }
+
+    // Only vertices of these indices are welded, others at the same position belong to other submeshes.
+    void Simplifier::weldPositions(const uint32_t *indices, size_t indexCount) {
+        _remap.assign(_vertexCount, UINT32_MAX);
+        _wedge.resize(_vertexCount);
+        PositionTable table(_vertices->positions, _vertices->positionStride, std::min(indexCount, _vertexCount));
+        for(size_t i = 0; i < indexCount; i++) {
+            uint32_t v = indices[i];
+            if(_remap[v] != UINT32_MAX)
+                continue;
+            uint32_t first = table.insert(v);
+            _remap[v] = first;
+            if(first == v) {
+                _wedge[v] = v;
+            }
+            else {
+                _wedge[v] = _wedge[first];
+                _wedge[first] = v;
+            }
+        }
+    }
+
+    // Half-edges without a twin, seams are open in index space too.
+    void Simplifier::findOpenEdges(const uint32_t *indices, size_t indexCount) {
+        _loop.assign(_vertexCount, UINT32_MAX);
+        _loopback.assign(_vertexCount, UINT32_MAX);
+        _openOut.assign(_vertexCount, 0);
+        _openIn.assign(_vertexCount, 0);
+        for(size_t i = 0; i < indexCount; i += 3) {
+            for(int k = 0; k < 3; k++) {
+                uint32_t a = indices[i + k], b = indices[i + (k + 1) % 3];
+                if(!_adjacency.hasEdge(b, a)) {
+                    _loop[a] = b;
+                    _loopback[b] = a;
+                    _openOut[a]++;
+                    _openIn[b]++;
+                }
+            }
+        }
+    }
+
+    void Simplifier::classifyVertices() {
+        _kinds.assign(_vertexCount, kLocked);
+        for(uint32_t v = 0; v < _vertexCount; v++) {
+            if(_remap[v] != v)
+                continue;
+
+            // kinds are decided once per position
+            bool locked = false;
+            uint32_t wedges = 0;
+            uint32_t w = v;
+            do {
+                locked |= _vertices->vertexLock && _vertices->vertexLock[w];
+                wedges++;
+                w = _wedge[w];
+            } while(w != v);
+
+            uint8_t kind = kLocked;
+            if(!locked) {
+                if(wedges == 1) {
+                    if(_openOut[v] == 0 && _openIn[v] == 0)
+                        kind = kManifold;
+                    else if(_openOut[v] == 1 && _openIn[v] == 1)
+                        kind = kBorder;
+                }
+                else if(wedges == 2) {
+                    // the two sides have to open along the same edges
+                    w = _wedge[v];
+                    if(_openOut[v] == 1 && _openIn[v] == 1 && _openOut[w] == 1 && _openIn[w] == 1 &&
+                       _remap[_loop[v]] == _remap[_loopback[w]] && _remap[_loopback[v]] == _remap[_loop[w]])
+                        kind = kSeam;
+                }
+            }
+
+            w = v;
+            do {
+                _kinds[w] = kind;
+                w = _wedge[w];
+            } while(w != v);
+        }
+    }
+
+    void Simplifier::fillQuadrics(const uint32_t *indices, size_t indexCount) {
+        _vertexQuadrics.assign(_vertexCount, Quadric());
+        for(size_t i = 0; i < indexCount; i += 3) {
+            uint32_t i0 = indices[i], i1 = indices[i + 1], i2 = indices[i + 2];
+            Quadric q;
+            quadricFromTriangle(q, _positions[i0], _positions[i1], _positions[i2]);
+            quadricAdd(_vertexQuadrics[_remap[i0]], q);
+            quadricAdd(_vertexQuadrics[_remap[i1]], q);
+            quadricAdd(_vertexQuadrics[_remap[i2]], q);
+
+            // borders, seams are held lighter as both sides add their planes
+            for(int k = 0; k < 3; k++) {
+                uint32_t a = indices[i + k], b = indices[i + (k + 1) % 3], c = indices[i + (k + 2) % 3];
+                if(_adjacency.hasEdge(b, a))
+                    continue;
+                float weight = _kinds[a] == kSeam && _kinds[b] == kSeam ? 1.0f : kBorderWeight;
+                quadricFromBorder(q, _positions[a], _positions[b], _positions[c], weight);
+                quadricAdd(_vertexQuadrics[_remap[a]], q);
+                quadricAdd(_vertexQuadrics[_remap[b]], q);
+            }
+        }
+
+        if(_attributeCount == 0)
+            return;
+        _attributeQuadrics.assign(_vertexCount, Quadric());
+        _attributeGradients.assign(_vertexCount * _attributeCount, QuadricGradient());
+        QuadricGradient g[kMaxAttributes];
+        for(size_t i = 0; i < indexCount; i += 3) {
+            uint32_t i0 = indices[i], i1 = indices[i + 1], i2 = indices[i + 2];
+            Quadric q;
+            quadricFromAttributes(q, g, _positions[i0], _positions[i1], _positions[i2],
+                                  attributes(i0), attributes(i1), attributes(i2), _attributeCount);
+            uint32_t corners[3] = { i0, i1, i2 };
+            for(uint32_t v : corners) {
+                quadricAdd(_attributeQuadrics[v], q);
+                quadricAdd(&_attributeGradients[v * _attributeCount], g, _attributeCount);
+            }
+        }
+    }
+
+    bool Simplifier::canCollapse(uint32_t v, uint32_t t) const {
+        uint8_t kind = _kinds[v];
+        uint8_t target = _kinds[t];
+        if(kind == kManifold)
+            return true;
+        if(kind == kBorder)
+            return (target == kBorder || target == kLocked) && (_loop[v] == t || _loopback[v] == t);
+        if(kind == kSeam) {
+            if(target != kSeam || (_loop[v] != t && _loopback[v] != t))
+                return false;
+            uint32_t v1 = _wedge[v], t1 = _wedge[t];
+            return _loop[v1] == t1 || _loopback[v1] == t1;
+        }
+        return false;
+    }
+
+    float Simplifier::collapseError(uint32_t v, uint32_t t) const {
+        float error = quadricError(_vertexQuadrics[_remap[v]], _positions[t]);
+        if(_attributeCount > 0) {
+            error += quadricError(_attributeQuadrics[v], &_attributeGradients[v * _attributeCount], _attributeCount,
+                                  _positions[t], attributes(t));
+            if(_kinds[v] == kSeam) {
+                uint32_t v1 = _wedge[v], t1 = _wedge[t];
+                error += quadricError(_attributeQuadrics[v1], &_attributeGradients[v1 * _attributeCount], _attributeCount,
+                                      _positions[t1], attributes(t1));
+            }
+        }
+        return error;
+    }
+
+    // Triangles around v that stay must not turn around when v moves to t.
+    bool Simplifier::hasTriangleFlips(uint32_t v, uint32_t t) const {
+        uint32_t position = _remap[t];
+        const Vector3 &pv = _positions[v];
+        const Vector3 &pt = _positions[t];
+        uint32_t w = v;
+        do {
+            for(uint32_t e = _adjacency.offsets[w]; e < _adjacency.offsets[w + 1]; e++) {
+                uint32_t a = _collapseRemap[_adjacency.edges[e].next];
+                uint32_t b = _collapseRemap[_adjacency.edges[e].prev];
+                if(_remap[a] == position || _remap[b] == position)
+                    continue;
+                const Vector3 &pa = _positions[a];
+                const Vector3 &pb = _positions[b];
+                Vector3 before = cross(pa - pv, pb - pv);
+                Vector3 after = cross(pa - pt, pb - pt);
+                if(dot(before, after) <= 0.0f)
+                    return true;
+            }
+            w = _wedge[w];
+        } while(w != v);
+        return false;
+    }
+
+    void Simplifier::pickCollapses(const uint32_t *indices, size_t indexCount) {
+        _collapses.clear();
+        for(size_t i = 0; i < indexCount; i += 3) {
+            for(int k = 0; k < 3; k++) {
+                uint32_t a = indices[i + k], b = indices[i + (k + 1) % 3];
+                if(_remap[a] == _remap[b])
+                    continue;
+                // inner edges are seen twice
+                if(a > b && _adjacency.hasEdge(b, a))
+                    continue;
+
+                bool ab = canCollapse(a, b), ba = canCollapse(b, a);
+                if(!ab && !ba)
+                    continue;
+                float errorAB = ab ? collapseError(a, b) : FLT_MAX;
+                float errorBA = ba ? collapseError(b, a) : FLT_MAX;
+                if(errorAB <= errorBA)
+                    _collapses.push_back({ a, b, errorAB });
+                else
+                    _collapses.push_back({ b, a, errorBA });
+            }
+        }
+    }
+
+    // Moves collapses up to errorLimit to the front in order, returns how many.
+    size_t Simplifier::sortCollapses(float errorLimit) {
+        auto last = std::partition(_collapses.begin(), _collapses.end(), [errorLimit](const Collapse &collapse) {
+            return collapse.error <= errorLimit;
+        });
+        std::sort(_collapses.begin(), last, [](const Collapse &lhs, const Collapse &rhs) {
+            return lhs.error < rhs.error;
+        });
+        return last - _collapses.begin();
+    }
+
+    void Simplifier::mergeQuadrics(uint32_t v, uint32_t t) {
+        quadricAdd(_vertexQuadrics[_remap[t]], _vertexQuadrics[_remap[v]]);
+        mergeAttributeQuadrics(v, t);
+    }
+
+    void Simplifier::mergeAttributeQuadrics(uint32_t v, uint32_t t) {
+        if(_attributeCount == 0)
+            return;
+        quadricAdd(_attributeQuadrics[t], _attributeQuadrics[v]);
+        quadricAdd(&_attributeGradients[t * _attributeCount], &_attributeGradients[v * _attributeCount], _attributeCount);
+    }
+
+    // One collapse per position and pass, so quadrics and flip tests stay valid.
+    size_t Simplifier::performCollapses(size_t numCandidates, size_t triangleGoal, float &maxError) {
+        size_t numCollapses = 0, numTriangles = 0;
+        for(size_t i = 0; i < numCandidates && numTriangles < triangleGoal; i++) {
+            const Collapse &collapse = _collapses[i];
+            uint32_t v = collapse.v, t = collapse.t;
+            if(_collapseLocked[_remap[v]] || _collapseLocked[_remap[t]])
+                continue;
+            if(hasTriangleFlips(v, t))
+                continue;
+
+            // the other side of a seam follows, the position quadric is shared
+            _collapseRemap[v] = t;
+            mergeQuadrics(v, t);
+            if(_kinds[v] == kSeam) {
+                uint32_t v1 = _wedge[v], t1 = _wedge[t];
+                _collapseRemap[v1] = t1;
+                mergeAttributeQuadrics(v1, t1);
+            }
+            _collapseLocked[_remap[v]] = 1;
+            _collapseLocked[_remap[t]] = 1;
+
+            numTriangles += _kinds[v] == kBorder ? 1 : 2;
+            maxError = std::max(maxError, collapse.error);
+            numCollapses++;
+        }
+        return numCollapses;
+    }
+
+    size_t Simplifier::simplify(uint32_t *result, size_t indexCount, size_t targetIndexCount,
+                                float targetError, float *resultError) {
+        float errorLimit = targetError * targetError;
+        float maxError = 0.0f;
+        bool classified = false;
+
+        while(indexCount > targetIndexCount) {
+            _adjacency.build(result, indexCount, _vertexCount);
+            findOpenEdges(result, indexCount);
+            if(!classified) {
+                classifyVertices();
+                fillQuadrics(result, indexCount);
+                classified = true;
+            }
+
+            pickCollapses(result, indexCount);
+            if(_collapses.empty())
+                break;
+
+            // about two triangles go away with a collapse
+            size_t triangleGoal = std::max<size_t>((indexCount - targetIndexCount) / 3, 1);
+            auto goal = _collapses.begin() + std::min(_collapses.size() - 1, triangleGoal / 2);
+            std::nth_element(_collapses.begin(), goal, _collapses.end(), [](const Collapse &lhs, const Collapse &rhs) {
+                return lhs.error < rhs.error;
+            });
+            float passLimit = std::min(errorLimit, goal->error * kPassErrorBound);
+
+            _collapseRemap.resize(_vertexCount);
+            for(size_t v = 0; v < _vertexCount; v++)
+                _collapseRemap[v] = (uint32_t)v;
+            _collapseLocked.assign(_vertexCount, 0);
+            size_t numCollapses = performCollapses(sortCollapses(passLimit), triangleGoal, maxError);
+            // flips may have blocked all of them
+            if(numCollapses == 0 && passLimit < errorLimit)
+                numCollapses = performCollapses(sortCollapses(errorLimit), triangleGoal, maxError);
+            if(numCollapses == 0)
+                break;
+
+            // drop triangles that lost an edge
+            size_t count = 0;
+            for(size_t i = 0; i < indexCount; i += 3) {
+                uint32_t i0 = _collapseRemap[result[i]];
+                uint32_t i1 = _collapseRemap[result[i + 1]];
+                uint32_t i2 = _collapseRemap[result[i + 2]];
+                uint32_t r0 = _remap[i0], r1 = _remap[i1], r2 = _remap[i2];
+                if(r0 == r1 || r1 == r2 || r2 == r0)
+                    continue;
+                result[count++] = i0;
+                result[count++] = i1;
+                result[count++] = i2;
+            }
+            indexCount = count;
+        }
+
+        if(resultError)
+            *resultError = sqrtf(maxError);
+        return indexCount;
+    }
+}
+
+size_t mgp_mesh_simplify(uint32_t *destination, const uint32_t *indices, size_t indexCount,
+                         const mgp_mesh_simplify_vertices_t *vertices,
+                         size_t targetIndexCount, float targetError, float *resultError) {
+    indexCount -= indexCount % 3;
+    if(destination != indices)
+        memmove(destination, indices, indexCount * sizeof(uint32_t));
+    if(resultError)
+        *resultError = 0.0f;
+    if(indexCount == 0 || vertices->vertexCount == 0)
+        return indexCount;
+
+    Simplifier simplifier(vertices, destination, indexCount);
+    return simplifier.simplify(destination, indexCount, targetIndexCount, targetError, resultError);
+}
+
+void mgp_mesh_simplify_lock_submesh_borders(unsigned char *vertexLock, const uint32_t *indices,
+                                            const size_t *submeshIndexCounts, size_t submeshCount,
+                                            const float *positions, size_t positionStride,
+                                            size_t vertexCount) {
+    const uint32_t kShared = UINT32_MAX - 1;
+    std::vector<uint32_t> owners(vertexCount, UINT32_MAX);     // by the first vertex at a position
+    std::vector<uint32_t> remap(vertexCount, UINT32_MAX);
+    PositionTable table(positions, positionStride, vertexCount);
+
+    const uint32_t *submeshIndices = indices;
+    for(size_t s = 0; s < submeshCount; s++) {
+        for(size_t i = 0; i < submeshIndexCounts[s]; i++) {
+            uint32_t v = submeshIndices[i];
+            if(remap[v] == UINT32_MAX)
+                remap[v] = table.insert(v);
+            uint32_t &owner = owners[remap[v]];
+            if(owner == UINT32_MAX)
+                owner = (uint32_t)s;
+            else if(owner != s)
+                owner = kShared;
+        }
+        submeshIndices += submeshIndexCounts[s];
+    }
+
+    for(size_t v = 0; v < vertexCount; v++) {
+        if(remap[v] != UINT32_MAX && owners[remap[v]] == kShared)
+            vertexLock[v] = 1;
+    }
+}
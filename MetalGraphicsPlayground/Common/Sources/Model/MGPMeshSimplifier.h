@@ -0,0 +1,78 @@
+//
+//  MGPMeshSimplifier.h
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/17.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#ifndef MGPMeshSimplifier_h
+#define MGPMeshSimplifier_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <float.h>
+
+// Edge-collapse simplification of triangle lists after the quadric error metric
+// (Garland and Heckbert), with attributes in the error as gradients over the
+// triangles (Hoppe). Vertices only collapse into other vertices, so the result
+// indexes the same vertex buffer and LODs can share it.
+//  - borders collapse only along the border,
+//  - attribute seams (same position, two vertices) collapse on both sides at once,
+//  - locked vertices never move.
+// Errors are distances relative to the largest extent of the vertices.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    const float *positions;             // float3
+    size_t positionStride;              // bytes
+    const float *attributes;            // attributeCount floats per vertex, NULL for none
+    size_t attributeStride;             // bytes
+    const float *attributeWeights;      // one per attribute
+    size_t attributeCount;              // 8 at most
+    size_t vertexCount;
+    const unsigned char *vertexLock;    // 1 for vertices that can't move, NULL for none
+} mgp_mesh_simplify_vertices_t;
+
+// Writes at most indexCount indices and returns how many, stopping when the mesh
+// gets down to targetIndexCount or a collapse would be worse than targetError.
+// destination may be the same as indices. resultError may be NULL.
+size_t mgp_mesh_simplify(uint32_t *destination, const uint32_t *indices, size_t indexCount,
+                         const mgp_mesh_simplify_vertices_t *vertices,
+                         size_t targetIndexCount, float targetError, float *resultError);
+
+// Locks vertices whose position is used by more than one submesh, so submeshes
+// simplified on their own keep sharing their borders.
+// indices : submeshes one after another, submeshIndexCounts[i] indices each.
+void mgp_mesh_simplify_lock_submesh_borders(unsigned char *vertexLock, const uint32_t *indices,
+                                            const size_t *submeshIndexCounts, size_t submeshCount,
+                                            const float *positions, size_t positionStride,
+                                            size_t vertexCount);
+
+// Screen size of a view, LOD n fits if its error <= (orthographicHalfHeight + tanHalfFov * depth) / (radius * pixelScale).
+typedef struct {
+    float orthographicHalfHeight;
+    float tanHalfFov;
+    float pixelScale;               // half view height in pixels / allowed error in pixels
+} mgp_mesh_lod_view_t;
+
+// Returns the coarsest LOD that fits for a bounding sphere whose nearest point is depth from the eye.
+// lodErrors : relative to the radius, increasing from 0 at LOD 0.
+static inline uint32_t mgp_mesh_select_lod(const mgp_mesh_lod_view_t *view, const float *lodErrors,
+                                           uint32_t lodCount, float radius, float depth) {
+    float halfHeight = view->orthographicHalfHeight + view->tanHalfFov * (depth > 0.0f ? depth : 0.0f);
+    float allowedError = radius * view->pixelScale > 0.0f ? halfHeight / (radius * view->pixelScale) : FLT_MAX;
+    uint32_t lod = 0;
+    while(lod + 1 < lodCount && lodErrors[lod + 1] <= allowedError)
+        lod++;
+    return lod;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MGPMeshSimplifier_h */
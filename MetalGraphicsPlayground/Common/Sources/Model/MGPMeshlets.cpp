@@ -0,0 +1,381 @@
+//
+//  MGPMeshlets.cpp
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/17.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#include "MGPMeshlets.h"
+
+#include <float.h>
+#include <string.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace {
+    // triangles whose normal is shorter than this don't bend the cone
+    const float kDegenerateArea = 1e-12f;
+    const uint32_t kNoMeshlet = UINT32_MAX;
+    // an island goes on with the nearest of this many triangles left in the cache order
+    const size_t kIslandCandidates = 32;
+
+    struct Vector3 {
+        float x, y, z;
+    };
+
+    inline Vector3 operator+(const Vector3 &a, const Vector3 &b) { return { a.x + b.x, a.y + b.y, a.z + b.z }; }
+    inline Vector3 operator-(const Vector3 &a, const Vector3 &b) { return { a.x - b.x, a.y - b.y, a.z - b.z }; }
+    inline Vector3 operator*(const Vector3 &a, float s) { return { a.x * s, a.y * s, a.z * s }; }
+    inline float dot(const Vector3 &a, const Vector3 &b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+    inline Vector3 cross(const Vector3 &a, const Vector3 &b) {
+        return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+    }
+
+    inline Vector3 position(const float *positions, size_t positionStride, uint32_t index) {
+        const float *p = (const float *)((const uint8_t *)positions + positionStride * index);
+        return { p[0], p[1], p[2] };
+    }
+
+    // Unit normal of every triangle, zero for degenerate ones.
+    std::vector<Vector3> triangleNormals(const uint32_t *indices, size_t triangleCount,
+                                         const float *positions, size_t positionStride) {
+        std::vector<Vector3> normals(triangleCount);
+        for(size_t t = 0; t < triangleCount; t++) {
+            Vector3 a = position(positions, positionStride, indices[t * 3]);
+            Vector3 b = position(positions, positionStride, indices[t * 3 + 1]);
+            Vector3 c = position(positions, positionStride, indices[t * 3 + 2]);
+            Vector3 n = cross(b - a, c - a);
+            float length = sqrtf(dot(n, n));
+            normals[t] = length > kDegenerateArea ? n * (1.0f / length) : Vector3 { 0.0f, 0.0f, 0.0f };
+        }
+        return normals;
+    }
+
+    // Triangles around each vertex, with the number of them not in a meshlet yet.
+    struct VertexTriangles {
+        std::vector<uint32_t> offsets;
+        std::vector<uint32_t> triangles;
+        std::vector<uint32_t> live;
+
+        VertexTriangles(const uint32_t *indices, size_t indexCount, size_t vertexCount)
+        : offsets(vertexCount + 1, 0), triangles(indexCount), live(vertexCount, 0) {
+            for(size_t i = 0; i < indexCount; i++)
+                live[indices[i]]++;
+            for(size_t v = 0; v < vertexCount; v++)
+                offsets[v + 1] = offsets[v] + live[v];
+            std::vector<uint32_t> cursors(offsets.begin(), offsets.end() - 1);
+            for(size_t i = 0; i < indexCount; i++)
+                triangles[cursors[indices[i]]++] = (uint32_t)(i / 3);
+        }
+    };
+
+    class MeshletBuilder {
+    public:
+        MeshletBuilder(const uint32_t *indices, size_t indexCount,
+                       const float *positions, size_t vertexCount, size_t positionStride,
+                       size_t maxVertices, size_t maxTriangles, float coneWeight)
+        : _indices(indices), _positions(positions), _positionStride(positionStride),
+          _maxVertices(maxVertices), _maxTriangles(maxTriangles), _coneWeight(coneWeight),
+          _adjacency(indices, indexCount, vertexCount),
+          _normals(triangleNormals(indices, indexCount / 3, positions, positionStride)),
+          _emitted(indexCount / 3, 0), _vertexMeshlet(vertexCount, kNoMeshlet) {
+            _vertices.reserve(maxVertices);
+            _triangles.reserve(maxTriangles);
+        }
+
+        size_t build(mgp_meshlet_t *meshlets, uint32_t *destination) {
+            size_t triangleCount = _emitted.size();
+            size_t meshletCount = 0;
+            size_t seed = 0;
+            uint32_t writtenIndices = 0;
+            while(true) {
+                // a meshlet starts from the first triangle left in the cache order
+                while(seed < triangleCount && _emitted[seed])
+                    seed++;
+                if(seed == triangleCount)
+                    break;
+
+                uint32_t meshlet = (uint32_t)meshletCount;
+                _vertices.clear();
+                _triangles.clear();
+                _normalSum = { 0.0f, 0.0f, 0.0f };
+                add((uint32_t)seed, meshlet);
+
+                while(_triangles.size() < _maxTriangles) {
+                    // around the last triangle first, the whole meshlet if nothing good is left there
+                    uint32_t triangle = bestNeighbor(_indices + _triangles.back() * 3, 3, meshlet);
+                    if(triangle == kNoMeshlet || newVertices(triangle, meshlet) > 0)
+                        triangle = bestNeighbor(_vertices.data(), _vertices.size(), meshlet);
+                    if(triangle == kNoMeshlet) {
+                        while(seed < triangleCount && _emitted[seed])
+                            seed++;
+                        if(seed == triangleCount)
+                            break;
+                        triangle = nearestIsland(seed);
+                    }
+                    if(_vertices.size() + newVertices(triangle, meshlet) > _maxVertices)
+                        break;
+                    add(triangle, meshlet);
+                }
+
+                mgp_meshlet_t &result = meshlets[meshletCount++];
+                result.indexOffset = writtenIndices;
+                result.indexCount = (uint32_t)_triangles.size() * 3;
+                for(uint32_t triangle : _triangles) {
+                    memcpy(destination + writtenIndices, _indices + triangle * 3, sizeof(uint32_t) * 3);
+                    writtenIndices += 3;
+                }
+                computeBounds(result);
+            }
+            return meshletCount;
+        }
+
+    private:
+        const uint32_t *_indices;
+        const float *_positions;
+        size_t _positionStride;
+        size_t _maxVertices;
+        size_t _maxTriangles;
+        float _coneWeight;
+
+        VertexTriangles _adjacency;
+        std::vector<Vector3> _normals;
+        std::vector<uint8_t> _emitted;
+        std::vector<uint32_t> _vertexMeshlet;      // the meshlet a vertex is in lately
+
+        // current meshlet
+        std::vector<uint32_t> _vertices;
+        std::vector<uint32_t> _triangles;
+        Vector3 _normalSum;
+
+        uint32_t newVertices(uint32_t triangle, uint32_t meshlet) const {
+            const uint32_t *corners = _indices + triangle * 3;
+            uint32_t count = 0;
+            for(int i = 0; i < 3; i++)
+                count += _vertexMeshlet[corners[i]] != meshlet;
+            return count;
+        }
+
+        void add(uint32_t triangle, uint32_t meshlet) {
+            const uint32_t *corners = _indices + triangle * 3;
+            for(int i = 0; i < 3; i++) {
+                uint32_t vertex = corners[i];
+                if(_vertexMeshlet[vertex] != meshlet) {
+                    _vertexMeshlet[vertex] = meshlet;
+                    _vertices.push_back(vertex);
+                }
+                _adjacency.live[vertex]--;
+            }
+            _emitted[triangle] = 1;
+            _triangles.push_back(triangle);
+            _normalSum = _normalSum + _normals[triangle];
+        }
+
+        // The unused triangle around the vertices adding the fewest vertices to the meshlet
+        // and facing most like it. Vertices with few triangles left are finished first.
+        uint32_t bestNeighbor(const uint32_t *vertices, size_t vertexCount, uint32_t meshlet) const {
+            float lengthSquared = dot(_normalSum, _normalSum);
+            Vector3 facing = lengthSquared > 0.0f ? _normalSum * (1.0f / sqrtf(lengthSquared)) : _normalSum;
+            uint32_t best = kNoMeshlet;
+            float bestScore = FLT_MAX;
+            for(size_t v = 0; v < vertexCount; v++) {
+                uint32_t vertex = vertices[v];
+                if(_adjacency.live[vertex] == 0)
+                    continue;
+                for(uint32_t i = _adjacency.offsets[vertex]; i < _adjacency.offsets[vertex + 1]; i++) {
+                    uint32_t triangle = _adjacency.triangles[i];
+                    if(_emitted[triangle])
+                        continue;
+                    const uint32_t *corners = _indices + triangle * 3;
+                    float score = 0.0f;
+                    for(int c = 0; c < 3; c++) {
+                        if(_vertexMeshlet[corners[c]] != meshlet)
+                            score += 1.0f;
+                        else if(_adjacency.live[corners[c]] == 1)
+                            score -= 0.5f;
+                    }
+                    score += _coneWeight * (1.0f - dot(facing, _normals[triangle]));
+                    if(score < bestScore) {
+                        bestScore = score;
+                        best = triangle;
+                    }
+                }
+            }
+            return best;
+        }
+
+        Vector3 centroid(uint32_t triangle) const {
+            const uint32_t *corners = _indices + triangle * 3;
+            return (position(_positions, _positionStride, corners[0]) +
+                    position(_positions, _positionStride, corners[1]) +
+                    position(_positions, _positionStride, corners[2])) * (1.0f / 3.0f);
+        }
+
+        // The meshlet ran out of neighbors, so it goes on with the triangle nearest to it
+        // among the first ones left from seed.
+        uint32_t nearestIsland(size_t seed) const {
+            Vector3 center = { 0.0f, 0.0f, 0.0f };
+            for(uint32_t triangle : _triangles)
+                center = center + centroid(triangle);
+            center = center * (1.0f / _triangles.size());
+
+            uint32_t best = (uint32_t)seed;
+            float bestDistance = FLT_MAX;
+            for(size_t t = seed, candidates = 0; t < _emitted.size() && candidates < kIslandCandidates; t++) {
+                if(_emitted[t])
+                    continue;
+                Vector3 d = centroid((uint32_t)t) - center;
+                if(dot(d, d) < bestDistance) {
+                    bestDistance = dot(d, d);
+                    best = (uint32_t)t;
+                }
+                candidates++;
+            }
+            return best;
+        }
+
+        void computeBounds(mgp_meshlet_t &meshlet) const {
+            Vector3 minimum = { FLT_MAX, FLT_MAX, FLT_MAX };
+            Vector3 maximum = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+            for(uint32_t vertex : _vertices) {
+                Vector3 p = position(_positions, _positionStride, vertex);
+                minimum = { std::min(minimum.x, p.x), std::min(minimum.y, p.y), std::min(minimum.z, p.z) };
+                maximum = { std::max(maximum.x, p.x), std::max(maximum.y, p.y), std::max(maximum.z, p.z) };
+            }
+            Vector3 center = (minimum + maximum) * 0.5f;
+            float radiusSquared = 0.0f;
+            for(uint32_t vertex : _vertices) {
+                Vector3 d = position(_positions, _positionStride, vertex) - center;
+                radiusSquared = std::max(radiusSquared, dot(d, d));
+            }
+            meshlet.center[0] = center.x;
+            meshlet.center[1] = center.y;
+            meshlet.center[2] = center.z;
+            meshlet.radius = sqrtf(radiusSquared);
+
+            // the cone holds every normal, degenerate triangles face nowhere
+            float lengthSquared = dot(_normalSum, _normalSum);
+            Vector3 axis = lengthSquared > 0.0f ? _normalSum * (1.0f / sqrtf(lengthSquared)) : _normalSum;
+            float minimumCos = lengthSquared > 0.0f ? 1.0f : -1.0f;
+            for(uint32_t triangle : _triangles) {
+                const Vector3 &normal = _normals[triangle];
+                if(dot(normal, normal) > 0.0f)
+                    minimumCos = std::min(minimumCos, dot(axis, normal));
+            }
+            meshlet.coneAxis[0] = axis.x;
+            meshlet.coneAxis[1] = axis.y;
+            meshlet.coneAxis[2] = axis.z;
+            meshlet.coneCos = minimumCos;
+            meshlet.coneSin = sqrtf(std::max(0.0f, 1.0f - minimumCos * minimumCos));
+        }
+    };
+
+    // Every triangle of the meshlet faces away from the eye.
+    // For any point p in the sphere and normal n in the cone, dot(p - eye, n) >= |v| cos(a + t) - r
+    // with v = center - eye, a the angle between v and the axis, t the half angle of the cone.
+    inline bool isBackFacing(const mgp_meshlet_t &meshlet, const float eye[4]) {
+        if(meshlet.coneCos <= 0.0f || (eye[0] == 0.0f && eye[1] == 0.0f && eye[2] == 0.0f && eye[3] == 0.0f))
+            return false;
+        Vector3 v = {
+            meshlet.center[0] * eye[3] - eye[0],
+            meshlet.center[1] * eye[3] - eye[1],
+            meshlet.center[2] * eye[3] - eye[2]
+        };
+        Vector3 axis = { meshlet.coneAxis[0], meshlet.coneAxis[1], meshlet.coneAxis[2] };
+        float along = dot(v, axis);
+        float across = sqrtf(std::max(0.0f, dot(v, v) - along * along));
+        return along * meshlet.coneCos - across * meshlet.coneSin >= meshlet.radius * eye[3];
+    }
+}
+
+size_t mgp_meshlets_bound(size_t indexCount, size_t maxVertices, size_t maxTriangles) {
+    // a meshlet closes only when the next triangle doesn't fit, so it holds at least
+    // maxVertices - 2 indices
+    size_t triangleCount = indexCount / 3;
+    size_t byVertices = (indexCount + maxVertices - 3) / (maxVertices - 2);
+    size_t byTriangles = (triangleCount + maxTriangles - 1) / maxTriangles;
+    return std::max(byVertices, byTriangles);
+}
+
+size_t mgp_meshlets_build(mgp_meshlet_t *meshlets, uint32_t *destination,
+                          const uint32_t *indices, size_t indexCount,
+                          const float *positions, size_t vertexCount, size_t positionStride,
+                          size_t maxVertices, size_t maxTriangles, float coneWeight) {
+    if(indexCount < 3 || maxVertices < 3 || maxTriangles < 1)
+        return 0;
+    MeshletBuilder builder(indices, indexCount - indexCount % 3, positions, vertexCount, positionStride,
+                           maxVertices, maxTriangles, coneWeight);
+    return builder.build(meshlets, destination);
+}
+
+void mgp_meshlet_view_make(mgp_meshlet_view_t *view, const mgp_cull_planes_t *planes,
+                           const float eye[4], const float m[16]) {
+    // plane' = M^T * plane, normalized so spheres keep their radius
+    float equations[MGP_CULL_MAX_PLANES][4];
+    for(uint32_t i = 0; i < planes->count; i++) {
+        float p[4] = { planes->nx[i], planes->ny[i], planes->nz[i], planes->d[i] };
+        float nx = m[0] * p[0] + m[1] * p[1] + m[2] * p[2];
+        float ny = m[4] * p[0] + m[5] * p[1] + m[6] * p[2];
+        float nz = m[8] * p[0] + m[9] * p[1] + m[10] * p[2];
+        float d = m[12] * p[0] + m[13] * p[1] + m[14] * p[2] + p[3];
+        float length = sqrtf(nx * nx + ny * ny + nz * nz);
+        float scale = length > 0.0f ? 1.0f / length : 0.0f;
+        equations[i][0] = nx * scale;
+        equations[i][1] = ny * scale;
+        equations[i][2] = nz * scale;
+        equations[i][3] = d * scale;
+    }
+    mgp_cull_planes_make(&view->planes, equations, planes->count);
+
+    // eye' = M^-1 * eye, solved with the columns of the 3x3 part (Cramer's rule)
+    Vector3 x = { m[0], m[1], m[2] };
+    Vector3 y = { m[4], m[5], m[6] };
+    Vector3 z = { m[8], m[9], m[10] };
+    Vector3 yz = cross(y, z);
+    float determinant = dot(x, yz);
+    if(fabsf(determinant) < 1e-20f) {
+        memset(view->eye, 0, sizeof(view->eye));
+        return;
+    }
+    Vector3 e = {
+        eye[0] - m[12] * eye[3],
+        eye[1] - m[13] * eye[3],
+        eye[2] - m[14] * eye[3]
+    };
+    view->eye[0] = dot(e, yz) / determinant;
+    view->eye[1] = dot(x, cross(e, z)) / determinant;
+    view->eye[2] = dot(x, cross(y, e)) / determinant;
+    view->eye[3] = eye[3];
+    if(eye[3] == 0.0f) {
+        float length = sqrtf(view->eye[0] * view->eye[0] + view->eye[1] * view->eye[1] + view->eye[2] * view->eye[2]);
+        for(int r = 0; r < 3 && length > 0.0f; r++)
+            view->eye[r] /= length;
+    }
+}
+
+size_t mgp_meshlets_cull(mgp_index_range_t *ranges, const mgp_meshlet_t *meshlets, size_t meshletCount,
+                         const mgp_meshlet_view_t *views, size_t viewCount, size_t *visibleCount) {
+    size_t rangeCount = 0;
+    size_t visible = 0;
+    for(size_t i = 0; i < meshletCount; i++) {
+        const mgp_meshlet_t &meshlet = meshlets[i];
+        bool isVisible = false;
+        for(size_t v = 0; v < viewCount && !isVisible; v++) {
+            isVisible = mgp_cull_sphere_is_visible(&views[v].planes, meshlet.center, meshlet.radius) &&
+                        !isBackFacing(meshlet, views[v].eye);
+        }
+        if(!isVisible)
+            continue;
+
+        visible++;
+        if(rangeCount > 0 && ranges[rangeCount - 1].start + ranges[rangeCount - 1].count == meshlet.indexOffset)
+            ranges[rangeCount - 1].count += meshlet.indexCount;
+        else
+            ranges[rangeCount++] = { meshlet.indexOffset, meshlet.indexCount };
+    }
+    if(visibleCount)
+        *visibleCount = visible;
+    return rangeCount;
+}
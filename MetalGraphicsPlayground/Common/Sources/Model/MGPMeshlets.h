@@ -0,0 +1,79 @@
+//
+//  MGPMeshlets.h
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/17.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#ifndef MGPMeshlets_h
+#define MGPMeshlets_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include "MGPCulling.h"
+
+// Meshlets : small clusters of a triangle list, each with a bounding sphere and
+// a normal cone, so the CPU can drop clusters that are off-screen or face away
+// before the vertex stage sees them.
+// Clusters grow over shared vertices, preferring triangles that add few vertices
+// and face like the cluster. The triangles of a cluster are made contiguous in
+// the index list, so visible clusters are drawn as index ranges.
+
+#define MGP_MESHLET_MAX_VERTICES 64
+#define MGP_MESHLET_MAX_TRIANGLES 124
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    uint32_t indexOffset;       // into the reordered indices
+    uint32_t indexCount;
+    float center[3];            // bounding sphere
+    float radius;
+    float coneAxis[3];          // average facing of the triangles
+    float coneCos, coneSin;     // half angle of the cone, coneCos <= 0 if it can't cull
+} mgp_meshlet_t;
+
+typedef struct {
+    uint32_t start;
+    uint32_t count;
+} mgp_index_range_t;
+
+// a view in the space of the meshlets
+typedef struct {
+    mgp_cull_planes_t planes;
+    // xyz,1 : eye position, xyz,0 : direction the eye looks from (orthographic),
+    // 0,0,0,0 : no cone culling
+    float eye[4];
+} mgp_meshlet_view_t;
+
+// Most meshlets indexCount indices may need.
+size_t mgp_meshlets_bound(size_t indexCount, size_t maxVertices, size_t maxTriangles);
+
+// Writes the triangles into destination cluster by cluster, and returns the number of meshlets.
+// indices should be in the cache order already, which is kept inside a cluster where possible.
+// destination can't be the same as indices.
+// positions : float3 at every positionStride bytes.
+// coneWeight : 0 for the fewest vertices, larger for tighter cones (0.5 is a good start).
+size_t mgp_meshlets_build(mgp_meshlet_t *meshlets, uint32_t *destination,
+                          const uint32_t *indices, size_t indexCount,
+                          const float *positions, size_t vertexCount, size_t positionStride,
+                          size_t maxVertices, size_t maxTriangles, float coneWeight);
+
+// Brings world-space planes and eye into the space of a model, by its column-major affine matrix.
+void mgp_meshlet_view_make(mgp_meshlet_view_t *view, const mgp_cull_planes_t *planes,
+                           const float eye[4], const float modelMatrix[16]);
+
+// Writes the index ranges of meshlets visible in any of the views, neighbours merged,
+// and returns the number of ranges. ranges must hold meshletCount of them.
+// visibleCount may be NULL.
+size_t mgp_meshlets_cull(mgp_index_range_t *ranges, const mgp_meshlet_t *meshlets, size_t meshletCount,
+                         const mgp_meshlet_view_t *views, size_t viewCount, size_t *visibleCount);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MGPMeshlets_h */
@@ -0,0 +1,666 @@
+//
+//  MGPObjImporter.cpp
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/17.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#include "MGPObjImporter.h"
+#include "MGPWorkerPool.h"
+
+#include <fcntl.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+// corners refer to positions/uvs/normals by these
+const int64_t kAbsent = -1;
+const int64_t kRelative = (int64_t)1 << 48;     // chunk-local, biased by kRelativeBias
+const int64_t kRelativeBias = (int64_t)1 << 32;
+
+// Lines up to the next chunk boundary.
+struct Chunk {
+    enum EventType { Object, Material, MaterialLibrary };
+    struct Event {
+        EventType type;
+        size_t corner;          // number of corners before it in this chunk
+        std::string name;
+    };
+
+    std::vector<float> positions;
+    std::vector<float> uvs;
+    std::vector<float> normals;
+    std::vector<int64_t> corners;       // (position, uv, normal) of triangle corners
+    std::vector<Event> events;
+    int line = 0;                       // of the first error, 0 if none
+};
+
+// Part of an object with a single material, in corners of every chunk.
+struct Range {
+    size_t cornerStart, cornerEnd;
+    uint32_t material;
+};
+
+struct Object {
+    std::string name;
+    std::vector<Range> ranges;
+};
+
+struct ObjModel : mgp_obj_model_t {
+    std::vector<mgp_obj_vertex_t> vertexStorage;
+    std::vector<uint32_t> indexStorage;
+    std::vector<mgp_obj_object_t> objectStorage;
+    std::vector<mgp_obj_submesh_t> submeshStorage;
+    std::vector<mgp_obj_material_t> materialStorage;
+    std::deque<std::string> strings;    // names and paths, addresses stay
+
+    const char *keep(const std::string &string) {
+        strings.push_back(string);
+        return strings.back().c_str();
+    }
+};
+
+void setError(char *errorMessage, size_t errorMessageSize, const char *format, ...) {
+    if(errorMessage == NULL || errorMessageSize == 0)
+        return;
+    va_list args;
+    va_start(args, format);
+    vsnprintf(errorMessage, errorMessageSize, format, args);
+    va_end(args);
+}
+
+inline bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+inline const char *skipSpaces(const char *p, const char *end) {
+    while(p < end && isSpace(*p))
+        p++;
+    return p;
+}
+
+inline const char *endOfLine(const char *p, const char *end) {
+    const char *newline = (const char *)memchr(p, '\n', end - p);
+    return newline ? newline : end;
+}
+
+// Decimal to float without locale and iostreams.
+// Up to 19 significant digits are kept, the scaling is done in double.
+const char *parseFloat(const char *p, const char *end, float *value) {
+    static const double powers[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+        1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    p = skipSpaces(p, end);
+    bool negative = false;
+    if(p < end && (*p == '-' || *p == '+'))
+        negative = *p++ == '-';
+
+    uint64_t mantissa = 0;
+    int exponent = 0, numDigits = 0;
+    const char *start = p;
+    for(; p < end && *p >= '0' && *p <= '9'; p++) {
+        if(numDigits < 19) {
+            mantissa = mantissa * 10 + (*p - '0');
+            numDigits += mantissa > 0;
+        }
+        else
+            exponent++;
+    }
+    if(p < end && *p == '.') {
+        for(p++; p < end && *p >= '0' && *p <= '9'; p++) {
+            if(numDigits < 19) {
+                mantissa = mantissa * 10 + (*p - '0');
+                numDigits += mantissa > 0;
+                exponent--;
+            }
+        }
+    }
+    if(p == start)
+        return NULL;
+    if(p < end && (*p == 'e' || *p == 'E')) {
+        const char *q = p + 1;
+        bool negativeExponent = false;
+        if(q < end && (*q == '-' || *q == '+'))
+            negativeExponent = *q++ == '-';
+        if(q < end && *q >= '0' && *q <= '9') {
+            int e = 0;
+            for(; q < end && *q >= '0' && *q <= '9'; q++)
+                e = std::min(e * 10 + (*q - '0'), 10000);
+            exponent += negativeExponent ? -e : e;
+            p = q;
+        }
+    }
+
+    double result = (double)mantissa;
+    if(exponent < 0 && exponent >= -22)
+        result /= powers[-exponent];
+    else if(exponent > 0 && exponent <= 22)
+        result *= powers[exponent];
+    else if(exponent != 0)
+        result *= std::pow(10.0, exponent);
+    *value = (float)(negative ? -result : result);
+    return p;
+}
+
+const char *parseInt(const char *p, const char *end, int64_t *value) {
+    bool negative = false;
+    if(p < end && (*p == '-' || *p == '+'))
+        negative = *p++ == '-';
+    const char *start = p;
+    int64_t result = 0;
+    for(; p < end && *p >= '0' && *p <= '9'; p++)
+        result = std::min(result * 10 + (*p - '0'), kRelativeBias - 1);
+    if(p == start)
+        return NULL;
+    *value = negative ? -result : result;
+    return p;
+}
+
+// 1-based or negative, to an absolute index or a chunk-local one
+inline int64_t encodeIndex(int64_t index, size_t localCount) {
+    if(index > 0)
+        return index - 1;
+    if(index < 0)
+        return kRelative + kRelativeBias + (int64_t)localCount + index;
+    return kAbsent - 1;     // invalid, 0 isn't an index
+}
+
+const char *parseFloats(const char *p, const char *end, std::vector<float> &values, int count, int required) {
+    for(int i = 0; i < count; i++) {
+        float value = 0.0f;
+        const char *next = parseFloat(p, end, &value);
+        if(next == NULL) {
+            if(i < required)
+                return NULL;
+            value = 0.0f;
+            next = p;
+        }
+        values.push_back(value);
+        p = next;
+    }
+    return p;
+}
+
+std::string restOfLine(const char *p, const char *end) {
+    p = skipSpaces(p, end);
+    while(end > p && isSpace(end[-1]))
+        end--;
+    return std::string(p, end);
+}
+
+inline bool keyword(const char *p, const char *end, const char *word, size_t length) {
+    return (size_t)(end - p) >= length && memcmp(p, word, length) == 0 &&
+           ((size_t)(end - p) == length || isSpace(p[length]));
+}
+
+void parseChunk(const char *p, const char *end, int firstLine, Chunk &chunk) {
+    std::vector<int64_t> polygon;
+    int line = firstLine;
+    for(; p < end; line++) {
+        const char *lineEnd = endOfLine(p, end);
+        const char *q = skipSpaces(p, lineEnd);
+        const char *next = lineEnd < end ? lineEnd + 1 : end;
+        if(q == lineEnd || *q == '#') {
+            p = next;
+            continue;
+        }
+
+        bool valid = true;
+        if(q[0] == 'v' && q + 1 < lineEnd && isSpace(q[1]))
+            valid = parseFloats(q + 2, lineEnd, chunk.positions, 3, 3) != NULL;
+        else if(q[0] == 'v' && q + 2 < lineEnd && q[1] == 't' && isSpace(q[2]))
+            valid = parseFloats(q + 3, lineEnd, chunk.uvs, 2, 1) != NULL;
+        else if(q[0] == 'v' && q + 2 < lineEnd && q[1] == 'n' && isSpace(q[2]))
+            valid = parseFloats(q + 3, lineEnd, chunk.normals, 3, 3) != NULL;
+        else if(q[0] == 'f' && q + 1 < lineEnd && isSpace(q[1])) {
+            polygon.clear();
+            const char *r = skipSpaces(q + 2, lineEnd);
+            while(valid && r < lineEnd) {
+                int64_t position = 0, uv = 0, normal = 0;
+                r = parseInt(r, lineEnd, &position);
+                if(r && r < lineEnd && *r == '/') {
+                    r++;
+                    if(r < lineEnd && *r != '/')
+                        r = parseInt(r, lineEnd, &uv);
+                    if(r && r < lineEnd && *r == '/')
+                        r = parseInt(r + 1, lineEnd, &normal);
+                }
+                valid = r != NULL && (r == lineEnd || isSpace(*r));
+                if(valid) {
+                    polygon.push_back(encodeIndex(position, chunk.positions.size() / 3));
+                    polygon.push_back(uv ? encodeIndex(uv, chunk.uvs.size() / 2) : kAbsent);
+                    polygon.push_back(normal ? encodeIndex(normal, chunk.normals.size() / 3) : kAbsent);
+                    r = skipSpaces(r, lineEnd);
+                }
+            }
+            size_t numCorners = polygon.size() / 3;
+            valid = valid && numCorners >= 3;
+            for(size_t i = 1; valid && i + 1 < numCorners; i++) {
+                chunk.corners.insert(chunk.corners.end(), &polygon[0], &polygon[3]);
+                chunk.corners.insert(chunk.corners.end(), &polygon[i * 3], &polygon[i * 3 + 6]);
+            }
+        }
+        else if(keyword(q, lineEnd, "o", 1) || keyword(q, lineEnd, "g", 1))
+            chunk.events.push_back({ Chunk::Object, chunk.corners.size() / 3, restOfLine(q + 1, lineEnd) });
+        else if(keyword(q, lineEnd, "usemtl", 6))
+            chunk.events.push_back({ Chunk::Material, chunk.corners.size() / 3, restOfLine(q + 6, lineEnd) });
+        else if(keyword(q, lineEnd, "mtllib", 6))
+            chunk.events.push_back({ Chunk::MaterialLibrary, chunk.corners.size() / 3, restOfLine(q + 6, lineEnd) });
+
+        if(!valid && chunk.line == 0)
+            chunk.line = line;
+        p = next;
+    }
+}
+
+// Last token is the file name, options like -bm come before it.
+const char *mapPath(ObjModel *model, const std::string &directory, const char *p, const char *end) {
+    std::string value = restOfLine(p, end);
+    size_t space = value.find_last_of(" \t");
+    if(space != std::string::npos)
+        value = value.substr(space + 1);
+    if(value.empty())
+        return NULL;
+    for(char &c : value) {
+        if(c == '\\')
+            c = '/';
+    }
+    return model->keep(value[0] == '/' || directory.empty() ? value : directory + "/" + value);
+}
+
+void parseMaterialLibrary(ObjModel *model, const std::string &path,
+                          std::unordered_map<std::string, uint32_t> &materialIndices) {
+    FILE *file = fopen(path.c_str(), "rb");
+    if(file == NULL)
+        return;
+    std::string data;
+    char buffer[16384];
+    size_t length;
+    while((length = fread(buffer, 1, sizeof(buffer), file)) > 0)
+        data.append(buffer, length);
+    fclose(file);
+
+    size_t slash = path.find_last_of('/');
+    std::string directory = slash != std::string::npos ? path.substr(0, slash) : std::string();
+    mgp_obj_material_t *material = NULL;
+    const char *p = data.data(), *end = data.data() + data.size();
+    while(p < end) {
+        const char *lineEnd = endOfLine(p, end);
+        const char *q = skipSpaces(p, lineEnd);
+        std::vector<float> values;
+        if(keyword(q, lineEnd, "newmtl", 6)) {
+            std::string name = restOfLine(q + 6, lineEnd);
+            auto index = materialIndices.find(name);
+            if(index == materialIndices.end()) {
+                index = materialIndices.emplace(name, (uint32_t)model->materialStorage.size()).first;
+                model->materialStorage.emplace_back();
+            }
+            material = &model->materialStorage[index->second];
+            *material = {};
+            material->name = model->keep(name);
+            material->specularExponent = 0.0f;
+            material->dissolve = 1.0f;
+        }
+        else if(material == NULL) {
+        }
+        else if(keyword(q, lineEnd, "Ka", 2) && parseFloats(q + 2, lineEnd, values, 3, 1))
+            memcpy(material->ambient, values.data(), sizeof(material->ambient));
+        else if(keyword(q, lineEnd, "Kd", 2) && parseFloats(q + 2, lineEnd, values, 3, 1))
+            memcpy(material->diffuse, values.data(), sizeof(material->diffuse));
+        else if(keyword(q, lineEnd, "Ks", 2) && parseFloats(q + 2, lineEnd, values, 3, 1))
+            memcpy(material->specular, values.data(), sizeof(material->specular));
+        else if(keyword(q, lineEnd, "Ns", 2) && parseFloats(q + 2, lineEnd, values, 1, 1))
+            material->specularExponent = values[0];
+        else if(keyword(q, lineEnd, "d", 1) && parseFloats(q + 1, lineEnd, values, 1, 1))
+            material->dissolve = values[0];
+        else if(keyword(q, lineEnd, "Tr", 2) && parseFloats(q + 2, lineEnd, values, 1, 1))
+            material->dissolve = 1.0f - values[0];
+        else if(keyword(q, lineEnd, "map_Ka", 6))
+            material->ambientMap = mapPath(model, directory, q + 6, lineEnd);
+        else if(keyword(q, lineEnd, "map_Kd", 6))
+            material->diffuseMap = mapPath(model, directory, q + 6, lineEnd);
+        else if(keyword(q, lineEnd, "map_Ks", 6))
+            material->specularMap = mapPath(model, directory, q + 6, lineEnd);
+        else if(keyword(q, lineEnd, "map_bump", 8) || keyword(q, lineEnd, "map_Bump", 8))
+            material->normalMap = mapPath(model, directory, q + 8, lineEnd);
+        else if(keyword(q, lineEnd, "bump", 4) || keyword(q, lineEnd, "norm", 4))
+            material->normalMap = mapPath(model, directory, q + 4, lineEnd);
+        else if(keyword(q, lineEnd, "map_Pr", 6))
+            material->roughnessMap = mapPath(model, directory, q + 6, lineEnd);
+        else if(keyword(q, lineEnd, "map_Pm", 6))
+            material->metallicMap = mapPath(model, directory, q + 6, lineEnd);
+        else if(keyword(q, lineEnd, "map_d", 5))
+            material->opacityMap = mapPath(model, directory, q + 5, lineEnd);
+        p = lineEnd < end ? lineEnd + 1 : end;
+    }
+}
+
+// Open addressing over (position, uv, normal), returns the slot of the key.
+class CornerTable {
+public:
+    explicit CornerTable(size_t numCorners) {
+        size_t capacity = 16;
+        while(capacity < numCorners * 2)
+            capacity <<= 1;
+        _mask = capacity - 1;
+        _keys.resize(capacity * 3);
+        _values.assign(capacity, UINT32_MAX);
+    }
+
+    // Returns the vertex of the key, or inserts the next one and sets inserted.
+    uint32_t find(const int64_t *key, uint32_t next, bool &inserted) {
+        uint64_t hash = (uint64_t)key[0] * 0x9e3779b97f4a7c15ULL ^
+                        (uint64_t)key[1] * 0xc2b2ae3d27d4eb4fULL ^
+                        (uint64_t)key[2] * 0x165667b19e3779f9ULL;
+        hash ^= hash >> 29;
+        for(size_t slot = hash & _mask;; slot = (slot + 1) & _mask) {
+            if(_values[slot] == UINT32_MAX) {
+                memcpy(&_keys[slot * 3], key, sizeof(int64_t) * 3);
+                _values[slot] = next;
+                inserted = true;
+                return next;
+            }
+            if(memcmp(&_keys[slot * 3], key, sizeof(int64_t) * 3) == 0) {
+                inserted = false;
+                return _values[slot];
+            }
+        }
+    }
+
+private:
+    size_t _mask;
+    std::vector<int64_t> _keys;
+    std::vector<uint32_t> _values;
+};
+
+}   // namespace
+
+mgp_obj_model_t *mgp_obj_parse(const char *data, size_t size, const char *basePath, uint32_t numThreads,
+                               char *errorMessage, size_t errorMessageSize) {
+    if(numThreads == 0)
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
+    mgp::WorkerPool pool(numThreads);
+
+    // line-aligned chunks, a few per thread so uneven ones balance out
+    const size_t minChunkSize = 1 << 18;
+    size_t numChunks = std::max<size_t>(1, std::min<size_t>(numThreads * 4, size / minChunkSize));
+    std::vector<const char *> bounds(numChunks + 1);
+    bounds[0] = data;
+    bounds[numChunks] = data + size;
+    for(size_t i = 1; i < numChunks; i++) {
+        const char *p = std::max(bounds[i - 1], data + size * i / numChunks);
+        const char *newline = (const char *)memchr(p, '\n', data + size - p);
+        bounds[i] = newline ? newline + 1 : data + size;
+    }
+
+    std::vector<Chunk> chunks(numChunks);
+    std::vector<int> firstLines(numChunks, 0);
+    {
+        std::atomic<size_t> next(0);
+        pool.run([&](uint32_t) {
+            size_t index;
+            while((index = next.fetch_add(1)) < numChunks)
+                parseChunk(bounds[index], bounds[index + 1], 0, chunks[index]);
+        });
+    }
+    for(size_t i = 0; i < numChunks; i++) {
+        if(chunks[i].line != 0) {
+            // line numbers are counted only for the message
+            int line = chunks[i].line + 1;
+            for(const char *p = data; p < bounds[i]; p++)
+                line += *p == '\n';
+            setError(errorMessage, errorMessageSize, "Invalid statement at line %d", line);
+            return NULL;
+        }
+    }
+
+    ObjModel *model = new ObjModel();
+    std::unordered_map<std::string, uint32_t> materialIndices;
+
+    // chunk offsets of attributes and corners
+    std::vector<size_t> positionStarts(numChunks + 1, 0), uvStarts(numChunks + 1, 0);
+    std::vector<size_t> normalStarts(numChunks + 1, 0), cornerStarts(numChunks + 1, 0);
+    for(size_t i = 0; i < numChunks; i++) {
+        positionStarts[i + 1] = positionStarts[i] + chunks[i].positions.size() / 3;
+        uvStarts[i + 1] = uvStarts[i] + chunks[i].uvs.size() / 2;
+        normalStarts[i + 1] = normalStarts[i] + chunks[i].normals.size() / 3;
+        cornerStarts[i + 1] = cornerStarts[i] + chunks[i].corners.size() / 3;
+    }
+
+    // objects and materials in file order
+    std::vector<Object> objects(1);
+    uint32_t material = MGP_OBJ_NO_MATERIAL;
+    size_t rangeStart = 0;
+    auto closeRange = [&](size_t corner) {
+        if(corner > rangeStart)
+            objects.back().ranges.push_back({ rangeStart, corner, material });
+        rangeStart = corner;
+    };
+    for(size_t i = 0; i < numChunks; i++) {
+        for(const auto &event : chunks[i].events) {
+            size_t corner = cornerStarts[i] + event.corner;
+            if(event.type == Chunk::Object) {
+                closeRange(corner);
+                if(!objects.back().ranges.empty())
+                    objects.emplace_back();
+                objects.back().name = event.name;
+            }
+            else if(event.type == Chunk::Material) {
+                closeRange(corner);
+                auto index = materialIndices.find(event.name);
+                material = index != materialIndices.end() ? index->second : MGP_OBJ_NO_MATERIAL;
+            }
+            else if(basePath) {
+                // libraries come before the materials they define
+                size_t start = 0;
+                while(start < event.name.size()) {
+                    size_t stop = event.name.find_first_of(" \t", start);
+                    if(stop == std::string::npos)
+                        stop = event.name.size();
+                    if(stop > start) {
+                        std::string name = event.name.substr(start, stop - start);
+                        parseMaterialLibrary(model, name[0] == '/' ? name : std::string(basePath) + "/" + name,
+                                             materialIndices);
+                    }
+                    start = stop + 1;
+                }
+            }
+        }
+    }
+    closeRange(cornerStarts[numChunks]);
+    if(objects.back().ranges.empty())
+        objects.pop_back();
+
+    // every object is deduplicated on its own
+    struct ObjectResult {
+        std::vector<mgp_obj_vertex_t> vertices;
+        std::vector<uint32_t> indices;
+        bool valid = true;
+        bool hasNormals = false, hasUVs = false;
+    };
+    std::vector<ObjectResult> results(objects.size());
+    {
+        auto resolve = [](int64_t index, size_t chunkStart, size_t count) -> int64_t {
+            if(index >= kRelative)
+                index = (int64_t)chunkStart + (index - kRelative - kRelativeBias);
+            return index >= 0 && (size_t)index < count ? index : -1;
+        };
+        const size_t numPositions = positionStarts[numChunks];
+        const size_t numUVs = uvStarts[numChunks];
+        const size_t numNormals = normalStarts[numChunks];
+
+        std::atomic<size_t> next(0);
+        pool.run([&](uint32_t) {
+            size_t objectIndex;
+            while((objectIndex = next.fetch_add(1)) < objects.size()) {
+                const Object &object = objects[objectIndex];
+                ObjectResult &result = results[objectIndex];
+                size_t numCorners = 0;
+                for(const Range &range : object.ranges)
+                    numCorners += range.cornerEnd - range.cornerStart;
+                CornerTable table(numCorners);
+                result.indices.reserve(numCorners);
+
+                size_t chunkIndex = 0;
+                for(const Range &range : object.ranges) {
+                    for(size_t corner = range.cornerStart; corner < range.cornerEnd && result.valid; corner++) {
+                        while(corner >= cornerStarts[chunkIndex + 1])
+                            chunkIndex++;
+                        const Chunk &chunk = chunks[chunkIndex];
+                        const int64_t *raw = &chunk.corners[(corner - cornerStarts[chunkIndex]) * 3];
+                        int64_t key[3] = {
+                            resolve(raw[0], positionStarts[chunkIndex], numPositions),
+                            raw[1] == kAbsent ? kAbsent : resolve(raw[1], uvStarts[chunkIndex], numUVs),
+                            raw[2] == kAbsent ? kAbsent : resolve(raw[2], normalStarts[chunkIndex], numNormals)
+                        };
+                        if(key[0] < 0 || (raw[1] != kAbsent && key[1] < 0) || (raw[2] != kAbsent && key[2] < 0)) {
+                            result.valid = false;
+                            break;
+                        }
+
+                        bool inserted = false;
+                        uint32_t vertex = table.find(key, (uint32_t)result.vertices.size(), inserted);
+                        result.indices.push_back(vertex);
+                        if(!inserted)
+                            continue;
+
+                        // attributes are read from the chunk which defined them
+                        mgp_obj_vertex_t v = {};
+                        auto chunkOf = [&](const std::vector<size_t> &starts, int64_t index) {
+                            return (size_t)(std::upper_bound(starts.begin(), starts.end(), (size_t)index) - starts.begin() - 1);
+                        };
+                        size_t c = chunkOf(positionStarts, key[0]);
+                        memcpy(v.position, &chunks[c].positions[(key[0] - positionStarts[c]) * 3], sizeof(v.position));
+                        if(key[1] >= 0) {
+                            c = chunkOf(uvStarts, key[1]);
+                            memcpy(v.uv, &chunks[c].uvs[(key[1] - uvStarts[c]) * 2], sizeof(v.uv));
+                            result.hasUVs = true;
+                        }
+                        if(key[2] >= 0) {
+                            c = chunkOf(normalStarts, key[2]);
+                            memcpy(v.normal, &chunks[c].normals[(key[2] - normalStarts[c]) * 3], sizeof(v.normal));
+                            result.hasNormals = true;
+                        }
+                        result.vertices.push_back(v);
+                    }
+                }
+            }
+        });
+    }
+
+    size_t numVertices = 0, numIndices = 0, numSubmeshes = 0;
+    for(size_t i = 0; i < objects.size(); i++) {
+        if(!results[i].valid) {
+            setError(errorMessage, errorMessageSize, "Face index out of range in object '%s'", objects[i].name.c_str());
+            delete model;
+            return NULL;
+        }
+        numVertices += results[i].vertices.size();
+        numIndices += results[i].indices.size();
+        numSubmeshes += objects[i].ranges.size();
+    }
+    if(numVertices > UINT32_MAX || numIndices > UINT32_MAX) {
+        setError(errorMessage, errorMessageSize, "Too many vertices");
+        delete model;
+        return NULL;
+    }
+
+    model->vertexStorage.resize(numVertices);
+    model->indexStorage.resize(numIndices);
+    model->objectStorage.reserve(objects.size());
+    model->submeshStorage.reserve(numSubmeshes);
+    std::vector<size_t> vertexStarts, indexStarts;
+    size_t vertexStart = 0, indexStart = 0;
+    for(size_t i = 0; i < objects.size(); i++) {
+        mgp_obj_object_t object = {
+            model->keep(objects[i].name), (uint32_t)vertexStart, (uint32_t)results[i].vertices.size(),
+            (uint32_t)model->submeshStorage.size(), (uint32_t)objects[i].ranges.size()
+        };
+        model->objectStorage.push_back(object);
+        vertexStarts.push_back(vertexStart);
+        indexStarts.push_back(indexStart);
+
+        size_t submeshStart = indexStart;
+        for(const Range &range : objects[i].ranges) {
+            uint32_t count = (uint32_t)(range.cornerEnd - range.cornerStart);
+            model->submeshStorage.push_back({ (uint32_t)submeshStart, count, range.material });
+            submeshStart += count;
+        }
+        vertexStart += results[i].vertices.size();
+        indexStart += results[i].indices.size();
+        model->hasNormals |= results[i].hasNormals;
+        model->hasUVs |= results[i].hasUVs;
+    }
+    {
+        std::atomic<size_t> next(0);
+        pool.run([&](uint32_t) {
+            size_t i;
+            while((i = next.fetch_add(1)) < objects.size()) {
+                std::copy(results[i].vertices.begin(), results[i].vertices.end(), &model->vertexStorage[vertexStarts[i]]);
+                std::copy(results[i].indices.begin(), results[i].indices.end(), &model->indexStorage[indexStarts[i]]);
+            }
+        });
+    }
+
+    model->vertices = model->vertexStorage.data();
+    model->indices = model->indexStorage.data();
+    model->objects = model->objectStorage.data();
+    model->submeshes = model->submeshStorage.data();
+    model->materials = model->materialStorage.data();
+    model->numVertices = numVertices;
+    model->numIndices = numIndices;
+    model->numObjects = (uint32_t)model->objectStorage.size();
+    model->numSubmeshes = (uint32_t)model->submeshStorage.size();
+    model->numMaterials = (uint32_t)model->materialStorage.size();
+    return model;
+}
+
+mgp_obj_model_t *mgp_obj_load(const char *path, uint32_t numThreads, char *errorMessage, size_t errorMessageSize) {
+    int fd = open(path, O_RDONLY);
+    if(fd < 0) {
+        setError(errorMessage, errorMessageSize, "Couldn't open %s", path);
+        return NULL;
+    }
+    struct stat st;
+    if(fstat(fd, &st) != 0) {
+        close(fd);
+        setError(errorMessage, errorMessageSize, "Couldn't get size of %s", path);
+        return NULL;
+    }
+    size_t size = (size_t)st.st_size;
+    void *mapping = size > 0 ? mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0) : NULL;
+    close(fd);
+    if(mapping == MAP_FAILED) {
+        setError(errorMessage, errorMessageSize, "Couldn't map %s", path);
+        return NULL;
+    }
+    if(mapping)
+        madvise(mapping, size, MADV_SEQUENTIAL);
+
+    std::string directory(path);
+    size_t slash = directory.find_last_of('/');
+    directory = slash != std::string::npos ? directory.substr(0, slash) : std::string(".");
+    mgp_obj_model_t *model = mgp_obj_parse((const char *)mapping, size, directory.c_str(), numThreads,
+                                           errorMessage, errorMessageSize);
+    if(mapping)
+        munmap(mapping, size);
+    return model;
+}
+
+void mgp_obj_destroy(mgp_obj_model_t *model) {
+    delete static_cast<ObjModel *>(model);
+}
@@ -0,0 +1,96 @@
+//
+//  MGPObjImporter.h
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/17.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#ifndef MGPObjImporter_h
+#define MGPObjImporter_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Wavefront OBJ/MTL importer.
+// The file is split into line-aligned chunks parsed in parallel, then the
+// vertices of each object are deduplicated in parallel and written in the
+// interleaved layout of the base vertex descriptor (see MGPGBuffer).
+//  - 'o' and 'g' start a new object, 'usemtl' a new submesh,
+//  - polygons are triangulated as fans, negative indices are supported,
+//  - corners without vt/vn get zero uv/normal, tangents are left zero.
+// Indices of an object are relative to its first vertex.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MGP_OBJ_NO_MATERIAL UINT32_MAX
+
+// attrib_pos, attrib_uv, attrib_normal, attrib_tangent, 44 bytes
+typedef struct {
+    float position[3];
+    float uv[2];
+    float normal[3];
+    float tangent[3];
+} mgp_obj_vertex_t;
+
+typedef struct {
+    const char *name;
+    uint32_t vertexStart;
+    uint32_t vertexCount;
+    uint32_t submeshStart;
+    uint32_t submeshCount;
+} mgp_obj_object_t;
+
+typedef struct {
+    uint32_t indexStart;
+    uint32_t indexCount;
+    uint32_t material;          // MGP_OBJ_NO_MATERIAL if none
+} mgp_obj_submesh_t;
+
+// Map paths are resolved against the directory of the MTL file, NULL if absent.
+typedef struct {
+    const char *name;
+    float ambient[3];           // Ka
+    float diffuse[3];           // Kd
+    float specular[3];          // Ks
+    float specularExponent;     // Ns
+    float dissolve;             // d, or 1 - Tr
+    const char *ambientMap;     // map_Ka
+    const char *diffuseMap;     // map_Kd
+    const char *specularMap;    // map_Ks
+    const char *normalMap;      // bump, map_bump, norm
+    const char *roughnessMap;   // map_Pr
+    const char *metallicMap;    // map_Pm
+    const char *opacityMap;     // map_d
+} mgp_obj_material_t;
+
+typedef struct {
+    const mgp_obj_vertex_t *vertices;
+    const uint32_t *indices;
+    const mgp_obj_object_t *objects;
+    const mgp_obj_submesh_t *submeshes;
+    const mgp_obj_material_t *materials;
+    size_t numVertices;
+    size_t numIndices;
+    uint32_t numObjects;
+    uint32_t numSubmeshes;
+    uint32_t numMaterials;
+    int hasNormals;             // any corner had vn
+    int hasUVs;                 // any corner had vt
+} mgp_obj_model_t;
+
+// Maps the file, reads MTL libraries next to it. numThreads : 0 picks the hardware concurrency.
+// Returns NULL and a message on failure.
+mgp_obj_model_t *mgp_obj_load(const char *path, uint32_t numThreads, char *errorMessage, size_t errorMessageSize);
+// basePath : directory of MTL libraries, may be NULL to skip them.
+mgp_obj_model_t *mgp_obj_parse(const char *data, size_t size, const char *basePath, uint32_t numThreads,
+                               char *errorMessage, size_t errorMessageSize);
+void mgp_obj_destroy(mgp_obj_model_t *model);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MGPObjImporter_h */
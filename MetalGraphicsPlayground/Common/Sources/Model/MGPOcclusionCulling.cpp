@@ -0,0 +1,542 @@
+//
+//  MGPOcclusionCulling.cpp
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/17.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#include "MGPOcclusionCulling.h"
+#include "MGPWorkerPool.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include <algorithm>
+#include <vector>
+
+// MGP_OCCLUSION_SCALAR forces the scalar lanes, which rasterize the same depth.
+#if defined(MGP_OCCLUSION_SCALAR)
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define MGP_OCCLUSION_SSE 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define MGP_OCCLUSION_NEON 1
+#endif
+
+namespace {
+
+const uint32_t kTileWidth = MGP_OCCLUSION_TILE_WIDTH;
+const uint32_t kTileHeight = MGP_OCCLUSION_TILE_HEIGHT;
+const uint32_t kTileSize = kTileWidth * kTileHeight;
+const size_t kDefaultTriangleBudget = 65536;
+
+// 4-wide float, mask
+#if MGP_OCCLUSION_SSE
+struct F4 { __m128 v; };
+struct M4 { __m128 v; };
+inline F4 splat(float x) { return { _mm_set1_ps(x) }; }
+inline F4 make4(float a, float b, float c, float d) { return { _mm_setr_ps(a, b, c, d) }; }
+inline F4 load4(const float *p) { return { _mm_load_ps(p) }; }
+inline void store4(float *p, F4 a) { _mm_store_ps(p, a.v); }
+inline F4 operator+(F4 a, F4 b) { return { _mm_add_ps(a.v, b.v) }; }
+inline F4 operator*(F4 a, F4 b) { return { _mm_mul_ps(a.v, b.v) }; }
+inline F4 min4(F4 a, F4 b) { return { _mm_min_ps(a.v, b.v) }; }
+inline F4 max4(F4 a, F4 b) { return { _mm_max_ps(a.v, b.v) }; }
+inline M4 nonNegative(F4 a) { return { _mm_cmpge_ps(a.v, _mm_setzero_ps()) }; }
+inline M4 operator&(M4 a, M4 b) { return { _mm_and_ps(a.v, b.v) }; }
+inline F4 select4(M4 m, F4 a, F4 b) { return { _mm_or_ps(_mm_and_ps(m.v, a.v), _mm_andnot_ps(m.v, b.v)) }; }
+inline float hmax4(F4 a) {
+    __m128 m = _mm_max_ps(a.v, _mm_shuffle_ps(a.v, a.v, _MM_SHUFFLE(2, 3, 0, 1)));
+    m = _mm_max_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(1, 0, 3, 2)));
+    return _mm_cvtss_f32(m);
+}
+#elif MGP_OCCLUSION_NEON
+struct F4 { float32x4_t v; };
+struct M4 { uint32x4_t v; };
+inline F4 splat(float x) { return { vdupq_n_f32(x) }; }
+inline F4 make4(float a, float b, float c, float d) { float t[4] = { a, b, c, d }; return { vld1q_f32(t) }; }
+inline F4 load4(const float *p) { return { vld1q_f32(p) }; }
+inline void store4(float *p, F4 a) { vst1q_f32(p, a.v); }
+inline F4 operator+(F4 a, F4 b) { return { vaddq_f32(a.v, b.v) }; }
+inline F4 operator*(F4 a, F4 b) { return { vmulq_f32(a.v, b.v) }; }
+inline F4 min4(F4 a, F4 b) { return { vminq_f32(a.v, b.v) }; }
+inline F4 max4(F4 a, F4 b) { return { vmaxq_f32(a.v, b.v) }; }
+inline M4 nonNegative(F4 a) { return { vcgeq_f32(a.v, vdupq_n_f32(0.0f)) }; }
+inline M4 operator&(M4 a, M4 b) { return { vandq_u32(a.v, b.v) }; }
+inline F4 select4(M4 m, F4 a, F4 b) { return { vbslq_f32(m.v, a.v, b.v) }; }
+inline float hmax4(F4 a) { return vmaxvq_f32(a.v); }
+#else
+struct F4 { float v[4]; };
+struct M4 { bool v[4]; };
+inline F4 splat(float x) { return { { x, x, x, x } }; }
+inline F4 make4(float a, float b, float c, float d) { return { { a, b, c, d } }; }
+inline F4 load4(const float *p) { return { { p[0], p[1], p[2], p[3] } }; }
+inline void store4(float *p, F4 a) { memcpy(p, a.v, sizeof(float) * 4); }
+#define MGP_OCCLUSION_LANES(expr) for(int i = 0; i < 4; i++) r.v[i] = (expr); return r;
+inline F4 operator+(F4 a, F4 b) { F4 r; MGP_OCCLUSION_LANES(a.v[i] + b.v[i]) }
+inline F4 operator*(F4 a, F4 b) { F4 r; MGP_OCCLUSION_LANES(a.v[i] * b.v[i]) }
+inline F4 min4(F4 a, F4 b) { F4 r; MGP_OCCLUSION_LANES(std::min(a.v[i], b.v[i])) }
+inline F4 max4(F4 a, F4 b) { F4 r; MGP_OCCLUSION_LANES(std::max(a.v[i], b.v[i])) }
+inline M4 nonNegative(F4 a) { M4 r; MGP_OCCLUSION_LANES(a.v[i] >= 0.0f) }
+inline M4 operator&(M4 a, M4 b) { M4 r; MGP_OCCLUSION_LANES(a.v[i] && b.v[i]) }
+inline F4 select4(M4 m, F4 a, F4 b) { F4 r; MGP_OCCLUSION_LANES(m.v[i] ? a.v[i] : b.v[i]) }
+#undef MGP_OCCLUSION_LANES
+inline float hmax4(F4 a) { return std::max(std::max(a.v[0], a.v[1]), std::max(a.v[2], a.v[3])); }
+#endif
+
+struct ClipVertex {
+    float x, y, z, w;
+};
+
+// edge i : a[i] * x + b[i] * y + c[i] >= 0 inside, depth : z = zA * x + zB * y + zC
+struct ScreenTriangle {
+    float a[3], b[3], c[3];
+    float zA, zB, zC;
+    float minZ;
+    uint32_t minTileX, maxTileX, minTileY, maxTileY;
+};
+
+inline ClipVertex transformPoint(const float m[16], float x, float y, float z) {
+    return {
+        m[0] * x + m[4] * y + m[8] * z + m[12],
+        m[1] * x + m[5] * y + m[9] * z + m[13],
+        m[2] * x + m[6] * y + m[10] * z + m[14],
+        m[3] * x + m[7] * y + m[11] * z + m[15]
+    };
+}
+
+void multiplyMatrix(const float a[16], const float b[16], float out[16]) {
+    for(int col = 0; col < 4; col++) {
+        for(int row = 0; row < 4; row++) {
+            float sum = 0.0f;
+            for(int k = 0; k < 4; k++)
+                sum += a[k * 4 + row] * b[col * 4 + k];
+            out[col * 4 + row] = sum;
+        }
+    }
+}
+
+inline ClipVertex lerpVertex(const ClipVertex &a, const ClipVertex &b, float t) {
+    return { a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t, a.z + (b.z - a.z) * t, a.w + (b.w - a.w) * t };
+}
+
+} // namespace
+
+struct mgp_occlusion {
+    uint32_t width, height;
+    uint32_t tilesX, tilesY;
+    float *depth = nullptr;                 // tiles of 8x4 pixels, row-major in a tile
+
+    // max depth pyramid, level 0 : per tile
+    std::vector<std::vector<float>> pyramid;
+    std::vector<uint32_t> pyramidWidth, pyramidHeight;
+
+    float viewProjection[16];
+    size_t triangleBudget = kDefaultTriangleBudget;
+    std::vector<ClipVertex> clipVertices;
+    std::vector<uint32_t> triangles;
+    std::vector<std::vector<ScreenTriangle>> screenTriangles;  // per worker
+
+    mgp::WorkerPool pool;
+
+    mgp_occlusion(uint32_t numThreads) : pool(numThreads) {}
+
+    void setupTriangles(uint32_t worker);
+    void emitTriangle(const ClipVertex &v0, const ClipVertex &v1, const ClipVertex &v2,
+                      std::vector<ScreenTriangle> &out) const;
+    void rasterizeBand(uint32_t worker);
+    void buildPyramid();
+    bool isRegionVisible(uint32_t level, uint32_t texelX, uint32_t texelY,
+                         uint32_t minX, uint32_t maxX, uint32_t minY, uint32_t maxY, float minZ) const;
+    bool isAABBVisible(const float center[3], const float extent[3]) const;
+};
+
+void mgp_occlusion::setupTriangles(uint32_t worker) {
+    std::vector<ScreenTriangle> &out = screenTriangles[worker];
+    out.clear();
+
+    size_t numTriangles = triangles.size() / 3;
+    size_t first = numTriangles * worker / pool.numThreads();
+    size_t last = numTriangles * (worker + 1) / pool.numThreads();
+    for(size_t t = first; t < last; t++) {
+        const ClipVertex *v[3] = {
+            &clipVertices[triangles[t * 3]],
+            &clipVertices[triangles[t * 3 + 1]],
+            &clipVertices[triangles[t * 3 + 2]]
+        };
+
+        // outside of one of side planes
+        if((v[0]->x > v[0]->w && v[1]->x > v[1]->w && v[2]->x > v[2]->w) ||
+           (v[0]->x < -v[0]->w && v[1]->x < -v[1]->w && v[2]->x < -v[2]->w) ||
+           (v[0]->y > v[0]->w && v[1]->y > v[1]->w && v[2]->y > v[2]->w) ||
+           (v[0]->y < -v[0]->w && v[1]->y < -v[1]->w && v[2]->y < -v[2]->w) ||
+           (v[0]->z < 0.0f && v[1]->z < 0.0f && v[2]->z < 0.0f))
+            continue;
+
+        // clip by near plane (z >= 0)
+        ClipVertex polygon[4];
+        int numVertices = 0;
+        for(int i = 0; i < 3; i++) {
+            const ClipVertex &a = *v[i];
+            const ClipVertex &b = *v[(i + 1) % 3];
+            if(a.z >= 0.0f)
+                polygon[numVertices++] = a;
+            if((a.z >= 0.0f) != (b.z >= 0.0f))
+                polygon[numVertices++] = lerpVertex(a, b, a.z / (a.z - b.z));
+        }
+        for(int i = 1; i + 1 < numVertices; i++)
+            emitTriangle(polygon[0], polygon[i], polygon[i + 1], out);
+    }
+}
+
+void mgp_occlusion::emitTriangle(const ClipVertex &v0, const ClipVertex &v1, const ClipVertex &v2,
+                                 std::vector<ScreenTriangle> &out) const {
+    const ClipVertex *v[3] = { &v0, &v1, &v2 };
+    float sx[3], sy[3], sz[3];
+    for(int i = 0; i < 3; i++) {
+        if(v[i]->w <= 0.0f)
+            return;
+        float invW = 1.0f / v[i]->w;
+        sx[i] = (v[i]->x * invW * 0.5f + 0.5f) * width;
+        sy[i] = (0.5f - v[i]->y * invW * 0.5f) * height;
+        sz[i] = v[i]->z * invW;
+    }
+
+    float area = (sx[1] - sx[0]) * (sy[2] - sy[0]) - (sx[2] - sx[0]) * (sy[1] - sy[0]);
+    if(fabsf(area) < 1e-6f)
+        return;
+    if(area < 0.0f) {
+        // both windings are rasterized
+        std::swap(sx[1], sx[2]);
+        std::swap(sy[1], sy[2]);
+        std::swap(sz[1], sz[2]);
+        area = -area;
+    }
+
+    float minX = std::max(0.0f, std::min(sx[0], std::min(sx[1], sx[2])));
+    float maxX = std::min((float)width - 1.0f, std::max(sx[0], std::max(sx[1], sx[2])));
+    float minY = std::max(0.0f, std::min(sy[0], std::min(sy[1], sy[2])));
+    float maxY = std::min((float)height - 1.0f, std::max(sy[0], std::max(sy[1], sy[2])));
+    if(minX > maxX || minY > maxY)
+        return;
+
+    ScreenTriangle tri;
+    // edge i is opposite to vertex i
+    for(int i = 0; i < 3; i++) {
+        int j = (i + 1) % 3, k = (i + 2) % 3;
+        tri.a[i] = sy[j] - sy[k];
+        tri.b[i] = sx[k] - sx[j];
+        tri.c[i] = sx[j] * sy[k] - sy[j] * sx[k];
+    }
+    float invArea = 1.0f / area;
+    tri.zA = (tri.a[0] * sz[0] + tri.a[1] * sz[1] + tri.a[2] * sz[2]) * invArea;
+    tri.zB = (tri.b[0] * sz[0] + tri.b[1] * sz[1] + tri.b[2] * sz[2]) * invArea;
+    tri.zC = (tri.c[0] * sz[0] + tri.c[1] * sz[1] + tri.c[2] * sz[2]) * invArea;
+    tri.minZ = std::min(sz[0], std::min(sz[1], sz[2]));
+    tri.minTileX = (uint32_t)minX / kTileWidth;
+    tri.maxTileX = (uint32_t)maxX / kTileWidth;
+    tri.minTileY = (uint32_t)minY / kTileHeight;
+    tri.maxTileY = (uint32_t)maxY / kTileHeight;
+    out.push_back(tri);
+}
+
+// Each worker owns a band of tile rows, so no synchronization is needed.
+void mgp_occlusion::rasterizeBand(uint32_t worker) {
+    uint32_t firstRow = tilesY * worker / pool.numThreads();
+    uint32_t lastRow = tilesY * (worker + 1) / pool.numThreads();
+    if(firstRow >= lastRow)
+        return;
+
+    float *tileMax = pyramid[0].data();
+    for(const std::vector<ScreenTriangle> &list : screenTriangles) {
+        for(const ScreenTriangle &tri : list) {
+            uint32_t minTileY = std::max(tri.minTileY, firstRow);
+            uint32_t maxTileY = std::min(tri.maxTileY, lastRow - 1);
+            for(uint32_t ty = minTileY; ty <= maxTileY; ty++) {
+                for(uint32_t tx = tri.minTileX; tx <= tri.maxTileX; tx++) {
+                    uint32_t tileIndex = ty * tilesX + tx;
+                    // tile is already nearer than the whole triangle
+                    if(tri.minZ >= tileMax[tileIndex])
+                        continue;
+
+                    float *tile = depth + tileIndex * kTileSize;
+                    float x = (float)(tx * kTileWidth) + 0.5f;
+                    F4 x0 = make4(x, x + 1.0f, x + 2.0f, x + 3.0f);
+                    F4 x1 = x0 + splat(4.0f);
+                    F4 a0 = splat(tri.a[0]), a1 = splat(tri.a[1]), a2 = splat(tri.a[2]), zA = splat(tri.zA);
+                    F4 e0x0 = a0 * x0, e1x0 = a1 * x0, e2x0 = a2 * x0, zx0 = zA * x0;
+                    F4 e0x1 = a0 * x1, e1x1 = a1 * x1, e2x1 = a2 * x1, zx1 = zA * x1;
+                    F4 maxDepth = splat(0.0f);
+                    for(uint32_t row = 0; row < kTileHeight; row++) {
+                        float y = (float)(ty * kTileHeight + row) + 0.5f;
+                        F4 e0y = splat(tri.b[0] * y + tri.c[0]);
+                        F4 e1y = splat(tri.b[1] * y + tri.c[1]);
+                        F4 e2y = splat(tri.b[2] * y + tri.c[2]);
+                        F4 zy = splat(tri.zB * y + tri.zC);
+                        float *p = tile + row * kTileWidth;
+
+                        M4 inside0 = nonNegative(e0x0 + e0y) & nonNegative(e1x0 + e1y) & nonNegative(e2x0 + e2y);
+                        F4 d0 = load4(p);
+                        d0 = select4(inside0, min4(d0, zx0 + zy), d0);
+                        store4(p, d0);
+
+                        M4 inside1 = nonNegative(e0x1 + e0y) & nonNegative(e1x1 + e1y) & nonNegative(e2x1 + e2y);
+                        F4 d1 = load4(p + 4);
+                        d1 = select4(inside1, min4(d1, zx1 + zy), d1);
+                        store4(p + 4, d1);
+
+                        maxDepth = max4(maxDepth, max4(d0, d1));
+                    }
+                    tileMax[tileIndex] = hmax4(maxDepth);
+                }
+            }
+        }
+    }
+}
+
+void mgp_occlusion::buildPyramid() {
+    for(size_t level = 1; level < pyramid.size(); level++) {
+        const std::vector<float> &src = pyramid[level - 1];
+        std::vector<float> &dst = pyramid[level];
+        uint32_t srcWidth = pyramidWidth[level - 1], srcHeight = pyramidHeight[level - 1];
+        for(uint32_t y = 0; y < pyramidHeight[level]; y++) {
+            for(uint32_t x = 0; x < pyramidWidth[level]; x++) {
+                uint32_t x1 = std::min(x * 2 + 1, srcWidth - 1);
+                uint32_t y1 = std::min(y * 2 + 1, srcHeight - 1);
+                dst[y * pyramidWidth[level] + x] = std::max(std::max(src[y * 2 * srcWidth + x * 2], src[y * 2 * srcWidth + x1]),
+                                                            std::max(src[y1 * srcWidth + x * 2], src[y1 * srcWidth + x1]));
+            }
+        }
+    }
+}
+
+// Region is given in pixels. Descends only into texels that may contain something farther than minZ.
+bool mgp_occlusion::isRegionVisible(uint32_t level, uint32_t texelX, uint32_t texelY,
+                                    uint32_t minX, uint32_t maxX, uint32_t minY, uint32_t maxY, float minZ) const {
+    if(pyramid[level][texelY * pyramidWidth[level] + texelX] < minZ)
+        return false;
+
+    if(level == 0) {
+        // per pixel
+        const float *tile = depth + (texelY * tilesX + texelX) * kTileSize;
+        uint32_t x0 = std::max(minX, texelX * kTileWidth) - texelX * kTileWidth;
+        uint32_t x1 = std::min(maxX, texelX * kTileWidth + kTileWidth - 1) - texelX * kTileWidth;
+        uint32_t y0 = std::max(minY, texelY * kTileHeight) - texelY * kTileHeight;
+        uint32_t y1 = std::min(maxY, texelY * kTileHeight + kTileHeight - 1) - texelY * kTileHeight;
+        for(uint32_t y = y0; y <= y1; y++) {
+            for(uint32_t x = x0; x <= x1; x++) {
+                if(tile[y * kTileWidth + x] >= minZ)
+                    return true;
+            }
+        }
+        return false;
+    }
+
+    uint32_t childLevel = level - 1;
+    uint32_t tileShift = childLevel;
+    uint32_t minTileX = minX / kTileWidth, maxTileX = maxX / kTileWidth;
+    uint32_t minTileY = minY / kTileHeight, maxTileY = maxY / kTileHeight;
+    for(uint32_t y = texelY * 2; y <= std::min(texelY * 2 + 1, pyramidHeight[childLevel] - 1); y++) {
+        if(y < (minTileY >> tileShift) || y > (maxTileY >> tileShift))
+            continue;
+        for(uint32_t x = texelX * 2; x <= std::min(texelX * 2 + 1, pyramidWidth[childLevel] - 1); x++) {
+            if(x < (minTileX >> tileShift) || x > (maxTileX >> tileShift))
+                continue;
+            if(isRegionVisible(childLevel, x, y, minX, maxX, minY, maxY, minZ))
+                return true;
+        }
+    }
+    return false;
+}
+
+bool mgp_occlusion::isAABBVisible(const float center[3], const float extent[3]) const {
+    // corners are center +- each transformed axis
+    const float *m = viewProjection;
+    ClipVertex c = transformPoint(m, center[0], center[1], center[2]);
+    ClipVertex axes[3];
+    for(int i = 0; i < 3; i++) {
+        axes[i] = { m[i * 4] * extent[i], m[i * 4 + 1] * extent[i], m[i * 4 + 2] * extent[i], m[i * 4 + 3] * extent[i] };
+    }
+
+    float minX = FLT_MAX, maxX = -FLT_MAX, minY = FLT_MAX, maxY = -FLT_MAX, minZ = FLT_MAX;
+    for(int i = 0; i < 8; i++) {
+        float sx = (i & 1) ? 1.0f : -1.0f, sy = (i & 2) ? 1.0f : -1.0f, sz = (i & 4) ? 1.0f : -1.0f;
+        ClipVertex v = {
+            c.x + axes[0].x * sx + axes[1].x * sy + axes[2].x * sz,
+            c.y + axes[0].y * sx + axes[1].y * sy + axes[2].y * sz,
+            c.z + axes[0].z * sx + axes[1].z * sy + axes[2].z * sz,
+            c.w + axes[0].w * sx + axes[1].w * sy + axes[2].w * sz
+        };
+        // crosses the near plane
+        if(v.z < 0.0f || v.w <= 0.0f)
+            return true;
+        float invW = 1.0f / v.w;
+        float x = (v.x * invW * 0.5f + 0.5f) * width;
+        float y = (0.5f - v.y * invW * 0.5f) * height;
+        minX = std::min(minX, x);
+        maxX = std::max(maxX, x);
+        minY = std::min(minY, y);
+        maxY = std::max(maxY, y);
+        minZ = std::min(minZ, v.z * invW);
+    }
+
+    minX = std::max(minX, 0.0f);
+    minY = std::max(minY, 0.0f);
+    maxX = std::min(maxX, (float)width - 1.0f);
+    maxY = std::min(maxY, (float)height - 1.0f);
+    if(minX > maxX || minY > maxY)
+        return true;
+
+    uint32_t x0 = (uint32_t)minX, x1 = (uint32_t)maxX;
+    uint32_t y0 = (uint32_t)minY, y1 = (uint32_t)maxY;
+
+    // start from the level where the box covers at most 2x2 texels
+    uint32_t level = 0;
+    uint32_t tx0 = x0 / kTileWidth, tx1 = x1 / kTileWidth;
+    uint32_t ty0 = y0 / kTileHeight, ty1 = y1 / kTileHeight;
+    while(level + 1 < pyramid.size() &&
+          ((tx1 >> level) - (tx0 >> level) > 1 || (ty1 >> level) - (ty0 >> level) > 1))
+        level++;
+
+    for(uint32_t ty = ty0 >> level; ty <= ty1 >> level; ty++) {
+        for(uint32_t tx = tx0 >> level; tx <= tx1 >> level; tx++) {
+            if(isRegionVisible(level, tx, ty, x0, x1, y0, y1, minZ))
+                return true;
+        }
+    }
+    return false;
+}
+
+mgp_occlusion_t *mgp_occlusion_create(uint32_t width, uint32_t height, uint32_t numThreads) {
+    mgp_occlusion_t *occlusion = new mgp_occlusion(numThreads);
+    occlusion->tilesX = std::max(1u, (width + kTileWidth - 1) / kTileWidth);
+    occlusion->tilesY = std::max(1u, (height + kTileHeight - 1) / kTileHeight);
+    occlusion->width = occlusion->tilesX * kTileWidth;
+    occlusion->height = occlusion->tilesY * kTileHeight;
+
+    void *block = nullptr;
+    if(posix_memalign(&block, 32, sizeof(float) * occlusion->width * occlusion->height) != 0) {
+        delete occlusion;
+        return nullptr;
+    }
+    occlusion->depth = (float *)block;
+
+    uint32_t levelWidth = occlusion->tilesX, levelHeight = occlusion->tilesY;
+    while(true) {
+        occlusion->pyramid.emplace_back(levelWidth * levelHeight, 1.0f);
+        occlusion->pyramidWidth.push_back(levelWidth);
+        occlusion->pyramidHeight.push_back(levelHeight);
+        if(levelWidth == 1 && levelHeight == 1)
+            break;
+        levelWidth = (levelWidth + 1) / 2;
+        levelHeight = (levelHeight + 1) / 2;
+    }
+    occlusion->screenTriangles.resize(occlusion->pool.numThreads());
+
+    float identity[16] = { 1,0,0,0, 0,1,0,0, 0,0,1,0, 0,0,0,1 };
+    mgp_occlusion_begin(occlusion, identity);
+    return occlusion;
+}
+
+void mgp_occlusion_destroy(mgp_occlusion_t *occlusion) {
+    if(occlusion == nullptr)
+        return;
+    free(occlusion->depth);
+    delete occlusion;
+}
+
+void mgp_occlusion_set_triangle_budget(mgp_occlusion_t *occlusion, size_t numTriangles) {
+    occlusion->triangleBudget = numTriangles;
+}
+
+void mgp_occlusion_begin(mgp_occlusion_t *occlusion, const float viewProjection[16]) {
+    memcpy(occlusion->viewProjection, viewProjection, sizeof(float) * 16);
+    std::fill(occlusion->depth, occlusion->depth + occlusion->width * occlusion->height, 1.0f);
+    for(std::vector<float> &level : occlusion->pyramid)
+        std::fill(level.begin(), level.end(), 1.0f);
+    occlusion->clipVertices.clear();
+    occlusion->triangles.clear();
+}
+
+int mgp_occlusion_add_occluder(mgp_occlusion_t *occlusion,
+                               const float *vertices,
+                               const uint32_t *indices, size_t numTriangles,
+                               const float model[16]) {
+    if(occlusion->triangles.size() / 3 + numTriangles > occlusion->triangleBudget)
+        return 0;
+
+    // vertices referenced by this occluder
+    uint32_t numVertices = 0;
+    for(size_t i = 0; i < numTriangles * 3; i++)
+        numVertices = std::max(numVertices, indices[i] + 1);
+
+    float matrix[16];
+    multiplyMatrix(occlusion->viewProjection, model, matrix);
+
+    uint32_t baseVertex = (uint32_t)occlusion->clipVertices.size();
+    occlusion->clipVertices.reserve(baseVertex + numVertices);
+    for(uint32_t i = 0; i < numVertices; i++) {
+        const float *p = vertices + i * 3;
+        occlusion->clipVertices.push_back(transformPoint(matrix, p[0], p[1], p[2]));
+    }
+    occlusion->triangles.reserve(occlusion->triangles.size() + numTriangles * 3);
+    for(size_t i = 0; i < numTriangles * 3; i++)
+        occlusion->triangles.push_back(baseVertex + indices[i]);
+    return 1;
+}
+
+void mgp_occlusion_rasterize(mgp_occlusion_t *occlusion) {
+    occlusion->pool.run([occlusion](uint32_t worker) {
+        occlusion->setupTriangles(worker);
+    });
+    occlusion->pool.run([occlusion](uint32_t worker) {
+        occlusion->rasterizeBand(worker);
+    });
+    occlusion->buildPyramid();
+}
+
+size_t mgp_occlusion_cull_aabbs(const mgp_occlusion_t *occlusion,
+                                const mgp_aabb_array_t *aabbs,
+                                uint64_t *visibility) {
+    size_t numVisible = 0;
+    for(size_t word = 0, numWords = MGP_CULL_BITSET_WORDS(aabbs->count); word < numWords; word++) {
+        uint64_t bits = visibility[word];
+        while(bits) {
+            size_t i = (word << 6) + __builtin_ctzll(bits);
+            bits &= bits - 1;
+
+            float center[3] = { aabbs->center_x[i], aabbs->center_y[i], aabbs->center_z[i] };
+            float extent[3] = { aabbs->extent_x[i], aabbs->extent_y[i], aabbs->extent_z[i] };
+            if(occlusion->isAABBVisible(center, extent))
+                numVisible++;
+            else
+                visibility[word] &= ~(1ull << (i & 63));
+        }
+    }
+    return numVisible;
+}
+
+int mgp_occlusion_aabb_is_visible(const mgp_occlusion_t *occlusion,
+                                  const float center[3], const float extent[3]) {
+    return occlusion->isAABBVisible(center, extent);
+}
+
+void mgp_occlusion_read_depth(const mgp_occlusion_t *occlusion, float *depth,
+                              uint32_t *width, uint32_t *height) {
+    if(width)
+        *width = occlusion->width;
+    if(height)
+        *height = occlusion->height;
+    if(depth == nullptr)
+        return;
+
+    for(uint32_t y = 0; y < occlusion->height; y++) {
+        for(uint32_t x = 0; x < occlusion->width; x++) {
+            uint32_t tile = (y / kTileHeight) * occlusion->tilesX + x / kTileWidth;
+            depth[y * occlusion->width + x] = occlusion->depth[tile * kTileSize + (y % kTileHeight) * kTileWidth + x % kTileWidth];
+        }
+    }
+}
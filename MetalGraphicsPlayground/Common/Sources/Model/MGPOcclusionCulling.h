@@ -0,0 +1,66 @@
+//
+//  MGPOcclusionCulling.h
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/17.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#ifndef MGPOcclusionCulling_h
+#define MGPOcclusionCulling_h
+
+#include "MGPCulling.h"
+
+// Software occlusion culling.
+// Occluder triangles are rasterized on worker threads into a low-resolution
+// depth buffer made of 8x4 pixel tiles (SIMD, one row of a tile per two float4),
+// then a max-depth pyramid over the tiles is used to test screen-space boxes.
+// Depth follows Metal clip space. (0 <= z <= w, smaller is nearer)
+
+#define MGP_OCCLUSION_TILE_WIDTH 8
+#define MGP_OCCLUSION_TILE_HEIGHT 4
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct mgp_occlusion mgp_occlusion_t;
+
+// width and height are rounded up to the tile size
+mgp_occlusion_t *mgp_occlusion_create(uint32_t width, uint32_t height, uint32_t numThreads);
+void mgp_occlusion_destroy(mgp_occlusion_t *occlusion);
+
+// maximum number of occluder triangles per frame (default : 65536)
+void mgp_occlusion_set_triangle_budget(mgp_occlusion_t *occlusion, size_t numTriangles);
+
+// Clears the depth buffer and occluders.
+// viewProjection : column-major 4x4 matrix
+void mgp_occlusion_begin(mgp_occlusion_t *occlusion, const float viewProjection[16]);
+
+// Queues an occluder. (vertices : packed xyz, indices : triangle list)
+// Returns 0 without queueing anything if it doesn't fit in the remaining budget.
+int mgp_occlusion_add_occluder(mgp_occlusion_t *occlusion,
+                               const float *vertices,
+                               const uint32_t *indices, size_t numTriangles,
+                               const float model[16]);
+
+// Rasterizes queued occluders and builds the depth pyramid.
+void mgp_occlusion_rasterize(mgp_occlusion_t *occlusion);
+
+// Clears the bits of boxes hidden behind occluders. Only boxes whose bit is
+// set are tested. Returns the number of boxes still visible.
+size_t mgp_occlusion_cull_aabbs(const mgp_occlusion_t *occlusion,
+                                const mgp_aabb_array_t *aabbs,
+                                uint64_t *visibility);
+int mgp_occlusion_aabb_is_visible(const mgp_occlusion_t *occlusion,
+                                  const float center[3], const float extent[3]);
+
+// Copies the depth buffer in row-major order. (width * height floats)
+void mgp_occlusion_read_depth(const mgp_occlusion_t *occlusion, float *depth,
+                              uint32_t *width, uint32_t *height);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MGPOcclusionCulling_h */
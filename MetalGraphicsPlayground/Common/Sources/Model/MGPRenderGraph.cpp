@@ -0,0 +1,252 @@
+//
+//  MGPRenderGraph.cpp
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/17.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#include "MGPRenderGraph.h"
+
+#include <algorithm>
+#include <vector>
+
+struct mgp_render_graph {
+    struct Attachment {
+        uint32_t resource;
+        bool load;
+    };
+    struct Pass {
+        mgp_render_graph_pass_type_t type;
+        uint32_t flags;
+        std::vector<uint32_t> reads;            // including loaded attachments
+        std::vector<uint32_t> sampled;          // read without being attached
+        std::vector<uint32_t> writes;           // including attachments
+        std::vector<Attachment> attachments;
+        bool culled;
+    };
+
+    std::vector<Pass> passes;
+    size_t numPasses;               // passes in use, the rest are kept for their memory
+    std::vector<uint32_t> resourceFlags;
+    std::vector<mgp_render_graph_step_t> steps;
+
+    // compile
+    std::vector<char> needed;
+    std::vector<uint32_t> lastWriters;
+    std::vector<std::vector<uint32_t>> readers;
+    std::vector<std::vector<uint32_t>> successors;
+    std::vector<uint32_t> numPredecessors;
+    std::vector<uint32_t> ready;
+};
+
+mgp_render_graph_t *mgp_render_graph_create(void) {
+    mgp_render_graph_t *graph = new mgp_render_graph_t();
+    graph->numPasses = 0;
+    return graph;
+}
+
+void mgp_render_graph_destroy(mgp_render_graph_t *graph) {
+    delete graph;
+}
+
+void mgp_render_graph_reset(mgp_render_graph_t *graph) {
+    graph->numPasses = 0;
+    graph->resourceFlags.clear();
+    graph->steps.clear();
+}
+
+uint32_t mgp_render_graph_add_resource(mgp_render_graph_t *graph, uint32_t flags) {
+    graph->resourceFlags.push_back(flags);
+    return (uint32_t)graph->resourceFlags.size() - 1;
+}
+
+uint32_t mgp_render_graph_add_pass(mgp_render_graph_t *graph, mgp_render_graph_pass_type_t type, uint32_t flags) {
+    if(graph->numPasses == graph->passes.size())
+        graph->passes.emplace_back();
+    auto &pass = graph->passes[graph->numPasses];
+    pass.type = type;
+    pass.flags = flags;
+    pass.reads.clear();
+    pass.sampled.clear();
+    pass.writes.clear();
+    pass.attachments.clear();
+    pass.culled = false;
+    return (uint32_t)graph->numPasses++;
+}
+
+void mgp_render_graph_pass_read(mgp_render_graph_t *graph, uint32_t pass, uint32_t resource) {
+    graph->passes[pass].reads.push_back(resource);
+    graph->passes[pass].sampled.push_back(resource);
+}
+
+void mgp_render_graph_pass_write(mgp_render_graph_t *graph, uint32_t pass, uint32_t resource) {
+    graph->passes[pass].writes.push_back(resource);
+}
+
+void mgp_render_graph_pass_attach(mgp_render_graph_t *graph, uint32_t pass, uint32_t resource, int load) {
+    auto &p = graph->passes[pass];
+    p.attachments.push_back({ resource, load != 0 });
+    p.writes.push_back(resource);
+    if(load)
+        p.reads.push_back(resource);
+}
+
+static bool contains(const std::vector<uint32_t> &values, uint32_t value) {
+    return std::find(values.begin(), values.end(), value) != values.end();
+}
+
+// Walks passes backwards, a pass is needed if it writes what a later needed pass reads.
+static void cull_passes(mgp_render_graph_t *graph) {
+    auto &needed = graph->needed;
+    needed.assign(graph->resourceFlags.size(), 0);
+    for(size_t i = 0; i < needed.size(); i++)
+        needed[i] = (graph->resourceFlags[i] & MGP_RENDER_GRAPH_RESOURCE_IMPORTED) != 0;
+
+    for(size_t i = graph->numPasses; i-- > 0;) {
+        auto &pass = graph->passes[i];
+        bool live = (pass.flags & MGP_RENDER_GRAPH_PASS_SIDE_EFFECT) != 0;
+        for(uint32_t resource : pass.writes)
+            live = live || needed[resource];
+        pass.culled = !live;
+        if(!live)
+            continue;
+
+        // contents before this pass are overwritten, unless read below
+        for(uint32_t resource : pass.writes) {
+            if(!(graph->resourceFlags[resource] & MGP_RENDER_GRAPH_RESOURCE_IMPORTED))
+                needed[resource] = 0;
+        }
+        for(uint32_t resource : pass.reads)
+            needed[resource] = 1;
+    }
+}
+
+static void add_dependency(mgp_render_graph_t *graph, uint32_t from, uint32_t to) {
+    if(from == MGP_RENDER_GRAPH_NONE || from == to)
+        return;
+    graph->successors[from].push_back(to);
+    graph->numPredecessors[to]++;
+}
+
+// Read-after-write, write-after-read and write-after-write hazards between live passes.
+static void build_dependencies(mgp_render_graph_t *graph) {
+    const size_t numPasses = graph->numPasses;
+    const size_t numResources = graph->resourceFlags.size();
+    graph->successors.resize(std::max(graph->successors.size(), numPasses));
+    for(size_t i = 0; i < numPasses; i++)
+        graph->successors[i].clear();
+    graph->numPredecessors.assign(numPasses, 0);
+    graph->lastWriters.assign(numResources, MGP_RENDER_GRAPH_NONE);
+    graph->readers.resize(std::max(graph->readers.size(), numResources));
+    for(size_t i = 0; i < numResources; i++)
+        graph->readers[i].clear();
+
+    uint32_t barrier = MGP_RENDER_GRAPH_NONE;
+    std::vector<uint32_t> sinceBarrier;
+    for(uint32_t i = 0; i < numPasses; i++) {
+        const auto &pass = graph->passes[i];
+        if(pass.culled)
+            continue;
+
+        // external passes may touch anything, keep them in place
+        add_dependency(graph, barrier, i);
+        if(pass.type == MGP_RENDER_GRAPH_PASS_EXTERNAL) {
+            for(uint32_t previous : sinceBarrier)
+                add_dependency(graph, previous, i);
+            sinceBarrier.clear();
+            barrier = i;
+        }
+        else {
+            sinceBarrier.push_back(i);
+        }
+
+        for(uint32_t resource : pass.reads)
+            add_dependency(graph, graph->lastWriters[resource], i);
+        for(uint32_t resource : pass.writes) {
+            add_dependency(graph, graph->lastWriters[resource], i);
+            for(uint32_t reader : graph->readers[resource])
+                add_dependency(graph, reader, i);
+            graph->lastWriters[resource] = i;
+            graph->readers[resource].clear();
+        }
+        for(uint32_t resource : pass.reads) {
+            if(graph->lastWriters[resource] != i)
+                graph->readers[resource].push_back(i);
+        }
+    }
+}
+
+// pass can continue the render encoder begun by first
+static bool can_merge(const mgp_render_graph_t *graph, uint32_t first, uint32_t pass) {
+    const auto &a = graph->passes[first];
+    const auto &b = graph->passes[pass];
+    if(a.type != MGP_RENDER_GRAPH_PASS_RENDER || b.type != MGP_RENDER_GRAPH_PASS_RENDER)
+        return false;
+    if(a.attachments.size() != b.attachments.size() || b.attachments.empty())
+        return false;
+    for(size_t i = 0; i < b.attachments.size(); i++) {
+        if(a.attachments[i].resource != b.attachments[i].resource || !b.attachments[i].load)
+            return false;
+    }
+    // attachments can't be sampled in the same encoder
+    for(const auto &attachment : a.attachments) {
+        if(contains(b.sampled, attachment.resource))
+            return false;
+    }
+    return true;
+}
+
+size_t mgp_render_graph_compile(mgp_render_graph_t *graph) {
+    graph->steps.clear();
+    cull_passes(graph);
+    build_dependencies(graph);
+
+    auto &ready = graph->ready;
+    ready.clear();
+    for(uint32_t i = 0; i < graph->numPasses; i++) {
+        if(!graph->passes[i].culled && graph->numPredecessors[i] == 0)
+            ready.push_back(i);
+    }
+
+    uint32_t encoder = 0;
+    uint32_t encoderFirstPass = MGP_RENDER_GRAPH_NONE;
+    while(!ready.empty()) {
+        // declaration order, but passes sharing the current encoder go first
+        size_t pick = 0;
+        bool merged = false;
+        for(size_t i = 0; i < ready.size(); i++) {
+            bool mergeable = encoderFirstPass != MGP_RENDER_GRAPH_NONE &&
+                             can_merge(graph, encoderFirstPass, ready[i]);
+            if(i == 0 || (mergeable && !merged) || (mergeable == merged && ready[i] < ready[pick])) {
+                pick = i;
+                merged = mergeable;
+            }
+        }
+
+        uint32_t pass = ready[pick];
+        ready[pick] = ready.back();
+        ready.pop_back();
+
+        if(!merged) {
+            if(!graph->steps.empty())
+                encoder++;
+            encoderFirstPass = graph->passes[pass].type == MGP_RENDER_GRAPH_PASS_RENDER ? pass : MGP_RENDER_GRAPH_NONE;
+        }
+        graph->steps.push_back({ pass, encoder });
+
+        for(uint32_t successor : graph->successors[pass]) {
+            if(--graph->numPredecessors[successor] == 0)
+                ready.push_back(successor);
+        }
+    }
+    return graph->steps.size();
+}
+
+const mgp_render_graph_step_t *mgp_render_graph_steps(const mgp_render_graph_t *graph) {
+    return graph->steps.data();
+}
+
+int mgp_render_graph_is_pass_culled(const mgp_render_graph_t *graph, uint32_t pass) {
+    return graph->passes[pass].culled ? 1 : 0;
+}
@@ -0,0 +1,74 @@
+//
+//  MGPRenderGraph.h
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/17.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#ifndef MGPRenderGraph_h
+#define MGPRenderGraph_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Render graph of a frame.
+// Passes are added in a valid execution order and declare the resources they
+// read and write. Compiling the graph
+//  - culls passes whose results are never used,
+//  - orders the remaining ones, keeping dependencies and bringing mergeable
+//    render passes next to each other,
+//  - merges consecutive render passes with the same attachments into one encoder.
+// The graph only knows ids, encoding is up to the caller.
+
+#define MGP_RENDER_GRAPH_NONE UINT32_MAX
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    MGP_RENDER_GRAPH_PASS_RENDER,       // encodes into a render encoder made from its attachments
+    MGP_RENDER_GRAPH_PASS_COMPUTE,      // encodes into a compute encoder
+    MGP_RENDER_GRAPH_PASS_EXTERNAL      // makes its own encoders, passes are never moved across it
+} mgp_render_graph_pass_type_t;
+
+// pass flags
+#define MGP_RENDER_GRAPH_PASS_SIDE_EFFECT 0x1   // never culled
+
+// resource flags
+#define MGP_RENDER_GRAPH_RESOURCE_IMPORTED 0x1  // outlives the graph, passes writing it are never culled
+
+typedef struct {
+    uint32_t pass;
+    uint32_t encoder;       // steps with the same encoder index share an encoder
+} mgp_render_graph_step_t;
+
+typedef struct mgp_render_graph mgp_render_graph_t;
+
+mgp_render_graph_t *mgp_render_graph_create(void);
+void mgp_render_graph_destroy(mgp_render_graph_t *graph);
+
+// Removes all passes and resources, keeping memory for the next frame.
+void mgp_render_graph_reset(mgp_render_graph_t *graph);
+
+uint32_t mgp_render_graph_add_resource(mgp_render_graph_t *graph, uint32_t flags);
+uint32_t mgp_render_graph_add_pass(mgp_render_graph_t *graph, mgp_render_graph_pass_type_t type, uint32_t flags);
+
+// Resource sampled or read as a buffer.
+void mgp_render_graph_pass_read(mgp_render_graph_t *graph, uint32_t pass, uint32_t resource);
+// Resource written completely.
+void mgp_render_graph_pass_write(mgp_render_graph_t *graph, uint32_t pass, uint32_t resource);
+// Attachment of a render pass. load : previous contents are kept (read and written), otherwise cleared.
+void mgp_render_graph_pass_attach(mgp_render_graph_t *graph, uint32_t pass, uint32_t resource, int load);
+
+// Returns the number of steps, valid until the graph is changed.
+size_t mgp_render_graph_compile(mgp_render_graph_t *graph);
+const mgp_render_graph_step_t *mgp_render_graph_steps(const mgp_render_graph_t *graph);
+int mgp_render_graph_is_pass_culled(const mgp_render_graph_t *graph, uint32_t pass);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MGPRenderGraph_h */
@@ -0,0 +1,181 @@
+//
+//  MGPRingAllocator.cpp
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/17.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#include "MGPRingAllocator.h"
+
+#include <deque>
+#include <vector>
+
+// buffer sizes are kept as multiples of this, so aligned positions stay aligned after wrapping
+static const size_t kCapacityGranularity = 256;
+
+struct mgp_ring_allocator {
+    struct Frame {
+        size_t end;
+        uint32_t generation;
+    };
+    struct RetiredBuffer {
+        void *buffer;
+        uint64_t retireFrame;
+    };
+
+    mgp_ring_backend_t backend;
+    uint32_t numFramesInFlight;
+    uint64_t frameIndex;
+
+    void *buffer;
+    uint8_t *contents;
+    size_t capacity;
+    uint32_t generation;
+
+    // positions grow monotonically, offset in the buffer is position % capacity
+    size_t head;
+    size_t tail;
+    std::deque<Frame> frames;   // previous frames which may be in flight
+    std::vector<RetiredBuffer> retiredBuffers;
+
+    size_t frameBytes;
+    size_t highWaterMark;
+    uint32_t numGrowths;
+};
+
+static size_t round_up(size_t value, size_t multiple) {
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+mgp_ring_allocator_t *mgp_ring_allocator_create(const mgp_ring_backend_t *backend,
+                                                size_t initialCapacity,
+                                                uint32_t numFramesInFlight) {
+    if(backend == NULL || backend->create_buffer == NULL || backend->destroy_buffer == NULL)
+        return NULL;
+
+    size_t capacity = round_up(initialCapacity > 0 ? initialCapacity : kCapacityGranularity,
+                               kCapacityGranularity);
+    void *contents = NULL;
+    void *buffer = backend->create_buffer(backend->context, capacity, &contents);
+    if(buffer == NULL)
+        return NULL;
+
+    mgp_ring_allocator_t *allocator = new mgp_ring_allocator_t();
+    allocator->backend = *backend;
+    allocator->numFramesInFlight = numFramesInFlight > 0 ? numFramesInFlight : 1;
+    allocator->frameIndex = 0;
+    allocator->buffer = buffer;
+    allocator->contents = (uint8_t *)contents;
+    allocator->capacity = capacity;
+    allocator->generation = 0;
+    allocator->head = 0;
+    allocator->tail = 0;
+    allocator->frameBytes = 0;
+    allocator->highWaterMark = 0;
+    allocator->numGrowths = 0;
+    return allocator;
+}
+
+void mgp_ring_allocator_destroy(mgp_ring_allocator_t *allocator) {
+    if(allocator == NULL)
+        return;
+    const mgp_ring_backend_t &backend = allocator->backend;
+    for(const auto &retired : allocator->retiredBuffers)
+        backend.destroy_buffer(backend.context, retired.buffer);
+    backend.destroy_buffer(backend.context, allocator->buffer);
+    delete allocator;
+}
+
+void mgp_ring_allocator_begin_frame(mgp_ring_allocator_t *allocator) {
+    allocator->frames.push_back({ allocator->head, allocator->generation });
+    allocator->frameIndex++;
+
+    // frame (frameIndex - numFramesInFlight) is finished, its memory can be reused
+    while(allocator->frames.size() >= allocator->numFramesInFlight) {
+        const auto &frame = allocator->frames.front();
+        if(frame.generation == allocator->generation)
+            allocator->tail = frame.end;
+        allocator->frames.pop_front();
+    }
+
+    auto &retiredBuffers = allocator->retiredBuffers;
+    for(size_t i = 0; i < retiredBuffers.size();) {
+        if(retiredBuffers[i].retireFrame <= allocator->frameIndex) {
+            allocator->backend.destroy_buffer(allocator->backend.context, retiredBuffers[i].buffer);
+            retiredBuffers[i] = retiredBuffers.back();
+            retiredBuffers.pop_back();
+        }
+        else {
+            i++;
+        }
+    }
+
+    allocator->frameBytes = 0;
+}
+
+static int mgp_ring_allocator_grow(mgp_ring_allocator_t *allocator, size_t size, size_t alignment) {
+    // the current frame keeps its allocations in the old buffer,
+    // and the new one must hold at least what this frame used so far.
+    size_t required = allocator->frameBytes + size + alignment;
+    size_t capacity = allocator->capacity * 2;
+    while(capacity < required)
+        capacity *= 2;
+    capacity = round_up(capacity, kCapacityGranularity);
+
+    void *contents = NULL;
+    void *buffer = allocator->backend.create_buffer(allocator->backend.context, capacity, &contents);
+    if(buffer == NULL)
+        return 0;
+
+    allocator->retiredBuffers.push_back({ allocator->buffer,
+        allocator->frameIndex + allocator->numFramesInFlight });
+    allocator->buffer = buffer;
+    allocator->contents = (uint8_t *)contents;
+    allocator->capacity = capacity;
+    allocator->generation++;
+    allocator->head = 0;
+    allocator->tail = 0;
+    allocator->numGrowths++;
+    return 1;
+}
+
+int mgp_ring_allocator_allocate(mgp_ring_allocator_t *allocator, size_t size, size_t alignment,
+                                mgp_ring_allocation_t *allocation) {
+    if(alignment == 0)
+        alignment = 1;
+
+    for(;;) {
+        size_t position = round_up(allocator->head, alignment);
+        size_t offset = position % allocator->capacity;
+        if(offset + size > allocator->capacity) {
+            // doesn't fit before the end, skip to the start of the buffer
+            position += allocator->capacity - offset;
+            offset = 0;
+        }
+
+        if(position + size - allocator->tail <= allocator->capacity) {
+            allocator->frameBytes += position + size - allocator->head;
+            if(allocator->frameBytes > allocator->highWaterMark)
+                allocator->highWaterMark = allocator->frameBytes;
+            allocator->head = position + size;
+
+            allocation->buffer = allocator->buffer;
+            allocation->contents = allocator->contents + offset;
+            allocation->offset = offset;
+            return 1;
+        }
+
+        if(!mgp_ring_allocator_grow(allocator, size, alignment))
+            return 0;
+    }
+}
+
+void mgp_ring_allocator_get_stats(const mgp_ring_allocator_t *allocator, mgp_ring_stats_t *stats) {
+    stats->capacity = allocator->capacity;
+    stats->frameBytes = allocator->frameBytes;
+    stats->highWaterMark = allocator->highWaterMark;
+    stats->inFlightBytes = allocator->head - allocator->tail;
+    stats->numBuffers = (uint32_t)allocator->retiredBuffers.size() + 1;
+    stats->numGrowths = allocator->numGrowths;
+}
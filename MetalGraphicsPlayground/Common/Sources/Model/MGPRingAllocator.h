@@ -0,0 +1,70 @@
+//
+//  MGPRingAllocator.h
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/17.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#ifndef MGPRingAllocator_h
+#define MGPRingAllocator_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Frame-fenced ring allocator.
+// Suballocates linearly from one large buffer. Memory of a frame is reused
+// once numFramesInFlight newer frames have begun, so the caller must make
+// sure that frame is finished on the GPU by then (e.g. with a semaphore).
+// If a frame doesn't fit, a new buffer twice as large is made and the old
+// one is destroyed after the frames using it retire.
+// Buffers come from a backend, so the logic runs without a GPU.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    // Returns an opaque buffer of size bytes and its CPU-visible contents, or NULL.
+    void *(*create_buffer)(void *context, size_t size, void **contents);
+    void (*destroy_buffer)(void *context, void *buffer);
+    void *context;
+} mgp_ring_backend_t;
+
+typedef struct {
+    void *buffer;
+    void *contents;     // start of the allocation
+    size_t offset;      // from the start of the buffer
+} mgp_ring_allocation_t;
+
+typedef struct {
+    size_t capacity;            // size of the current buffer
+    size_t frameBytes;          // used by the current frame, including alignment and wrap padding
+    size_t highWaterMark;       // largest frameBytes so far
+    size_t inFlightBytes;       // used in the current buffer by frames not retired yet
+    uint32_t numBuffers;        // current buffer and the ones waiting for retirement
+    uint32_t numGrowths;
+} mgp_ring_stats_t;
+
+typedef struct mgp_ring_allocator mgp_ring_allocator_t;
+
+// alignment of every allocation is a divisor of the buffer sizes (a power of two up to 256 is safe)
+mgp_ring_allocator_t *mgp_ring_allocator_create(const mgp_ring_backend_t *backend,
+                                                size_t initialCapacity,
+                                                uint32_t numFramesInFlight);
+void mgp_ring_allocator_destroy(mgp_ring_allocator_t *allocator);
+
+// Starts a new frame, retiring the one that began numFramesInFlight frames ago.
+void mgp_ring_allocator_begin_frame(mgp_ring_allocator_t *allocator);
+
+// alignment : power of two. Returns 0 if the backend fails to make a buffer.
+int mgp_ring_allocator_allocate(mgp_ring_allocator_t *allocator, size_t size, size_t alignment,
+                                mgp_ring_allocation_t *allocation);
+
+void mgp_ring_allocator_get_stats(const mgp_ring_allocator_t *allocator, mgp_ring_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MGPRingAllocator_h */
@@ -15,6 +15,9 @@ NS_ASSUME_NONNULL_BEGIN
 @class MGPRenderer;
 @class MGPSceneNode;
 @class MGPImageBasedLighting;
+@class MGPCameraComponent;
+@class MGPLightComponent;
+@class MGPMeshComponent;
 @interface MGPScene : NSObject
 
 // Global Illumination
@@ -26,6 +29,11 @@ NS_ASSUME_NONNULL_BEGIN
 // Root scene node
 @property (nonatomic, readonly) MGPSceneNode *rootNode;
 
+// Enabled components under the root node, kept up to date as nodes and components change.
+@property (nonatomic, readonly) NSArray<MGPCameraComponent*> *cameraComponents;
+@property (nonatomic, readonly) NSArray<MGPLightComponent*> *lightComponents;   // sorted by light type
+@property (nonatomic, readonly) NSArray<MGPMeshComponent*> *meshComponents;
+
 // Renderer
 @property (nonatomic, weak) MGPRenderer *renderer;
 
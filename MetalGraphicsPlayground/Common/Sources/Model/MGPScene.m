@@ -8,6 +8,10 @@
 
 #import "MGPScene.h"
 #import "MGPSceneNode.h"
+#import "MGPSceneNodeComponent.h"
+#import "MGPCameraComponent.h"
+#import "MGPLightComponent.h"
+#import "MGPMeshComponent.h"
 #import "../Utility/MetalMath.h"
 #import <simd/simd.h>
 
@@ -15,11 +19,23 @@
 - (void)setScene:(MGPScene * _Nullable)scene;
 @end
 
-@implementation MGPScene
+@interface MGPSceneNodeComponent (Private)
+@property (nonatomic) NSUInteger sceneIndex;
+@end
+
+@implementation MGPScene {
+    NSMutableArray<MGPCameraComponent*> *_cameraComponents;
+    NSMutableArray<MGPLightComponent*> *_lightComponents;
+    NSMutableArray<MGPMeshComponent*> *_meshComponents;
+    BOOL _lightComponentsNeedSort;
+}
 
 - (instancetype)init {
     self = [super init];
     if(self) {
+        _cameraComponents = [NSMutableArray new];
+        _lightComponents = [NSMutableArray new];
+        _meshComponents = [NSMutableArray new];
         [self _makeDefaultProperties];
     }
     return self;
@@ -33,4 +49,56 @@
     [_rootNode setScene:self];
 }
 
+#pragma mark - Component registries
+- (NSArray<MGPLightComponent *> *)lightComponents {
+    if(_lightComponentsNeedSort) {
+        [_lightComponents sortWithOptions:NSSortStable
+                          usingComparator:^NSComparisonResult(MGPLightComponent * _Nonnull obj1, MGPLightComponent * _Nonnull obj2) {
+            if(obj1.type < obj2.type)
+                return NSOrderedAscending;
+            else if(obj1.type > obj2.type)
+                return NSOrderedDescending;
+            return NSOrderedSame;
+        }];
+        _lightComponentsNeedSort = NO;
+    }
+    return _lightComponents;
+}
+
+// called by nodes and components when a component becomes active or inactive in this scene
+- (void)registerComponent:(MGPSceneNodeComponent *)component {
+    if([component isKindOfClass:MGPCameraComponent.class]) {
+        [_cameraComponents addObject:(MGPCameraComponent *)component];
+    }
+    else if([component isKindOfClass:MGPLightComponent.class]) {
+        [_lightComponents addObject:(MGPLightComponent *)component];
+        _lightComponentsNeedSort = YES;
+    }
+    else if([component isKindOfClass:MGPMeshComponent.class]) {
+        component.sceneIndex = _meshComponents.count;
+        [_meshComponents addObject:(MGPMeshComponent *)component];
+    }
+}
+
+- (void)unregisterComponent:(MGPSceneNodeComponent *)component {
+    if([component isKindOfClass:MGPCameraComponent.class]) {
+        [_cameraComponents removeObjectIdenticalTo:(MGPCameraComponent *)component];
+    }
+    else if([component isKindOfClass:MGPLightComponent.class]) {
+        [_lightComponents removeObjectIdenticalTo:(MGPLightComponent *)component];
+    }
+    else if([component isKindOfClass:MGPMeshComponent.class]) {
+        // swap with the last one
+        NSUInteger index = component.sceneIndex;
+        MGPMeshComponent *last = _meshComponents.lastObject;
+        last.sceneIndex = index;
+        _meshComponents[index] = last;
+        [_meshComponents removeLastObject];
+    }
+}
+
+- (void)lightComponentDidChangeType:(MGPLightComponent *)component {
+    _lightComponentsNeedSort = YES;
+}
+
 @end
@@ -13,6 +13,9 @@ NS_ASSUME_NONNULL_BEGIN
 
 @class MGPScene;
 @class MGPSceneNodeComponent;
+
+// Transforms of all nodes share one unsynchronized transform system, so nodes are
+// created, changed and released on the main thread only. (asserted in debug builds)
 @interface MGPSceneNode : NSObject
 
 // On/Off
@@ -27,6 +30,13 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic, readonly) matrix_float4x4 localToWorldRotationMatrix;
 @property (nonatomic, readonly) matrix_float4x4 worldToLocalRotationMatrix;
 
+// Increased whenever world matrices are recalculated (for caching world-space data)
+@property (nonatomic, readonly) NSUInteger transformVersion;
+
+// Recalculates world matrices of all changed nodes in one linear pass.
+// Transform changes only mark nodes dirty, world matrices are also resolved when read.
++ (void)updateWorldMatrices;
+
 // Transform (Local)
 @property (nonatomic) simd_float3 position;
 @property (nonatomic) simd_float3 rotation;
@@ -9,12 +9,47 @@
 #import "MGPSceneNode.h"
 #import "../Utility/MetalMath.h"
 #import "MGPSceneNodeComponent.h"
+#import "MGPTransformSystem.h"
+
+@interface MGPScene (Private)
+- (void)registerComponent:(MGPSceneNodeComponent *)component;
+- (void)unregisterComponent:(MGPSceneNodeComponent *)component;
+@end
+
+// Transforms of all nodes, stored contiguously.
+// Not synchronized, every node is used on the main thread where scenes are rendered.
+static mgp_transform_system_t *MGPSharedTransformSystem(void) {
+    NSCAssert(NSThread.isMainThread, @"Scene nodes must be used on the main thread.");
+    static mgp_transform_system_t *system;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        uint32_t numThreads = (uint32_t)MIN(4, NSProcessInfo.processInfo.activeProcessorCount);
+        system = mgp_transform_system_create(numThreads);
+    });
+    return system;
+}
+
+static simd_float4x4 MGPMatrixFrom3x3(const float m[9]) {
+    return simd_matrix(simd_make_float4(m[0], m[1], m[2], 0),
+                       simd_make_float4(m[3], m[4], m[5], 0),
+                       simd_make_float4(m[6], m[7], m[8], 0),
+                       simd_make_float4(0, 0, 0, 1));
+}
+
+static void MGPMatrixTo3x3(simd_float4x4 matrix, float m[9]) {
+    for(int col = 0; col < 3; col++) {
+        m[col * 3 + 0] = matrix.columns[col].x;
+        m[col * 3 + 1] = matrix.columns[col].y;
+        m[col * 3 + 2] = matrix.columns[col].z;
+    }
+}
 
 @implementation MGPSceneNode {
+    mgp_transform_t _transform;
     NSMutableArray<MGPSceneNode *> *_children;
     NSMutableArray<MGPSceneNodeComponent *> *_components;
-    simd_float4x4 _localToParentRotationMatrix, _parentToLocalRotationMatrix;
-    simd_float3 _position, _rotation, _scale;
+    simd_float3 _rotation;
+    __weak MGPScene *_activeScene;     // non-nil if this node and all of its ancestors are enabled in a scene
 }
 
 @synthesize scene = _scene;
@@ -22,45 +57,140 @@
 - (instancetype)init {
     self = [super init];
     if(self) {
+        _transform = mgp_transform_create(MGPSharedTransformSystem());
         _children = [NSMutableArray new];
         _components = [NSMutableArray new];
-        _localToParentMatrix = matrix_identity_float4x4;
-        _parentToLocalMatrix = matrix_identity_float4x4;
-        _localToParentRotationMatrix = matrix_identity_float4x4;
-        _parentToLocalRotationMatrix = matrix_identity_float4x4;
-        _localToWorldMatrix = matrix_identity_float4x4;
-        _worldToLocalMatrix = matrix_identity_float4x4;
-        _localToWorldRotationMatrix = matrix_identity_float4x4;
-        _worldToLocalRotationMatrix = matrix_identity_float4x4;
-        _scale = simd_make_float3(1, 1, 1);
         _enabled = YES;
     }
     return self;
 }
 
+- (void)dealloc {
+    mgp_transform_destroy(MGPSharedTransformSystem(), _transform);
+}
+
++ (void)updateWorldMatrices {
+    mgp_transform_system_update(MGPSharedTransformSystem());
+}
+
+- (void)setEnabled:(BOOL)enabled {
+    _enabled = enabled;
+    [self _updateActiveScene];
+}
+
 #pragma mark - Matrix, Transform
+- (matrix_float4x4)localToParentMatrix {
+    simd_float3 position, scale;
+    float rotation[9];
+    mgp_transform_get_local(MGPSharedTransformSystem(), _transform, (float *)&position, rotation, (float *)&scale);
+    
+    simd_float4x4 matrix = MGPMatrixFrom3x3(rotation);
+    matrix.columns[0].xyz *= scale.x;
+    matrix.columns[1].xyz *= scale.y;
+    matrix.columns[2].xyz *= scale.z;
+    matrix.columns[3].xyz = position;
+    return matrix;
+}
+
 - (void)setLocalToParentMatrix:(matrix_float4x4)localToParentMatrix {
-    _localToParentMatrix = localToParentMatrix;
-    _parentToLocalMatrix = simd_inverse(localToParentMatrix);
-    [self _decomposeMatrixToTRS];
+    simd_float3x3 axes = simd_matrix(localToParentMatrix.columns[0].xyz,
+                                     localToParentMatrix.columns[1].xyz,
+                                     localToParentMatrix.columns[2].xyz);
+    [self _setLocalPosition:localToParentMatrix.columns[3].xyz axes:axes];
+}
+
+// axes : rotation * scale, the upper 3x3 of the local to parent matrix
+- (void)_setLocalPosition:(simd_float3)position axes:(simd_float3x3)axes {
+    simd_float3 scale = simd_make_float3(simd_length(axes.columns[0]),
+                                         simd_length(axes.columns[1]),
+                                         simd_length(axes.columns[2]));
+    
+    // orthonormalized axes are the rotation as is, euler angles are only kept for the rotation getter
+    simd_float3 x = axes.columns[0] / scale.x;
+    simd_float3 y = axes.columns[1] - simd_dot(axes.columns[1], x) * x;
+    simd_float4x4 rotationMatrix;
+    if(scale.x >= 1e-10f && scale.z >= 1e-10f && simd_length(y) >= 1e-10f) {
+        y = simd_normalize(y);
+        simd_float3 z = simd_cross(x, y);
+        // mirrored, the rotation stays proper with a negative scale
+        if(simd_dot(z, axes.columns[2]) < 0.0f)
+            scale.z = -scale.z;
+        rotationMatrix = simd_matrix(simd_make_float4(x, 0), simd_make_float4(y, 0), simd_make_float4(z, 0),
+                                     simd_make_float4(0, 0, 0, 1));
+        matrix_decompose_trs(rotationMatrix, NULL, &_rotation, NULL);
+    }
+    else {
+        // zero scale, only what euler angles can recover
+        simd_float4x4 matrix = simd_matrix(simd_make_float4(axes.columns[0], 0), simd_make_float4(axes.columns[1], 0),
+                                           simd_make_float4(axes.columns[2], 0), simd_make_float4(0, 0, 0, 1));
+        simd_float3 unused;
+        matrix_decompose_trs(matrix, NULL, &_rotation, &unused);
+        rotationMatrix = matrix_from_euler(_rotation);
+    }
+    
+    float rotation[9];
+    MGPMatrixTo3x3(rotationMatrix, rotation);
+    mgp_transform_set_local(MGPSharedTransformSystem(), _transform, (float *)&position, rotation, (float *)&scale);
+}
+
+- (matrix_float4x4)parentToLocalMatrix {
+    simd_float3 position, scale;
+    float rotation[9];
+    mgp_transform_get_local(MGPSharedTransformSystem(), _transform, (float *)&position, rotation, (float *)&scale);
+    
+    simd_float4x4 matrix = simd_transpose(MGPMatrixFrom3x3(rotation));
+    matrix.columns[3].xyz = -simd_mul(matrix, simd_make_float4(position, 1.0)).xyz;
+    simd_float3 scaleDiv1 = 1.0 / scale;
+    matrix.columns[0].xyz *= scaleDiv1.x;
+    matrix.columns[1].xyz *= scaleDiv1.y;
+    matrix.columns[2].xyz *= scaleDiv1.z;
+    return matrix;
 }
 
 - (void)setParentToLocalMatrix:(matrix_float4x4)parentToLocalMatrix {
-    _parentToLocalMatrix = parentToLocalMatrix;
-    _localToParentMatrix = simd_inverse(parentToLocalMatrix);
-    [self _decomposeMatrixToTRS];
+    // rows of the upper 3x3 are the axes divided by their scale, so no 4x4 inverse is needed
+    simd_float3x3 axes;
+    for(int i = 0; i < 3; i++) {
+        simd_float3 row = simd_make_float3(parentToLocalMatrix.columns[0][i],
+                                           parentToLocalMatrix.columns[1][i],
+                                           parentToLocalMatrix.columns[2][i]);
+        float lengthSquared = simd_length_squared(row);
+        axes.columns[i] = lengthSquared >= 1e-20f ? row / lengthSquared : simd_make_float3(0, 0, 0);
+    }
+    simd_float3 position = -simd_mul(axes, parentToLocalMatrix.columns[3].xyz);
+    [self _setLocalPosition:position axes:axes];
+}
+
+- (matrix_float4x4)localToWorldMatrix {
+    simd_float4x4 matrix;
+    memcpy(&matrix, mgp_transform_world_matrix(MGPSharedTransformSystem(), _transform), sizeof(float) * 16);
+    return matrix;
+}
+
+- (matrix_float4x4)worldToLocalMatrix {
+    return simd_inverse(self.localToWorldMatrix);
+}
+
+- (matrix_float4x4)localToWorldRotationMatrix {
+    return MGPMatrixFrom3x3(mgp_transform_world_rotation(MGPSharedTransformSystem(), _transform));
+}
+
+- (matrix_float4x4)worldToLocalRotationMatrix {
+    return simd_transpose(self.localToWorldRotationMatrix);
+}
+
+- (NSUInteger)transformVersion {
+    return mgp_transform_version(MGPSharedTransformSystem(), _transform);
 }
 
 - (simd_float3)position {
-    return _position;
+    simd_float3 position;
+    mgp_transform_get_local(MGPSharedTransformSystem(), _transform, (float *)&position, NULL, NULL);
+    return position;
 }
 
 - (void)setPosition:(simd_float3)position {
-    _position = position;
-    _localToParentMatrix.columns[3].xyz = position;
-    _parentToLocalMatrix.columns[3].xyz = -simd_mul(_parentToLocalRotationMatrix,
-                                                    simd_make_float4(position, 1.0)).xyz;
-    [self _calculateLocalWorldMatrices];
+    mgp_transform_set_local(MGPSharedTransformSystem(), _transform, (float *)&position, NULL, NULL);
 }
 
 - (simd_float3)rotation {
@@ -69,16 +199,19 @@
 
 - (void)setRotation:(simd_float3)rotation {
     _rotation = rotation;
-    [self _calculateMatrices];
+    float matrix[9];
+    MGPMatrixTo3x3(matrix_from_euler(rotation), matrix);
+    mgp_transform_set_local(MGPSharedTransformSystem(), _transform, NULL, matrix, NULL);
 }
 
 - (simd_float3)scale {
-    return _scale;
+    simd_float3 scale;
+    mgp_transform_get_local(MGPSharedTransformSystem(), _transform, NULL, NULL, (float *)&scale);
+    return scale;
 }
 
 - (void)setScale:(simd_float3)scale {
-    _scale = scale;
-    [self _calculateMatrices];
+    mgp_transform_set_local(MGPSharedTransformSystem(), _transform, NULL, NULL, (float *)&scale);
 }
 
 - (void)lookAt:(simd_float3)target {
@@ -87,7 +220,7 @@
 
 - (void)lookAt:(simd_float3)target
             up:(simd_float3)up {
-    simd_float3 worldPos = _localToWorldMatrix.columns[3].xyz;
+    simd_float3 worldPos = self.localToWorldMatrix.columns[3].xyz;
     simd_float3 forward = target - worldPos;
     if(simd_length_squared(forward) > 1e-8f) {
         forward = simd_normalize(forward);
@@ -95,16 +228,16 @@
         simd_float3 right = simd_normalize(simd_cross(up, forward));
         up = simd_normalize(simd_cross(forward, right));
         
-        _localToParentRotationMatrix.columns[0] = simd_make_float4(right, 0);
-        _localToParentRotationMatrix.columns[1] = simd_make_float4(up, 0);
-        _localToParentRotationMatrix.columns[2] = simd_make_float4(forward, 0);
-        _localToParentRotationMatrix.columns[3] = simd_make_float4(0, 0, 0, 1);
-        _parentToLocalRotationMatrix = simd_transpose(_localToParentRotationMatrix);
+        simd_float4x4 rotationMatrix = matrix_identity_float4x4;
+        rotationMatrix.columns[0] = simd_make_float4(right, 0);
+        rotationMatrix.columns[1] = simd_make_float4(up, 0);
+        rotationMatrix.columns[2] = simd_make_float4(forward, 0);
         
-        matrix_decompose_trs(_localToParentRotationMatrix, nil, &_rotation, nil);
+        matrix_decompose_trs(rotationMatrix, nil, &_rotation, nil);
         
-        [self _applyTSWithRotationMatrix];
-        [self _calculateLocalWorldMatrices];
+        float matrix[9];
+        MGPMatrixTo3x3(rotationMatrix, matrix);
+        mgp_transform_set_local(MGPSharedTransformSystem(), _transform, NULL, matrix, NULL);
     }
 }
 
@@ -113,16 +246,21 @@
     if(node == nil || node == self || [_children indexOfObject: node] != NSNotFound || node.parent != nil) {
         return;
     }
+    // rejects ancestors of this node
+    if(!mgp_transform_set_parent(MGPSharedTransformSystem(), node->_transform, _transform)) {
+        return;
+    }
     [_children addObject: node];
     [node setParent:self];
-    [node _calculateLocalWorldMatrices];
+    [node _updateActiveScene];
 }
 
 - (void)removeChild:(MGPSceneNode *)node {
     if(node != nil && node.parent == self) {
         [_children removeObject: node];
         [node setParent:nil];
-        [node _calculateLocalWorldMatrices];
+        [node _updateActiveScene];
+        mgp_transform_set_parent(MGPSharedTransformSystem(), node->_transform, MGP_TRANSFORM_NONE);
     }
 }
 
@@ -142,6 +280,28 @@
 
 - (void)setScene:(MGPScene * _Nullable)scene {
     _scene = scene;
+    [self _updateActiveScene];
+}
+
+- (MGPScene * _Nullable)activeScene {
+    return _activeScene;
+}
+
+- (void)_updateActiveScene {
+    MGPScene *scene = _parent ? _parent->_activeScene : _scene;
+    if(!_enabled)
+        scene = nil;
+    if(scene == _activeScene)
+        return;
+    
+    for(MGPSceneNodeComponent *component in _components) {
+        if(!component.enabled) continue;
+        [_activeScene unregisterComponent:component];
+        [scene registerComponent:component];
+    }
+    _activeScene = scene;
+    for(MGPSceneNode *child in _children)
+        [child _updateActiveScene];
 }
 
 #pragma mark - Components
@@ -149,6 +309,8 @@
     if(component.node == nil) {
         [_components addObject: component];
         component.node = self;
+        if(component.enabled)
+            [_activeScene registerComponent:component];
     }
     else {
         @throw [NSException exceptionWithName:@"MGPSceneNodeErrorDomain"
@@ -170,76 +332,30 @@
 }
 
 - (void)removeComponentAtIndex: (NSUInteger)index {
+    [self _detachComponent:[_components objectAtIndex:index]];
     [_components removeObjectAtIndex:index];
 }
 
 - (void)removeAllComponents {
+    for(MGPSceneNodeComponent *comp in _components)
+        [self _detachComponent:comp];
     [_components removeAllObjects];
 }
 
 - (void)removeComponentOfType: (Class)theClass {
     for(NSUInteger i = 0; i < _components.count; i++) {
         MGPSceneNodeComponent *comp = [_components objectAtIndex:i];
-        if(comp.class == theClass)
+        if(comp.class == theClass) {
+            [self _detachComponent:comp];
             [_components removeObjectAtIndex:i--];
-    }
-}
-
-#pragma mark - Matrix operations
-- (void)_calculateMatrices {
-    // get rotation matrix
-    _localToParentRotationMatrix = matrix_from_euler(_rotation);
-    _parentToLocalRotationMatrix = simd_transpose(_localToParentRotationMatrix);
-    
-    [self _applyTSWithRotationMatrix];
-    [self _calculateLocalWorldMatrices];
-}
-
-- (void)_applyTSWithRotationMatrix {
-    simd_float4x4 localToParentMatrix = _localToParentRotationMatrix;
-    simd_float4x4 parentToLocalMatrix = _parentToLocalRotationMatrix;
-    
-    // apply positions
-    localToParentMatrix.columns[3].xyz = _position;
-    parentToLocalMatrix.columns[3].xyz = -simd_mul(_parentToLocalRotationMatrix, simd_make_float4(_position, 1.0)).xyz;
-    
-    // apply scales
-    simd_float3 scaleDiv1 = 1.0 / _scale;
-    localToParentMatrix.columns[0].xyz *= _scale.x;
-    localToParentMatrix.columns[1].xyz *= _scale.y;
-    localToParentMatrix.columns[2].xyz *= _scale.z;
-    parentToLocalMatrix.columns[0].xyz *= scaleDiv1.x;
-    parentToLocalMatrix.columns[1].xyz *= scaleDiv1.y;
-    parentToLocalMatrix.columns[2].xyz *= scaleDiv1.z;
-    
-    // replace current matrices
-    _localToParentMatrix = localToParentMatrix;
-    _parentToLocalMatrix = parentToLocalMatrix;
-}
-
-- (void)_calculateLocalWorldMatrices {
-    if(_parent) {
-        _localToWorldMatrix = simd_mul(_parent.localToWorldMatrix, _localToParentMatrix);
-        _worldToLocalMatrix = simd_mul(_parent.worldToLocalMatrix, _parentToLocalMatrix);
-        _localToWorldRotationMatrix = simd_mul(_parent.localToWorldRotationMatrix, _localToParentRotationMatrix);
-        _worldToLocalRotationMatrix = simd_mul(_parent.worldToLocalRotationMatrix, _parentToLocalRotationMatrix);
-    }
-    else {
-        _localToWorldMatrix = _localToParentMatrix;
-        _worldToLocalMatrix = _parentToLocalMatrix;
-        _localToWorldRotationMatrix = _localToParentRotationMatrix;
-        _worldToLocalRotationMatrix = _parentToLocalRotationMatrix;
-    }
-    
-    if(_children.count > 0) {
-        for(MGPSceneNode *child in _children) {
-            [child _calculateLocalWorldMatrices];
         }
     }
 }
 
-- (void)_decomposeMatrixToTRS {
-    matrix_decompose_trs(_localToParentMatrix, &_position, &_rotation, &_scale);
+- (void)_detachComponent: (MGPSceneNodeComponent *)component {
+    if(component.enabled)
+        [_activeScene unregisterComponent:component];
+    component.node = nil;
 }
 
 @end
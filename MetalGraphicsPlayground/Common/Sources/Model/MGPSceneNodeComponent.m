@@ -9,7 +9,18 @@
 #import "MGPSceneNodeComponent.h"
 #import "MGPSceneNode.h"
 
-@implementation MGPSceneNodeComponent
+@interface MGPSceneNode (Private)
+- (MGPScene * _Nullable)activeScene;
+@end
+
+@interface MGPScene (Private)
+- (void)registerComponent:(MGPSceneNodeComponent *)component;
+- (void)unregisterComponent:(MGPSceneNodeComponent *)component;
+@end
+
+@implementation MGPSceneNodeComponent {
+    NSUInteger _sceneIndex;     // index in the scene's registry
+}
 
 - (instancetype)init {
     self = [super init];
@@ -19,6 +30,26 @@
     return self;
 }
 
+- (void)setEnabled:(BOOL)enabled {
+    if(_enabled == enabled)
+        return;
+    
+    MGPScene *scene = _node.activeScene;
+    if(!enabled)
+        [scene unregisterComponent:self];
+    _enabled = enabled;
+    if(enabled)
+        [scene registerComponent:self];
+}
+
+- (NSUInteger)sceneIndex {
+    return _sceneIndex;
+}
+
+- (void)setSceneIndex:(NSUInteger)sceneIndex {
+    _sceneIndex = sceneIndex;
+}
+
 - (simd_float4x4)localToWorldMatrix {
     return _node ? _node.localToWorldMatrix : matrix_identity_float4x4;
 }
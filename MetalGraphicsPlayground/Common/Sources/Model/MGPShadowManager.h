@@ -20,10 +20,16 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic, readonly) id<MTLLibrary> library;
 @property (nonatomic, readonly) MTLVertexDescriptor *vertexDescriptor;
 @property (nonatomic, readonly) id<MTLRenderPipelineState> shadowPipeline;
+// for meshes with quantized vertices, nil without the descriptor
+@property (nonatomic, readonly, nullable) id<MTLRenderPipelineState> quantizedShadowPipeline;
 
 - (instancetype)initWithDevice: (id<MTLDevice>)device
                        library: (id<MTLLibrary>)library
               vertexDescriptor: (MTLVertexDescriptor *)vertexDescriptor;
+- (instancetype)initWithDevice: (id<MTLDevice>)device
+                       library: (id<MTLLibrary>)library
+              vertexDescriptor: (MTLVertexDescriptor *)vertexDescriptor
+     quantizedVertexDescriptor: (nullable MTLVertexDescriptor *)quantizedVertexDescriptor;
 
 - (MGPShadowBuffer *)newShadowBufferForLight: (MGPLight *)light
                                   resolution: (NSUInteger)resolution
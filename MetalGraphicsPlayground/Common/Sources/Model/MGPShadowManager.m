@@ -11,6 +11,7 @@
 #import "MGPLight.h"
 #import "MGPCamera.h"
 #import "MGPLightComponent.h"
+#import "../../Shaders/SharedStructures.h"
 
 NSString * const MGPShadowManagerErrorDoamin = @"MGPShadowManagerError";
 
@@ -19,11 +20,23 @@ NSString * const MGPShadowManagerErrorDoamin = @"MGPShadowManagerError";
     NSMutableDictionary<NSNumber*, MGPShadowBuffer*> *_lightCompShadowBufferDict;
     MGPCamera *_camera;
     id<MTLRenderPipelineState> _shadowPipeline;
+    id<MTLRenderPipelineState> _quantizedShadowPipeline;
+    MTLVertexDescriptor *_quantizedVertexDescriptor;
 }
 
 - (instancetype)initWithDevice:(id<MTLDevice>)device
                        library:(id<MTLLibrary>)library
               vertexDescriptor:(nonnull MTLVertexDescriptor *)vertexDescriptor {
+    return [self initWithDevice: device
+                        library: library
+               vertexDescriptor: vertexDescriptor
+      quantizedVertexDescriptor: nil];
+}
+
+- (instancetype)initWithDevice:(id<MTLDevice>)device
+                       library:(id<MTLLibrary>)library
+              vertexDescriptor:(nonnull MTLVertexDescriptor *)vertexDescriptor
+     quantizedVertexDescriptor:(nullable MTLVertexDescriptor *)quantizedVertexDescriptor {
     self = [super init];
     if(self) {
         if(device == nil)
@@ -38,6 +51,7 @@ NSString * const MGPShadowManagerErrorDoamin = @"MGPShadowManagerError";
         _device = device;
         _library = library;
         _vertexDescriptor = vertexDescriptor;
+        _quantizedVertexDescriptor = quantizedVertexDescriptor;
         _shadowBufferDict = [NSMutableDictionary dictionaryWithCapacity:8];
         _lightCompShadowBufferDict = [NSMutableDictionary dictionaryWithCapacity:8];
         [self _makeRenderPipeline];
@@ -53,6 +67,20 @@ NSString * const MGPShadowManagerErrorDoamin = @"MGPShadowManagerError";
     
     _shadowPipeline = [_device newRenderPipelineStateWithDescriptor: desc
                                                               error: nil];
+    
+    if(_quantizedVertexDescriptor != nil) {
+        bool quantizedVertex = true;
+        MTLFunctionConstantValues *constantValues = [MTLFunctionConstantValues new];
+        [constantValues setConstantValue: &quantizedVertex
+                                    type: MTLDataTypeBool
+                                 atIndex: fcv_quantized_vertex];
+        desc.vertexDescriptor = _quantizedVertexDescriptor;
+        desc.vertexFunction = [_library newFunctionWithName: @"shadow_vert"
+                                             constantValues: constantValues
+                                                      error: nil];
+        _quantizedShadowPipeline = [_device newRenderPipelineStateWithDescriptor: desc
+                                                                           error: nil];
+    }
 }
 
 - (MGPShadowBuffer *)newShadowBufferForLight:(MGPLight *)light
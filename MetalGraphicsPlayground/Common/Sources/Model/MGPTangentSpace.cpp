@@ -0,0 +1,332 @@
+//
+//  MGPTangentSpace.cpp
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/17.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#include "MGPTangentSpace.h"
+#include "MGPWorkerPool.h"
+
+#include <string.h>
+#include <algorithm>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+namespace {
+    // meshes with less triangles than this aren't worth waking workers for
+    const size_t kMinParallelTriangles = 4096;
+    const uint32_t kNoVertex = UINT32_MAX;
+
+    struct Vector3 {
+        float x, y, z;
+    };
+
+    inline Vector3 operator+(const Vector3 &a, const Vector3 &b) { return { a.x + b.x, a.y + b.y, a.z + b.z }; }
+    inline Vector3 operator-(const Vector3 &a, const Vector3 &b) { return { a.x - b.x, a.y - b.y, a.z - b.z }; }
+    inline Vector3 operator*(const Vector3 &a, float s) { return { a.x * s, a.y * s, a.z * s }; }
+    inline float dot(const Vector3 &a, const Vector3 &b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+    inline Vector3 cross(const Vector3 &a, const Vector3 &b) {
+        return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+    }
+    inline Vector3 normalizeOrZero(const Vector3 &a) {
+        float length = sqrtf(dot(a, a));
+        return length > 1e-20f ? a * (1.0f / length) : Vector3 { 0.0f, 0.0f, 0.0f };
+    }
+    inline bool isZero(const Vector3 &a) {
+        return a.x == 0.0f && a.y == 0.0f && a.z == 0.0f;
+    }
+    inline bool isEqual(const Vector3 &a, const Vector3 &b) {
+        return memcmp(&a, &b, sizeof(Vector3)) == 0;
+    }
+
+    class Vertices {
+    public:
+        Vertices(void *vertices, const mgp_tangent_space_layout_t &layout)
+        : _bytes((uint8_t *)vertices), _layout(layout) {}
+
+        float *attribute(uint32_t vertex, size_t offset) const {
+            return (float *)(_bytes + _layout.vertexSize * vertex + offset);
+        }
+        Vector3 position(uint32_t vertex) const {
+            const float *p = attribute(vertex, _layout.positionOffset);
+            return { p[0], p[1], p[2] };
+        }
+        Vector3 normal(uint32_t vertex) const {
+            const float *n = attribute(vertex, _layout.normalOffset);
+            return { n[0], n[1], n[2] };
+        }
+        const float *uv(uint32_t vertex) const {
+            return attribute(vertex, _layout.uvOffset);
+        }
+        void setNormal(uint32_t vertex, const Vector3 &normal) const {
+            memcpy(attribute(vertex, _layout.normalOffset), &normal, sizeof(Vector3));
+        }
+        void setTangent(uint32_t vertex, const Vector3 &tangent, float sign) const {
+            float *t = attribute(vertex, _layout.tangentOffset);
+            memcpy(t, &tangent, sizeof(Vector3));
+            if(_layout.tangentHasSign)
+                t[3] = sign;
+        }
+        void copy(uint32_t destination, uint32_t source) const {
+            memcpy(_bytes + _layout.vertexSize * destination, _bytes + _layout.vertexSize * source, _layout.vertexSize);
+        }
+
+    private:
+        uint8_t *_bytes;
+        mgp_tangent_space_layout_t _layout;
+    };
+
+    // Runs job(first, last) over count items, one range per worker.
+    template<typename Job>
+    void parallelRanges(mgp::WorkerPool &pool, size_t count, const Job &job) {
+        uint32_t numThreads = pool.numThreads();
+        pool.run([&](uint32_t worker) {
+            size_t first = count * worker / numThreads;
+            size_t last = count * (worker + 1) / numThreads;
+            if(first < last)
+                job(first, last);
+        });
+    }
+
+    uint32_t threadCount(uint32_t numThreads, size_t triangleCount) {
+        if(triangleCount < kMinParallelTriangles)
+            return 1;
+        return numThreads > 0 ? numThreads : std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // Angle of every corner of the triangles.
+    void cornerAngles(float *angles, const Vertices &vertices, const uint32_t *indices, size_t first, size_t last) {
+        for(size_t t = first; t < last; t++) {
+            const uint32_t *corners = indices + t * 3;
+            for(int c = 0; c < 3; c++) {
+                Vector3 p = vertices.position(corners[c]);
+                Vector3 e1 = normalizeOrZero(vertices.position(corners[(c + 1) % 3]) - p);
+                Vector3 e2 = normalizeOrZero(vertices.position(corners[(c + 2) % 3]) - p);
+                angles[t * 3 + c] = acosf(std::min(1.0f, std::max(-1.0f, dot(e1, e2))));
+            }
+        }
+    }
+
+    // Vertices at the same position share an id, positions match bit by bit.
+    std::vector<uint32_t> weldPositions(const Vertices &vertices, size_t vertexCount) {
+        size_t capacity = 1;
+        while(capacity < vertexCount * 2)
+            capacity *= 2;
+        std::vector<uint32_t> table(capacity, kNoVertex);
+        std::vector<uint32_t> ids(vertexCount);
+        for(uint32_t v = 0; v < vertexCount; v++) {
+            uint32_t key[3];
+            Vector3 p = vertices.position(v);
+            memcpy(key, &p, sizeof(key));
+            uint32_t hash = (key[0] * 73856093u) ^ (key[1] * 19349663u) ^ (key[2] * 83492791u);
+            size_t slot = hash & (capacity - 1);
+            while(table[slot] != kNoVertex && !isEqual(vertices.position(table[slot]), p))
+                slot = (slot + 1) & (capacity - 1);
+            if(table[slot] == kNoVertex)
+                table[slot] = v;
+            ids[v] = table[slot];
+        }
+        return ids;
+    }
+
+    // Corners of every key in the order of the corners. (compressed rows)
+    struct CornerLists {
+        std::vector<uint32_t> offsets;
+        std::vector<uint32_t> corners;
+
+        CornerLists(const uint32_t *keys, size_t cornerCount, size_t keyCount)
+        : offsets(keyCount + 1, 0), corners(cornerCount) {
+            for(size_t i = 0; i < cornerCount; i++)
+                offsets[keys[i] + 1]++;
+            for(size_t k = 0; k < keyCount; k++)
+                offsets[k + 1] += offsets[k];
+            std::vector<uint32_t> cursors(offsets.begin(), offsets.end() - 1);
+            for(size_t i = 0; i < cornerCount; i++)
+                corners[cursors[keys[i]]++] = (uint32_t)i;
+        }
+    };
+
+    Vector3 anyTangent(const Vector3 &normal) {
+        Vector3 axis = fabsf(normal.x) < 0.9f ? Vector3 { 1.0f, 0.0f, 0.0f } : Vector3 { 0.0f, 1.0f, 0.0f };
+        Vector3 tangent = normalizeOrZero(axis - normal * dot(normal, axis));
+        return isZero(tangent) ? Vector3 { 1.0f, 0.0f, 0.0f } : tangent;
+    }
+}
+
+size_t mgp_tangent_space_generate_normals(void *destination, uint32_t *destinationIndices,
+                                          const void *vertices, size_t vertexCount,
+                                          const uint32_t *indices, size_t indexCount,
+                                          const mgp_tangent_space_layout_t *layout,
+                                          float creaseThreshold, uint32_t numThreads) {
+    if(destination != vertices)
+        memcpy(destination, vertices, layout->vertexSize * vertexCount);
+    if(destinationIndices != indices)
+        memcpy(destinationIndices, indices, sizeof(uint32_t) * indexCount);
+    size_t triangleCount = indexCount / 3;
+    size_t cornerCount = triangleCount * 3;
+    Vertices output(destination, *layout);
+    mgp::WorkerPool pool(threadCount(numThreads, triangleCount));
+
+    // face normals and corner angles
+    std::vector<Vector3> faceNormals(triangleCount);
+    std::vector<float> angles(cornerCount);
+    parallelRanges(pool, triangleCount, [&](size_t first, size_t last) {
+        for(size_t t = first; t < last; t++) {
+            const uint32_t *corners = destinationIndices + t * 3;
+            Vector3 p0 = output.position(corners[0]);
+            faceNormals[t] = normalizeOrZero(cross(output.position(corners[1]) - p0, output.position(corners[2]) - p0));
+        }
+        cornerAngles(angles.data(), output, destinationIndices, first, last);
+    });
+
+    // corners around every position
+    std::vector<uint32_t> positionIds = weldPositions(output, vertexCount);
+    std::vector<uint32_t> cornerPositions(cornerCount);
+    for(size_t i = 0; i < cornerCount; i++)
+        cornerPositions[i] = positionIds[destinationIndices[i]];
+    CornerLists positionCorners(cornerPositions.data(), cornerCount, vertexCount);
+
+    // a corner gathers the faces around its position that bend less than the crease
+    std::vector<Vector3> cornerNormals(cornerCount);
+    parallelRanges(pool, triangleCount, [&](size_t first, size_t last) {
+        for(size_t i = first * 3; i < last * 3; i++) {
+            const Vector3 &faceNormal = faceNormals[i / 3];
+            uint32_t position = cornerPositions[i];
+            Vector3 sum = { 0.0f, 0.0f, 0.0f }, all = { 0.0f, 0.0f, 0.0f };
+            for(uint32_t j = positionCorners.offsets[position]; j < positionCorners.offsets[position + 1]; j++) {
+                uint32_t corner = positionCorners.corners[j];
+                Vector3 weighted = faceNormals[corner / 3] * angles[corner];
+                all = all + weighted;
+                if(dot(faceNormal, faceNormals[corner / 3]) >= creaseThreshold)
+                    sum = sum + weighted;
+            }
+            // degenerate faces take the smooth normal
+            Vector3 normal = normalizeOrZero(isZero(faceNormal) ? all : sum);
+            cornerNormals[i] = isZero(normal) ? Vector3 { 0.0f, 0.0f, 1.0f } : normal;
+        }
+    });
+
+    // corners with the same faces around get the same sum, others split their vertex
+    size_t outputCount = vertexCount;
+    std::vector<uint32_t> nextSplit(vertexCount + cornerCount, kNoVertex);
+    std::vector<uint8_t> assigned(vertexCount, 0);
+    for(size_t i = 0; i < cornerCount; i++) {
+        uint32_t vertex = destinationIndices[i];
+        const Vector3 &normal = cornerNormals[i];
+        if(!assigned[vertex]) {
+            assigned[vertex] = 1;
+            output.setNormal(vertex, normal);
+            continue;
+        }
+        uint32_t last = vertex;
+        for(uint32_t v = vertex; v != kNoVertex; v = nextSplit[v]) {
+            last = v;
+            if(isEqual(output.normal(v), normal))
+                break;
+        }
+        if(!isEqual(output.normal(last), normal)) {
+            uint32_t split = (uint32_t)outputCount++;
+            output.copy(split, vertex);
+            output.setNormal(split, normal);
+            nextSplit[last] = split;
+            last = split;
+        }
+        destinationIndices[i] = last;
+    }
+    return outputCount;
+}
+
+size_t mgp_tangent_space_generate_tangents(void *destination, uint32_t *destinationIndices,
+                                           const void *vertices, size_t vertexCount,
+                                           const uint32_t *indices, size_t indexCount,
+                                           const mgp_tangent_space_layout_t *layout,
+                                           uint32_t numThreads) {
+    if(destination != vertices)
+        memcpy(destination, vertices, layout->vertexSize * vertexCount);
+    if(destinationIndices != indices)
+        memcpy(destinationIndices, indices, sizeof(uint32_t) * indexCount);
+    size_t triangleCount = indexCount / 3;
+    size_t cornerCount = triangleCount * 3;
+    Vertices output(destination, *layout);
+    mgp::WorkerPool pool(threadCount(numThreads, triangleCount));
+
+    // dP/du of every face with its uv orientation, projected onto the normal of each corner
+    std::vector<float> angles(cornerCount);
+    std::vector<Vector3> cornerTangents(cornerCount);
+    std::vector<uint8_t> preservesOrientation(cornerCount);
+    parallelRanges(pool, triangleCount, [&](size_t first, size_t last) {
+        cornerAngles(angles.data(), output, destinationIndices, first, last);
+        for(size_t t = first; t < last; t++) {
+            const uint32_t *corners = destinationIndices + t * 3;
+            Vector3 p0 = output.position(corners[0]);
+            Vector3 d1 = output.position(corners[1]) - p0;
+            Vector3 d2 = output.position(corners[2]) - p0;
+            const float *uv0 = output.uv(corners[0]);
+            const float *uv1 = output.uv(corners[1]);
+            const float *uv2 = output.uv(corners[2]);
+            float t21x = uv1[0] - uv0[0], t21y = uv1[1] - uv0[1];
+            float t31x = uv2[0] - uv0[0], t31y = uv2[1] - uv0[1];
+            float signedArea = t21x * t31y - t21y * t31x;
+            Vector3 faceTangent = normalizeOrZero((d1 * t31y - d2 * t21y) * (signedArea > 0.0f ? 1.0f : -1.0f));
+            if(signedArea == 0.0f)
+                faceTangent = { 0.0f, 0.0f, 0.0f };
+            for(int c = 0; c < 3; c++) {
+                Vector3 normal = output.normal(corners[c]);
+                Vector3 projected = normalizeOrZero(faceTangent - normal * dot(normal, faceTangent));
+                cornerTangents[t * 3 + c] = projected * angles[t * 3 + c];
+                preservesOrientation[t * 3 + c] = signedArea > 0.0f;
+            }
+        }
+    });
+
+    // sums of the corners of every vertex, one for each orientation
+    CornerLists vertexCorners(destinationIndices, cornerCount, vertexCount);
+    std::vector<Vector3> sums(vertexCount * 2);
+    parallelRanges(pool, vertexCount, [&](size_t first, size_t last) {
+        for(size_t v = first; v < last; v++) {
+            Vector3 sum[2] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
+            for(uint32_t j = vertexCorners.offsets[v]; j < vertexCorners.offsets[v + 1]; j++) {
+                uint32_t corner = vertexCorners.corners[j];
+                sum[preservesOrientation[corner]] = sum[preservesOrientation[corner]] + cornerTangents[corner];
+            }
+            sums[v * 2] = sum[0];
+            sums[v * 2 + 1] = sum[1];
+        }
+    });
+
+    // a vertex keeps the orientation of its first corner, the other one is split off
+    size_t outputCount = vertexCount;
+    std::vector<uint32_t> mirrored(vertexCount, kNoVertex);
+    std::vector<int8_t> orientation(vertexCount, -1);
+    for(size_t i = 0; i < cornerCount; i++) {
+        uint32_t vertex = destinationIndices[i];
+        int preserves = preservesOrientation[i];
+        if(orientation[vertex] < 0) {
+            orientation[vertex] = (int8_t)preserves;
+        }
+        else if(orientation[vertex] != preserves) {
+            if(mirrored[vertex] == kNoVertex) {
+                mirrored[vertex] = (uint32_t)outputCount++;
+                output.copy(mirrored[vertex], vertex);
+            }
+            destinationIndices[i] = mirrored[vertex];
+        }
+    }
+    for(uint32_t v = 0; v < vertexCount; v++) {
+        if(orientation[v] < 0)
+            continue;
+        for(int side = 0; side < 2; side++) {
+            uint32_t target = side == orientation[v] ? v : mirrored[v];
+            if(target == kNoVertex)
+                continue;
+            Vector3 tangent = normalizeOrZero(sums[v * 2 + side]);
+            if(isZero(tangent))
+                tangent = anyTangent(output.normal(v));
+            output.setTangent(target, tangent, side ? 1.0f : -1.0f);
+        }
+    }
+    return outputCount;
+}
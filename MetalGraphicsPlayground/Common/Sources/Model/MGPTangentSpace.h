@@ -0,0 +1,62 @@
+//
+//  MGPTangentSpace.h
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/17.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#ifndef MGPTangentSpace_h
+#define MGPTangentSpace_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Normals and tangents of triangle lists, in place of the ModelIO helpers.
+//  - normals : face normals weighted by the angle of the corner, averaged over
+//    corners at the same position whose faces bend less than the crease,
+//  - tangents : the MikkTSpace basis, dP/du of each face projected onto the
+//    normal and weighted by the angle of the corner, averaged over corners of
+//    a vertex with the same uv orientation.
+// A vertex that ends up with more than one normal or tangent is split, copies
+// go after the original vertices and indices are rewritten. Faces are split by
+// ranges across threads, and every sum runs in the order of the corners, so
+// the result doesn't depend on the number of threads.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Interleaved vertices, all attributes are floats.
+typedef struct {
+    size_t vertexSize;          // bytes, vertices are copied whole when split
+    size_t positionOffset;      // float3
+    size_t uvOffset;            // float2
+    size_t normalOffset;        // float3
+    size_t tangentOffset;       // float3, or float4 if tangentHasSign
+    int tangentHasSign;         // w : 1 if the bitangent is cross(normal, tangent), -1 if mirrored
+} mgp_tangent_space_layout_t;
+
+// creaseThreshold : cosine of the sharpest angle between faces that is still smoothed.
+// destination must hold vertexCount + indexCount vertices. Returns the number of vertices.
+// numThreads : 0 picks the hardware concurrency.
+// destination may be the same as vertices, destinationIndices the same as indices.
+size_t mgp_tangent_space_generate_normals(void *destination, uint32_t *destinationIndices,
+                                          const void *vertices, size_t vertexCount,
+                                          const uint32_t *indices, size_t indexCount,
+                                          const mgp_tangent_space_layout_t *layout,
+                                          float creaseThreshold, uint32_t numThreads);
+
+// Normals should be there already.
+// destination must hold vertexCount * 2 vertices. Returns the number of vertices.
+size_t mgp_tangent_space_generate_tangents(void *destination, uint32_t *destinationIndices,
+                                           const void *vertices, size_t vertexCount,
+                                           const uint32_t *indices, size_t indexCount,
+                                           const mgp_tangent_space_layout_t *layout,
+                                           uint32_t numThreads);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MGPTangentSpace_h */
@@ -0,0 +1,183 @@
+//
+//  MGPTextureBudget.cpp
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/17.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#include "MGPTextureBudget.h"
+
+#include <algorithm>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+
+struct mgp_texture_budget {
+    struct Entry {
+        void *texture;
+        uint32_t width, height, depth;
+        std::vector<uint64_t> levelBytes;
+        uint32_t skippedLevels;
+    };
+
+    mgp_texture_budget_backend_t backend;
+    size_t budget;
+    uint32_t maxSize;
+    uint32_t minSize;
+
+    std::vector<Entry> entries;             // in the order of addition
+    std::unordered_map<void *, size_t> indices;
+    std::vector<uint32_t> skippedLevels;    // scratch
+};
+
+uint32_t mgp_texture_budget_max_size_of_level(uint32_t width, uint32_t height, uint32_t depth, uint32_t level) {
+    uint32_t size = std::max(width, std::max(height, depth));
+    return std::max(1u, level < 32 ? size >> level : 0);
+}
+
+// Decides skipped levels of every entry, without the backend.
+static void fit(mgp_texture_budget_t *budget) {
+    auto &entries = budget->entries;
+    auto &skippedLevels = budget->skippedLevels;
+    std::vector<uint32_t> maxSkippedLevels(entries.size());
+    skippedLevels.assign(entries.size(), 0);
+
+    uint64_t total = 0;
+    for(size_t i = 0; i < entries.size(); i++) {
+        const auto &entry = entries[i];
+        uint32_t lastLevel = (uint32_t)entry.levelBytes.size() - 1;
+        auto sizeOf = [&](uint32_t level) {
+            return mgp_texture_budget_max_size_of_level(entry.width, entry.height, entry.depth, level);
+        };
+
+        uint32_t skip = 0;
+        if(budget->maxSize > 0) {
+            while(skip < lastLevel && sizeOf(skip) > budget->maxSize)
+                skip++;
+        }
+        uint32_t maxSkip = skip;
+        while(maxSkip < lastLevel && sizeOf(maxSkip + 1) >= budget->minSize)
+            maxSkip++;
+
+        skippedLevels[i] = skip;
+        maxSkippedLevels[i] = maxSkip;
+        for(uint32_t level = skip; level <= lastLevel; level++)
+            total += entry.levelBytes[level];
+    }
+    if(budget->budget == 0 || total <= budget->budget)
+        return;
+
+    // largest top level first, earlier ones on a tie
+    typedef std::pair<uint64_t, size_t> Candidate;
+    auto compare = [](const Candidate &a, const Candidate &b) {
+        return a.first != b.first ? a.first < b.first : a.second > b.second;
+    };
+    std::priority_queue<Candidate, std::vector<Candidate>, decltype(compare)> candidates(compare);
+    for(size_t i = 0; i < entries.size(); i++) {
+        if(skippedLevels[i] < maxSkippedLevels[i])
+            candidates.emplace(entries[i].levelBytes[skippedLevels[i]], i);
+    }
+    while(total > budget->budget && !candidates.empty()) {
+        size_t i = candidates.top().second;
+        candidates.pop();
+        total -= entries[i].levelBytes[skippedLevels[i]];
+        if(++skippedLevels[i] < maxSkippedLevels[i])
+            candidates.emplace(entries[i].levelBytes[skippedLevels[i]], i);
+    }
+}
+
+// Applies the fitted levels, the backend hears about changes except the skipped texture.
+static void update(mgp_texture_budget_t *budget, void *exceptTexture) {
+    fit(budget);
+    for(size_t i = 0; i < budget->entries.size(); i++) {
+        auto &entry = budget->entries[i];
+        if(entry.skippedLevels == budget->skippedLevels[i])
+            continue;
+        entry.skippedLevels = budget->skippedLevels[i];
+        if(entry.texture != exceptTexture)
+            budget->backend.resize(budget->backend.context, entry.texture, entry.skippedLevels);
+    }
+}
+
+mgp_texture_budget_t *mgp_texture_budget_create(const mgp_texture_budget_backend_t *backend,
+                                                size_t budget, uint32_t maxSize, uint32_t minSize) {
+    mgp_texture_budget_t *textureBudget = new mgp_texture_budget_t();
+    textureBudget->backend = *backend;
+    textureBudget->budget = budget;
+    textureBudget->maxSize = maxSize;
+    textureBudget->minSize = minSize;
+    return textureBudget;
+}
+
+void mgp_texture_budget_destroy(mgp_texture_budget_t *budget) {
+    delete budget;
+}
+
+void mgp_texture_budget_set_budget(mgp_texture_budget_t *budget, size_t bytes) {
+    budget->budget = bytes;
+    update(budget, NULL);
+}
+
+void mgp_texture_budget_set_max_size(mgp_texture_budget_t *budget, uint32_t maxSize) {
+    budget->maxSize = maxSize;
+    update(budget, NULL);
+}
+
+void mgp_texture_budget_set_min_size(mgp_texture_budget_t *budget, uint32_t minSize) {
+    budget->minSize = minSize;
+    update(budget, NULL);
+}
+
+uint32_t mgp_texture_budget_add(mgp_texture_budget_t *budget, void *texture,
+                                uint32_t width, uint32_t height, uint32_t depth,
+                                uint32_t numLevels, const uint64_t *levelBytes) {
+    if(numLevels == 0)
+        return 0;
+    auto index = budget->indices.find(texture);
+    if(index == budget->indices.end()) {
+        index = budget->indices.emplace(texture, budget->entries.size()).first;
+        budget->entries.emplace_back();
+    }
+    auto &entry = budget->entries[index->second];
+    entry.texture = texture;
+    entry.width = width;
+    entry.height = height;
+    entry.depth = depth;
+    entry.levelBytes.assign(levelBytes, levelBytes + numLevels);
+    entry.skippedLevels = 0;
+
+    update(budget, texture);
+    return budget->entries[index->second].skippedLevels;
+}
+
+void mgp_texture_budget_remove(mgp_texture_budget_t *budget, void *texture) {
+    auto index = budget->indices.find(texture);
+    if(index == budget->indices.end())
+        return;
+    size_t i = index->second;
+    budget->indices.erase(index);
+    // keeps the order of addition, ties go to older textures
+    budget->entries.erase(budget->entries.begin() + i);
+    for(size_t j = i; j < budget->entries.size(); j++)
+        budget->indices[budget->entries[j].texture] = j;
+    update(budget, NULL);
+}
+
+uint32_t mgp_texture_budget_skipped_levels(const mgp_texture_budget_t *budget, void *texture) {
+    auto index = budget->indices.find(texture);
+    return index != budget->indices.end() ? budget->entries[index->second].skippedLevels : 0;
+}
+
+void mgp_texture_budget_get_stats(const mgp_texture_budget_t *budget, mgp_texture_budget_stats_t *stats) {
+    *stats = {};
+    for(const auto &entry : budget->entries) {
+        for(size_t level = 0; level < entry.levelBytes.size(); level++) {
+            stats->fullBytes += entry.levelBytes[level];
+            if(level >= entry.skippedLevels)
+                stats->residentBytes += entry.levelBytes[level];
+        }
+        stats->numTextures++;
+        stats->numReduced += entry.skippedLevels > 0;
+    }
+}
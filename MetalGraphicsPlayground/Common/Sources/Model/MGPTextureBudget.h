@@ -0,0 +1,70 @@
+//
+//  MGPTextureBudget.h
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/17.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#ifndef MGPTextureBudget_h
+#define MGPTextureBudget_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Texture quality policy, decides how many top mip levels each texture skips.
+//  - levels larger than maxSize are always skipped,
+//  - while the retained levels of every texture exceed the budget, the texture
+//    with the largest top level drops it, so the biggest textures shrink first,
+//  - a texture never drops below minSize or its last level.
+// The budget can be exceeded if minSize doesn't allow to fit it.
+// Skipped levels are recomputed when textures or limits change, the backend is
+// told about every texture whose count changed, so it can reload it.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    // Skipped levels of the texture changed, the texture isn't the one being added.
+    void (*resize)(void *context, void *texture, uint32_t skippedLevels);
+    void *context;
+} mgp_texture_budget_backend_t;
+
+typedef struct {
+    size_t residentBytes;       // retained levels of every texture
+    size_t fullBytes;           // if no level was skipped
+    uint32_t numTextures;
+    uint32_t numReduced;        // textures skipping any level
+} mgp_texture_budget_stats_t;
+
+typedef struct mgp_texture_budget mgp_texture_budget_t;
+
+// budget : bytes, 0 is unlimited. maxSize : 0 is unlimited.
+mgp_texture_budget_t *mgp_texture_budget_create(const mgp_texture_budget_backend_t *backend,
+                                                size_t budget, uint32_t maxSize, uint32_t minSize);
+void mgp_texture_budget_destroy(mgp_texture_budget_t *budget);
+
+void mgp_texture_budget_set_budget(mgp_texture_budget_t *budget, size_t bytes);
+void mgp_texture_budget_set_max_size(mgp_texture_budget_t *budget, uint32_t maxSize);
+void mgp_texture_budget_set_min_size(mgp_texture_budget_t *budget, uint32_t minSize);
+
+// levelBytes : bytes of each level over every slice, largest first.
+// Returns skipped levels of the texture.
+uint32_t mgp_texture_budget_add(mgp_texture_budget_t *budget, void *texture,
+                                uint32_t width, uint32_t height, uint32_t depth,
+                                uint32_t numLevels, const uint64_t *levelBytes);
+void mgp_texture_budget_remove(mgp_texture_budget_t *budget, void *texture);
+// Returns 0 if the texture isn't added.
+uint32_t mgp_texture_budget_skipped_levels(const mgp_texture_budget_t *budget, void *texture);
+
+// Largest dimension of the first retained level, the maxsize of the loader.
+uint32_t mgp_texture_budget_max_size_of_level(uint32_t width, uint32_t height, uint32_t depth, uint32_t level);
+
+void mgp_texture_budget_get_stats(const mgp_texture_budget_t *budget, mgp_texture_budget_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MGPTextureBudget_h */
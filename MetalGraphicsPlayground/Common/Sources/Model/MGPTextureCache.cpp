@@ -0,0 +1,206 @@
+//
+//  MGPTextureCache.cpp
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/17.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#include "MGPTextureCache.h"
+
+#include <string.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+    struct PathKey {
+        std::string path;
+        uint32_t variant;
+        bool operator==(const PathKey &other) const {
+            return variant == other.variant && path == other.path;
+        }
+    };
+    struct PathKeyHash {
+        size_t operator()(const PathKey &key) const {
+            return std::hash<std::string>()(key.path) ^ ((size_t)key.variant * 0x9e3779b97f4a7c15ULL);
+        }
+    };
+
+    struct ContentKey {
+        uint64_t hash;
+        uint64_t fileSize;
+        uint32_t variant;
+        bool operator==(const ContentKey &other) const {
+            return hash == other.hash && fileSize == other.fileSize && variant == other.variant;
+        }
+    };
+    struct ContentKeyHash {
+        size_t operator()(const ContentKey &key) const {
+            return (size_t)(key.hash ^ (key.fileSize * 0x9e3779b97f4a7c15ULL) ^ key.variant);
+        }
+    };
+
+    struct PathInfo {
+        void *texture;
+        uint64_t fileSize;
+        int64_t modificationTime;
+    };
+
+    struct Entry {
+        ContentKey content;
+        uint32_t refCount;
+        std::vector<PathKey> paths;
+    };
+}
+
+struct mgp_texture_cache {
+    mgp_texture_cache_backend_t backend;
+    std::unordered_map<void *, Entry> entries;
+    std::unordered_map<PathKey, PathInfo, PathKeyHash> paths;
+    std::unordered_map<ContentKey, void *, ContentKeyHash> contents;
+    mgp_texture_cache_stats_t stats;
+};
+
+mgp_texture_cache_t *mgp_texture_cache_create(const mgp_texture_cache_backend_t *backend) {
+    mgp_texture_cache_t *cache = new mgp_texture_cache_t();
+    cache->backend = *backend;
+    cache->stats = {};
+    return cache;
+}
+
+void mgp_texture_cache_destroy(mgp_texture_cache_t *cache) {
+    if(cache == NULL)
+        return;
+    for(auto &entry : cache->entries)
+        cache->backend.evict(cache->backend.context, entry.first);
+    delete cache;
+}
+
+static void remove_path(mgp_texture_cache_t *cache, const PathKey &key, void *texture) {
+    cache->paths.erase(key);
+    auto &paths = cache->entries[texture].paths;
+    for(size_t i = 0; i < paths.size(); i++) {
+        if(paths[i] == key) {
+            paths.erase(paths.begin() + i);
+            break;
+        }
+    }
+}
+
+static void add_path(mgp_texture_cache_t *cache, const mgp_texture_cache_file_t *file, void *texture) {
+    PathKey key = { file->path, file->variant };
+    auto path = cache->paths.find(key);
+    if(path != cache->paths.end())
+        remove_path(cache, key, path->second.texture);
+    cache->paths[key] = { texture, file->fileSize, file->modificationTime };
+    cache->entries[texture].paths.push_back(key);
+}
+
+void *mgp_texture_cache_acquire_path(mgp_texture_cache_t *cache, const mgp_texture_cache_file_t *file) {
+    PathKey key = { file->path, file->variant };
+    auto path = cache->paths.find(key);
+    if(path == cache->paths.end())
+        return NULL;
+
+    void *texture = path->second.texture;
+    if(path->second.fileSize != file->fileSize || path->second.modificationTime != file->modificationTime) {
+        // changed on disk, its contents have to be hashed again
+        remove_path(cache, key, texture);
+        return NULL;
+    }
+    cache->entries[texture].refCount++;
+    cache->stats.pathHits++;
+    cache->stats.savedBytes += file->fileSize;
+    return texture;
+}
+
+void *mgp_texture_cache_acquire_content(mgp_texture_cache_t *cache, const mgp_texture_cache_file_t *file,
+                                        uint64_t contentHash) {
+    auto content = cache->contents.find({ contentHash, file->fileSize, file->variant });
+    if(content == cache->contents.end()) {
+        cache->stats.misses++;
+        return NULL;
+    }
+    void *texture = content->second;
+    add_path(cache, file, texture);
+    cache->entries[texture].refCount++;
+    cache->stats.contentHits++;
+    cache->stats.savedBytes += file->fileSize;
+    cache->stats.dedupedBytes += file->fileSize;
+    return texture;
+}
+
+void mgp_texture_cache_insert(mgp_texture_cache_t *cache, const mgp_texture_cache_file_t *file,
+                              uint64_t contentHash, void *texture) {
+    Entry &entry = cache->entries[texture];
+    entry.content = { contentHash, file->fileSize, file->variant };
+    entry.refCount = 1;
+    cache->contents[entry.content] = texture;
+    add_path(cache, file, texture);
+    cache->stats.residentBytes += file->fileSize;
+}
+
+int mgp_texture_cache_release(mgp_texture_cache_t *cache, void *texture) {
+    auto entry = cache->entries.find(texture);
+    if(entry == cache->entries.end())
+        return 0;
+    if(--entry->second.refCount > 0)
+        return 1;
+
+    for(const auto &key : entry->second.paths)
+        cache->paths.erase(key);
+    cache->contents.erase(entry->second.content);
+    cache->stats.residentBytes -= entry->second.content.fileSize;
+    cache->stats.evictions++;
+    cache->entries.erase(entry);
+    cache->backend.evict(cache->backend.context, texture);
+    return 1;
+}
+
+static inline uint64_t rotl(uint64_t x, int r) {
+    return (x << r) | (x >> (64 - r));
+}
+
+static inline uint64_t read64(const uint8_t *p) {
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+uint64_t mgp_texture_cache_hash(const void *data, size_t size) {
+    // four independent lanes of multiply-rotate over 32-byte stripes (as in xxHash64)
+    static const uint64_t P1 = 0x9e3779b185ebca87ULL;
+    static const uint64_t P2 = 0xc2b2ae3d27d4eb4fULL;
+    static const uint64_t P3 = 0x165667b19e3779f9ULL;
+    const uint8_t *p = (const uint8_t *)data;
+    const uint8_t *end = p + size;
+    uint64_t lanes[4] = { P1 + P2, P2, 0, (uint64_t)0 - P1 };
+    while(end - p >= 32) {
+        for(int i = 0; i < 4; i++, p += 8)
+            lanes[i] = rotl(lanes[i] + read64(p) * P2, 31) * P1;
+    }
+    uint64_t hash = rotl(lanes[0], 1) + rotl(lanes[1], 7) + rotl(lanes[2], 12) + rotl(lanes[3], 18);
+    hash += size;
+    while(end - p >= 8) {
+        hash ^= rotl(read64(p) * P2, 31) * P1;
+        hash = rotl(hash, 27) * P1 + P3;
+        p += 8;
+    }
+    while(p < end) {
+        hash ^= *p++ * P3;
+        hash = rotl(hash, 11) * P1;
+    }
+    hash ^= hash >> 33;
+    hash *= P2;
+    hash ^= hash >> 29;
+    hash *= P3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+void mgp_texture_cache_get_stats(const mgp_texture_cache_t *cache, mgp_texture_cache_stats_t *stats) {
+    *stats = cache->stats;
+    stats->numTextures = (uint32_t)cache->entries.size();
+    stats->numPaths = (uint32_t)cache->paths.size();
+}
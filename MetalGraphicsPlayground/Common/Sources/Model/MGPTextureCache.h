@@ -0,0 +1,78 @@
+//
+//  MGPTextureCache.h
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/17.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#ifndef MGPTextureCache_h
+#define MGPTextureCache_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Texture cache addressed by file content.
+// A texture is found by the canonical path first, then by the hash and size of
+// the file, so identical files under different names share a texture.
+// A path is trusted while its size and modification time don't change.
+// Textures are reference counted, the last release evicts the texture, so the
+// cache never keeps a texture nobody uses.
+// Variant tells textures of the same file apart (e.g. usage and storage mode).
+// Textures come from a backend, so the logic runs without a GPU.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    const char *path;           // canonical
+    uint64_t fileSize;
+    int64_t modificationTime;
+    uint32_t variant;
+} mgp_texture_cache_file_t;
+
+typedef struct {
+    // The last reference is released.
+    void (*evict)(void *context, void *texture);
+    void *context;
+} mgp_texture_cache_backend_t;
+
+typedef struct {
+    uint64_t pathHits;
+    uint64_t contentHits;       // identical file under another path
+    uint64_t misses;
+    uint64_t evictions;
+    uint64_t savedBytes;        // file bytes not loaded again by any hit
+    uint64_t dedupedBytes;      // of them, by content hits
+    size_t residentBytes;       // file bytes of cached textures
+    uint32_t numTextures;
+    uint32_t numPaths;
+} mgp_texture_cache_stats_t;
+
+typedef struct mgp_texture_cache mgp_texture_cache_t;
+
+mgp_texture_cache_t *mgp_texture_cache_create(const mgp_texture_cache_backend_t *backend);
+// Evicts every texture.
+void mgp_texture_cache_destroy(mgp_texture_cache_t *cache);
+
+// Each returns a texture with a new reference, or NULL if it isn't cached.
+void *mgp_texture_cache_acquire_path(mgp_texture_cache_t *cache, const mgp_texture_cache_file_t *file);
+// Also remembers the path for the found texture.
+void *mgp_texture_cache_acquire_content(mgp_texture_cache_t *cache, const mgp_texture_cache_file_t *file,
+                                        uint64_t contentHash);
+// Texture of a miss, with one reference.
+void mgp_texture_cache_insert(mgp_texture_cache_t *cache, const mgp_texture_cache_file_t *file,
+                              uint64_t contentHash, void *texture);
+// Returns 0 if the texture isn't cached.
+int mgp_texture_cache_release(mgp_texture_cache_t *cache, void *texture);
+
+// 64-bit hash of file contents.
+uint64_t mgp_texture_cache_hash(const void *data, size_t size);
+void mgp_texture_cache_get_stats(const mgp_texture_cache_t *cache, mgp_texture_cache_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MGPTextureCache_h */
@@ -0,0 +1,246 @@
+//
+//  MGPTexturePool.cpp
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/17.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#include "MGPTexturePool.h"
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+static const uint32_t kNone = UINT32_MAX;
+
+static bool operator==(const mgp_texture_pool_key_t &a, const mgp_texture_pool_key_t &b) {
+    return a.textureType == b.textureType && a.pixelFormat == b.pixelFormat &&
+           a.width == b.width && a.height == b.height && a.depth == b.depth &&
+           a.mipmapLevelCount == b.mipmapLevelCount && a.arrayLength == b.arrayLength &&
+           a.sampleCount == b.sampleCount && a.storageMode == b.storageMode && a.usage == b.usage;
+}
+
+struct KeyHash {
+    size_t operator()(const mgp_texture_pool_key_t &key) const {
+        return (size_t)mgp_texture_pool_hash_key(&key);
+    }
+};
+
+struct mgp_texture_pool {
+    struct Entry {
+        void *texture;
+        mgp_texture_pool_key_t key;
+        size_t bytes;
+        uint64_t lastUsedFrame;
+        uint32_t prev, next;        // unused list, least recently used first
+        bool used;
+    };
+
+    mgp_texture_pool_backend_t backend;
+    size_t budget;
+    uint32_t maxUnusedFrames;
+    uint64_t frame;
+
+    std::vector<Entry> entries;
+    std::vector<uint32_t> freeEntries;
+    uint32_t unusedHead, unusedTail;
+    std::unordered_map<mgp_texture_pool_key_t, std::vector<uint32_t>, KeyHash> unusedByKey;
+    std::unordered_map<void *, uint32_t> usedEntries;
+    std::unordered_map<uint32_t, size_t> bytesByFormat;
+    mgp_texture_pool_stats_t stats;
+};
+
+uint64_t mgp_texture_pool_hash_key(const mgp_texture_pool_key_t *key) {
+    const uint32_t fields[] = {
+        key->textureType, key->pixelFormat, key->width, key->height, key->depth,
+        key->mipmapLevelCount, key->arrayLength, key->sampleCount, key->storageMode, key->usage
+    };
+    // FNV-1a over the fields, then a finalizer so every bit affects the bucket
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for(uint32_t field : fields) {
+        hash ^= field;
+        hash *= 0x100000001b3ULL;
+    }
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+mgp_texture_pool_t *mgp_texture_pool_create(const mgp_texture_pool_backend_t *backend,
+                                            size_t budget, uint32_t maxUnusedFrames) {
+    mgp_texture_pool_t *pool = new mgp_texture_pool_t();
+    pool->backend = *backend;
+    pool->budget = budget;
+    pool->maxUnusedFrames = maxUnusedFrames;
+    pool->frame = 0;
+    pool->unusedHead = pool->unusedTail = kNone;
+    pool->stats = {};
+    return pool;
+}
+
+void mgp_texture_pool_destroy(mgp_texture_pool_t *pool) {
+    if(pool == NULL)
+        return;
+    for(auto &entry : pool->entries) {
+        if(entry.texture)
+            pool->backend.destroy_texture(pool->backend.context, entry.texture);
+    }
+    delete pool;
+}
+
+static void unlink_unused(mgp_texture_pool_t *pool, uint32_t index) {
+    auto &entry = pool->entries[index];
+    if(entry.prev != kNone)
+        pool->entries[entry.prev].next = entry.next;
+    else
+        pool->unusedHead = entry.next;
+    if(entry.next != kNone)
+        pool->entries[entry.next].prev = entry.prev;
+    else
+        pool->unusedTail = entry.prev;
+    entry.prev = entry.next = kNone;
+}
+
+static void evict(mgp_texture_pool_t *pool, uint32_t index) {
+    auto &entry = pool->entries[index];
+    unlink_unused(pool, index);
+
+    auto bucket = pool->unusedByKey.find(entry.key);
+    auto &indices = bucket->second;
+    indices.erase(std::find(indices.begin(), indices.end(), index));
+    if(indices.empty())
+        pool->unusedByKey.erase(bucket);
+
+    pool->backend.destroy_texture(pool->backend.context, entry.texture);
+    pool->bytesByFormat[entry.key.pixelFormat] -= entry.bytes;
+    pool->stats.residentBytes -= entry.bytes;
+    pool->stats.unusedBytes -= entry.bytes;
+    pool->stats.numResident--;
+    pool->stats.numUnused--;
+    pool->stats.evictions++;
+
+    entry.texture = NULL;
+    pool->freeEntries.push_back(index);
+}
+
+static void trim_to_budget(mgp_texture_pool_t *pool) {
+    if(pool->budget == 0)
+        return;
+    while(pool->stats.residentBytes > pool->budget && pool->unusedHead != kNone)
+        evict(pool, pool->unusedHead);
+}
+
+void mgp_texture_pool_set_budget(mgp_texture_pool_t *pool, size_t budget) {
+    pool->budget = budget;
+    trim_to_budget(pool);
+}
+
+void mgp_texture_pool_set_max_unused_frames(mgp_texture_pool_t *pool, uint32_t maxUnusedFrames) {
+    pool->maxUnusedFrames = maxUnusedFrames;
+}
+
+void mgp_texture_pool_begin_frame(mgp_texture_pool_t *pool) {
+    pool->frame++;
+    if(pool->maxUnusedFrames > 0) {
+        // released in frame order, so the oldest are at the head
+        while(pool->unusedHead != kNone &&
+              pool->frame - pool->entries[pool->unusedHead].lastUsedFrame > pool->maxUnusedFrames)
+            evict(pool, pool->unusedHead);
+    }
+    trim_to_budget(pool);
+}
+
+void *mgp_texture_pool_acquire(mgp_texture_pool_t *pool, const mgp_texture_pool_key_t *key) {
+    auto bucket = pool->unusedByKey.find(*key);
+    if(bucket != pool->unusedByKey.end()) {
+        // most recently released one
+        uint32_t index = bucket->second.back();
+        bucket->second.pop_back();
+        if(bucket->second.empty())
+            pool->unusedByKey.erase(bucket);
+        unlink_unused(pool, index);
+
+        auto &entry = pool->entries[index];
+        entry.used = true;
+        entry.lastUsedFrame = pool->frame;
+        pool->usedEntries[entry.texture] = index;
+        pool->stats.unusedBytes -= entry.bytes;
+        pool->stats.numUnused--;
+        pool->stats.hits++;
+        return entry.texture;
+    }
+
+    pool->stats.misses++;
+    size_t bytes = 0;
+    void *texture = pool->backend.create_texture(pool->backend.context, key, &bytes);
+    if(texture == NULL)
+        return NULL;
+
+    uint32_t index;
+    if(!pool->freeEntries.empty()) {
+        index = pool->freeEntries.back();
+        pool->freeEntries.pop_back();
+    }
+    else {
+        index = (uint32_t)pool->entries.size();
+        pool->entries.emplace_back();
+    }
+    auto &entry = pool->entries[index];
+    entry.texture = texture;
+    entry.key = *key;
+    entry.bytes = bytes;
+    entry.lastUsedFrame = pool->frame;
+    entry.prev = entry.next = kNone;
+    entry.used = true;
+    pool->usedEntries[texture] = index;
+    pool->bytesByFormat[key->pixelFormat] += bytes;
+    pool->stats.residentBytes += bytes;
+    pool->stats.numResident++;
+
+    // make room with unused ones, if any
+    trim_to_budget(pool);
+    return texture;
+}
+
+int mgp_texture_pool_release(mgp_texture_pool_t *pool, void *texture) {
+    auto used = pool->usedEntries.find(texture);
+    if(used == pool->usedEntries.end())
+        return 0;
+    uint32_t index = used->second;
+    pool->usedEntries.erase(used);
+
+    auto &entry = pool->entries[index];
+    entry.used = false;
+    entry.lastUsedFrame = pool->frame;
+    entry.prev = pool->unusedTail;
+    entry.next = kNone;
+    if(pool->unusedTail != kNone)
+        pool->entries[pool->unusedTail].next = index;
+    else
+        pool->unusedHead = index;
+    pool->unusedTail = index;
+    pool->unusedByKey[entry.key].push_back(index);
+    pool->stats.unusedBytes += entry.bytes;
+    pool->stats.numUnused++;
+
+    trim_to_budget(pool);
+    return 1;
+}
+
+void mgp_texture_pool_purge(mgp_texture_pool_t *pool) {
+    while(pool->unusedHead != kNone)
+        evict(pool, pool->unusedHead);
+}
+
+void mgp_texture_pool_get_stats(const mgp_texture_pool_t *pool, mgp_texture_pool_stats_t *stats) {
+    *stats = pool->stats;
+}
+
+size_t mgp_texture_pool_resident_bytes_of_format(const mgp_texture_pool_t *pool, uint32_t pixelFormat) {
+    auto bytes = pool->bytesByFormat.find(pixelFormat);
+    return bytes != pool->bytesByFormat.end() ? bytes->second : 0;
+}
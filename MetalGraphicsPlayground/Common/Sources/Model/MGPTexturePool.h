@@ -0,0 +1,86 @@
+//
+//  MGPTexturePool.h
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/17.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#ifndef MGPTexturePool_h
+#define MGPTexturePool_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Pool of temporary textures, reused by descriptor.
+// Released textures stay resident until
+//  - they haven't been used for maxUnusedFrames frames, or
+//  - resident bytes exceed the budget, then the least recently used go first.
+// Textures in use are never evicted, so the budget can be exceeded while
+// they're held. Descriptors are compared field by field, the 64-bit hash
+// only picks the bucket.
+// Textures come from a backend, so the logic runs without a GPU.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    uint32_t textureType;
+    uint32_t pixelFormat;
+    uint32_t width;
+    uint32_t height;
+    uint32_t depth;
+    uint32_t mipmapLevelCount;
+    uint32_t arrayLength;
+    uint32_t sampleCount;
+    uint32_t storageMode;
+    uint32_t usage;
+} mgp_texture_pool_key_t;
+
+typedef struct {
+    // Returns an opaque texture and its allocated size, or NULL.
+    void *(*create_texture)(void *context, const mgp_texture_pool_key_t *key, size_t *bytes);
+    void (*destroy_texture)(void *context, void *texture);
+    void *context;
+} mgp_texture_pool_backend_t;
+
+typedef struct {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+    size_t residentBytes;       // textures in use and unused
+    size_t unusedBytes;
+    uint32_t numResident;
+    uint32_t numUnused;
+} mgp_texture_pool_stats_t;
+
+typedef struct mgp_texture_pool mgp_texture_pool_t;
+
+// budget : bytes, 0 is unlimited.
+mgp_texture_pool_t *mgp_texture_pool_create(const mgp_texture_pool_backend_t *backend,
+                                            size_t budget, uint32_t maxUnusedFrames);
+void mgp_texture_pool_destroy(mgp_texture_pool_t *pool);
+
+void mgp_texture_pool_set_budget(mgp_texture_pool_t *pool, size_t budget);
+void mgp_texture_pool_set_max_unused_frames(mgp_texture_pool_t *pool, uint32_t maxUnusedFrames);
+
+// Advances the frame, evicts unused textures which are too old or over the budget.
+void mgp_texture_pool_begin_frame(mgp_texture_pool_t *pool);
+
+// Returns an unused texture of the key or a new one, NULL if the backend fails.
+void *mgp_texture_pool_acquire(mgp_texture_pool_t *pool, const mgp_texture_pool_key_t *key);
+// Returns 0 if the texture isn't in use from this pool.
+int mgp_texture_pool_release(mgp_texture_pool_t *pool, void *texture);
+// Destroys every unused texture.
+void mgp_texture_pool_purge(mgp_texture_pool_t *pool);
+
+uint64_t mgp_texture_pool_hash_key(const mgp_texture_pool_key_t *key);
+void mgp_texture_pool_get_stats(const mgp_texture_pool_t *pool, mgp_texture_pool_stats_t *stats);
+size_t mgp_texture_pool_resident_bytes_of_format(const mgp_texture_pool_t *pool, uint32_t pixelFormat);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MGPTexturePool_h */
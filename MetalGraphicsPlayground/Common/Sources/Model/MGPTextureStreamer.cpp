@@ -0,0 +1,120 @@
+//
+//  MGPTextureStreamer.cpp
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/17.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#include "MGPTextureStreamer.h"
+#include "MGPWorkerPool.h"
+
+#include <atomic>
+#include <deque>
+#include <vector>
+
+struct mgp_texture_streamer {
+    mgp_texture_streamer(const mgp_texture_streamer_backend_t &backend, uint32_t numThreads, uint32_t maxBatchSize)
+        : backend(backend), maxBatchSize(maxBatchSize), pool(numThreads) {
+        thread = std::thread(&mgp_texture_streamer::streamingMain, this);
+    }
+
+    void streamingMain();
+
+    mgp_texture_streamer_backend_t backend;
+    uint32_t maxBatchSize;
+    mgp::WorkerPool pool;
+    std::thread thread;
+
+    std::mutex mutex;
+    std::condition_variable requestCondition;
+    std::condition_variable idleCondition;
+    std::deque<void *> pending;
+    uint64_t numInFlight = 0;       // taken by the streaming thread, not uploaded yet
+    bool stop = false;
+    mgp_texture_streamer_stats_t stats = {};
+};
+
+void mgp_texture_streamer::streamingMain() {
+    std::vector<void *> requests;
+    std::vector<void *> images;
+    while(true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            requestCondition.wait(lock, [this] { return stop || !pending.empty(); });
+            if(pending.empty())
+                return;
+
+            // everything waiting so far goes into one batch
+            size_t count = pending.size();
+            if(maxBatchSize > 0)
+                count = std::min(count, (size_t)maxBatchSize);
+            requests.assign(pending.begin(), pending.begin() + count);
+            pending.erase(pending.begin(), pending.begin() + count);
+            numInFlight += count;
+        }
+
+        images.assign(requests.size(), nullptr);
+        std::atomic<size_t> next(0);
+        pool.run([&](uint32_t) {
+            size_t index;
+            while((index = next.fetch_add(1)) < requests.size())
+                images[index] = backend.decode(backend.context, requests[index]);
+        });
+
+        size_t numFailed = 0;
+        for(void *image : images)
+            numFailed += image == nullptr;
+        backend.upload(backend.context, requests.data(), images.data(), requests.size());
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            numInFlight -= requests.size();
+            stats.numDecoded += requests.size();
+            stats.numFailed += numFailed;
+            stats.numBatches++;
+        }
+        idleCondition.notify_all();
+    }
+}
+
+mgp_texture_streamer_t *mgp_texture_streamer_create(const mgp_texture_streamer_backend_t *backend,
+                                                    uint32_t numThreads, uint32_t maxBatchSize) {
+    if(numThreads == 0)
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
+    return new mgp_texture_streamer_t(*backend, numThreads, maxBatchSize);
+}
+
+void mgp_texture_streamer_destroy(mgp_texture_streamer_t *streamer) {
+    if(streamer == nullptr)
+        return;
+    {
+        // the streaming thread drains the pending requests before it exits
+        std::lock_guard<std::mutex> lock(streamer->mutex);
+        streamer->stop = true;
+    }
+    streamer->requestCondition.notify_one();
+    streamer->thread.join();
+    delete streamer;
+}
+
+void mgp_texture_streamer_enqueue(mgp_texture_streamer_t *streamer, void *request) {
+    {
+        std::lock_guard<std::mutex> lock(streamer->mutex);
+        streamer->pending.push_back(request);
+        streamer->stats.numRequests++;
+    }
+    streamer->requestCondition.notify_one();
+}
+
+void mgp_texture_streamer_wait_idle(mgp_texture_streamer_t *streamer) {
+    std::unique_lock<std::mutex> lock(streamer->mutex);
+    streamer->idleCondition.wait(lock, [streamer] {
+        return streamer->pending.empty() && streamer->numInFlight == 0;
+    });
+}
+
+void mgp_texture_streamer_get_stats(mgp_texture_streamer_t *streamer, mgp_texture_streamer_stats_t *stats) {
+    std::lock_guard<std::mutex> lock(streamer->mutex);
+    *stats = streamer->stats;
+}
@@ -0,0 +1,59 @@
+//
+//  MGPTextureStreamer.h
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/17.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#ifndef MGPTextureStreamer_h
+#define MGPTextureStreamer_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Background texture streaming.
+// Requests are taken in batches by a streaming thread. Each batch is decoded
+// in parallel on a worker pool, then uploaded at once by the backend, so a
+// batch can be recorded into a single command buffer.
+// Reading, decoding and uploading are up to the backend, so the pipeline
+// runs without a GPU.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    // Worker threads. Reads and decodes the request, returns an opaque image or NULL.
+    void *(*decode)(void *context, void *request);
+    // Streaming thread. Uploads a batch, images may be NULL if decoding failed.
+    void (*upload)(void *context, void *const *requests, void *const *images, size_t count);
+    void *context;
+} mgp_texture_streamer_backend_t;
+
+typedef struct {
+    uint64_t numRequests;       // enqueued so far
+    uint64_t numDecoded;        // including failures
+    uint64_t numFailed;
+    uint64_t numBatches;
+} mgp_texture_streamer_stats_t;
+
+typedef struct mgp_texture_streamer mgp_texture_streamer_t;
+
+// numThreads : decoding threads, 0 picks the hardware concurrency. maxBatchSize : 0 is unlimited.
+mgp_texture_streamer_t *mgp_texture_streamer_create(const mgp_texture_streamer_backend_t *backend,
+                                                    uint32_t numThreads, uint32_t maxBatchSize);
+// Waits for the enqueued requests.
+void mgp_texture_streamer_destroy(mgp_texture_streamer_t *streamer);
+
+void mgp_texture_streamer_enqueue(mgp_texture_streamer_t *streamer, void *request);
+// Blocks until every enqueued request is uploaded.
+void mgp_texture_streamer_wait_idle(mgp_texture_streamer_t *streamer);
+
+void mgp_texture_streamer_get_stats(mgp_texture_streamer_t *streamer, mgp_texture_streamer_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MGPTextureStreamer_h */
@@ -0,0 +1,384 @@
+//
+//  MGPTransformSystem.cpp
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/17.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#include "MGPTransformSystem.h"
+#include "MGPWorkerPool.h"
+
+#include <string.h>
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+// levels smaller than this are updated on the calling thread only
+const uint32_t kMinParallelCount = 4096;
+
+const float kIdentity3x3[9] = { 1, 0, 0, 0, 1, 0, 0, 0, 1 };
+
+struct Local {
+    float position[3];
+    float rotation[9];
+    float scale[3];
+};
+
+struct alignas(16) World {
+    float matrix[16];
+    float rotation[9];
+    uint32_t version;
+    uint32_t parentVersion;     // version of the parent when this was calculated
+    uint32_t dirty;             // local transform or parent changed
+};
+
+inline void makeLocalMatrix(const Local &local, float out[16]) {
+    for(int col = 0; col < 3; col++) {
+        for(int row = 0; row < 3; row++)
+            out[col * 4 + row] = local.rotation[col * 3 + row] * local.scale[col];
+        out[col * 4 + 3] = 0.0f;
+    }
+    out[12] = local.position[0];
+    out[13] = local.position[1];
+    out[14] = local.position[2];
+    out[15] = 1.0f;
+}
+
+// a * b, both affine (last row is 0 0 0 1)
+inline void multiplyAffine(const float a[16], const float b[16], float out[16]) {
+    for(int col = 0; col < 4; col++) {
+        float x = b[col * 4], y = b[col * 4 + 1], z = b[col * 4 + 2];
+        float w = col == 3 ? 1.0f : 0.0f;
+        for(int row = 0; row < 4; row++)
+            out[col * 4 + row] = a[row] * x + a[4 + row] * y + a[8 + row] * z + a[12 + row] * w;
+    }
+}
+
+inline void multiply3x3(const float a[9], const float b[9], float out[9]) {
+    for(int col = 0; col < 3; col++) {
+        float x = b[col * 3], y = b[col * 3 + 1], z = b[col * 3 + 2];
+        for(int row = 0; row < 3; row++)
+            out[col * 3 + row] = a[row] * x + a[3 + row] * y + a[6 + row] * z;
+    }
+}
+
+inline void calculateWorld(const Local &local, const World *parent, World &world) {
+    if(parent) {
+        float localMatrix[16];
+        makeLocalMatrix(local, localMatrix);
+        multiplyAffine(parent->matrix, localMatrix, world.matrix);
+        multiply3x3(parent->rotation, local.rotation, world.rotation);
+        world.parentVersion = parent->version;
+    }
+    else {
+        makeLocalMatrix(local, world.matrix);
+        memcpy(world.rotation, local.rotation, sizeof(world.rotation));
+        world.parentVersion = 0;
+    }
+    world.version++;
+    world.dirty = 0;
+}
+
+} // namespace
+
+struct mgp_transform_system {
+    mgp::WorkerPool pool;
+
+    // by handle
+    std::vector<uint32_t> slots;            // dense index, MGP_TRANSFORM_NONE if free
+    std::vector<uint32_t> childCounts;
+    std::vector<uint32_t> freeHandles;
+
+    // dense, sorted by level unless orderDirty
+    std::vector<uint32_t> handles;
+    std::vector<uint32_t> parentHandles;
+    std::vector<uint32_t> parentIndices;    // valid unless orderDirty
+    std::vector<Local> locals;
+    std::vector<World> worlds;
+    std::vector<uint32_t> levelStarts;      // valid unless orderDirty
+
+    bool orderDirty = false;
+    bool changed = false;                   // anything to resolve since the last update
+
+    std::vector<uint32_t> chain;            // scratch for resolve
+
+    explicit mgp_transform_system(uint32_t numThreads) : pool(numThreads) {}
+
+    void sortByLevel();
+    void updateRange(uint32_t first, uint32_t last);
+    void resolve(uint32_t index);
+};
+
+void mgp_transform_system::sortByLevel() {
+    const uint32_t count = (uint32_t)handles.size();
+
+    // children of each transform (CSR)
+    std::vector<uint32_t> childStarts(count + 1, 0), children(count);
+    for(uint32_t i = 0; i < count; i++) {
+        if(parentHandles[i] != MGP_TRANSFORM_NONE)
+            childStarts[slots[parentHandles[i]] + 1]++;
+    }
+    for(uint32_t i = 0; i < count; i++)
+        childStarts[i + 1] += childStarts[i];
+    std::vector<uint32_t> cursors(childStarts.begin(), childStarts.end() - 1);
+    for(uint32_t i = 0; i < count; i++) {
+        if(parentHandles[i] != MGP_TRANSFORM_NONE)
+            children[cursors[slots[parentHandles[i]]]++] = i;
+    }
+
+    // breadth-first from all roots : levels are contiguous, siblings are adjacent
+    // and parents are visited in increasing order
+    std::vector<uint32_t> order;
+    order.reserve(count);
+    for(uint32_t i = 0; i < count; i++) {
+        if(parentHandles[i] == MGP_TRANSFORM_NONE)
+            order.push_back(i);
+    }
+    levelStarts.assign(1, 0);
+    for(size_t levelFirst = 0; levelFirst < order.size();) {
+        size_t levelLast = order.size();
+        levelStarts.push_back((uint32_t)levelLast);
+        for(size_t i = levelFirst; i < levelLast; i++) {
+            uint32_t index = order[i];
+            order.insert(order.end(), children.begin() + childStarts[index], children.begin() + childStarts[index + 1]);
+        }
+        levelFirst = levelLast;
+    }
+
+    std::vector<uint32_t> sortedHandles(count), sortedParentHandles(count);
+    std::vector<Local> sortedLocals(count);
+    std::vector<World> sortedWorlds(count);
+    for(uint32_t i = 0; i < count; i++) {
+        uint32_t from = order[i];
+        sortedHandles[i] = handles[from];
+        sortedParentHandles[i] = parentHandles[from];
+        sortedLocals[i] = locals[from];
+        sortedWorlds[i] = worlds[from];
+        slots[handles[from]] = i;
+    }
+    handles.swap(sortedHandles);
+    parentHandles.swap(sortedParentHandles);
+    locals.swap(sortedLocals);
+    worlds.swap(sortedWorlds);
+
+    parentIndices.resize(count);
+    for(uint32_t i = 0; i < count; i++) {
+        uint32_t parent = parentHandles[i];
+        parentIndices[i] = parent == MGP_TRANSFORM_NONE ? MGP_TRANSFORM_NONE : slots[parent];
+    }
+    orderDirty = false;
+}
+
+void mgp_transform_system::updateRange(uint32_t first, uint32_t last) {
+    const uint32_t *parents = parentIndices.data();
+    const Local *localData = locals.data();
+    World *worldData = worlds.data();
+    for(uint32_t i = first; i < last; i++) {
+        World &world = worldData[i];
+        uint32_t parent = parents[i];
+        if(parent == MGP_TRANSFORM_NONE) {
+            if(world.dirty)
+                calculateWorld(localData[i], nullptr, world);
+        }
+        else {
+            const World &parentWorld = worldData[parent];
+            if(world.dirty || world.parentVersion != parentWorld.version)
+                calculateWorld(localData[i], &parentWorld, world);
+        }
+    }
+}
+
+void mgp_transform_system::resolve(uint32_t index) {
+    if(!changed)
+        return;
+
+    // ancestors first
+    chain.clear();
+    while(index != MGP_TRANSFORM_NONE) {
+        chain.push_back(index);
+        uint32_t parent = parentHandles[index];
+        index = parent == MGP_TRANSFORM_NONE ? MGP_TRANSFORM_NONE : slots[parent];
+    }
+    const World *parentWorld = nullptr;
+    for(size_t j = chain.size(); j-- > 0;) {
+        World &world = worlds[chain[j]];
+        if(world.dirty || (parentWorld && world.parentVersion != parentWorld->version))
+            calculateWorld(locals[chain[j]], parentWorld, world);
+        parentWorld = &world;
+    }
+}
+
+mgp_transform_system_t *mgp_transform_system_create(uint32_t numThreads) {
+    return new mgp_transform_system(numThreads);
+}
+
+void mgp_transform_system_destroy(mgp_transform_system_t *system) {
+    delete system;
+}
+
+void mgp_transform_system_update(mgp_transform_system_t *system) {
+    if(!system->changed)
+        return;
+    if(system->orderDirty)
+        system->sortByLevel();
+
+    // parents are complete before the next level starts
+    mgp::WorkerPool &pool = system->pool;
+    for(size_t level = 0; level + 1 < system->levelStarts.size(); level++) {
+        uint32_t first = system->levelStarts[level];
+        uint32_t last = system->levelStarts[level + 1];
+        if(pool.numThreads() == 1 || last - first < kMinParallelCount) {
+            system->updateRange(first, last);
+            continue;
+        }
+        pool.run([system, &pool, first, last](uint32_t worker) {
+            uint32_t count = last - first;
+            uint32_t begin = first + (uint32_t)((uint64_t)count * worker / pool.numThreads());
+            uint32_t end = first + (uint32_t)((uint64_t)count * (worker + 1) / pool.numThreads());
+            system->updateRange(begin, end);
+        });
+    }
+    system->changed = false;
+}
+
+size_t mgp_transform_system_count(const mgp_transform_system_t *system) {
+    return system->handles.size();
+}
+
+mgp_transform_t mgp_transform_create(mgp_transform_system_t *system) {
+    mgp_transform_t handle;
+    if(!system->freeHandles.empty()) {
+        handle = system->freeHandles.back();
+        system->freeHandles.pop_back();
+    }
+    else {
+        handle = (mgp_transform_t)system->slots.size();
+        system->slots.push_back(MGP_TRANSFORM_NONE);
+        system->childCounts.push_back(0);
+    }
+    system->slots[handle] = (uint32_t)system->handles.size();
+    system->childCounts[handle] = 0;
+
+    Local local;
+    memset(local.position, 0, sizeof(local.position));
+    memcpy(local.rotation, kIdentity3x3, sizeof(local.rotation));
+    local.scale[0] = local.scale[1] = local.scale[2] = 1.0f;
+    World world;
+    memset(&world, 0, sizeof(World));
+    world.dirty = 1;
+
+    system->handles.push_back(handle);
+    system->parentHandles.push_back(MGP_TRANSFORM_NONE);
+    system->locals.push_back(local);
+    system->worlds.push_back(world);
+    system->orderDirty = true;
+    system->changed = true;
+    return handle;
+}
+
+void mgp_transform_destroy(mgp_transform_system_t *system, mgp_transform_t transform) {
+    uint32_t index = system->slots[transform];
+
+    if(system->childCounts[transform] > 0) {
+        for(size_t i = 0; i < system->handles.size(); i++) {
+            if(system->parentHandles[i] == transform) {
+                system->parentHandles[i] = MGP_TRANSFORM_NONE;
+                system->worlds[i].dirty = 1;
+            }
+        }
+    }
+    uint32_t parent = system->parentHandles[index];
+    if(parent != MGP_TRANSFORM_NONE)
+        system->childCounts[parent]--;
+
+    // move the last one into the hole
+    uint32_t last = (uint32_t)system->handles.size() - 1;
+    if(index != last) {
+        system->handles[index] = system->handles[last];
+        system->parentHandles[index] = system->parentHandles[last];
+        system->locals[index] = system->locals[last];
+        system->worlds[index] = system->worlds[last];
+        system->slots[system->handles[index]] = index;
+    }
+    system->handles.pop_back();
+    system->parentHandles.pop_back();
+    system->locals.pop_back();
+    system->worlds.pop_back();
+
+    system->slots[transform] = MGP_TRANSFORM_NONE;
+    system->freeHandles.push_back(transform);
+    system->orderDirty = true;
+    system->changed = true;
+}
+
+int mgp_transform_set_parent(mgp_transform_system_t *system, mgp_transform_t transform, mgp_transform_t parent) {
+    uint32_t index = system->slots[transform];
+    uint32_t oldParent = system->parentHandles[index];
+    if(oldParent == parent)
+        return 1;
+
+    for(mgp_transform_t ancestor = parent; ancestor != MGP_TRANSFORM_NONE;
+        ancestor = system->parentHandles[system->slots[ancestor]]) {
+        if(ancestor == transform)
+            return 0;
+    }
+
+    if(oldParent != MGP_TRANSFORM_NONE)
+        system->childCounts[oldParent]--;
+    if(parent != MGP_TRANSFORM_NONE)
+        system->childCounts[parent]++;
+    system->parentHandles[index] = parent;
+    system->worlds[index].dirty = 1;
+    system->orderDirty = true;
+    system->changed = true;
+    return 1;
+}
+
+mgp_transform_t mgp_transform_parent(const mgp_transform_system_t *system, mgp_transform_t transform) {
+    return system->parentHandles[system->slots[transform]];
+}
+
+void mgp_transform_set_local(mgp_transform_system_t *system, mgp_transform_t transform,
+                             const float position[3], const float rotation[9], const float scale[3]) {
+    uint32_t index = system->slots[transform];
+    Local &local = system->locals[index];
+    if(position)
+        memcpy(local.position, position, sizeof(local.position));
+    if(rotation)
+        memcpy(local.rotation, rotation, sizeof(local.rotation));
+    if(scale)
+        memcpy(local.scale, scale, sizeof(local.scale));
+    system->worlds[index].dirty = 1;
+    system->changed = true;
+}
+
+void mgp_transform_get_local(const mgp_transform_system_t *system, mgp_transform_t transform,
+                             float position[3], float rotation[9], float scale[3]) {
+    const Local &local = system->locals[system->slots[transform]];
+    if(position)
+        memcpy(position, local.position, sizeof(local.position));
+    if(rotation)
+        memcpy(rotation, local.rotation, sizeof(local.rotation));
+    if(scale)
+        memcpy(scale, local.scale, sizeof(local.scale));
+}
+
+const float *mgp_transform_world_matrix(mgp_transform_system_t *system, mgp_transform_t transform) {
+    uint32_t index = system->slots[transform];
+    system->resolve(index);
+    return system->worlds[index].matrix;
+}
+
+const float *mgp_transform_world_rotation(mgp_transform_system_t *system, mgp_transform_t transform) {
+    uint32_t index = system->slots[transform];
+    system->resolve(index);
+    return system->worlds[index].rotation;
+}
+
+uint32_t mgp_transform_version(mgp_transform_system_t *system, mgp_transform_t transform) {
+    uint32_t index = system->slots[transform];
+    system->resolve(index);
+    return system->worlds[index].version;
+}
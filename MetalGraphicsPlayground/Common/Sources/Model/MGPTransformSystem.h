@@ -0,0 +1,65 @@
+//
+//  MGPTransformSystem.h
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/17.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#ifndef MGPTransformSystem_h
+#define MGPTransformSystem_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Transform hierarchy stored in contiguous arrays.
+// Transforms are referenced by stable handles, while their data is kept sorted
+// by hierarchy level so parents always come before their children.
+// World matrices are updated by one linear pass, each level split across threads.
+// Matrices are column-major. (float[16] : 4x4, float[9] : 3x3)
+
+#define MGP_TRANSFORM_NONE UINT32_MAX
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct mgp_transform_system mgp_transform_system_t;
+typedef uint32_t mgp_transform_t;
+
+mgp_transform_system_t *mgp_transform_system_create(uint32_t numThreads);
+void mgp_transform_system_destroy(mgp_transform_system_t *system);
+
+// Resolves world matrices of every changed transform, level by level.
+void mgp_transform_system_update(mgp_transform_system_t *system);
+size_t mgp_transform_system_count(const mgp_transform_system_t *system);
+
+// Creates a root transform with identity local transform.
+mgp_transform_t mgp_transform_create(mgp_transform_system_t *system);
+// Children of a destroyed transform become roots.
+void mgp_transform_destroy(mgp_transform_system_t *system, mgp_transform_t transform);
+
+// parent : MGP_TRANSFORM_NONE for root
+// Returns 0 without changing anything if parent is the transform itself or one of its descendants.
+int mgp_transform_set_parent(mgp_transform_system_t *system, mgp_transform_t transform, mgp_transform_t parent);
+mgp_transform_t mgp_transform_parent(const mgp_transform_system_t *system, mgp_transform_t transform);
+
+// Local transform : translation, rotation (orthonormal 3x3) then scale.
+// Any of them can be NULL to keep (or skip) it.
+void mgp_transform_set_local(mgp_transform_system_t *system, mgp_transform_t transform,
+                             const float position[3], const float rotation[9], const float scale[3]);
+void mgp_transform_get_local(const mgp_transform_system_t *system, mgp_transform_t transform,
+                             float position[3], float rotation[9], float scale[3]);
+
+// World matrices, resolved on read if the transform or its ancestors changed.
+// Pointers are valid until the system changes.
+const float *mgp_transform_world_matrix(mgp_transform_system_t *system, mgp_transform_t transform);
+const float *mgp_transform_world_rotation(mgp_transform_system_t *system, mgp_transform_t transform);
+// Increased whenever the world matrices of the transform are recalculated.
+uint32_t mgp_transform_version(mgp_transform_system_t *system, mgp_transform_t transform);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MGPTransformSystem_h */
@@ -0,0 +1,388 @@
+//
+//  MGPVertexQuantizer.cpp
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/17.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#include "MGPVertexQuantizer.h"
+
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include <algorithm>
+
+// MGP_QUANTIZE_SCALAR forces the scalar lanes, which encode the same bits.
+#if defined(MGP_QUANTIZE_SCALAR)
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define MGP_QUANTIZE_SSE 1
+#if defined(__F16C__)
+#include <immintrin.h>
+#define MGP_QUANTIZE_F16C 1
+#endif
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define MGP_QUANTIZE_NEON 1
+#endif
+
+namespace {
+
+const float kPi = 3.14159265358979f;
+
+// 4 lanes, only what the encoder needs
+#if MGP_QUANTIZE_SSE
+struct F4 { __m128 v; };
+inline F4 load(const float *p) { return { _mm_loadu_ps(p) }; }
+inline void store(F4 a, float *p) { _mm_storeu_ps(p, a.v); }
+inline F4 splat(float f) { return { _mm_set1_ps(f) }; }
+inline F4 operator+(F4 a, F4 b) { return { _mm_add_ps(a.v, b.v) }; }
+inline F4 operator-(F4 a, F4 b) { return { _mm_sub_ps(a.v, b.v) }; }
+inline F4 operator*(F4 a, F4 b) { return { _mm_mul_ps(a.v, b.v) }; }
+inline F4 operator/(F4 a, F4 b) { return { _mm_div_ps(a.v, b.v) }; }
+inline F4 min(F4 a, F4 b) { return { _mm_min_ps(a.v, b.v) }; }
+inline F4 max(F4 a, F4 b) { return { _mm_max_ps(a.v, b.v) }; }
+inline F4 sqrt(F4 a) { return { _mm_sqrt_ps(a.v) }; }
+inline F4 abs(F4 a) { return { _mm_andnot_ps(_mm_set1_ps(-0.0f), a.v) }; }
+inline F4 greaterEqual(F4 a, F4 b) { return { _mm_cmpge_ps(a.v, b.v) }; }
+inline F4 greater(F4 a, F4 b) { return { _mm_cmpgt_ps(a.v, b.v) }; }
+inline F4 select(F4 mask, F4 a, F4 b) { return { _mm_or_ps(_mm_and_ps(mask.v, a.v), _mm_andnot_ps(mask.v, b.v)) }; }
+// magnitude of a, sign of b
+inline F4 copySign(F4 a, F4 b) {
+    __m128 signMask = _mm_set1_ps(-0.0f);
+    return { _mm_or_ps(_mm_andnot_ps(signMask, a.v), _mm_and_ps(signMask, b.v)) };
+}
+// to nearest
+inline void round(F4 a, int32_t *p) { _mm_storeu_si128((__m128i *)p, _mm_cvtps_epi32(a.v)); }
+#elif MGP_QUANTIZE_NEON
+struct F4 { float32x4_t v; };
+inline F4 load(const float *p) { return { vld1q_f32(p) }; }
+inline void store(F4 a, float *p) { vst1q_f32(p, a.v); }
+inline F4 splat(float f) { return { vdupq_n_f32(f) }; }
+inline F4 operator+(F4 a, F4 b) { return { vaddq_f32(a.v, b.v) }; }
+inline F4 operator-(F4 a, F4 b) { return { vsubq_f32(a.v, b.v) }; }
+inline F4 operator*(F4 a, F4 b) { return { vmulq_f32(a.v, b.v) }; }
+inline F4 operator/(F4 a, F4 b) { return { vdivq_f32(a.v, b.v) }; }
+inline F4 min(F4 a, F4 b) { return { vminq_f32(a.v, b.v) }; }
+inline F4 max(F4 a, F4 b) { return { vmaxq_f32(a.v, b.v) }; }
+inline F4 sqrt(F4 a) { return { vsqrtq_f32(a.v) }; }
+inline F4 abs(F4 a) { return { vabsq_f32(a.v) }; }
+inline F4 greaterEqual(F4 a, F4 b) { return { vreinterpretq_f32_u32(vcgeq_f32(a.v, b.v)) }; }
+inline F4 greater(F4 a, F4 b) { return { vreinterpretq_f32_u32(vcgtq_f32(a.v, b.v)) }; }
+inline F4 select(F4 mask, F4 a, F4 b) { return { vbslq_f32(vreinterpretq_u32_f32(mask.v), a.v, b.v) }; }
+inline F4 copySign(F4 a, F4 b) {
+    uint32x4_t signMask = vdupq_n_u32(0x80000000u);
+    return { vbslq_f32(signMask, b.v, a.v) };
+}
+inline void round(F4 a, int32_t *p) { vst1q_s32(p, vcvtnq_s32_f32(a.v)); }
+#else
+struct F4 { float v[4]; };
+#define MGP_QUANTIZE_LANES(expr) F4 r; for(int i = 0; i < 4; i++) r.v[i] = (expr); return r
+inline F4 load(const float *p) { F4 r; memcpy(r.v, p, sizeof(r.v)); return r; }
+inline void store(F4 a, float *p) { memcpy(p, a.v, sizeof(a.v)); }
+inline F4 splat(float f) { MGP_QUANTIZE_LANES(f); }
+inline F4 operator+(F4 a, F4 b) { MGP_QUANTIZE_LANES(a.v[i] + b.v[i]); }
+inline F4 operator-(F4 a, F4 b) { MGP_QUANTIZE_LANES(a.v[i] - b.v[i]); }
+inline F4 operator*(F4 a, F4 b) { MGP_QUANTIZE_LANES(a.v[i] * b.v[i]); }
+inline F4 operator/(F4 a, F4 b) { MGP_QUANTIZE_LANES(a.v[i] / b.v[i]); }
+inline F4 min(F4 a, F4 b) { MGP_QUANTIZE_LANES(std::min(a.v[i], b.v[i])); }
+inline F4 max(F4 a, F4 b) { MGP_QUANTIZE_LANES(std::max(a.v[i], b.v[i])); }
+inline F4 sqrt(F4 a) { MGP_QUANTIZE_LANES(sqrtf(a.v[i])); }
+inline F4 abs(F4 a) { MGP_QUANTIZE_LANES(fabsf(a.v[i])); }
+// masks are 1 or 0
+inline F4 greaterEqual(F4 a, F4 b) { MGP_QUANTIZE_LANES(a.v[i] >= b.v[i] ? 1.0f : 0.0f); }
+inline F4 greater(F4 a, F4 b) { MGP_QUANTIZE_LANES(a.v[i] > b.v[i] ? 1.0f : 0.0f); }
+inline F4 select(F4 mask, F4 a, F4 b) { MGP_QUANTIZE_LANES(mask.v[i] != 0.0f ? a.v[i] : b.v[i]); }
+inline F4 copySign(F4 a, F4 b) { MGP_QUANTIZE_LANES(copysignf(a.v[i], b.v[i])); }
+inline void round(F4 a, int32_t *p) { for(int i = 0; i < 4; i++) p[i] = (int32_t)lrintf(a.v[i]); }
+#undef MGP_QUANTIZE_LANES
+#endif
+
+inline F4 clamp(F4 a, float lower, float upper) {
+    return min(max(a, splat(lower)), splat(upper));
+}
+
+// ±1, +1 for zero
+inline F4 signNotZero(F4 a) {
+    return select(greaterEqual(a, splat(0.0f)), splat(1.0f), splat(-1.0f));
+}
+
+// Max error about 1e-5 rad, below a step of the 16-bit angle (1e-4 rad).
+inline F4 atan2(F4 y, F4 x) {
+    F4 ax = abs(x), ay = abs(y);
+    F4 a = min(ax, ay) / max(max(ax, ay), splat(FLT_MIN));
+    F4 s = a * a;
+    F4 r = splat(-0.0117212f);
+    r = r * s + splat(0.05265332f);
+    r = r * s + splat(-0.11643287f);
+    r = r * s + splat(0.19354346f);
+    r = r * s + splat(-0.33262347f);
+    r = r * s + splat(0.99997723f);
+    r = r * a;
+    r = select(greater(ay, ax), splat(kPi * 0.5f) - r, r);
+    r = select(greater(splat(0.0f), x), splat(kPi) - r, r);
+    return copySign(r, y);
+}
+
+// Tangent basis of a normal (Duff et al., Building an Orthonormal Basis, Revisited).
+// Same as tangent_decode in the shader.
+inline void basis4(F4 nx, F4 ny, F4 nz, F4 *t, F4 *b) {
+    F4 s = signNotZero(nz);
+    F4 a = splat(-1.0f) / (s + nz);
+    F4 c = nx * ny * a;
+    t[0] = splat(1.0f) + s * nx * nx * a;
+    t[1] = s * c;
+    t[2] = splat(0.0f) - s * nx;
+    b[0] = c;
+    b[1] = s + ny * ny * a;
+    b[2] = splat(0.0f) - ny;
+}
+
+inline void basis1(float nx, float ny, float nz, float *t, float *b) {
+    float s = nz >= 0.0f ? 1.0f : -1.0f;
+    float a = -1.0f / (s + nz);
+    float c = nx * ny * a;
+    t[0] = 1.0f + s * nx * nx * a;
+    t[1] = s * c;
+    t[2] = -s * nx;
+    b[0] = c;
+    b[1] = s + ny * ny * a;
+    b[2] = -ny;
+}
+
+// Fabian Giesen's float/half conversions, to nearest even
+#if !MGP_QUANTIZE_F16C && !MGP_QUANTIZE_NEON
+uint16_t floatToHalf(float value) {
+    const uint32_t infinity = 255u << 23;
+    const uint32_t halfMax = (127u + 16u) << 23;
+    const uint32_t denormMagic = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+    uint32_t u;
+    memcpy(&u, &value, sizeof(u));
+    uint32_t sign = u & 0x80000000u;
+    u ^= sign;
+    uint16_t half;
+    if(u >= halfMax)
+        half = u > infinity ? 0x7e00 : 0x7c00;
+    else if(u < (113u << 23)) {
+        float f, magic;
+        memcpy(&f, &u, sizeof(f));
+        memcpy(&magic, &denormMagic, sizeof(magic));
+        f += magic;
+        memcpy(&u, &f, sizeof(u));
+        half = (uint16_t)(u - denormMagic);
+    }
+    else {
+        uint32_t odd = (u >> 13) & 1;
+        u += ((uint32_t)(15 - 127) << 23) + 0xfff;
+        u += odd;
+        half = (uint16_t)(u >> 13);
+    }
+    return half | (uint16_t)(sign >> 16);
+}
+#endif
+
+float halfToFloat(uint16_t half) {
+    const uint32_t shiftedExponent = 0x7c00u << 13;
+    uint32_t u = ((uint32_t)half & 0x7fffu) << 13;
+    uint32_t exponent = shiftedExponent & u;
+    u += (127u - 15u) << 23;
+    if(exponent == shiftedExponent)
+        u += (128u - 16u) << 23;
+    else if(exponent == 0) {
+        u += 1u << 23;
+        float f, magic;
+        uint32_t magicBits = 113u << 23;
+        memcpy(&f, &u, sizeof(f));
+        memcpy(&magic, &magicBits, sizeof(magic));
+        f -= magic;
+        memcpy(&u, &f, sizeof(u));
+    }
+    u |= ((uint32_t)half & 0x8000u) << 16;
+    float value;
+    memcpy(&value, &u, sizeof(value));
+    return value;
+}
+
+inline const float *attribute(const float *base, size_t stride, size_t index) {
+    return (const float *)((const uint8_t *)base + index * stride);
+}
+
+inline float snorm16(int16_t value) {
+    return std::max(value / 32767.0f, -1.0f);
+}
+
+// Octahedral decode of snorm values, not normalized.
+inline void octDecode(float ex, float ey, float *n) {
+    n[0] = ex;
+    n[1] = ey;
+    n[2] = 1.0f - fabsf(ex) - fabsf(ey);
+    float t = std::max(-n[2], 0.0f);
+    n[0] += n[0] >= 0.0f ? -t : t;
+    n[1] += n[1] >= 0.0f ? -t : t;
+}
+
+}   // namespace
+
+void mgp_vertex_quantization_make(const mgp_vertex_stream_t *stream, mgp_vertex_quantization_t *quantization) {
+    float lower[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+    float upper[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+    for(size_t i = 0; i < stream->count; i++) {
+        const float *p = attribute(stream->position, stream->stride, i);
+        for(int c = 0; c < 3; c++) {
+            lower[c] = std::min(lower[c], p[c]);
+            upper[c] = std::max(upper[c], p[c]);
+        }
+    }
+    for(int c = 0; c < 3; c++) {
+        if(stream->count == 0)
+            lower[c] = upper[c] = 0.0f;
+        quantization->offset[c] = lower[c];
+        quantization->scale[c] = upper[c] > lower[c] ? upper[c] - lower[c] : 1.0f;
+    }
+}
+
+void mgp_vertex_quantize(mgp_quantized_vertex_t *destination, const mgp_vertex_stream_t *stream,
+                         const mgp_vertex_quantization_t *quantization) {
+    const size_t count = stream->count;
+    const size_t stride = stream->stride;
+    F4 offset[3], invScale[3];
+    for(int c = 0; c < 3; c++) {
+        offset[c] = splat(quantization->offset[c]);
+        invScale[c] = splat(1.0f / quantization->scale[c]);
+    }
+
+    // attributes of 4 vertices in lanes, the last group repeats its last vertex
+    float lanes[12][4];
+    int32_t values[9][4];
+    for(size_t start = 0; start < count; start += 4) {
+        size_t groupSize = std::min<size_t>(4, count - start);
+        for(size_t l = 0; l < 4; l++) {
+            size_t v = start + std::min(l, groupSize - 1);
+            const float *p = attribute(stream->position, stride, v);
+            const float *n = attribute(stream->normal, stride, v);
+            for(int c = 0; c < 3; c++) {
+                lanes[c][l] = p[c];
+                lanes[3 + c][l] = n[c];
+            }
+            if(stream->tangent) {
+                const float *t = attribute(stream->tangent, stride, v);
+                for(int c = 0; c < 3; c++)
+                    lanes[6 + c][l] = t[c];
+                lanes[9][l] = stream->tangentHasSign ? t[3] : 1.0f;
+            }
+            else {
+                lanes[6][l] = lanes[7][l] = lanes[8][l] = 0.0f;
+                lanes[9][l] = 1.0f;
+            }
+            const float *uv = stream->uv ? attribute(stream->uv, stride, v) : NULL;
+            lanes[10][l] = uv ? uv[0] : 0.0f;
+            lanes[11][l] = uv ? uv[1] : 0.0f;
+        }
+
+        // position
+        for(int c = 0; c < 3; c++) {
+            F4 t = clamp((load(lanes[c]) - offset[c]) * invScale[c], 0.0f, 1.0f);
+            round(t * splat(65535.0f), values[c]);
+        }
+
+        // normal, projected on the octahedron and folded into the upper half
+        F4 nx = load(lanes[3]), ny = load(lanes[4]), nz = load(lanes[5]);
+        F4 length = max(abs(nx) + abs(ny) + abs(nz), splat(FLT_MIN));
+        nx = nx / length;
+        ny = ny / length;
+        nz = nz / length;
+        F4 lower = greater(splat(0.0f), nz);
+        F4 foldedX = (splat(1.0f) - abs(ny)) * signNotZero(nx);
+        F4 foldedY = (splat(1.0f) - abs(nx)) * signNotZero(ny);
+        nx = select(lower, foldedX, nx);
+        ny = select(lower, foldedY, ny);
+        round(clamp(nx, -1.0f, 1.0f) * splat(32767.0f), values[3]);
+        round(clamp(ny, -1.0f, 1.0f) * splat(32767.0f), values[4]);
+
+        // the normal as the shader sees it, for the tangent basis
+        float decoded[2][4];
+        for(int l = 0; l < 4; l++) {
+            decoded[0][l] = snorm16((int16_t)values[3][l]);
+            decoded[1][l] = snorm16((int16_t)values[4][l]);
+        }
+        F4 ex = load(decoded[0]), ey = load(decoded[1]);
+        F4 dz = splat(1.0f) - abs(ex) - abs(ey);
+        F4 fold = max(splat(0.0f) - dz, splat(0.0f));
+        F4 dx = ex + select(greaterEqual(ex, splat(0.0f)), splat(0.0f) - fold, fold);
+        F4 dy = ey + select(greaterEqual(ey, splat(0.0f)), splat(0.0f) - fold, fold);
+        F4 invLength = splat(1.0f) / sqrt(dx * dx + dy * dy + dz * dz);
+        dx = dx * invLength;
+        dy = dy * invLength;
+        dz = dz * invLength;
+
+        // tangent, as an angle in the basis
+        F4 t[3], b[3];
+        basis4(dx, dy, dz, t, b);
+        F4 tx = load(lanes[6]), ty = load(lanes[7]), tz = load(lanes[8]);
+        F4 x = tx * t[0] + ty * t[1] + tz * t[2];
+        F4 y = tx * b[0] + ty * b[1] + tz * b[2];
+        F4 angle = atan2(y, x) * splat(1.0f / kPi);
+        round(clamp(angle, -1.0f, 1.0f) * splat(32767.0f), values[5]);
+        round(signNotZero(load(lanes[9])) * splat(32767.0f), values[6]);
+
+        // uv
+        uint16_t halves[2][4];
+#if MGP_QUANTIZE_F16C
+        for(int c = 0; c < 2; c++)
+            _mm_storel_epi64((__m128i *)halves[c], _mm_cvtps_ph(_mm_loadu_ps(lanes[10 + c]), _MM_FROUND_TO_NEAREST_INT));
+#elif MGP_QUANTIZE_NEON
+        for(int c = 0; c < 2; c++)
+            vst1_u16(halves[c], vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(lanes[10 + c]))));
+#else
+        for(int c = 0; c < 2; c++) {
+            for(int l = 0; l < 4; l++)
+                halves[c][l] = floatToHalf(lanes[10 + c][l]);
+        }
+#endif
+
+        for(size_t l = 0; l < groupSize; l++) {
+            mgp_quantized_vertex_t &out = destination[start + l];
+            out.position[0] = (uint16_t)values[0][l];
+            out.position[1] = (uint16_t)values[1][l];
+            out.position[2] = (uint16_t)values[2][l];
+            out.position[3] = 0;
+            out.uv[0] = halves[0][l];
+            out.uv[1] = halves[1][l];
+            out.normal[0] = (int16_t)values[3][l];
+            out.normal[1] = (int16_t)values[4][l];
+            out.tangent[0] = (int16_t)values[5][l];
+            out.tangent[1] = (int16_t)values[6][l];
+        }
+    }
+}
+
+void mgp_vertex_dequantize(const mgp_quantized_vertex_t *vertex, const mgp_vertex_quantization_t *quantization,
+                           float *position, float *uv, float *normal, float *tangent) {
+    if(position) {
+        for(int c = 0; c < 3; c++)
+            position[c] = quantization->offset[c] + vertex->position[c] / 65535.0f * quantization->scale[c];
+    }
+    if(uv) {
+        uv[0] = halfToFloat(vertex->uv[0]);
+        uv[1] = halfToFloat(vertex->uv[1]);
+    }
+
+    float n[3];
+    octDecode(snorm16(vertex->normal[0]), snorm16(vertex->normal[1]), n);
+    float invLength = 1.0f / sqrtf(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+    for(int c = 0; c < 3; c++)
+        n[c] *= invLength;
+    if(normal)
+        memcpy(normal, n, sizeof(n));
+
+    if(tangent) {
+        float t[3], b[3];
+        basis1(n[0], n[1], n[2], t, b);
+        float angle = snorm16(vertex->tangent[0]) * kPi;
+        float c = cosf(angle), s = sinf(angle);
+        for(int i = 0; i < 3; i++)
+            tangent[i] = c * t[i] + s * b[i];
+        tangent[3] = snorm16(vertex->tangent[1]) >= 0.0f ? 1.0f : -1.0f;
+    }
+}
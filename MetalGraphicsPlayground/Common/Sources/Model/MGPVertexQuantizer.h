@@ -0,0 +1,64 @@
+//
+//  MGPVertexQuantizer.h
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/17.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#ifndef MGPVertexQuantizer_h
+#define MGPVertexQuantizer_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Compressed vertex of 20 bytes instead of 44 (see MGPGBuffer quantizedVertexDescriptor).
+//  - position : 16-bit unorm in the bounds of the mesh,
+//  - uv : half,
+//  - normal : octahedral, 16-bit snorm,
+//  - tangent : angle around the normal / pi and the bitangent sign, 16-bit snorm.
+// The tangent angle is measured from a basis built from the decoded normal,
+// the shader decodes it the same way (oct_decode, tangent_decode in CommonMath).
+// Vertices are encoded 4 at a time with SSE2 or NEON.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    uint16_t position[4];       // w unused
+    uint16_t uv[2];
+    int16_t normal[2];
+    int16_t tangent[2];
+} mgp_quantized_vertex_t;
+
+// position = offset + unorm * scale
+typedef struct {
+    float offset[3];
+    float scale[3];
+} mgp_vertex_quantization_t;
+
+// Attributes of an interleaved (or not) vertex buffer.
+typedef struct {
+    const float *position;      // float3
+    const float *uv;            // float2, NULL for zero
+    const float *normal;        // float3, normalized
+    const float *tangent;       // float3, or float4 with the sign if tangentHasSign, NULL for any
+    size_t stride;              // bytes between vertices, same for every attribute
+    size_t count;
+    int tangentHasSign;
+} mgp_vertex_stream_t;
+
+// Bounds of the positions.
+void mgp_vertex_quantization_make(const mgp_vertex_stream_t *stream, mgp_vertex_quantization_t *quantization);
+void mgp_vertex_quantize(mgp_quantized_vertex_t *destination, const mgp_vertex_stream_t *stream,
+                         const mgp_vertex_quantization_t *quantization);
+// Decodes like the shader, any output may be NULL. tangent : float4 with the sign.
+void mgp_vertex_dequantize(const mgp_quantized_vertex_t *vertex, const mgp_vertex_quantization_t *quantization,
+                           float *position, float *uv, float *normal, float *tangent);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MGPVertexQuantizer_h */
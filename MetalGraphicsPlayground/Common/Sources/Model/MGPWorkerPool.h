@@ -0,0 +1,93 @@
+//
+//  MGPWorkerPool.h
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/17.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#ifndef MGPWorkerPool_h
+#define MGPWorkerPool_h
+
+// C++ only, shared by the portable culling/transform cores.
+
+#include <stdint.h>
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mgp {
+
+// Runs a job on every worker (and the calling thread) and waits for all of them.
+class WorkerPool {
+public:
+    explicit WorkerPool(uint32_t numThreads) : _numThreads(std::max(1u, numThreads)) {
+        for(uint32_t i = 1; i < _numThreads; i++)
+            _threads.emplace_back(&WorkerPool::workerMain, this, i);
+    }
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stop = true;
+        }
+        _wakeCondition.notify_all();
+        for(std::thread &thread : _threads)
+            thread.join();
+    }
+
+    uint32_t numThreads() const { return _numThreads; }
+
+    void run(const std::function<void(uint32_t)> &job) {
+        if(_numThreads == 1) {
+            job(0);
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _job = &job;
+            _remaining = _numThreads - 1;
+            _generation++;
+        }
+        _wakeCondition.notify_all();
+        job(0);
+
+        std::unique_lock<std::mutex> lock(_mutex);
+        _doneCondition.wait(lock, [this] { return _remaining == 0; });
+        _job = nullptr;
+    }
+
+private:
+    void workerMain(uint32_t index) {
+        uint64_t generation = 0;
+        std::unique_lock<std::mutex> lock(_mutex);
+        while(true) {
+            _wakeCondition.wait(lock, [&] { return _stop || _generation != generation; });
+            if(_stop)
+                return;
+            generation = _generation;
+            const std::function<void(uint32_t)> *job = _job;
+            lock.unlock();
+            (*job)(index);
+            lock.lock();
+            if(--_remaining == 0)
+                _doneCondition.notify_one();
+        }
+    }
+
+    uint32_t _numThreads;
+    std::vector<std::thread> _threads;
+    std::mutex _mutex;
+    std::condition_variable _wakeCondition;
+    std::condition_variable _doneCondition;
+    const std::function<void(uint32_t)> *_job = nullptr;
+    uint32_t _remaining = 0;
+    uint64_t _generation = 0;
+    bool _stop = false;
+};
+
+} // namespace mgp
+
+#endif /* MGPWorkerPool_h */
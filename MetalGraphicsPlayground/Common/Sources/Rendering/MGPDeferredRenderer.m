@@ -20,12 +20,58 @@
 #import "MGPShadowManager.h"
 #import "LightingCommon.h"
 #import "MGPCommonVertices.h"
+#import "MGPDrawSort.h"
+#import "MGPRenderGraph.h"
 #import "../Model/MGPImageBasedLighting.h"
 
 #define DEFAULT_SHADOW_RESOLUTION 512
 #define LIGHT_CULL_BUFFER_SIZE (19881*4*16) // fits Pro Display XDR (6016/16)*(3384/16)/4=19881
 #define LIGHT_CULL_GRID_TILE_SIZE 16
 
+// draw sort
+#define DRAW_PASS_GBUFFER 0
+#define DRAW_PASS_SHADOW 1
+#define DRAW_ITEM_SUBMESH_BITS 12   // draw item : draw call index, submesh index
+
+// passes of a camera, in the order they are added to the render graph
+typedef enum {
+    camera_pass_skybox,
+    camera_pass_post_process_before_prepass,
+    camera_pass_prepass,
+    camera_pass_post_process_before_light_pass,
+    camera_pass_light_cull,
+    camera_pass_post_process_before_shade_pass,
+    camera_pass_shading,
+    camera_pass_directional_shadowed_lighting,
+    camera_pass_indirect_lighting,
+    camera_pass_post_process_after_shade_pass,
+    camera_pass_present,
+    camera_pass_total
+} camera_pass_t;
+
+static NSString * const kCameraPassNames[camera_pass_total] = {
+    @"Skybox",
+    @"Post-process (Before Prepass)",
+    @"G-buffer",
+    @"Post-process (Before Light Pass)",
+    @"Light Culling",
+    @"Post-process (Before Shade Pass)",
+    @"Direct Lighting",
+    @"Directional Shadowed Lighting",
+    @"Indirect Lighting",
+    @"Post-process (After Shade Pass)",
+    @"Present"
+};
+
+// resources shared by the passes of a camera
+typedef struct {
+    uint32_t drawable;
+    uint32_t depth, albedo, normal, shading, tangent;
+    uint32_t lightCull;
+    uint32_t ssao;
+    uint32_t output;
+} camera_resources_t;
+
 @interface MGPDeferredRenderer ()
 @end
 
@@ -46,17 +92,41 @@
     id<MTLComputePipelineState> _computePipelineLightCulling;
     id<MTLRenderPipelineState> _renderPipelineLightCullTile;
     id<MTLBuffer> _lightCullBuffer;
+    
+    // Draw calls of this frame
+    MGPDrawCallList *_cameraDrawCallList;
+    NSArray<MGPDrawCallList*> *_shadowDrawCallLists;
+    NSMutableArray<MGPFrustum*> *_drawCallFrustums;
+    
+    // Render graph of camera passes, rebuilt for each camera
+    mgp_render_graph_t *_renderGraph;
+    camera_pass_t _renderGraphPasses[camera_pass_total];    // by graph pass index
+    
+    // Sort keys of submesh draws, reused between passes
+    uint64_t *_drawKeys, *_drawKeysTemp;
+    uint32_t *_drawItems, *_drawItemsTemp;
+    size_t _drawKeyCapacity;
 }
 
 - (instancetype)init {
     self = [super init];
     if(self) {
         _usesAnisotropy = YES;
+        _drawCallFrustums = [NSMutableArray new];
+        _renderGraph = mgp_render_graph_create();
         [self _initAssets];
     }
     return self;
 }
 
+- (void)dealloc {
+    mgp_render_graph_destroy(_renderGraph);
+    free(_drawKeys);
+    free(_drawKeysTemp);
+    free(_drawItems);
+    free(_drawItemsTemp);
+}
+
 - (void)_initAssets {
     // G-buffer
     MGPGBufferAttachmentType attachments =
@@ -74,7 +144,8 @@
     // shadow manager
     _shadowManager = [[MGPShadowManager alloc] initWithDevice:self.device
                                                       library:self.defaultLibrary
-                                             vertexDescriptor:_gBuffer.baseVertexDescriptor];
+                                             vertexDescriptor:_gBuffer.baseVertexDescriptor
+                                    quantizedVertexDescriptor:_gBuffer.quantizedVertexDescriptor];
     
     // vertex buffer (mesh)
     _commonVertexBuffer = [self.device newBufferWithLength:1024
@@ -156,6 +227,9 @@
     commandBuffer.label = @"Render";
     [self beginGPUTime:commandBuffer];
     
+    // cull shadow and camera views at once
+    [self makeDrawCallLists];
+    
     // shadow
     [self renderShadows: commandBuffer];
     
@@ -175,6 +249,22 @@
     [commandBuffer commit];
 }
 
+- (void)makeDrawCallLists {
+    NSMutableArray<MGPFrustum*> *frustums = _drawCallFrustums;
+    [frustums removeAllObjects];
+    for(MGPLightComponent *lightComponent in _lightComponents) {
+        if(lightComponent.castShadows)
+            [frustums addObject:lightComponent.frustum];
+    }
+    if(_cameraComponents.count > 0)
+        [frustums addObject:_cameraComponents[0].frustum];
+    
+    // shadow lists come first, the camera's list is the last one
+    NSArray<MGPDrawCallList*> *drawCallLists = [self drawCallListsWithFrustums:frustums];
+    _cameraDrawCallList = _cameraComponents.count > 0 ? drawCallLists.lastObject : nil;
+    _shadowDrawCallLists = drawCallLists;
+}
+
 - (void)performPrefilterPass {
     id<MTLCommandBuffer> commandBuffer = [self.queue commandBuffer];
     commandBuffer.label = @"Prefilter";
@@ -188,62 +278,281 @@
               commandBuffer:(id<MTLCommandBuffer>)commandBuffer {
     [commandBuffer pushDebugGroup:[NSString stringWithFormat:@"Camera #%lu", index+1]];
     
+    // passes whose outputs aren't used are culled, lighting passes share one encoder
+    [self _buildCameraRenderGraph];
+    size_t numSteps = mgp_render_graph_compile(_renderGraph);
+    const mgp_render_graph_step_t *steps = mgp_render_graph_steps(_renderGraph);
+    
+    id<MTLCommandEncoder> encoder = nil;
+    for(size_t i = 0; i < numSteps; i++) {
+        camera_pass_t pass = _renderGraphPasses[steps[i].pass];
+        if(i == 0 || steps[i].encoder != steps[i-1].encoder) {
+            [encoder endEncoding];
+            encoder = [self _makeEncoderForCameraPass:pass
+                                        commandBuffer:commandBuffer];
+        }
+        [encoder pushDebugGroup:kCameraPassNames[pass]];
+        [self _encodeCameraPass:pass
+                        encoder:encoder
+                  commandBuffer:commandBuffer];
+        [encoder popDebugGroup];
+    }
+    [encoder endEncoding];
+    
+    [commandBuffer popDebugGroup];
+}
+
+- (uint32_t)_addCameraPass:(camera_pass_t)pass
+                      type:(mgp_render_graph_pass_type_t)type
+                     flags:(uint32_t)flags {
+    uint32_t index = mgp_render_graph_add_pass(_renderGraph, type, flags);
+    _renderGraphPasses[index] = pass;
+    return index;
+}
+
+- (void)_addPostProcessPass:(camera_pass_t)pass
+                      order:(MGPPostProcessingRenderingOrder)order
+                  resources:(const camera_resources_t *)res {
+    NSArray<id<MGPPostProcessingLayer>> *layers = [_postProcess orderedLayersForRenderingOrder:order];
+    if(layers.count == 0)
+        return;
+    
+    // resources of known layers, others are always rendered
+    uint32_t flags = 0;
+    for(id<MGPPostProcessingLayer> layer in layers) {
+        if(![layer isKindOfClass:MGPPostProcessingLayerSSAO.class] &&
+           ![layer isKindOfClass:MGPPostProcessingLayerScreenSpaceReflection.class])
+            flags |= MGP_RENDER_GRAPH_PASS_SIDE_EFFECT;
+    }
+    uint32_t index = [self _addCameraPass:pass
+                                     type:MGP_RENDER_GRAPH_PASS_EXTERNAL
+                                    flags:flags];
+    for(id<MGPPostProcessingLayer> layer in layers) {
+        if([layer isKindOfClass:MGPPostProcessingLayerSSAO.class]) {
+            mgp_render_graph_pass_read(_renderGraph, index, res->depth);
+            mgp_render_graph_pass_read(_renderGraph, index, res->normal);
+            mgp_render_graph_pass_read(_renderGraph, index, res->tangent);
+            mgp_render_graph_pass_write(_renderGraph, index, res->ssao);
+        }
+        else if([layer isKindOfClass:MGPPostProcessingLayerScreenSpaceReflection.class]) {
+            mgp_render_graph_pass_read(_renderGraph, index, res->normal);
+            mgp_render_graph_pass_read(_renderGraph, index, res->depth);
+            mgp_render_graph_pass_read(_renderGraph, index, res->shading);
+            mgp_render_graph_pass_read(_renderGraph, index, res->output);
+            mgp_render_graph_pass_write(_renderGraph, index, res->output);
+        }
+    }
+}
+
+- (void)_readGBufferInPass:(uint32_t)index
+                 resources:(const camera_resources_t *)res {
+    mgp_render_graph_pass_read(_renderGraph, index, res->albedo);
+    mgp_render_graph_pass_read(_renderGraph, index, res->normal);
+    mgp_render_graph_pass_read(_renderGraph, index, res->shading);
+    mgp_render_graph_pass_read(_renderGraph, index, res->depth);
+    if(_usesAnisotropy)
+        mgp_render_graph_pass_read(_renderGraph, index, res->tangent);
+}
+
+- (void)_buildCameraRenderGraph {
+    mgp_render_graph_t *graph = _renderGraph;
+    mgp_render_graph_reset(graph);
+    
+    camera_resources_t res;
+    res.drawable = mgp_render_graph_add_resource(graph, MGP_RENDER_GRAPH_RESOURCE_IMPORTED);
+    res.depth = mgp_render_graph_add_resource(graph, 0);
+    res.albedo = mgp_render_graph_add_resource(graph, 0);
+    res.normal = mgp_render_graph_add_resource(graph, 0);
+    res.shading = mgp_render_graph_add_resource(graph, 0);
+    res.tangent = mgp_render_graph_add_resource(graph, 0);
+    res.lightCull = mgp_render_graph_add_resource(graph, 0);
+    res.ssao = mgp_render_graph_add_resource(graph, 0);
+    res.output = mgp_render_graph_add_resource(graph, 0);
+    
+    uint32_t pass;
+    
     // skybox pass
     if(self.scene.IBL) {
-        _renderPassSkybox.colorAttachments[0].texture = self.view.currentDrawable.texture;
-        _renderPassSkybox.depthAttachment.texture = _gBuffer.depth;
-        id<MTLRenderCommandEncoder> skyboxPassEncoder = [commandBuffer renderCommandEncoderWithDescriptor: _renderPassSkybox];
-        [self renderSkybox:skyboxPassEncoder];
+        pass = [self _addCameraPass:camera_pass_skybox type:MGP_RENDER_GRAPH_PASS_RENDER flags:0];
+        mgp_render_graph_pass_attach(graph, pass, res.drawable, 0);
+        mgp_render_graph_pass_attach(graph, pass, res.depth, 0);
     }
     
-    // Post-process before prepass
-    [_postProcess render: commandBuffer
-       forRenderingOrder: MGPPostProcessingRenderingOrderBeforePrepass];
+    [self _addPostProcessPass:camera_pass_post_process_before_prepass
+                        order:MGPPostProcessingRenderingOrderBeforePrepass
+                    resources:&res];
     
     // G-buffer prepass
-    id<MTLRenderCommandEncoder> prepassEncoder = [commandBuffer renderCommandEncoderWithDescriptor: [_gBuffer prePassDescriptorWithAttachment:_gBuffer.attachments]];
-    [self renderGBuffer:prepassEncoder];
+    MGPGBufferAttachmentType attachments = _gBuffer.attachments;
+    pass = [self _addCameraPass:camera_pass_prepass type:MGP_RENDER_GRAPH_PASS_RENDER flags:0];
+    if(attachments & MGPGBufferAttachmentTypeAlbedo)
+        mgp_render_graph_pass_attach(graph, pass, res.albedo, 0);
+    if(attachments & MGPGBufferAttachmentTypeNormal)
+        mgp_render_graph_pass_attach(graph, pass, res.normal, 0);
+    if(attachments & MGPGBufferAttachmentTypeShading)
+        mgp_render_graph_pass_attach(graph, pass, res.shading, 0);
+    if(attachments & MGPGBufferAttachmentTypeTangent)
+        mgp_render_graph_pass_attach(graph, pass, res.tangent, 0);
+    if(attachments & MGPGBufferAttachmentTypeDepth)
+        mgp_render_graph_pass_attach(graph, pass, res.depth, 0);
     
-    // Post-process before light pass
-    [_postProcess render: commandBuffer
-       forRenderingOrder: MGPPostProcessingRenderingOrderBeforeLightPass];
+    [self _addPostProcessPass:camera_pass_post_process_before_light_pass
+                        order:MGPPostProcessingRenderingOrderBeforeLightPass
+                    resources:&res];
     
     // Light cull pass
-    id<MTLComputeCommandEncoder> lightCullPassEncoder = [commandBuffer computeCommandEncoder];
-    [self computeLightCullGrid:lightCullPassEncoder];
+    pass = [self _addCameraPass:camera_pass_light_cull type:MGP_RENDER_GRAPH_PASS_COMPUTE flags:0];
+    mgp_render_graph_pass_read(graph, pass, res.depth);
+    mgp_render_graph_pass_write(graph, pass, res.lightCull);
     
-    // Post-process before shade pass
-    [_postProcess render: commandBuffer
-       forRenderingOrder: MGPPostProcessingRenderingOrderBeforeShadePass];
+    [self _addPostProcessPass:camera_pass_post_process_before_shade_pass
+                        order:MGPPostProcessingRenderingOrderBeforeShadePass
+                    resources:&res];
     
     // G-buffer shade pass
-    id<MTLRenderCommandEncoder> shadingPassEncoder = [commandBuffer renderCommandEncoderWithDescriptor: _gBuffer.shadingPassDescriptor];
-    [self renderDirectLighting:shadingPassEncoder];
+    pass = [self _addCameraPass:camera_pass_shading type:MGP_RENDER_GRAPH_PASS_RENDER flags:0];
+    mgp_render_graph_pass_attach(graph, pass, res.output, 0);
+    [self _readGBufferInPass:pass resources:&res];
+    mgp_render_graph_pass_read(graph, pass, res.lightCull);
     
     // Directional lighting (with shadow) pass
     if(self.scene.lightGlobalProps.num_directional_shadowed_light > 0) {
-        id<MTLRenderCommandEncoder> directionalShadowedLightingPassEncoder = [commandBuffer renderCommandEncoderWithDescriptor:_gBuffer.directionalShadowedLightingPassDescriptor];
-        [self renderDirectionalShadowedLighting:directionalShadowedLightingPassEncoder];
+        pass = [self _addCameraPass:camera_pass_directional_shadowed_lighting type:MGP_RENDER_GRAPH_PASS_RENDER flags:0];
+        mgp_render_graph_pass_attach(graph, pass, res.output, 1);
+        [self _readGBufferInPass:pass resources:&res];
     }
     
     // Indirect lighting pass
-    id<MTLRenderCommandEncoder> indirectLightingPassEncoder = [commandBuffer renderCommandEncoderWithDescriptor:_gBuffer.indirectLightingPassDescriptor];
-    [self renderIndirectLighting:indirectLightingPassEncoder];
+    pass = [self _addCameraPass:camera_pass_indirect_lighting type:MGP_RENDER_GRAPH_PASS_RENDER flags:0];
+    mgp_render_graph_pass_attach(graph, pass, res.output, 1);
+    [self _readGBufferInPass:pass resources:&res];
+    if([_postProcess layerByClass:MGPPostProcessingLayerSSAO.class].enabled)
+        mgp_render_graph_pass_read(graph, pass, res.ssao);
     
-    // Post-process after shade pass
-    [_postProcess render: commandBuffer
-       forRenderingOrder: MGPPostProcessingRenderingOrderAfterShadePass];
+    [self _addPostProcessPass:camera_pass_post_process_after_shade_pass
+                        order:MGPPostProcessingRenderingOrderAfterShadePass
+                    resources:&res];
     
     // present to framebuffer
-    _renderPassPresent.colorAttachments[0].texture = self.view.currentDrawable.texture;
-    if(self.scene.IBL)
-        _renderPassPresent.colorAttachments[0].loadAction = MTLLoadActionLoad;
-    else
-        _renderPassPresent.colorAttachments[0].loadAction = MTLLoadActionClear;
-    id<MTLRenderCommandEncoder> presentCommandEncoder = [commandBuffer renderCommandEncoderWithDescriptor: _renderPassPresent];
-    [self renderFramebuffer:presentCommandEncoder];
+    pass = [self _addCameraPass:camera_pass_present type:MGP_RENDER_GRAPH_PASS_RENDER flags:0];
+    mgp_render_graph_pass_attach(graph, pass, res.drawable, self.scene.IBL != nil);
+    switch(_gBufferIndex) {
+        case 1:
+            mgp_render_graph_pass_read(graph, pass, res.albedo);
+            break;
+        case 2:
+            mgp_render_graph_pass_read(graph, pass, res.normal);
+            break;
+        case 3:
+            mgp_render_graph_pass_read(graph, pass, res.tangent);
+            break;
+        case 4:
+            mgp_render_graph_pass_read(graph, pass, res.shading);
+            break;
+        case 5:
+            if([_postProcess layerByClass:MGPPostProcessingLayerSSAO.class] != nil)
+                mgp_render_graph_pass_read(graph, pass, res.ssao);
+            else
+                mgp_render_graph_pass_read(graph, pass, res.output);
+            break;
+        case 6:
+            mgp_render_graph_pass_read(graph, pass, res.lightCull);
+            break;
+        default:
+            mgp_render_graph_pass_read(graph, pass, res.output);
+            break;
+    }
+}
+
+- (id<MTLCommandEncoder>)_makeEncoderForCameraPass:(camera_pass_t)pass
+                                     commandBuffer:(id<MTLCommandBuffer>)commandBuffer {
+    MTLRenderPassDescriptor *renderPass = nil;
+    switch(pass) {
+        case camera_pass_skybox:
+            _renderPassSkybox.colorAttachments[0].texture = self.view.currentDrawable.texture;
+            _renderPassSkybox.depthAttachment.texture = _gBuffer.depth;
+            renderPass = _renderPassSkybox;
+            break;
+        case camera_pass_prepass:
+            renderPass = [_gBuffer prePassDescriptorWithAttachment:_gBuffer.attachments];
+            break;
+        case camera_pass_light_cull:
+        {
+            id<MTLComputeCommandEncoder> encoder = [commandBuffer computeCommandEncoder];
+            encoder.label = kCameraPassNames[pass];
+            return encoder;
+        }
+        case camera_pass_shading:
+            renderPass = _gBuffer.shadingPassDescriptor;
+            break;
+        case camera_pass_directional_shadowed_lighting:
+            renderPass = _gBuffer.directionalShadowedLightingPassDescriptor;
+            break;
+        case camera_pass_indirect_lighting:
+            renderPass = _gBuffer.indirectLightingPassDescriptor;
+            break;
+        case camera_pass_present:
+            _renderPassPresent.colorAttachments[0].texture = self.view.currentDrawable.texture;
+            if(self.scene.IBL)
+                _renderPassPresent.colorAttachments[0].loadAction = MTLLoadActionLoad;
+            else
+                _renderPassPresent.colorAttachments[0].loadAction = MTLLoadActionClear;
+            renderPass = _renderPassPresent;
+            break;
+        default:
+            // post-process passes make their own encoders
+            return nil;
+    }
     
-    [commandBuffer popDebugGroup];
+    id<MTLRenderCommandEncoder> encoder = [commandBuffer renderCommandEncoderWithDescriptor:renderPass];
+    encoder.label = kCameraPassNames[pass];
+    return encoder;
+}
+
+- (void)_encodeCameraPass:(camera_pass_t)pass
+                  encoder:(id<MTLCommandEncoder>)encoder
+            commandBuffer:(id<MTLCommandBuffer>)commandBuffer {
+    switch(pass) {
+        case camera_pass_skybox:
+            [self renderSkybox:(id<MTLRenderCommandEncoder>)encoder];
+            break;
+        case camera_pass_post_process_before_prepass:
+            [_postProcess render: commandBuffer
+               forRenderingOrder: MGPPostProcessingRenderingOrderBeforePrepass];
+            break;
+        case camera_pass_prepass:
+            [self renderGBuffer:(id<MTLRenderCommandEncoder>)encoder];
+            break;
+        case camera_pass_post_process_before_light_pass:
+            [_postProcess render: commandBuffer
+               forRenderingOrder: MGPPostProcessingRenderingOrderBeforeLightPass];
+            break;
+        case camera_pass_light_cull:
+            [self computeLightCullGrid:(id<MTLComputeCommandEncoder>)encoder];
+            break;
+        case camera_pass_post_process_before_shade_pass:
+            [_postProcess render: commandBuffer
+               forRenderingOrder: MGPPostProcessingRenderingOrderBeforeShadePass];
+            break;
+        case camera_pass_shading:
+            [self renderDirectLighting:(id<MTLRenderCommandEncoder>)encoder];
+            break;
+        case camera_pass_directional_shadowed_lighting:
+            [self renderDirectionalShadowedLighting:(id<MTLRenderCommandEncoder>)encoder];
+            break;
+        case camera_pass_indirect_lighting:
+            [self renderIndirectLighting:(id<MTLRenderCommandEncoder>)encoder];
+            break;
+        case camera_pass_post_process_after_shade_pass:
+            [_postProcess render: commandBuffer
+               forRenderingOrder: MGPPostProcessingRenderingOrderAfterShadePass];
+            break;
+        case camera_pass_present:
+            [self renderFramebuffer:(id<MTLRenderCommandEncoder>)encoder];
+            break;
+        default:
+            break;
+    }
 }
 
 - (void)endFrame {
@@ -254,88 +563,197 @@
            bindTextures:(BOOL)bindTextures
     instanceBufferIndex:(NSUInteger)slotIndex
                 encoder:(id<MTLRenderCommandEncoder>)encoder {
-    id<MTLTexture> textures[tex_total] = {};
-    BOOL textureChangedFlags[tex_total] = {};
-    for(int i = 0; i < tex_total; i++) {
-        textureChangedFlags[i] = YES;
+    NSArray<MGPDrawCall*> *drawCalls = drawCallList.drawCalls;
+    
+    // one sort key per submesh draw : pass, pipeline, textures, mesh, depth
+    size_t numItems = 0;
+    float maxDepth = 0.0f;
+    for(MGPDrawCall *drawCall in drawCalls) {
+        numItems += drawCall.mesh.submeshes.count;
+        maxDepth = MAX(maxDepth, drawCall.depth);
     }
-    id<MTLRenderPipelineState> prevPrepassPipeline = nil;
-    for(MGPDrawCall *drawCall in drawCallList.drawCalls) {
-        MGPMesh *mesh = drawCall.mesh;
-        NSUInteger instanceCount = drawCall.instanceCount;
-        id<MTLBuffer> instancePropsBuffer = drawCall.instancePropsBuffer;
-        NSUInteger instancePropsBufferOffset = drawCall.instancePropsBufferOffset;
+    if(numItems > _drawKeyCapacity) {
+        _drawKeyCapacity = MAX(256, numItems * 2);
+        _drawKeys = realloc(_drawKeys, sizeof(uint64_t) * _drawKeyCapacity);
+        _drawKeysTemp = realloc(_drawKeysTemp, sizeof(uint64_t) * _drawKeyCapacity);
+        _drawItems = realloc(_drawItems, sizeof(uint32_t) * _drawKeyCapacity);
+        _drawItemsTemp = realloc(_drawItemsTemp, sizeof(uint32_t) * _drawKeyCapacity);
+    }
+    
+    size_t numKeys = 0;
+    uint32_t pass = bindTextures ? DRAW_PASS_GBUFFER : DRAW_PASS_SHADOW;
+    for(uint32_t d = 0; d < drawCalls.count; d++) {
+        MGPDrawCall *drawCall = drawCalls[d];
+        const void *mesh = (__bridge const void *)drawCall.mesh;
+        uint32_t meshKey = mgp_draw_key_hash(&mesh, 1, MGP_DRAW_KEY_MESH_BITS);
+        uint32_t depthKey = mgp_draw_key_depth(drawCall.depth, maxDepth);
         
-        // Set vertex buffer
-        [encoder setVertexBuffer: mesh.metalKitMesh.vertexBuffers[0].buffer
-                          offset: 0
-                         atIndex: 0];
+        uint32_t quantizedKey = (drawCall.mesh.usesQuantizedVertices ? 1 : 0) << 7;
         
-        // draw submeshes
-        for(MGPSubmesh *submesh in mesh.submeshes) {
-            // Texture binding
+        NSArray<MGPSubmesh*> *submeshes = drawCall.mesh.submeshes;
+        for(uint32_t s = 0; s < submeshes.count; s++) {
+            uint32_t pipelineKey = quantizedKey, textureSetKey = 0;
             if(bindTextures) {
-                // Check previous draw call's textures and current textures are duplicated.
+                MGPSubmesh *submesh = submeshes[s];
+                const void *textures[tex_total];
                 for(int i = 0; i < tex_total; i++) {
-                    id<MTLTexture> texture = submesh.textures[i];
-                    if(texture == (id<MTLTexture>)NSNull.null)
-                        texture = nil;
-                    if(textures[i] != texture) {
-                        textureChangedFlags[i] = YES;
-                        textures[i] = texture;
-                    }
+                    id texture = submesh.textures[i];
+                    textures[i] = texture == NSNull.null ? NULL : (__bridge const void *)texture;
                 }
-                
-                // Set textures
-                for(int i = 0; i < tex_total; i++) {
-                    if(textureChangedFlags[i]) {
-                        [encoder setFragmentTexture: textures[i] atIndex: i];
-                        textureChangedFlags[i] = NO;
-                    }
+                pipelineKey |= [self _prepassPipelineKeyForSubmesh:submesh];
+                textureSetKey = mgp_draw_key_hash(textures, tex_total, MGP_DRAW_KEY_TEXTURE_SET_BITS);
+            }
+            _drawKeys[numKeys] = mgp_draw_key_make(pass, pipelineKey, textureSetKey, meshKey, depthKey);
+            _drawItems[numKeys++] = (d << DRAW_ITEM_SUBMESH_BITS) | s;
+        }
+    }
+    mgp_draw_keys_sort(_drawKeys, _drawItems, _drawKeysTemp, _drawItemsTemp, numKeys);
+    
+    // encode, changing only the states that differ from the previous draw
+    id<MTLTexture> textures[tex_total] = {};
+    BOOL textureBound[tex_total] = {};
+    uint32_t prevPipelineKey = UINT32_MAX;
+    MGPMesh *prevMesh = nil;
+    id<MTLBuffer> prevInstancePropsBuffer = nil;
+    NSUInteger prevInstancePropsBufferOffset = 0;
+    for(size_t k = 0; k < numKeys; k++) {
+        MGPDrawCall *drawCall = drawCalls[_drawItems[k] >> DRAW_ITEM_SUBMESH_BITS];
+        MGPMesh *mesh = drawCall.mesh;
+        NSUInteger submeshIndex = _drawItems[k] & ((1u << DRAW_ITEM_SUBMESH_BITS) - 1);
+        MGPSubmesh *submesh = mesh.submeshes[submeshIndex];
+        id<MTLBuffer> instancePropsBuffer = drawCall.instancePropsBuffer;
+        NSUInteger instancePropsBufferOffset = drawCall.instancePropsBufferOffset;
+        
+        if(bindTextures) {
+            // Texture binding
+            for(int i = 0; i < tex_total; i++) {
+                id<MTLTexture> texture = submesh.textures[i];
+                if(texture == (id<MTLTexture>)NSNull.null)
+                    texture = nil;
+                if(!textureBound[i] || textures[i] != texture) {
+                    [encoder setFragmentTexture: texture atIndex: i];
+                    textures[i] = texture;
+                    textureBound[i] = YES;
                 }
-                
-                // Set render pipeline for G-buffer
-                MGPGBufferPrepassFunctionConstants prepassConstants = {};
-                prepassConstants.hasAlbedoMap = submesh.textures[tex_albedo] != NSNull.null;
-                prepassConstants.hasNormalMap = submesh.textures[tex_normal] != NSNull.null;
-                prepassConstants.hasRoughnessMap = submesh.textures[tex_roughness] != NSNull.null;
-                prepassConstants.hasMetalicMap = submesh.textures[tex_metalic] != NSNull.null;
-                prepassConstants.hasOcclusionMap = submesh.textures[tex_occlusion] != NSNull.null;
-                prepassConstants.hasAnisotropicMap = submesh.textures[tex_anisotropic] != NSNull.null;
-                //prepassConstants.flipVertically = YES;  // for sponza textures
-                //prepassConstants.sRGBTexture = YES;     // for sponza textures
-                prepassConstants.usesAnisotropy = _usesAnisotropy;
-                
-                id<MTLRenderPipelineState> prepassPipeline = [_gBuffer renderPipelineStateWithConstants: prepassConstants
+            }
+            
+            // Set render pipeline for G-buffer, looked up only when the permutation changes
+            uint32_t pipelineKey = mgp_draw_key_pipeline(_drawKeys[k]);
+            if(pipelineKey != prevPipelineKey) {
+                id<MTLRenderPipelineState> prepassPipeline = [_gBuffer renderPipelineStateWithConstants: [self _prepassConstantsWithPipelineKey: pipelineKey]
                                                                                                   error: nil];
-                if(prepassPipeline != nil &&
-                   prevPrepassPipeline != prepassPipeline) {
+                if(prepassPipeline != nil)
                     [encoder setRenderPipelineState: prepassPipeline];
-                    prevPrepassPipeline = prepassPipeline;
-                }
+                prevPipelineKey = pipelineKey;
             }
-            
-            // instance props buffer
+        }
+        else {
+            // Shadow pipeline differs only by the vertex format
+            uint32_t pipelineKey = mgp_draw_key_pipeline(_drawKeys[k]);
+            if(pipelineKey != prevPipelineKey) {
+                [encoder setRenderPipelineState: mesh.usesQuantizedVertices ? _shadowManager.quantizedShadowPipeline : _shadowManager.shadowPipeline];
+                prevPipelineKey = pipelineKey;
+            }
+        }
+        
+        // Set vertex buffer
+        if(mesh != prevMesh) {
+            [encoder setVertexBuffer: mesh.metalKitMesh.vertexBuffers[0].buffer
+                              offset: 0
+                             atIndex: 0];
+            if(mesh.usesQuantizedVertices) {
+                vertex_quantization_t quantization = mesh.vertexQuantization;
+                [encoder setVertexBytes: &quantization
+                                 length: sizeof(vertex_quantization_t)
+                                atIndex: 4];
+            }
+            prevMesh = mesh;
+        }
+        
+        // instance props buffer
+        if(instancePropsBuffer != prevInstancePropsBuffer) {
             [encoder setVertexBuffer: instancePropsBuffer
                               offset: instancePropsBufferOffset
                              atIndex: slotIndex];
             [encoder setFragmentBuffer: instancePropsBuffer
                                 offset: instancePropsBufferOffset
                                atIndex: slotIndex];
-            
-            // Draw call
+            prevInstancePropsBuffer = instancePropsBuffer;
+            prevInstancePropsBufferOffset = instancePropsBufferOffset;
+        }
+        else if(instancePropsBufferOffset != prevInstancePropsBufferOffset) {
+            [encoder setVertexBufferOffset: instancePropsBufferOffset atIndex: slotIndex];
+            [encoder setFragmentBufferOffset: instancePropsBufferOffset atIndex: slotIndex];
+            prevInstancePropsBufferOffset = instancePropsBufferOffset;
+        }
+        
+        // Draw call
+        NSUInteger lod = drawCall.lod;
+        if(drawCall.usesClusterRanges) {
+            // Visible meshlets only, neighbours are merged into one range
+            NSUInteger numRanges = 0;
+            const mgp_index_range_t *ranges = [drawCall clusterRangesOfSubmeshAtIndex: submeshIndex
+                                                                                count: &numRanges];
+            NSUInteger indexSize = submesh.metalKitSubmesh.indexType == MTLIndexTypeUInt32 ? sizeof(uint32_t) : sizeof(uint16_t);
+            for(NSUInteger r = 0; r < numRanges; r++) {
+                [encoder drawIndexedPrimitives: submesh.metalKitSubmesh.primitiveType
+                                    indexCount: ranges[r].count
+                                     indexType: submesh.metalKitSubmesh.indexType
+                                   indexBuffer: submesh.metalKitSubmesh.indexBuffer.buffer
+                             indexBufferOffset: submesh.metalKitSubmesh.indexBuffer.offset + ranges[r].start * indexSize
+                                 instanceCount: drawCall.instanceCount];
+            }
+        }
+        else if(lod == 0) {
             [encoder drawIndexedPrimitives: submesh.metalKitSubmesh.primitiveType
                                 indexCount: submesh.metalKitSubmesh.indexCount
                                  indexType: submesh.metalKitSubmesh.indexType
                                indexBuffer: submesh.metalKitSubmesh.indexBuffer.buffer
                          indexBufferOffset: submesh.metalKitSubmesh.indexBuffer.offset
-                             instanceCount: instanceCount];
+                             instanceCount: drawCall.instanceCount];
+        }
+        else if([submesh indexCountAtLOD: lod] > 0) {
+            // Coarser LODs index the same vertices from the mesh's LOD index buffer
+            [encoder drawIndexedPrimitives: submesh.metalKitSubmesh.primitiveType
+                                indexCount: [submesh indexCountAtLOD: lod]
+                                 indexType: MTLIndexTypeUInt32
+                               indexBuffer: mesh.lodIndexBuffer
+                         indexBufferOffset: [submesh indexBufferOffsetAtLOD: lod]
+                             instanceCount: drawCall.instanceCount];
         }
     }
 }
 
+// G-buffer pipeline permutation as key bits
+- (uint32_t)_prepassPipelineKeyForSubmesh:(MGPSubmesh *)submesh {
+    NSArray *textures = submesh.textures;
+    uint32_t key = 0;
+    key |= (textures[tex_albedo] != NSNull.null) << 0;
+    key |= (textures[tex_normal] != NSNull.null) << 1;
+    key |= (textures[tex_roughness] != NSNull.null) << 2;
+    key |= (textures[tex_metalic] != NSNull.null) << 3;
+    key |= (textures[tex_occlusion] != NSNull.null) << 4;
+    key |= (textures[tex_anisotropic] != NSNull.null) << 5;
+    key |= (_usesAnisotropy ? 1 : 0) << 6;
+    return key;
+}
+
+- (MGPGBufferPrepassFunctionConstants)_prepassConstantsWithPipelineKey:(uint32_t)key {
+    MGPGBufferPrepassFunctionConstants prepassConstants = {};
+    prepassConstants.hasAlbedoMap = key & (1 << 0);
+    prepassConstants.hasNormalMap = key & (1 << 1);
+    prepassConstants.hasRoughnessMap = key & (1 << 2);
+    prepassConstants.hasMetalicMap = key & (1 << 3);
+    prepassConstants.hasOcclusionMap = key & (1 << 4);
+    prepassConstants.hasAnisotropicMap = key & (1 << 5);
+    //prepassConstants.flipVertically = YES;  // for sponza textures
+    //prepassConstants.sRGBTexture = YES;     // for sponza textures
+    prepassConstants.usesAnisotropy = key & (1 << 6);
+    prepassConstants.quantizedVertex = key & (1 << 7);
+    return prepassConstants;
+}
+
 - (void)renderSkybox:(id<MTLRenderCommandEncoder>)encoder {
-    encoder.label = @"Skybox";
     [encoder setRenderPipelineState: _renderPipelineSkybox];
     [encoder setDepthStencilState: _depthStencil];
     [encoder setCullMode: MTLCullModeBack];
@@ -353,11 +771,9 @@
                     vertexStart: 0
                     vertexCount: 36];
     }
-    [encoder endEncoding];
 }
 
 - (void)renderGBuffer:(id<MTLRenderCommandEncoder>)encoder {
-    encoder.label = @"G-buffer";
     [encoder setCullMode: MTLCullModeBack];
     [encoder setDepthStencilState: _depthStencil];
     
@@ -369,24 +785,27 @@
                         offset: _currentBufferIndex * (sizeof(camera_props_t) * MAX_NUM_CAMS)
                        atIndex: 1];
     
+    // material table
+    [encoder setFragmentBuffer: _materialsBuffer
+                        offset: _materialsBufferOffset
+                       atIndex: 3];
+    
     // draw call
-    if(_cameraComponents.count > 0) {
-        MGPDrawCallList *drawCalls = [self drawCallListWithFrustum: _cameraComponents[0].frustum];
-        [self renderDrawCalls:drawCalls
+    if(_cameraDrawCallList) {
+        [self renderDrawCalls:_cameraDrawCallList
                  bindTextures:YES
           instanceBufferIndex:2
                       encoder:encoder];
     }
-    
-    [encoder endEncoding];
 }
 
 - (void)renderShadows:(id<MTLCommandBuffer>)buffer {
     if(_lightComponents.count == 0) return;
     
-    for(NSUInteger i = 0, count = _lightComponents.count; i < count; i++) {
+    for(NSUInteger i = 0, count = _lightComponents.count, shadowIndex = 0; i < count; i++) {
         MGPLightComponent *lightComponent = _lightComponents[i];
         if(lightComponent.castShadows) {
+            MGPDrawCallList *drawCallList = _shadowDrawCallLists[shadowIndex++];
             MGPShadowBuffer *shadowBuffer = [_shadowManager newShadowBufferForLightComponent: lightComponent
                                                                                   resolution: DEFAULT_SHADOW_RESOLUTION
                                                                                cascadeLevels: 1];
@@ -405,8 +824,6 @@
                                   offset: _currentBufferIndex * sizeof(light_global_t)
                                  atIndex: 2];
                 
-                MGPDrawCallList *drawCallList = [self drawCallListWithFrustum:lightComponent.frustum];
-                
                 [self renderDrawCalls:drawCallList
                          bindTextures:NO
                   instanceBufferIndex:3
@@ -419,7 +836,6 @@
 }
 
 - (void)computeLightCullGrid:(id<MTLComputeCommandEncoder>)encoder {
-    encoder.label = @"Light Culling";
     
     [encoder setComputePipelineState: _computePipelineLightCulling];
     NSUInteger tileSize = LIGHT_CULL_GRID_TILE_SIZE;
@@ -444,7 +860,6 @@
                 atIndex: 0];
     [encoder dispatchThreadgroups:threadSize
             threadsPerThreadgroup:MTLSizeMake(tileSize, tileSize, 1)];
-    [encoder endEncoding];
 }
 
 - (void)renderDirectLighting:(id<MTLRenderCommandEncoder>)encoder {
@@ -454,7 +869,6 @@
     id<MTLRenderPipelineState> shadingPipeline = [_gBuffer shadingPipelineStateWithConstants: shadingConstants
                                                                                        error: nil];
     
-    encoder.label = @"Direct Lighting";
     [encoder setRenderPipelineState: shadingPipeline];
     [encoder setCullMode: MTLCullModeBack];
     [encoder setFragmentBuffer: _cameraPropsBuffer
@@ -485,8 +899,6 @@
     [encoder drawPrimitives: MTLPrimitiveTypeTriangle
                 vertexStart: 0
                 vertexCount: 3];
-    
-    [encoder endEncoding];
 }
 
 - (void)renderIndirectLighting:(id<MTLRenderCommandEncoder>)encoder {
@@ -499,7 +911,6 @@
     id<MTLRenderPipelineState> renderPipeline = [_gBuffer indirectLightingPipelineStateWithConstants:shadingConstants
                                                                                                error:nil];
     
-    encoder.label = @"Indirect Lighting";
     [encoder setRenderPipelineState: renderPipeline];
     [encoder setCullMode: MTLCullModeBack];
     [encoder setFragmentBuffer: _cameraPropsBuffer
@@ -536,8 +947,6 @@
     [encoder drawPrimitives: MTLPrimitiveTypeTriangle
                 vertexStart: 0
                 vertexCount: 3];
-    
-    [encoder endEncoding];
 }
 
 - (void)renderDirectionalShadowedLighting:(id<MTLRenderCommandEncoder>)encoder {
@@ -549,7 +958,6 @@
     id<MTLRenderPipelineState> renderPipeline = [_gBuffer directionalShadowedLightingPipelineStateWithConstants:shadingConstants
                                                                                                           error:nil];
 
-    encoder.label = @"Directional Shadowed Lighting";
     [encoder setRenderPipelineState: renderPipeline];
     [encoder setCullMode: MTLCullModeBack];
     [encoder setFragmentBuffer: _cameraPropsBuffer
@@ -593,12 +1001,9 @@
 
         }
     }
-    
-    [encoder endEncoding];
 }
 
 - (void)renderFramebuffer:(id<MTLRenderCommandEncoder>)encoder {
-    encoder.label = @"Present";
     
     if(_gBufferIndex == 6) {
         // Draw light-culling tiles
@@ -620,8 +1025,6 @@
     [encoder drawPrimitives: MTLPrimitiveTypeTriangle
                 vertexStart: 0
                 vertexCount: 3];
-    
-    [encoder endEncoding];
 }
 
 - (id<MTLTexture>)_presentationGBuferTexture {
@@ -20,6 +20,7 @@ typedef struct MGPGBufferPrepassFunctionConstants {
     bool flipVertically;
     bool sRGBTexture;
     bool usesAnisotropy;
+    bool quantizedVertex;       // vertices in quantizedVertexDescriptor
 } MGPGBufferPrepassFunctionConstants;
 
 typedef struct MGPGBufferShadingFunctionConstants {
@@ -72,6 +73,8 @@ typedef NS_OPTIONS(NSUInteger, MGPGBufferAttachmentType) {
 
 // base vertex descriptor
 @property (readonly) MTLVertexDescriptor *baseVertexDescriptor;
+// 20 bytes instead of 44, see MGPVertexQuantizer
+@property (readonly) MTLVertexDescriptor *quantizedVertexDescriptor;
 
 // render pass
 @property (readonly) MTLRenderPassDescriptor *renderPassDescriptor;
@@ -17,6 +17,7 @@
     CGSize _size;
     MGPGBufferAttachmentType _attachments;
     MTLVertexDescriptor *_baseVertexDescriptor;
+    MTLVertexDescriptor *_quantizedVertexDescriptor;
     MTLRenderPassDescriptor *_renderPassDescriptor;
     MTLRenderPassDescriptor *_lightingPassBaseDescriptor;
     MTLRenderPassDescriptor *_lightingPassAddDescriptor;
@@ -92,6 +93,7 @@
     
     [self _makeGBufferTextures];
     [self _makeBaseVertexDescriptor];
+    [self _makeQuantizedVertexDescriptor];
     [self _makeRenderPipelineDescriptor];
     [self _makeLightingPipelineDescriptor];
     [self _makeIndirectLightingPipelineDescriptor];
@@ -205,6 +207,26 @@
     _baseVertexDescriptor.layouts[0].stepFunction = MTLVertexStepFunctionPerVertex;
 }
 
+- (void)_makeQuantizedVertexDescriptor {
+    // same as mgp_quantized_vertex_t
+    _quantizedVertexDescriptor = [[MTLVertexDescriptor alloc] init];
+    _quantizedVertexDescriptor.attributes[attrib_pos].format = MTLVertexFormatUShort4Normalized;
+    _quantizedVertexDescriptor.attributes[attrib_pos].offset = 0;
+    _quantizedVertexDescriptor.attributes[attrib_pos].bufferIndex = 0;
+    _quantizedVertexDescriptor.attributes[attrib_uv].format = MTLVertexFormatHalf2;
+    _quantizedVertexDescriptor.attributes[attrib_uv].offset = 8;
+    _quantizedVertexDescriptor.attributes[attrib_uv].bufferIndex = 0;
+    _quantizedVertexDescriptor.attributes[attrib_normal].format = MTLVertexFormatShort2Normalized;
+    _quantizedVertexDescriptor.attributes[attrib_normal].offset = 12;
+    _quantizedVertexDescriptor.attributes[attrib_normal].bufferIndex = 0;
+    _quantizedVertexDescriptor.attributes[attrib_tangent].format = MTLVertexFormatShort2Normalized;
+    _quantizedVertexDescriptor.attributes[attrib_tangent].offset = 16;
+    _quantizedVertexDescriptor.attributes[attrib_tangent].bufferIndex = 0;
+    _quantizedVertexDescriptor.layouts[0].stride = 20;
+    _quantizedVertexDescriptor.layouts[0].stepRate = 1;
+    _quantizedVertexDescriptor.layouts[0].stepFunction = MTLVertexStepFunctionPerVertex;
+}
+
 - (void)_makeRenderPipelineDescriptor {
     MTLRenderPipelineDescriptor *desc = [[MTLRenderPipelineDescriptor alloc] init];
     desc.label = @"G-buffer";
@@ -337,6 +359,10 @@
     return _baseVertexDescriptor;
 }
 
+- (MTLVertexDescriptor *)quantizedVertexDescriptor {
+    return _quantizedVertexDescriptor;
+}
+
 - (MTLRenderPassDescriptor *)renderPassDescriptor {
     return [self prePassDescriptorWithAttachment:_attachments];
 }
@@ -504,6 +530,7 @@
     bitflag |= constants.flipVertically ? (1L << fcv_flip_vertically) : 0;
     bitflag |= constants.sRGBTexture ? (1L << fcv_srgb_texture) : 0;
     bitflag |= constants.usesAnisotropy ? (1L << fcv_uses_anisotropy) : 0;
+    bitflag |= constants.quantizedVertex ? (1L << fcv_quantized_vertex) : 0;
     
     NSNumber *key = @(bitflag);
     id<MTLRenderPipelineState> renderPipelineState = [_renderPipelineDict objectForKey: key];
@@ -537,7 +564,11 @@
         [constantValues setConstantValue: &constants.usesAnisotropy
                                     type: MTLDataTypeBool
                                  atIndex: fcv_uses_anisotropy];
+        [constantValues setConstantValue: &constants.quantizedVertex
+                                    type: MTLDataTypeBool
+                                 atIndex: fcv_quantized_vertex];
         
+        _renderPipelineDescriptor.vertexDescriptor = constants.quantizedVertex ? _quantizedVertexDescriptor : _baseVertexDescriptor;
         _renderPipelineDescriptor.vertexFunction = [_library newFunctionWithName: @"gbuffer_prepass_vert"
                                                                   constantValues: constantValues
                                                                            error: error];
@@ -568,6 +599,7 @@
     bitflag |= constants.flipVertically ? (1L << fcv_flip_vertically) : 0;
     bitflag |= constants.sRGBTexture ? (1L << fcv_srgb_texture) : 0;
     bitflag |= constants.usesAnisotropy ? (1L << fcv_uses_anisotropy) : 0;
+    bitflag |= constants.quantizedVertex ? (1L << fcv_quantized_vertex) : 0;
     
     NSNumber *key = @(bitflag);
     id<MTLRenderPipelineState> renderPipelineState = [_renderPipelineDict objectForKey: key];
@@ -601,7 +633,11 @@
         [constantValues setConstantValue: &constants.usesAnisotropy
                                     type: MTLDataTypeBool
                                  atIndex: fcv_uses_anisotropy];
+        [constantValues setConstantValue: &constants.quantizedVertex
+                                    type: MTLDataTypeBool
+                                 atIndex: fcv_quantized_vertex];
         
+        _renderPipelineDescriptor.vertexDescriptor = constants.quantizedVertex ? _quantizedVertexDescriptor : _baseVertexDescriptor;
         _renderPipelineDescriptor.vertexFunction = [_library newFunctionWithName: @"gbuffer_prepass_vert"
                                                                   constantValues: constantValues
                                                                            error: error];
@@ -59,8 +59,21 @@ NSString * const MGPPostProcessingLayerErrorDomain = @"MGPPostProcessingLayerErr
     id<MTLBuffer> _ssaoRandomSamplesBuffer;
     id<MTLBuffer> _ssaoPropsBuffer;
     CGSize _destinationResolution;
+    
+    // temporary textures, aliased by their lifetimes
+    MGPTransientTextureSet *_transientTextures;
+    NSUInteger _blurTextureIndex, _deinterleavedTextureIndex, _interleavedTextureIndex;
 }
 
+// SSAO steps, in encoding order
+typedef enum {
+    ssao_step_deinterleave,
+    ssao_step_ssao,
+    ssao_step_blur_horizontal,
+    ssao_step_blur_vertical,
+    ssao_step_interleave
+} ssao_step_t;
+
 - (instancetype)initWithDevice:(id<MTLDevice>)device library:(id<MTLLibrary>)library {
     self = [super initWithDevice: device library: library];
     if(self) {
@@ -101,6 +114,44 @@ NSString * const MGPPostProcessingLayerErrorDomain = @"MGPPostProcessingLayerErr
     desc.storageMode = MTLStorageModePrivate;
     _ssaoTexture = [_device newTextureWithDescriptor: desc];
     _ssaoTexture.label = @"SSAO Texture";
+    
+    [self _makeTransientTexturesWithSSAODescriptor: desc];
+}
+
+- (void)_makeTransientTexturesWithSSAODescriptor: (MTLTextureDescriptor *)ssaoDescriptor {
+    if(_transientTextures == nil)
+        _transientTextures = [_postProcessing.textureManager newTransientTextureSet];
+    [_transientTextures removeAllTextures];
+    
+    // blur temporary, same size as the SSAO texture
+    _blurTextureIndex = [_transientTextures addTextureWithDescriptor: ssaoDescriptor
+                                                            firstUse: ssao_step_blur_horizontal
+                                                             lastUse: ssao_step_blur_vertical];
+    
+    // deinterleaved depth (2x2 -> 4 slices of half size), and interleaved result
+    NSUInteger width = MAX(1, (NSUInteger)_destinationResolution.width);
+    NSUInteger height = MAX(1, (NSUInteger)_destinationResolution.height);
+    MTLTextureDescriptor *desc = [MTLTextureDescriptor texture2DDescriptorWithPixelFormat: MTLPixelFormatR16Float
+                                                                                    width: MAX(1, width / 2)
+                                                                                   height: MAX(1, height / 2)
+                                                                                mipmapped: NO];
+    desc.textureType = MTLTextureType2DArray;
+    desc.arrayLength = 4;
+    desc.usage = MTLTextureUsageShaderRead | MTLTextureUsageShaderWrite;
+    desc.storageMode = MTLStorageModePrivate;
+    _deinterleavedTextureIndex = [_transientTextures addTextureWithDescriptor: desc
+                                                                     firstUse: ssao_step_deinterleave
+                                                                      lastUse: ssao_step_interleave];
+    
+    desc.textureType = MTLTextureType2D;
+    desc.arrayLength = 1;
+    desc.width = width;
+    desc.height = height;
+    _interleavedTextureIndex = [_transientTextures addTextureWithDescriptor: desc
+                                                                   firstUse: ssao_step_interleave
+                                                                    lastUse: ssao_step_interleave];
+    
+    [_transientTextures makeTextures];
 }
 
 - (void)_makeRandomSamples {
@@ -146,27 +197,12 @@ NSString * const MGPPostProcessingLayerErrorDomain = @"MGPPostProcessingLayerErr
            &props, sizeof(ssao_props_t));
     [_ssaoPropsBuffer didModifyRange: NSMakeRange(sizeof(ssao_props_t) * _postProcessing.currentBufferIndex, sizeof(ssao_props_t))];
     
-    // make temporary textures
-    id<MTLTexture> temporarySSAOTexture = nil;
-    id<MTLTexture> deinterleavedTextureArray = nil;
-    temporarySSAOTexture = [_postProcessing.textureManager newTemporaryTextureWithWidth:_ssaoTexture.width
-                                                                                 height:_ssaoTexture.height
-                                                                            pixelFormat:MTLPixelFormatR16Float
-                                                                            storageMode:MTLStorageModePrivate
-                                                                                  usage:MTLTextureUsageShaderRead | MTLTextureUsageShaderWrite
-                                                                       mipmapLevelCount:1
-                                                                            arrayLength:1];
+    // temporary textures
     _type = MGPSSAOTypeAdaptive;
-    if(_type == MGPSSAOTypeAdaptive) {
-        deinterleavedTextureArray = [_postProcessing.textureManager newTemporaryTextureWithWidth:_destinationResolution.width / 2
-                                                                                          height:_destinationResolution.height / 2
-                                                                                     pixelFormat:MTLPixelFormatR16Float
-                                                                                     storageMode:MTLStorageModePrivate
-                                                                                           usage:MTLTextureUsageShaderRead | MTLTextureUsageShaderWrite
-                                                                                mipmapLevelCount:1
-                                                                                     arrayLength:4];
-    }
-    
+    id<MTLTexture> temporarySSAOTexture = [_transientTextures textureAtIndex: _blurTextureIndex];
+    id<MTLTexture> deinterleavedTextureArray = [_transientTextures textureAtIndex: _deinterleavedTextureIndex];
+    id<MTLTexture> interleavedTexture = [_transientTextures textureAtIndex: _interleavedTextureIndex];
+    id<MTLFence> transientTexturesFence = _transientTextures.fence;
     
     NSUInteger width = _ssaoTexture.width, height = _ssaoTexture.height;
     MGPGBuffer *gBuffer = _postProcessing.gBuffer;
@@ -176,6 +212,10 @@ NSString * const MGPPostProcessingLayerErrorDomain = @"MGPPostProcessingLayerErr
     id<MTLComputeCommandEncoder> encoder = [buffer computeCommandEncoder];
     [encoder setLabel: @"SSAO"];
     
+    // previous frame may still use the aliased memory
+    if(transientTexturesFence)
+        [encoder waitForFence: transientTexturesFence];
+    
     // num threads, threadgroups
     MTLSize threadsPerThreadgroup = MTLSizeMake(16, 16, 1);
     MTLSize threadgroups = MTLSizeMake((width+threadsPerThreadgroup.width-1)/threadsPerThreadgroup.width,
@@ -229,24 +269,16 @@ NSString * const MGPPostProcessingLayerErrorDomain = @"MGPPostProcessingLayerErr
     
     // interleave
     if(_type == MGPSSAOTypeAdaptive) {
-        temporarySSAOTexture = [_postProcessing.textureManager newTemporaryTextureWithWidth:_destinationResolution.width
-                                                                                     height:_destinationResolution.height
-                                                                                pixelFormat:MTLPixelFormatR16Float
-                                                                                storageMode:MTLStorageModePrivate
-                                                                                      usage:MTLTextureUsageShaderRead | MTLTextureUsageShaderWrite
-                                                                           mipmapLevelCount:1
-                                                                                arrayLength:1];
-        
         [encoder setComputePipelineState: _interleave2x2Pipeline];
         [encoder setTexture:deinterleavedTextureArray atIndex:0];
-        [encoder setTexture:temporarySSAOTexture atIndex:1];
+        [encoder setTexture:interleavedTexture atIndex:1];
         [encoder dispatchThreadgroups:threadgroups2
                 threadsPerThreadgroup:threadsPerThreadgroup];
     }
     
+    if(transientTexturesFence)
+        [encoder updateFence: transientTexturesFence];
     [encoder endEncoding];
-    
-    [_postProcessing.textureManager releaseTemporaryTexture:temporarySSAOTexture];
 }
 
 - (void)resize: (CGSize)newSize {
@@ -8,6 +8,7 @@
 
 #import "MGPRenderer.h"
 #import "SharedStructures.h"
+#import "../Model/MGPMeshlets.h"
 @import Metal;
 
 NS_ASSUME_NONNULL_BEGIN
@@ -35,6 +36,14 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic, readonly) NSUInteger instanceCount;
 @property (nonatomic, readonly) id<MTLBuffer> instancePropsBuffer;
 @property (nonatomic, readonly) NSUInteger instancePropsBufferOffset;
+@property (nonatomic, readonly) float depth;    // distance from the near plane to the nearest instance
+@property (nonatomic, readonly) NSUInteger lod; // level of detail of every instance
+
+// Meshlets some instance may see, as index ranges of each submesh.
+// Submeshes are drawn whole if usesClusterRanges is NO.
+@property (nonatomic, readonly) BOOL usesClusterRanges;
+- (const mgp_index_range_t *)clusterRangesOfSubmeshAtIndex: (NSUInteger)index
+                                                     count: (NSUInteger *)count;
 
 @end
 
@@ -42,6 +51,10 @@ NS_ASSUME_NONNULL_BEGIN
 
 @property (nonatomic, readonly) MGPFrustum *frustum;
 @property (nonatomic, readonly) NSArray<MGPDrawCall*> *drawCalls;
+@property (nonatomic, readonly) NSUInteger triangleCount;   // of all instances at their LODs
+// meshlets of the draw calls culled by clusters, and how many of them were culled
+@property (nonatomic, readonly) NSUInteger clusterCount;
+@property (nonatomic, readonly) NSUInteger culledClusterCount;
 
 @end
 
@@ -56,6 +69,10 @@ NS_ASSUME_NONNULL_BEGIN
     id<MTLBuffer> _lightPropsBuffer;
     id<MTLBuffer> _lightGlobalBuffer;
     
+    // Material table of mesh components, indexed by instance props
+    id<MTLBuffer> _materialsBuffer;
+    NSUInteger _materialsBufferOffset;
+    
     // Profiling
     float _CPUTime;
     float _GPUTime;
@@ -63,8 +80,25 @@ NS_ASSUME_NONNULL_BEGIN
 
 @property (nonatomic, readonly) MGPTextureManager *textureManager;
 @property (nonatomic) MGPScene *scene;
+// Hides meshes behind occluders in the first camera's view after frustum culling. (default : NO)
+@property (nonatomic) BOOL occlusionCullingEnabled;
+// Size of the ring buffer instance props are suballocated from, and the most bytes a frame has used.
+@property (nonatomic, readonly) NSUInteger instancePropsBufferSize;
+@property (nonatomic, readonly) NSUInteger instancePropsHighWaterMark;
+// Instances are drawn at the coarsest LOD whose error covers at most lodErrorThreshold pixels
+// of the view, judged by the bounding sphere. (default : 1)
+@property (nonatomic) float lodErrorThreshold;
+// Shadow views allow this many times the error of camera views. (default : 4)
+@property (nonatomic) float shadowLODBias;
+// Drops meshlets of LOD 0 that are off-screen or face away from every instance.
+// (default : YES, NO if its per-instance views couldn't be allocated)
+@property (nonatomic) BOOL clusterCullingEnabled;
+// Seconds the last drawCallListsWithFrustums: took, culling and picking LODs included.
+@property (nonatomic, readonly) float cullingTime;
 
 - (MGPDrawCallList *)drawCallListWithFrustum: (MGPFrustum *)frustum;
+// Culls every frustum in one pass and returns draw call lists in the same order.
+- (NSArray<MGPDrawCallList*> *)drawCallListsWithFrustums: (NSArray<MGPFrustum*> *)frustums;
 
 @end
 
@@ -16,36 +16,118 @@
 #import "../Model/MGPMesh.h"
 #import "../Model/MGPFrustum.h"
 #import "../Model/MGPBoundingVolume.h"
+#import "../Model/MGPCulling.h"
+#import "../Model/MGPBVH.h"
+#import "../Model/MGPOcclusionCulling.h"
+#import "../Model/MGPRingAllocator.h"
+#import "../Model/MGPMeshSimplifier.h"
 #import "../Utility/MGPTextureManager.h"
 #import "LightingCommon.h"
 
+#define OCCLUSION_BUFFER_WIDTH 256
+#define OCCLUSION_BUFFER_HEIGHT 128
+#define NO_DRAW_BUCKET UINT32_MAX
+#define INSTANCE_PROPS_BUFFER_INITIAL_SIZE (sizeof(instance_props_t) * MAX_NUM_INSTANCE * 4)
+#define INSTANCE_PROPS_ALIGNMENT 256
+
+typedef struct {
+    uint32_t index;
+    float score;
+} occluder_candidate_t;
+
+typedef struct {
+    float depthOffset;              // from the near plane to the eye
+    mgp_mesh_lod_view_t screen;
+} lod_view_t;
+
+static int compare_occluder_candidates(const void *a, const void *b) {
+    float lhs = ((const occluder_candidate_t *)a)->score;
+    float rhs = ((const occluder_candidate_t *)b)->score;
+    return (lhs < rhs) - (lhs > rhs);
+}
+
+// ring allocator backend, context is the MTLDevice
+static void *instance_props_buffer_create(void *context, size_t size, void **contents) {
+    id<MTLDevice> device = (__bridge id<MTLDevice>)context;
+    id<MTLBuffer> buffer = [device newBufferWithLength:size
+                                               options:MTLResourceStorageModeManaged];
+    if(buffer == nil)
+        return NULL;
+    buffer.label = @"Instance Props";
+    *contents = buffer.contents;
+    return (void *)CFBridgingRetain(buffer);
+}
+
+static void instance_props_buffer_destroy(void *context, void *buffer) {
+    CFBridgingRelease(buffer);
+}
+
+// realloc that keeps the array as it was if it fails
+static BOOL grow_array(void **array, size_t size) {
+    void *grown = realloc(*array, size);
+    if(grown == NULL)
+        return NO;
+    *array = grown;
+    return YES;
+}
+
 @interface MGPDrawCall ()
 @property (nonatomic) MGPMesh *mesh;
 @property (nonatomic, readwrite) NSUInteger instanceCount;
 @property (nonatomic, readwrite) id<MTLBuffer> instancePropsBuffer;
 @property (nonatomic, readwrite) NSUInteger instancePropsBufferOffset;
 @property (nonatomic, readwrite) instance_props_t instanceProps;
+@property (nonatomic, readwrite) float depth;
+@property (nonatomic, readwrite) NSUInteger lod;
+@property (nonatomic, readwrite) BOOL usesClusterRanges;
+// ranges of all submeshes, and where the ranges of each submesh end (NSUInteger)
+@property (nonatomic, readonly) NSMutableData *clusterRanges;
+@property (nonatomic, readonly) NSMutableData *clusterRangeEnds;
 @end
 
 @implementation MGPDrawCall
+
+- (instancetype)init {
+    self = [super init];
+    if(self) {
+        _clusterRanges = [NSMutableData new];
+        _clusterRangeEnds = [NSMutableData new];
+    }
+    return self;
+}
+
+- (const mgp_index_range_t *)clusterRangesOfSubmeshAtIndex:(NSUInteger)index
+                                                     count:(NSUInteger *)count {
+    const NSUInteger *ends = _clusterRangeEnds.bytes;
+    NSUInteger start = index > 0 ? ends[index - 1] : 0;
+    *count = ends[index] - start;
+    return (const mgp_index_range_t *)_clusterRanges.bytes + start;
+}
+
 @end
 
 @interface MGPDrawCallList ()
-- (instancetype)initWithFrustum: (MGPFrustum *)frustum
-                      drawCalls: (NSArray<MGPDrawCall*> *)drawCalls;
+@property (nonatomic, readwrite) MGPFrustum *frustum;
+@property (nonatomic, readonly) NSMutableArray<MGPDrawCall*> *mutableDrawCalls;
+@property (nonatomic, readwrite) NSUInteger triangleCount;
+@property (nonatomic, readwrite) NSUInteger clusterCount;
+@property (nonatomic, readwrite) NSUInteger culledClusterCount;
 @end
 
 @implementation MGPDrawCallList
 
-- (instancetype)initWithFrustum:(MGPFrustum *)frustum drawCalls:(NSArray<MGPDrawCall *> *)drawCalls {
+- (instancetype)init {
     self = [super init];
     if(self) {
-        _frustum = frustum;
-        _drawCalls = [NSArray arrayWithArray:drawCalls];
+        _mutableDrawCalls = [NSMutableArray new];
     }
     return self;
 }
 
+- (NSArray<MGPDrawCall *> *)drawCalls {
+    return _mutableDrawCalls;
+}
+
 @end
 
 @interface MGPSceneRenderer ()
@@ -53,18 +135,52 @@
 
 @implementation MGPSceneRenderer {
     MGPTextureManager *_textureManager;
-    NSMutableArray<id<MTLBuffer>> *_instancePropsBuffersList[kMaxBuffersInFlight];
-    NSUInteger _instancePropsBufferIndex;
-    NSUInteger _instancePropsBufferOffset;
+    mgp_ring_allocator_t *_instancePropsAllocator;
+    
+    // Culling
+    mgp_aabb_array_t _cullingVolumes;
+    mgp_bvh_t *_cullingTree;
+    NSArray<MGPMeshComponent*> *_cullingTreeComponents;
+    uint64_t *_visibility;
+    size_t _visibilityCapacity;
+    mgp_occlusion_t *_occlusionCuller;
+    
+    // Draw buckets, one per mesh, kept across frames
+    NSMapTable<MGPMesh*, NSNumber*> *_drawBucketIndices;
+    NSMutableArray *_drawBucketMeshes;              // MGPMesh, or NSNull if the bucket is free
+    uint32_t *_drawBucketSizes;
+    uint32_t *_drawBucketEnds;
+    size_t _drawBucketCapacity;
+    uint32_t *_componentDrawBuckets;                // per mesh component
+    const void **_componentMeshes;                  // mesh each component was bucketed with
+    uint32_t *_sortedComponentIndices;
+    uint8_t *_componentLODs;                        // of a draw bucket in a view
+    uint32_t *_lodSortedComponentIndices;
+    occluder_candidate_t *_occluderCandidates;
+    mgp_meshlet_view_t *_meshletViews;              // of the instances of a draw call
+    size_t _componentCapacity;
+    NSUInteger _numBucketedComponents;
+    BOOL _cullingArraysValid;                       // NO if culling volumes or draw buckets couldn't grow this frame
+    
+    // Draw calls reused every frame
+    NSMutableArray<MGPDrawCall*> *_drawCallPool;
+    NSMutableArray<MGPDrawCallList*> *_drawCallListPool;
+    NSMutableArray<NSMutableArray<MGPDrawCallList*>*> *_drawCallListArrayPool;
+    NSUInteger _numUsedDrawCalls, _numUsedDrawCallLists, _numUsedDrawCallListArrays;
 }
 
 - (instancetype)init {
     self = [super init];
     if(self) {
         // GPU-buffer
-        for(NSUInteger i = 0; i < kMaxBuffersInFlight; i++) {
-            _instancePropsBuffersList[i] = [NSMutableArray new];
-        }
+        mgp_ring_backend_t instancePropsBackend = {
+            .create_buffer = instance_props_buffer_create,
+            .destroy_buffer = instance_props_buffer_destroy,
+            .context = (__bridge void *)self.device
+        };
+        _instancePropsAllocator = mgp_ring_allocator_create(&instancePropsBackend,
+                                                            INSTANCE_PROPS_BUFFER_INITIAL_SIZE,
+                                                            kMaxBuffersInFlight);
         _lightGlobalBuffer = [self.device newBufferWithLength:sizeof(light_global_t)*kMaxBuffersInFlight
                                                       options:MTLResourceStorageModeManaged];
         _lightPropsBuffer = [self.device newBufferWithLength:sizeof(light_t)*kMaxBuffersInFlight*MAX_NUM_LIGHTS
@@ -79,45 +195,76 @@
         
         // texture manager
         _textureManager = [[MGPTextureManager alloc] initWithDevice:self.device];
+        
+        // culling
+        _cullingTree = mgp_bvh_create();
+        
+        // draw buckets
+        _drawBucketIndices = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsStrongMemory | NSPointerFunctionsObjectPointerPersonality
+                                                   valueOptions:NSPointerFunctionsStrongMemory];
+        _drawBucketMeshes = [NSMutableArray new];
+        _drawBucketCapacity = 16;
+        _drawBucketSizes = malloc(sizeof(uint32_t) * _drawBucketCapacity);
+        _drawBucketEnds = malloc(sizeof(uint32_t) * (_drawBucketCapacity + 1));
+        _drawCallPool = [NSMutableArray new];
+        _drawCallListPool = [NSMutableArray new];
+        _drawCallListArrayPool = [NSMutableArray new];
+        
+        // LOD
+        _lodErrorThreshold = 1.0f;
+        _shadowLODBias = 4.0f;
+        
+        // Cluster culling, planes are loaded aligned
+        _clusterCullingEnabled = YES;
+        if(posix_memalign((void **)&_meshletViews, _Alignof(mgp_meshlet_view_t), sizeof(mgp_meshlet_view_t) * MAX_NUM_INSTANCE) != 0) {
+            NSLog(@"Failed to allocate meshlet views, cluster culling is disabled.");
+            _meshletViews = NULL;
+            _clusterCullingEnabled = NO;
+        }
     }
     return self;
 }
 
+- (void)dealloc {
+    mgp_aabb_array_free(&_cullingVolumes);
+    mgp_bvh_destroy(_cullingTree);
+    free(_visibility);
+    free(_drawBucketSizes);
+    free(_drawBucketEnds);
+    free(_componentDrawBuckets);
+    free(_componentMeshes);
+    free(_sortedComponentIndices);
+    free(_componentLODs);
+    free(_lodSortedComponentIndices);
+    free(_occluderCandidates);
+    free(_meshletViews);
+    if(_occlusionCuller)
+        mgp_occlusion_destroy(_occlusionCuller);
+    mgp_ring_allocator_destroy(_instancePropsAllocator);
+}
+
 - (void)beginFrame {
     [super beginFrame];
     
-    // collects cameras, lights, meshes...
-    NSMutableArray *nodes = [NSMutableArray new];
-    [nodes addObject: _scene.rootNode];
-    while(nodes.count > 0) {
-        MGPSceneNode *node = [nodes lastObject];
-        [nodes removeLastObject];
-        
-        if(node.enabled) {
-            for(MGPSceneNodeComponent *comp in node.components) {
-                if(!comp.enabled) continue;
-                
-                if([comp isKindOfClass:MGPCameraComponent.class])
-                   [_cameraComponents addObject:(MGPCameraComponent*)comp];
-                else if([comp isKindOfClass:MGPLightComponent.class])
-                    [_lightComponents addObject:(MGPLightComponent*)comp];
-                else if([comp isKindOfClass:MGPMeshComponent.class])
-                    [_meshComponents addObject:(MGPMeshComponent*)comp];
-            }
-        
-            [nodes addObjectsFromArray:node.children];
-        }
-    }
+    // temporary textures unused for a while
+    [_textureManager beginFrame];
     
-    // sort lights by light type
-    [_lightComponents sortUsingComparator:
-     ^NSComparisonResult(MGPLightComponent* _Nonnull obj1, MGPLightComponent*  _Nonnull obj2) {
-        if(obj1.type < obj2.type)
-            return NSOrderedAscending;
-        else if(obj1.type > obj2.type)
-            return NSOrderedDescending;
-        return NSOrderedSame;
-    }];
+    // resolves transforms changed since the last frame
+    [MGPSceneNode updateWorldMatrices];
+    
+    // enabled cameras, lights (sorted by type), meshes registered in the scene
+    [_cameraComponents setArray:_scene.cameraComponents];
+    [_lightComponents setArray:_scene.lightComponents];
+    [_meshComponents setArray:_scene.meshComponents];
+    
+    // world-space bounding volumes for culling
+    BOOL cullingVolumesValid = [self _updateCullingVolumes];
+    
+    // draw buckets of added, removed or changed mesh components
+    _cullingArraysValid = [self _updateDrawBuckets] && cullingVolumesValid;
+    _numUsedDrawCalls = 0;
+    _numUsedDrawCallLists = 0;
+    _numUsedDrawCallListArrays = 0;
     
     // find first point light index
     NSUInteger numLights = MIN(MAX_NUM_LIGHTS, _lightComponents.count);
@@ -134,19 +281,12 @@
         }
     }
     
-    // initialize heap index and offset...
-    _instancePropsBufferIndex = 0;
-    _instancePropsBufferOffset = 0;
+    // instance props of the frame finished on GPU can be overwritten now
+    if(_instancePropsAllocator)
+        mgp_ring_allocator_begin_frame(_instancePropsAllocator);
     
-    // sort instance props buffers by size
-    [_instancePropsBuffersList[_currentBufferIndex] sortUsingComparator:
-     ^NSComparisonResult(id<MTLBuffer> b1, id<MTLBuffer> b2) {
-        if(b1.length > b2.length)
-            return NSOrderedAscending;
-        else if(b1.length < b2.length)
-            return NSOrderedDescending;
-        return NSOrderedSame;
-    }];
+    // update material table, instances refer to materials by mesh component index
+    [self _updateMaterialTable];
     
     // update light global buffer...
     light_global_t lightGlobalProps = _scene.lightGlobalProps;
@@ -191,106 +331,498 @@
 
 - (id<MTLBuffer>)makeInstancePropsBufferWithInstanceCount:(NSUInteger)instanceCount
                                                    offset:(NSUInteger*)offset {
-    id<MTLBuffer> buffer = nil;
-    NSUInteger instancePropsSize = sizeof(instance_props_t) * instanceCount;
-    
-    NSMutableArray<id<MTLBuffer>> *instancePropsBuffers = _instancePropsBuffersList[_currentBufferIndex];
-    BOOL newBuffer = NO;
-    for(; _instancePropsBufferIndex < instancePropsBuffers.count; _instancePropsBufferIndex++) {
-        buffer = instancePropsBuffers[_instancePropsBufferIndex];
-        if(instancePropsSize + _instancePropsBufferOffset > buffer.length) {
-            _instancePropsBufferIndex += 1;
-            _instancePropsBufferOffset = 0;
-            buffer = nil;
+    mgp_ring_allocation_t allocation;
+    if(_instancePropsAllocator == NULL ||
+       !mgp_ring_allocator_allocate(_instancePropsAllocator, sizeof(instance_props_t) * instanceCount,
+                                    INSTANCE_PROPS_ALIGNMENT, &allocation)) {
+        NSLog(@"Failed to allocate instance props buffer.");
+        return nil;
+    }
+    if(offset)
+        *offset = allocation.offset;
+    return (__bridge id<MTLBuffer>)allocation.buffer;
+}
+
+- (void)_updateMaterialTable {
+    NSUInteger count = _meshComponents.count;
+    mgp_ring_allocation_t allocation;
+    if(_instancePropsAllocator == NULL ||
+       !mgp_ring_allocator_allocate(_instancePropsAllocator, sizeof(material_t) * MAX(count, 1),
+                                    INSTANCE_PROPS_ALIGNMENT, &allocation)) {
+        NSLog(@"Failed to allocate material table.");
+        _materialsBuffer = nil;
+        _materialsBufferOffset = 0;
+        return;
+    }
+    
+    material_t *materials = (material_t *)allocation.contents;
+    for(NSUInteger i = 0; i < count; i++)
+        materials[i] = _meshComponents[i].material;
+    _materialsBuffer = (__bridge id<MTLBuffer>)allocation.buffer;
+    _materialsBufferOffset = allocation.offset;
+    [_materialsBuffer didModifyRange:NSMakeRange(_materialsBufferOffset, sizeof(material_t) * count)];
+}
+
+- (NSUInteger)instancePropsBufferSize {
+    mgp_ring_stats_t stats = {};
+    if(_instancePropsAllocator)
+        mgp_ring_allocator_get_stats(_instancePropsAllocator, &stats);
+    return stats.capacity;
+}
+
+- (NSUInteger)instancePropsHighWaterMark {
+    mgp_ring_stats_t stats = {};
+    if(_instancePropsAllocator)
+        mgp_ring_allocator_get_stats(_instancePropsAllocator, &stats);
+    return stats.highWaterMark;
+}
+
+- (MGPDrawCallList *)drawCallListWithFrustum:(MGPFrustum *)frustum {
+    return [self drawCallListsWithFrustums:@[frustum]][0];
+}
+
+- (NSArray<MGPDrawCallList *> *)drawCallListsWithFrustums:(NSArray<MGPFrustum *> *)frustums {
+    NSTimeInterval startTime = [NSDate timeIntervalSinceReferenceDate];
+    NSUInteger numViews = frustums.count;
+    NSUInteger count = _meshComponents.count;
+    size_t numWords = MGP_CULL_BITSET_WORDS(count);
+    
+    // Check mesh bounding volumes of all views at once...
+    mgp_cull_planes_t planes[MAX(1, numViews)];
+    for(NSUInteger i = 0; i < numViews; i++)
+        [frustums[i] getCullingPlanes:&planes[i]];
+    
+    if(!_cullingArraysValid)
+        return [self _emptyDrawCallListsWithFrustums:frustums];
+    if(numWords * numViews > _visibilityCapacity) {
+        if(!grow_array((void **)&_visibility, sizeof(uint64_t) * numWords * numViews * 2)) {
+            NSLog(@"Failed to allocate visibility of mesh components.");
+            return [self _emptyDrawCallListsWithFrustums:frustums];
         }
-        else {
-            if(offset)
-                *offset = _instancePropsBufferOffset;
-            _instancePropsBufferOffset += instancePropsSize;
-            break;
+        _visibilityCapacity = numWords * numViews * 2;
+    }
+    mgp_bvh_cull_views(_cullingTree, planes, numViews, _visibility);
+    
+    // then hide mesh components behind occluders in the first camera's view
+    if(_occlusionCullingEnabled && _cameraComponents.count > 0) {
+        MGPCameraComponent *camera = _cameraComponents[0];
+        MGPFrustum *cameraFrustum = camera.frustum;
+        for(NSUInteger view = 0; view < numViews; view++) {
+            if(frustums[view] == cameraFrustum) {
+                [self _cullOccludedMeshComponentsWithCamera:camera
+                                                 visibility:_visibility + view * numWords];
+            }
+        }
+    }
+    
+    // sort each view's visible mesh components by draw bucket, then combine draw calls
+    NSUInteger numBuckets = _drawBucketMeshes.count;
+    NSMutableArray<MGPDrawCallList*> *drawCallLists = [self _nextDrawCallListArray];
+    for(NSUInteger view = 0; view < numViews; view++) {
+        const uint64_t *visibility = _visibility + view * numWords;
+        
+        memset(_drawBucketEnds, 0, sizeof(uint32_t) * (numBuckets + 1));
+        for(size_t word = 0; word < numWords; word++) {
+            for(uint64_t bits = visibility[word]; bits; bits &= bits - 1)
+                _drawBucketEnds[_componentDrawBuckets[(word << 6) + __builtin_ctzll(bits)] + 1]++;
+        }
+        for(NSUInteger b = 0; b < numBuckets; b++)
+            _drawBucketEnds[b + 1] += _drawBucketEnds[b];
+        for(size_t word = 0; word < numWords; word++) {
+            for(uint64_t bits = visibility[word]; bits; bits &= bits - 1) {
+                NSUInteger index = (word << 6) + __builtin_ctzll(bits);
+                _sortedComponentIndices[_drawBucketEnds[_componentDrawBuckets[index]]++] = (uint32_t)index;
+            }
+        }
+        
+        // _drawBucketEnds[b] is the end of bucket b now
+        MGPDrawCallList *drawCallList = [self _nextDrawCallList];
+        drawCallList.frustum = frustums[view];
+        lod_view_t lodView = [self _lodViewWithFrustum:frustums[view]];
+        for(NSUInteger b = 0, first = 0; b < numBuckets; first = _drawBucketEnds[b++]) {
+            if(_drawBucketEnds[b] == first)
+                continue;
+            [self _appendDrawCallsForMesh:_drawBucketMeshes[b]
+                         componentIndices:_sortedComponentIndices + first
+                                    count:_drawBucketEnds[b] - first
+                                   planes:&planes[view]
+                                      eye:frustums[view].eye
+                                  lodView:&lodView
+                             drawCallList:drawCallList];
+        }
+        [drawCallLists addObject:drawCallList];
+    }
+    
+    _cullingTime = [NSDate timeIntervalSinceReferenceDate] - startTime;
+    return drawCallLists;
+}
+
+- (lod_view_t)_lodViewWithFrustum:(MGPFrustum *)frustum {
+    BOOL shadowView = YES;
+    for(MGPCameraComponent *camera in _cameraComponents) {
+        if(camera.frustum == frustum)
+            shadowView = NO;
+    }
+    
+    MGPProjectionState proj = frustum.projectionState;
+    float allowedPixels = MAX(_lodErrorThreshold, 1e-3f) * (shadowView ? _shadowLODBias : 1.0f);
+    lod_view_t lodView = {
+        .depthOffset = proj.nearPlane,
+        .screen = {
+            .orthographicHalfHeight = proj.orthographicSize * 0.5f * proj.orthographicRate,
+            .tanHalfFov = tanf(proj.fieldOfView * 0.5f) * (1.0f - proj.orthographicRate),
+            .pixelScale = self.scaledSize.height * 0.5f / allowedPixels
         }
+    };
+    return lodView;
+}
+
+// Picks the LOD of each instance, then draws instances of a LOD together.
+- (void)_appendDrawCallsForMesh:(MGPMesh *)mesh
+               componentIndices:(const uint32_t *)componentIndices
+                          count:(NSUInteger)count
+                         planes:(const mgp_cull_planes_t *)planes
+                            eye:(simd_float4)eye
+                        lodView:(const lod_view_t *)lodView
+                   drawCallList:(MGPDrawCallList *)drawCallList {
+    NSUInteger lodCount = MIN(mesh.lodCount, MGP_MESH_MAX_LODS);
+    if(lodCount <= 1) {
+        [self _appendDrawCallsForMesh:mesh
+                                  lod:0
+                     componentIndices:componentIndices
+                                count:count
+                               planes:planes
+                                  eye:eye
+                         drawCallList:drawCallList];
+        return;
     }
-    if(buffer == nil) {
-        newBuffer = YES;
+    
+    float lodErrors[MGP_MESH_MAX_LODS];
+    for(NSUInteger lod = 0; lod < lodCount; lod++)
+        lodErrors[lod] = [mesh lodErrorAtIndex:lod];
+    
+    uint32_t lodEnds[MGP_MESH_MAX_LODS + 1] = {};
+    for(NSUInteger i = 0; i < count; i++) {
+        uint32_t index = componentIndices[i];
+        float radius = sqrtf(_cullingVolumes.extent_x[index] * _cullingVolumes.extent_x[index] +
+                             _cullingVolumes.extent_y[index] * _cullingVolumes.extent_y[index] +
+                             _cullingVolumes.extent_z[index] * _cullingVolumes.extent_z[index]);
+        // the nearest point of the sphere from the eye
+        float depth = planes->nx[0] * _cullingVolumes.center_x[index] +
+                      planes->ny[0] * _cullingVolumes.center_y[index] +
+                      planes->nz[0] * _cullingVolumes.center_z[index] + planes->d[0] + lodView->depthOffset - radius;
+        uint8_t lod = (uint8_t)mgp_mesh_select_lod(&lodView->screen, lodErrors, (uint32_t)lodCount, radius, depth);
+        _componentLODs[i] = lod;
+        lodEnds[lod + 1]++;
     }
+    for(NSUInteger lod = 0; lod < lodCount; lod++)
+        lodEnds[lod + 1] += lodEnds[lod];
+    for(NSUInteger i = 0; i < count; i++)
+        _lodSortedComponentIndices[lodEnds[_componentLODs[i]]++] = componentIndices[i];
     
-    if(newBuffer) {
-        // make new heap for instance props buffer
-        buffer = [self.device newBufferWithLength:MAX(instancePropsSize, sizeof(instance_props_t) * 64)
-                                          options:MTLResourceStorageModeManaged];
-        if(buffer) {
-            [instancePropsBuffers addObject:buffer];
-            if(offset)
-                *offset = 0;
-            _instancePropsBufferOffset = instancePropsSize;
+    // lodEnds[lod] is the end of the LOD now
+    for(NSUInteger lod = 0, first = 0; lod < lodCount; first = lodEnds[lod++]) {
+        if(lodEnds[lod] == first)
+            continue;
+        [self _appendDrawCallsForMesh:mesh
+                                  lod:lod
+                     componentIndices:_lodSortedComponentIndices + first
+                                count:lodEnds[lod] - first
+                               planes:planes
+                                  eye:eye
+                         drawCallList:drawCallList];
+    }
+}
+
+- (void)_appendDrawCallsForMesh:(MGPMesh *)mesh
+                            lod:(NSUInteger)lod
+               componentIndices:(const uint32_t *)componentIndices
+                          count:(NSUInteger)count
+                         planes:(const mgp_cull_planes_t *)planes
+                            eye:(simd_float4)eye
+                   drawCallList:(MGPDrawCallList *)drawCallList {
+    for(NSUInteger i = 0; i < count; i += MAX_NUM_INSTANCE) {
+        MGPDrawCall *drawCall = [self _nextDrawCall];
+        drawCall.mesh = mesh;
+        drawCall.lod = lod;
+        drawCall.instanceCount = MIN(MAX_NUM_INSTANCE, count - i);
+        drawCall.usesClusterRanges = NO;
+        if(lod == 0 && _clusterCullingEnabled && _meshletViews && mesh.meshletCount > 0) {
+            [self _cullClustersOfDrawCall:drawCall
+                         componentIndices:componentIndices + i
+                                   planes:planes
+                                      eye:eye
+                             drawCallList:drawCallList];
+            // every meshlet is out of sight
+            if(drawCall.instanceCount == 0)
+                continue;
         }
         else {
-            NSLog(@"Failed to create new instance props buffer.");
+            drawCallList.triangleCount += drawCall.instanceCount * [mesh triangleCountAtLOD:lod];
         }
+        NSUInteger instancePropsBufferOffset = 0;
+        drawCall.instancePropsBuffer = [self makeInstancePropsBufferWithInstanceCount:drawCall.instanceCount
+                                                                               offset:&instancePropsBufferOffset];
+        drawCall.instancePropsBufferOffset = instancePropsBufferOffset;
+        
+        // fill instance props into buffer
+        instance_props_t *contents = (instance_props_t *)(drawCall.instancePropsBuffer.contents + instancePropsBufferOffset);
+        float depth = FLT_MAX;
+        for(NSUInteger j = 0, k = i; j < drawCall.instanceCount; j++, k++) {
+            uint32_t index = componentIndices[k];
+            contents[j] = instance_props_make(_meshComponents[index].localToWorldMatrix, index);
+            
+            // distance from the near plane (the first one)
+            depth = MIN(depth, planes->nx[0] * _cullingVolumes.center_x[index] +
+                               planes->ny[0] * _cullingVolumes.center_y[index] +
+                               planes->nz[0] * _cullingVolumes.center_z[index] + planes->d[0]);
+        }
+        drawCall.depth = MAX(0.0f, depth);
+        [drawCall.instancePropsBuffer didModifyRange:NSMakeRange(drawCall.instancePropsBufferOffset, sizeof(instance_props_t) * drawCall.instanceCount)];
+        [drawCallList.mutableDrawCalls addObject:drawCall];
+    }
+}
+
+// Keeps the meshlets visible to any instance of the draw call, by frustum and normal cone
+// in the space of each instance.
+- (void)_cullClustersOfDrawCall:(MGPDrawCall *)drawCall
+               componentIndices:(const uint32_t *)componentIndices
+                         planes:(const mgp_cull_planes_t *)planes
+                            eye:(simd_float4)eye
+                   drawCallList:(MGPDrawCallList *)drawCallList {
+    NSUInteger instanceCount = drawCall.instanceCount;
+    for(NSUInteger j = 0; j < instanceCount; j++) {
+        simd_float4x4 localToWorldMatrix = _meshComponents[componentIndices[j]].localToWorldMatrix;
+        mgp_meshlet_view_make(&_meshletViews[j], planes, (const float *)&eye, (const float *)&localToWorldMatrix);
     }
     
-    return buffer;
+    NSArray<MGPSubmesh*> *submeshes = drawCall.mesh.submeshes;
+    // a range per meshlet at most, one for a submesh without meshlets
+    [drawCall.clusterRanges setLength:sizeof(mgp_index_range_t) * (drawCall.mesh.meshletCount + submeshes.count)];
+    [drawCall.clusterRangeEnds setLength:sizeof(NSUInteger) * submeshes.count];
+    mgp_index_range_t *ranges = drawCall.clusterRanges.mutableBytes;
+    NSUInteger *rangeEnds = drawCall.clusterRangeEnds.mutableBytes;
+    NSUInteger numRanges = 0, numIndices = 0;
+    for(NSUInteger s = 0; s < submeshes.count; s++) {
+        MGPSubmesh *submesh = submeshes[s];
+        NSData *meshlets = submesh.meshlets;
+        if(meshlets == nil) {
+            // drawn whole
+            ranges[numRanges++] = (mgp_index_range_t){ 0, (uint32_t)submesh.metalKitSubmesh.indexCount };
+            numIndices += submesh.metalKitSubmesh.indexCount;
+        }
+        else {
+            size_t meshletCount = meshlets.length / sizeof(mgp_meshlet_t);
+            size_t visibleCount = 0;
+            size_t count = mgp_meshlets_cull(ranges + numRanges, meshlets.bytes, meshletCount,
+                                             _meshletViews, instanceCount, &visibleCount);
+            for(size_t r = 0; r < count; r++)
+                numIndices += ranges[numRanges + r].count;
+            numRanges += count;
+            drawCallList.clusterCount += meshletCount;
+            drawCallList.culledClusterCount += meshletCount - visibleCount;
+        }
+        rangeEnds[s] = numRanges;
+    }
+    drawCall.usesClusterRanges = YES;
+    if(numIndices == 0)
+        drawCall.instanceCount = 0;
+    drawCallList.triangleCount += drawCall.instanceCount * (numIndices / 3);
 }
 
-- (MGPDrawCallList *)drawCallListWithFrustum:(MGPFrustum *)frustum {
-    NSMutableArray<MGPDrawCall*> *combinedDrawCalls = [NSMutableArray new];
+- (MGPDrawCall *)_nextDrawCall {
+    if(_numUsedDrawCalls == _drawCallPool.count)
+        [_drawCallPool addObject:[MGPDrawCall new]];
+    return _drawCallPool[_numUsedDrawCalls++];
+}
+
+- (MGPDrawCallList *)_nextDrawCallList {
+    if(_numUsedDrawCallLists == _drawCallListPool.count)
+        [_drawCallListPool addObject:[MGPDrawCallList new]];
+    MGPDrawCallList *drawCallList = _drawCallListPool[_numUsedDrawCallLists++];
+    [drawCallList.mutableDrawCalls removeAllObjects];
+    drawCallList.triangleCount = 0;
+    drawCallList.clusterCount = 0;
+    drawCallList.culledClusterCount = 0;
+    return drawCallList;
+}
+
+- (NSMutableArray<MGPDrawCallList*> *)_nextDrawCallListArray {
+    if(_numUsedDrawCallListArrays == _drawCallListArrayPool.count)
+        [_drawCallListArrayPool addObject:[NSMutableArray new]];
+    NSMutableArray<MGPDrawCallList*> *drawCallLists = _drawCallListArrayPool[_numUsedDrawCallListArrays++];
+    [drawCallLists removeAllObjects];
+    return drawCallLists;
+}
+
+// nothing to draw in any view, when culling arrays couldn't be allocated
+- (NSArray<MGPDrawCallList *> *)_emptyDrawCallListsWithFrustums:(NSArray<MGPFrustum *> *)frustums {
+    NSMutableArray<MGPDrawCallList*> *drawCallLists = [self _nextDrawCallListArray];
+    for(MGPFrustum *frustum in frustums) {
+        MGPDrawCallList *drawCallList = [self _nextDrawCallList];
+        drawCallList.frustum = frustum;
+        [drawCallLists addObject:drawCallList];
+    }
+    return drawCallLists;
+}
+
+- (void)_cullOccludedMeshComponentsWithCamera:(MGPCameraComponent *)camera
+                                   visibility:(uint64_t *)visibility {
+    if(_occlusionCuller == NULL) {
+        uint32_t numThreads = (uint32_t)MIN(4, NSProcessInfo.processInfo.activeProcessorCount);
+        _occlusionCuller = mgp_occlusion_create(OCCLUSION_BUFFER_WIDTH, OCCLUSION_BUFFER_HEIGHT, numThreads);
+    }
     
-    NSMutableDictionary<NSNumber*,MGPMesh*> *meshDict = [NSMutableDictionary dictionary];
-    NSMutableDictionary<NSNumber*,NSMutableArray<MGPMeshComponent*>*> *compListDict = [NSMutableDictionary dictionary];
+    camera_props_t cameraProps = camera.shaderProperties;
+    mgp_occlusion_begin(_occlusionCuller, (const float *)&cameraProps.viewProjection);
     
-    // collect mesh component list by mesh
-    for(MGPMeshComponent *meshComponent in _meshComponents) {
+    // visible occluders, the ones covering more of the screen first
+    NSUInteger count = _meshComponents.count;
+    occluder_candidate_t *candidates = _occluderCandidates;
+    size_t numCandidates = 0;
+    for(size_t word = 0; word < MGP_CULL_BITSET_WORDS(count); word++) {
+        uint64_t bits = visibility[word];
+        while(bits) {
+            uint32_t index = (uint32_t)((word << 6) + __builtin_ctzll(bits));
+            bits &= bits - 1;
+            if(_meshComponents[index].mesh.occluderIndices == nil)
+                continue;
+            
+            simd_float3 center = simd_make_float3(_cullingVolumes.center_x[index],
+                                                  _cullingVolumes.center_y[index],
+                                                  _cullingVolumes.center_z[index]);
+            simd_float3 extent = simd_make_float3(_cullingVolumes.extent_x[index],
+                                                  _cullingVolumes.extent_y[index],
+                                                  _cullingVolumes.extent_z[index]);
+            float distance = simd_distance(center, cameraProps.position);
+            candidates[numCandidates++] = (occluder_candidate_t){
+                index, simd_length(extent) / MAX(distance, cameraProps.nearPlane)
+            };
+        }
+    }
+    qsort(candidates, numCandidates, sizeof(occluder_candidate_t), compare_occluder_candidates);
+    
+    // add occluders until the triangle budget runs out
+    for(size_t i = 0; i < numCandidates; i++) {
+        MGPMeshComponent *meshComponent = _meshComponents[candidates[i].index];
         MGPMesh *mesh = meshComponent.mesh;
-        if(mesh == nil)
+        simd_float4x4 model = meshComponent.localToWorldMatrix;
+        if(!mgp_occlusion_add_occluder(_occlusionCuller,
+                                       mesh.occluderVertices.bytes,
+                                       mesh.occluderIndices.bytes,
+                                       mesh.occluderIndices.length / (sizeof(uint32_t) * 3),
+                                       (const float *)&model))
+            break;
+    }
+    
+    mgp_occlusion_rasterize(_occlusionCuller);
+    mgp_occlusion_cull_aabbs(_occlusionCuller, &_cullingVolumes, visibility);
+}
+
+// Returns NO if the volumes couldn't grow, the tree is left as it was.
+- (BOOL)_updateCullingVolumes {
+    NSUInteger count = _meshComponents.count;
+    
+    // gather world-space bounding boxes into SoA arrays
+    if(!mgp_aabb_array_resize(&_cullingVolumes, count)) {
+        NSLog(@"Failed to allocate culling volumes.");
+        return NO;
+    }
+    for(NSUInteger i = 0; i < count; i++) {
+        MGPMeshComponent *meshComponent = _meshComponents[i];
+        simd_float3 center = meshComponent.worldBoundsCenter;
+        simd_float3 extent = meshComponent.worldBoundsExtent;
+        mgp_aabb_array_set(&_cullingVolumes, i, (float *)&center, (float *)&extent);
+    }
+    
+    // rebuild the tree if mesh components are added or removed, otherwise refit moved ones
+    if(![_cullingTreeComponents isEqualToArray:_meshComponents]) {
+        mgp_bvh_build(_cullingTree, &_cullingVolumes);
+        _cullingTreeComponents = [_meshComponents copy];
+    }
+    else {
+        mgp_bvh_refit(_cullingTree, &_cullingVolumes);
+    }
+    return YES;
+}
+
+// Returns NO if an array couldn't grow, components that didn't get a bucket try again next frame.
+- (BOOL)_updateDrawBuckets {
+    NSUInteger count = _meshComponents.count;
+    if(count > _componentCapacity) {
+        size_t capacity = MAX(64, count * 2);
+        // arrays that grew before a failure are only larger than _componentCapacity
+        if(!grow_array((void **)&_componentDrawBuckets, sizeof(uint32_t) * capacity) ||
+           !grow_array((void **)&_componentMeshes, sizeof(const void *) * capacity) ||
+           !grow_array((void **)&_sortedComponentIndices, sizeof(uint32_t) * capacity) ||
+           !grow_array((void **)&_componentLODs, sizeof(uint8_t) * capacity) ||
+           !grow_array((void **)&_lodSortedComponentIndices, sizeof(uint32_t) * capacity) ||
+           !grow_array((void **)&_occluderCandidates, sizeof(occluder_candidate_t) * capacity)) {
+            NSLog(@"Failed to allocate draw buckets.");
+            return NO;
+        }
+        for(size_t i = _componentCapacity; i < capacity; i++) {
+            _componentDrawBuckets[i] = NO_DRAW_BUCKET;
+            _componentMeshes[i] = NULL;
+        }
+        _componentCapacity = capacity;
+    }
+    
+    // only components whose mesh differs from the last frame move between buckets
+    BOOL valid = YES;
+    for(NSUInteger i = 0; i < MAX(count, _numBucketedComponents); i++) {
+        MGPMesh *mesh = i < count ? _meshComponents[i].mesh : nil;
+        if(_componentMeshes[i] == (__bridge const void *)mesh)
             continue;
         
-        // Check mesh bounding volumes...
-        id<MGPBoundingVolume> volume = mesh.volume;
-        if([volume isCulledInFrustum:frustum])
+        if(_componentDrawBuckets[i] != NO_DRAW_BUCKET)
+            [self _releaseDrawBucket:_componentDrawBuckets[i]];
+        _componentDrawBuckets[i] = mesh ? [self _retainDrawBucketForMesh:mesh] : NO_DRAW_BUCKET;
+        if(mesh && _componentDrawBuckets[i] == NO_DRAW_BUCKET) {
+            _componentMeshes[i] = NULL;
+            valid = NO;
             continue;
-        
-        NSNumber *key = @((size_t)mesh);
-        if(![meshDict objectForKey:key])
-            meshDict[key] = mesh;
-        NSMutableArray<MGPMeshComponent*> *list = [compListDict objectForKey:key];
-        if(!list) {
-            list = [NSMutableArray array];
-            compListDict[key] = list;
         }
-        [list addObject:meshComponent];
-    }
-    
-    // Combine draw calls
-    for(NSNumber *key in compListDict) {
-        MGPMesh *mesh = meshDict[key];
-        NSMutableArray<MGPMeshComponent*> *list = compListDict[key];
-        for(NSUInteger i = 0; i < list.count; i += MAX_NUM_INSTANCE) {
-            MGPDrawCall *drawCall = [MGPDrawCall new];
-            drawCall.mesh = mesh;
-            drawCall.instanceCount = MIN(MAX_NUM_INSTANCE, list.count - i);
-            NSUInteger instancePropsBufferOffset = 0;
-            drawCall.instancePropsBuffer = [self makeInstancePropsBufferWithInstanceCount:drawCall.instanceCount
-                                                                                   offset:&instancePropsBufferOffset];
-            drawCall.instancePropsBufferOffset = instancePropsBufferOffset;
-
-            // fill instance props into buffer
-            instance_props_t *contents = (instance_props_t *)(drawCall.instancePropsBuffer.contents + instancePropsBufferOffset);
-            for(NSUInteger j = 0, k = i; j < drawCall.instanceCount; j++) {
-                contents[j] = list[k++].instanceProps;
+        _componentMeshes[i] = (__bridge const void *)mesh;
+    }
+    _numBucketedComponents = count;
+    return valid;
+}
+
+- (uint32_t)_retainDrawBucketForMesh:(MGPMesh *)mesh {
+    NSNumber *index = [_drawBucketIndices objectForKey:mesh];
+    if(index) {
+        _drawBucketSizes[index.unsignedIntValue]++;
+        return index.unsignedIntValue;
+    }
+    
+    // reuse a free bucket or add one
+    uint32_t bucket = (uint32_t)[_drawBucketMeshes indexOfObjectIdenticalTo:NSNull.null];
+    if(bucket == (uint32_t)NSNotFound) {
+        bucket = (uint32_t)_drawBucketMeshes.count;
+        if(bucket + 1 > _drawBucketCapacity) {
+            if(!grow_array((void **)&_drawBucketSizes, sizeof(uint32_t) * _drawBucketCapacity * 2) ||
+               !grow_array((void **)&_drawBucketEnds, sizeof(uint32_t) * (_drawBucketCapacity * 2 + 1))) {
+                NSLog(@"Failed to allocate draw buckets.");
+                return NO_DRAW_BUCKET;
             }
-            [drawCall.instancePropsBuffer didModifyRange:NSMakeRange(drawCall.instancePropsBufferOffset, sizeof(instance_props_t) * drawCall.instanceCount)];
-            [combinedDrawCalls addObject:drawCall];
+            _drawBucketCapacity *= 2;
         }
+        [_drawBucketMeshes addObject:mesh];
     }
-    
-    MGPDrawCallList *drawCallList = [[MGPDrawCallList alloc] initWithFrustum: frustum
-                                                                   drawCalls: combinedDrawCalls];
-    return drawCallList;
+    else {
+        _drawBucketMeshes[bucket] = mesh;
+    }
+    _drawBucketSizes[bucket] = 1;
+    [_drawBucketIndices setObject:@(bucket) forKey:mesh];
+    return bucket;
 }
 
-- (void)resize:(CGSize)newSize {
-    [super resize:newSize];
-    [_textureManager clearUnusedTemporaryTextures];
+- (void)_releaseDrawBucket:(uint32_t)bucket {
+    if(--_drawBucketSizes[bucket] == 0) {
+        [_drawBucketIndices removeObjectForKey:_drawBucketMeshes[bucket]];
+        _drawBucketMeshes[bucket] = NSNull.null;
+    }
 }
 
 @end
@@ -54,3 +54,39 @@ BOOL CreateDDSTextureFromFile(id<MTLDevice> device,
 #ifdef __cplusplus
 }
 #endif
+
+// DDS file mapped into memory. Headers are validated in place and
+// subresources are read straight from the mapping, without a copy of the file.
+@interface DDSTextureFile : NSObject
+
+@property (nonatomic, readonly) DDS_ALPHA_MODE alphaMode;
+@property (nonatomic, readonly) NSUInteger width;
+@property (nonatomic, readonly) NSUInteger height;
+@property (nonatomic, readonly) NSUInteger depth;
+@property (nonatomic, readonly) NSUInteger mipmapLevelCount;
+
+- (instancetype)initWithPath:(NSString *)path
+                       error:(NSError **)error;
+
+// Bytes of the level over every slice.
+- (NSUInteger)bytesOfMipmapLevel:(NSUInteger)level;
+
+// maxsize : mips larger than this are skipped and never read from the file, 0 keeps every mip.
+// Texture in CPU-visible storage, filled from the mapping.
+- (id<MTLTexture>)newTextureWithDevice:(id<MTLDevice>)device
+                               maxsize:(size_t)maxsize
+                                 usage:(MTLTextureUsage)usage
+                           storageMode:(MTLStorageMode)storageMode
+                             forceSRGB:(bool)forceSRGB
+                                 error:(NSError **)error;
+
+// Private texture, filled by the encoder from a buffer wrapping the mapping.
+// The file stays mapped until the command buffer no longer needs it.
+- (id<MTLTexture>)newPrivateTextureWithDevice:(id<MTLDevice>)device
+                                      maxsize:(size_t)maxsize
+                                        usage:(MTLTextureUsage)usage
+                                    forceSRGB:(bool)forceSRGB
+                                  blitEncoder:(id<MTLBlitCommandEncoder>)blit
+                                        error:(NSError **)error;
+
+@end
@@ -19,7 +19,12 @@
 #include <assert.h>
 #include <algorithm>
 #include <memory>
+#include <vector>
 #include <stdio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 //--------------------------------------------------------------------------------------
 // Macros
@@ -269,6 +274,19 @@ NSString * const DDSTextureErrorDomain = @"DDSTextureErrorDomain";
 //--------------------------------------------------------------------------------------
 namespace
 {
+    //--------------------------------------------------------------------------------------
+    NSError* MakeError(NSString* debugDescription, NSString* description)
+    {
+        return [NSError errorWithDomain: DDSTextureErrorDomain
+                                   code: -1
+                               userInfo: @{
+                                           NSDebugDescriptionErrorKey : debugDescription,
+                                           NSLocalizedDescriptionKey : description
+                                           }];
+    }
+    
+    //--------------------------------------------------------------------------------------
+    // Validates the headers in place, bitData points into ddsData
     //--------------------------------------------------------------------------------------
     BOOL LoadTextureDataFromMemory(const uint8_t* ddsData,
                                    size_t ddsDataSize,
@@ -282,13 +300,19 @@ namespace
             return NO;
         }
         
+        // File is too big for 32-bit allocation, so reject read
         if (ddsDataSize > UINT32_MAX)
         {
+            if (error != nil)
+                *error = MakeError(@"IO error", @"File is too big for 32-bit allocation");
             return NO;
         }
         
+        // Need at least enough data to fill the header and magic number to be a valid DDS
         if (ddsDataSize < (sizeof(uint32_t) + sizeof(DDS_HEADER)))
         {
+            if (error != nil)
+                *error = MakeError(@"IO error", [NSString stringWithFormat: @"File size is not valid - %lu < sizeof(uint32_t) + sizeof(DDS_HEADER)", ddsDataSize]);
             return NO;
         }
         
@@ -296,6 +320,8 @@ namespace
         auto dwMagicNumber = *reinterpret_cast<const uint32_t*>(ddsData);
         if (dwMagicNumber != DDS_MAGIC)
         {
+            if (error != nil)
+                *error = MakeError(@"IO error", @"Invalid magic number.");
             return NO;
         }
         
@@ -305,6 +331,8 @@ namespace
         if (hdr->size != sizeof(DDS_HEADER) ||
             hdr->ddspf.size != sizeof(DDS_PIXELFORMAT))
         {
+            if (error != nil)
+                *error = MakeError(@"IO error", @"Invalid header.");
             return NO;
         }
         
@@ -316,6 +344,8 @@ namespace
             // Must be long enough for both headers and magic value
             if (ddsDataSize < (sizeof(DDS_HEADER) + sizeof(uint32_t) + sizeof(DDS_HEADER_DXT10)))
             {
+                if (error != nil)
+                    *error = MakeError(@"IO error", @"Invalid DXT10 header.");
                 return NO;
             }
             
@@ -333,171 +363,44 @@ namespace
         return YES;
     }
     
-    BOOL LoadTextureDataFromFile(const char *filePath, std::unique_ptr<uint8_t[]>& ddsData, const DDS_HEADER** header, const uint8_t** bitData, size_t* bitSize, NSError** error)
+    //--------------------------------------------------------------------------------------
+    // Maps the whole file read-only, the mapping is rounded up to pages
+    //--------------------------------------------------------------------------------------
+    BOOL MapTextureDataFromFile(const char *filePath, void** mapping, size_t* mappingSize, size_t* fileSize, NSError** error)
     {
-        if (!header || !bitData || !bitSize)
+        int fd = open(filePath, O_RDONLY);
+        if (fd < 0)
         {
+            if (error != nil)
+                *error = MakeError(@"IO error", [NSString stringWithFormat: @"Couldn't open file at path : %s", filePath]);
             return NO;
         }
         
-        // open the file
-        FILE *file = fopen(filePath, "r");
-        if (!file)
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size <= 0)
         {
-            if(error != nil) {
-                *error = [NSError errorWithDomain: DDSTextureErrorDomain
-                                             code: -1
-                                         userInfo: @{
-                                                     NSDebugDescriptionErrorKey : @"IO error",
-                                                     NSLocalizedDescriptionKey : [NSString stringWithFormat: @"Couldn't open file at path : %s", filePath]
-                                                     }];
-            }
-            return false;
-        }
-        
-        // Get the file size
-        fseek(file, 0, SEEK_END);
-        size_t fileSize = ftell(file);
-        fseek(file, 0, SEEK_SET);
-        
-        // File is too big for 32-bit allocation, so reject read
-        if(fileSize > 0xffffffff) {
-            fclose(file);
-            
-            if(error != nil) {
-                *error = [NSError errorWithDomain: DDSTextureErrorDomain
-                                             code: -1
-                                         userInfo: @{
-                                                     NSDebugDescriptionErrorKey : @"IO error",
-                                                     NSLocalizedDescriptionKey : @"File is too big for 32-bit allocation"
-                                                     }];
-            }
-            
+            close(fd);
+            if (error != nil)
+                *error = MakeError(@"IO error", [NSString stringWithFormat: @"Couldn't get size of file at path : %s", filePath]);
             return NO;
         }
         
-        // Need at least enough data to fill the header and magic number to be a valid DDS
-        if (fileSize < (sizeof(uint32_t) + sizeof(DDS_HEADER)))
+        size_t pageSize = (size_t)getpagesize();
+        *fileSize = (size_t)st.st_size;
+        *mappingSize = (*fileSize + pageSize - 1) / pageSize * pageSize;
+        *mapping = mmap(nullptr, *mappingSize, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (*mapping == MAP_FAILED)
         {
-            fclose(file);
-            
-            
-            if(error != nil) {
-                *error = [NSError errorWithDomain: DDSTextureErrorDomain
-                                             code: -1
-                                         userInfo: @{
-                                                     NSDebugDescriptionErrorKey : @"IO error",
-                                                     NSLocalizedDescriptionKey : [NSString stringWithFormat: @"File size is not valid - %lu < sizeof(uint32_t) + sizeof(DDS_HEADER)", fileSize]
-                                                     }];
-            }
-            
-            return NO;
-        }
-        
-        // create enough space for the file data
-        uint8_t *ddsDataBuffer = new (std::nothrow) uint8_t[fileSize];
-        ddsData.reset(ddsDataBuffer);
-        if (!ddsData)
-        {
-            fclose(file);
-            
-            if(error != nil) {
-                *error = [NSError errorWithDomain: DDSTextureErrorDomain
-                                             code: -1
-                                         userInfo: @{
-                                                     NSDebugDescriptionErrorKey : @"Memory allocation error",
-                                                     NSLocalizedDescriptionKey : @"Couldn't allocate DDS data buffer."
-                                                     }];
-            }
-            
-            return NO;
-        }
-        
-        // read the data in
-        size_t bytesRead = fread(ddsDataBuffer, 1, fileSize, file);
-        if (bytesRead < fileSize)
-        {
-            fclose(file);
-            
-            if(error != nil) {
-                *error = [NSError errorWithDomain: DDSTextureErrorDomain
-                                             code: -1
-                                         userInfo: @{
-                                                     NSDebugDescriptionErrorKey : @"IO error",
-                                                     NSLocalizedDescriptionKey : [NSString stringWithFormat: @"File size is not valid - bytesRead(%lu) < fileSize(%lu)", bytesRead, fileSize]
-                                                     }];
-            }
-            
-            
+            *mapping = nullptr;
+            if (error != nil)
+                *error = MakeError(@"IO error", [NSString stringWithFormat: @"Couldn't map file at path : %s", filePath]);
             return NO;
         }
         
-        fclose(file);
-        
-        // DDS files always start with the same magic number ("DDS ")
-        auto dwMagicNumber = *reinterpret_cast<const uint32_t*>(ddsData.get());
-        if (dwMagicNumber != DDS_MAGIC)
-        {
-            if(error != nil) {
-                *error = [NSError errorWithDomain: DDSTextureErrorDomain
-                                             code: -1
-                                         userInfo: @{
-                                                     NSDebugDescriptionErrorKey : @"IO error",
-                                                     NSLocalizedDescriptionKey : @"Invalid magic number."
-                                                     }];
-            }
-            
-            return NO;
-        }
-        
-        auto hdr = reinterpret_cast<const DDS_HEADER*>(ddsData.get() + sizeof(uint32_t));
-        
-        // Verify header to validate DDS file
-        if (hdr->size != sizeof(DDS_HEADER) ||
-            hdr->ddspf.size != sizeof(DDS_PIXELFORMAT))
-        {
-            if(error != nil) {
-                *error = [NSError errorWithDomain: DDSTextureErrorDomain
-                                             code: -1
-                                         userInfo: @{
-                                                     NSDebugDescriptionErrorKey : @"IO error",
-                                                     NSLocalizedDescriptionKey : @"Invalid header."
-                                                     }];
-            }
-            
-            return NO;
-        }
-        
-        // Check for DX10 extension
-        bool bDXT10Header = false;
-        if ((hdr->ddspf.flags & DDS_FOURCC) &&
-            (MAKEFOURCC('D', 'X', '1', '0') == hdr->ddspf.fourCC))
-        {
-            // Must be long enough for both headers and magic value
-            if (fileSize < (sizeof(DDS_HEADER) + sizeof(uint32_t) + sizeof(DDS_HEADER_DXT10)))
-            {
-                if(error != nil) {
-                    *error = [NSError errorWithDomain: DDSTextureErrorDomain
-                                                 code: -1
-                                             userInfo: @{
-                                                         NSDebugDescriptionErrorKey : @"IO error",
-                                                         NSLocalizedDescriptionKey : @"Invalid DXT10 header."
-                                                         }];
-                }
-                
-                return NO;
-            }
-            
-            bDXT10Header = true;
-        }
-        
-        // setup the pointers in the process request
-        *header = hdr;
-        ptrdiff_t offset = sizeof(uint32_t) + sizeof(DDS_HEADER)
-        + (bDXT10Header ? sizeof(DDS_HEADER_DXT10) : 0);
-        *bitData = ddsDataBuffer + offset;
-        *bitSize = fileSize - offset;
-        
+        // pages are read on first touch, skipped mips are never read
+        // (see PrefetchSubresources)
+        madvise(*mapping, *mappingSize, MADV_SEQUENTIAL);
         return YES;
     }
     
@@ -699,20 +602,25 @@ namespace
     }
     
     //--------------------------------------------------------------------------------------
-    bool FillInitData(id<MTLTexture> texture,
-                      size_t width,
-                      size_t height,
-                      size_t depth,
-                      size_t mipCount,
-                      size_t arraySize,
-                      MTLPixelFormat format,
-                      size_t maxsize,
-                      size_t bitSize,
-                      const uint8_t* bitData,
-                      size_t& twidth,
-                      size_t& theight,
-                      size_t& tdepth,
-                      size_t& skipMip)
+    // Calls upload(level, slice, width, height, depth, bits, rowBytes, numBytes) for every
+    // subresource within maxsize, each checked to lie inside bitData before it's passed.
+    // Levels are counted from the first retained one.
+    //--------------------------------------------------------------------------------------
+    template<typename UploadFunction>
+    bool ForEachSubresource(size_t width,
+                            size_t height,
+                            size_t depth,
+                            size_t mipCount,
+                            size_t arraySize,
+                            MTLPixelFormat format,
+                            size_t maxsize,
+                            size_t bitSize,
+                            const uint8_t* bitData,
+                            size_t& twidth,
+                            size_t& theight,
+                            size_t& tdepth,
+                            size_t& skipMip,
+                            UploadFunction upload)
     {
         if ( !bitData )
         {
@@ -745,6 +653,12 @@ namespace
                                nullptr
                                );
                 
+                // bits may be mapped from a file, never read past them
+                if (NumBytes * d > (size_t)(pEndBits - pSrcBits))
+                {
+                    return false;
+                }
+                
                 if ( (mipCount <= 1) || !maxsize || (w <= maxsize && h <= maxsize && d <= maxsize) )
                 {
                     if ( !twidth )
@@ -755,10 +669,7 @@ namespace
                     }
                     
                     assert(index < mipCount * arraySize);
-                    [texture replaceRegion: MTLRegionMake3D(0, 0, 0, w, MAX(1, h), MAX(1, d))
-                               mipmapLevel: i
-                                 withBytes: pSrcBits
-                               bytesPerRow: RowBytes];
+                    upload(i - skipMip, j, w, h, d, pSrcBits, RowBytes, NumBytes);
                     
                     ++index;
                 }
@@ -768,11 +679,6 @@ namespace
                     ++skipMip;
                 }
                 
-                if (pSrcBits + (NumBytes*d) > pEndBits)
-                {
-                    return false;
-                }
-                
                 pSrcBits += NumBytes * d;
                 
                 w = w >> 1;
@@ -796,6 +702,36 @@ namespace
         return (index > 0);
     }
     
+    //--------------------------------------------------------------------------------------
+    bool FillInitData(id<MTLTexture> texture,
+                      size_t width,
+                      size_t height,
+                      size_t depth,
+                      size_t mipCount,
+                      size_t arraySize,
+                      MTLPixelFormat format,
+                      size_t maxsize,
+                      size_t bitSize,
+                      const uint8_t* bitData,
+                      size_t& twidth,
+                      size_t& theight,
+                      size_t& tdepth,
+                      size_t& skipMip)
+    {
+        const bool is3D = texture.textureType == MTLTextureType3D;
+        return ForEachSubresource(width, height, depth, mipCount, arraySize, format, maxsize, bitSize, bitData,
+                                  twidth, theight, tdepth, skipMip,
+                                  [&](size_t level, size_t slice, size_t w, size_t h, size_t d,
+                                      const uint8_t* bits, size_t rowBytes, size_t numBytes) {
+            [texture replaceRegion: MTLRegionMake3D(0, 0, 0, w, MAX(1, h), MAX(1, d))
+                       mipmapLevel: level
+                             slice: slice
+                         withBytes: bits
+                       bytesPerRow: rowBytes
+                     bytesPerImage: is3D ? numBytes : 0];
+        });
+    }
+    
     
     //--------------------------------------------------------------------------------------
 #define ISBITMASK( r,g,b,a ) ( ddpf.RBitMask == r && ddpf.GBitMask == g && ddpf.BBitMask == b && ddpf.ABitMask == a )
@@ -1193,16 +1129,27 @@ namespace
     }
     
     //--------------------------------------------------------------------------------------
-    BOOL CreateTextureFromDDS(id<MTLDevice> device,
-                              const DDS_HEADER* header,
-                              const uint8_t* bitData,
-                              size_t bitSize,
-                              size_t maxsize,
-                              MTLTextureUsage usage,
-                              MTLStorageMode storageMode,
-                              bool forceSRGB,
-                              id<MTLTexture>* texture,
-                              NSError** error)
+    // Subresources of each mip level, stored in the file one after another
+    //--------------------------------------------------------------------------------------
+    size_t GetSliceCount(MTLTextureDescriptor* descriptor)
+    {
+        switch (descriptor.textureType)
+        {
+            case MTLTextureTypeCube:
+            case MTLTextureTypeCubeArray:
+                return descriptor.arrayLength * 6;
+            default:
+                return descriptor.arrayLength;
+        }
+    }
+    
+    
+    //--------------------------------------------------------------------------------------
+    BOOL MakeTextureDescriptorFromDDS(const DDS_HEADER* header,
+                                      MTLTextureUsage usage,
+                                      MTLStorageMode storageMode,
+                                      bool forceSRGB,
+                                      MTLTextureDescriptor** outDescriptor)
     {
         uint32_t width = header->width;
         uint32_t height = header->height;
@@ -1259,7 +1206,7 @@ namespace
                 case D3D11_RESOURCE_DIMENSION_TEXTURE2D:
                     if (d3d10ext->miscFlag & D3D11_RESOURCE_MISC_TEXTURECUBE)
                     {
-                        descriptor.arrayLength *= 6;
+                        // Metal counts cubes, not faces
                         isCubeMap = true;
                         descriptor.textureType = MTLTextureTypeCube;
                         if(descriptor.arrayLength > 1)
@@ -1311,7 +1258,6 @@ namespace
                         return false;
                     }
                     descriptor.textureType = MTLTextureTypeCube;
-                    descriptor.arrayLength = 6;
                     isCubeMap = true;
                 }
                 else {
@@ -1376,11 +1322,91 @@ namespace
          }
          */
         
+        *outDescriptor = descriptor;
+        return true;
+    }
+    
+    
+    //--------------------------------------------------------------------------------------
+    // Copy of the descriptor without the mips larger than maxsize
+    //--------------------------------------------------------------------------------------
+    BOOL FitTextureDescriptor(MTLTextureDescriptor* descriptor,
+                              size_t maxsize,
+                              size_t bitSize,
+                              const uint8_t* bitData,
+                              MTLTextureDescriptor** outDescriptor,
+                              NSError** error)
+    {
+        size_t twidth, theight, tdepth, skipMip;
+        if (!ForEachSubresource(descriptor.width, descriptor.height, descriptor.depth, descriptor.mipmapLevelCount,
+                                GetSliceCount(descriptor), descriptor.pixelFormat, maxsize, bitSize, bitData,
+                                twidth, theight, tdepth, skipMip,
+                                [](size_t, size_t, size_t, size_t, size_t, const uint8_t*, size_t, size_t) {}))
+        {
+            if (error != nil)
+                *error = MakeError(@"IO error", @"Subresources exceed the file size, or no mip fits in maxsize");
+            return false;
+        }
+        
+        MTLTextureDescriptor *fitDescriptor = [descriptor copy];
+        fitDescriptor.width = twidth;
+        fitDescriptor.height = theight;
+        fitDescriptor.depth = tdepth;
+        fitDescriptor.mipmapLevelCount = descriptor.mipmapLevelCount - skipMip;
+        *outDescriptor = fitDescriptor;
+        return true;
+    }
+    
+    
+    //--------------------------------------------------------------------------------------
+    // Reads ahead the retained subresources of mapped bits
+    //--------------------------------------------------------------------------------------
+    void PrefetchSubresources(MTLTextureDescriptor* descriptor,
+                              size_t maxsize,
+                              size_t bitSize,
+                              const uint8_t* bitData)
+    {
+        const uintptr_t pageMask = (uintptr_t)getpagesize() - 1;
+        size_t twidth, theight, tdepth, skipMip;
+        ForEachSubresource(descriptor.width, descriptor.height, descriptor.depth, descriptor.mipmapLevelCount,
+                           GetSliceCount(descriptor), descriptor.pixelFormat, maxsize, bitSize, bitData,
+                           twidth, theight, tdepth, skipMip,
+                           [&](size_t, size_t, size_t, size_t, size_t d, const uint8_t* bits, size_t, size_t numBytes) {
+            uintptr_t begin = (uintptr_t)bits & ~pageMask;
+            uintptr_t end = (uintptr_t)bits + numBytes * d;
+            madvise((void *)begin, end - begin, MADV_WILLNEED);
+        });
+    }
+    
+    
+    //--------------------------------------------------------------------------------------
+    BOOL CreateTextureFromDDS(id<MTLDevice> device,
+                              const DDS_HEADER* header,
+                              const uint8_t* bitData,
+                              size_t bitSize,
+                              size_t maxsize,
+                              MTLTextureUsage usage,
+                              MTLStorageMode storageMode,
+                              bool forceSRGB,
+                              id<MTLTexture>* texture,
+                              NSError** error)
+    {
+        MTLTextureDescriptor *fullDescriptor = nil;
+        if (!MakeTextureDescriptorFromDDS(header, usage, storageMode, forceSRGB, &fullDescriptor))
+            return false;
+        
+        // only the mips within maxsize are allocated
+        MTLTextureDescriptor *descriptor = nil;
+        if (!FitTextureDescriptor(fullDescriptor, maxsize, bitSize, bitData, &descriptor, error))
+            return false;
+        
         // Create the texture
         size_t twidth, theight, tdepth, skipMip;
         *texture = [device newTextureWithDescriptor: descriptor];
-        FillInitData(*texture, descriptor.width, descriptor.height, descriptor.depth, descriptor.mipmapLevelCount, descriptor.arrayLength, descriptor.pixelFormat, maxsize, bitSize, bitData, twidth, theight, tdepth, skipMip);
-        return *texture != nil;
+        if (*texture == nil)
+            return false;
+        FillInitData(*texture, fullDescriptor.width, fullDescriptor.height, fullDescriptor.depth, fullDescriptor.mipmapLevelCount, GetSliceCount(fullDescriptor), fullDescriptor.pixelFormat, maxsize, bitSize, bitData, twidth, theight, tdepth, skipMip);
+        return true;
     }
     
     
@@ -1490,7 +1516,7 @@ extern "C" {
                 *alphaMode = GetAlphaMode(header);
         }
         
-        return true;
+        return flag;
     }
     
     BOOL CreateDDSTextureFromFile(id<MTLDevice> device,
@@ -1542,26 +1568,202 @@ extern "C" {
         if (alphaMode)
             *alphaMode = DDS_ALPHA_MODE_UNKNOWN;
         
-        const DDS_HEADER* header = nullptr;
-        const uint8_t* bitData = nullptr;
-        size_t bitSize = 0;
-        
-        std::unique_ptr<uint8_t[]> ddsData;
-        bool flag = LoadTextureDataFromFile(fileName.UTF8String, ddsData, &header, &bitData, &bitSize, error);
-        if (!flag)
+        // subresources are read straight from the mapping
+        DDSTextureFile *file = [[DDSTextureFile alloc] initWithPath: (NSString *)fileName
+                                                              error: error];
+        if (file == nil)
             return false;
         
-        flag = CreateTextureFromDDS(device, header, bitData, bitSize,
-                                    maxsize, usage, storageMode,
-                                    forceSRGB, texture, error);
-        
-        if (flag)
+        *texture = [file newTextureWithDevice: device
+                                      maxsize: maxsize
+                                        usage: usage
+                                  storageMode: storageMode
+                                    forceSRGB: forceSRGB
+                                        error: error];
+        if (*texture != nil)
         {
-            (*texture).label = [fileName lastPathComponent];
             if (alphaMode)
-                *alphaMode = GetAlphaMode(header);
+                *alphaMode = file.alphaMode;
         }
         
         return true;
     }
 }
+
+@implementation DDSTextureFile {
+    NSString *_path;
+    void *_mapping;
+    size_t _mappingSize;
+    const DDS_HEADER *_header;
+    const uint8_t *_bitData;
+    size_t _bitSize;
+    std::vector<size_t> _mipmapLevelBytes;
+}
+
+- (instancetype)initWithPath:(NSString *)path
+                       error:(NSError **)error {
+    self = [super init];
+    if(self) {
+        _path = path;
+        size_t fileSize = 0;
+        if(!MapTextureDataFromFile(path.fileSystemRepresentation, &_mapping, &_mappingSize, &fileSize, error))
+            return nil;
+        if(!LoadTextureDataFromMemory((const uint8_t *)_mapping, fileSize, &_header, &_bitData, &_bitSize, error))
+            return nil;
+        
+        MTLTextureDescriptor *descriptor = nil;
+        if(!MakeTextureDescriptorFromDDS(_header, 0, MTLStorageModeManaged, false, &descriptor)) {
+            if(error != nil)
+                *error = MakeError(@"invalid format", [NSString stringWithFormat: @"Unsupported format of %@", path.lastPathComponent]);
+            return nil;
+        }
+        _width = descriptor.width;
+        _height = descriptor.height;
+        _depth = descriptor.depth;
+        _alphaMode = GetAlphaMode(_header);
+        
+        // sizes of mip levels over every slice, header only
+        size_t w = _width, h = _height, d = _depth;
+        for(NSUInteger level = 0; level < descriptor.mipmapLevelCount; level++) {
+            size_t numBytes = 0;
+            GetSurfaceInfo(w, h, descriptor.pixelFormat, &numBytes, nullptr, nullptr);
+            _mipmapLevelBytes.push_back(numBytes * d * GetSliceCount(descriptor));
+            w = MAX(1, w >> 1);
+            h = MAX(1, h >> 1);
+            d = MAX(1, d >> 1);
+        }
+    }
+    return self;
+}
+
+- (void)dealloc {
+    if(_mapping)
+        munmap(_mapping, _mappingSize);
+}
+
+- (NSUInteger)mipmapLevelCount {
+    return _mipmapLevelBytes.size();
+}
+
+- (NSUInteger)bytesOfMipmapLevel:(NSUInteger)level {
+    return level < _mipmapLevelBytes.size() ? _mipmapLevelBytes[level] : 0;
+}
+
+- (id<MTLTexture>)newTextureWithDevice:(id<MTLDevice>)device
+                               maxsize:(size_t)maxsize
+                                 usage:(MTLTextureUsage)usage
+                           storageMode:(MTLStorageMode)storageMode
+                             forceSRGB:(bool)forceSRGB
+                                 error:(NSError **)error {
+    MTLTextureDescriptor *descriptor = nil;
+    if(MakeTextureDescriptorFromDDS(_header, usage, storageMode, forceSRGB, &descriptor))
+        PrefetchSubresources(descriptor, maxsize, _bitSize, _bitData);
+    
+    id<MTLTexture> texture = nil;
+    if(!CreateTextureFromDDS(device, _header, _bitData, _bitSize, maxsize, usage, storageMode, forceSRGB, &texture, error) ||
+       texture == nil) {
+        if(error != nil && *error == nil)
+            *error = MakeError(@"invalid format", [NSString stringWithFormat: @"Couldn't create texture from %@", _path.lastPathComponent]);
+        return nil;
+    }
+    texture.label = _path.lastPathComponent;
+    return texture;
+}
+
+- (id<MTLTexture>)newPrivateTextureWithDevice:(id<MTLDevice>)device
+                                      maxsize:(size_t)maxsize
+                                        usage:(MTLTextureUsage)usage
+                                    forceSRGB:(bool)forceSRGB
+                                  blitEncoder:(id<MTLBlitCommandEncoder>)blit
+                                        error:(NSError **)error {
+    MTLTextureDescriptor *fullDescriptor = nil;
+    if(!MakeTextureDescriptorFromDDS(_header, usage, MTLStorageModePrivate, forceSRGB, &fullDescriptor)) {
+        if(error != nil)
+            *error = MakeError(@"invalid format", [NSString stringWithFormat: @"Unsupported format of %@", _path.lastPathComponent]);
+        return nil;
+    }
+    MTLTextureDescriptor *descriptor = nil;
+    if(!FitTextureDescriptor(fullDescriptor, maxsize, _bitSize, _bitData, &descriptor, error))
+        return nil;
+    
+    // buffer copies must start on a pixel (block) of the format
+    size_t pixelBytes = 0;
+    GetSurfaceInfo(1, 1, fullDescriptor.pixelFormat, nullptr, &pixelBytes, nullptr);
+    const uint8_t *mapping = (const uint8_t *)_mapping;
+    bool aligned = pixelBytes > 0;
+    size_t twidth, theight, tdepth, skipMip;
+    ForEachSubresource(fullDescriptor.width, fullDescriptor.height, fullDescriptor.depth, fullDescriptor.mipmapLevelCount,
+                       GetSliceCount(fullDescriptor), fullDescriptor.pixelFormat, maxsize, _bitSize, _bitData,
+                       twidth, theight, tdepth, skipMip,
+                       [&](size_t, size_t, size_t, size_t, size_t, const uint8_t* bits, size_t rowBytes, size_t) {
+        aligned = aligned && (bits - mapping) % pixelBytes == 0 && rowBytes % pixelBytes == 0;
+    });
+    
+    if(!aligned) {
+        // misaligned (e.g. after a DX10 header), copies through a CPU-visible texture
+        id<MTLTexture> intermediateTexture = [self newTextureWithDevice: device
+                                                                maxsize: maxsize
+                                                                  usage: usage
+                                                            storageMode: MTLStorageModeManaged
+                                                              forceSRGB: forceSRGB
+                                                                  error: error];
+        if(intermediateTexture == nil)
+            return nil;
+        id<MTLTexture> texture = [device newTextureWithDescriptor: descriptor];
+        if(texture == nil)
+            return nil;
+        texture.label = _path.lastPathComponent;
+        ForEachSubresource(fullDescriptor.width, fullDescriptor.height, fullDescriptor.depth, fullDescriptor.mipmapLevelCount,
+                           GetSliceCount(fullDescriptor), fullDescriptor.pixelFormat, maxsize, _bitSize, _bitData,
+                           twidth, theight, tdepth, skipMip,
+                           [&](size_t level, size_t slice, size_t w, size_t h, size_t d, const uint8_t*, size_t, size_t) {
+            [blit copyFromTexture: intermediateTexture
+                      sourceSlice: slice
+                      sourceLevel: level
+                     sourceOrigin: MTLOriginMake(0, 0, 0)
+                       sourceSize: MTLSizeMake(w, MAX(1, h), MAX(1, d))
+                        toTexture: texture
+                 destinationSlice: slice
+                 destinationLevel: level
+                destinationOrigin: MTLOriginMake(0, 0, 0)];
+        });
+        return texture;
+    }
+    
+    id<MTLTexture> texture = [device newTextureWithDescriptor: descriptor];
+    if(texture == nil)
+        return nil;
+    texture.label = _path.lastPathComponent;
+    PrefetchSubresources(fullDescriptor, maxsize, _bitSize, _bitData);
+    
+    // the buffer keeps the file mapped until the GPU is done with it
+    DDSTextureFile *file = self;
+    id<MTLBuffer> buffer = [device newBufferWithBytesNoCopy: _mapping
+                                                     length: _mappingSize
+                                                    options: MTLResourceStorageModeShared
+                                                deallocator: ^(void *pointer, NSUInteger length) {
+        (void)file;
+    }];
+    if(buffer == nil)
+        return nil;
+    
+    const bool is3D = descriptor.textureType == MTLTextureType3D;
+    ForEachSubresource(fullDescriptor.width, fullDescriptor.height, fullDescriptor.depth, fullDescriptor.mipmapLevelCount,
+                       GetSliceCount(fullDescriptor), fullDescriptor.pixelFormat, maxsize, _bitSize, _bitData,
+                       twidth, theight, tdepth, skipMip,
+                       [&](size_t level, size_t slice, size_t w, size_t h, size_t d,
+                           const uint8_t* bits, size_t rowBytes, size_t numBytes) {
+        [blit copyFromBuffer: buffer
+                sourceOffset: bits - mapping
+           sourceBytesPerRow: rowBytes
+         sourceBytesPerImage: is3D ? numBytes : 0
+                  sourceSize: MTLSizeMake(w, MAX(1, h), MAX(1, d))
+                   toTexture: texture
+            destinationSlice: slice
+            destinationLevel: level
+           destinationOrigin: MTLOriginMake(0, 0, 0)];
+    });
+    return texture;
+}
+
+@end
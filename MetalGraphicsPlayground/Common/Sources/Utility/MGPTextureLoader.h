@@ -11,12 +11,59 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
+// Texture loaded in the background. (see -[MGPTextureLoader requestTextureFromURL:...])
+@interface MGPTextureRequest : NSObject
+
+@property (readonly, nonatomic) NSURL *url;
+// Placeholder until the loaded texture is resident. The placeholder stays if loading fails.
+// Replaced again when the texture is reloaded at another quality.
+@property (readonly, nullable) id<MTLTexture> texture;
+@property (readonly, getter=isResident) BOOL resident;
+@property (readonly, getter=isCompleted) BOOL completed;   // resident or failed
+@property (readonly, nullable) NSError *error;
+
+- (void)waitUntilCompleted;
+
+@end
+
+typedef struct {
+    NSUInteger residentBytes;       // retained mips of streamed DDS textures
+    NSUInteger fullBytes;           // if every mip was retained
+    NSUInteger numTextures;
+    NSUInteger numReducedTextures;  // skipping any mip
+} MGPTextureMemoryStatistics;
+
+typedef struct {
+    uint64_t hits;                  // same file again
+    uint64_t dedupHits;             // identical file under another name
+    uint64_t misses;
+    uint64_t evictions;
+    uint64_t savedBytes;            // file bytes not loaded again by any hit
+    uint64_t dedupSavedBytes;       // of them, by identical files under another name
+    NSUInteger residentBytes;       // file bytes of cached textures
+    NSUInteger numTextures;
+} MGPTextureCacheStatistics;
+
 @interface MGPTextureLoader : NSObject
 
 @property (readonly, nonatomic) id<MTLDevice> device;
 
+// Quality of streamed DDS textures. Top mips are skipped (never read from the file) when they are
+// larger than maxTextureSize, or while the textures exceed the budget, the largest first.
+// A texture never drops below minTextureSize. (default : 0 unlimited, 0 unlimited, 64)
+// Changing them reloads affected textures in the background, the request's texture is replaced.
+// maxTextureSize also applies to DDS textures loaded at once.
+@property (nonatomic) NSUInteger textureMemoryBudget;
+@property (nonatomic) NSUInteger maxTextureSize;
+@property (nonatomic) NSUInteger minTextureSize;
+@property (readonly) MGPTextureMemoryStatistics textureMemoryStatistics;
+@property (readonly) MGPTextureCacheStatistics textureCacheStatistics;
+
 - (instancetype)initWithDevice: (id<MTLDevice>)device;
 
+// Loader kept for the lifetime of the process, one per device.
++ (MGPTextureLoader *)sharedTextureLoaderWithDevice: (id<MTLDevice>)device;
+
 - (id<MTLTexture>)newTextureWithName: (NSString *)name
                                usage: (MTLTextureUsage)textureUsage
                          storageMode: (MTLStorageMode)storageMode
@@ -32,6 +79,29 @@ NS_ASSUME_NONNULL_BEGIN
                         storageMode: (MTLStorageMode)storageMode
                               error: (NSError **)error;
 
+// Reads and decodes on worker threads, uploads in batches, one command buffer per batch.
+// Deallocating the loader waits for its requests.
+- (MGPTextureRequest *)requestTextureFromURL: (NSURL *)url
+                                       usage: (MTLTextureUsage)textureUsage
+                                 storageMode: (MTLStorageMode)storageMode
+                                 placeholder: (nullable id<MTLTexture>)placeholder;
+- (void)waitUntilAllRequestsCompleted;
+
+// Streamed textures cached by canonical path and file contents, identical files under
+// different names share a request. The shared loader's cache is process-wide.
+// Each call is balanced by releaseCachedTexture:, the last release drops the request from the cache.
+- (MGPTextureRequest *)retainCachedTextureFromURL: (NSURL *)url
+                                            usage: (MTLTextureUsage)textureUsage
+                                      storageMode: (MTLStorageMode)storageMode
+                                      placeholder: (nullable id<MTLTexture>)placeholder;
+- (void)releaseCachedTexture: (MGPTextureRequest *)request;
+
+// 1x1 RGBA8 texture of the color, shared by every caller.
+- (id<MTLTexture>)placeholderTextureWithRed: (uint8_t)red
+                                      green: (uint8_t)green
+                                       blue: (uint8_t)blue
+                                      alpha: (uint8_t)alpha;
+
 @end
 
 NS_ASSUME_NONNULL_END
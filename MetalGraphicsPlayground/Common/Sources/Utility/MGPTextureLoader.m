@@ -8,11 +8,119 @@
 
 #import "MGPTextureLoader.h"
 #import "DDSTextureLoader.h"
+#import "../Model/MGPTextureStreamer.h"
+#import "../Model/MGPTextureBudget.h"
+#import "../Model/MGPTextureCache.h"
 @import MetalKit;
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// textures decoded at once before a batch is uploaded
+#define TEXTURE_STREAMING_BATCH_SIZE 8
+
+@interface MGPTextureRequest ()
+@property (readwrite, nullable) id<MTLTexture> texture;
+@property (readwrite, getter=isResident) BOOL resident;
+@property (readwrite, getter=isCompleted) BOOL completed;
+@property (readwrite, nullable) NSError *error;
+@property (readonly, nonatomic) MTLTextureUsage usage;
+@property (readonly, nonatomic) MTLStorageMode storageMode;
+
+// loader lock
+@property (weak, nonatomic) MGPTextureLoader *loader;
+@property (nonatomic) BOOL budgeted;                // added to the texture budget
+@property (nonatomic) BOOL reloading;               // enqueued again at another quality
+@property (nonatomic) NSUInteger encodedSkippedMipmapLevelCount;
+
+- (instancetype)initWithURL:(NSURL *)url
+                      usage:(MTLTextureUsage)usage
+                storageMode:(MTLStorageMode)storageMode
+                placeholder:(nullable id<MTLTexture>)placeholder;
+- (void)_completeWithTexture:(nullable id<MTLTexture>)texture
+                       error:(nullable NSError *)error;
+@end
+
+@interface MGPTextureLoader ()
+- (void)_removeTextureRequest:(MGPTextureRequest *)request;
+@end
+
+@implementation MGPTextureRequest {
+    dispatch_group_t _group;
+}
+
+- (instancetype)initWithURL:(NSURL *)url
+                      usage:(MTLTextureUsage)usage
+                storageMode:(MTLStorageMode)storageMode
+                placeholder:(id<MTLTexture>)placeholder {
+    self = [super init];
+    if(self) {
+        _url = url;
+        _usage = usage;
+        _storageMode = storageMode;
+        _texture = placeholder;
+        _group = dispatch_group_create();
+        dispatch_group_enter(_group);
+    }
+    return self;
+}
+
+- (void)dealloc {
+    [_loader _removeTextureRequest: self];
+}
+
+- (void)_completeWithTexture:(id<MTLTexture>)texture
+                       error:(NSError *)error {
+    if(self.completed) {
+        // reloaded, the old texture stays if it failed
+        if(texture)
+            self.texture = texture;
+        return;
+    }
+    if(texture) {
+        self.texture = texture;
+        self.resident = YES;
+    }
+    else {
+        self.error = error ?: [NSError errorWithDomain: NSURLErrorDomain
+                                                  code: 0
+                                              userInfo: nil];
+    }
+    self.completed = YES;
+    dispatch_group_leave(_group);
+}
+
+- (void)waitUntilCompleted {
+    dispatch_group_wait(_group, DISPATCH_TIME_FOREVER);
+}
+
+@end
+
+// texture streamer backend, context is the MGPTextureLoader
+static void *texture_request_decode(void *context, void *request);
+static void texture_request_upload(void *context, void *const *requests, void *const *images, size_t count);
+// texture budget backend
+static void texture_request_resize(void *context, void *request, uint32_t skippedLevels);
+// texture cache backend
+static void texture_request_evict(void *context, void *request);
 
 @implementation MGPTextureLoader {
     MTKTextureLoader *_mtkTextureLoader;
     id<MTLCommandQueue> _commandQueue;
+    
+    // streaming
+    mgp_texture_streamer_t *_streamer;
+    id<MTLCommandQueue> _streamingCommandQueue;
+    id<MTLCommandBuffer> _lastStreamingCommandBuffer;
+    NSMutableDictionary<NSNumber*, id<MTLTexture>> *_placeholderTextures;
+    
+    // quality of streamed DDS textures, keyed by request, loader lock
+    mgp_texture_budget_t *_textureBudget;
+    NSMapTable<NSNumber*, MGPTextureRequest*> *_budgetedRequests;
+    
+    // retained requests, loader lock
+    mgp_texture_cache_t *_textureCache;
 }
 
 - (instancetype)initWithDevice:(id<MTLDevice>)device {
@@ -21,10 +129,138 @@
         _device = device;
         _commandQueue = [_device newCommandQueueWithMaxCommandBufferCount:1];
         _mtkTextureLoader = [[MTKTextureLoader alloc] initWithDevice: _device];
+        _placeholderTextures = [NSMutableDictionary new];
+        
+        _minTextureSize = 64;
+        mgp_texture_budget_backend_t backend = {
+            .resize = texture_request_resize,
+            .context = (__bridge void *)self
+        };
+        _textureBudget = mgp_texture_budget_create(&backend, _textureMemoryBudget,
+                                                   (uint32_t)_maxTextureSize, (uint32_t)_minTextureSize);
+        // weak, so a deallocating request is never enqueued again
+        _budgetedRequests = [NSMapTable strongToWeakObjectsMapTable];
+        
+        mgp_texture_cache_backend_t cacheBackend = {
+            .evict = texture_request_evict,
+            .context = (__bridge void *)self
+        };
+        _textureCache = mgp_texture_cache_create(&cacheBackend);
     }
     return self;
 }
 
+- (void)dealloc {
+    mgp_texture_streamer_destroy(_streamer);
+    mgp_texture_cache_destroy(_textureCache);
+    mgp_texture_budget_destroy(_textureBudget);
+}
+
++ (MGPTextureLoader *)sharedTextureLoaderWithDevice:(id<MTLDevice>)device {
+    static NSMapTable<id<MTLDevice>, MGPTextureLoader*> *sharedTextureLoaders = nil;
+    @synchronized (MGPTextureLoader.class) {
+        if(sharedTextureLoaders == nil)
+            sharedTextureLoaders = [NSMapTable strongToStrongObjectsMapTable];
+        MGPTextureLoader *textureLoader = [sharedTextureLoaders objectForKey: device];
+        if(textureLoader == nil) {
+            textureLoader = [[MGPTextureLoader alloc] initWithDevice: device];
+            [sharedTextureLoaders setObject: textureLoader
+                                     forKey: device];
+        }
+        return textureLoader;
+    }
+}
+
+#pragma mark - Texture budget
+
+- (void)setTextureMemoryBudget:(NSUInteger)textureMemoryBudget {
+    @synchronized (self) {
+        _textureMemoryBudget = textureMemoryBudget;
+        mgp_texture_budget_set_budget(_textureBudget, textureMemoryBudget);
+    }
+}
+
+- (void)setMaxTextureSize:(NSUInteger)maxTextureSize {
+    @synchronized (self) {
+        _maxTextureSize = maxTextureSize;
+        mgp_texture_budget_set_max_size(_textureBudget, (uint32_t)maxTextureSize);
+    }
+}
+
+- (void)setMinTextureSize:(NSUInteger)minTextureSize {
+    @synchronized (self) {
+        _minTextureSize = minTextureSize;
+        mgp_texture_budget_set_min_size(_textureBudget, (uint32_t)minTextureSize);
+    }
+}
+
+- (MGPTextureMemoryStatistics)textureMemoryStatistics {
+    mgp_texture_budget_stats_t stats = {};
+    @synchronized (self) {
+        mgp_texture_budget_get_stats(_textureBudget, &stats);
+    }
+    return (MGPTextureMemoryStatistics) {
+        .residentBytes = stats.residentBytes,
+        .fullBytes = stats.fullBytes,
+        .numTextures = stats.numTextures,
+        .numReducedTextures = stats.numReduced
+    };
+}
+
+// loader lock, returns skipped mip levels
+- (NSUInteger)_addTextureRequest:(MGPTextureRequest *)request
+                            file:(DDSTextureFile *)file {
+    if(request.budgeted)
+        return mgp_texture_budget_skipped_levels(_textureBudget, (__bridge void *)request);
+    
+    NSUInteger numLevels = file.mipmapLevelCount;
+    uint64_t levelBytes[numLevels];
+    for(NSUInteger level = 0; level < numLevels; level++)
+        levelBytes[level] = [file bytesOfMipmapLevel: level];
+    request.budgeted = YES;
+    request.loader = self;
+    [_budgetedRequests setObject: request
+                          forKey: @((uintptr_t)request)];
+    return mgp_texture_budget_add(_textureBudget, (__bridge void *)request,
+                                  (uint32_t)file.width, (uint32_t)file.height, (uint32_t)file.depth,
+                                  (uint32_t)numLevels, levelBytes);
+}
+
+// deallocating request, it's only compared by address
+- (void)_removeTextureRequest:(MGPTextureRequest *)request {
+    @synchronized (self) {
+        [_budgetedRequests removeObjectForKey: @((uintptr_t)request)];
+        mgp_texture_budget_remove(_textureBudget, (__bridge void *)request);
+    }
+}
+
+// loader lock, the budget changed skipped levels of the request
+- (void)_resizeTextureRequest:(void *)requestPointer
+                skippedLevels:(NSUInteger)skippedLevels {
+    MGPTextureRequest *request = [_budgetedRequests objectForKey: @((uintptr_t)requestPointer)];
+    if(request == nil || request.reloading ||
+       request.encodedSkippedMipmapLevelCount == skippedLevels)
+        return;
+    // loaded again in the background, the current texture stays until then
+    request.reloading = YES;
+    mgp_texture_streamer_enqueue(_streamer, (void *)CFBridgingRetain(request));
+}
+
+// loader lock, maxsize of the loaded mips
+- (size_t)_maxsizeOfTextureRequest:(MGPTextureRequest *)request
+                              file:(DDSTextureFile *)file {
+    NSUInteger skippedLevels = [self _addTextureRequest: request
+                                                   file: file];
+    request.reloading = NO;
+    request.encodedSkippedMipmapLevelCount = skippedLevels;
+    if(skippedLevels == 0)
+        return 0;
+    return mgp_texture_budget_max_size_of_level((uint32_t)file.width, (uint32_t)file.height,
+                                                (uint32_t)file.depth, (uint32_t)skippedLevels);
+}
+
+#pragma mark - Loading
+
 - (id<MTLTexture>)newTextureWithName:(NSString *)name
                                usage:(MTLTextureUsage)textureUsage
                          storageMode:(MTLStorageMode)storageMode
@@ -111,57 +347,314 @@
     
     id<MTLTexture> texture = nil;
     @autoreleasepool {
-        DDS_ALPHA_MODE alphaMode = DDS_ALPHA_MODE_UNKNOWN;
-        CreateDDSTextureFromFile(self.device,
-                                 filePath,
-                                 0,
-                                 textureUsage,
-                                 MTLStorageModeManaged,
-                                 false,
-                                 &texture,
-                                 &alphaMode,
-                                 error);
+        DDSTextureFile *file = [[DDSTextureFile alloc] initWithPath: filePath
+                                                              error: error];
+        if(file == nil)
+            return nil;
         
         if(storageMode == MTLStorageModePrivate) {
-            id<MTLTexture> intermediateTexture = texture;
-            MTLTextureDescriptor *desc = [[MTLTextureDescriptor alloc] init];
-            desc.textureType = intermediateTexture.textureType;
-            desc.width = intermediateTexture.width;
-            desc.height = intermediateTexture.height;
-            desc.depth = intermediateTexture.depth;
-            desc.mipmapLevelCount = intermediateTexture.mipmapLevelCount;
-            desc.arrayLength = intermediateTexture.arrayLength;
-            desc.pixelFormat = intermediateTexture.pixelFormat;
-            desc.sampleCount = intermediateTexture.sampleCount;
-            desc.storageMode = storageMode;
-            desc.usage = textureUsage;
-            texture = [_device newTextureWithDescriptor: desc];
-            texture.label = intermediateTexture.label;
-            
-            id<MTLCommandBuffer> buffer = [_commandQueue commandBufferWithUnretainedReferences];
+            // copied by the GPU from the mapped file
+            id<MTLCommandBuffer> buffer = [_commandQueue commandBuffer];
             id<MTLBlitCommandEncoder> blit = [buffer blitCommandEncoder];
-            MTLSize size = MTLSizeMake(texture.width, texture.height, texture.depth);
-            for(int level = 0; level < desc.mipmapLevelCount; level++) {
-                [blit copyFromTexture: intermediateTexture
-                          sourceSlice: 0
-                          sourceLevel: level
-                         sourceOrigin: MTLOriginMake(0, 0, 0)
-                           sourceSize: size
-                            toTexture: texture
-                     destinationSlice: 0
-                     destinationLevel: level
-                    destinationOrigin: MTLOriginMake(0, 0, 0)];
-                size.width = MAX(1, size.width / 2);
-                size.height = MAX(1, size.height / 2);
-                size.depth = MAX(1, size.depth / 2);
-            }
-            
+            texture = [file newPrivateTextureWithDevice: _device
+                                                maxsize: self.maxTextureSize
+                                                  usage: textureUsage
+                                              forceSRGB: false
+                                            blitEncoder: blit
+                                                  error: error];
             [blit endEncoding];
             [buffer commit];
             [buffer waitUntilCompleted];
         }
+        else {
+            texture = [file newTextureWithDevice: _device
+                                         maxsize: self.maxTextureSize
+                                           usage: textureUsage
+                                     storageMode: MTLStorageModeManaged
+                                       forceSRGB: false
+                                           error: error];
+        }
     }
     return texture;
 }
 
+#pragma mark - Streaming
+
+- (MGPTextureRequest *)requestTextureFromURL:(NSURL *)url
+                                       usage:(MTLTextureUsage)textureUsage
+                                 storageMode:(MTLStorageMode)storageMode
+                                 placeholder:(id<MTLTexture>)placeholder {
+    MGPTextureRequest *request = [[MGPTextureRequest alloc] initWithURL: url
+                                                                  usage: textureUsage
+                                                            storageMode: storageMode
+                                                            placeholder: placeholder];
+    @synchronized (self) {
+        if(_streamer == NULL) {
+            _streamingCommandQueue = [_device newCommandQueue];
+            _streamingCommandQueue.label = @"Texture Streaming";
+            mgp_texture_streamer_backend_t backend = {
+                .decode = texture_request_decode,
+                .upload = texture_request_upload,
+                .context = (__bridge void *)self
+            };
+            _streamer = mgp_texture_streamer_create(&backend, 0, TEXTURE_STREAMING_BATCH_SIZE);
+        }
+    }
+    // released after the upload
+    mgp_texture_streamer_enqueue(_streamer, (void *)CFBridgingRetain(request));
+    return request;
+}
+
+- (void)waitUntilAllRequestsCompleted {
+    if(_streamer == NULL)
+        return;
+    mgp_texture_streamer_wait_idle(_streamer);
+    
+    // batches complete in order on the same queue
+    id<MTLCommandBuffer> lastBuffer = nil;
+    @synchronized (self) {
+        lastBuffer = _lastStreamingCommandBuffer;
+    }
+    [lastBuffer waitUntilCompleted];
+}
+
+// worker threads, returns a texture or a mapped DDS file
+- (id)_decodeRequest:(MGPTextureRequest *)request {
+    NSURL *url = request.url;
+    NSError *error = nil;
+    id image = nil;
+    if([url.path.pathExtension.lowercaseString isEqualToString: @"dds"]) {
+        // only mapped and validated, subresources are read by the upload
+        image = [[DDSTextureFile alloc] initWithPath: url.path
+                                               error: &error];
+    }
+    else {
+        image = [self newTextureFromURL: url
+                                  usage: request.usage
+                            storageMode: request.storageMode
+                                  error: &error];
+    }
+    if(image == nil && !request.completed)
+        request.error = error;
+    return image;
+}
+
+// streaming thread
+- (void)_uploadRequests:(NSArray<MGPTextureRequest*> *)requests
+                 images:(NSArray *)images {
+    id<MTLCommandBuffer> buffer = nil;
+    id<MTLBlitCommandEncoder> blit = nil;
+    NSMutableArray<MGPTextureRequest*> *copiedRequests = [NSMutableArray new];
+    NSMutableArray<id<MTLTexture>> *copiedTextures = [NSMutableArray new];
+    
+    for(NSUInteger i = 0; i < requests.count; i++) {
+        MGPTextureRequest *request = requests[i];
+        id image = images[i] != NSNull.null ? images[i] : nil;
+        if(![image isKindOfClass: DDSTextureFile.class]) {
+            @synchronized (self) {
+                // a failed reload keeps the old texture
+                request.reloading = NO;
+            }
+            [request _completeWithTexture: image
+                                    error: request.error];
+            continue;
+        }
+        
+        DDSTextureFile *file = image;
+        NSError *error = nil;
+        size_t maxsize = 0;
+        @synchronized (self) {
+            maxsize = [self _maxsizeOfTextureRequest: request
+                                                file: file];
+        }
+        if(request.storageMode != MTLStorageModePrivate) {
+            id<MTLTexture> texture = [file newTextureWithDevice: _device
+                                                        maxsize: maxsize
+                                                          usage: request.usage
+                                                    storageMode: MTLStorageModeManaged
+                                                      forceSRGB: false
+                                                          error: &error];
+            [request _completeWithTexture: texture
+                                    error: error];
+            continue;
+        }
+        
+        if(buffer == nil) {
+            buffer = [_streamingCommandQueue commandBuffer];
+            buffer.label = @"Texture Upload";
+            blit = [buffer blitCommandEncoder];
+        }
+        id<MTLTexture> texture = [file newPrivateTextureWithDevice: _device
+                                                           maxsize: maxsize
+                                                             usage: request.usage
+                                                         forceSRGB: false
+                                                       blitEncoder: blit
+                                                             error: &error];
+        if(texture == nil) {
+            [request _completeWithTexture: nil
+                                    error: error];
+            continue;
+        }
+        [copiedRequests addObject: request];
+        [copiedTextures addObject: texture];
+    }
+    
+    if(buffer) {
+        [blit endEncoding];
+        [buffer addCompletedHandler:^(id<MTLCommandBuffer> commandBuffer) {
+            NSError *error = commandBuffer.error;
+            for(NSUInteger i = 0; i < copiedRequests.count; i++) {
+                [copiedRequests[i] _completeWithTexture: error ? nil : copiedTextures[i]
+                                                  error: error];
+            }
+        }];
+        [buffer commit];
+        @synchronized (self) {
+            _lastStreamingCommandBuffer = buffer;
+        }
+    }
+}
+
+- (id<MTLTexture>)placeholderTextureWithRed:(uint8_t)red
+                                      green:(uint8_t)green
+                                       blue:(uint8_t)blue
+                                      alpha:(uint8_t)alpha {
+    uint8_t color[4] = { red, green, blue, alpha };
+    uint32_t key = 0;
+    memcpy(&key, color, sizeof(uint32_t));
+    
+    @synchronized (_placeholderTextures) {
+        id<MTLTexture> texture = _placeholderTextures[@(key)];
+        if(texture == nil) {
+            MTLTextureDescriptor *desc = [MTLTextureDescriptor texture2DDescriptorWithPixelFormat: MTLPixelFormatRGBA8Unorm
+                                                                                            width: 1
+                                                                                           height: 1
+                                                                                        mipmapped: NO];
+            desc.usage = MTLTextureUsageShaderRead;
+            desc.storageMode = MTLStorageModeManaged;
+            texture = [_device newTextureWithDescriptor: desc];
+            texture.label = @"Placeholder";
+            [texture replaceRegion: MTLRegionMake2D(0, 0, 1, 1)
+                       mipmapLevel: 0
+                         withBytes: color
+                       bytesPerRow: sizeof(color)];
+            _placeholderTextures[@(key)] = texture;
+        }
+        return texture;
+    }
+}
+
+#pragma mark - Cache
+
+- (MGPTextureRequest *)retainCachedTextureFromURL:(NSURL *)url
+                                            usage:(MTLTextureUsage)textureUsage
+                                      storageMode:(MTLStorageMode)storageMode
+                                      placeholder:(id<MTLTexture>)placeholder {
+    NSString *path = url.URLByResolvingSymlinksInPath.URLByStandardizingPath.path;
+    struct stat st;
+    if(path.length == 0 || stat(path.fileSystemRepresentation, &st) != 0) {
+        // not cached, fails like any request
+        return [self requestTextureFromURL: url
+                                     usage: textureUsage
+                               storageMode: storageMode
+                               placeholder: placeholder];
+    }
+    
+    mgp_texture_cache_file_t file = {
+        .path = path.fileSystemRepresentation,
+        .fileSize = (uint64_t)st.st_size,
+        .modificationTime = (int64_t)st.st_mtimespec.tv_sec * 1000000000 + st.st_mtimespec.tv_nsec,
+        .variant = (uint32_t)(textureUsage << 4 | storageMode)
+    };
+    @synchronized (self) {
+        void *request = mgp_texture_cache_acquire_path(_textureCache, &file);
+        if(request)
+            return (__bridge MGPTextureRequest *)request;
+    }
+    
+    // a new path, the file is hashed without the lock
+    uint64_t contentHash = 0;
+    int fd = open(file.path, O_RDONLY);
+    void *mapping = (fd >= 0 && st.st_size > 0) ? mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+    if(fd >= 0)
+        close(fd);
+    if(mapping != MAP_FAILED) {
+        madvise(mapping, (size_t)st.st_size, MADV_SEQUENTIAL);
+        contentHash = mgp_texture_cache_hash(mapping, (size_t)st.st_size);
+        munmap(mapping, (size_t)st.st_size);
+    }
+    
+    @synchronized (self) {
+        // another thread may have loaded it meanwhile
+        void *request = mgp_texture_cache_acquire_path(_textureCache, &file);
+        if(request == NULL)
+            request = mgp_texture_cache_acquire_content(_textureCache, &file, contentHash);
+        if(request)
+            return (__bridge MGPTextureRequest *)request;
+        
+        MGPTextureRequest *newRequest = [self requestTextureFromURL: url
+                                                              usage: textureUsage
+                                                        storageMode: storageMode
+                                                        placeholder: placeholder];
+        // released on eviction
+        mgp_texture_cache_insert(_textureCache, &file, contentHash, (void *)CFBridgingRetain(newRequest));
+        return newRequest;
+    }
+}
+
+- (void)releaseCachedTexture:(MGPTextureRequest *)request {
+    @synchronized (self) {
+        mgp_texture_cache_release(_textureCache, (__bridge void *)request);
+    }
+}
+
+- (MGPTextureCacheStatistics)textureCacheStatistics {
+    mgp_texture_cache_stats_t stats = {};
+    @synchronized (self) {
+        mgp_texture_cache_get_stats(_textureCache, &stats);
+    }
+    return (MGPTextureCacheStatistics) {
+        .hits = stats.pathHits,
+        .dedupHits = stats.contentHits,
+        .misses = stats.misses,
+        .evictions = stats.evictions,
+        .savedBytes = stats.savedBytes,
+        .dedupSavedBytes = stats.dedupedBytes,
+        .residentBytes = stats.residentBytes,
+        .numTextures = stats.numTextures
+    };
+}
+
 @end
+
+static void *texture_request_decode(void *context, void *request) {
+    MGPTextureLoader *textureLoader = (__bridge MGPTextureLoader *)context;
+    @autoreleasepool {
+        id image = [textureLoader _decodeRequest: (__bridge MGPTextureRequest *)request];
+        return image ? (void *)CFBridgingRetain(image) : NULL;
+    }
+}
+
+static void texture_request_upload(void *context, void *const *requests, void *const *images, size_t count) {
+    MGPTextureLoader *textureLoader = (__bridge MGPTextureLoader *)context;
+    @autoreleasepool {
+        NSMutableArray<MGPTextureRequest*> *batchRequests = [NSMutableArray arrayWithCapacity: count];
+        NSMutableArray *batchImages = [NSMutableArray arrayWithCapacity: count];
+        for(size_t i = 0; i < count; i++) {
+            [batchRequests addObject: CFBridgingRelease(requests[i])];
+            [batchImages addObject: images[i] ? CFBridgingRelease(images[i]) : NSNull.null];
+        }
+        [textureLoader _uploadRequests: batchRequests
+                                images: batchImages];
+    }
+}
+
+static void texture_request_resize(void *context, void *request, uint32_t skippedLevels) {
+    MGPTextureLoader *textureLoader = (__bridge MGPTextureLoader *)context;
+    [textureLoader _resizeTextureRequest: request
+                           skippedLevels: skippedLevels];
+}
+
+static void texture_request_evict(void *context, void *request) {
+    CFBridgingRelease(request);
+}
@@ -11,12 +11,56 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
+// Textures used only while a frame is encoded, placed in one heap by their lifetimes.
+// Textures whose lifetimes don't overlap may share memory, so contents don't
+// survive the uses of other textures. (needs placement heaps, otherwise every
+// texture gets its own memory)
+@interface MGPTransientTextureSet : NSObject
+
+@property (nonatomic, readonly) id<MTLDevice> device;
+@property (nonatomic, readonly) NSUInteger heapSize;        // memory used by the textures
+@property (nonatomic, readonly) NSUInteger unaliasedSize;   // memory the textures would use without aliasing
+@property (nonatomic, readonly) NSUInteger savedSize;
+// Heap textures aren't tracked. Wait for it before using textures, update it after.
+@property (nonatomic, readonly, nullable) id<MTLFence> fence;
+
+- (instancetype)initWithDevice:(id<MTLDevice>)device;
+
+// Textures are used from firstUse to lastUse (inclusive), in the caller's order of passes.
+- (NSUInteger)addTextureWithDescriptor:(MTLTextureDescriptor *)descriptor
+                              firstUse:(NSUInteger)firstUse
+                               lastUse:(NSUInteger)lastUse;
+- (void)removeAllTextures;
+
+// Plans placements and makes textures of the added descriptors.
+- (void)makeTextures;
+- (nullable id<MTLTexture>)textureAtIndex:(NSUInteger)index;
+
+@end
+
+typedef struct {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+    NSUInteger residentBytes;   // temporary textures in use and unused
+    NSUInteger unusedBytes;
+} MGPTemporaryTextureStatistics;
+
 @interface MGPTextureManager : NSObject
 
+// Released temporary textures are destroyed when they are unused for this many frames (default : 8, 0 : never),
+// or when resident bytes exceed the budget, least recently used first. (default : 0, unlimited)
+@property (nonatomic) NSUInteger temporaryTextureBudget;
+@property (nonatomic) NSUInteger temporaryTextureMaxUnusedFrames;
+@property (nonatomic, readonly) MGPTemporaryTextureStatistics temporaryTextureStatistics;
+
 - (instancetype)initWithDevice:(id<MTLDevice>)device;
 
 + (MGPTextureManager *)sharedTextureManager;
 
+// Evicts old temporary textures, call once per frame.
+- (void)beginFrame;
+
 - (id<MTLTexture>)newTemporaryTextureWithDescriptor:(MTLTextureDescriptor *)descriptor;
 
 - (id<MTLTexture>)newTemporaryTextureWithWidth:(NSUInteger)width
@@ -28,6 +72,9 @@ NS_ASSUME_NONNULL_BEGIN
                                    arrayLength:(NSUInteger)arrayLength;
 - (void)releaseTemporaryTexture:(id<MTLTexture>)texture;
 - (void)clearUnusedTemporaryTextures;
+- (NSUInteger)temporaryTextureBytesOfPixelFormat:(MTLPixelFormat)pixelFormat;
+
+- (MGPTransientTextureSet *)newTransientTextureSet;
 
 @end
 
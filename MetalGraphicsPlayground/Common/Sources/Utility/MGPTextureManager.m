@@ -7,14 +7,39 @@
 //
 
 #import "MGPTextureManager.h"
+#import "../Model/MGPAliasingPlanner.h"
+#import "../Model/MGPTexturePool.h"
 
 static MGPTextureManager *_sharedTextureManager = nil;
 
+// texture pool backend, context is the MTLDevice
+static void *temporary_texture_create(void *context, const mgp_texture_pool_key_t *key, size_t *bytes) {
+    id<MTLDevice> device = (__bridge id<MTLDevice>)context;
+    MTLTextureDescriptor *descriptor = [MTLTextureDescriptor new];
+    descriptor.textureType = key->textureType;
+    descriptor.pixelFormat = key->pixelFormat;
+    descriptor.width = key->width;
+    descriptor.height = key->height;
+    descriptor.depth = key->depth;
+    descriptor.mipmapLevelCount = key->mipmapLevelCount;
+    descriptor.arrayLength = key->arrayLength;
+    descriptor.sampleCount = key->sampleCount;
+    descriptor.storageMode = key->storageMode;
+    descriptor.usage = key->usage;
+    id<MTLTexture> texture = [device newTextureWithDescriptor:descriptor];
+    if(texture == nil)
+        return NULL;
+    *bytes = texture.allocatedSize;
+    return (void *)CFBridgingRetain(texture);
+}
+
+static void temporary_texture_destroy(void *context, void *texture) {
+    CFBridgingRelease(texture);
+}
+
 @implementation MGPTextureManager {
     id<MTLDevice> _device;
-    
-    NSMutableDictionary<NSNumber*,NSMutableSet<id<MTLTexture>>*> *_unusedTemporaryTextures;
-    NSMutableDictionary<NSNumber*,NSMutableSet<id<MTLTexture>>*> *_usedTemporaryTextures;
+    mgp_texture_pool_t *_temporaryTexturePool;
 }
 
 - (instancetype)initWithDevice:(id<MTLDevice>)device {
@@ -22,44 +47,56 @@ static MGPTextureManager *_sharedTextureManager = nil;
     if(self) {
         _device = device;
         _sharedTextureManager = self;
-        _unusedTemporaryTextures = [NSMutableDictionary new];
-        _usedTemporaryTextures = [NSMutableDictionary new];
+        _temporaryTextureMaxUnusedFrames = 8;
+        mgp_texture_pool_backend_t backend = {
+            .create_texture = temporary_texture_create,
+            .destroy_texture = temporary_texture_destroy,
+            .context = (__bridge void *)device
+        };
+        _temporaryTexturePool = mgp_texture_pool_create(&backend, 0, (uint32_t)_temporaryTextureMaxUnusedFrames);
     }
     return self;
 }
 
+- (void)dealloc {
+    mgp_texture_pool_destroy(_temporaryTexturePool);
+}
+
 + (MGPTextureManager *)sharedTextureManager {
     return _sharedTextureManager;
 }
 
-- (NSNumber*)_identifierFromWidth:(NSUInteger)width
-                           height:(NSUInteger)height
-                      pixelFormat:(MTLPixelFormat)pixelFormat
-                      storageMode:(MTLStorageMode)storageMode
-                            usage:(MTLTextureUsage)usage
-                 mipmapLevelCount:(NSUInteger)mipmapLevelCount
-                      arrayLength:(NSUInteger)arrayLength {
-    NSUInteger identifier = width;
-    identifier = (identifier << 14) | height;
-    identifier = (identifier << 10) | pixelFormat;
-    identifier = (identifier << 4) | storageMode;
-    identifier = (identifier << 6) | usage;
-    identifier = (identifier << 4) | mipmapLevelCount;
-    identifier = (identifier << 4) | arrayLength;
-    return @(identifier);
+- (void)setTemporaryTextureBudget:(NSUInteger)temporaryTextureBudget {
+    _temporaryTextureBudget = temporaryTextureBudget;
+    mgp_texture_pool_set_budget(_temporaryTexturePool, temporaryTextureBudget);
+}
+
+- (void)setTemporaryTextureMaxUnusedFrames:(NSUInteger)temporaryTextureMaxUnusedFrames {
+    _temporaryTextureMaxUnusedFrames = temporaryTextureMaxUnusedFrames;
+    mgp_texture_pool_set_max_unused_frames(_temporaryTexturePool, (uint32_t)temporaryTextureMaxUnusedFrames);
+}
+
+- (void)beginFrame {
+    mgp_texture_pool_begin_frame(_temporaryTexturePool);
 }
 
 - (id<MTLTexture>)newTemporaryTextureWithDescriptor:(MTLTextureDescriptor *)descriptor {
     if(descriptor == nil)
         return nil;
     
-    return [self newTemporaryTextureWithWidth:descriptor.width
-                                       height:descriptor.height
-                                  pixelFormat:descriptor.pixelFormat
-                                  storageMode:descriptor.storageMode
-                                        usage:descriptor.usage
-                             mipmapLevelCount:descriptor.mipmapLevelCount
-                                  arrayLength:descriptor.arrayLength];
+    mgp_texture_pool_key_t key = {
+        .textureType = (uint32_t)descriptor.textureType,
+        .pixelFormat = (uint32_t)descriptor.pixelFormat,
+        .width = (uint32_t)descriptor.width,
+        .height = (uint32_t)descriptor.height,
+        .depth = (uint32_t)descriptor.depth,
+        .mipmapLevelCount = (uint32_t)descriptor.mipmapLevelCount,
+        .arrayLength = (uint32_t)descriptor.arrayLength,
+        .sampleCount = (uint32_t)descriptor.sampleCount,
+        .storageMode = (uint32_t)descriptor.storageMode,
+        .usage = (uint32_t)descriptor.usage
+    };
+    return (__bridge id<MTLTexture>)mgp_texture_pool_acquire(_temporaryTexturePool, &key);
 }
 
 - (id<MTLTexture>)newTemporaryTextureWithWidth:(NSUInteger)width
@@ -69,89 +106,152 @@ static MGPTextureManager *_sharedTextureManager = nil;
                                          usage:(MTLTextureUsage)usage
                               mipmapLevelCount:(NSUInteger)mipmapLevelCount
                                    arrayLength:(NSUInteger)arrayLength {
-    NSNumber *identifier = [self _identifierFromWidth:width
-                                               height:height
-                                          pixelFormat:pixelFormat
-                                          storageMode:storageMode
-                                                usage:usage
-                                     mipmapLevelCount:mipmapLevelCount
-                                          arrayLength:arrayLength];
-    
-    NSMutableSet<id<MTLTexture>> *unusedSet = _unusedTemporaryTextures[identifier];
-    NSMutableSet<id<MTLTexture>> *usedSet = _usedTemporaryTextures[identifier];
-    if(!unusedSet) {
-        unusedSet = [NSMutableSet set];
-        _unusedTemporaryTextures[identifier] = unusedSet;
-    }
-    if(!usedSet) {
-        usedSet = [NSMutableSet set];
-        _usedTemporaryTextures[identifier] = usedSet;
+    MTLTextureDescriptor *descriptor = [MTLTextureDescriptor texture2DDescriptorWithPixelFormat:pixelFormat
+                                                                                          width:width
+                                                                                         height:height
+                                                                                      mipmapped:mipmapLevelCount > 1];
+    descriptor.usage = usage;
+    descriptor.storageMode = storageMode;
+    if(mipmapLevelCount > 1)
+        descriptor.mipmapLevelCount = mipmapLevelCount;
+    if(arrayLength > 1) {
+        descriptor.textureType = MTLTextureType2DArray;
+        descriptor.arrayLength = arrayLength;
     }
-    
-    id<MTLTexture> texture = nil;
-    if([unusedSet count]) {
-        texture = [unusedSet anyObject];
-        [unusedSet removeObject:texture];
-    }
-    else {
-        MTLTextureDescriptor *descriptor = [MTLTextureDescriptor texture2DDescriptorWithPixelFormat:pixelFormat
-                                                                                              width:width
-                                                                                             height:height
-                                                                                          mipmapped:mipmapLevelCount > 1];
-        descriptor.usage = usage;
-        descriptor.storageMode = storageMode;
-        if(mipmapLevelCount > 1)
-            descriptor.mipmapLevelCount = mipmapLevelCount;
-        if(arrayLength > 1) {
-            descriptor.textureType = MTLTextureType2DArray;
-            descriptor.arrayLength = arrayLength;
-        }
-        texture = [_device newTextureWithDescriptor:descriptor];
-    }
-    if(texture)
-        [usedSet addObject:texture];
-    return texture;
+    return [self newTemporaryTextureWithDescriptor:descriptor];
 }
 
 - (void)releaseTemporaryTexture:(id<MTLTexture>)texture {
     if(texture == nil)
         return;
     
-    NSNumber *identifier = [self _identifierFromWidth:texture.width
-                                               height:texture.height
-                                          pixelFormat:texture.pixelFormat
-                                          storageMode:texture.storageMode
-                                                usage:texture.usage
-                                     mipmapLevelCount:texture.mipmapLevelCount
-                                          arrayLength:texture.arrayLength];
-    
-    NSMutableSet<id<MTLTexture>> *unusedSet = _unusedTemporaryTextures[identifier];
-    NSMutableSet<id<MTLTexture>> *usedSet = _usedTemporaryTextures[identifier];
-    if(!unusedSet) {
-        unusedSet = [NSMutableSet set];
-        _unusedTemporaryTextures[identifier] = unusedSet;
-    }
-    if(!usedSet) {
-        usedSet = [NSMutableSet set];
-        _usedTemporaryTextures[identifier] = usedSet;
+    if(!mgp_texture_pool_release(_temporaryTexturePool, (__bridge void *)texture))
+        NSLog(@"This is not temporary texture(0x%016lX)!", (uintptr_t)texture);
+}
+
+- (void)clearUnusedTemporaryTextures {
+    mgp_texture_pool_purge(_temporaryTexturePool);
+}
+
+- (MGPTemporaryTextureStatistics)temporaryTextureStatistics {
+    mgp_texture_pool_stats_t stats = {};
+    mgp_texture_pool_get_stats(_temporaryTexturePool, &stats);
+    return (MGPTemporaryTextureStatistics) {
+        .hits = stats.hits,
+        .misses = stats.misses,
+        .evictions = stats.evictions,
+        .residentBytes = stats.residentBytes,
+        .unusedBytes = stats.unusedBytes
+    };
+}
+
+- (NSUInteger)temporaryTextureBytesOfPixelFormat:(MTLPixelFormat)pixelFormat {
+    return mgp_texture_pool_resident_bytes_of_format(_temporaryTexturePool, (uint32_t)pixelFormat);
+}
+
+- (MGPTransientTextureSet *)newTransientTextureSet {
+    return [[MGPTransientTextureSet alloc] initWithDevice:_device];
+}
+
+@end
+
+@implementation MGPTransientTextureSet {
+    NSMutableArray<MTLTextureDescriptor*> *_descriptors;
+    NSMutableArray *_textures;          // id<MTLTexture>, or NSNull if failed
+    NSMutableData *_requests;           // mgp_alias_request_t
+    id<MTLHeap> _heap;
+}
+
+- (instancetype)initWithDevice:(id<MTLDevice>)device {
+    self = [super init];
+    if(self) {
+        _device = device;
+        _descriptors = [NSMutableArray new];
+        _textures = [NSMutableArray new];
+        _requests = [NSMutableData new];
     }
+    return self;
+}
+
+- (NSUInteger)addTextureWithDescriptor:(MTLTextureDescriptor *)descriptor
+                              firstUse:(NSUInteger)firstUse
+                               lastUse:(NSUInteger)lastUse {
+    MTLSizeAndAlign sizeAndAlign = [_device heapTextureSizeAndAlignWithDescriptor:descriptor];
+    mgp_alias_request_t request = {
+        .size = sizeAndAlign.size,
+        .alignment = sizeAndAlign.align,
+        .firstUse = (uint32_t)firstUse,
+        .lastUse = (uint32_t)MAX(firstUse, lastUse)
+    };
+    [_requests appendBytes:&request length:sizeof(mgp_alias_request_t)];
+    [_descriptors addObject:[descriptor copy]];
+    return _descriptors.count - 1;
+}
+
+- (void)removeAllTextures {
+    [_descriptors removeAllObjects];
+    [_textures removeAllObjects];
+    _requests.length = 0;
+    _heap = nil;
+    _fence = nil;
+    _heapSize = 0;
+    _unaliasedSize = 0;
+}
+
+- (void)makeTextures {
+    NSUInteger count = _descriptors.count;
+    [_textures removeAllObjects];
+    _heap = nil;
+    _fence = nil;
+    
+    const mgp_alias_request_t *requests = (const mgp_alias_request_t *)_requests.bytes;
+    uint64_t *offsets = malloc(sizeof(uint64_t) * MAX(count, 1));
+    mgp_alias_stats_t stats = {};
+    mgp_alias_plan(requests, count, offsets, &stats);
+    _unaliasedSize = stats.unaliasedSize;
     
-    if([usedSet containsObject:texture]) {
-        [usedSet removeObject:texture];
-        [unusedSet addObject:texture];
+    if(@available(macOS 10.15, iOS 13.0, *)) {
+        if(count > 0) {
+            MTLHeapDescriptor *heapDescriptor = [MTLHeapDescriptor new];
+            heapDescriptor.type = MTLHeapTypePlacement;
+            heapDescriptor.storageMode = MTLStorageModePrivate;
+            heapDescriptor.size = stats.heapSize;
+            _heap = [_device newHeapWithDescriptor:heapDescriptor];
+            _heap.label = @"Transient Textures";
+            _fence = [_device newFence];
+        }
     }
-    else {
-        NSLog(@"This is not temporary texture(0x%016lX)!", (uintptr_t)texture);
+    
+    _heapSize = 0;
+    for(NSUInteger i = 0; i < count; i++) {
+        MTLTextureDescriptor *descriptor = _descriptors[i];
+        id<MTLTexture> texture = nil;
+        if(_heap && descriptor.storageMode == MTLStorageModePrivate) {
+            if(@available(macOS 10.15, iOS 13.0, *)) {
+                texture = [_heap newTextureWithDescriptor:descriptor
+                                                   offset:offsets[i]];
+            }
+        }
+        if(texture == nil) {
+            // not placeable, uses its own memory
+            texture = [_device newTextureWithDescriptor:descriptor];
+            _heapSize += requests[i].size;
+        }
+        [_textures addObject:texture ?: NSNull.null];
     }
+    if(_heap)
+        _heapSize += stats.heapSize;
+    free(offsets);
 }
 
-- (void)clearUnusedTemporaryTextures {
-    NSNumber *key = nil;
-    NSEnumerator<NSNumber*> *e = _unusedTemporaryTextures.keyEnumerator;
-    while((key = e.nextObject)) {
-        [_unusedTemporaryTextures[key] removeAllObjects];
-    }
-    [_unusedTemporaryTextures removeAllObjects];
+- (NSUInteger)savedSize {
+    return _unaliasedSize > _heapSize ? _unaliasedSize - _heapSize : 0;
+}
+
+- (id<MTLTexture>)textureAtIndex:(NSUInteger)index {
+    if(index >= _textures.count || _textures[index] == NSNull.null)
+        return nil;
+    return _textures[index];
 }
 
 @end
@@ -43,10 +43,16 @@ const size_t kLightCullBufferSize = 19881*4*16; // fits Pro Display XDR (6016/16
 const NSUInteger kLightCountPerDrawCall = 4;
 
 #define DEG_TO_RAD(x) ((x)*0.0174532925)
+// per-frame ranges of buffers bound to constant address space are aligned to 256 bytes
+#define ALIGN_UP_256(x) (((x) + 255) & ~(size_t)255)
+#define INSTANCE_PROPS_STRIDE ALIGN_UP_256(sizeof(instance_props_t) * kNumInstance)
+#define MATERIALS_STRIDE ALIGN_UP_256(sizeof(material_t) * kNumInstance)
 
 @implementation DeferredRenderer {
     camera_props_t camera_props[kMaxBuffersInFlight];
     instance_props_t instance_props[kMaxBuffersInFlight * kNumInstance];
+    material_t instance_materials[kMaxBuffersInFlight * kNumInstance];
+    matrix_float4x4 instance_models[kNumInstance];
     light_t light_props[kMaxBuffersInFlight * kNumLight];
     light_global_t light_globals[kMaxBuffersInFlight];
     
@@ -67,6 +73,7 @@ const NSUInteger kLightCountPerDrawCall = 4;
     // props
     id<MTLBuffer> _cameraPropsBuffer;
     id<MTLBuffer> _instancePropsBuffer;
+    id<MTLBuffer> _materialsBuffer;
     id<MTLBuffer> _lightPropsBuffer;
     id<MTLBuffer> _lightGlobalBuffer;
     id<MTLBuffer> _lightShadowPropsBuffer;
@@ -242,8 +249,10 @@ const NSUInteger kLightCountPerDrawCall = 4;
     // props
     _cameraPropsBuffer = [self.device newBufferWithLength: sizeof(camera_props)
                                                   options: MTLResourceStorageModeManaged];
-    _instancePropsBuffer = [self.device newBufferWithLength: sizeof(instance_props)
+    _instancePropsBuffer = [self.device newBufferWithLength: INSTANCE_PROPS_STRIDE * kMaxBuffersInFlight
                                                     options: MTLResourceStorageModeManaged];
+    _materialsBuffer = [self.device newBufferWithLength: MATERIALS_STRIDE * kMaxBuffersInFlight
+                                                options: MTLResourceStorageModeManaged];
     _lightPropsBuffer = [self.device newBufferWithLength: sizeof(light_props)
                                                  options: MTLResourceStorageModeManaged];
     _lightGlobalBuffer = [self.device newBufferWithLength: sizeof(light_globals)
@@ -529,13 +538,16 @@ const NSUInteger kLightCountPerDrawCall = 4;
     }
     
     for(NSInteger i = 0; i < kNumInstance; i++) {
-        instance_props_t *p = &instance_props[_currentBufferIndex * kNumInstance + i];
-        p->model = matrix_from_translation(instance_pos[i].x, instance_pos[i].y, instance_pos[i].z);
-        p->model.columns[0].x = p->model.columns[1].y = p->model.columns[2].z = 0.01f;
-        p->material.albedo = instance_albedo[i];
-        p->material.roughness = self.roughness;
-        p->material.metalic = self.metalic;
-        p->material.anisotropy = self.anisotropy;
+        matrix_float4x4 model = matrix_from_translation(instance_pos[i].x, instance_pos[i].y, instance_pos[i].z);
+        model.columns[0].x = model.columns[1].y = model.columns[2].z = 0.01f;
+        instance_models[i] = model;
+        instance_props[_currentBufferIndex * kNumInstance + i] = instance_props_make(model, (uint32_t)i);
+        
+        material_t *m = &instance_materials[_currentBufferIndex * kNumInstance + i];
+        m->albedo = instance_albedo[i];
+        m->roughness = self.roughness;
+        m->metalic = self.metalic;
+        m->anisotropy = self.anisotropy;
     }
     
     // Update lights
@@ -610,11 +622,16 @@ const NSUInteger kLightCountPerDrawCall = 4;
     [_cameraPropsBuffer didModifyRange: NSMakeRange(_currentBufferIndex * sizeof(camera_props_t),
                                                     sizeof(camera_props_t))];
     
-    memcpy(_instancePropsBuffer.contents + _currentBufferIndex * sizeof(instance_props_t) * kNumInstance,
+    memcpy(_instancePropsBuffer.contents + _currentBufferIndex * INSTANCE_PROPS_STRIDE,
            &instance_props[_currentBufferIndex * kNumInstance], sizeof(instance_props_t) * kNumInstance);
-    [_instancePropsBuffer didModifyRange: NSMakeRange(_currentBufferIndex * sizeof(instance_props_t) * kNumInstance,
+    [_instancePropsBuffer didModifyRange: NSMakeRange(_currentBufferIndex * INSTANCE_PROPS_STRIDE,
                                                       sizeof(instance_props_t) * kNumInstance)];
     
+    memcpy(_materialsBuffer.contents + _currentBufferIndex * MATERIALS_STRIDE,
+           &instance_materials[_currentBufferIndex * kNumInstance], sizeof(material_t) * kNumInstance);
+    [_materialsBuffer didModifyRange: NSMakeRange(_currentBufferIndex * MATERIALS_STRIDE,
+                                                  sizeof(material_t) * kNumInstance)];
+    
     memcpy(_lightPropsBuffer.contents + _currentBufferIndex * sizeof(light_t) * kNumLight,
            &light_props[_currentBufferIndex * kNumLight], sizeof(light_t) * _numLights);
     [_lightPropsBuffer didModifyRange: NSMakeRange(_currentBufferIndex * sizeof(light_t) * kNumLight,
@@ -630,6 +647,8 @@ const NSUInteger kLightCountPerDrawCall = 4;
 }
 
 - (void)render {
+    [_textureManager beginFrame];
+    
     if(_IBLOn) {
         if(_IBLs[_currentIBLIndex].isAnyRenderingRequired) {
             [self performPrefilterPass];
@@ -802,7 +821,7 @@ const NSUInteger kLightCountPerDrawCall = 4;
 - (void)renderObjects:(id<MTLRenderCommandEncoder>)encoder
          bindTextures:(BOOL)bindTextures
               frustum:(MGPFrustum *)frustum {
-    MGPFrustum *localSpaceFrustum = [frustum frustumByMultipliedWithMatrix:simd_inverse(instance_props[_currentBufferIndex * kNumInstance].model)];
+    MGPFrustum *localSpaceFrustum = [frustum frustumByMultipliedWithMatrix:simd_inverse(instance_models[0])];
     
     id<MTLTexture> textures[tex_total] = {};
     BOOL textureChangedFlags[tex_total] = {};
@@ -923,11 +942,14 @@ const NSUInteger kLightCountPerDrawCall = 4;
     
     // instance
     [encoder setVertexBuffer: _instancePropsBuffer
-                      offset: _currentBufferIndex * sizeof(instance_props_t) * kNumInstance
+                      offset: _currentBufferIndex * INSTANCE_PROPS_STRIDE
                      atIndex: 2];
     [encoder setFragmentBuffer: _instancePropsBuffer
-                        offset: _currentBufferIndex * sizeof(instance_props_t) * kNumInstance
+                        offset: _currentBufferIndex * INSTANCE_PROPS_STRIDE
                        atIndex: 2];
+    [encoder setFragmentBuffer: _materialsBuffer
+                        offset: _currentBufferIndex * MATERIALS_STRIDE
+                       atIndex: 3];
     
     static MGPFrustum *frustum = nil;
     if(_locksFrustum) {
@@ -974,7 +996,7 @@ const NSUInteger kLightCountPerDrawCall = 4;
                                   offset: _currentBufferIndex * sizeof(light_global_t)
                                  atIndex: 2];
                 [encoder setVertexBuffer: _instancePropsBuffer
-                                  offset: _currentBufferIndex * sizeof(instance_props_t) * kNumInstance
+                                  offset: _currentBufferIndex * INSTANCE_PROPS_STRIDE
                                  atIndex: 3];
                 
                 [self renderObjects: encoder
@@ -1293,7 +1315,6 @@ const NSUInteger kLightCountPerDrawCall = 4;
     [super resize:newSize];
     
     CGSize scaledSize = self.scaledSize;
-    [_textureManager clearUnusedTemporaryTextures];
     [_gBuffer resize:scaledSize];
     [_postProcess resize:scaledSize];
     MGPProjectionState proj = _camera.projectionState;
@@ -0,0 +1,154 @@
+//
+//  AliasingPlannerTests.cpp
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/18.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#include "MGPTest.h"
+#include "MGPAliasingPlanner.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace {
+    bool livesOverlap(const mgp_alias_request_t &a, const mgp_alias_request_t &b) {
+        return a.firstUse <= b.lastUse && b.firstUse <= a.lastUse;
+    }
+
+    bool memoryOverlaps(uint64_t offsetA, uint64_t sizeA, uint64_t offsetB, uint64_t sizeB) {
+        return offsetA < offsetB + sizeB && offsetB < offsetA + sizeA;
+    }
+
+    // largest sum of sizes used by any one pass
+    uint64_t peakLiveSize(const std::vector<mgp_alias_request_t> &requests) {
+        uint32_t lastPass = 0;
+        for(const mgp_alias_request_t &request : requests)
+            lastPass = std::max(lastPass, request.lastUse);
+        uint64_t peak = 0;
+        for(uint32_t pass = 0; pass <= lastPass; pass++) {
+            uint64_t live = 0;
+            for(const mgp_alias_request_t &request : requests) {
+                if(request.firstUse <= pass && pass <= request.lastUse)
+                    live += request.size;
+            }
+            peak = std::max(peak, live);
+        }
+        return peak;
+    }
+
+    std::vector<mgp_alias_request_t> randomRequests(std::mt19937 &random) {
+        std::vector<mgp_alias_request_t> requests(1 + random() % 40);
+        for(mgp_alias_request_t &request : requests) {
+            request.size = (1 + random() % 64) * 4096 + random() % 3 * 256;
+            request.alignment = random() % 8 == 0 ? 0 : 1ull << (random() % 17);
+            request.firstUse = random() % 20;
+            request.lastUse = request.firstUse + random() % 6;
+        }
+        return requests;
+    }
+}
+
+MGP_TEST(randomPlansNeverOverlapLiveResources) {
+    std::mt19937 random(7);
+    for(int trial = 0; trial < 2000; trial++) {
+        std::vector<mgp_alias_request_t> requests = randomRequests(random);
+        std::vector<uint64_t> offsets(requests.size());
+        uint64_t heapSize = mgp_alias_plan(requests.data(), requests.size(), offsets.data(), nullptr);
+
+        bool overlaps = false, outside = false;
+        for(size_t i = 0; i < requests.size(); i++) {
+            outside |= offsets[i] + requests[i].size > heapSize;
+            for(size_t j = i + 1; j < requests.size(); j++) {
+                overlaps |= livesOverlap(requests[i], requests[j]) &&
+                            memoryOverlaps(offsets[i], requests[i].size, offsets[j], requests[j].size);
+            }
+        }
+        MGP_CHECK(!overlaps);
+        MGP_CHECK(!outside);
+    }
+}
+
+MGP_TEST(randomPlansAreAligned) {
+    std::mt19937 random(11);
+    for(int trial = 0; trial < 2000; trial++) {
+        std::vector<mgp_alias_request_t> requests = randomRequests(random);
+        std::vector<uint64_t> offsets(requests.size());
+        mgp_alias_plan(requests.data(), requests.size(), offsets.data(), nullptr);
+
+        bool misaligned = false;
+        for(size_t i = 0; i < requests.size(); i++) {
+            uint64_t alignment = std::max<uint64_t>(1, requests[i].alignment);
+            misaligned |= offsets[i] % alignment != 0;
+        }
+        MGP_CHECK(!misaligned);
+    }
+}
+
+MGP_TEST(randomPlansStayCloseToPeakLiveSize) {
+    std::mt19937 random(13);
+    const int trials = 2000;
+    double heapOverPeak = 0.0, heapOverUnaliased = 0.0;
+    for(int trial = 0; trial < trials; trial++) {
+        std::vector<mgp_alias_request_t> requests = randomRequests(random);
+        std::vector<uint64_t> offsets(requests.size());
+        mgp_alias_stats_t stats;
+        uint64_t heapSize = mgp_alias_plan(requests.data(), requests.size(), offsets.data(), &stats);
+
+        uint64_t unaliased = 0;
+        for(const mgp_alias_request_t &request : requests)
+            unaliased += request.size;
+        MGP_CHECK(stats.heapSize == heapSize);
+        MGP_CHECK(stats.unaliasedSize == unaliased);
+        MGP_CHECK(stats.peakLiveSize == peakLiveSize(requests));
+        MGP_CHECK(heapSize >= stats.peakLiveSize);
+        heapOverPeak += (double)heapSize / stats.peakLiveSize;
+        heapOverUnaliased += (double)heapSize / unaliased;
+    }
+    // measured 1.04 and 0.41 when the planner was written
+    MGP_CHECK(heapOverPeak / trials < 1.1);
+    MGP_CHECK(heapOverUnaliased / trials < 0.5);
+}
+
+MGP_TEST(disjointLifetimesShareMemory) {
+    std::vector<mgp_alias_request_t> requests = {
+        { 1 << 20, 4096, 0, 1 }, { 1 << 19, 4096, 2, 3 }, { 3 << 18, 4096, 4, 4 }
+    };
+    std::vector<uint64_t> offsets(requests.size());
+    uint64_t heapSize = mgp_alias_plan(requests.data(), requests.size(), offsets.data(), nullptr);
+    MGP_CHECK(heapSize == 1 << 20);
+    for(uint64_t offset : offsets)
+        MGP_CHECK(offset == 0);
+}
+
+MGP_TEST(overlappingLifetimesGetTheirOwnMemory) {
+    std::vector<mgp_alias_request_t> requests = {
+        { 1000, 256, 0, 2 }, { 3000, 256, 1, 3 }, { 500, 1024, 2, 2 }
+    };
+    std::vector<uint64_t> offsets(requests.size());
+    mgp_alias_stats_t stats;
+    uint64_t heapSize = mgp_alias_plan(requests.data(), requests.size(), offsets.data(), &stats);
+    MGP_CHECK(stats.peakLiveSize == 4500);
+    MGP_CHECK(heapSize >= 4500);
+    MGP_CHECK(offsets[2] % 1024 == 0);
+}
+
+MGP_TEST(emptyPlan) {
+    mgp_alias_stats_t stats;
+    MGP_CHECK(mgp_alias_plan(nullptr, 0, nullptr, &stats) == 0);
+    MGP_CHECK(stats.heapSize == 0 && stats.unaliasedSize == 0 && stats.peakLiveSize == 0);
+}
+
+// SSAO temporaries at 2560x1440 : deinterleaved depth, blur and interleave targets
+MGP_TEST(ssaoTemporariesAlias) {
+    std::vector<mgp_alias_request_t> requests = {
+        { 1280 * 720 * 2 * 4, 65536, 0, 3 }, { 1280 * 720 * 2, 65536, 1, 2 }, { 2560 * 1440 * 2, 65536, 3, 3 }
+    };
+    std::vector<uint64_t> offsets(requests.size());
+    mgp_alias_stats_t stats;
+    mgp_alias_plan(requests.data(), requests.size(), offsets.data(), &stats);
+    MGP_CHECK(stats.heapSize < stats.unaliasedSize);
+    MGP_CHECK(stats.heapSize - stats.peakLiveSize < 65536);
+}
@@ -0,0 +1,203 @@
+//
+//  BVHTests.cpp
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/18.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#include "MGPTest.h"
+#include "MGPBVH.h"
+
+#include <math.h>
+#include <random>
+#include <vector>
+
+namespace {
+    struct Vector {
+        float x, y, z;
+    };
+
+    Vector operator*(const Vector &v, float s) { return { v.x * s, v.y * s, v.z * s }; }
+    Vector operator+(const Vector &a, const Vector &b) { return { a.x + b.x, a.y + b.y, a.z + b.z }; }
+    float dot(const Vector &a, const Vector &b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+    Vector cross(const Vector &a, const Vector &b) {
+        return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+    }
+    Vector normalize(const Vector &v) { return v * (1.0f / sqrtf(dot(v, v))); }
+
+    // Perspective frustum of a random camera in the box field, 0.5 ~ 150.
+    mgp_cull_planes_t randomFrustum(std::mt19937 &random) {
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        Vector eye = { unit(random) * 60.0f, unit(random) * 60.0f, unit(random) * 60.0f };
+        Vector forward = normalize({ unit(random), unit(random), unit(random) + 0.01f });
+        Vector right = normalize(cross(fabsf(forward.y) < 0.9f ? Vector{ 0, 1, 0 } : Vector{ 1, 0, 0 }, forward));
+        Vector up = cross(forward, right);
+        float halfFov = 0.3f + (unit(random) + 1.0f) * 0.3f;
+        float c = cosf(halfFov), s = sinf(halfFov);
+
+        // inward normals, then the plane through the eye (or at near / far)
+        const Vector normals[6] = {
+            forward, forward * -1.0f,
+            right * c + forward * s, right * -c + forward * s,
+            up * c + forward * s, up * -c + forward * s
+        };
+        float equations[6][4];
+        for(int i = 0; i < 6; i++) {
+            equations[i][0] = normals[i].x;
+            equations[i][1] = normals[i].y;
+            equations[i][2] = normals[i].z;
+            equations[i][3] = -dot(normals[i], eye);
+        }
+        equations[0][3] -= 0.5f;
+        equations[1][3] += 150.0f;
+        mgp_cull_planes_t planes;
+        mgp_cull_planes_make(&planes, equations, 6);
+        return planes;
+    }
+
+    void setRandomBox(mgp_aabb_array_t &boxes, size_t i, std::mt19937 &random) {
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        float center[3] = { unit(random) * 100.0f, unit(random) * 100.0f, unit(random) * 100.0f };
+        float extent[3] = { 0.2f + (unit(random) + 1.0f) * 2.0f, 0.2f + (unit(random) + 1.0f) * 2.0f,
+                            0.2f + (unit(random) + 1.0f) * 2.0f };
+        uint32_t kind = random() % 50;
+        if(kind == 0)
+            extent[random() % 3] = -1.0f;
+        else if(kind == 1)
+            extent[random() % 3] = INFINITY;
+        else if(kind == 2)
+            center[random() % 3] = -INFINITY;
+        mgp_aabb_array_set(&boxes, i, center, extent);
+    }
+
+    // mgp_cull_aabbs, with the classes the tree documents : a negative extent is
+    // never visible, then a non-finite center or extent is always visible.
+    std::vector<uint64_t> bruteForce(const mgp_cull_planes_t &planes, const mgp_aabb_array_t &boxes) {
+        std::vector<uint64_t> visibility(MGP_CULL_BITSET_WORDS(boxes.count));
+        mgp_cull_aabbs(&planes, &boxes, visibility.data());
+        for(size_t i = 0; i < boxes.count; i++) {
+            const float extent[3] = { boxes.extent_x[i], boxes.extent_y[i], boxes.extent_z[i] };
+            const float center[3] = { boxes.center_x[i], boxes.center_y[i], boxes.center_z[i] };
+            bool negative = extent[0] < 0.0f || extent[1] < 0.0f || extent[2] < 0.0f;
+            bool finite = true;
+            for(int k = 0; k < 3; k++)
+                finite &= isfinite(extent[k]) && isfinite(center[k]);
+            if(negative)
+                visibility[i >> 6] &= ~(1ull << (i & 63));
+            else if(!finite)
+                visibility[i >> 6] |= 1ull << (i & 63);
+        }
+        return visibility;
+    }
+
+    size_t countBits(const std::vector<uint64_t> &bits) {
+        size_t count = 0;
+        for(uint64_t word : bits)
+            count += __builtin_popcountll(word);
+        return count;
+    }
+}
+
+// Single view, many views at once and leaf ranges all give what testing every
+// box gives, after builds and after refits of random moves, including boxes
+// that change class and force a rebuild.
+MGP_TEST(cullingMatchesBruteForceAfterRefits) {
+    const size_t count = 3001;
+    const size_t numViews = 70;
+    std::mt19937 random(1);
+    mgp_aabb_array_t boxes = {};
+    mgp_aabb_array_resize(&boxes, count);
+    for(size_t i = 0; i < count; i++)
+        setRandomBox(boxes, i, random);
+    mgp_bvh_t *bvh = mgp_bvh_create();
+    mgp_bvh_build(bvh, &boxes);
+    MGP_CHECK(mgp_bvh_primitive_count(bvh) == count);
+
+    size_t numWords = MGP_CULL_BITSET_WORDS(count);
+    bool single = true, views = true, ranges = true, counted = true;
+    size_t numVisible = 0;
+    for(int frame = 0; frame < 20; frame++) {
+        if(frame > 0) {
+            std::uniform_real_distribution<float> step(-3.0f, 3.0f);
+            for(size_t k = 0; k < count / 10; k++) {
+                size_t i = random() % count;
+                if(random() % 20 == 0) {
+                    setRandomBox(boxes, i, random);
+                    continue;
+                }
+                boxes.center_x[i] += step(random);
+                boxes.center_y[i] += step(random);
+                boxes.center_z[i] += step(random);
+            }
+            mgp_bvh_refit(bvh, &boxes);
+        }
+
+        std::vector<mgp_cull_planes_t> planes(numViews);
+        for(mgp_cull_planes_t &view : planes)
+            view = randomFrustum(random);
+        std::vector<uint64_t> allViews(numWords * numViews);
+        mgp_bvh_cull_views(bvh, planes.data(), numViews, allViews.data());
+
+        for(size_t view = 0; view < numViews; view++) {
+            std::vector<uint64_t> expected = bruteForce(planes[view], boxes);
+            numVisible += countBits(expected);
+
+            std::vector<uint64_t> visibility(numWords);
+            counted &= mgp_bvh_cull(bvh, &planes[view], visibility.data()) == countBits(expected);
+            single &= visibility == expected;
+            views &= std::vector<uint64_t>(allViews.begin() + view * numWords,
+                                           allViews.begin() + (view + 1) * numWords) == expected;
+
+            size_t numRanges = 0;
+            const mgp_bvh_range_t *visibleRanges = mgp_bvh_cull_ranges(bvh, &planes[view], &numRanges);
+            const uint32_t *indices = mgp_bvh_primitive_indices(bvh);
+            std::vector<uint64_t> fromRanges(numWords);
+            for(size_t r = 0; r < numRanges; r++) {
+                for(uint32_t slot = visibleRanges[r].first; slot < visibleRanges[r].first + visibleRanges[r].count; slot++) {
+                    uint32_t i = indices[slot];
+                    ranges &= (fromRanges[i >> 6] >> (i & 63) & 1) == 0;
+                    fromRanges[i >> 6] |= 1ull << (i & 63);
+                }
+            }
+            ranges &= fromRanges == expected;
+        }
+    }
+    MGP_CHECK(single);
+    MGP_CHECK(counted);
+    MGP_CHECK(views);
+    MGP_CHECK(ranges);
+    // frusta see some of the field beyond the always visible boxes, not all of it
+    size_t averageVisible = numVisible / (20 * numViews);
+    MGP_CHECK(averageVisible > count / 20 && averageVisible < count / 2);
+
+    mgp_bvh_destroy(bvh);
+    mgp_aabb_array_free(&boxes);
+}
+
+// Trees of only never or always visible boxes, and of none.
+MGP_TEST(unboundedBoxesOnly) {
+    std::mt19937 random(2);
+    mgp_cull_planes_t planes = randomFrustum(random);
+    mgp_aabb_array_t boxes = {};
+    mgp_aabb_array_resize(&boxes, 100);
+    for(size_t i = 0; i < 100; i++) {
+        const float center[3] = { 0, 0, 0 };
+        const float extent[3] = { i % 2 ? -1.0f : INFINITY, 1, 1 };
+        mgp_aabb_array_set(&boxes, i, center, extent);
+    }
+    mgp_bvh_t *bvh = mgp_bvh_create();
+    mgp_bvh_build(bvh, &boxes);
+    std::vector<uint64_t> visibility(MGP_CULL_BITSET_WORDS(100));
+    MGP_CHECK(mgp_bvh_cull(bvh, &planes, visibility.data()) == 50);
+    MGP_CHECK(visibility == bruteForce(planes, boxes));
+
+    mgp_aabb_array_resize(&boxes, 0);
+    mgp_bvh_build(bvh, &boxes);
+    size_t numRanges = 1;
+    mgp_bvh_cull_ranges(bvh, &planes, &numRanges);
+    MGP_CHECK(numRanges == 0);
+    MGP_CHECK(mgp_bvh_cull(bvh, &planes, visibility.data()) == 0);
+    mgp_bvh_destroy(bvh);
+    mgp_aabb_array_free(&boxes);
+}
@@ -0,0 +1,24 @@
+//
+//  CullingScalar.cpp
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/18.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+// MGPCulling.cpp once more with the scalar loop and mgp_*_scalar names, so
+// CullingTests can compare it with the SIMD path the test was built for.
+
+#define MGP_CULL_SCALAR 1
+#define mgp_cull_planes_make mgp_cull_planes_make_scalar
+#define mgp_aabb_array_resize mgp_aabb_array_resize_scalar
+#define mgp_aabb_array_free mgp_aabb_array_free_scalar
+#define mgp_sphere_array_resize mgp_sphere_array_resize_scalar
+#define mgp_sphere_array_free mgp_sphere_array_free_scalar
+#define mgp_cull_aabbs mgp_cull_aabbs_scalar
+#define mgp_cull_spheres mgp_cull_spheres_scalar
+#define mgp_aabb_transform mgp_aabb_transform_scalar
+#define mgp_cull_aabb_is_visible mgp_cull_aabb_is_visible_scalar
+#define mgp_cull_sphere_is_visible mgp_cull_sphere_is_visible_scalar
+
+#include "MGPCulling.cpp"
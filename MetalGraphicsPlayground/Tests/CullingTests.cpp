@@ -0,0 +1,144 @@
+//
+//  CullingTests.cpp
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/18.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#include "MGPTest.h"
+#include "MGPCulling.h"
+
+#include <stdint.h>
+#include <random>
+#include <vector>
+
+// the scalar loop, from CullingScalar.cpp
+extern "C" {
+size_t mgp_cull_aabbs_scalar(const mgp_cull_planes_t *planes,
+                             const mgp_aabb_array_t *aabbs,
+                             uint64_t *visibility);
+size_t mgp_cull_spheres_scalar(const mgp_cull_planes_t *planes,
+                               const mgp_sphere_array_t *spheres,
+                               uint64_t *visibility);
+}
+
+namespace {
+    // 1 ~ MGP_CULL_MAX_PLANES random planes through the field
+    mgp_cull_planes_t randomPlanes(std::mt19937 &random) {
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        uint32_t count = 1 + random() % MGP_CULL_MAX_PLANES;
+        float equations[MGP_CULL_MAX_PLANES][4];
+        for(uint32_t i = 0; i < count; i++) {
+            for(int k = 0; k < 3; k++)
+                equations[i][k] = unit(random);
+            equations[i][3] = unit(random) * 40.0f + 30.0f;
+        }
+        mgp_cull_planes_t planes;
+        mgp_cull_planes_make(&planes, equations, count);
+        return planes;
+    }
+}
+
+// Counts around the batch width of every path (4 and 8) and the bitset words,
+// so the batched loop and the remainder both run.
+MGP_TEST(simdMatchesScalar) {
+    std::mt19937 random(1);
+    std::uniform_real_distribution<float> position(-100.0f, 100.0f), size(0.0f, 10.0f);
+    bool aabbs = true, spheres = true;
+    size_t numVisible = 0, numTested = 0;
+    for(size_t count : { 1, 3, 4, 5, 7, 8, 9, 15, 17, 63, 64, 65, 127, 1001, 4099 }) {
+        mgp_aabb_array_t boxes = {};
+        mgp_sphere_array_t balls = {};
+        MGP_CHECK(mgp_aabb_array_resize(&boxes, count));
+        MGP_CHECK(mgp_sphere_array_resize(&balls, count));
+        for(size_t i = 0; i < count; i++) {
+            const float center[3] = { position(random), position(random), position(random) };
+            const float extent[3] = { size(random), size(random), size(random) };
+            mgp_aabb_array_set(&boxes, i, center, extent);
+            balls.center_x[i] = center[0];
+            balls.center_y[i] = center[1];
+            balls.center_z[i] = center[2];
+            balls.radius[i] = extent[0];
+        }
+
+        for(int p = 0; p < 20; p++) {
+            mgp_cull_planes_t planes = randomPlanes(random);
+            // filled with garbage, every word is written
+            std::vector<uint64_t> visibility(MGP_CULL_BITSET_WORDS(count), ~0ull), expected(visibility.size());
+            size_t n = mgp_cull_aabbs(&planes, &boxes, visibility.data());
+            aabbs &= n == mgp_cull_aabbs_scalar(&planes, &boxes, expected.data()) && visibility == expected;
+            numVisible += n;
+            numTested += count;
+
+            std::fill(visibility.begin(), visibility.end(), ~0ull);
+            n = mgp_cull_spheres(&planes, &balls, visibility.data());
+            spheres &= n == mgp_cull_spheres_scalar(&planes, &balls, expected.data()) && visibility == expected;
+        }
+        mgp_sphere_array_free(&balls);
+        mgp_aabb_array_free(&boxes);
+    }
+    MGP_CHECK(aabbs);
+    MGP_CHECK(spheres);
+    MGP_CHECK(numVisible > numTested / 10 && numVisible < numTested * 9 / 10);
+}
+
+// The batched test agrees with the single volume test.
+MGP_TEST(batchesMatchSingleTests) {
+    std::mt19937 random(2);
+    std::uniform_real_distribution<float> position(-100.0f, 100.0f), size(0.0f, 10.0f);
+    const size_t count = 1003;
+    mgp_aabb_array_t boxes = {};
+    mgp_aabb_array_resize(&boxes, count);
+    for(size_t i = 0; i < count; i++) {
+        const float center[3] = { position(random), position(random), position(random) };
+        const float extent[3] = { size(random), size(random), size(random) };
+        mgp_aabb_array_set(&boxes, i, center, extent);
+    }
+    mgp_cull_planes_t planes = randomPlanes(random);
+    std::vector<uint64_t> visibility(MGP_CULL_BITSET_WORDS(count));
+    mgp_cull_aabbs(&planes, &boxes, visibility.data());
+    bool same = true;
+    for(size_t i = 0; i < count; i++) {
+        const float center[3] = { boxes.center_x[i], boxes.center_y[i], boxes.center_z[i] };
+        const float extent[3] = { boxes.extent_x[i], boxes.extent_y[i], boxes.extent_z[i] };
+        same &= (int)(visibility[i >> 6] >> (i & 63) & 1) == mgp_cull_aabb_is_visible(&planes, center, extent);
+    }
+    MGP_CHECK(same);
+    mgp_aabb_array_free(&boxes);
+}
+
+MGP_TEST(resizeKeepsVolumesAndReportsFailure) {
+    mgp_aabb_array_t boxes = {};
+    MGP_CHECK(mgp_aabb_array_resize(&boxes, 5));
+    for(size_t i = 0; i < 5; i++) {
+        const float center[3] = { (float)i, 0, 0 }, extent[3] = { 1, 1, (float)i };
+        mgp_aabb_array_set(&boxes, i, center, extent);
+    }
+    MGP_CHECK(mgp_aabb_array_resize(&boxes, 1000));
+    MGP_CHECK(boxes.count == 1000 && boxes.capacity >= 1000);
+    MGP_CHECK(((uintptr_t)boxes.center_x & 31) == 0 && ((uintptr_t)boxes.extent_z & 31) == 0);
+    bool kept = true;
+    for(size_t i = 0; i < 5; i++)
+        kept &= boxes.center_x[i] == (float)i && boxes.extent_z[i] == (float)i;
+    MGP_CHECK(kept);
+
+    // too large to allocate, or to even compute the size of
+    float *centers = boxes.center_x;
+    size_t capacity = boxes.capacity;
+    MGP_CHECK(!mgp_aabb_array_resize(&boxes, (size_t)1 << 56));
+    MGP_CHECK(!mgp_aabb_array_resize(&boxes, SIZE_MAX));
+    MGP_CHECK(boxes.center_x == centers && boxes.capacity == capacity && boxes.count == 1000);
+    MGP_CHECK(boxes.center_x[4] == 4.0f);
+
+    // shrinking never allocates
+    MGP_CHECK(mgp_aabb_array_resize(&boxes, 3));
+    MGP_CHECK(boxes.count == 3 && boxes.center_x == centers);
+    mgp_aabb_array_free(&boxes);
+
+    mgp_sphere_array_t spheres = {};
+    MGP_CHECK(mgp_sphere_array_resize(&spheres, 10));
+    MGP_CHECK(!mgp_sphere_array_resize(&spheres, SIZE_MAX / 2));
+    MGP_CHECK(spheres.count == 10);
+    mgp_sphere_array_free(&spheres);
+}
@@ -0,0 +1,93 @@
+//
+//  DrawSortTests.cpp
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/18.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#include "MGPTest.h"
+#include "MGPDrawSort.h"
+
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace {
+    // Sorts with mgp_draw_keys_sort, values are the original indices. True if keys
+    // and values end up exactly as std::stable_sort leaves them.
+    bool sortsLikeStableSort(const std::vector<uint64_t> &input) {
+        size_t count = input.size();
+        std::vector<uint64_t> keys = input, tempKeys(count);
+        std::vector<uint32_t> values(count), tempValues(count);
+        for(size_t i = 0; i < count; i++)
+            values[i] = (uint32_t)i;
+        mgp_draw_keys_sort(keys.data(), values.data(), tempKeys.data(), tempValues.data(), count);
+
+        std::vector<std::pair<uint64_t, uint32_t>> expected(count);
+        for(size_t i = 0; i < count; i++)
+            expected[i] = { input[i], (uint32_t)i };
+        std::stable_sort(expected.begin(), expected.end(),
+                         [](const std::pair<uint64_t, uint32_t> &a, const std::pair<uint64_t, uint32_t> &b) {
+            return a.first < b.first;
+        });
+        bool same = true;
+        for(size_t i = 0; i < count; i++)
+            same &= keys[i] == expected[i].first && values[i] == expected[i].second;
+        return same;
+    }
+}
+
+MGP_TEST(randomKeysSortLikeStableSort) {
+    std::mt19937_64 random(1);
+    for(size_t count : { 0, 1, 2, 3, 255, 256, 1000, 100000 }) {
+        std::vector<uint64_t> keys(count);
+        for(uint64_t &key : keys)
+            key = random();
+        MGP_CHECK(sortsLikeStableSort(keys));
+
+        // few distinct keys, so equal keys have to keep their order
+        for(uint64_t &key : keys)
+            key = random() % 7 << 40 | random() % 3;
+        MGP_CHECK(sortsLikeStableSort(keys));
+    }
+}
+
+// Every subset of the bytes varying : bytes shared by every key skip their pass,
+// leaving an odd or even number of passes and so the result in either buffer.
+MGP_TEST(keysWithConstantBytesSortLikeStableSort) {
+    std::mt19937_64 random(2);
+    const size_t count = 5000;
+    std::vector<uint64_t> keys(count);
+    bool same = true;
+    for(uint64_t varyingBytes = 0; varyingBytes < 256; varyingBytes++) {
+        uint64_t mask = 0;
+        for(int byte = 0; byte < 8; byte++) {
+            if(varyingBytes >> byte & 1)
+                mask |= 0xffull << (byte * 8);
+        }
+        uint64_t constant = random() & ~mask;
+        for(uint64_t &key : keys)
+            key = constant | (random() & mask);
+        same &= sortsLikeStableSort(keys);
+    }
+    MGP_CHECK(same);
+}
+
+// Draw keys as the renderer makes them : a few pipelines and texture sets,
+// meshes, and depth varying the most.
+MGP_TEST(drawKeysSortLikeStableSort) {
+    std::mt19937 random(3);
+    std::vector<uint64_t> keys;
+    for(int i = 0; i < 20000; i++) {
+        const void *textures[2] = { (const void *)(uintptr_t)(0x1000 + random() % 12 * 64), nullptr };
+        keys.push_back(mgp_draw_key_make(random() % 2, random() % 5, mgp_draw_key_hash(textures, 2, 16),
+                                         random() % 40, mgp_draw_key_depth((float)(random() % 1000), 999.0f)));
+    }
+    MGP_CHECK(sortsLikeStableSort(keys));
+    std::sort(keys.begin(), keys.end());
+    MGP_CHECK(sortsLikeStableSort(keys));
+    std::reverse(keys.begin(), keys.end());
+    MGP_CHECK(sortsLikeStableSort(keys));
+}
@@ -0,0 +1,52 @@
+//
+//  MGPTest.cpp
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/18.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#include "MGPTest.h"
+
+#include <stdio.h>
+#include <vector>
+
+namespace {
+    struct Test {
+        const char *name;
+        mgp::test::Function function;
+    };
+
+    std::vector<Test> &tests() {
+        static std::vector<Test> list;
+        return list;
+    }
+
+    int numFailures = 0;
+}
+
+mgp::test::Registration::Registration(const char *name, Function function) {
+    tests().push_back({ name, function });
+}
+
+void mgp::test::fail(const char *file, int line, const char *expression) {
+    fprintf(stderr, "%s:%d: check failed : %s\n", file, line, expression);
+    numFailures++;
+}
+
+std::string mgp::test::assetPath(const char *relativePath) {
+    return std::string(MGP_SOURCE_DIR) + "/" + relativePath;
+}
+
+int main() {
+    int numFailedTests = 0;
+    for(const Test &test : tests()) {
+        int failuresBefore = numFailures;
+        test.function();
+        bool passed = numFailures == failuresBefore;
+        printf("[%s] %s\n", passed ? "  OK  " : "FAILED", test.name);
+        numFailedTests += !passed;
+    }
+    printf("%zu tests, %d failed\n", tests().size(), numFailedTests);
+    return numFailedTests > 0 ? 1 : 0;
+}
@@ -0,0 +1,46 @@
+//
+//  MGPTest.h
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/18.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#ifndef MGPTest_h
+#define MGPTest_h
+
+// Minimal test runner for the portable cores.
+// Every MGP_TEST in an executable runs in declaration order, a failed
+// MGP_CHECK is reported and the test goes on, main returns non-zero if any failed.
+
+#include <string>
+
+namespace mgp {
+namespace test {
+
+typedef void (*Function)();
+
+struct Registration {
+    Registration(const char *name, Function function);
+};
+
+void fail(const char *file, int line, const char *expression);
+
+// Path of a file under the MetalGraphicsPlayground directory.
+std::string assetPath(const char *relativePath);
+
+} // namespace test
+} // namespace mgp
+
+#define MGP_TEST(name) \
+    static void name##Test(); \
+    static mgp::test::Registration name##Registration(#name, name##Test); \
+    static void name##Test()
+
+#define MGP_CHECK(expression) \
+    do { \
+        if(!(expression)) \
+            mgp::test::fail(__FILE__, __LINE__, #expression); \
+    } while(0)
+
+#endif /* MGPTest_h */
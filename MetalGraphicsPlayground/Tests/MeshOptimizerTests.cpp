@@ -0,0 +1,170 @@
+//
+//  MeshOptimizerTests.cpp
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/18.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#include "MGPTest.h"
+#include "MGPMeshOptimizer.h"
+#include "MGPObjImporter.h"
+
+#include <string.h>
+#include <algorithm>
+#include <array>
+#include <vector>
+
+namespace {
+    // same settings as MGPMesh
+    const uint32_t kCacheSize = 32;
+    const float kOverdrawThreshold = 1.05f;
+
+    typedef std::array<uint32_t, 3> Triangle;
+
+    // Triangles rotated to start at their smallest index, winding kept, sorted.
+    std::vector<Triangle> triangleSet(const uint32_t *indices, size_t indexCount) {
+        std::vector<Triangle> triangles;
+        for(size_t i = 0; i + 2 < indexCount; i += 3) {
+            const uint32_t *t = indices + i;
+            int first = t[0] <= t[1] && t[0] <= t[2] ? 0 : (t[1] <= t[2] ? 1 : 2);
+            triangles.push_back({ { t[first], t[(first + 1) % 3], t[(first + 2) % 3] } });
+        }
+        std::sort(triangles.begin(), triangles.end());
+        return triangles;
+    }
+
+    struct Model {
+        mgp_obj_model_t *obj;
+
+        explicit Model(const char *relativePath) {
+            char error[256] = {};
+            obj = mgp_obj_load(mgp::test::assetPath(relativePath).c_str(), 1, error, sizeof(error));
+        }
+        ~Model() {
+            if(obj)
+                mgp_obj_destroy(obj);
+        }
+    };
+
+    struct MeshResult {
+        mgp_mesh_cache_stats_t before, after;
+        bool trianglesKept = true;
+        bool reordered = false;
+    };
+
+    // Optimizes every submesh of an object as MGPMesh does, then renumbers its vertices.
+    MeshResult optimizeObject(const mgp_obj_model_t *model, const mgp_obj_object_t &object) {
+        MeshResult result;
+        const mgp_obj_submesh_t &first = model->submeshes[object.submeshStart];
+        const mgp_obj_submesh_t &last = model->submeshes[object.submeshStart + object.submeshCount - 1];
+        const uint32_t *original = model->indices + first.indexStart;
+        size_t indexCount = last.indexStart + last.indexCount - first.indexStart;
+        const mgp_obj_vertex_t *vertices = model->vertices + object.vertexStart;
+        size_t vertexCount = object.vertexCount;
+
+        std::vector<uint32_t> indices(original, original + indexCount);
+        mgp_mesh_analyze_vertex_cache(indices.data(), indexCount, vertexCount, kCacheSize, &result.before);
+        for(uint32_t s = object.submeshStart; s < object.submeshStart + object.submeshCount; s++) {
+            const mgp_obj_submesh_t &submesh = model->submeshes[s];
+            uint32_t *submeshIndices = indices.data() + (submesh.indexStart - first.indexStart);
+            mgp_mesh_cache_stats_t before, after;
+            result.reordered |= mgp_mesh_optimize_triangle_order(submeshIndices, submeshIndices, submesh.indexCount,
+                                                                 vertices->position, vertexCount, sizeof(mgp_obj_vertex_t),
+                                                                 kOverdrawThreshold, kCacheSize, &before, &after) != 0;
+            MGP_CHECK(after.numTransformed <= before.numTransformed);
+            result.trianglesKept &= triangleSet(submeshIndices, submesh.indexCount) ==
+                                    triangleSet(model->indices + submesh.indexStart, submesh.indexCount);
+        }
+        mgp_mesh_analyze_vertex_cache(indices.data(), indexCount, vertexCount, kCacheSize, &result.after);
+
+        // the remap is a permutation, and the remapped mesh draws the same positions
+        std::vector<uint32_t> remap(vertexCount);
+        size_t usedCount = mgp_mesh_optimize_vertex_fetch_remap(remap.data(), indices.data(), indexCount, vertexCount);
+        std::vector<bool> taken(vertexCount, false);
+        bool permutation = usedCount <= vertexCount;
+        for(uint32_t target : remap) {
+            permutation &= target < vertexCount && !taken[target];
+            if(target < vertexCount)
+                taken[target] = true;
+        }
+        MGP_CHECK(permutation);
+
+        std::vector<mgp_obj_vertex_t> remapped(vertexCount);
+        std::vector<uint32_t> remappedIndices(indexCount);
+        mgp_mesh_remap_vertices(remapped.data(), vertices, vertexCount, sizeof(mgp_obj_vertex_t), remap.data());
+        mgp_mesh_remap_indices(remappedIndices.data(), indices.data(), indexCount, remap.data());
+        bool samePositions = true;
+        uint32_t highest = 0;
+        for(size_t i = 0; i < indexCount; i++) {
+            samePositions &= memcmp(remapped[remappedIndices[i]].position, vertices[indices[i]].position,
+                                    sizeof(float) * 3) == 0;
+            highest = std::max(highest, remappedIndices[i]);
+        }
+        MGP_CHECK(samePositions);
+        MGP_CHECK(highest + 1 == usedCount);
+        return result;
+    }
+}
+
+MGP_TEST(teapotKeepsItsTrianglesAndDoesNotRegress) {
+    Model teapot("MetalTextureLOD/teapot.obj");
+    MGP_CHECK(teapot.obj != nullptr);
+    if(teapot.obj == nullptr)
+        return;
+    for(uint32_t o = 0; o < teapot.obj->numObjects; o++) {
+        MeshResult result = optimizeObject(teapot.obj, teapot.obj->objects[o]);
+        MGP_CHECK(result.trianglesKept);
+        MGP_CHECK(result.after.acmr <= result.before.acmr);
+    }
+}
+
+// teapot's own order is already good for 32 entries (0.600 against 0.719 reordered),
+// but not for 16, where the passes help.
+MGP_TEST(teapotKeepsItsOrderWhereReorderingLoses) {
+    Model teapot("MetalTextureLOD/teapot.obj");
+    if(teapot.obj == nullptr)
+        return;
+    const mgp_obj_submesh_t &submesh = teapot.obj->submeshes[0];
+    const uint32_t *indices = teapot.obj->indices + submesh.indexStart;
+    const mgp_obj_object_t &object = teapot.obj->objects[0];
+    const float *positions = teapot.obj->vertices[object.vertexStart].position;
+    std::vector<uint32_t> destination(submesh.indexCount);
+
+    mgp_mesh_cache_stats_t before, after;
+    int reordered = mgp_mesh_optimize_triangle_order(destination.data(), indices, submesh.indexCount,
+                                                     positions, object.vertexCount, sizeof(mgp_obj_vertex_t),
+                                                     kOverdrawThreshold, 32, &before, &after);
+    MGP_CHECK(!reordered);
+    MGP_CHECK(memcmp(destination.data(), indices, sizeof(uint32_t) * submesh.indexCount) == 0);
+    MGP_CHECK(after.acmr == before.acmr);
+
+    reordered = mgp_mesh_optimize_triangle_order(destination.data(), indices, submesh.indexCount,
+                                                 positions, object.vertexCount, sizeof(mgp_obj_vertex_t),
+                                                 kOverdrawThreshold, 16, &before, &after);
+    MGP_CHECK(reordered);
+    MGP_CHECK(after.acmr < before.acmr * 0.8f);
+}
+
+MGP_TEST(legoAndBunnyImprove) {
+    for(const char *path : { "MetalShadowMapping/lego.obj", "MetalEnvironmentMapping/bun_zipper_res3.obj" }) {
+        Model model(path);
+        MGP_CHECK(model.obj != nullptr);
+        if(model.obj == nullptr)
+            continue;
+        for(uint32_t o = 0; o < model.obj->numObjects; o++) {
+            MeshResult result = optimizeObject(model.obj, model.obj->objects[o]);
+            MGP_CHECK(result.trianglesKept);
+            MGP_CHECK(result.reordered);
+            MGP_CHECK(result.after.acmr < result.before.acmr);
+        }
+    }
+}
+
+MGP_TEST(unusedVerticesGoLast) {
+    const uint32_t indices[] = { 4, 2, 0, 0, 2, 5 };
+    uint32_t remap[6];
+    MGP_CHECK(mgp_mesh_optimize_vertex_fetch_remap(remap, indices, 6, 6) == 4);
+    MGP_CHECK(remap[4] == 0 && remap[2] == 1 && remap[0] == 2 && remap[5] == 3);
+    MGP_CHECK(remap[1] == 4 && remap[3] == 5);
+}
@@ -0,0 +1,233 @@
+//
+//  MeshSimplifierTests.cpp
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/18.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#include "MGPTest.h"
+#include "MGPMeshSimplifier.h"
+
+#include <math.h>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace {
+    struct Vertex {
+        float position[3];
+        float uv[2];
+    };
+
+    // n x n quads over [0, 1]^2 at height(x, y). Vertices of the seam column are
+    // doubled : the chart left of it has u = x, the right one u = 2 + x. -1 for no seam.
+    struct Grid {
+        std::vector<Vertex> vertices;
+        std::vector<uint32_t> indices;
+        int seamColumn;
+
+        Grid(int n, int seamColumn, float (*height)(float, float)) : seamColumn(seamColumn) {
+            std::vector<uint32_t> left((n + 1) * (n + 1)), right((n + 1) * (n + 1));
+            for(int y = 0; y <= n; y++) {
+                for(int x = 0; x <= n; x++) {
+                    float px = x / (float)n, py = y / (float)n;
+                    Vertex vertex = { { px, py, height(px, py) }, { px, py } };
+                    if(x <= seamColumn) {
+                        left[y * (n + 1) + x] = (uint32_t)vertices.size();
+                        vertices.push_back(vertex);
+                    }
+                    if(x >= seamColumn) {
+                        vertex.uv[0] = 2.0f + px;
+                        right[y * (n + 1) + x] = (uint32_t)vertices.size();
+                        vertices.push_back(vertex);
+                    }
+                }
+            }
+            for(int y = 0; y < n; y++) {
+                for(int x = 0; x < n; x++) {
+                    const std::vector<uint32_t> &chart = x < seamColumn ? left : right;
+                    uint32_t a = chart[y * (n + 1) + x], b = chart[y * (n + 1) + x + 1];
+                    uint32_t c = chart[(y + 1) * (n + 1) + x + 1], d = chart[(y + 1) * (n + 1) + x];
+                    indices.insert(indices.end(), { a, b, c, a, c, d });
+                }
+            }
+        }
+
+        mgp_mesh_simplify_vertices_t simplifyVertices() const {
+            static const float weights[2] = { 1.0f, 1.0f };
+            mgp_mesh_simplify_vertices_t simplifyVertices = {
+                vertices[0].position, sizeof(Vertex), vertices[0].uv, sizeof(Vertex), weights, 2,
+                vertices.size(), NULL
+            };
+            return simplifyVertices;
+        }
+
+        std::vector<uint32_t> simplify(size_t targetIndexCount, float targetError, float *resultError = NULL) const {
+            mgp_mesh_simplify_vertices_t simplifyVertices = this->simplifyVertices();
+            std::vector<uint32_t> result(indices.size());
+            result.resize(mgp_mesh_simplify(result.data(), indices.data(), indices.size(), &simplifyVertices,
+                                            targetIndexCount, targetError, resultError));
+            return result;
+        }
+
+        // in the xy plane, counter-clockwise positive
+        float area(uint32_t a, uint32_t b, uint32_t c) const {
+            const float *p = vertices[a].position, *q = vertices[b].position, *r = vertices[c].position;
+            return 0.5f * ((q[0] - p[0]) * (r[1] - p[1]) - (r[0] - p[0]) * (q[1] - p[1]));
+        }
+
+        bool isLeft(uint32_t vertex) const {
+            return vertices[vertex].uv[0] < 1.5f;
+        }
+    };
+
+    float flat(float, float) { return 0.0f; }
+    float waves(float x, float y) { return 0.05f * sinf(x * 9.0f) * cosf(y * 7.0f); }
+
+    // Valid indices, no degenerate or flipped triangle, and the area of the square.
+    bool coversSquare(const Grid &grid, const std::vector<uint32_t> &indices) {
+        bool valid = true;
+        float area = 0.0f;
+        for(size_t i = 0; i < indices.size(); i += 3) {
+            for(int k = 0; k < 3; k++)
+                valid &= indices[i + k] < grid.vertices.size();
+            if(!valid)
+                return false;
+            float triangleArea = grid.area(indices[i], indices[i + 1], indices[i + 2]);
+            valid &= triangleArea > 0.0f;
+            area += triangleArea;
+        }
+        return valid && fabsf(area - 1.0f) < 1e-4f;
+    }
+}
+
+// Without an error limit the count gets down to the target, a collapse removing
+// at most a few triangles past it.
+MGP_TEST(reachesTargetCount) {
+    Grid grid(40, -1, waves);
+    size_t count = grid.indices.size();
+    for(size_t target : { count / 2, count / 4, count / 10, count / 50 }) {
+        target = target / 3 * 3;
+        float error = -1.0f;
+        std::vector<uint32_t> result = grid.simplify(target, FLT_MAX, &error);
+        MGP_CHECK(result.size() <= target && result.size() + 3 * 4 >= target);
+        MGP_CHECK(error >= 0.0f && error < 1.0f);
+        bool valid = true;
+        for(size_t i = 0; i < result.size(); i += 3) {
+            for(int k = 0; k < 3; k++)
+                valid &= result[i + k] < grid.vertices.size() && result[i + k] != result[i + (k + 1) % 3];
+        }
+        MGP_CHECK(valid);
+    }
+
+    // an error limit stops it first on curved surfaces, not on flat ones
+    float error = 0.0f;
+    std::vector<uint32_t> limited = grid.simplify(count / 50, 1e-3f, &error);
+    MGP_CHECK(limited.size() > count / 10 && error <= 1e-3f);
+    Grid flatGrid(40, -1, flat);
+    MGP_CHECK(flatGrid.simplify(count / 50, 1e-3f).size() <= count / 50);
+
+    // the source can be the destination
+    mgp_mesh_simplify_vertices_t vertices = grid.simplifyVertices();
+    std::vector<uint32_t> inPlace = grid.indices;
+    inPlace.resize(mgp_mesh_simplify(inPlace.data(), inPlace.data(), inPlace.size(), &vertices,
+                                     count / 4, FLT_MAX, NULL));
+    MGP_CHECK(inPlace == grid.simplify(count / 4, FLT_MAX));
+}
+
+// Borders only collapse along themselves : the square keeps its outline and
+// area however far the inside goes.
+MGP_TEST(bordersArePreserved) {
+    Grid grid(30, -1, flat);
+    for(size_t target : { grid.indices.size() / 4, grid.indices.size() / 20, (size_t)30 }) {
+        std::vector<uint32_t> result = grid.simplify(target, FLT_MAX);
+        MGP_CHECK(!result.empty());
+        MGP_CHECK(coversSquare(grid, result));
+
+        std::set<std::pair<float, float>> corners;
+        for(uint32_t index : result) {
+            const float *position = grid.vertices[index].position;
+            if((position[0] == 0.0f || position[0] == 1.0f) && (position[1] == 0.0f || position[1] == 1.0f))
+                corners.insert({ position[0], position[1] });
+        }
+        MGP_CHECK(corners.size() == 4);
+    }
+}
+
+// Both sides of a UV seam collapse together : no triangle mixes the charts and
+// both charts still meet at the same positions on the seam.
+MGP_TEST(uvSeamsArePreserved) {
+    Grid grid(30, 12, flat);
+    for(size_t target : { grid.indices.size() / 4, grid.indices.size() / 20 }) {
+        std::vector<uint32_t> result = grid.simplify(target, FLT_MAX);
+        MGP_CHECK(result.size() <= target);
+        MGP_CHECK(coversSquare(grid, result));
+
+        bool oneChart = true;
+        float leftArea = 0.0f;
+        std::set<float> leftSeam, rightSeam;
+        float seamX = grid.seamColumn / 30.0f;
+        for(size_t i = 0; i < result.size(); i += 3) {
+            bool left = grid.isLeft(result[i]);
+            oneChart &= grid.isLeft(result[i + 1]) == left && grid.isLeft(result[i + 2]) == left;
+            if(left)
+                leftArea += grid.area(result[i], result[i + 1], result[i + 2]);
+            for(int k = 0; k < 3; k++) {
+                const Vertex &vertex = grid.vertices[result[i + k]];
+                oneChart &= left ? vertex.position[0] <= seamX : vertex.position[0] >= seamX;
+                if(vertex.position[0] == seamX)
+                    (left ? leftSeam : rightSeam).insert(vertex.position[1]);
+            }
+        }
+        MGP_CHECK(oneChart);
+        MGP_CHECK(fabsf(leftArea - seamX) < 1e-4f);
+        MGP_CHECK(leftSeam == rightSeam && leftSeam.count(0.0f) == 1 && leftSeam.count(1.0f) == 1);
+    }
+}
+
+// Farther, smaller or at a lower resolution never picks a finer LOD.
+MGP_TEST(lodPickIsMonotonicInScreenSize) {
+    const float lodErrors[5] = { 0.0f, 0.004f, 0.01f, 0.05f, 0.2f };
+    mgp_mesh_lod_view_t perspective = { 0.0f, tanf(0.5f), 1080.0f * 0.5f / 1.0f };
+    mgp_mesh_lod_view_t orthographic = { 20.0f, 0.0f, 1080.0f * 0.5f / 1.0f };
+
+    bool monotonic = true;
+    std::set<uint32_t> picked;
+    for(float radius : { 0.1f, 1.0f, 10.0f }) {
+        uint32_t previous = 0;
+        for(float depth = -radius; depth < 10000.0f; depth += 0.01f + fabsf(depth) * 0.1f) {
+            uint32_t lod = mgp_mesh_select_lod(&perspective, lodErrors, 5, radius, depth);
+            monotonic &= lod >= previous;
+            previous = lod;
+            picked.insert(lod);
+        }
+        MGP_CHECK(previous == 4);
+        MGP_CHECK(mgp_mesh_select_lod(&perspective, lodErrors, 5, radius, 0.0f) == 0);
+    }
+    for(float depth : { 1.0f, 30.0f, 500.0f }) {
+        uint32_t previous = 4;
+        for(float radius = 0.001f; radius < 1000.0f; radius *= 1.2f) {
+            uint32_t lod = mgp_mesh_select_lod(&perspective, lodErrors, 5, radius, depth);
+            monotonic &= lod <= previous;
+            previous = lod;
+        }
+        previous = 0;
+        for(float pixelScale = 10.0f; pixelScale > 0.01f; pixelScale *= 0.8f) {
+            mgp_mesh_lod_view_t view = perspective;
+            view.pixelScale = pixelScale;
+            uint32_t lod = mgp_mesh_select_lod(&view, lodErrors, 5, 1.0f, depth);
+            monotonic &= lod >= previous;
+            previous = lod;
+        }
+    }
+    MGP_CHECK(monotonic);
+    MGP_CHECK(picked.size() == 5);
+
+    // orthographic views don't care for depth
+    for(float depth : { 0.0f, 10.0f, 1000.0f })
+        MGP_CHECK(mgp_mesh_select_lod(&orthographic, lodErrors, 5, 2.0f, depth) ==
+                  mgp_mesh_select_lod(&orthographic, lodErrors, 5, 2.0f, 0.0f));
+    MGP_CHECK(mgp_mesh_select_lod(&perspective, lodErrors, 1, 1.0f, 1000.0f) == 0);
+    MGP_CHECK(mgp_mesh_select_lod(&perspective, lodErrors, 5, 0.0f, 1.0f) == 4);
+}
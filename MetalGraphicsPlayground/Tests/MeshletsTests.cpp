@@ -0,0 +1,297 @@
+//
+//  MeshletsTests.cpp
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/18.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#include "MGPTest.h"
+#include "MGPMeshlets.h"
+#include "MGPMeshOptimizer.h"
+#include "MGPObjImporter.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <algorithm>
+#include <array>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace {
+    // same settings as MGPMesh
+    const float kConeWeight = 0.5f;
+    const size_t kMinTriangles = 1024;
+
+    struct Vector {
+        float x, y, z;
+    };
+
+    Vector operator-(Vector a, Vector b) { return { a.x - b.x, a.y - b.y, a.z - b.z }; }
+    Vector operator+(Vector a, Vector b) { return { a.x + b.x, a.y + b.y, a.z + b.z }; }
+    Vector operator*(Vector a, float s) { return { a.x * s, a.y * s, a.z * s }; }
+    float dot(Vector a, Vector b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+    Vector cross(Vector a, Vector b) { return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x }; }
+    Vector normalize(Vector a) { return a * (1.0f / sqrtf(dot(a, a))); }
+
+    Vector transform(const float *m, Vector p) {
+        return { m[0] * p.x + m[4] * p.y + m[8] * p.z + m[12],
+                 m[1] * p.x + m[5] * p.y + m[9] * p.z + m[13],
+                 m[2] * p.x + m[6] * p.y + m[10] * p.z + m[14] };
+    }
+
+    // A submesh of a bundled model, in the cache order and clustered as MGPMesh does.
+    struct Clusters {
+        std::vector<Vector> positions;
+        std::vector<uint32_t> original;
+        std::vector<uint32_t> indices;
+        std::vector<mgp_meshlet_t> meshlets;
+        float radius = 0.0f;            // around the origin
+        Vector center = { 0.0f, 0.0f, 0.0f };
+
+        Vector position(size_t corner) const {
+            return positions[indices[corner]];
+        }
+    };
+
+    std::vector<Clusters> loadClusters(const char *relativePath) {
+        std::vector<Clusters> result;
+        char error[256] = {};
+        mgp_obj_model_t *model = mgp_obj_load(mgp::test::assetPath(relativePath).c_str(), 1, error, sizeof(error));
+        MGP_CHECK(model != nullptr);
+        if(model == nullptr)
+            return result;
+        for(uint32_t o = 0; o < model->numObjects; o++) {
+            const mgp_obj_object_t &object = model->objects[o];
+            for(uint32_t s = object.submeshStart; s < object.submeshStart + object.submeshCount; s++) {
+                const mgp_obj_submesh_t &submesh = model->submeshes[s];
+                if(submesh.indexCount / 3 < kMinTriangles)
+                    continue;
+                Clusters clusters;
+                for(uint32_t v = 0; v < object.vertexCount; v++) {
+                    const float *p = model->vertices[object.vertexStart + v].position;
+                    clusters.positions.push_back({ p[0], p[1], p[2] });
+                }
+                const uint32_t *indices = model->indices + submesh.indexStart;
+                clusters.original.resize(submesh.indexCount);
+                mgp_mesh_optimize_vertex_cache(clusters.original.data(), indices, submesh.indexCount, object.vertexCount);
+                clusters.indices.resize(submesh.indexCount);
+                clusters.meshlets.resize(mgp_meshlets_bound(submesh.indexCount, MGP_MESHLET_MAX_VERTICES,
+                                                            MGP_MESHLET_MAX_TRIANGLES));
+                clusters.meshlets.resize(mgp_meshlets_build(clusters.meshlets.data(), clusters.indices.data(),
+                                                            clusters.original.data(), submesh.indexCount,
+                                                            &clusters.positions[0].x, object.vertexCount,
+                                                            sizeof(Vector), MGP_MESHLET_MAX_VERTICES,
+                                                            MGP_MESHLET_MAX_TRIANGLES, kConeWeight));
+                Vector lower = clusters.positions[0], upper = lower;
+                for(const Vector &p : clusters.positions) {
+                    lower = { std::min(lower.x, p.x), std::min(lower.y, p.y), std::min(lower.z, p.z) };
+                    upper = { std::max(upper.x, p.x), std::max(upper.y, p.y), std::max(upper.z, p.z) };
+                }
+                clusters.center = (lower + upper) * 0.5f;
+                clusters.radius = sqrtf(dot(upper - lower, upper - lower)) * 0.5f;
+                result.push_back(std::move(clusters));
+            }
+        }
+        mgp_obj_destroy(model);
+        return result;
+    }
+
+    // Perspective camera, planes facing inside.
+    struct Camera {
+        Vector position, forward;
+        mgp_cull_planes_t planes;
+        float eye[4];
+
+        Camera(Vector position, Vector target, float fov, float aspect, float near, float far)
+            : position(position), forward(normalize(target - position)) {
+            Vector right = normalize(cross(forward, { 0.0f, 1.0f, 0.0f }));
+            Vector up = cross(right, forward);
+            float height = tanf(fov * 0.5f), width = height * aspect;
+            Vector normals[6] = {
+                forward, forward * -1.0f,
+                normalize(right + forward * width), normalize(right * -1.0f + forward * width),
+                normalize(up + forward * height), normalize(up * -1.0f + forward * height)
+            };
+            float equations[6][4];
+            for(int i = 0; i < 6; i++) {
+                equations[i][0] = normals[i].x;
+                equations[i][1] = normals[i].y;
+                equations[i][2] = normals[i].z;
+                equations[i][3] = -dot(normals[i], position);
+            }
+            equations[0][3] -= near;
+            equations[1][3] += far;
+            mgp_cull_planes_make(&planes, equations, 6);
+            eye[0] = position.x;
+            eye[1] = position.y;
+            eye[2] = position.z;
+            eye[3] = 1.0f;
+        }
+
+        // orthographic cone test, along the view direction
+        void makeOrthographic() {
+            eye[0] = -forward.x;
+            eye[1] = -forward.y;
+            eye[2] = -forward.z;
+            eye[3] = 0.0f;
+        }
+    };
+
+    struct CullResult {
+        size_t visible = 0;
+        size_t drawnTriangles = 0;
+        size_t wronglyCulled = 0;
+    };
+
+    // Culls in the space of the model and checks every triangle left out in world space:
+    // it must face away from the eye or lie outside one plane.
+    CullResult cull(const Clusters &clusters, const Camera &camera, const float *modelMatrix) {
+        CullResult result;
+        mgp_meshlet_view_t view;
+        mgp_meshlet_view_make(&view, &camera.planes, camera.eye, modelMatrix);
+        std::vector<mgp_index_range_t> ranges(clusters.meshlets.size());
+        size_t rangeCount = mgp_meshlets_cull(ranges.data(), clusters.meshlets.data(), clusters.meshlets.size(),
+                                              &view, 1, &result.visible);
+        std::vector<bool> drawn(clusters.indices.size() / 3, false);
+        for(size_t r = 0; r < rangeCount; r++) {
+            for(uint32_t i = ranges[r].start; i < ranges[r].start + ranges[r].count; i += 3)
+                drawn[i / 3] = true;
+        }
+
+        float tolerance = 1e-4f * clusters.radius;
+        const mgp_cull_planes_t &planes = camera.planes;
+        for(size_t t = 0; t < drawn.size(); t++) {
+            if(drawn[t]) {
+                result.drawnTriangles++;
+                continue;
+            }
+            Vector corners[3];
+            for(int c = 0; c < 3; c++)
+                corners[c] = transform(modelMatrix, clusters.position(t * 3 + c));
+            Vector normal = cross(corners[1] - corners[0], corners[2] - corners[0]);
+            float normalLength = sqrtf(dot(normal, normal));
+            if(normalLength < 1e-12f)
+                continue;
+            Vector toEye = camera.eye[3] != 0.0f ? camera.position - corners[0]
+                                                 : Vector{ camera.eye[0], camera.eye[1], camera.eye[2] };
+            bool facingAway = dot(toEye, normal) <= tolerance * normalLength;
+            bool outside = false;
+            for(uint32_t p = 0; p < planes.count && !outside; p++) {
+                bool allOutside = true;
+                for(const Vector &corner : corners)
+                    allOutside &= planes.nx[p] * corner.x + planes.ny[p] * corner.y + planes.nz[p] * corner.z +
+                                  planes.d[p] < tolerance;
+                outside = allOutside;
+            }
+            result.wronglyCulled += !facingAway && !outside;
+        }
+        return result;
+    }
+
+    const float kIdentity[16] = { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
+}
+
+MGP_TEST(meshletsHoldEveryTriangleOnce) {
+    for(const char *path : { "MetalTextureLOD/teapot.obj", "MetalShadowMapping/lego.obj" }) {
+        std::vector<Clusters> submeshes = loadClusters(path);
+        MGP_CHECK(!submeshes.empty());
+        for(const Clusters &clusters : submeshes) {
+            // the same triangles, winding kept
+            std::multiset<std::array<uint32_t, 3>> before, after;
+            for(size_t i = 0; i < clusters.indices.size(); i += 3) {
+                const uint32_t *a = &clusters.original[i], *b = &clusters.indices[i];
+                int first = a[0] <= a[1] && a[0] <= a[2] ? 0 : (a[1] <= a[2] ? 1 : 2);
+                before.insert({ { a[first], a[(first + 1) % 3], a[(first + 2) % 3] } });
+                first = b[0] <= b[1] && b[0] <= b[2] ? 0 : (b[1] <= b[2] ? 1 : 2);
+                after.insert({ { b[first], b[(first + 1) % 3], b[(first + 2) % 3] } });
+            }
+            MGP_CHECK(before == after);
+
+            // contiguous ranges in the limits, spheres around their vertices
+            uint32_t offset = 0;
+            bool limits = true, contiguous = true, bounded = true;
+            for(const mgp_meshlet_t &meshlet : clusters.meshlets) {
+                contiguous &= meshlet.indexOffset == offset && meshlet.indexCount % 3 == 0 && meshlet.indexCount > 0;
+                offset += meshlet.indexCount;
+                std::set<uint32_t> vertices(clusters.indices.begin() + meshlet.indexOffset,
+                                            clusters.indices.begin() + meshlet.indexOffset + meshlet.indexCount);
+                limits &= vertices.size() <= MGP_MESHLET_MAX_VERTICES;
+                limits &= meshlet.indexCount <= MGP_MESHLET_MAX_TRIANGLES * 3;
+                Vector center = { meshlet.center[0], meshlet.center[1], meshlet.center[2] };
+                for(uint32_t v : vertices) {
+                    Vector d = clusters.positions[v] - center;
+                    bounded &= sqrtf(dot(d, d)) <= meshlet.radius * 1.0001f + 1e-6f;
+                }
+            }
+            MGP_CHECK(contiguous && offset == clusters.indices.size());
+            MGP_CHECK(limits);
+            MGP_CHECK(bounded);
+        }
+    }
+}
+
+// Random cameras around and inside the models, perspective and orthographic cones,
+// with skewed model matrices.
+MGP_TEST(cullingIsConservative) {
+    std::mt19937 random(1);
+    std::uniform_real_distribution<float> uniform(-1.0f, 1.0f);
+    for(const char *path : { "MetalTextureLOD/teapot.obj", "MetalShadowMapping/lego.obj" }) {
+        for(const Clusters &clusters : loadClusters(path)) {
+            size_t wronglyCulled = 0;
+            for(int i = 0; i < 100; i++) {
+                float model[16] = {};
+                for(int row = 0; row < 3; row++) {
+                    for(int column = 0; column < 3; column++)
+                        model[column * 4 + row] = (row == column ? 1.0f : 0.0f) + 0.3f * uniform(random);
+                    model[12 + row] = uniform(random);
+                }
+                model[15] = 1.0f;
+                float distance = clusters.radius * 3.0f;
+                Vector center = transform(model, clusters.center);
+                Vector position = center + Vector{ uniform(random), uniform(random), uniform(random) } * distance;
+                Vector target = center + Vector{ uniform(random), uniform(random), uniform(random) } * clusters.radius;
+                Camera camera(position, target, 1.0f, 1.5f, 0.01f, distance * 4.0f);
+                if(i % 2)
+                    camera.makeOrthographic();
+                wronglyCulled += cull(clusters, camera, model).wronglyCulled;
+            }
+            MGP_CHECK(wronglyCulled == 0);
+        }
+    }
+}
+
+// A fixed orbit around the teapot, moving in close enough that the frustum cuts it,
+// then back out. Prints how much culling leaves out.
+MGP_TEST(cameraPathRejectsMeshlets) {
+    std::vector<Clusters> submeshes = loadClusters("MetalTextureLOD/teapot.obj");
+    MGP_CHECK(!submeshes.empty());
+    if(submeshes.empty())
+        return;
+    const Clusters &clusters = submeshes[0];
+    const int numFrames = 240;
+    size_t total = 0, visible = 0, visibleByFrustum = 0, drawn = 0, wronglyCulled = 0;
+    for(int frame = 0; frame < numFrames; frame++) {
+        float s = frame / (float)(numFrames - 1);
+        float angle = s * 4.0f * (float)M_PI;
+        float distance = clusters.radius * (0.4f + 2.6f * fabsf(cosf(s * (float)M_PI)));
+        Vector position = clusters.center + Vector{ cosf(angle), 0.4f * sinf(angle * 1.5f), sinf(angle) } * distance;
+        Vector target = clusters.center + Vector{ 1.2f * sinf(angle), 0.3f * sinf(angle * 0.5f), 0.0f } * clusters.radius;
+        Camera camera(position, target, 60.0f * (float)M_PI / 180.0f, 16.0f / 9.0f, 0.01f, 100.0f * clusters.radius);
+        CullResult result = cull(clusters, camera, kIdentity);
+        total += clusters.meshlets.size();
+        visible += result.visible;
+        drawn += result.drawnTriangles;
+        wronglyCulled += result.wronglyCulled;
+
+        camera.eye[0] = camera.eye[1] = camera.eye[2] = camera.eye[3] = 0.0f;
+        visibleByFrustum += cull(clusters, camera, kIdentity).visible;
+    }
+    printf("teapot, %zu meshlets, %d frames : %.1f%% of meshlets rejected (%.1f%% by the frustum alone), "
+           "%.1f%% of triangles drawn\n", clusters.meshlets.size(), numFrames,
+           100.0 * (total - visible) / total, 100.0 * (total - visibleByFrustum) / total,
+           100.0 * drawn / (numFrames * (clusters.indices.size() / 3)));
+    MGP_CHECK(wronglyCulled == 0);
+    MGP_CHECK(visible < visibleByFrustum);
+}
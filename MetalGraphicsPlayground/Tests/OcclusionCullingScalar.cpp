@@ -0,0 +1,24 @@
+//
+//  OcclusionCullingScalar.cpp
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/18.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+// MGPOcclusionCulling.cpp once more with the scalar lanes and mgp_occlusion_scalar_*
+// names, so OcclusionCullingTests can run both paths on the same scene.
+
+#define MGP_OCCLUSION_SCALAR 1
+#define mgp_occlusion mgp_occlusion_scalar
+#define mgp_occlusion_create mgp_occlusion_scalar_create
+#define mgp_occlusion_destroy mgp_occlusion_scalar_destroy
+#define mgp_occlusion_set_triangle_budget mgp_occlusion_scalar_set_triangle_budget
+#define mgp_occlusion_begin mgp_occlusion_scalar_begin
+#define mgp_occlusion_add_occluder mgp_occlusion_scalar_add_occluder
+#define mgp_occlusion_rasterize mgp_occlusion_scalar_rasterize
+#define mgp_occlusion_cull_aabbs mgp_occlusion_scalar_cull_aabbs
+#define mgp_occlusion_aabb_is_visible mgp_occlusion_scalar_aabb_is_visible
+#define mgp_occlusion_read_depth mgp_occlusion_scalar_read_depth
+
+#include "MGPOcclusionCulling.cpp"
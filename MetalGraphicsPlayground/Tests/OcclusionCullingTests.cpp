@@ -0,0 +1,210 @@
+//
+//  OcclusionCullingTests.cpp
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/18.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#include "MGPTest.h"
+#include "MGPOcclusionCulling.h"
+
+#include <math.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+// the scalar lanes, from OcclusionCullingScalar.cpp
+extern "C" {
+typedef struct mgp_occlusion_scalar mgp_occlusion_scalar_t;
+mgp_occlusion_scalar_t *mgp_occlusion_scalar_create(uint32_t width, uint32_t height, uint32_t numThreads);
+void mgp_occlusion_scalar_destroy(mgp_occlusion_scalar_t *occlusion);
+void mgp_occlusion_scalar_begin(mgp_occlusion_scalar_t *occlusion, const float viewProjection[16]);
+int mgp_occlusion_scalar_add_occluder(mgp_occlusion_scalar_t *occlusion,
+                                      const float *vertices,
+                                      const uint32_t *indices, size_t numTriangles,
+                                      const float model[16]);
+void mgp_occlusion_scalar_rasterize(mgp_occlusion_scalar_t *occlusion);
+size_t mgp_occlusion_scalar_cull_aabbs(const mgp_occlusion_scalar_t *occlusion,
+                                       const mgp_aabb_array_t *aabbs,
+                                       uint64_t *visibility);
+void mgp_occlusion_scalar_read_depth(const mgp_occlusion_scalar_t *occlusion, float *depth,
+                                     uint32_t *width, uint32_t *height);
+}
+
+namespace {
+    const float kIdentity[16] = { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
+
+    // camera at the origin looking down +z, 0.1 ~ 1000
+    struct Projection {
+        float m[16];
+
+        Projection() {
+            float nearZ = 0.1f, farZ = 1000.0f, aspect = 16.0f / 9.0f;
+            float yScale = 1.0f / tanf(0.5f);
+            float zScale = farZ / (farZ - nearZ);
+            const float matrix[16] = {
+                yScale / aspect, 0, 0, 0,
+                0, yScale, 0, 0,
+                0, 0, zScale, 1,
+                0, 0, -nearZ * zScale, 0
+            };
+            std::copy(matrix, matrix + 16, m);
+        }
+    };
+
+    // 10x10 wall at z = 10
+    const float kWallVertices[] = { -5, -5, 10, 5, -5, 10, 5, 5, 10, -5, 5, 10 };
+    const uint32_t kWallIndices[] = { 0, 1, 2, 0, 2, 3 };
+
+    bool isVisible(const mgp_occlusion_t *occlusion, float x, float y, float z, float ex, float ey, float ez) {
+        const float center[3] = { x, y, z }, extent[3] = { ex, ey, ez };
+        return mgp_occlusion_aabb_is_visible(occlusion, center, extent) != 0;
+    }
+
+    mgp_occlusion_t *makeWall(uint32_t numThreads) {
+        mgp_occlusion_t *occlusion = mgp_occlusion_create(256, 128, numThreads);
+        mgp_occlusion_begin(occlusion, Projection().m);
+        mgp_occlusion_add_occluder(occlusion, kWallVertices, kWallIndices, 2, kIdentity);
+        mgp_occlusion_rasterize(occlusion);
+        return occlusion;
+    }
+
+    // unit cube, 12 triangles
+    struct Cube {
+        std::vector<float> vertices;
+        std::vector<uint32_t> indices;
+
+        Cube() {
+            for(int i = 0; i < 8; i++)
+                vertices.insert(vertices.end(), { i & 1 ? 1.0f : -1.0f, i & 2 ? 1.0f : -1.0f, i & 4 ? 1.0f : -1.0f });
+            const uint32_t faces[6][4] = { { 0, 1, 3, 2 }, { 4, 6, 7, 5 }, { 0, 4, 5, 1 },
+                                           { 2, 3, 7, 6 }, { 0, 2, 6, 4 }, { 1, 5, 7, 3 } };
+            for(const uint32_t *q : faces)
+                indices.insert(indices.end(), { q[0], q[1], q[2], q[0], q[2], q[3] });
+        }
+    };
+}
+
+MGP_TEST(boxBehindOccluderIsCulled) {
+    for(uint32_t numThreads : { 1u, 3u }) {
+        mgp_occlusion_t *occlusion = makeWall(numThreads);
+        MGP_CHECK(!isVisible(occlusion, 0, 0, 20, 1, 1, 1));
+        MGP_CHECK(!isVisible(occlusion, 3, 3, 30, 1, 1, 1));
+        // thin box just behind the wall
+        MGP_CHECK(!isVisible(occlusion, 0, 0, 10.5f, 4, 4, 0.4f));
+        mgp_occlusion_destroy(occlusion);
+    }
+}
+
+MGP_TEST(boxInFrontOrBesideOccluderIsKept) {
+    mgp_occlusion_t *occlusion = makeWall(1);
+    // in front
+    MGP_CHECK(isVisible(occlusion, 0, 0, 5, 1, 1, 1));
+    MGP_CHECK(isVisible(occlusion, 0, 0, 9, 0.5f, 0.5f, 0.5f));
+    // intersecting the wall
+    MGP_CHECK(isVisible(occlusion, 0, 0, 10, 1, 1, 1));
+    // beside, and sticking out past the edge
+    MGP_CHECK(isVisible(occlusion, 15, 0, 20, 1, 1, 1));
+    MGP_CHECK(isVisible(occlusion, 9, 0, 20, 2, 1, 1));
+    MGP_CHECK(isVisible(occlusion, 0, -9, 20, 1, 2, 1));
+    mgp_occlusion_destroy(occlusion);
+}
+
+MGP_TEST(boxCrossingNearPlaneIsKept) {
+    mgp_occlusion_t *occlusion = makeWall(1);
+    // mostly behind the wall, but reaching behind the camera
+    MGP_CHECK(isVisible(occlusion, 0, 0, 14.5f, 1, 1, 14.6f));
+    MGP_CHECK(isVisible(occlusion, 0, 0, 0.05f, 0.5f, 0.5f, 0.1f));
+    // behind the camera
+    MGP_CHECK(isVisible(occlusion, 0, 0, -5, 1, 1, 1));
+    mgp_occlusion_destroy(occlusion);
+}
+
+MGP_TEST(triangleBudgetStopsOccluders) {
+    mgp_occlusion_t *occlusion = mgp_occlusion_create(256, 128, 1);
+    mgp_occlusion_set_triangle_budget(occlusion, 3);
+    const float farther[16] = { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 20, 1 };
+
+    // the nearer wall doesn't fit after the farther one
+    mgp_occlusion_begin(occlusion, Projection().m);
+    MGP_CHECK(mgp_occlusion_add_occluder(occlusion, kWallVertices, kWallIndices, 2, farther) == 1);
+    MGP_CHECK(mgp_occlusion_add_occluder(occlusion, kWallVertices, kWallIndices, 2, kIdentity) == 0);
+    mgp_occlusion_rasterize(occlusion);
+    MGP_CHECK(isVisible(occlusion, 0, 0, 20, 1, 1, 1));
+    MGP_CHECK(!isVisible(occlusion, 0, 0, 40, 1, 1, 1));
+
+    // begin starts a new budget
+    mgp_occlusion_begin(occlusion, Projection().m);
+    MGP_CHECK(mgp_occlusion_add_occluder(occlusion, kWallVertices, kWallIndices, 2, kIdentity) == 1);
+    MGP_CHECK(mgp_occlusion_add_occluder(occlusion, kWallVertices, kWallIndices, 1, farther) == 1);
+    MGP_CHECK(mgp_occlusion_add_occluder(occlusion, kWallVertices, kWallIndices, 1, farther) == 0);
+    mgp_occlusion_rasterize(occlusion);
+    MGP_CHECK(!isVisible(occlusion, 0, 0, 20, 1, 1, 1));
+    mgp_occlusion_destroy(occlusion);
+}
+
+// Random cubes as occluders and 10000 boxes to test, on odd-sized buffers:
+// the SIMD build, on one and three threads, gives the same depth and
+// visibility as the scalar lanes.
+MGP_TEST(simdMatchesScalar) {
+    const uint32_t width = 203, height = 117;
+    mgp_occlusion_t *simd = mgp_occlusion_create(width, height, 1);
+    mgp_occlusion_t *simdThreaded = mgp_occlusion_create(width, height, 3);
+    mgp_occlusion_scalar_t *scalar = mgp_occlusion_scalar_create(width, height, 1);
+    Projection projection;
+    mgp_occlusion_begin(simd, projection.m);
+    mgp_occlusion_begin(simdThreaded, projection.m);
+    mgp_occlusion_scalar_begin(scalar, projection.m);
+
+    Cube cube;
+    std::mt19937 random(5);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    for(int i = 0; i < 300; i++) {
+        float scale = 0.5f + (unit(random) + 1.0f) * 1.5f;
+        const float model[16] = { scale, 0, 0, 0, 0, scale, 0, 0, 0, 0, scale, 0,
+                                  unit(random) * 40.0f, unit(random) * 20.0f, 12.0f + unit(random) * 10.0f, 1 };
+        size_t numTriangles = cube.indices.size() / 3;
+        mgp_occlusion_add_occluder(simd, cube.vertices.data(), cube.indices.data(), numTriangles, model);
+        mgp_occlusion_add_occluder(simdThreaded, cube.vertices.data(), cube.indices.data(), numTriangles, model);
+        mgp_occlusion_scalar_add_occluder(scalar, cube.vertices.data(), cube.indices.data(), numTriangles, model);
+    }
+    mgp_occlusion_rasterize(simd);
+    mgp_occlusion_rasterize(simdThreaded);
+    mgp_occlusion_scalar_rasterize(scalar);
+
+    uint32_t depthWidth = 0, depthHeight = 0;
+    mgp_occlusion_read_depth(simd, nullptr, &depthWidth, &depthHeight);
+    MGP_CHECK(depthWidth == 208 && depthHeight == 120);
+    std::vector<float> simdDepth(depthWidth * depthHeight), threadedDepth(simdDepth.size()), scalarDepth(simdDepth.size());
+    mgp_occlusion_read_depth(simd, simdDepth.data(), nullptr, nullptr);
+    mgp_occlusion_read_depth(simdThreaded, threadedDepth.data(), nullptr, nullptr);
+    mgp_occlusion_scalar_read_depth(scalar, scalarDepth.data(), nullptr, nullptr);
+    MGP_CHECK(simdDepth == scalarDepth);
+    MGP_CHECK(threadedDepth == scalarDepth);
+    size_t covered = 0;
+    for(float z : simdDepth)
+        covered += z < 1.0f;
+    MGP_CHECK(covered > simdDepth.size() / 4);
+
+    const size_t numBoxes = 10000;
+    mgp_aabb_array_t boxes = {};
+    mgp_aabb_array_resize(&boxes, numBoxes);
+    for(size_t i = 0; i < numBoxes; i++) {
+        const float center[3] = { unit(random) * 60.0f, unit(random) * 30.0f, 30.0f + unit(random) * 28.0f };
+        const float extent[3] = { 0.5f, 0.5f, 0.5f };
+        mgp_aabb_array_set(&boxes, i, center, extent);
+    }
+    std::vector<uint64_t> simdVisibility(MGP_CULL_BITSET_WORDS(numBoxes), ~0ull);
+    simdVisibility.back() = (1ull << (numBoxes % 64)) - 1;
+    std::vector<uint64_t> scalarVisibility = simdVisibility;
+    size_t numVisible = mgp_occlusion_cull_aabbs(simd, &boxes, simdVisibility.data());
+    MGP_CHECK(numVisible == mgp_occlusion_scalar_cull_aabbs(scalar, &boxes, scalarVisibility.data()));
+    MGP_CHECK(simdVisibility == scalarVisibility);
+    MGP_CHECK(numVisible > 0 && numVisible < numBoxes);
+
+    mgp_aabb_array_free(&boxes);
+    mgp_occlusion_scalar_destroy(scalar);
+    mgp_occlusion_destroy(simdThreaded);
+    mgp_occlusion_destroy(simd);
+}
@@ -0,0 +1,288 @@
+//
+//  RenderGraphTests.cpp
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/18.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#include "MGPTest.h"
+#include "MGPRenderGraph.h"
+
+#include <vector>
+
+namespace {
+    // camera passes of MGPDeferredRenderer
+    enum Pass {
+        Skybox, Prepass, SSAO, LightCull, Shade, DirectionalShadowed, Indirect, SSR, Present, NumPasses
+    };
+
+    // what present shows, as MGPDeferredRenderer's gBufferIndex
+    enum Output {
+        OutputLit = 0, OutputAlbedo = 1, OutputNormal = 2, OutputShading = 4, OutputSSAO = 5, OutputLightCull = 6
+    };
+
+    struct CameraSetup {
+        bool ibl = true;
+        bool ssao = true;
+        bool ssr = true;
+        bool shadowedLight = true;
+        Output output = OutputLit;
+    };
+
+    typedef std::vector<std::vector<Pass>> Encoders;
+
+    // Same graph as -[MGPDeferredRenderer _buildCameraRenderGraph].
+    class CameraGraph {
+    public:
+        CameraGraph() : _graph(mgp_render_graph_create()) {}
+        ~CameraGraph() { mgp_render_graph_destroy(_graph); }
+
+        void build(const CameraSetup &setup) {
+            mgp_render_graph_reset(_graph);
+            for(uint32_t &pass : _passes)
+                pass = MGP_RENDER_GRAPH_NONE;
+
+            uint32_t drawable = mgp_render_graph_add_resource(_graph, MGP_RENDER_GRAPH_RESOURCE_IMPORTED);
+            uint32_t depth = mgp_render_graph_add_resource(_graph, 0);
+            uint32_t albedo = mgp_render_graph_add_resource(_graph, 0);
+            uint32_t normal = mgp_render_graph_add_resource(_graph, 0);
+            uint32_t shading = mgp_render_graph_add_resource(_graph, 0);
+            uint32_t lightCull = mgp_render_graph_add_resource(_graph, 0);
+            uint32_t ssao = mgp_render_graph_add_resource(_graph, 0);
+            uint32_t output = mgp_render_graph_add_resource(_graph, 0);
+            const uint32_t gBuffer[] = { albedo, normal, shading, depth };
+
+            uint32_t pass;
+            if(setup.ibl) {
+                pass = addPass(Skybox, MGP_RENDER_GRAPH_PASS_RENDER);
+                mgp_render_graph_pass_attach(_graph, pass, drawable, 0);
+                mgp_render_graph_pass_attach(_graph, pass, depth, 0);
+            }
+
+            pass = addPass(Prepass, MGP_RENDER_GRAPH_PASS_RENDER);
+            for(uint32_t resource : gBuffer)
+                mgp_render_graph_pass_attach(_graph, pass, resource, 0);
+
+            if(setup.ssao) {
+                pass = addPass(SSAO, MGP_RENDER_GRAPH_PASS_EXTERNAL);
+                mgp_render_graph_pass_read(_graph, pass, depth);
+                mgp_render_graph_pass_read(_graph, pass, normal);
+                mgp_render_graph_pass_write(_graph, pass, ssao);
+            }
+
+            pass = addPass(LightCull, MGP_RENDER_GRAPH_PASS_COMPUTE);
+            mgp_render_graph_pass_read(_graph, pass, depth);
+            mgp_render_graph_pass_write(_graph, pass, lightCull);
+
+            pass = addPass(Shade, MGP_RENDER_GRAPH_PASS_RENDER);
+            mgp_render_graph_pass_attach(_graph, pass, output, 0);
+            for(uint32_t resource : gBuffer)
+                mgp_render_graph_pass_read(_graph, pass, resource);
+            mgp_render_graph_pass_read(_graph, pass, lightCull);
+
+            if(setup.shadowedLight) {
+                pass = addPass(DirectionalShadowed, MGP_RENDER_GRAPH_PASS_RENDER);
+                mgp_render_graph_pass_attach(_graph, pass, output, 1);
+                for(uint32_t resource : gBuffer)
+                    mgp_render_graph_pass_read(_graph, pass, resource);
+            }
+
+            pass = addPass(Indirect, MGP_RENDER_GRAPH_PASS_RENDER);
+            mgp_render_graph_pass_attach(_graph, pass, output, 1);
+            for(uint32_t resource : gBuffer)
+                mgp_render_graph_pass_read(_graph, pass, resource);
+            if(setup.ssao)
+                mgp_render_graph_pass_read(_graph, pass, ssao);
+
+            if(setup.ssr) {
+                pass = addPass(SSR, MGP_RENDER_GRAPH_PASS_EXTERNAL);
+                mgp_render_graph_pass_read(_graph, pass, normal);
+                mgp_render_graph_pass_read(_graph, pass, depth);
+                mgp_render_graph_pass_read(_graph, pass, shading);
+                mgp_render_graph_pass_read(_graph, pass, output);
+                mgp_render_graph_pass_write(_graph, pass, output);
+            }
+
+            pass = addPass(Present, MGP_RENDER_GRAPH_PASS_RENDER);
+            mgp_render_graph_pass_attach(_graph, pass, drawable, setup.ibl);
+            switch(setup.output) {
+                case OutputAlbedo: mgp_render_graph_pass_read(_graph, pass, albedo); break;
+                case OutputNormal: mgp_render_graph_pass_read(_graph, pass, normal); break;
+                case OutputShading: mgp_render_graph_pass_read(_graph, pass, shading); break;
+                case OutputSSAO: mgp_render_graph_pass_read(_graph, pass, setup.ssao ? ssao : output); break;
+                case OutputLightCull: mgp_render_graph_pass_read(_graph, pass, lightCull); break;
+                default: mgp_render_graph_pass_read(_graph, pass, output); break;
+            }
+        }
+
+        // Compiles the graph, steps grouped by encoder.
+        Encoders compile() {
+            size_t numSteps = mgp_render_graph_compile(_graph);
+            const mgp_render_graph_step_t *steps = mgp_render_graph_steps(_graph);
+            Encoders encoders;
+            for(size_t i = 0; i < numSteps; i++) {
+                if(i == 0 || steps[i].encoder != steps[i - 1].encoder)
+                    encoders.emplace_back();
+                encoders.back().push_back(passOfIndex(steps[i].pass));
+            }
+            return encoders;
+        }
+
+        bool isCulled(Pass pass) const {
+            return mgp_render_graph_is_pass_culled(_graph, _passes[pass]) != 0;
+        }
+
+    private:
+        mgp_render_graph_t *_graph;
+        uint32_t _passes[NumPasses];
+
+        uint32_t addPass(Pass pass, mgp_render_graph_pass_type_t type) {
+            _passes[pass] = mgp_render_graph_add_pass(_graph, type, 0);
+            return _passes[pass];
+        }
+
+        Pass passOfIndex(uint32_t index) const {
+            for(int pass = 0; pass < NumPasses; pass++) {
+                if(_passes[pass] == index)
+                    return (Pass)pass;
+            }
+            return NumPasses;
+        }
+    };
+}
+
+MGP_TEST(fullSetupMergesLightingIntoOneEncoder) {
+    CameraGraph graph;
+    graph.build(CameraSetup());
+    Encoders expected = {
+        { Skybox }, { Prepass }, { SSAO }, { LightCull }, { Shade, DirectionalShadowed, Indirect }, { SSR }, { Present }
+    };
+    MGP_CHECK(graph.compile() == expected);
+}
+
+MGP_TEST(fullSetupWithoutSkyboxOrShadows) {
+    CameraGraph graph;
+    CameraSetup setup;
+    setup.ibl = false;
+    setup.shadowedLight = false;
+    graph.build(setup);
+    Encoders expected = {
+        { Prepass }, { SSAO }, { LightCull }, { Shade, Indirect }, { SSR }, { Present }
+    };
+    MGP_CHECK(graph.compile() == expected);
+}
+
+MGP_TEST(albedoOutputCullsEverythingButPrepass) {
+    CameraGraph graph;
+    CameraSetup setup;
+    setup.output = OutputAlbedo;
+    graph.build(setup);
+    Encoders expected = { { Skybox }, { Prepass }, { Present } };
+    MGP_CHECK(graph.compile() == expected);
+    for(Pass pass : { SSAO, LightCull, Shade, DirectionalShadowed, Indirect, SSR })
+        MGP_CHECK(graph.isCulled(pass));
+    MGP_CHECK(!graph.isCulled(Prepass));
+}
+
+MGP_TEST(ssaoOutputCullsLighting) {
+    CameraGraph graph;
+    CameraSetup setup;
+    setup.ibl = false;
+    setup.output = OutputSSAO;
+    graph.build(setup);
+    Encoders expected = { { Prepass }, { SSAO }, { Present } };
+    MGP_CHECK(graph.compile() == expected);
+    for(Pass pass : { LightCull, Shade, DirectionalShadowed, Indirect, SSR })
+        MGP_CHECK(graph.isCulled(pass));
+}
+
+MGP_TEST(ssaoOutputWithoutSSAOShowsLighting) {
+    CameraGraph graph;
+    CameraSetup setup;
+    setup.ibl = false;
+    setup.ssao = false;
+    setup.ssr = false;
+    setup.output = OutputSSAO;
+    graph.build(setup);
+    Encoders expected = { { Prepass }, { LightCull }, { Shade, DirectionalShadowed, Indirect }, { Present } };
+    MGP_CHECK(graph.compile() == expected);
+}
+
+MGP_TEST(lightCullOutputCullsLightingAndSSAO) {
+    CameraGraph graph;
+    CameraSetup setup;
+    setup.ibl = false;
+    setup.output = OutputLightCull;
+    graph.build(setup);
+    Encoders expected = { { Prepass }, { LightCull }, { Present } };
+    MGP_CHECK(graph.compile() == expected);
+    for(Pass pass : { SSAO, Shade, DirectionalShadowed, Indirect, SSR })
+        MGP_CHECK(graph.isCulled(pass));
+}
+
+MGP_TEST(resetKeepsNothingOfThePreviousGraph) {
+    CameraGraph graph;
+    CameraSetup setup;
+    setup.output = OutputAlbedo;
+    graph.build(setup);
+    graph.compile();
+    graph.build(CameraSetup());
+    MGP_CHECK(graph.compile().size() == 7);
+}
+
+// A render pass loading the attachments of the current encoder goes before an
+// unrelated compute pass declared between them.
+MGP_TEST(independentPassDoesNotSplitMergeableRenderPasses) {
+    mgp_render_graph_t *graph = mgp_render_graph_create();
+    uint32_t target = mgp_render_graph_add_resource(graph, MGP_RENDER_GRAPH_RESOURCE_IMPORTED);
+    uint32_t buffer = mgp_render_graph_add_resource(graph, 0);
+    uint32_t clear = mgp_render_graph_add_pass(graph, MGP_RENDER_GRAPH_PASS_RENDER, 0);
+    mgp_render_graph_pass_attach(graph, clear, target, 0);
+    uint32_t compute = mgp_render_graph_add_pass(graph, MGP_RENDER_GRAPH_PASS_COMPUTE, 0);
+    mgp_render_graph_pass_write(graph, compute, buffer);
+    uint32_t draw = mgp_render_graph_add_pass(graph, MGP_RENDER_GRAPH_PASS_RENDER, 0);
+    mgp_render_graph_pass_attach(graph, draw, target, 1);
+    uint32_t consume = mgp_render_graph_add_pass(graph, MGP_RENDER_GRAPH_PASS_RENDER, 0);
+    mgp_render_graph_pass_attach(graph, consume, target, 1);
+    mgp_render_graph_pass_read(graph, consume, buffer);
+
+    MGP_CHECK(mgp_render_graph_compile(graph) == 4);
+    const mgp_render_graph_step_t *steps = mgp_render_graph_steps(graph);
+    MGP_CHECK(steps[0].pass == clear && steps[1].pass == draw);
+    MGP_CHECK(steps[0].encoder == steps[1].encoder);
+    MGP_CHECK(steps[2].pass == compute && steps[2].encoder != steps[1].encoder);
+    // consume waits for the compute pass, so it can't join the first encoder
+    MGP_CHECK(steps[3].pass == consume && steps[3].encoder != steps[1].encoder);
+    mgp_render_graph_destroy(graph);
+}
+
+MGP_TEST(passSamplingAnAttachmentIsNotMerged) {
+    mgp_render_graph_t *graph = mgp_render_graph_create();
+    uint32_t target = mgp_render_graph_add_resource(graph, MGP_RENDER_GRAPH_RESOURCE_IMPORTED);
+    uint32_t first = mgp_render_graph_add_pass(graph, MGP_RENDER_GRAPH_PASS_RENDER, 0);
+    mgp_render_graph_pass_attach(graph, first, target, 0);
+    uint32_t second = mgp_render_graph_add_pass(graph, MGP_RENDER_GRAPH_PASS_RENDER, 0);
+    mgp_render_graph_pass_attach(graph, second, target, 1);
+    mgp_render_graph_pass_read(graph, second, target);
+
+    MGP_CHECK(mgp_render_graph_compile(graph) == 2);
+    const mgp_render_graph_step_t *steps = mgp_render_graph_steps(graph);
+    MGP_CHECK(steps[0].encoder != steps[1].encoder);
+    mgp_render_graph_destroy(graph);
+}
+
+MGP_TEST(sideEffectPassIsNeverCulled) {
+    mgp_render_graph_t *graph = mgp_render_graph_create();
+    uint32_t scratch = mgp_render_graph_add_resource(graph, 0);
+    uint32_t unused = mgp_render_graph_add_pass(graph, MGP_RENDER_GRAPH_PASS_COMPUTE, 0);
+    mgp_render_graph_pass_write(graph, unused, scratch);
+    uint32_t external = mgp_render_graph_add_pass(graph, MGP_RENDER_GRAPH_PASS_EXTERNAL, MGP_RENDER_GRAPH_PASS_SIDE_EFFECT);
+    mgp_render_graph_pass_write(graph, external, scratch);
+
+    MGP_CHECK(mgp_render_graph_compile(graph) == 1);
+    MGP_CHECK(mgp_render_graph_steps(graph)[0].pass == external);
+    MGP_CHECK(mgp_render_graph_is_pass_culled(graph, unused));
+    MGP_CHECK(!mgp_render_graph_is_pass_culled(graph, external));
+    mgp_render_graph_destroy(graph);
+}
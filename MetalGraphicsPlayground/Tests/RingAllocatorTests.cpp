@@ -0,0 +1,257 @@
+//
+//  RingAllocatorTests.cpp
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/18.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#include "MGPTest.h"
+#include "MGPRingAllocator.h"
+
+#include <stdlib.h>
+#include <algorithm>
+#include <map>
+#include <random>
+#include <vector>
+
+namespace {
+    // Buffers in host memory, counting what the allocator makes and releases.
+    struct MockBackend {
+        struct Buffer {
+            size_t size;
+            void *memory;
+        };
+
+        std::map<void *, Buffer> live;
+        std::vector<size_t> createdSizes;
+        std::map<void *, uint64_t> destroyedAtFrame;
+        uint64_t frame = 0;             // the test's frame counter, for when buffers go
+        size_t numCreated = 0, numDestroyed = 0;
+        bool failCreation = false;
+        std::vector<void *> released;   // freed at the end, so no address comes back as a new buffer
+
+        ~MockBackend() {
+            for(void *memory : released)
+                free(memory);
+        }
+
+        static void *createBuffer(void *context, size_t size, void **contents) {
+            MockBackend *backend = (MockBackend *)context;
+            if(backend->failCreation)
+                return NULL;
+            void *memory = aligned_alloc(256, size);
+            backend->live[memory] = { size, memory };
+            backend->createdSizes.push_back(size);
+            backend->numCreated++;
+            *contents = memory;
+            return memory;
+        }
+
+        static void destroyBuffer(void *context, void *buffer) {
+            MockBackend *backend = (MockBackend *)context;
+            MGP_CHECK(backend->live.count(buffer) == 1);
+            backend->live.erase(buffer);
+            backend->destroyedAtFrame[buffer] = backend->frame;
+            backend->numDestroyed++;
+            backend->released.push_back(buffer);
+        }
+
+        mgp_ring_backend_t backend() {
+            return { createBuffer, destroyBuffer, this };
+        }
+    };
+
+    struct Allocation {
+        void *buffer;
+        size_t offset, size;
+    };
+
+    bool overlaps(const Allocation &a, const Allocation &b) {
+        return a.buffer == b.buffer && a.offset < b.offset + b.size && b.offset < a.offset + a.size;
+    }
+}
+
+// Random frames, some much larger than the ring: allocations of the current frame
+// never overlap each other or the numFramesInFlight - 1 frames before it.
+MGP_TEST(allocationsNeverOverlapFramesInFlight) {
+    for(uint32_t numFramesInFlight : { 1u, 2u, 3u }) {
+        MockBackend mock;
+        mgp_ring_backend_t backend = mock.backend();
+        mgp_ring_allocator_t *allocator = mgp_ring_allocator_create(&backend, 4096, numFramesInFlight);
+        MGP_CHECK(allocator != NULL);
+        if(allocator == NULL)
+            continue;
+
+        std::mt19937 random(numFramesInFlight);
+        std::vector<std::vector<Allocation>> frames;
+        bool overlap = false, aligned = true, inside = true;
+        for(int f = 0; f < 2000; f++) {
+            mock.frame++;
+            mgp_ring_allocator_begin_frame(allocator);
+            frames.emplace_back();
+            size_t numAllocations = random() % 40;
+            if(f % 500 == 250)
+                numAllocations = 400;
+            for(size_t a = 0; a < numAllocations; a++) {
+                size_t size = 1 + random() % 2048;
+                size_t alignment = (size_t)1 << (random() % 9);
+                mgp_ring_allocation_t allocation;
+                MGP_CHECK(mgp_ring_allocator_allocate(allocator, size, alignment, &allocation));
+                Allocation current = { allocation.buffer, allocation.offset, size };
+                aligned &= allocation.offset % alignment == 0;
+                aligned &= (uintptr_t)allocation.contents % alignment == 0;
+                const MockBackend::Buffer &buffer = mock.live[allocation.buffer];
+                inside &= allocation.offset + size <= buffer.size &&
+                          (uint8_t *)allocation.contents == (uint8_t *)buffer.memory + allocation.offset;
+
+                size_t firstFrame = frames.size() > numFramesInFlight ? frames.size() - numFramesInFlight : 0;
+                for(size_t g = firstFrame; g < frames.size(); g++) {
+                    for(const Allocation &other : frames[g])
+                        overlap |= overlaps(current, other);
+                }
+                frames.back().push_back(current);
+            }
+        }
+        MGP_CHECK(!overlap);
+        MGP_CHECK(aligned);
+        MGP_CHECK(inside);
+        mgp_ring_allocator_destroy(allocator);
+    }
+}
+
+// Each buffer is at least twice the one before, and numGrowths counts them.
+MGP_TEST(capacityGrowsGeometrically) {
+    MockBackend mock;
+    mgp_ring_backend_t backend = mock.backend();
+    mgp_ring_allocator_t *allocator = mgp_ring_allocator_create(&backend, 1000, 2);
+    mgp_ring_stats_t stats;
+    mgp_ring_allocator_get_stats(allocator, &stats);
+    MGP_CHECK(stats.capacity == 1024);
+    MGP_CHECK(stats.numGrowths == 0);
+
+    // frames of 1, 2, 4 ... 64 KB
+    for(size_t frameSize = 1024; frameSize <= 65536; frameSize *= 2) {
+        mock.frame++;
+        mgp_ring_allocator_begin_frame(allocator);
+        mgp_ring_allocation_t allocation;
+        for(size_t used = 0; used < frameSize; used += 256)
+            MGP_CHECK(mgp_ring_allocator_allocate(allocator, 256, 256, &allocation));
+    }
+    mgp_ring_allocator_get_stats(allocator, &stats);
+    MGP_CHECK(stats.numGrowths == mock.numCreated - 1);
+    MGP_CHECK(stats.numGrowths > 0);
+    bool geometric = true;
+    for(size_t i = 1; i < mock.createdSizes.size(); i++)
+        geometric &= mock.createdSizes[i] >= mock.createdSizes[i - 1] * 2 && mock.createdSizes[i] % 256 == 0;
+    MGP_CHECK(geometric);
+    MGP_CHECK(stats.capacity == mock.createdSizes.back());
+
+    // steady frames settle once two of them fit, then make no new buffers
+    size_t numCreated = mock.numCreated;
+    for(int f = 0; f < 100; f++) {
+        if(f == 10)
+            numCreated = mock.numCreated;
+        mock.frame++;
+        mgp_ring_allocator_begin_frame(allocator);
+        mgp_ring_allocation_t allocation;
+        for(size_t used = 0; used < 65536; used += 256)
+            MGP_CHECK(mgp_ring_allocator_allocate(allocator, 256, 256, &allocation));
+    }
+    MGP_CHECK(mock.numCreated == numCreated);
+    mgp_ring_allocator_destroy(allocator);
+}
+
+// A buffer replaced during frame F stays alive until frame F + numFramesInFlight begins.
+MGP_TEST(retiredBuffersLiveUntilTheirFramesRetire) {
+    for(uint32_t numFramesInFlight : { 1u, 2u, 3u }) {
+        MockBackend mock;
+        mgp_ring_backend_t backend = mock.backend();
+        mgp_ring_allocator_t *allocator = mgp_ring_allocator_create(&backend, 1024, numFramesInFlight);
+        std::map<void *, uint64_t> replacedAtFrame;
+        void *current = NULL;
+        for(int f = 0; f < 40; f++) {
+            mock.frame++;
+            mgp_ring_allocator_begin_frame(allocator);
+            // grows on frames 5, 10, 15 ...
+            size_t frameSize = f % 5 == 0 ? (size_t)1024 << (f / 5) : 512;
+            mgp_ring_allocation_t allocation;
+            for(size_t used = 0; used < frameSize; used += 512) {
+                MGP_CHECK(mgp_ring_allocator_allocate(allocator, 512, 256, &allocation));
+                if(current != NULL && allocation.buffer != current)
+                    replacedAtFrame[current] = mock.frame;
+                current = allocation.buffer;
+            }
+        }
+        MGP_CHECK(replacedAtFrame.size() >= 6);
+        bool onTime = true;
+        for(const auto &replaced : replacedAtFrame) {
+            auto destroyed = mock.destroyedAtFrame.find(replaced.first);
+            onTime &= destroyed != mock.destroyedAtFrame.end() &&
+                      destroyed->second == replaced.second + numFramesInFlight;
+        }
+        MGP_CHECK(onTime);
+        mgp_ring_allocator_destroy(allocator);
+    }
+}
+
+MGP_TEST(highWaterMarkIsTheLargestFrame) {
+    MockBackend mock;
+    mgp_ring_backend_t backend = mock.backend();
+    mgp_ring_allocator_t *allocator = mgp_ring_allocator_create(&backend, 1 << 20, 3);
+    const size_t frameSizes[] = { 4096, 65536, 1024, 8192 };
+    size_t largest = 0;
+    mgp_ring_stats_t stats;
+    for(size_t frameSize : frameSizes) {
+        mock.frame++;
+        mgp_ring_allocator_begin_frame(allocator);
+        mgp_ring_allocation_t allocation;
+        for(size_t used = 0; used < frameSize; used += 256)
+            mgp_ring_allocator_allocate(allocator, 256, 256, &allocation);
+        mgp_ring_allocator_get_stats(allocator, &stats);
+        MGP_CHECK(stats.frameBytes >= frameSize);
+        largest = std::max(largest, stats.frameBytes);
+    }
+    MGP_CHECK(stats.highWaterMark == largest);
+    MGP_CHECK(stats.highWaterMark >= 65536 && stats.highWaterMark < 65536 + 256);
+    mgp_ring_allocator_destroy(allocator);
+}
+
+MGP_TEST(destroyReleasesEveryBuffer) {
+    MockBackend mock;
+    mgp_ring_backend_t backend = mock.backend();
+    mgp_ring_allocator_t *allocator = mgp_ring_allocator_create(&backend, 256, 3);
+    // grow on the last frames so buffers are still waiting for retirement
+    for(int f = 0; f < 3; f++) {
+        mock.frame++;
+        mgp_ring_allocator_begin_frame(allocator);
+        mgp_ring_allocation_t allocation;
+        for(int a = 0; a < 8 << f; a++)
+            MGP_CHECK(mgp_ring_allocator_allocate(allocator, 200, 16, &allocation));
+    }
+    mgp_ring_stats_t stats;
+    mgp_ring_allocator_get_stats(allocator, &stats);
+    MGP_CHECK(stats.numBuffers > 1);
+    MGP_CHECK(stats.numBuffers == mock.live.size());
+    mgp_ring_allocator_destroy(allocator);
+    MGP_CHECK(mock.live.empty());
+    MGP_CHECK(mock.numCreated == mock.numDestroyed);
+}
+
+MGP_TEST(failedBackendFailsTheAllocation) {
+    MockBackend mock;
+    mgp_ring_backend_t backend = mock.backend();
+    mgp_ring_allocator_t *allocator = mgp_ring_allocator_create(&backend, 1024, 2);
+    mgp_ring_allocator_begin_frame(allocator);
+    mgp_ring_allocation_t allocation;
+    mock.failCreation = true;
+    MGP_CHECK(mgp_ring_allocator_allocate(allocator, 512, 256, &allocation));
+    MGP_CHECK(!mgp_ring_allocator_allocate(allocator, 4096, 256, &allocation));
+    mock.failCreation = false;
+    MGP_CHECK(mgp_ring_allocator_allocate(allocator, 4096, 256, &allocation));
+    mgp_ring_allocator_destroy(allocator);
+    MGP_CHECK(mock.live.empty());
+
+    mock.failCreation = true;
+    MGP_CHECK(mgp_ring_allocator_create(&backend, 1024, 2) == NULL);
+}
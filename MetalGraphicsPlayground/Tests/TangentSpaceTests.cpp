@@ -0,0 +1,227 @@
+//
+//  TangentSpaceTests.cpp
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/18.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#include "MGPTest.h"
+#include "MGPTangentSpace.h"
+#include "MGPObjImporter.h"
+
+#include <math.h>
+#include <stddef.h>
+#include <string.h>
+#include <vector>
+
+namespace {
+    struct Vertex {
+        float position[3];
+        float uv[2];
+        float normal[3];
+        float tangent[4];
+    };
+
+    struct Vector {
+        float x, y, z;
+    };
+
+    Vector operator*(Vector a, float s) { return { a.x * s, a.y * s, a.z * s }; }
+    float dot(Vector a, Vector b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+    Vector cross(Vector a, Vector b) { return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x }; }
+    Vector normalize(Vector a) { return a * (1.0f / sqrtf(dot(a, a))); }
+    Vector vector(const float *v) { return { v[0], v[1], v[2] }; }
+
+    // without normal and tangent
+    Vertex makeVertex(float x, float y, float z, float u, float v) {
+        Vertex vertex = {};
+        vertex.position[0] = x;
+        vertex.position[1] = y;
+        vertex.position[2] = z;
+        vertex.uv[0] = u;
+        vertex.uv[1] = v;
+        return vertex;
+    }
+
+    const mgp_tangent_space_layout_t kLayout = {
+        sizeof(Vertex), offsetof(Vertex, position), offsetof(Vertex, uv),
+        offsetof(Vertex, normal), offsetof(Vertex, tangent), 1
+    };
+
+    struct Mesh {
+        std::vector<Vertex> vertices;
+        std::vector<uint32_t> indices;
+    };
+
+    // Normals then tangents, as MGPMesh makes them.
+    Mesh generate(const Mesh &mesh, uint32_t numThreads) {
+        Mesh result;
+        result.vertices.resize((mesh.vertices.size() + mesh.indices.size()) * 2);
+        result.indices.resize(mesh.indices.size());
+        size_t count = mgp_tangent_space_generate_normals(result.vertices.data(), result.indices.data(),
+                                                          mesh.vertices.data(), mesh.vertices.size(),
+                                                          mesh.indices.data(), mesh.indices.size(),
+                                                          &kLayout, 0.5f, numThreads);
+        count = mgp_tangent_space_generate_tangents(result.vertices.data(), result.indices.data(),
+                                                    result.vertices.data(), count,
+                                                    result.indices.data(), result.indices.size(),
+                                                    &kLayout, numThreads);
+        result.vertices.resize(count);
+        return result;
+    }
+
+    // Unit normal and tangent at right angles, a sign of +-1, every index valid.
+    bool isOrthonormal(const Mesh &mesh) {
+        bool valid = true;
+        for(const Vertex &vertex : mesh.vertices) {
+            Vector normal = vector(vertex.normal), tangent = vector(vertex.tangent);
+            valid &= fabsf(dot(normal, normal) - 1.0f) < 1e-4f && fabsf(dot(tangent, tangent) - 1.0f) < 1e-4f;
+            valid &= fabsf(dot(normal, tangent)) < 1e-4f;
+            valid &= vertex.tangent[3] == 1.0f || vertex.tangent[3] == -1.0f;
+        }
+        for(uint32_t index : mesh.indices)
+            valid &= index < mesh.vertices.size();
+        return valid;
+    }
+
+    // Two triangles from corner along the edges, uv (0, 0) ~ (1, 1) over them
+    // unless mirrored in u.
+    Mesh quad(Vector corner, Vector edgeU, Vector edgeV, bool mirrored) {
+        Mesh mesh;
+        const float uv[4][2] = { { 0, 0 }, { 1, 0 }, { 1, 1 }, { 0, 1 } };
+        for(int i = 0; i < 4; i++) {
+            Vector p = { corner.x + edgeU.x * uv[i][0] + edgeV.x * uv[i][1],
+                         corner.y + edgeU.y * uv[i][0] + edgeV.y * uv[i][1],
+                         corner.z + edgeU.z * uv[i][0] + edgeV.z * uv[i][1] };
+            mesh.vertices.push_back(makeVertex(p.x, p.y, p.z, mirrored ? 1.0f - uv[i][0] : uv[i][0], uv[i][1]));
+        }
+        mesh.indices = { 0, 1, 2, 0, 2, 3 };
+        return mesh;
+    }
+
+    // The basis the vertex would give to a normal map.
+    bool hasBasis(const Vertex &vertex, Vector normal, Vector tangent, Vector bitangent) {
+        Vector n = vector(vertex.normal), t = vector(vertex.tangent);
+        Vector b = cross(n, t) * vertex.tangent[3];
+        return dot(n, normal) > 0.9999f && dot(t, tangent) > 0.9999f && dot(b, bitangent) > 0.9999f;
+    }
+}
+
+// Planar quads in any orientation : the normal faces the front side, the tangent
+// follows u and the bitangent from the sign follows v.
+MGP_TEST(planarQuadGivesOrthonormalBasis) {
+    const Vector edges[][2] = {
+        { { 1, 0, 0 }, { 0, 1, 0 } },
+        { { 0, 0, -2 }, { 0, 3, 0 } },
+        { { 0.6f, 0.8f, 0 }, { -0.3f, 0.2f, 0.9f } },      // not at right angles
+    };
+    for(const auto &edge : edges) {
+        Mesh mesh = generate(quad({ 1, 2, 3 }, edge[0], edge[1], false), 1);
+        MGP_CHECK(mesh.vertices.size() == 4);
+        MGP_CHECK(isOrthonormal(mesh));
+
+        // u follows edge 0, v is what's left at right angles to it
+        Vector normal = normalize(cross(edge[0], edge[1]));
+        Vector tangent = normalize(edge[0]);
+        Vector bitangent = cross(normal, tangent);
+        bool basis = true;
+        for(const Vertex &vertex : mesh.vertices)
+            basis &= hasBasis(vertex, normal, tangent, bitangent) && vertex.tangent[3] == 1.0f;
+        MGP_CHECK(basis);
+    }
+}
+
+// u running backwards : the tangent turns around and the sign keeps the
+// bitangent along v.
+MGP_TEST(mirroredQuadFlipsHandedness) {
+    Mesh mesh = generate(quad({ 0, 0, 0 }, { 1, 0, 0 }, { 0, 1, 0 }, true), 1);
+    MGP_CHECK(mesh.vertices.size() == 4);
+    MGP_CHECK(isOrthonormal(mesh));
+    bool basis = true;
+    for(const Vertex &vertex : mesh.vertices)
+        basis &= hasBasis(vertex, { 0, 0, 1 }, { -1, 0, 0 }, { 0, 1, 0 }) && vertex.tangent[3] == -1.0f;
+    MGP_CHECK(basis);
+
+    // a quad and its mirror side by side, sharing the edge at x = 1 in both uv
+    // and position : the shared vertices split, one copy for each side
+    Mesh pair;
+    const float x[6] = { 0, 1, 2, 0, 1, 2 }, u[6] = { 0, 1, 0, 0, 1, 0 };
+    for(int i = 0; i < 6; i++) {
+        float y = i < 3 ? 0.0f : 1.0f;
+        pair.vertices.push_back(makeVertex(x[i], y, 0, u[i], y));
+    }
+    pair.indices = { 0, 1, 4, 0, 4, 3, 1, 2, 5, 1, 5, 4 };
+    Mesh result = generate(pair, 1);
+    MGP_CHECK(result.vertices.size() == 8);
+    MGP_CHECK(isOrthonormal(result));
+    bool sides = true;
+    for(size_t i = 0; i < result.indices.size(); i++) {
+        const Vertex &vertex = result.vertices[result.indices[i]];
+        bool left = i < 6;
+        sides &= hasBasis(vertex, { 0, 0, 1 }, { left ? 1.0f : -1.0f, 0, 0 }, { 0, 1, 0 });
+        sides &= vertex.tangent[3] == (left ? 1.0f : -1.0f);
+    }
+    MGP_CHECK(sides);
+    MGP_CHECK(result.indices[6] != result.indices[1] && result.indices[11] != result.indices[2]);
+}
+
+// Any number of threads gives the same vertices and indices, bit for bit.
+MGP_TEST(parallelMatchesSerial) {
+    std::vector<Mesh> meshes;
+
+    // a uv sphere with its seam, past the size that's split across threads
+    Mesh sphere;
+    const int slices = 128, stacks = 64;
+    for(int j = 0; j <= stacks; j++) {
+        for(int i = 0; i <= slices; i++) {
+            float theta = (float)M_PI * j / stacks, phi = 2.0f * (float)M_PI * i / slices;
+            sphere.vertices.push_back(makeVertex(sinf(theta) * cosf(phi), cosf(theta), sinf(theta) * sinf(phi),
+                                                 (float)i / slices, (float)j / stacks));
+        }
+    }
+    for(int j = 0; j < stacks; j++) {
+        for(int i = 0; i < slices; i++) {
+            uint32_t a = j * (slices + 1) + i, b = a + 1, c = a + slices + 1, d = c + 1;
+            sphere.indices.insert(sphere.indices.end(), { a, b, c, b, d, c });
+        }
+    }
+    meshes.push_back(sphere);
+
+    char error[256] = {};
+    mgp_obj_model_t *model = mgp_obj_load(mgp::test::assetPath("Common/Assets/Models/teapot.obj").c_str(),
+                                          1, error, sizeof(error));
+    MGP_CHECK(model != nullptr);
+    if(model) {
+        Mesh teapot;
+        for(uint32_t v = 0; v < model->numVertices; v++) {
+            const mgp_obj_vertex_t &vertex = model->vertices[v];
+            teapot.vertices.push_back(makeVertex(vertex.position[0], vertex.position[1], vertex.position[2],
+                                                 vertex.uv[0], vertex.uv[1]));
+        }
+        for(uint32_t o = 0; o < model->numObjects; o++) {
+            const mgp_obj_object_t &object = model->objects[o];
+            for(uint32_t s = object.submeshStart; s < object.submeshStart + object.submeshCount; s++) {
+                const mgp_obj_submesh_t &submesh = model->submeshes[s];
+                for(uint32_t k = submesh.indexStart; k < submesh.indexStart + submesh.indexCount; k++)
+                    teapot.indices.push_back(model->indices[k] + object.vertexStart);
+            }
+        }
+        meshes.push_back(teapot);
+        mgp_obj_destroy(model);
+    }
+
+    for(const Mesh &mesh : meshes) {
+        MGP_CHECK(mesh.indices.size() / 3 >= 4096);
+        Mesh serial = generate(mesh, 1);
+        MGP_CHECK(isOrthonormal(serial));
+        MGP_CHECK(serial.vertices.size() > mesh.vertices.size());
+        bool same = true;
+        for(uint32_t numThreads : { 2u, 3u, 8u, 0u }) {
+            Mesh parallel = generate(mesh, numThreads);
+            same &= parallel.indices == serial.indices && parallel.vertices.size() == serial.vertices.size() &&
+                    memcmp(parallel.vertices.data(), serial.vertices.data(), sizeof(Vertex) * serial.vertices.size()) == 0;
+        }
+        MGP_CHECK(same);
+    }
+}
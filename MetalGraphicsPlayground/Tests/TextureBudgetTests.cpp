@@ -0,0 +1,216 @@
+//
+//  TextureBudgetTests.cpp
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/18.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#include "MGPTest.h"
+#include "MGPTextureBudget.h"
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <vector>
+
+namespace {
+    // Remembers the skipped levels the budget last told about.
+    struct MockBackend {
+        std::map<void *, uint32_t> resized;
+        size_t numResized = 0;
+
+        static void resize(void *context, void *texture, uint32_t skippedLevels) {
+            MockBackend *backend = (MockBackend *)context;
+            backend->resized[texture] = skippedLevels;
+            backend->numResized++;
+        }
+
+        mgp_texture_budget_backend_t backend() {
+            return { resize, this };
+        }
+    };
+
+    // RGBA8 2D texture with every mip level
+    struct Texture {
+        uint32_t width, height;
+        std::vector<uint64_t> levelBytes;
+
+        Texture(uint32_t width, uint32_t height) : width(width), height(height) {
+            for(uint32_t w = width, h = height; ; w = std::max(1u, w / 2), h = std::max(1u, h / 2)) {
+                levelBytes.push_back((uint64_t)w * h * 4);
+                if(w == 1 && h == 1)
+                    break;
+            }
+        }
+
+        uint32_t add(mgp_texture_budget_t *budget) {
+            return mgp_texture_budget_add(budget, this, width, height, 1,
+                                          (uint32_t)levelBytes.size(), levelBytes.data());
+        }
+    };
+
+    // The policy spelled out : skip levels over maxSize, then drop the largest
+    // top level (the earliest added on a tie) one at a time until the budget fits.
+    std::vector<uint32_t> referenceSkippedLevels(const std::vector<Texture> &textures, size_t budget,
+                                                 uint32_t maxSize, uint32_t minSize) {
+        size_t count = textures.size();
+        std::vector<uint32_t> skip(count), maxSkip(count);
+        uint64_t total = 0;
+        for(size_t i = 0; i < count; i++) {
+            const Texture &texture = textures[i];
+            uint32_t lastLevel = (uint32_t)texture.levelBytes.size() - 1;
+            auto sizeOf = [&](uint32_t level) {
+                return std::max(1u, std::max(texture.width, texture.height) >> level);
+            };
+            while(maxSize > 0 && skip[i] < lastLevel && sizeOf(skip[i]) > maxSize)
+                skip[i]++;
+            maxSkip[i] = skip[i];
+            while(maxSkip[i] < lastLevel && sizeOf(maxSkip[i] + 1) >= minSize)
+                maxSkip[i]++;
+            for(uint32_t level = skip[i]; level <= lastLevel; level++)
+                total += texture.levelBytes[level];
+        }
+        while(budget > 0 && total > budget) {
+            size_t largest = count;
+            for(size_t i = 0; i < count; i++) {
+                if(skip[i] < maxSkip[i] && (largest == count ||
+                   textures[i].levelBytes[skip[i]] > textures[largest].levelBytes[skip[largest]]))
+                    largest = i;
+            }
+            if(largest == count)
+                break;
+            total -= textures[largest].levelBytes[skip[largest]++];
+        }
+        return skip;
+    }
+
+    std::vector<uint32_t> skippedLevels(const mgp_texture_budget_t *budget, std::vector<Texture> &textures) {
+        std::vector<uint32_t> skip;
+        for(Texture &texture : textures)
+            skip.push_back(mgp_texture_budget_skipped_levels(budget, &texture));
+        return skip;
+    }
+
+    const uint64_t kMB = 1 << 20;
+}
+
+// 1024, 512 and 256 RGBA8 : the 4 MB top level of the 1024 goes first, then the
+// 1 MB levels, the 1024 before the 512 which was added later.
+MGP_TEST(largestTopLevelsGoFirst) {
+    MockBackend mock;
+    mgp_texture_budget_backend_t backend = mock.backend();
+    mgp_texture_budget_t *budget = mgp_texture_budget_create(&backend, 0, 0, 1);
+    std::vector<Texture> textures = { Texture(1024, 1024), Texture(512, 512), Texture(256, 256) };
+    for(Texture &texture : textures)
+        MGP_CHECK(texture.add(budget) == 0);
+    mgp_texture_budget_stats_t stats;
+    mgp_texture_budget_get_stats(budget, &stats);
+    MGP_CHECK(stats.residentBytes == stats.fullBytes && stats.numReduced == 0 && stats.numTextures == 3);
+
+    mgp_texture_budget_set_budget(budget, 4 * kMB);
+    MGP_CHECK(skippedLevels(budget, textures) == (std::vector<uint32_t>{ 1, 0, 0 }));
+    mgp_texture_budget_set_budget(budget, 2 * kMB);
+    MGP_CHECK(skippedLevels(budget, textures) == (std::vector<uint32_t>{ 2, 0, 0 }));
+    mgp_texture_budget_set_budget(budget, 1 * kMB);
+    MGP_CHECK(skippedLevels(budget, textures) == (std::vector<uint32_t>{ 2, 1, 0 }));
+    mgp_texture_budget_get_stats(budget, &stats);
+    MGP_CHECK(stats.residentBytes <= 1 * kMB && stats.numReduced == 2);
+    MGP_CHECK(mock.resized[&textures[0]] == 2 && mock.resized[&textures[1]] == 1);
+    MGP_CHECK(mock.resized.count(&textures[2]) == 0);
+
+    // back to unlimited, every texture reloads its full chain
+    mgp_texture_budget_set_budget(budget, 0);
+    MGP_CHECK(skippedLevels(budget, textures) == (std::vector<uint32_t>{ 0, 0, 0 }));
+    MGP_CHECK(mock.resized[&textures[0]] == 0 && mock.resized[&textures[1]] == 0);
+    mgp_texture_budget_destroy(budget);
+}
+
+// maxSize always applies, minSize stops the budget even if it isn't met.
+MGP_TEST(sizeLimits) {
+    MockBackend mock;
+    mgp_texture_budget_backend_t backend = mock.backend();
+    mgp_texture_budget_t *budget = mgp_texture_budget_create(&backend, 0, 256, 64);
+    std::vector<Texture> textures = { Texture(1024, 1024), Texture(512, 128), Texture(32, 32) };
+    MGP_CHECK(textures[0].add(budget) == 2);
+    MGP_CHECK(textures[1].add(budget) == 1);
+    MGP_CHECK(textures[2].add(budget) == 0);
+    MGP_CHECK(mock.numResized == 0);
+    MGP_CHECK(mgp_texture_budget_max_size_of_level(1024, 1024, 1, 2) == 256);
+    MGP_CHECK(mgp_texture_budget_max_size_of_level(512, 128, 1, 1) == 256);
+    MGP_CHECK(mgp_texture_budget_max_size_of_level(8, 4, 64, 3) == 8);
+    MGP_CHECK(mgp_texture_budget_max_size_of_level(8, 4, 1, 40) == 1);
+
+    // nothing fits in a byte : every texture down to 64, the smaller one untouched
+    mgp_texture_budget_set_budget(budget, 1);
+    MGP_CHECK(skippedLevels(budget, textures) == (std::vector<uint32_t>{ 4, 3, 0 }));
+    mgp_texture_budget_stats_t stats;
+    mgp_texture_budget_get_stats(budget, &stats);
+    MGP_CHECK(stats.residentBytes > 1 && stats.numReduced == 2);
+
+    // a last level above minSize is still kept
+    mgp_texture_budget_set_min_size(budget, 4096);
+    MGP_CHECK(skippedLevels(budget, textures) == (std::vector<uint32_t>{ 2, 1, 0 }));
+    mgp_texture_budget_set_max_size(budget, 0);
+    MGP_CHECK(skippedLevels(budget, textures) == (std::vector<uint32_t>{ 0, 0, 0 }));
+    mgp_texture_budget_destroy(budget);
+}
+
+// Random textures, limits, additions and removals against the policy spelled
+// out. Lowering the budget never brings a level back.
+MGP_TEST(matchesReferencePolicy) {
+    std::mt19937 random(1);
+    MockBackend mock;
+    mgp_texture_budget_backend_t backend = mock.backend();
+    mgp_texture_budget_t *budget = mgp_texture_budget_create(&backend, 0, 0, 1);
+    std::vector<Texture> textures;
+    textures.reserve(60);
+    for(int i = 0; i < 60; i++)
+        textures.emplace_back(1u << random() % 12, 1u << random() % 12);
+    std::vector<Texture *> order;
+
+    bool same = true, told = true, monotonic = true;
+    for(int step = 0; step < 300; step++) {
+        size_t bytes = random() % 4 == 0 ? 0 : (size_t)(random() % (64 * kMB));
+        uint32_t maxSize = random() % 3 ? 0 : 1u << random() % 12;
+        uint32_t minSize = random() % 3 ? 1 : 1u << random() % 12;
+        mgp_texture_budget_set_budget(budget, bytes);
+        mgp_texture_budget_set_max_size(budget, maxSize);
+        mgp_texture_budget_set_min_size(budget, minSize);
+
+        Texture *texture = &textures[random() % textures.size()];
+        auto position = std::find(order.begin(), order.end(), texture);
+        if(position != order.end()) {
+            order.erase(position);
+            mgp_texture_budget_remove(budget, texture);
+        }
+        else {
+            order.push_back(texture);
+            texture->add(budget);
+        }
+
+        std::vector<Texture> current;
+        std::vector<uint32_t> skip;
+        for(Texture *t : order) {
+            current.push_back(*t);
+            skip.push_back(mgp_texture_budget_skipped_levels(budget, t));
+            // the backend knows the count of everything but a texture just added
+            told &= t == texture || (mock.resized.count(t) ? mock.resized[t] : 0) == skip.back();
+        }
+        same &= skip == referenceSkippedLevels(current, bytes, maxSize, minSize);
+        mock.resized[texture] = mgp_texture_budget_skipped_levels(budget, texture);
+
+        if(bytes > 0) {
+            mgp_texture_budget_set_budget(budget, bytes / 2);
+            for(size_t i = 0; i < order.size(); i++) {
+                monotonic &= mgp_texture_budget_skipped_levels(budget, order[i]) >= skip[i];
+                told &= mock.resized[order[i]] == mgp_texture_budget_skipped_levels(budget, order[i]);
+            }
+        }
+    }
+    MGP_CHECK(same);
+    MGP_CHECK(told);
+    MGP_CHECK(monotonic);
+    MGP_CHECK(mgp_texture_budget_skipped_levels(budget, &mock) == 0);
+    mgp_texture_budget_destroy(budget);
+}
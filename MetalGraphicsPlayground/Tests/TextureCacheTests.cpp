@@ -0,0 +1,261 @@
+//
+//  TextureCacheTests.cpp
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/18.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#include "MGPTest.h"
+#include "MGPTextureCache.h"
+
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace {
+    // Records what the cache evicts.
+    struct MockBackend {
+        std::vector<void *> evicted;
+
+        static void evict(void *context, void *texture) {
+            ((MockBackend *)context)->evicted.push_back(texture);
+        }
+
+        mgp_texture_cache_backend_t backend() {
+            return { evict, this };
+        }
+    };
+
+    // A file on the fake disk, the texture loaded from it is any address.
+    struct File {
+        std::string path;
+        std::vector<uint8_t> contents;
+        int64_t modificationTime = 1;
+        uint32_t variant = 0;
+
+        mgp_texture_cache_file_t info() const {
+            return { path.c_str(), contents.size(), modificationTime, variant };
+        }
+        uint64_t hash() const {
+            return mgp_texture_cache_hash(contents.data(), contents.size());
+        }
+    };
+
+    // What the loader does : path, then content, then a load.
+    void *load(mgp_texture_cache_t *cache, const File &file, void *newTexture) {
+        mgp_texture_cache_file_t info = file.info();
+        void *texture = mgp_texture_cache_acquire_path(cache, &info);
+        if(texture == NULL)
+            texture = mgp_texture_cache_acquire_content(cache, &info, file.hash());
+        if(texture == NULL) {
+            mgp_texture_cache_insert(cache, &info, file.hash(), newTexture);
+            texture = newTexture;
+        }
+        return texture;
+    }
+
+    mgp_texture_cache_stats_t statsOf(const mgp_texture_cache_t *cache) {
+        mgp_texture_cache_stats_t stats;
+        mgp_texture_cache_get_stats(cache, &stats);
+        return stats;
+    }
+
+    std::vector<uint8_t> randomContents(std::mt19937 &random, size_t size) {
+        std::vector<uint8_t> contents(size);
+        for(uint8_t &byte : contents)
+            byte = (uint8_t)random();
+        return contents;
+    }
+}
+
+// The same file under other names is one texture, loaded once; its bytes count
+// as saved for every hit and as deduplicated for the content hits.
+MGP_TEST(identicalContentIsShared) {
+    MockBackend mock;
+    mgp_texture_cache_backend_t backend = mock.backend();
+    mgp_texture_cache_t *cache = mgp_texture_cache_create(&backend);
+    std::mt19937 random(1);
+    int textures[4];
+
+    File brick = { "/assets/brick.dds", randomContents(random, 1000) };
+    File copy = brick, other = brick;
+    copy.path = "/assets/sponza/brick_copy.dds";
+    other.path = "/assets/other.dds";
+    other.contents[500] ^= 1;
+
+    MGP_CHECK(load(cache, brick, &textures[0]) == &textures[0]);
+    MGP_CHECK(load(cache, copy, &textures[1]) == &textures[0]);
+    MGP_CHECK(load(cache, other, &textures[2]) == &textures[2]);
+    mgp_texture_cache_stats_t stats = statsOf(cache);
+    MGP_CHECK(stats.misses == 2 && stats.contentHits == 1 && stats.pathHits == 0);
+    MGP_CHECK(stats.savedBytes == 1000 && stats.dedupedBytes == 1000);
+    MGP_CHECK(stats.residentBytes == 2000);
+    MGP_CHECK(stats.numTextures == 2 && stats.numPaths == 3);
+
+    // the copy's path is known now, it isn't hashed again
+    mgp_texture_cache_file_t info = copy.info();
+    MGP_CHECK(mgp_texture_cache_acquire_path(cache, &info) == &textures[0]);
+    stats = statsOf(cache);
+    MGP_CHECK(stats.pathHits == 1 && stats.savedBytes == 2000 && stats.dedupedBytes == 1000);
+
+    // same contents loaded for another use, or a file that only shares the hash
+    File variant = copy;
+    variant.variant = 1;
+    MGP_CHECK(load(cache, variant, &textures[3]) == &textures[3]);
+    File truncated = { "/assets/truncated.dds", std::vector<uint8_t>(brick.contents.begin(), brick.contents.end() - 1) };
+    info = truncated.info();
+    MGP_CHECK(mgp_texture_cache_acquire_content(cache, &info, brick.hash()) == NULL);
+    MGP_CHECK(statsOf(cache).misses == 4);
+
+    mgp_texture_cache_destroy(cache);
+    MGP_CHECK(std::set<void *>(mock.evicted.begin(), mock.evicted.end()) ==
+              (std::set<void *>{ &textures[0], &textures[2], &textures[3] }));
+    MGP_CHECK(mock.evicted.size() == 3);
+}
+
+// The cache only holds textures somebody uses : the last release evicts the
+// texture and forgets every path to it.
+MGP_TEST(lastReleaseEvicts) {
+    MockBackend mock;
+    mgp_texture_cache_backend_t backend = mock.backend();
+    mgp_texture_cache_t *cache = mgp_texture_cache_create(&backend);
+    std::mt19937 random(2);
+    int texture, reloaded;
+
+    File file = { "/a.dds", randomContents(random, 300) };
+    File copy = file;
+    copy.path = "/b.dds";
+    load(cache, file, &texture);
+    load(cache, file, NULL);
+    load(cache, copy, NULL);
+
+    MGP_CHECK(mgp_texture_cache_release(cache, &texture));
+    MGP_CHECK(mgp_texture_cache_release(cache, &texture));
+    MGP_CHECK(mock.evicted.empty());
+    MGP_CHECK(statsOf(cache).numTextures == 1);
+    MGP_CHECK(mgp_texture_cache_release(cache, &texture));
+    MGP_CHECK(mock.evicted == std::vector<void *>{ &texture });
+
+    mgp_texture_cache_stats_t stats = statsOf(cache);
+    MGP_CHECK(stats.evictions == 1 && stats.numTextures == 0 && stats.numPaths == 0 && stats.residentBytes == 0);
+    MGP_CHECK(mgp_texture_cache_release(cache, &texture) == 0);
+    mgp_texture_cache_file_t info = copy.info();
+    MGP_CHECK(mgp_texture_cache_acquire_path(cache, &info) == NULL);
+    MGP_CHECK(load(cache, copy, &reloaded) == &reloaded);
+
+    mgp_texture_cache_destroy(cache);
+    MGP_CHECK(mock.evicted.back() == &reloaded && mock.evicted.size() == 2);
+}
+
+// A path whose size or modification time changed is hashed again, its texture
+// stays for other paths and for the same contents.
+MGP_TEST(changedFilesAreHashedAgain) {
+    MockBackend mock;
+    mgp_texture_cache_backend_t backend = mock.backend();
+    mgp_texture_cache_t *cache = mgp_texture_cache_create(&backend);
+    std::mt19937 random(3);
+    int textures[2];
+
+    File file = { "/a.dds", randomContents(random, 512) };
+    File copy = file;
+    copy.path = "/b.dds";
+    load(cache, file, &textures[0]);
+    load(cache, copy, NULL);
+
+    // touched, not changed
+    file.modificationTime++;
+    mgp_texture_cache_file_t info = file.info();
+    MGP_CHECK(mgp_texture_cache_acquire_path(cache, &info) == NULL);
+    MGP_CHECK(statsOf(cache).numPaths == 1);
+    MGP_CHECK(load(cache, file, &textures[1]) == &textures[0]);
+
+    // rewritten
+    file.modificationTime++;
+    file.contents = randomContents(random, 512);
+    MGP_CHECK(load(cache, file, &textures[1]) == &textures[1]);
+    info = copy.info();
+    MGP_CHECK(mgp_texture_cache_acquire_path(cache, &info) == &textures[0]);
+    MGP_CHECK(mock.evicted.empty());
+
+    mgp_texture_cache_stats_t stats = statsOf(cache);
+    MGP_CHECK(stats.numTextures == 2 && stats.numPaths == 2);
+    MGP_CHECK(stats.residentBytes == 1024);
+    mgp_texture_cache_destroy(cache);
+}
+
+// Random loads and releases against a plain model of which textures are alive.
+MGP_TEST(countersMatchModel) {
+    MockBackend mock;
+    mgp_texture_cache_backend_t backend = mock.backend();
+    mgp_texture_cache_t *cache = mgp_texture_cache_create(&backend);
+    std::mt19937 random(4);
+
+    // 12 paths over 5 distinct files
+    std::vector<std::vector<uint8_t>> contents;
+    for(int i = 0; i < 5; i++)
+        contents.push_back(randomContents(random, 100 + i * 37));
+    std::vector<File> files;
+    for(int i = 0; i < 12; i++)
+        files.push_back({ "/textures/" + std::to_string(i) + ".dds", contents[i % 5] });
+
+    std::vector<int> storage(10000);
+    size_t numLoaded = 0;
+    std::vector<void *> held;
+    uint64_t requestedBytes = 0, loadedBytes = 0;
+    bool consistent = true;
+    for(int step = 0; step < 2000; step++) {
+        if(held.empty() || random() % 3) {
+            const File &file = files[random() % files.size()];
+            void *texture = load(cache, file, &storage[numLoaded]);
+            if(texture == &storage[numLoaded]) {
+                numLoaded++;
+                loadedBytes += file.contents.size();
+            }
+            requestedBytes += file.contents.size();
+            held.push_back(texture);
+        }
+        else {
+            size_t i = random() % held.size();
+            consistent &= mgp_texture_cache_release(cache, held[i]) == 1;
+            held.erase(held.begin() + i);
+        }
+
+        // alive : loaded and still held, one per distinct file
+        std::set<void *> alive(held.begin(), held.end());
+        mgp_texture_cache_stats_t stats = statsOf(cache);
+        consistent &= stats.numTextures == alive.size() && alive.size() <= contents.size();
+        consistent &= stats.evictions == numLoaded - alive.size() && mock.evicted.size() == stats.evictions;
+        consistent &= stats.misses == numLoaded;
+        consistent &= stats.savedBytes == requestedBytes - loadedBytes;
+        consistent &= stats.dedupedBytes <= stats.savedBytes;
+    }
+    MGP_CHECK(consistent);
+    mgp_texture_cache_stats_t stats = statsOf(cache);
+    MGP_CHECK(stats.pathHits > 0 && stats.contentHits > 0 && stats.evictions > 0);
+    mgp_texture_cache_destroy(cache);
+    MGP_CHECK(mock.evicted.size() == numLoaded);
+}
+
+MGP_TEST(hashDependsOnEveryByte) {
+    std::mt19937 random(5);
+    std::vector<uint8_t> data = randomContents(random, 200);
+    std::set<uint64_t> hashes;
+    for(size_t size = 0; size <= data.size(); size++)
+        hashes.insert(mgp_texture_cache_hash(data.data(), size));
+    MGP_CHECK(hashes.size() == data.size() + 1);
+
+    uint64_t hash = mgp_texture_cache_hash(data.data(), data.size());
+    bool changed = true;
+    for(size_t i = 0; i < data.size(); i++) {
+        for(int bit = 0; bit < 8; bit++) {
+            data[i] ^= 1 << bit;
+            changed &= mgp_texture_cache_hash(data.data(), data.size()) != hash;
+            data[i] ^= 1 << bit;
+        }
+    }
+    MGP_CHECK(changed);
+    std::vector<uint8_t> copy = data;
+    MGP_CHECK(mgp_texture_cache_hash(copy.data(), copy.size()) == hash);
+}
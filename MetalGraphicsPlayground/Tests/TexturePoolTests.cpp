@@ -0,0 +1,261 @@
+//
+//  TexturePoolTests.cpp
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/18.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#include "MGPTest.h"
+#include "MGPTexturePool.h"
+
+#include <stdlib.h>
+#include <map>
+#include <random>
+#include <vector>
+
+namespace {
+    // Textures are host allocations of the key's size, 4 bytes a pixel.
+    struct MockBackend {
+        std::map<void *, mgp_texture_pool_key_t> live;
+        std::vector<void *> destroyed;
+        size_t numCreated = 0;
+        bool failCreation = false;
+
+        ~MockBackend() {
+            for(void *texture : destroyed)
+                free(texture);
+        }
+
+        static void *createTexture(void *context, const mgp_texture_pool_key_t *key, size_t *bytes) {
+            MockBackend *backend = (MockBackend *)context;
+            if(backend->failCreation)
+                return NULL;
+            void *texture = malloc(1);
+            backend->live[texture] = *key;
+            backend->numCreated++;
+            *bytes = (size_t)key->width * key->height * 4;
+            return texture;
+        }
+
+        static void destroyTexture(void *context, void *texture) {
+            MockBackend *backend = (MockBackend *)context;
+            MGP_CHECK(backend->live.count(texture) == 1);
+            backend->live.erase(texture);
+            // kept until the end, so no address comes back as a new texture
+            backend->destroyed.push_back(texture);
+        }
+
+        mgp_texture_pool_backend_t backend() {
+            return { createTexture, destroyTexture, this };
+        }
+    };
+
+    // 2D RGBA8 render target, 'width' x 'height'
+    mgp_texture_pool_key_t makeKey(uint32_t width, uint32_t height = 5) {
+        mgp_texture_pool_key_t key = {};
+        key.textureType = 2;
+        key.pixelFormat = 70;
+        key.width = width;
+        key.height = height;
+        key.depth = 1;
+        key.mipmapLevelCount = 1;
+        key.arrayLength = 1;
+        key.sampleCount = 1;
+        key.storageMode = 2;
+        key.usage = 4;
+        return key;
+    }
+
+    mgp_texture_pool_stats_t statsOf(const mgp_texture_pool_t *pool) {
+        mgp_texture_pool_stats_t stats;
+        mgp_texture_pool_get_stats(pool, &stats);
+        return stats;
+    }
+}
+
+// Descriptors equal field by field get the same texture back, any field
+// differing gets another one.
+MGP_TEST(equalDescriptorsShareTextures) {
+    MockBackend mock;
+    mgp_texture_pool_backend_t backend = mock.backend();
+    mgp_texture_pool_t *pool = mgp_texture_pool_create(&backend, 0, 0);
+
+    mgp_texture_pool_key_t key = makeKey(16), same = makeKey(16);
+    MGP_CHECK(mgp_texture_pool_hash_key(&key) == mgp_texture_pool_hash_key(&same));
+    void *texture = mgp_texture_pool_acquire(pool, &key);
+    MGP_CHECK(mgp_texture_pool_release(pool, texture));
+    MGP_CHECK(mgp_texture_pool_acquire(pool, &same) == texture);
+    MGP_CHECK(mgp_texture_pool_release(pool, texture));
+
+    bool separate = true, hashed = true;
+    for(size_t field = 0; field < sizeof(key) / sizeof(uint32_t); field++) {
+        mgp_texture_pool_key_t other = key;
+        ((uint32_t *)&other)[field] ^= 1;
+        hashed &= mgp_texture_pool_hash_key(&other) != mgp_texture_pool_hash_key(&key);
+        void *otherTexture = mgp_texture_pool_acquire(pool, &other);
+        separate &= otherTexture != texture && mock.live[otherTexture].pixelFormat == other.pixelFormat;
+        mgp_texture_pool_release(pool, otherTexture);
+    }
+    MGP_CHECK(separate);
+    MGP_CHECK(hashed);
+
+    // a held texture isn't handed out twice
+    void *first = mgp_texture_pool_acquire(pool, &key);
+    void *second = mgp_texture_pool_acquire(pool, &key);
+    MGP_CHECK(first == texture && second != first);
+
+    mgp_texture_pool_destroy(pool);
+    MGP_CHECK(mock.live.empty());
+}
+
+// Over the budget, unused textures go by last used frame, oldest first. Held
+// ones stay even if that leaves the pool over the budget.
+MGP_TEST(budgetEvictsLeastRecentlyUsed) {
+    MockBackend mock;
+    mgp_texture_pool_backend_t backend = mock.backend();
+    const size_t textureBytes = 10 * 5 * 4;
+    mgp_texture_pool_t *pool = mgp_texture_pool_create(&backend, textureBytes * 3, 0);
+
+    mgp_texture_pool_key_t keys[4] = { makeKey(10, 5), makeKey(5, 10), makeKey(25, 2), makeKey(2, 25) };
+    void *textures[4];
+    for(int i = 0; i < 3; i++) {
+        textures[i] = mgp_texture_pool_acquire(pool, &keys[i]);
+        mgp_texture_pool_release(pool, textures[i]);
+        mgp_texture_pool_begin_frame(pool);
+    }
+    // 0 used most recently, then 2, 1 the least
+    for(int i : { 2, 0 }) {
+        MGP_CHECK(mgp_texture_pool_acquire(pool, &keys[i]) == textures[i]);
+        mgp_texture_pool_release(pool, textures[i]);
+        mgp_texture_pool_begin_frame(pool);
+    }
+    MGP_CHECK(mock.destroyed.empty());
+    MGP_CHECK(statsOf(pool).residentBytes == textureBytes * 3);
+
+    textures[3] = mgp_texture_pool_acquire(pool, &keys[3]);
+    MGP_CHECK(mock.destroyed == std::vector<void *>{ textures[1] });
+    void *recreated = mgp_texture_pool_acquire(pool, &keys[1]);
+    MGP_CHECK(mock.destroyed == (std::vector<void *>{ textures[1], textures[2] }));
+    MGP_CHECK(statsOf(pool).residentBytes == textureBytes * 3);
+
+    // all held : over the budget, nothing to evict
+    void *held = mgp_texture_pool_acquire(pool, &keys[0]);
+    void *extra = mgp_texture_pool_acquire(pool, &keys[2]);
+    MGP_CHECK(held == textures[0] && extra != NULL);
+    MGP_CHECK(statsOf(pool).residentBytes == textureBytes * 4);
+    MGP_CHECK(mock.live.size() == 4);
+
+    // the first released is the first to go
+    mgp_texture_pool_release(pool, extra);
+    mgp_texture_pool_release(pool, recreated);
+    MGP_CHECK(mock.destroyed.back() == extra);
+    MGP_CHECK(mock.live.count(recreated) == 1);
+
+    // a lower budget trims right away
+    mgp_texture_pool_release(pool, held);
+    mgp_texture_pool_set_budget(pool, textureBytes);
+    MGP_CHECK(statsOf(pool).residentBytes == textureBytes);
+    MGP_CHECK(mock.live.size() == 1 && mock.live.count(textures[3]) == 1);
+
+    mgp_texture_pool_destroy(pool);
+    MGP_CHECK(mock.live.empty());
+}
+
+// Unused textures live for maxUnusedFrames frames after their last use.
+MGP_TEST(unusedTexturesExpire) {
+    MockBackend mock;
+    mgp_texture_pool_backend_t backend = mock.backend();
+    mgp_texture_pool_t *pool = mgp_texture_pool_create(&backend, 0, 2);
+    mgp_texture_pool_key_t key = makeKey(8), other = makeKey(9);
+
+    void *texture = mgp_texture_pool_acquire(pool, &key);
+    void *held = mgp_texture_pool_acquire(pool, &other);
+    mgp_texture_pool_release(pool, texture);
+    mgp_texture_pool_begin_frame(pool);
+    mgp_texture_pool_begin_frame(pool);
+    MGP_CHECK(mock.live.count(texture) == 1);
+    mgp_texture_pool_begin_frame(pool);
+    MGP_CHECK(mock.live.count(texture) == 0);
+    for(int i = 0; i < 10; i++)
+        mgp_texture_pool_begin_frame(pool);
+    MGP_CHECK(mock.live.count(held) == 1);
+
+    // 0 keeps them until the budget or a purge
+    mgp_texture_pool_set_max_unused_frames(pool, 0);
+    mgp_texture_pool_release(pool, held);
+    for(int i = 0; i < 10; i++)
+        mgp_texture_pool_begin_frame(pool);
+    MGP_CHECK(mock.live.count(held) == 1);
+    mgp_texture_pool_purge(pool);
+    MGP_CHECK(mock.live.empty());
+    mgp_texture_pool_destroy(pool);
+}
+
+// Random use against a budget : the counters add up with what the backend saw.
+MGP_TEST(statsMatchBackend) {
+    MockBackend mock;
+    mgp_texture_pool_backend_t backend = mock.backend();
+    const size_t budget = 4000;
+    mgp_texture_pool_t *pool = mgp_texture_pool_create(&backend, budget, 8);
+
+    std::mt19937 random(1);
+    std::vector<void *> held;
+    uint64_t numAcquired = 0;
+    bool consistent = true, withinBudget = true;
+    for(int frame = 0; frame < 500; frame++) {
+        mgp_texture_pool_begin_frame(pool);
+        for(int i = 0; i < 6; i++) {
+            mgp_texture_pool_key_t key = makeKey(1 + random() % 12, 1 + random() % 3);
+            if(random() % 7 == 0)
+                key.pixelFormat = 80;
+            held.push_back(mgp_texture_pool_acquire(pool, &key));
+            numAcquired++;
+        }
+        while(held.size() > 4) {
+            size_t i = random() % held.size();
+            consistent &= mgp_texture_pool_release(pool, held[i]) == 1;
+            held.erase(held.begin() + i);
+        }
+
+        mgp_texture_pool_stats_t stats = statsOf(pool);
+        size_t liveBytes = 0, heldBytes = 0, format80Bytes = 0;
+        for(auto &texture : mock.live) {
+            size_t bytes = (size_t)texture.second.width * texture.second.height * 4;
+            liveBytes += bytes;
+            if(texture.second.pixelFormat == 80)
+                format80Bytes += bytes;
+        }
+        for(void *texture : held)
+            heldBytes += (size_t)mock.live[texture].width * mock.live[texture].height * 4;
+        consistent &= stats.hits + stats.misses == numAcquired;
+        consistent &= stats.misses == mock.numCreated;
+        consistent &= stats.evictions == mock.destroyed.size();
+        consistent &= stats.numResident == mock.live.size() && stats.residentBytes == liveBytes;
+        consistent &= stats.numUnused == mock.live.size() - held.size();
+        consistent &= stats.unusedBytes == liveBytes - heldBytes;
+        consistent &= mgp_texture_pool_resident_bytes_of_format(pool, 80) == format80Bytes;
+        withinBudget &= stats.residentBytes <= budget || stats.numUnused == 0;
+    }
+    MGP_CHECK(consistent);
+    MGP_CHECK(withinBudget);
+    mgp_texture_pool_stats_t stats = statsOf(pool);
+    MGP_CHECK(stats.hits > stats.misses && stats.evictions > 0);
+
+    // not from the pool, or released twice
+    int notTexture = 0;
+    MGP_CHECK(mgp_texture_pool_release(pool, &notTexture) == 0);
+    void *last = held.back();
+    MGP_CHECK(mgp_texture_pool_release(pool, last) == 1);
+    MGP_CHECK(mgp_texture_pool_release(pool, last) == 0);
+
+    // the backend failing is a miss without a texture
+    mock.failCreation = true;
+    mgp_texture_pool_key_t key = makeKey(100);
+    MGP_CHECK(mgp_texture_pool_acquire(pool, &key) == NULL);
+    MGP_CHECK(statsOf(pool).misses == stats.misses + 1);
+    MGP_CHECK(statsOf(pool).numResident == stats.numResident);
+
+    mgp_texture_pool_destroy(pool);
+    MGP_CHECK(mock.live.empty());
+}
@@ -0,0 +1,304 @@
+//
+//  TransformSystemTests.cpp
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/18.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#include "MGPTest.h"
+#include "MGPTransformSystem.h"
+
+#include <math.h>
+#include <algorithm>
+#include <map>
+#include <random>
+#include <vector>
+
+namespace {
+    struct Local {
+        float position[3];
+        float rotation[9];
+        float scale[3];
+    };
+
+    // The hierarchy as the test sees it, world matrices resolved recursively.
+    struct Reference {
+        std::map<mgp_transform_t, mgp_transform_t> parents;
+        std::map<mgp_transform_t, Local> locals;
+
+        bool isAncestor(mgp_transform_t ancestor, mgp_transform_t transform) const {
+            for(; transform != MGP_TRANSFORM_NONE; transform = parents.at(transform)) {
+                if(transform == ancestor)
+                    return true;
+            }
+            return false;
+        }
+
+        void worldMatrix(mgp_transform_t transform, double out[16]) const {
+            const Local &local = locals.at(transform);
+            double matrix[16] = {};
+            for(int col = 0; col < 3; col++) {
+                for(int row = 0; row < 3; row++)
+                    matrix[col * 4 + row] = (double)local.rotation[col * 3 + row] * local.scale[col];
+            }
+            for(int row = 0; row < 3; row++)
+                matrix[12 + row] = local.position[row];
+            matrix[15] = 1.0;
+
+            mgp_transform_t parent = parents.at(transform);
+            if(parent == MGP_TRANSFORM_NONE) {
+                std::copy(matrix, matrix + 16, out);
+                return;
+            }
+            double parentMatrix[16];
+            worldMatrix(parent, parentMatrix);
+            for(int col = 0; col < 4; col++) {
+                for(int row = 0; row < 4; row++) {
+                    double sum = 0.0;
+                    for(int k = 0; k < 4; k++)
+                        sum += parentMatrix[k * 4 + row] * matrix[col * 4 + k];
+                    out[col * 4 + row] = sum;
+                }
+            }
+        }
+    };
+
+    Local randomLocal(std::mt19937 &random) {
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        Local local;
+        for(float &p : local.position)
+            p = unit(random) * 10.0f;
+        // rotation about a random axis
+        float axis[3] = { unit(random), unit(random), unit(random) + 2.0f };
+        float length = sqrtf(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+        float x = axis[0] / length, y = axis[1] / length, z = axis[2] / length;
+        float angle = unit(random) * 3.14159265f, c = cosf(angle), s = sinf(angle), t = 1.0f - c;
+        const float rotation[9] = {
+            t * x * x + c, t * x * y + s * z, t * x * z - s * y,
+            t * x * y - s * z, t * y * y + c, t * y * z + s * x,
+            t * x * z + s * y, t * y * z - s * x, t * z * z + c
+        };
+        std::copy(rotation, rotation + 9, local.rotation);
+        for(float &scale : local.scale)
+            scale = 0.5f + (unit(random) + 1.0f) * 0.5f;
+        return local;
+    }
+
+    bool matches(mgp_transform_system_t *system, const Reference &reference, mgp_transform_t transform) {
+        const float *matrix = mgp_transform_world_matrix(system, transform);
+        double expected[16];
+        reference.worldMatrix(transform, expected);
+        for(int i = 0; i < 16; i++) {
+            if(fabs(matrix[i] - expected[i]) > 1e-3 * std::max(1.0, fabs(expected[i])))
+                return false;
+        }
+        return true;
+    }
+
+    bool allMatch(mgp_transform_system_t *system, const Reference &reference) {
+        bool match = mgp_transform_system_count(system) == reference.parents.size();
+        for(const auto &entry : reference.parents) {
+            match &= mgp_transform_parent(system, entry.first) == entry.second;
+            match &= matches(system, reference, entry.first);
+        }
+        return match;
+    }
+}
+
+// Random creates, destroys, reparents and local changes; world matrices are
+// compared with the reference both after an update and when read without one.
+MGP_TEST(worldMatricesMatchRecursiveReference) {
+    for(uint32_t numThreads : { 1u, 4u }) {
+        mgp_transform_system_t *system = mgp_transform_system_create(numThreads);
+        Reference reference;
+        std::vector<mgp_transform_t> transforms;
+        std::mt19937 random(numThreads);
+        bool match = true, readMatch = true;
+        for(int step = 0; step < 4000; step++) {
+            uint32_t op = random() % 10;
+            if(transforms.size() < 8 || op < 3) {
+                mgp_transform_t transform = mgp_transform_create(system);
+                transforms.push_back(transform);
+                reference.parents[transform] = MGP_TRANSFORM_NONE;
+                Local local = randomLocal(random);
+                reference.locals[transform] = local;
+                mgp_transform_set_local(system, transform, local.position, local.rotation, local.scale);
+            }
+            else if(op < 4) {
+                size_t i = random() % transforms.size();
+                mgp_transform_t transform = transforms[i];
+                mgp_transform_destroy(system, transform);
+                // children become roots
+                for(auto &entry : reference.parents) {
+                    if(entry.second == transform)
+                        entry.second = MGP_TRANSFORM_NONE;
+                }
+                reference.parents.erase(transform);
+                reference.locals.erase(transform);
+                transforms.erase(transforms.begin() + i);
+            }
+            else if(op < 7) {
+                mgp_transform_t transform = transforms[random() % transforms.size()];
+                mgp_transform_t parent = random() % 8 == 0 ? MGP_TRANSFORM_NONE : transforms[random() % transforms.size()];
+                bool cycle = parent != MGP_TRANSFORM_NONE && reference.isAncestor(transform, parent);
+                match &= mgp_transform_set_parent(system, transform, parent) == !cycle;
+                if(!cycle)
+                    reference.parents[transform] = parent;
+            }
+            else {
+                mgp_transform_t transform = transforms[random() % transforms.size()];
+                Local local = randomLocal(random);
+                // only some of them
+                const float *position = random() % 2 ? local.position : nullptr;
+                const float *rotation = random() % 2 ? local.rotation : nullptr;
+                const float *scale = random() % 2 ? local.scale : nullptr;
+                mgp_transform_set_local(system, transform, position, rotation, scale);
+                Local &expected = reference.locals[transform];
+                if(position)
+                    std::copy(position, position + 3, expected.position);
+                if(rotation)
+                    std::copy(rotation, rotation + 9, expected.rotation);
+                if(scale)
+                    std::copy(scale, scale + 3, expected.scale);
+            }
+
+            if(step % 50 == 49) {
+                mgp_transform_system_update(system);
+                match &= allMatch(system, reference);
+            }
+            else if(step % 50 == 24) {
+                // resolved on read
+                mgp_transform_t transform = transforms[random() % transforms.size()];
+                readMatch &= matches(system, reference, transform);
+            }
+        }
+        MGP_CHECK(match);
+        MGP_CHECK(readMatch);
+        mgp_transform_system_destroy(system);
+    }
+}
+
+// Levels wide enough to be split across threads give the same matrices.
+MGP_TEST(wideLevelsMatchReference) {
+    mgp_transform_system_t *system = mgp_transform_system_create(4);
+    Reference reference;
+    std::mt19937 random(9);
+    std::vector<mgp_transform_t> previousLevel;
+    for(int level = 0; level < 3; level++) {
+        std::vector<mgp_transform_t> currentLevel;
+        size_t count = level == 0 ? 64 : 10000;
+        for(size_t i = 0; i < count; i++) {
+            mgp_transform_t transform = mgp_transform_create(system);
+            mgp_transform_t parent = previousLevel.empty() ? MGP_TRANSFORM_NONE : previousLevel[random() % previousLevel.size()];
+            MGP_CHECK(mgp_transform_set_parent(system, transform, parent));
+            Local local = randomLocal(random);
+            mgp_transform_set_local(system, transform, local.position, local.rotation, local.scale);
+            reference.parents[transform] = parent;
+            reference.locals[transform] = local;
+            currentLevel.push_back(transform);
+        }
+        previousLevel.swap(currentLevel);
+    }
+    mgp_transform_system_update(system);
+    MGP_CHECK(allMatch(system, reference));
+
+    // a root moves, its whole subtree follows
+    mgp_transform_t root = 0;
+    Local local = randomLocal(random);
+    mgp_transform_set_local(system, root, local.position, nullptr, nullptr);
+    std::copy(local.position, local.position + 3, reference.locals[root].position);
+    mgp_transform_system_update(system);
+    MGP_CHECK(allMatch(system, reference));
+    mgp_transform_system_destroy(system);
+}
+
+MGP_TEST(setParentRejectsCycles) {
+    mgp_transform_system_t *system = mgp_transform_system_create(1);
+    // a -> b -> c -> d
+    mgp_transform_t a = mgp_transform_create(system), b = mgp_transform_create(system);
+    mgp_transform_t c = mgp_transform_create(system), d = mgp_transform_create(system);
+    MGP_CHECK(mgp_transform_set_parent(system, b, a));
+    MGP_CHECK(mgp_transform_set_parent(system, c, b));
+    MGP_CHECK(mgp_transform_set_parent(system, d, c));
+
+    MGP_CHECK(!mgp_transform_set_parent(system, a, a));
+    MGP_CHECK(!mgp_transform_set_parent(system, a, d));
+    MGP_CHECK(!mgp_transform_set_parent(system, b, c));
+    MGP_CHECK(mgp_transform_parent(system, a) == MGP_TRANSFORM_NONE);
+    MGP_CHECK(mgp_transform_parent(system, b) == a);
+    MGP_CHECK(mgp_transform_parent(system, c) == b);
+
+    // moving a subtree elsewhere is fine, and so is setting the same parent again
+    MGP_CHECK(mgp_transform_set_parent(system, c, a));
+    MGP_CHECK(mgp_transform_set_parent(system, c, a));
+    MGP_CHECK(mgp_transform_set_parent(system, b, d));
+    MGP_CHECK(mgp_transform_parent(system, b) == d);
+    MGP_CHECK(!mgp_transform_set_parent(system, c, b));
+    mgp_transform_system_update(system);
+    MGP_CHECK(mgp_transform_system_count(system) == 4);
+    mgp_transform_system_destroy(system);
+}
+
+// Versions move only for transforms whose world matrix was recalculated :
+// the changed one and its descendants, once per change.
+MGP_TEST(versionsChangeOnlyWithWorldMatrices) {
+    mgp_transform_system_t *system = mgp_transform_system_create(1);
+    // root -> { left -> leftChild, right }, and another root
+    mgp_transform_t root = mgp_transform_create(system), left = mgp_transform_create(system);
+    mgp_transform_t leftChild = mgp_transform_create(system), right = mgp_transform_create(system);
+    mgp_transform_t other = mgp_transform_create(system);
+    mgp_transform_set_parent(system, left, root);
+    mgp_transform_set_parent(system, leftChild, left);
+    mgp_transform_set_parent(system, right, root);
+    const mgp_transform_t all[] = { root, left, leftChild, right, other };
+    mgp_transform_system_update(system);
+
+    auto versions = [&] {
+        std::vector<uint32_t> result;
+        for(mgp_transform_t transform : all)
+            result.push_back(mgp_transform_version(system, transform));
+        return result;
+    };
+    std::vector<uint32_t> before = versions();
+
+    // nothing changed
+    mgp_transform_system_update(system);
+    mgp_transform_world_matrix(system, leftChild);
+    MGP_CHECK(versions() == before);
+
+    // a rejected reparent changes nothing either
+    MGP_CHECK(!mgp_transform_set_parent(system, root, leftChild));
+    mgp_transform_system_update(system);
+    MGP_CHECK(versions() == before);
+
+    const float position[3] = { 1, 2, 3 };
+    mgp_transform_set_local(system, left, position, nullptr, nullptr);
+    mgp_transform_system_update(system);
+    std::vector<uint32_t> after = versions();
+    MGP_CHECK(after[0] == before[0]);
+    MGP_CHECK(after[1] == before[1] + 1);
+    MGP_CHECK(after[2] == before[2] + 1);
+    MGP_CHECK(after[3] == before[3]);
+    MGP_CHECK(after[4] == before[4]);
+
+    // resolved on read : the ancestors of what is read, nothing else
+    before = after;
+    mgp_transform_set_local(system, root, position, nullptr, nullptr);
+    mgp_transform_world_matrix(system, leftChild);
+    after = versions();
+    MGP_CHECK(after[0] == before[0] + 1 && after[1] == before[1] + 1 && after[2] == before[2] + 1);
+    MGP_CHECK(after[3] == before[3] + 1);
+    MGP_CHECK(after[4] == before[4]);
+    mgp_transform_system_update(system);
+    MGP_CHECK(versions() == after);
+
+    // a reparent recalculates the moved subtree only
+    before = after;
+    MGP_CHECK(mgp_transform_set_parent(system, left, other));
+    mgp_transform_system_update(system);
+    after = versions();
+    MGP_CHECK(after[0] == before[0] && after[3] == before[3] && after[4] == before[4]);
+    MGP_CHECK(after[1] == before[1] + 1 && after[2] == before[2] + 1);
+    mgp_transform_system_destroy(system);
+}
@@ -0,0 +1,213 @@
+//
+//  VertexQuantizerTests.cpp
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/18.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#include "MGPTest.h"
+#include "MGPVertexQuantizer.h"
+
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
+
+// Built once for every encoder this compiler can target (see CMakeLists.txt),
+// each build has to give the same bits.
+
+namespace {
+    struct Vertex {
+        float position[3];
+        float uv[2];
+        float normal[3];
+        float tangent[4];
+    };
+
+    // xorshift, so the vertices are the same with any standard library
+    struct Random {
+        uint32_t state = 2463534242u;
+        float next(float lower, float upper) {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            return lower + (upper - lower) * ((state >> 8) * (1.0f / 16777216.0f));
+        }
+    };
+
+    void normalize(float *v) {
+        float length = sqrtf(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+        for(int c = 0; c < 3; c++)
+            v[c] /= length;
+    }
+
+    float dot(const float *a, const float *b) {
+        return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+    }
+
+    // atan2 of the cross and dot products in double, acos of a float dot can't see a step
+    float angleDegrees(const float *a, const float *b) {
+        double cross[3] = { (double)a[1] * b[2] - (double)a[2] * b[1],
+                            (double)a[2] * b[0] - (double)a[0] * b[2],
+                            (double)a[0] * b[1] - (double)a[1] * b[0] };
+        double sine = sqrt(cross[0] * cross[0] + cross[1] * cross[1] + cross[2] * cross[2]);
+        double cosine = (double)a[0] * b[0] + (double)a[1] * b[1] + (double)a[2] * b[2];
+        return (float)(atan2(sine, cosine) * 180.0 / M_PI);
+    }
+
+    void setTangent(Vertex &v, const float *direction, float sign) {
+        float d = dot(direction, v.normal);
+        for(int c = 0; c < 3; c++)
+            v.tangent[c] = direction[c] - d * v.normal[c];
+        normalize(v.tangent);
+        v.tangent[3] = sign;
+    }
+
+    // Random vertices, then the axes and diagonals where the octahedron folds.
+    // 20003 isn't a multiple of 4, so the last group is partial.
+    std::vector<Vertex> makeVertices() {
+        std::vector<Vertex> vertices;
+        Random random;
+        for(int i = 0; i < 20003; i++) {
+            Vertex v;
+            for(int c = 0; c < 3; c++)
+                v.position[c] = random.next(-10.0f, 10.0f) * (c + 1);
+            v.uv[0] = random.next(-4.0f, 4.0f);
+            v.uv[1] = random.next(-4.0f, 4.0f);
+            float direction[3];
+            do {
+                for(int c = 0; c < 3; c++) {
+                    v.normal[c] = random.next(-1.0f, 1.0f);
+                    direction[c] = random.next(-1.0f, 1.0f);
+                }
+            } while(dot(v.normal, v.normal) < 1e-3f || dot(direction, direction) < 1e-3f);
+            normalize(v.normal);
+            normalize(direction);
+            if(fabsf(dot(direction, v.normal)) > 0.99f)
+                continue;
+            setTangent(v, direction, (i & 1) ? 1.0f : -1.0f);
+            vertices.push_back(v);
+        }
+
+        const float axes[][3] = {
+            { 0, 0, 1 }, { 0, 0, -1 }, { 1, 0, 0 }, { -1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 },
+            { 0.57735027f, 0.57735027f, -0.57735027f }, { -0.70710678f, 0, -0.70710678f }
+        };
+        for(const float *axis : axes) {
+            Vertex v = vertices[0];
+            memcpy(v.normal, axis, sizeof(v.normal));
+            float direction[3] = { axis[1], axis[2], axis[0] };
+            if(fabsf(dot(direction, axis)) > 0.99f)
+                direction[0] += 1.0f;
+            normalize(direction);
+            setTangent(v, direction, 1.0f);
+            vertices.push_back(v);
+        }
+        return vertices;
+    }
+
+    struct Quantized {
+        std::vector<Vertex> vertices;
+        mgp_vertex_quantization_t quantization;
+        std::vector<mgp_quantized_vertex_t> encoded;
+
+        Quantized() : vertices(makeVertices()) {
+            mgp_vertex_stream_t stream = { vertices[0].position, vertices[0].uv, vertices[0].normal,
+                                           vertices[0].tangent, sizeof(Vertex), vertices.size(), 1 };
+            mgp_vertex_quantization_make(&stream, &quantization);
+            encoded.resize(vertices.size());
+            mgp_vertex_quantize(encoded.data(), &stream, &quantization);
+        }
+    };
+
+    const Quantized &quantized() {
+        static Quantized q;
+        return q;
+    }
+}
+
+MGP_TEST(positionWithinHalfAStep) {
+    const Quantized &q = quantized();
+    float worst = 0.0f;
+    for(size_t i = 0; i < q.vertices.size(); i++) {
+        float position[3];
+        mgp_vertex_dequantize(&q.encoded[i], &q.quantization, position, NULL, NULL, NULL);
+        for(int c = 0; c < 3; c++)
+            worst = std::max(worst, fabsf(position[c] - q.vertices[i].position[c]) / q.quantization.scale[c]);
+    }
+    MGP_CHECK(worst <= 0.5f / 65535.0f + 1e-6f);
+    MGP_CHECK(q.encoded[0].position[3] == 0);
+}
+
+MGP_TEST(uvRoundsToNearestHalf) {
+    const Quantized &q = quantized();
+    bool withinHalfUlp = true;
+    for(size_t i = 0; i < q.vertices.size(); i++) {
+        float uv[2];
+        mgp_vertex_dequantize(&q.encoded[i], &q.quantization, NULL, uv, NULL, NULL);
+        for(int c = 0; c < 2; c++) {
+            float original = q.vertices[i].uv[c];
+            // half has 11 significant bits, subnormals step by 2^-24
+            float ulp = std::max(ldexpf(1.0f, ilogbf(fabsf(original)) - 10), ldexpf(1.0f, -24));
+            withinHalfUlp &= fabsf(uv[c] - original) <= ulp * 0.5f;
+        }
+    }
+    MGP_CHECK(withinHalfUlp);
+
+    Vertex v = quantized().vertices[0];
+    v.uv[0] = 1.0f;
+    v.uv[1] = -0.5f;
+    mgp_vertex_stream_t stream = { v.position, v.uv, v.normal, v.tangent, sizeof(Vertex), 1, 1 };
+    mgp_quantized_vertex_t encoded;
+    mgp_vertex_quantize(&encoded, &stream, &q.quantization);
+    MGP_CHECK(encoded.uv[0] == 0x3c00 && encoded.uv[1] == 0xb800);
+}
+
+MGP_TEST(octahedralNormalWithinBound) {
+    const Quantized &q = quantized();
+    float worst = 0.0f;
+    for(size_t i = 0; i < q.vertices.size(); i++) {
+        float normal[3];
+        mgp_vertex_dequantize(&q.encoded[i], &q.quantization, NULL, NULL, normal, NULL);
+        worst = std::max(worst, angleDegrees(normal, q.vertices[i].normal));
+        MGP_CHECK(fabsf(dot(normal, normal) - 1.0f) < 1e-5f);
+    }
+    // half a step of 2 / 32767 across the octahedron is at most ~0.0035 degrees on the sphere
+    MGP_CHECK(worst < 0.004f);
+}
+
+MGP_TEST(tangentAngleWithinBound) {
+    const Quantized &q = quantized();
+    float worst = 0.0f;
+    bool orthogonal = true;
+    bool signs = true;
+    for(size_t i = 0; i < q.vertices.size(); i++) {
+        float normal[3], tangent[4];
+        mgp_vertex_dequantize(&q.encoded[i], &q.quantization, NULL, NULL, normal, tangent);
+        // against the original tangent projected on the plane of the decoded normal
+        const float *original = q.vertices[i].tangent;
+        float d = dot(original, normal);
+        float projected[3] = { original[0] - d * normal[0], original[1] - d * normal[1], original[2] - d * normal[2] };
+        worst = std::max(worst, angleDegrees(tangent, projected));
+        orthogonal &= fabsf(dot(tangent, normal)) < 1e-4f;
+        signs &= tangent[3] == original[3];
+    }
+    // half a step of pi / 32767 is ~0.0027 degrees
+    MGP_CHECK(worst < 0.003f);
+    MGP_CHECK(orthogonal);
+    MGP_CHECK(signs);
+}
+
+// FNV-1a of the encoded vertices, the same for SSE2, F16C, NEON and scalar lanes.
+MGP_TEST(encodersGiveTheSameBits) {
+    const Quantized &q = quantized();
+    uint64_t hash = 1469598103934665603ull;
+    const uint8_t *bytes = (const uint8_t *)q.encoded.data();
+    for(size_t i = 0; i < q.encoded.size() * sizeof(mgp_quantized_vertex_t); i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    MGP_CHECK(q.encoded.size() == 19785);
+    MGP_CHECK(hash == 0x3d5add6ed014ad2bull);
+}
@@ -0,0 +1,107 @@
+//
+//  BVHBench.cpp
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/18.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#include "Bench.h"
+#include "MGPBVH.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <random>
+#include <vector>
+
+namespace {
+    // Camera at (x, 0, z) looking down +z, from 0.1 to 300.
+    void makeFrustum(mgp_cull_planes_t *planes, float fov, float x, float z) {
+        float t = tanf(fov * 0.5f);
+        float n = 1.0f / sqrtf(1.0f + t * t);
+        const float normals[6][3] = {
+            { n, 0.0f, t * n }, { -n, 0.0f, t * n }, { 0.0f, n, t * n }, { 0.0f, -n, t * n },
+            { 0.0f, 0.0f, 1.0f }, { 0.0f, 0.0f, -1.0f }
+        };
+        float equations[6][4];
+        for(int i = 0; i < 6; i++) {
+            equations[i][0] = normals[i][0];
+            equations[i][1] = normals[i][1];
+            equations[i][2] = normals[i][2];
+            equations[i][3] = -(normals[i][0] * x + normals[i][2] * z);
+        }
+        equations[4][3] = -(z + 0.1f);
+        equations[5][3] = z + 300.0f;
+        mgp_cull_planes_make(planes, equations, 6);
+    }
+
+    size_t countDifferences(const std::vector<uint64_t> &a, const std::vector<uint64_t> &b) {
+        size_t count = 0;
+        for(size_t i = 0; i < a.size(); i++)
+            count += __builtin_popcountll(a[i] ^ b[i]);
+        return count;
+    }
+}
+
+// Linear SoA culling against the BVH, and the cost of keeping the tree up to date.
+// Boxes are spread so that the frustum sees roughly the same number at every count.
+MGP_BENCHMARK(bvh) {
+    printf("%8s %8s %11s %11s %10s %13s %9s %9s %11s\n",
+           "boxes", "visible", "linear ms", "bvh ms", "build ms", "refit 5% ms",
+           "sah", "refit sah", "rebuilt sah");
+    for(size_t count : { 1000ul, 10000ul, 100000ul, 500000ul }) {
+        std::mt19937 random(1);
+        float width = powf((float)count, 1.0f / 3.0f) * 20.0f;
+        std::uniform_real_distribution<float> position(-width, width), extent(0.5f, 2.0f);
+        mgp_aabb_array_t boxes = {};
+        mgp_aabb_array_resize(&boxes, count);
+        for(size_t i = 0; i < count; i++) {
+            float c[3] = { position(random), position(random), position(random) };
+            float e[3] = { extent(random), extent(random), extent(random) };
+            mgp_aabb_array_set(&boxes, i, c, e);
+        }
+
+        mgp_bvh_t *bvh = mgp_bvh_create();
+        double build = mgp::bench::milliseconds(1, [&] { mgp_bvh_build(bvh, &boxes); });
+        mgp_cull_planes_t planes;
+        makeFrustum(&planes, 1.0f, 0.0f, -width);
+
+        std::vector<uint64_t> linearVisibility(MGP_CULL_BITSET_WORDS(count));
+        std::vector<uint64_t> bvhVisibility(linearVisibility.size());
+        size_t visible = 0;
+        int repeats = count > 100000 ? 20 : 200;
+        double linear = mgp::bench::milliseconds(repeats, [&] {
+            visible = mgp_cull_aabbs(&planes, &boxes, linearVisibility.data());
+        });
+        double tree = mgp::bench::milliseconds(repeats, [&] {
+            mgp_bvh_cull(bvh, &planes, bvhVisibility.data());
+        });
+        size_t differences = countDifferences(linearVisibility, bvhVisibility);
+
+        // move 5% of the boxes a little, as a frame of moving objects would
+        std::uniform_int_distribution<size_t> pick(0, count - 1);
+        for(size_t i = 0; i < count / 20; i++) {
+            size_t box = pick(random);
+            boxes.center_x[box] += position(random) * 0.05f;
+            boxes.center_z[box] += position(random) * 0.05f;
+        }
+        float builtCost = mgp_bvh_sah_cost(bvh);
+        double refit = mgp::bench::milliseconds(1, [&] { mgp_bvh_refit(bvh, &boxes); });
+        float refitCost = mgp_bvh_sah_cost(bvh);
+
+        mgp_cull_aabbs(&planes, &boxes, linearVisibility.data());
+        mgp_bvh_cull(bvh, &planes, bvhVisibility.data());
+        differences += countDifferences(linearVisibility, bvhVisibility);
+
+        mgp_bvh_t *rebuilt = mgp_bvh_create();
+        mgp_bvh_build(rebuilt, &boxes);
+        if(differences > 0)
+            printf("mismatch : %zu boxes differ between linear and bvh culling\n", differences);
+        printf("%8zu %8zu %11.3f %11.3f %10.2f %13.2f %9.1f %9.1f %11.1f\n",
+               count, visible, linear, tree, build, refit, builtCost, refitCost, mgp_bvh_sah_cost(rebuilt));
+
+        mgp_bvh_destroy(rebuilt);
+        mgp_bvh_destroy(bvh);
+        mgp_aabb_array_free(&boxes);
+    }
+}
@@ -0,0 +1,65 @@
+//
+//  Bench.h
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/18.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#ifndef Bench_h
+#define Bench_h
+
+// Benchmarks of the portable cores, runnable without Metal.
+// Each MGP_BENCHMARK registers itself and prints its own table.
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace mgp {
+namespace bench {
+
+typedef void (*Function)();
+
+struct Registration {
+    Registration(const char *name, Function function);
+};
+
+// Path of a file under the MetalGraphicsPlayground directory.
+std::string assetPath(const char *relativePath);
+
+// Sorted paths of the files with the extension in a directory under MetalGraphicsPlayground.
+std::vector<std::string> listFiles(const char *relativePath, const char *extension);
+
+// Average milliseconds of one of repeats runs.
+template<typename Body>
+double milliseconds(int repeats, const Body &body) {
+    auto begin = std::chrono::steady_clock::now();
+    for(int i = 0; i < repeats; i++)
+        body();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - begin).count() / repeats;
+}
+
+// Name of the SIMD path the cores were compiled with.
+inline const char *simdName() {
+#if defined(__AVX__)
+    return "AVX";
+#elif defined(__SSE2__)
+    return "SSE2";
+#elif defined(__ARM_NEON)
+    return "NEON";
+#else
+    return "scalar";
+#endif
+}
+
+} // namespace bench
+} // namespace mgp
+
+#define MGP_BENCHMARK(name) \
+    static void name##Benchmark(); \
+    static mgp::bench::Registration name##Registration(#name, name##Benchmark); \
+    static void name##Benchmark()
+
+#endif /* Bench_h */
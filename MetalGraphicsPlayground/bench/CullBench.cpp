@@ -0,0 +1,58 @@
+//
+//  CullBench.cpp
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/18.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#include "Bench.h"
+#include "MGPCulling.h"
+
+#include <stdio.h>
+#include <random>
+#include <vector>
+
+// Batched SoA box culling against the one box at a time test, on random boxes.
+MGP_BENCHMARK(cull) {
+    // a 74 degree frustum looking down +z, from 0.1 to 100
+    const float equations[6][4] = {
+        { 0.0f, 0.0f, 1.0f, -0.1f }, { 0.0f, 0.0f, -1.0f, 100.0f },
+        { 0.8f, 0.0f, 0.6f, 0.0f }, { -0.8f, 0.0f, 0.6f, 0.0f },
+        { 0.0f, 0.8f, 0.6f, 0.0f }, { 0.0f, -0.8f, 0.6f, 0.0f }
+    };
+    mgp_cull_planes_t planes;
+    mgp_cull_planes_make(&planes, equations, 6);
+
+    printf("%10s %10s %15s %15s\n", "boxes", "visible", "batched Mbox/s", "single Mbox/s");
+    std::mt19937 random(1);
+    std::uniform_real_distribution<float> position(-100.0f, 100.0f), extent(0.1f, 2.0f);
+    for(size_t count : { 10000ul, 100000ul, 1000000ul }) {
+        mgp_aabb_array_t boxes = {};
+        mgp_aabb_array_resize(&boxes, count);
+        for(size_t i = 0; i < count; i++) {
+            float c[3] = { position(random), position(random), position(random) };
+            float e[3] = { extent(random), extent(random), extent(random) };
+            mgp_aabb_array_set(&boxes, i, c, e);
+        }
+
+        std::vector<uint64_t> visibility(MGP_CULL_BITSET_WORDS(count));
+        size_t visible = 0, singleVisible = 0;
+        int repeats = (int)(20000000 / count);
+        double batched = mgp::bench::milliseconds(repeats, [&] {
+            visible = mgp_cull_aabbs(&planes, &boxes, visibility.data());
+        });
+        double single = mgp::bench::milliseconds(repeats / 4 + 1, [&] {
+            singleVisible = 0;
+            for(size_t i = 0; i < count; i++) {
+                float c[3] = { boxes.center_x[i], boxes.center_y[i], boxes.center_z[i] };
+                float e[3] = { boxes.extent_x[i], boxes.extent_y[i], boxes.extent_z[i] };
+                singleVisible += mgp_cull_aabb_is_visible(&planes, c, e);
+            }
+        });
+        if(visible != singleVisible)
+            printf("mismatch : %zu visible batched, %zu single\n", visible, singleVisible);
+        printf("%10zu %10zu %15.1f %15.1f\n", count, visible, count / batched / 1e3, count / single / 1e3);
+        mgp_aabb_array_free(&boxes);
+    }
+}
@@ -0,0 +1,106 @@
+//
+//  DDSBench.cpp
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/18.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#include "Bench.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <string>
+#include <vector>
+
+namespace {
+    // Offset of the surface data, 0 if the file isn't a DDS file.
+    size_t ddsDataOffset(const uint8_t *bytes, size_t size) {
+        if(size < 128 || memcmp(bytes, "DDS ", 4) != 0)
+            return 0;
+        bool dx10 = memcmp(bytes + 84, "DX10", 4) == 0;
+        return dx10 ? (size >= 148 ? 148 : 0) : 128;
+    }
+
+    // DDSTextureFile before : fread into a heap copy, then a copy into texture memory.
+    uint64_t readAndCopy(const std::string &path) {
+        FILE *file = fopen(path.c_str(), "rb");
+        if(file == nullptr)
+            return 0;
+        fseek(file, 0, SEEK_END);
+        size_t size = ftell(file);
+        fseek(file, 0, SEEK_SET);
+        std::vector<uint8_t> bytes(size);
+        size_t read = fread(bytes.data(), 1, size, file);
+        fclose(file);
+        size_t offset = ddsDataOffset(bytes.data(), read);
+        if(read != size || offset == 0)
+            return 0;
+        std::vector<uint8_t> texture(bytes.begin() + offset, bytes.end());
+        return texture[texture.size() / 2];
+    }
+
+    // mode 1 : the managed path, copied from the mapping into texture memory
+    // mode 2 : the private path, the mapping is read in place (one touch per page
+    //          stands in for the blit reading the no-copy buffer)
+    uint64_t mapFile(const std::string &path, int mode) {
+        int fd = open(path.c_str(), O_RDONLY);
+        if(fd < 0)
+            return 0;
+        struct stat status;
+        fstat(fd, &status);
+        size_t size = status.st_size;
+        void *mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if(mapping == MAP_FAILED)
+            return 0;
+        madvise(mapping, size, MADV_SEQUENTIAL);
+        madvise(mapping, size, MADV_WILLNEED);
+
+        const uint8_t *bytes = (const uint8_t *)mapping;
+        size_t offset = ddsDataOffset(bytes, size);
+        uint64_t sum = 0;
+        if(offset > 0 && mode == 1) {
+            std::vector<uint8_t> texture(bytes + offset, bytes + size);
+            sum = texture[texture.size() / 2];
+        }
+        else if(offset > 0) {
+            for(size_t i = offset; i < size; i += 4096)
+                sum += bytes[i];
+        }
+        munmap(mapping, size);
+        return sum;
+    }
+}
+
+// CPU side of loading the bundled Sponza DDS set, warm page cache.
+MGP_BENCHMARK(dds) {
+    std::vector<std::string> files = mgp::bench::listFiles("Common/Assets/Textures/Sponza", ".dds");
+    if(files.empty()) {
+        printf("no DDS files found\n");
+        return;
+    }
+    size_t totalSize = 0;
+    for(const std::string &file : files) {
+        struct stat status;
+        if(stat(file.c_str(), &status) == 0)
+            totalSize += status.st_size;
+    }
+    printf("%zu files, %.1f MB, average of 5 passes after a warm-up\n", files.size(), totalSize / 1048576.0);
+
+    const char *names[] = { "fread + copy into texture memory", "mmap + copy (managed path)", "mmap, read in place (private path)" };
+    volatile uint64_t sink = 0;
+    for(int mode = 0; mode < 3; mode++) {
+        auto pass = [&] {
+            for(const std::string &file : files)
+                sink = sink + (mode == 0 ? readAndCopy(file) : mapFile(file, mode));
+        };
+        pass();
+        printf("%-36s %8.2f ms/pass\n", names[mode], mgp::bench::milliseconds(5, pass));
+    }
+}
@@ -0,0 +1,70 @@
+//
+//  DrawSortBench.cpp
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/18.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#include "Bench.h"
+#include "MGPDrawSort.h"
+
+#include <stdio.h>
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+
+// 100k draw keys, radix sorted with their values against std::sort and
+// std::stable_sort of key/value pairs. Draw keys as the renderer makes them
+// leave most bytes constant, random keys need every pass.
+MGP_BENCHMARK(draw_sort) {
+    const size_t count = 100000;
+    const int repeats = 20;
+    std::mt19937_64 random(1);
+    std::vector<uint64_t> drawKeys(count), randomKeys(count);
+    for(size_t i = 0; i < count; i++) {
+        const void *texture = (const void *)(uintptr_t)(0x1000 + random() % 64 * 64);
+        drawKeys[i] = mgp_draw_key_make(random() % 3, random() % 16, mgp_draw_key_hash(&texture, 1, 16),
+                                        random() % 500, mgp_draw_key_depth((float)(random() % 10000), 10000.0f));
+        randomKeys[i] = random();
+    }
+
+    printf("%-12s %10s %14s %17s %9s\n", "keys", "radix ms", "std::sort ms", "stable_sort ms", "speedup");
+    const std::pair<const char *, const std::vector<uint64_t> *> inputs[] = {
+        { "draw keys", &drawKeys }, { "random", &randomKeys }
+    };
+    for(const auto &input : inputs) {
+        std::vector<uint64_t> keys(count), tempKeys(count);
+        std::vector<uint32_t> values(count), tempValues(count);
+        double radix = 0.0;
+        for(int r = 0; r < repeats; r++) {
+            keys = *input.second;
+            for(size_t i = 0; i < count; i++)
+                values[i] = (uint32_t)i;
+            radix += mgp::bench::milliseconds(1, [&] {
+                mgp_draw_keys_sort(keys.data(), values.data(), tempKeys.data(), tempValues.data(), count);
+            });
+        }
+
+        std::vector<std::pair<uint64_t, uint32_t>> pairs(count);
+        double sort = 0.0, stableSort = 0.0;
+        for(int r = 0; r < repeats; r++) {
+            for(size_t i = 0; i < count; i++)
+                pairs[i] = { (*input.second)[i], (uint32_t)i };
+            sort += mgp::bench::milliseconds(1, [&] {
+                std::sort(pairs.begin(), pairs.end());
+            });
+            for(size_t i = 0; i < count; i++)
+                pairs[i] = { (*input.second)[i], (uint32_t)i };
+            stableSort += mgp::bench::milliseconds(1, [&] {
+                std::stable_sort(pairs.begin(), pairs.end(),
+                                 [](const std::pair<uint64_t, uint32_t> &a, const std::pair<uint64_t, uint32_t> &b) {
+                    return a.first < b.first;
+                });
+            });
+        }
+        printf("%-12s %10.3f %14.3f %17.3f %8.1fx\n", input.first, radix / repeats, sort / repeats,
+               stableSort / repeats, stableSort / radix);
+    }
+}
@@ -0,0 +1,153 @@
+//
+//  ObjBench.cpp
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/18.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#include "Bench.h"
+#include "MGPObjImporter.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace {
+    // Writes objects of segments x segments quads with v/vt/vn, every other one
+    // with negative indices, one material per object. Returns the file size.
+    size_t writeSyntheticObj(const char *path, int numObjects, int segments) {
+        FILE *file = fopen(path, "wb");
+        if(file == nullptr)
+            return 0;
+        int numVertices = 0;
+        for(int o = 0; o < numObjects; o++) {
+            fprintf(file, "o object%d\nusemtl material%d\n", o, o % 4);
+            for(int y = 0; y <= segments; y++) {
+                for(int x = 0; x <= segments; x++) {
+                    float u = (float)x / segments, v = (float)y / segments;
+                    float height = 0.1f * sinf(u * 20.0f + o) * cosf(v * 20.0f);
+                    fprintf(file, "v %.6f %.6f %.6f\n", u * 10.0f + o * 11.0f, height, v * 10.0f);
+                    fprintf(file, "vt %.6f %.6f\n", u, v);
+                    fprintf(file, "vn %.6f %.6f %.6f\n", -height, 0.995f, height * 0.5f);
+                }
+            }
+            bool negative = o % 2 == 1;
+            int rowSize = segments + 1;
+            int count = rowSize * rowSize;
+            for(int y = 0; y < segments; y++) {
+                for(int x = 0; x < segments; x++) {
+                    int corners[4] = { y * rowSize + x, y * rowSize + x + 1, (y + 1) * rowSize + x + 1, (y + 1) * rowSize + x };
+                    fprintf(file, "f");
+                    for(int corner : corners) {
+                        int index = negative ? corner - count : numVertices + corner + 1;
+                        fprintf(file, " %d/%d/%d", index, index, index);
+                    }
+                    fprintf(file, "\n");
+                }
+            }
+            numVertices += count;
+        }
+        size_t size = ftell(file);
+        fclose(file);
+        return size;
+    }
+
+    struct NaiveModel {
+        size_t numVertices = 0;
+        size_t numIndices = 0;
+    };
+
+    // fgets + sscanf + std::map, how an importer is usually written first.
+    NaiveModel loadNaively(const char *path) {
+        NaiveModel model;
+        FILE *file = fopen(path, "r");
+        if(file == nullptr)
+            return model;
+        std::vector<float> positions, uvs, normals;
+        std::map<std::tuple<int, int, int>, uint32_t> corners;
+        std::vector<uint32_t> indices, polygon;
+        char line[1024];
+        while(fgets(line, sizeof(line), file)) {
+            float a, b, c;
+            if(strncmp(line, "v ", 2) == 0 && sscanf(line + 2, "%f %f %f", &a, &b, &c) == 3)
+                positions.insert(positions.end(), { a, b, c });
+            else if(strncmp(line, "vt ", 3) == 0 && sscanf(line + 3, "%f %f", &a, &b) == 2)
+                uvs.insert(uvs.end(), { a, b });
+            else if(strncmp(line, "vn ", 3) == 0 && sscanf(line + 3, "%f %f %f", &a, &b, &c) == 3)
+                normals.insert(normals.end(), { a, b, c });
+            else if(strncmp(line, "f ", 2) == 0) {
+                polygon.clear();
+                for(char *token = strtok(line + 1, " \t\r\n"); token; token = strtok(nullptr, " \t\r\n")) {
+                    int p = 0, t = 0, n = 0;
+                    sscanf(token, "%d/%d/%d", &p, &t, &n);
+                    if(p < 0) p += (int)positions.size() / 3 + 1;
+                    if(t < 0) t += (int)uvs.size() / 2 + 1;
+                    if(n < 0) n += (int)normals.size() / 3 + 1;
+                    auto corner = corners.emplace(std::make_tuple(p, t, n), (uint32_t)corners.size()).first;
+                    polygon.push_back(corner->second);
+                }
+                for(size_t i = 1; i + 1 < polygon.size(); i++)
+                    indices.insert(indices.end(), { polygon[0], polygon[i], polygon[i + 1] });
+            }
+        }
+        fclose(file);
+        model.numVertices = corners.size();
+        model.numIndices = indices.size();
+        return model;
+    }
+
+    size_t fileSize(const char *path) {
+        FILE *file = fopen(path, "rb");
+        if(file == nullptr)
+            return 0;
+        fseek(file, 0, SEEK_END);
+        size_t size = ftell(file);
+        fclose(file);
+        return size;
+    }
+}
+
+// mgp_obj_load on the bundled models and on a 66 MB synthetic file standing in
+// for sponza.obj, which isn't in the tree, against a naive importer.
+MGP_BENCHMARK(obj) {
+    const char *syntheticPath = "mgp_bench_synthetic.obj";
+    writeSyntheticObj(syntheticPath, 10, 200);
+
+    std::string bundled[] = {
+        mgp::bench::assetPath("MetalTextureLOD/teapot.obj"),
+        mgp::bench::assetPath("MetalShadowMapping/lego.obj"),
+        mgp::bench::assetPath("MetalEnvironmentMapping/bun_zipper_res3.obj"),
+        syntheticPath
+    };
+    printf("%-24s %8s %10s %8s %10s %10s %10s\n", "file", "MB", "ms", "MB/s", "vertices", "indices", "naive ms");
+    for(const std::string &path : bundled) {
+        size_t size = fileSize(path.c_str());
+        int repeats = size > (16 << 20) ? 3 : 10;
+        mgp_obj_model_t *model = nullptr;
+        char error[256] = {};
+        double time = mgp::bench::milliseconds(repeats, [&] {
+            if(model)
+                mgp_obj_destroy(model);
+            model = mgp_obj_load(path.c_str(), 0, error, sizeof(error));
+        });
+        const char *name = strrchr(path.c_str(), '/') ? strrchr(path.c_str(), '/') + 1 : path.c_str();
+        if(model == nullptr) {
+            printf("%-24s failed : %s\n", name, error);
+            continue;
+        }
+
+        NaiveModel naive;
+        double naiveTime = mgp::bench::milliseconds(1, [&] { naive = loadNaively(path.c_str()); });
+        if(naive.numIndices != model->numIndices)
+            printf("mismatch : %zu indices, %zu naively\n", model->numIndices, naive.numIndices);
+        printf("%-24s %8.2f %10.2f %8.0f %10zu %10zu %10.1f\n", name, size / 1e6, time, size / 1e3 / time,
+               model->numVertices, model->numIndices, naiveTime);
+        mgp_obj_destroy(model);
+    }
+    remove(syntheticPath);
+}
@@ -0,0 +1,127 @@
+//
+//  OcclusionBench.cpp
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/18.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#include "Bench.h"
+#include "MGPOcclusionCulling.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+    struct Occluder {
+        std::vector<float> vertices;
+        std::vector<uint32_t> indices;
+    };
+
+    // unit cube, 12 triangles
+    Occluder makeCube() {
+        Occluder cube;
+        for(int i = 0; i < 8; i++) {
+            cube.vertices.push_back(i & 1 ? 1.0f : -1.0f);
+            cube.vertices.push_back(i & 2 ? 1.0f : -1.0f);
+            cube.vertices.push_back(i & 4 ? 1.0f : -1.0f);
+        }
+        const uint32_t faces[6][4] = { { 0, 1, 3, 2 }, { 4, 6, 7, 5 }, { 0, 4, 5, 1 }, { 2, 3, 7, 6 }, { 0, 2, 6, 4 }, { 1, 5, 7, 3 } };
+        for(const uint32_t *face : faces)
+            cube.indices.insert(cube.indices.end(), { face[0], face[1], face[2], face[0], face[2], face[3] });
+        return cube;
+    }
+
+    // [-1, 1] square on z = 0, split into segments x segments quads
+    Occluder makeGrid(uint32_t segments) {
+        Occluder grid;
+        for(uint32_t y = 0; y <= segments; y++) {
+            for(uint32_t x = 0; x <= segments; x++) {
+                grid.vertices.push_back(x * 2.0f / segments - 1.0f);
+                grid.vertices.push_back(y * 2.0f / segments - 1.0f);
+                grid.vertices.push_back(0.0f);
+            }
+        }
+        for(uint32_t y = 0; y < segments; y++) {
+            for(uint32_t x = 0; x < segments; x++) {
+                uint32_t i = y * (segments + 1) + x;
+                grid.indices.insert(grid.indices.end(), { i, i + 1, i + segments + 2, i, i + segments + 2, i + segments + 1 });
+            }
+        }
+        return grid;
+    }
+}
+
+// 2000 random cubes and 4 dense walls rasterized into the 256x128 buffer
+// the renderer uses, then 100k boxes behind them tested against it.
+MGP_BENCHMARK(occlusion) {
+    const float near = 0.1f, far = 1000.0f, aspect = 16.0f / 9.0f;
+    const float fy = 1.0f / tanf(0.5f);
+    const float projection[16] = {
+        fy / aspect, 0.0f, 0.0f, 0.0f,
+        0.0f, fy, 0.0f, 0.0f,
+        0.0f, 0.0f, far / (far - near), 1.0f,
+        0.0f, 0.0f, -near * far / (far - near), 0.0f
+    };
+    Occluder cube = makeCube();
+    Occluder wall = makeGrid(64);
+
+    std::mt19937 random(3);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    const size_t boxCount = 100000;
+    mgp_aabb_array_t boxes = {};
+    mgp_aabb_array_resize(&boxes, boxCount);
+    for(size_t i = 0; i < boxCount; i++) {
+        float c[3] = { unit(random) * 60.0f, unit(random) * 30.0f, 50.0f + unit(random) * 45.0f };
+        float e[3] = { 0.5f, 0.5f, 0.5f };
+        mgp_aabb_array_set(&boxes, i, c, e);
+    }
+    std::vector<uint64_t> visibility(MGP_CULL_BITSET_WORDS(boxCount));
+
+    printf("%8s %10s %14s %12s %10s\n", "threads", "triangles", "rasterize ms", "test ms", "visible");
+    uint32_t hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    for(uint32_t numThreads : { 1u, hardwareThreads }) {
+        mgp_occlusion_t *occlusion = mgp_occlusion_create(256, 128, numThreads);
+        const int repeats = 20;
+        double rasterize = 0.0, test = 0.0;
+        size_t triangles = 0, visible = 0;
+        for(int r = 0; r < repeats; r++) {
+            mgp_occlusion_begin(occlusion, projection);
+            triangles = 0;
+            std::mt19937 placement(7);
+            for(int i = 0; i < 2000; i++) {
+                float s = 0.5f + (unit(placement) + 1.0f) * 1.5f;
+                float model[16] = {
+                    s, 0.0f, 0.0f, 0.0f, 0.0f, s, 0.0f, 0.0f, 0.0f, 0.0f, s, 0.0f,
+                    unit(placement) * 40.0f, unit(placement) * 20.0f, 15.0f + (unit(placement) + 1.0f) * 10.0f, 1.0f
+                };
+                if(mgp_occlusion_add_occluder(occlusion, cube.vertices.data(), cube.indices.data(), 12, model))
+                    triangles += 12;
+            }
+            for(int i = 0; i < 4; i++) {
+                float model[16] = { 8.0f, 0.0f, 0.0f, 0.0f, 0.0f, 8.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f,
+                                    -24.0f + i * 16.0f, -4.0f, 40.0f, 1.0f };
+                size_t wallTriangles = wall.indices.size() / 3;
+                if(mgp_occlusion_add_occluder(occlusion, wall.vertices.data(), wall.indices.data(), wallTriangles, model))
+                    triangles += wallTriangles;
+            }
+            rasterize += mgp::bench::milliseconds(1, [&] { mgp_occlusion_rasterize(occlusion); });
+
+            std::fill(visibility.begin(), visibility.end(), ~0ull);
+            if(boxCount % 64)
+                visibility.back() = (1ull << (boxCount % 64)) - 1;
+            test += mgp::bench::milliseconds(1, [&] {
+                visible = mgp_occlusion_cull_aabbs(occlusion, &boxes, visibility.data());
+            });
+        }
+        printf("%8u %10zu %14.3f %12.3f %10zu\n", numThreads, triangles, rasterize / repeats, test / repeats, visible);
+        mgp_occlusion_destroy(occlusion);
+        if(hardwareThreads == 1)
+            break;
+    }
+    mgp_aabb_array_free(&boxes);
+}
@@ -0,0 +1,230 @@
+//
+//  SimplifierBench.cpp
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/18.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#include "Bench.h"
+#include "MGPMeshSimplifier.h"
+#include "MGPObjImporter.h"
+
+#include <float.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace {
+    // same settings as MGPMesh
+    const int kMaxLODs = 4;
+    const float kTriangleRatio = 0.5f;
+    const float kTargetError = 0.05f;
+    const float kMaxTriangleRatio = 0.8f;
+    const size_t kMinTriangles = 256;
+    const float kAttributeWeights[5] = { 1.0f, 1.0f, 0.5f, 0.5f, 0.5f };
+
+    struct Vector {
+        float x, y, z;
+    };
+
+    Vector operator-(Vector a, Vector b) { return { a.x - b.x, a.y - b.y, a.z - b.z }; }
+    Vector operator+(Vector a, Vector b) { return { a.x + b.x, a.y + b.y, a.z + b.z }; }
+    Vector operator*(Vector a, float s) { return { a.x * s, a.y * s, a.z * s }; }
+    float dot(Vector a, Vector b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+    float length(Vector a) { return sqrtf(dot(a, a)); }
+
+    // Closest point on a triangle (Ericson, Real-Time Collision Detection 5.1.5).
+    float distanceToTriangle(Vector p, Vector a, Vector b, Vector c) {
+        Vector ab = b - a, ac = c - a, ap = p - a;
+        float d1 = dot(ab, ap), d2 = dot(ac, ap);
+        if(d1 <= 0.0f && d2 <= 0.0f)
+            return length(p - a);
+        Vector bp = p - b;
+        float d3 = dot(ab, bp), d4 = dot(ac, bp);
+        if(d3 >= 0.0f && d4 <= d3)
+            return length(p - b);
+        float vc = d1 * d4 - d3 * d2;
+        if(vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f)
+            return length(p - (a + ab * (d1 / (d1 - d3))));
+        Vector cp = p - c;
+        float d5 = dot(ab, cp), d6 = dot(ac, cp);
+        if(d6 >= 0.0f && d5 <= d6)
+            return length(p - c);
+        float vb = d5 * d2 - d1 * d6;
+        if(vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f)
+            return length(p - (a + ac * (d2 / (d2 - d6))));
+        float va = d3 * d6 - d5 * d4;
+        if(va <= 0.0f && d4 - d3 >= 0.0f && d5 - d6 >= 0.0f)
+            return length(p - (b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)))));
+        float denominator = 1.0f / (va + vb + vc);
+        return length(p - (a + ab * (vb * denominator) + ac * (vc * denominator)));
+    }
+
+    Vector position(const mgp_obj_vertex_t &vertex) {
+        return { vertex.position[0], vertex.position[1], vertex.position[2] };
+    }
+
+    // Farthest distance of sampled original vertices to the simplified surface.
+    float surfaceDistance(const mgp_obj_vertex_t *vertices, size_t vertexCount,
+                          const std::vector<uint32_t> &indices) {
+        float farthest = 0.0f;
+        size_t step = std::max<size_t>(1, vertexCount / 1000);
+        for(size_t v = 0; v < vertexCount; v += step) {
+            Vector p = position(vertices[v]);
+            float closest = FLT_MAX;
+            for(size_t i = 0; i + 2 < indices.size(); i += 3)
+                closest = std::min(closest, distanceToTriangle(p, position(vertices[indices[i]]),
+                                                               position(vertices[indices[i + 1]]),
+                                                               position(vertices[indices[i + 2]])));
+            farthest = std::max(farthest, closest);
+        }
+        return farthest;
+    }
+
+    // Builds the LOD chain as MGPMesh does, submeshes one after another, and
+    // prints a row per LOD.
+    void buildChain(const char *name, const mgp_obj_vertex_t *vertices, size_t vertexCount,
+                    std::vector<std::vector<uint32_t>> submeshes) {
+        std::vector<uint32_t> allIndices;
+        std::vector<size_t> counts;
+        for(const std::vector<uint32_t> &submesh : submeshes) {
+            allIndices.insert(allIndices.end(), submesh.begin(), submesh.end());
+            counts.push_back(submesh.size());
+        }
+        size_t triangleCount = allIndices.size() / 3;
+        if(triangleCount < kMinTriangles)
+            return;
+
+        float lower[3] = { FLT_MAX, FLT_MAX, FLT_MAX }, upper[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+        for(size_t v = 0; v < vertexCount; v++) {
+            for(int c = 0; c < 3; c++) {
+                lower[c] = std::min(lower[c], vertices[v].position[c]);
+                upper[c] = std::max(upper[c], vertices[v].position[c]);
+            }
+        }
+        float extent = std::max(upper[0] - lower[0], std::max(upper[1] - lower[1], upper[2] - lower[2]));
+
+        std::vector<unsigned char> vertexLock(vertexCount, 0);
+        double lockTime = mgp::bench::milliseconds(1, [&] {
+            mgp_mesh_simplify_lock_submesh_borders(vertexLock.data(), allIndices.data(), counts.data(), counts.size(),
+                                                   vertices[0].position, sizeof(mgp_obj_vertex_t), vertexCount);
+        });
+        mgp_mesh_simplify_vertices_t simplifyVertices = {
+            vertices[0].position, sizeof(mgp_obj_vertex_t),
+            vertices[0].uv, sizeof(mgp_obj_vertex_t),   // uv and normal follow each other
+            kAttributeWeights, 5, vertexCount, vertexLock.data()
+        };
+
+        float chainError = 0.0f;
+        size_t previousCount = triangleCount;
+        for(int lod = 1; lod < kMaxLODs; lod++) {
+            std::vector<std::vector<uint32_t>> simplified(submeshes.size());
+            float error = 0.0f;
+            size_t count = 0;
+            double time = mgp::bench::milliseconds(1, [&] {
+                for(size_t s = 0; s < submeshes.size(); s++) {
+                    const std::vector<uint32_t> &indices = submeshes[s];
+                    size_t targetIndexCount = (size_t)(indices.size() / 3 * kTriangleRatio) * 3;
+                    float submeshError = 0.0f;
+                    simplified[s].resize(indices.size());
+                    simplified[s].resize(mgp_mesh_simplify(simplified[s].data(), indices.data(), indices.size(),
+                                                           &simplifyVertices, targetIndexCount, kTargetError,
+                                                           &submeshError));
+                    error = std::max(error, submeshError);
+                    count += simplified[s].size() / 3;
+                }
+            });
+            if(count > previousCount * kMaxTriangleRatio)
+                break;
+
+            std::vector<uint32_t> lodIndices;
+            bool lockedKept = true;
+            for(size_t s = 0; s < submeshes.size(); s++) {
+                lodIndices.insert(lodIndices.end(), simplified[s].begin(), simplified[s].end());
+                for(uint32_t index : submeshes[s]) {
+                    if(vertexLock[index])
+                        lockedKept &= std::find(simplified[s].begin(), simplified[s].end(), index) != simplified[s].end();
+                }
+            }
+            chainError += error;
+            printf("%-36s %3d %9zu %7.1f%% %9.2f %9.4f %9.4f %9.4f %7s\n", lod == 1 ? name : "", lod, count,
+                   100.0 * count / triangleCount, time + (lod == 1 ? lockTime : 0.0), error, chainError,
+                   surfaceDistance(vertices, vertexCount, lodIndices) / extent, lockedKept ? "yes" : "NO");
+            submeshes.swap(simplified);
+            previousCount = count;
+        }
+    }
+
+    void buildChains(const char *relativePath) {
+        char error[256] = {};
+        mgp_obj_model_t *model = mgp_obj_load(mgp::bench::assetPath(relativePath).c_str(), 1, error, sizeof(error));
+        if(model == nullptr) {
+            printf("%s : %s\n", relativePath, error);
+            return;
+        }
+        const char *fileName = strrchr(relativePath, '/') ? strrchr(relativePath, '/') + 1 : relativePath;
+        for(uint32_t o = 0; o < model->numObjects; o++) {
+            const mgp_obj_object_t &object = model->objects[o];
+            std::vector<std::vector<uint32_t>> submeshes;
+            for(uint32_t s = object.submeshStart; s < object.submeshStart + object.submeshCount; s++) {
+                const uint32_t *indices = model->indices + model->submeshes[s].indexStart;
+                submeshes.emplace_back(indices, indices + model->submeshes[s].indexCount);
+            }
+            std::string name = std::string(fileName) + "/" + object.name;
+            buildChain(name.c_str(), model->vertices + object.vertexStart, object.vertexCount, submeshes);
+        }
+        mgp_obj_destroy(model);
+    }
+
+    // 201 x 201 heightfield of 80k triangles in two submeshes split at x = 100,
+    // with a uv seam at x = 150 so both borders and seams are in the way.
+    void buildGridChain() {
+        const int size = 201, seam = 150;
+        std::vector<mgp_obj_vertex_t> vertices;
+        std::vector<uint32_t> ids(size * size), seamIds(size);
+        for(int y = 0; y < size; y++) {
+            for(int x = 0; x < size; x++) {
+                mgp_obj_vertex_t vertex = {};
+                vertex.position[0] = x / (float)(size - 1);
+                vertex.position[1] = y / (float)(size - 1);
+                vertex.position[2] = 0.05f * sinf(x * 0.07f) * cosf(y * 0.05f);
+                vertex.uv[0] = x < seam ? x / (float)seam : (x - seam) / (float)(size - 1 - seam);
+                vertex.uv[1] = y / (float)(size - 1);
+                vertex.normal[2] = 1.0f;
+                ids[y * size + x] = (uint32_t)vertices.size();
+                vertices.push_back(vertex);
+                if(x == seam) {
+                    vertex.uv[0] = 1.0f;
+                    seamIds[y] = (uint32_t)vertices.size();
+                    vertices.push_back(vertex);
+                }
+            }
+        }
+        std::vector<std::vector<uint32_t>> submeshes(2);
+        for(int y = 0; y < size - 1; y++) {
+            for(int x = 0; x < size - 1; x++) {
+                // quads left of the seam use its copy with u = 1
+                auto id = [&](int cx, int cy) { return cx == seam && x < seam ? seamIds[cy] : ids[cy * size + cx]; };
+                uint32_t a = id(x, y), b = id(x + 1, y), c = id(x + 1, y + 1), d = id(x, y + 1);
+                submeshes[x < 100 ? 0 : 1].insert(submeshes[x < 100 ? 0 : 1].end(), { a, b, c, a, c, d });
+            }
+        }
+        buildChain("grid 201x201, 2 submeshes", vertices.data(), vertices.size(), submeshes);
+    }
+}
+
+// LOD chains of the bundled models and of a large grid with submesh borders and
+// a uv seam. Errors and distances are relative to the largest extent, ms is
+// single-threaded where MGPMesh runs submeshes in parallel.
+MGP_BENCHMARK(simplifier) {
+    printf("%-36s %3s %9s %8s %9s %9s %9s %9s %7s\n", "mesh", "lod", "triangles", "of lod0", "ms",
+           "error", "chain", "distance", "locked");
+    buildChains("MetalTextureLOD/teapot.obj");
+    buildChains("MetalShadowMapping/lego.obj");
+    buildChains("MetalEnvironmentMapping/bun_zipper_res3.obj");
+    buildGridChain();
+}
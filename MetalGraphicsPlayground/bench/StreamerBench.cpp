@@ -0,0 +1,106 @@
+//
+//  StreamerBench.cpp
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/18.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#include "Bench.h"
+#include "MGPTextureStreamer.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    // Reads a DDS file and checks its magic, standing in for the staging texture decode.
+    void *decodeDDS(void *, void *request) {
+        FILE *file = fopen((const char *)request, "rb");
+        if(file == nullptr)
+            return nullptr;
+        fseek(file, 0, SEEK_END);
+        long size = ftell(file);
+        fseek(file, 0, SEEK_SET);
+        std::vector<uint8_t> *image = new std::vector<uint8_t>(size);
+        bool valid = fread(image->data(), 1, size, file) == (size_t)size &&
+                     size >= 128 && memcmp(image->data(), "DDS ", 4) == 0;
+        fclose(file);
+        if(!valid) {
+            delete image;
+            return nullptr;
+        }
+        return image;
+    }
+
+    struct Uploads {
+        size_t numTextures = 0;
+        size_t numBytes = 0;
+    };
+
+    // The null backend : nothing goes to a GPU, images are dropped.
+    void uploadBatch(void *context, void *const *, void *const *images, size_t count) {
+        Uploads *uploads = (Uploads *)context;
+        for(size_t i = 0; i < count; i++) {
+            std::vector<uint8_t> *image = (std::vector<uint8_t> *)images[i];
+            if(image == nullptr)
+                continue;
+            uploads->numTextures++;
+            uploads->numBytes += image->size();
+            delete image;
+        }
+    }
+}
+
+// The bundled Sponza DDS set, enqueued 10 times, through a null upload backend.
+MGP_BENCHMARK(streamer) {
+    std::vector<std::string> files = mgp::bench::listFiles("Common/Assets/Textures/Sponza", ".dds");
+    if(files.empty()) {
+        printf("no DDS files found\n");
+        return;
+    }
+    const int repeats = 10;
+
+    Uploads serial;
+    double serialTime = mgp::bench::milliseconds(1, [&] {
+        for(int r = 0; r < repeats; r++) {
+            for(const std::string &file : files) {
+                void *image = decodeDDS(nullptr, (void *)file.c_str());
+                uploadBatch(&serial, nullptr, &image, 1);
+            }
+        }
+    });
+    printf("%zu textures, %.1f MB\n", serial.numTextures, serial.numBytes / 1048576.0);
+    printf("%8s %8s %10s %10s\n", "threads", "batch", "batches", "ms");
+    printf("%8s %8s %10zu %10.1f\n", "serial", "-", serial.numTextures, serialTime);
+
+    uint32_t hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    for(uint32_t numThreads : { 1u, hardwareThreads }) {
+        for(uint32_t batchSize : { 1u, 8u, 0u }) {
+            Uploads uploads;
+            mgp_texture_streamer_backend_t backend = { decodeDDS, uploadBatch, &uploads };
+            mgp_texture_streamer_stats_t stats;
+            double time = mgp::bench::milliseconds(1, [&] {
+                mgp_texture_streamer_t *streamer = mgp_texture_streamer_create(&backend, numThreads, batchSize);
+                for(int r = 0; r < repeats; r++) {
+                    for(const std::string &file : files)
+                        mgp_texture_streamer_enqueue(streamer, (void *)file.c_str());
+                }
+                mgp_texture_streamer_wait_idle(streamer);
+                mgp_texture_streamer_get_stats(streamer, &stats);
+                mgp_texture_streamer_destroy(streamer);
+            });
+            if(uploads.numTextures != serial.numTextures || stats.numFailed > 0)
+                printf("mismatch : %zu textures uploaded, %llu failed\n",
+                       uploads.numTextures, (unsigned long long)stats.numFailed);
+            char batch[16];
+            snprintf(batch, sizeof(batch), batchSize ? "%u" : "all", batchSize);
+            printf("%8u %8s %10llu %10.1f\n", numThreads, batch, (unsigned long long)stats.numBatches, time);
+        }
+        if(hardwareThreads == 1)
+            break;
+    }
+}
@@ -0,0 +1,137 @@
+//
+//  TangentSpaceBench.cpp
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/18.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#include "Bench.h"
+#include "TangentSpaceBench.h"
+#include "MGPTangentSpace.h"
+
+#include <math.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+namespace {
+    // same as MGPMesh
+    const float kNormalCreaseThreshold = 0.2f;
+
+    const mgp_tangent_space_layout_t kLayout = {
+        sizeof(mgp_obj_vertex_t),
+        offsetof(mgp_obj_vertex_t, position),
+        offsetof(mgp_obj_vertex_t, uv),
+        offsetof(mgp_obj_vertex_t, normal),
+        offsetof(mgp_obj_vertex_t, tangent),
+        0
+    };
+
+    void appendModel(std::vector<mgp::bench::TangentSpaceMesh> &meshes, const char *relativePath) {
+        char error[256] = {};
+        mgp_obj_model_t *model = mgp_obj_load(mgp::bench::assetPath(relativePath).c_str(), 0, error, sizeof(error));
+        if(model == nullptr) {
+            printf("%s : %s\n", relativePath, error);
+            return;
+        }
+        mgp::bench::TangentSpaceMesh mesh;
+        mesh.name = strrchr(relativePath, '/') ? strrchr(relativePath, '/') + 1 : relativePath;
+        mesh.vertices.assign(model->vertices, model->vertices + model->numVertices);
+        mesh.indices.assign(model->indices, model->indices + model->numIndices);
+        // indices of objects start at their own vertices
+        for(uint32_t o = 0; o < model->numObjects; o++) {
+            const mgp_obj_object_t &object = model->objects[o];
+            for(uint32_t s = object.submeshStart; s < object.submeshStart + object.submeshCount; s++) {
+                const mgp_obj_submesh_t &submesh = model->submeshes[s];
+                for(uint32_t i = submesh.indexStart; i < submesh.indexStart + submesh.indexCount; i++)
+                    mesh.indices[i] += object.vertexStart;
+            }
+        }
+        mgp_obj_destroy(model);
+        meshes.push_back(std::move(mesh));
+    }
+
+    // size x size heightfield with ridges sharp enough to crease, and a uv
+    // mirrored at the middle so tangents split there.
+    mgp::bench::TangentSpaceMesh makeTerrain(int size) {
+        mgp::bench::TangentSpaceMesh mesh;
+        mesh.name = "terrain " + std::to_string(size) + "x" + std::to_string(size);
+        for(int y = 0; y < size; y++) {
+            for(int x = 0; x < size; x++) {
+                mgp_obj_vertex_t vertex = {};
+                float u = x / (float)(size - 1), v = y / (float)(size - 1);
+                vertex.position[0] = u * 100.0f;
+                vertex.position[1] = 4.0f * fabsf(sinf(u * 17.0f)) * cosf(v * 11.0f) + sinf(u * 3.0f + v * 5.0f);
+                vertex.position[2] = v * 100.0f;
+                vertex.uv[0] = fabsf(u * 2.0f - 1.0f) * 8.0f;
+                vertex.uv[1] = v * 8.0f;
+                mesh.vertices.push_back(vertex);
+            }
+        }
+        for(int y = 0; y < size - 1; y++) {
+            for(int x = 0; x < size - 1; x++) {
+                uint32_t a = y * size + x, b = a + 1, c = a + size, d = c + 1;
+                mesh.indices.insert(mesh.indices.end(), { a, c, b, b, c, d });
+            }
+        }
+        return mesh;
+    }
+}
+
+std::vector<mgp::bench::TangentSpaceMesh> mgp::bench::tangentSpaceMeshes() {
+    std::vector<TangentSpaceMesh> meshes;
+    appendModel(meshes, "MetalTextureLOD/teapot.obj");
+    appendModel(meshes, "MetalShadowMapping/lego.obj");
+    appendModel(meshes, "MetalEnvironmentMapping/bun_zipper_res3.obj");
+    meshes.push_back(makeTerrain(512));
+    return meshes;
+}
+
+size_t mgp::bench::generateTangentSpace(const TangentSpaceMesh &mesh, uint32_t numThreads,
+                                        std::vector<mgp_obj_vertex_t> &vertices, std::vector<uint32_t> &indices) {
+    // room for every split of both passes
+    vertices.resize((mesh.vertices.size() + mesh.indices.size()) * 2);
+    std::copy(mesh.vertices.begin(), mesh.vertices.end(), vertices.begin());
+    indices = mesh.indices;
+    size_t count = mgp_tangent_space_generate_normals(vertices.data(), indices.data(), vertices.data(),
+                                                      mesh.vertices.size(), indices.data(), indices.size(),
+                                                      &kLayout, kNormalCreaseThreshold, numThreads);
+    return mgp_tangent_space_generate_tangents(vertices.data(), indices.data(), vertices.data(), count,
+                                               indices.data(), indices.size(), &kLayout, numThreads);
+}
+
+// Normals and tangents of the bundled models and a 520k triangle terrain, on one
+// thread and on all of them, and whether 1, 2, 3 and 8 threads give the same bytes.
+MGP_BENCHMARK(tangent_space) {
+    unsigned hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    printf("%-22s %9s %9s %9s %10s %10s %9s %9s\n", "mesh", "triangles", "vertices", "split",
+           "1 thr ms", "all ms", "Mtri/s", "same");
+    for(const mgp::bench::TangentSpaceMesh &mesh : mgp::bench::tangentSpaceMeshes()) {
+        std::vector<mgp_obj_vertex_t> vertices, otherVertices;
+        std::vector<uint32_t> indices, otherIndices;
+        size_t count = 0;
+        int repeats = mesh.indices.size() > 300000 ? 3 : 10;
+        double time = mgp::bench::milliseconds(repeats, [&] {
+            count = mgp::bench::generateTangentSpace(mesh, 1, vertices, indices);
+        });
+        double parallelTime = mgp::bench::milliseconds(repeats, [&] {
+            mgp::bench::generateTangentSpace(mesh, hardwareThreads, otherVertices, otherIndices);
+        });
+
+        bool same = true;
+        for(uint32_t numThreads : { 2u, 3u, 8u }) {
+            size_t otherCount = mgp::bench::generateTangentSpace(mesh, numThreads, otherVertices, otherIndices);
+            same &= otherCount == count && otherIndices == indices &&
+                    memcmp(otherVertices.data(), vertices.data(), count * sizeof(mgp_obj_vertex_t)) == 0;
+        }
+        size_t triangles = mesh.indices.size() / 3;
+        printf("%-22s %9zu %9zu %9zu %10.2f %10.2f %9.1f %9s\n", mesh.name.c_str(), triangles,
+               mesh.vertices.size(), count - mesh.vertices.size(), time, parallelTime,
+               triangles / std::min(time, parallelTime) / 1e3, same ? "yes" : "NO");
+    }
+    printf("%u hardware threads\n", hardwareThreads);
+}
@@ -0,0 +1,41 @@
+//
+//  TangentSpaceBench.h
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/18.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#ifndef TangentSpaceBench_h
+#define TangentSpaceBench_h
+
+// Meshes shared by the tangent space benchmarks, so MGPTangentSpace and
+// ModelIO (TangentSpaceModelIOBench.mm, Apple only) see the same input.
+
+#include "MGPObjImporter.h"
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace mgp {
+namespace bench {
+
+struct TangentSpaceMesh {
+    std::string name;
+    std::vector<mgp_obj_vertex_t> vertices;
+    std::vector<uint32_t> indices;      // one triangle list over all vertices
+};
+
+// The bundled models and a large terrain.
+std::vector<TangentSpaceMesh> tangentSpaceMeshes();
+
+// Normals then tangents as MGPMesh makes them, into vertices and indices.
+// Returns the number of vertices after splits.
+size_t generateTangentSpace(const TangentSpaceMesh &mesh, uint32_t numThreads,
+                            std::vector<mgp_obj_vertex_t> &vertices, std::vector<uint32_t> &indices);
+
+} // namespace bench
+} // namespace mgp
+
+#endif /* TangentSpaceBench_h */
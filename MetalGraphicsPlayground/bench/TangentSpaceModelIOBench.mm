@@ -0,0 +1,98 @@
+//
+//  TangentSpaceModelIOBench.mm
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/18.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <ModelIO/ModelIO.h>
+
+#include "Bench.h"
+#include "TangentSpaceBench.h"
+
+#include <stddef.h>
+#include <stdio.h>
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+// same as MGPMesh
+#define NORMAL_CREASE_THRESHOLD 0.2f
+
+namespace {
+    // The mesh in the base layout of MGPMesh, as ModelIO gets it after loading.
+    MDLMesh *makeModelIOMesh(const mgp::bench::TangentSpaceMesh &mesh) {
+        MDLVertexDescriptor *descriptor = [MDLVertexDescriptor new];
+        descriptor.attributes[0] = [[MDLVertexAttribute alloc] initWithName: MDLVertexAttributePosition
+                                                                     format: MDLVertexFormatFloat3
+                                                                     offset: offsetof(mgp_obj_vertex_t, position)
+                                                                bufferIndex: 0];
+        descriptor.attributes[1] = [[MDLVertexAttribute alloc] initWithName: MDLVertexAttributeTextureCoordinate
+                                                                     format: MDLVertexFormatFloat2
+                                                                     offset: offsetof(mgp_obj_vertex_t, uv)
+                                                                bufferIndex: 0];
+        descriptor.attributes[2] = [[MDLVertexAttribute alloc] initWithName: MDLVertexAttributeNormal
+                                                                     format: MDLVertexFormatFloat3
+                                                                     offset: offsetof(mgp_obj_vertex_t, normal)
+                                                                bufferIndex: 0];
+        descriptor.attributes[3] = [[MDLVertexAttribute alloc] initWithName: MDLVertexAttributeTangent
+                                                                     format: MDLVertexFormatFloat3
+                                                                     offset: offsetof(mgp_obj_vertex_t, tangent)
+                                                                bufferIndex: 0];
+        descriptor.layouts[0] = [[MDLVertexBufferLayout alloc] initWithStride: sizeof(mgp_obj_vertex_t)];
+
+        NSData *vertexData = [NSData dataWithBytes: mesh.vertices.data()
+                                            length: mesh.vertices.size() * sizeof(mgp_obj_vertex_t)];
+        NSData *indexData = [NSData dataWithBytes: mesh.indices.data()
+                                           length: mesh.indices.size() * sizeof(uint32_t)];
+        MDLMeshBufferData *vertexBuffer = [[MDLMeshBufferData alloc] initWithType: MDLMeshBufferTypeVertex
+                                                                             data: vertexData];
+        MDLMeshBufferData *indexBuffer = [[MDLMeshBufferData alloc] initWithType: MDLMeshBufferTypeIndex
+                                                                            data: indexData];
+        MDLSubmesh *submesh = [[MDLSubmesh alloc] initWithIndexBuffer: indexBuffer
+                                                           indexCount: mesh.indices.size()
+                                                            indexType: MDLIndexBitDepthUInt32
+                                                         geometryType: MDLGeometryTypeTriangles
+                                                             material: nil];
+        return [[MDLMesh alloc] initWithVertexBuffer: vertexBuffer
+                                         vertexCount: mesh.vertices.size()
+                                          descriptor: descriptor
+                                           submeshes: @[ submesh ]];
+    }
+}
+
+// The ModelIO helpers MGPMesh used before MGPTangentSpace, on the same meshes as
+// tangent_space. Only built on Apple platforms.
+MGP_BENCHMARK(tangent_space_modelio) {
+    unsigned hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    printf("%-22s %9s %12s %12s %12s %9s\n", "mesh", "triangles", "modelio ms", "vertices", "mgp all ms", "speedup");
+    for(const mgp::bench::TangentSpaceMesh &mesh : mgp::bench::tangentSpaceMeshes()) {
+        int repeats = mesh.indices.size() > 300000 ? 3 : 10;
+        NSUInteger vertexCount = 0;
+        double time = 0.0;
+        for(int r = 0; r < repeats; r++) {
+            @autoreleasepool {
+                MDLMesh *mdlMesh = makeModelIOMesh(mesh);
+                time += mgp::bench::milliseconds(1, [&] {
+                    [mdlMesh addNormalsWithAttributeNamed: MDLVertexAttributeNormal
+                                          creaseThreshold: NORMAL_CREASE_THRESHOLD];
+                    [mdlMesh addTangentBasisForTextureCoordinateAttributeNamed: MDLVertexAttributeTextureCoordinate
+                                                          normalAttributeNamed: MDLVertexAttributeNormal
+                                                         tangentAttributeNamed: MDLVertexAttributeTangent];
+                });
+                vertexCount = mdlMesh.vertexCount;
+            }
+        }
+        time /= repeats;
+
+        std::vector<mgp_obj_vertex_t> vertices;
+        std::vector<uint32_t> indices;
+        double mgpTime = mgp::bench::milliseconds(repeats, [&] {
+            mgp::bench::generateTangentSpace(mesh, hardwareThreads, vertices, indices);
+        });
+        printf("%-22s %9zu %12.2f %12lu %12.2f %8.1fx\n", mesh.name.c_str(), mesh.indices.size() / 3, time,
+               (unsigned long)vertexCount, mgpTime, time / mgpTime);
+    }
+}
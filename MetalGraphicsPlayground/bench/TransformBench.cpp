@@ -0,0 +1,172 @@
+//
+//  TransformBench.cpp
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/18.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#include "Bench.h"
+#include "MGPTransformSystem.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+    // What the scene graph did before : nodes on the heap, updated recursively.
+    struct Node {
+        float position[3], rotation[9], scale[3];
+        float world[16], worldRotation[9];
+        Node *parent = nullptr;
+        std::vector<Node *> children;
+    };
+
+    void multiply4(const float *a, const float *b, float *result) {
+        for(int c = 0; c < 4; c++) {
+            for(int r = 0; r < 4; r++) {
+                float sum = 0.0f;
+                for(int k = 0; k < 4; k++)
+                    sum += a[k * 4 + r] * b[c * 4 + k];
+                result[c * 4 + r] = sum;
+            }
+        }
+    }
+
+    void multiply3(const float *a, const float *b, float *result) {
+        for(int c = 0; c < 3; c++) {
+            for(int r = 0; r < 3; r++) {
+                float sum = 0.0f;
+                for(int k = 0; k < 3; k++)
+                    sum += a[k * 3 + r] * b[c * 3 + k];
+                result[c * 3 + r] = sum;
+            }
+        }
+    }
+
+    void updateRecursively(Node *node) {
+        float local[16];
+        for(int c = 0; c < 3; c++) {
+            for(int r = 0; r < 3; r++)
+                local[c * 4 + r] = node->rotation[c * 3 + r] * node->scale[c];
+            local[c * 4 + 3] = 0.0f;
+        }
+        memcpy(local + 12, node->position, sizeof(float) * 3);
+        local[15] = 1.0f;
+        if(node->parent) {
+            multiply4(node->parent->world, local, node->world);
+            multiply3(node->parent->worldRotation, node->rotation, node->worldRotation);
+        }
+        else {
+            memcpy(node->world, local, sizeof(local));
+            memcpy(node->worldRotation, node->rotation, sizeof(node->rotation));
+        }
+        for(Node *child : node->children)
+            updateRecursively(child);
+    }
+
+    void rotationZ(float angle, float *rotation) {
+        float c = cosf(angle), s = sinf(angle);
+        const float matrix[9] = { c, s, 0.0f, -s, c, 0.0f, 0.0f, 0.0f, 1.0f };
+        memcpy(rotation, matrix, sizeof(matrix));
+    }
+}
+
+// 1M transforms in a random tree with 1% roots, against a recursive update
+// of heap nodes allocated in shuffled order.
+MGP_BENCHMARK(transform) {
+    const size_t count = 1000000;
+    const size_t rootCount = count / 100;
+    std::mt19937 random(1);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+    std::vector<size_t> parents(count);
+    for(size_t i = 0; i < count; i++)
+        parents[i] = i < rootCount ? SIZE_MAX : random() % i;
+    std::vector<size_t> order(count);
+    for(size_t i = 0; i < count; i++)
+        order[i] = i;
+    std::shuffle(order.begin(), order.end(), random);
+    std::vector<std::unique_ptr<Node>> allocations(count);
+    std::vector<Node *> nodes(count);
+    for(size_t i = 0; i < count; i++) {
+        allocations[i].reset(new Node());
+        nodes[order[i]] = allocations[i].get();
+    }
+
+    uint32_t hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    for(uint32_t numThreads : { 1u, hardwareThreads }) {
+        mgp_transform_system_t *system = mgp_transform_system_create(numThreads);
+        std::vector<mgp_transform_t> transforms(count);
+        std::mt19937 values(2);
+        for(size_t i = 0; i < count; i++) {
+            Node *node = nodes[i];
+            float position[3] = { unit(values), unit(values), unit(values) };
+            float scale[3] = { 1.0f + 0.1f * unit(values), 1.0f, 1.0f };
+            memcpy(node->position, position, sizeof(position));
+            memcpy(node->scale, scale, sizeof(scale));
+            rotationZ(unit(values), node->rotation);
+            transforms[i] = mgp_transform_create(system);
+            mgp_transform_set_local(system, transforms[i], node->position, node->rotation, node->scale);
+        }
+        for(size_t i = 0; i < count; i++) {
+            if(parents[i] == SIZE_MAX)
+                continue;
+            mgp_transform_set_parent(system, transforms[i], transforms[parents[i]]);
+            if(numThreads == 1) {
+                nodes[i]->parent = nodes[parents[i]];
+                nodes[parents[i]]->children.push_back(nodes[i]);
+            }
+        }
+
+        double sort = mgp::bench::milliseconds(1, [&] { mgp_transform_system_update(system); });
+
+        const int repeats = 10;
+        double allChanged = 0.0, recursive = 0.0;
+        for(int r = 0; r < repeats; r++) {
+            float position[3] = { r * 0.01f, 0.0f, 0.0f };
+            for(size_t i = 0; i < count; i++) {
+                mgp_transform_set_local(system, transforms[i], position, nullptr, nullptr);
+                memcpy(nodes[i]->position, position, sizeof(position));
+            }
+            allChanged += mgp::bench::milliseconds(1, [&] { mgp_transform_system_update(system); });
+            recursive += mgp::bench::milliseconds(1, [&] {
+                for(size_t i = 0; i < rootCount; i++)
+                    updateRecursively(nodes[i]);
+            });
+        }
+
+        float maxError = 0.0f;
+        for(size_t i = 0; i < count; i++) {
+            const float *world = mgp_transform_world_matrix(system, transforms[i]);
+            for(int k = 0; k < 16; k++)
+                maxError = std::max(maxError, fabsf(world[k] - nodes[i]->world[k]));
+        }
+
+        double rootsMoved = 0.0;
+        for(int r = 0; r < repeats; r++) {
+            float position[3] = { r * 0.02f, 1.0f, 0.0f };
+            rootsMoved += mgp::bench::milliseconds(1, [&] {
+                for(size_t i = 0; i < rootCount; i++)
+                    mgp_transform_set_local(system, transforms[i], position, nullptr, nullptr);
+                mgp_transform_system_update(system);
+            });
+        }
+        double unchanged = mgp::bench::milliseconds(repeats, [&] { mgp_transform_system_update(system); });
+
+        printf("threads %u\n", numThreads);
+        printf("  first update with sort  %9.2f ms\n", sort);
+        printf("  all changed             %9.2f ms (recursive %.2f ms, max difference %g)\n",
+               allChanged / repeats, recursive / repeats, maxError);
+        printf("  roots moved             %9.2f ms\n", rootsMoved / repeats);
+        printf("  unchanged               %9.4f ms\n", unchanged);
+        mgp_transform_system_destroy(system);
+        if(hardwareThreads == 1)
+            break;
+    }
+}
@@ -0,0 +1,78 @@
+//
+//  main.cpp
+//  MetalGraphicsPlayground
+//
+//  Created by 이현우 on 2026/10/18.
+//  Copyright © 2026 Prin_E. All rights reserved.
+//
+
+#include "Bench.h"
+
+#include <dirent.h>
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+
+namespace {
+    struct Benchmark {
+        const char *name;
+        mgp::bench::Function function;
+    };
+
+    std::vector<Benchmark> &benchmarks() {
+        static std::vector<Benchmark> list;
+        return list;
+    }
+}
+
+mgp::bench::Registration::Registration(const char *name, Function function) {
+    benchmarks().push_back({ name, function });
+}
+
+std::string mgp::bench::assetPath(const char *relativePath) {
+    return std::string(MGP_SOURCE_DIR) + "/" + relativePath;
+}
+
+std::vector<std::string> mgp::bench::listFiles(const char *relativePath, const char *extension) {
+    std::string directory = assetPath(relativePath);
+    std::vector<std::string> files;
+    DIR *dir = opendir(directory.c_str());
+    if(dir == nullptr)
+        return files;
+    size_t extensionLength = strlen(extension);
+    while(dirent *entry = readdir(dir)) {
+        size_t length = strlen(entry->d_name);
+        if(length > extensionLength && strcmp(entry->d_name + length - extensionLength, extension) == 0)
+            files.push_back(directory + "/" + entry->d_name);
+    }
+    closedir(dir);
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+// usage : mgp_bench [--list] [name...], runs every benchmark without names
+int main(int argc, char **argv) {
+    if(argc > 1 && strcmp(argv[1], "--list") == 0) {
+        for(const Benchmark &benchmark : benchmarks())
+            printf("%s\n", benchmark.name);
+        return 0;
+    }
+
+    int ran = 0;
+    for(const Benchmark &benchmark : benchmarks()) {
+        bool selected = argc == 1;
+        for(int i = 1; i < argc; i++)
+            selected = selected || strcmp(argv[i], benchmark.name) == 0;
+        if(!selected)
+            continue;
+        printf("== %s (%s) ==\n", benchmark.name, mgp::bench::simdName());
+        benchmark.function();
+        printf("\n");
+        ran++;
+    }
+    if(ran == 0) {
+        fprintf(stderr, "no benchmark matched, see --list\n");
+        return 1;
+    }
+    return 0;
+}